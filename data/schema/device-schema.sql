@@ -81,17 +81,70 @@ CREATE TABLE device_%deviceid_songs (
   musicbrainz_track_id TEXT,
   musicbrainz_disc_id TEXT,
   musicbrainz_release_group_id TEXT,
-  musicbrainz_work_id TEXT
+  musicbrainz_work_id TEXT,
+
+  rg_track_gain REAL,
+  rg_track_peak REAL,
+
+  artist_sortkey TEXT,
+  album_sortkey TEXT
 
 );
 
 CREATE INDEX idx_device_%deviceid_songs_album ON device_%deviceid_songs (album);
 
+CREATE INDEX idx_device_%deviceid_songs_artist_sortkey ON device_%deviceid_songs (artist_sortkey);
+
+CREATE INDEX idx_device_%deviceid_songs_album_sortkey ON device_%deviceid_songs (album_sortkey);
+
 CREATE INDEX idx_device_%deviceid_songs_comp_artist ON device_%deviceid_songs (compilation_effective, artist);
 
 CREATE VIRTUAL TABLE device_%deviceid_fts USING fts5(
   ftstitle, ftsalbum, ftsartist, ftsalbumartist, ftscomposer, ftsperformer, ftsgrouping, ftsgenre, ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
+);
+
+CREATE TABLE device_%deviceid_songs_counts (
+  songs INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE device_%deviceid_songs_artists (
+  artist TEXT NOT NULL PRIMARY KEY,
+  count INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE device_%deviceid_songs_albums (
+  effective_albumartist TEXT NOT NULL,
+  album TEXT NOT NULL,
+  count INTEGER NOT NULL DEFAULT 0,
+  PRIMARY KEY (effective_albumartist, album)
 );
 
-UPDATE devices SET schema_version=4 WHERE ROWID=%deviceid;
+INSERT INTO device_%deviceid_songs_counts (songs) VALUES (0);
+
+CREATE TRIGGER device_%deviceid_songs_counts_insert AFTER INSERT ON device_%deviceid_songs WHEN new.unavailable = 0 BEGIN
+UPDATE device_%deviceid_songs_counts SET songs = songs + 1;
+INSERT INTO device_%deviceid_songs_artists (artist, count) SELECT new.artist, 1 WHERE new.artist IS NOT NULL ON CONFLICT (artist) DO UPDATE SET count = count + 1;
+INSERT INTO device_%deviceid_songs_albums (effective_albumartist, album, count) VALUES (IFNULL(new.effective_albumartist, ''), IFNULL(new.album, ''), 1) ON CONFLICT (effective_albumartist, album) DO UPDATE SET count = count + 1;
+END;
+
+CREATE TRIGGER device_%deviceid_songs_counts_delete AFTER DELETE ON device_%deviceid_songs WHEN old.unavailable = 0 BEGIN
+UPDATE device_%deviceid_songs_counts SET songs = songs - 1;
+UPDATE device_%deviceid_songs_artists SET count = count - 1 WHERE artist = old.artist;
+DELETE FROM device_%deviceid_songs_artists WHERE artist = old.artist AND count <= 0;
+UPDATE device_%deviceid_songs_albums SET count = count - 1 WHERE effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '');
+DELETE FROM device_%deviceid_songs_albums WHERE effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '') AND count <= 0;
+END;
+
+CREATE TRIGGER device_%deviceid_songs_counts_update AFTER UPDATE OF artist, album, effective_albumartist, unavailable ON device_%deviceid_songs BEGIN
+UPDATE device_%deviceid_songs_counts SET songs = songs - (CASE WHEN old.unavailable = 0 THEN 1 ELSE 0 END) + (CASE WHEN new.unavailable = 0 THEN 1 ELSE 0 END);
+UPDATE device_%deviceid_songs_artists SET count = count - 1 WHERE old.unavailable = 0 AND artist = old.artist;
+DELETE FROM device_%deviceid_songs_artists WHERE old.unavailable = 0 AND artist = old.artist AND count <= 0;
+INSERT INTO device_%deviceid_songs_artists (artist, count) SELECT new.artist, 1 WHERE new.unavailable = 0 AND new.artist IS NOT NULL ON CONFLICT (artist) DO UPDATE SET count = count + 1;
+UPDATE device_%deviceid_songs_albums SET count = count - 1 WHERE old.unavailable = 0 AND effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '');
+DELETE FROM device_%deviceid_songs_albums WHERE old.unavailable = 0 AND effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '') AND count <= 0;
+INSERT INTO device_%deviceid_songs_albums (effective_albumartist, album, count) SELECT IFNULL(new.effective_albumartist, ''), IFNULL(new.album, ''), 1 WHERE new.unavailable = 0 ON CONFLICT (effective_albumartist, album) DO UPDATE SET count = count + 1;
+END;
+
+UPDATE devices SET schema_version=5 WHERE ROWID=%deviceid;
@@ -0,0 +1,6 @@
+CREATE TABLE file_fingerprints (
+  url TEXT NOT NULL PRIMARY KEY,
+  fingerprint TEXT NOT NULL
+);
+
+UPDATE schema_version SET version=18;
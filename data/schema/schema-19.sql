@@ -0,0 +1,5 @@
+ALTER TABLE %allsongstables ADD COLUMN rg_track_gain REAL;
+
+ALTER TABLE %allsongstables ADD COLUMN rg_track_peak REAL;
+
+UPDATE schema_version SET version=19;
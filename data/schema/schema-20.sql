@@ -0,0 +1,10 @@
+DROP VIEW IF EXISTS duplicated_songs;
+
+CREATE VIEW duplicated_songs as
+select s.ROWID as dup_rowid from songs s inner join (select artist, album, title from songs where artist != '' and album != '' and title != '' and unavailable = 0 group by artist, album, title having count(*) > 1) dup on s.artist = dup.artist and s.album = dup.album and s.title = dup.title where s.unavailable = 0
+union
+select s.ROWID as dup_rowid from songs s inner join (select artist, title, length / 1000000000 as length_seconds from songs where artist != '' and title != '' and unavailable = 0 group by artist, title, length_seconds having count(*) > 1) dup on s.artist = dup.artist and s.title = dup.title and s.length / 1000000000 = dup.length_seconds where s.unavailable = 0
+union
+select s.ROWID as dup_rowid from songs s inner join (select fingerprint from songs where fingerprint != '' and fingerprint != 'NONE' and unavailable = 0 group by fingerprint having count(*) > 1) dup on s.fingerprint = dup.fingerprint where s.unavailable = 0;
+
+UPDATE schema_version SET version=20;
@@ -0,0 +1,47 @@
+CREATE TABLE %allsongstables_counts (
+  songs INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE %allsongstables_artists (
+  artist TEXT NOT NULL PRIMARY KEY,
+  count INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE %allsongstables_albums (
+  effective_albumartist TEXT NOT NULL,
+  album TEXT NOT NULL,
+  count INTEGER NOT NULL DEFAULT 0,
+  PRIMARY KEY (effective_albumartist, album)
+);
+
+INSERT INTO %allsongstables_counts (songs) SELECT COUNT(*) FROM %allsongstables WHERE unavailable = 0;
+
+INSERT INTO %allsongstables_artists (artist, count) SELECT artist, COUNT(*) FROM %allsongstables WHERE unavailable = 0 AND artist IS NOT NULL GROUP BY artist;
+
+INSERT INTO %allsongstables_albums (effective_albumartist, album, count) SELECT IFNULL(effective_albumartist, ''), IFNULL(album, ''), COUNT(*) FROM %allsongstables WHERE unavailable = 0 GROUP BY IFNULL(effective_albumartist, ''), IFNULL(album, '');
+
+CREATE TRIGGER %allsongstables_counts_insert AFTER INSERT ON %allsongstables WHEN new.unavailable = 0 BEGIN
+UPDATE %allsongstables_counts SET songs = songs + 1;
+INSERT INTO %allsongstables_artists (artist, count) SELECT new.artist, 1 WHERE new.artist IS NOT NULL ON CONFLICT (artist) DO UPDATE SET count = count + 1;
+INSERT INTO %allsongstables_albums (effective_albumartist, album, count) VALUES (IFNULL(new.effective_albumartist, ''), IFNULL(new.album, ''), 1) ON CONFLICT (effective_albumartist, album) DO UPDATE SET count = count + 1;
+END;
+
+CREATE TRIGGER %allsongstables_counts_delete AFTER DELETE ON %allsongstables WHEN old.unavailable = 0 BEGIN
+UPDATE %allsongstables_counts SET songs = songs - 1;
+UPDATE %allsongstables_artists SET count = count - 1 WHERE artist = old.artist;
+DELETE FROM %allsongstables_artists WHERE artist = old.artist AND count <= 0;
+UPDATE %allsongstables_albums SET count = count - 1 WHERE effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '');
+DELETE FROM %allsongstables_albums WHERE effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '') AND count <= 0;
+END;
+
+CREATE TRIGGER %allsongstables_counts_update AFTER UPDATE OF artist, album, effective_albumartist, unavailable ON %allsongstables BEGIN
+UPDATE %allsongstables_counts SET songs = songs - (CASE WHEN old.unavailable = 0 THEN 1 ELSE 0 END) + (CASE WHEN new.unavailable = 0 THEN 1 ELSE 0 END);
+UPDATE %allsongstables_artists SET count = count - 1 WHERE old.unavailable = 0 AND artist = old.artist;
+DELETE FROM %allsongstables_artists WHERE old.unavailable = 0 AND artist = old.artist AND count <= 0;
+INSERT INTO %allsongstables_artists (artist, count) SELECT new.artist, 1 WHERE new.unavailable = 0 AND new.artist IS NOT NULL ON CONFLICT (artist) DO UPDATE SET count = count + 1;
+UPDATE %allsongstables_albums SET count = count - 1 WHERE old.unavailable = 0 AND effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '');
+DELETE FROM %allsongstables_albums WHERE old.unavailable = 0 AND effective_albumartist = IFNULL(old.effective_albumartist, '') AND album = IFNULL(old.album, '') AND count <= 0;
+INSERT INTO %allsongstables_albums (effective_albumartist, album, count) SELECT IFNULL(new.effective_albumartist, ''), IFNULL(new.album, ''), 1 WHERE new.unavailable = 0 ON CONFLICT (effective_albumartist, album) DO UPDATE SET count = count + 1;
+END;
+
+UPDATE schema_version SET version=21;
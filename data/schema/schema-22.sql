@@ -0,0 +1,9 @@
+ALTER TABLE %allsongstables ADD COLUMN artist_sortkey TEXT;
+
+ALTER TABLE %allsongstables ADD COLUMN album_sortkey TEXT;
+
+CREATE INDEX IF NOT EXISTS idx_artist_sortkey ON songs (artist_sortkey);
+
+CREATE INDEX IF NOT EXISTS idx_album_sortkey ON songs (album_sortkey);
+
+UPDATE schema_version SET version=22;
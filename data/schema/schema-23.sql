@@ -0,0 +1,9 @@
+CREATE TABLE fullscan_checkpoints (
+  subdirs_table TEXT NOT NULL,
+  directory_id INTEGER NOT NULL,
+  path TEXT NOT NULL,
+  mtime INTEGER NOT NULL,
+  PRIMARY KEY (subdirs_table, directory_id, path)
+);
+
+UPDATE schema_version SET version=23;
@@ -0,0 +1,7 @@
+CREATE INDEX IF NOT EXISTS idx_mtime ON songs (mtime) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_ctime ON songs (ctime) WHERE unavailable = 0;
+
+CREATE INDEX IF NOT EXISTS idx_lastseen ON songs (lastseen) WHERE unavailable = 1;
+
+UPDATE schema_version SET version=24;
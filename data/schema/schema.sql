@@ -4,7 +4,7 @@ CREATE TABLE IF NOT EXISTS schema_version (
 
 DELETE FROM schema_version;
 
-INSERT INTO schema_version (version) VALUES (16);
+INSERT INTO schema_version (version) VALUES (17);
 
 CREATE TABLE IF NOT EXISTS directories (
   path TEXT NOT NULL,
@@ -750,7 +750,12 @@ CREATE INDEX IF NOT EXISTS idx_album ON songs (album);
 
 CREATE INDEX IF NOT EXISTS idx_title ON songs (title);
 
-CREATE VIEW IF NOT EXISTS duplicated_songs as select artist dup_artist, album dup_album, title dup_title from songs as inner_songs where artist != '' and album != '' and title != '' and unavailable = 0 group by artist, album , title having count(*) > 1;
+CREATE VIEW IF NOT EXISTS duplicated_songs as
+select s.ROWID as dup_rowid from songs s inner join (select artist, album, title from songs where artist != '' and album != '' and title != '' and unavailable = 0 group by artist, album, title having count(*) > 1) dup on s.artist = dup.artist and s.album = dup.album and s.title = dup.title where s.unavailable = 0
+union
+select s.ROWID as dup_rowid from songs s inner join (select artist, title, length / 1000000000 as length_seconds from songs where artist != '' and title != '' and unavailable = 0 group by artist, title, length_seconds having count(*) > 1) dup on s.artist = dup.artist and s.title = dup.title and s.length / 1000000000 = dup.length_seconds where s.unavailable = 0
+union
+select s.ROWID as dup_rowid from songs s inner join (select fingerprint from songs where fingerprint != '' and fingerprint != 'NONE' and unavailable = 0 group by fingerprint having count(*) > 1) dup on s.fingerprint = dup.fingerprint where s.unavailable = 0;
 
 CREATE VIRTUAL TABLE IF NOT EXISTS songs_fts USING fts5(
 
@@ -763,7 +768,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -778,7 +784,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS subsonic_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -793,7 +800,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS tidal_artists_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -808,7 +816,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS tidal_albums_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -823,7 +832,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS tidal_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -838,7 +848,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_artists_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -853,7 +864,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_albums_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -868,7 +880,8 @@ CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_songs_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
 
@@ -883,6 +896,7 @@ CREATE VIRTUAL TABLE IF NOT EXISTS %allsongstables_fts USING fts5(
   ftsgrouping,
   ftsgenre,
   ftscomment,
-  tokenize = "unicode61 remove_diacritics 1"
+  tokenize = "unicode61 remove_diacritics 1",
+  prefix = "2 3 4"
 
 );
@@ -85,10 +85,9 @@ void _MessageHandlerBase::DeviceReadyRead() {
         return;
       }
 
-      // Clear the buffer
-      buffer_.close();
-      buffer_.setData(QByteArray());
-      buffer_.open(QIODevice::ReadWrite);
+      // Clear the buffer, but keep the allocated capacity so the next message reuses it.
+      buffer_.buffer().resize(0);
+      buffer_.seek(0);
       reading_protobuf_ = false;
     }
   }
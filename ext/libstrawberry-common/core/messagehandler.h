@@ -26,6 +26,7 @@
 #include <QThread>
 #include <QBuffer>
 #include <QByteArray>
+#include <QList>
 #include <QMap>
 #include <QString>
 #include <QLocalSocket>
@@ -100,6 +101,14 @@ class AbstractMessageHandler : public _MessageHandlerBase {
   // Sets the "id" field of reply to the same as the request, and sends the reply on the socket.  Used on the worker side.
   void SendReply(const MessageType &request, MessageType *reply);
 
+  // Removes and returns all replies that are still waiting for an answer.
+  // Used by the WorkerPool to reassign outstanding requests when a worker is restarted.
+  QList<ReplyType*> TakeAllPendingReplies() {
+    QList<ReplyType*> replies = pending_replies_.values();
+    pending_replies_.clear();
+    return replies;
+  }
+
  protected:
   // Called when a message is received from the socket.
   virtual void MessageArrived(const MessageType &message) { Q_UNUSED(message); }
@@ -110,6 +119,11 @@ class AbstractMessageHandler : public _MessageHandlerBase {
 
  private:
   QMap<int, ReplyType*> pending_replies_;
+
+  // Reused for every message so that steady-state sends and receives don't allocate.
+  // Both are only touched from my thread: SendMessage asserts it, and RawMessageArrived is called from DeviceReadyRead.
+  std::string write_buffer_;
+  MessageType read_message_;
 };
 
 template<typename MT>
@@ -120,8 +134,9 @@ template<typename MT>
 void AbstractMessageHandler<MT>::SendMessage(const MessageType &message) {
   Q_ASSERT(QThread::currentThread() == thread());
 
-  std::string data = message.SerializeAsString();
-  WriteMessage(QByteArray(data.data(), data.size()));
+  message.SerializeToString(&write_buffer_);
+  // WriteMessage copies the data to the socket before returning, so the buffer can be wrapped instead of copied.
+  WriteMessage(QByteArray::fromRawData(write_buffer_.data(), static_cast<int>(write_buffer_.size())));
 }
 
 template<typename MT>
@@ -145,18 +160,18 @@ void AbstractMessageHandler<MT>::SendReply(const MessageType &request, MessageTy
 template<typename MT>
 bool AbstractMessageHandler<MT>::RawMessageArrived(const QByteArray &data) {
 
-  MessageType message;
-  if (!message.ParseFromArray(data.constData(), data.size())) {
+  // Parsing into the same message every time lets protobuf reuse the heap blocks it allocated for the previous message's fields.
+  if (!read_message_.ParseFromArray(data.constData(), data.size())) {
     return false;
   }
 
-  if (pending_replies_.contains(message.id())) {
+  if (pending_replies_.contains(read_message_.id())) {
     // This is a reply to a message that we created earlier.
-    ReplyType *reply = pending_replies_.take(message.id());
-    reply->SetReply(message);
+    ReplyType *reply = pending_replies_.take(read_message_.id());
+    reply->SetReply(read_message_);
   }
   else {
-    MessageArrived(message);
+    MessageArrived(read_message_);
   }
 
   return true;
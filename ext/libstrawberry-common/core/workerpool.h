@@ -21,6 +21,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstddef>
 
@@ -35,6 +36,8 @@
 #include <QList>
 #include <QQueue>
 #include <QString>
+#include <QTimer>
+#include <QDateTime>
 #include <QStringList>
 #include <QAtomicInt>
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
@@ -63,6 +66,7 @@ class _WorkerPoolBase : public QObject {
   virtual void ProcessReadyReadStandardError() {}
   virtual void ProcessError(QProcess::ProcessError) {}
   virtual void SendQueuedMessages() {}
+  virtual void CheckSlowRequests() {}
 };
 
 
@@ -83,7 +87,7 @@ class WorkerPool : public _WorkerPoolBase {
   // You must call this before calling Start().
   void SetExecutableName(const QString &executable_name);
 
-  // Sets the number of worker process to use.  Defaults to 1 <= (processors / 2) <= 2.
+  // Sets the number of worker processes to use.  A count of 0 or less selects the default of half the available cores, minimum 1.
   void SetWorkerCount(const int count);
 
   // Sets the prefix to use for the local server (on unix this is a named pipe in /tmp).
@@ -107,6 +111,7 @@ class WorkerPool : public _WorkerPoolBase {
   void ProcessReadyReadStandardError() override;
   void ProcessError(QProcess::ProcessError error) override;
   void SendQueuedMessages() override;
+  void CheckSlowRequests() override;
 
  private:
   struct Worker {
@@ -116,11 +121,19 @@ class WorkerPool : public _WorkerPoolBase {
     QLocalSocket *local_socket_;
     QProcess *process_;
     HandlerType *handler_;
+
+    // Message id -> time the request was written to this worker, for load balancing and slow request detection.
+    QMap<int, qint64> request_sent_times_;
   };
 
   // Must only ever be called on my thread.
   void StartOneWorker(Worker *worker);
 
+  // Replaces a dead or stuck worker.  If the warm standby is already connected it is promoted into the
+  // worker's slot so recovery doesn't wait for process startup, and a new standby is spawned in the background.
+  // Must only ever be called on my thread.
+  void RestartWorker(Worker *worker);
+
   template<typename T>
   Worker *FindWorker(T Worker::*member, T value) {
     for (typename QList<Worker>::iterator it = workers_.begin(); it != workers_.end(); ++it) {
@@ -128,6 +141,9 @@ class WorkerPool : public _WorkerPoolBase {
         return &(*it);
       }
     }
+    if (standby_.*member == value) {
+      return &standby_;
+    }
     return nullptr;
   }
 
@@ -143,17 +159,31 @@ class WorkerPool : public _WorkerPoolBase {
   // and sets the request's ID to the ID of the reply.  Can be called from any thread
   ReplyType *NewReply(MessageType *message);
 
-  // Returns the next handler, or nullptr if there isn't one.  Must be called from my thread.
-  HandlerType *NextHandler() const;
+  // Returns the index of the connected worker with the fewest outstanding requests that is still under the queue depth bound,
+  // or -1 if there isn't one.  Must be called from my thread.
+  int NextWorkerIndex();
+
+  // Writes the request to the worker and records it for load balancing and slow request detection.
+  void SendRequestToWorker(const int worker_index, ReplyType *reply);
 
  private:
   QString local_server_name_;
   QString executable_name_;
   QString executable_path_;
 
+  // Each worker pipelines at most this many outstanding requests, the rest stay in the shared queue.
+  static const int kMaxWorkerQueueDepth = 4;
+  // A worker whose oldest outstanding request is older than this is restarted and its requests are reassigned.
+  static const int kSlowRequestTimeoutMs = 30000;
+  static const int kSlowRequestCheckIntervalMs = 5000;
+
   int worker_count_;
   mutable int next_worker_;
   QList<Worker> workers_;
+  // A warm standby worker that is started ahead of need and never receives requests.
+  // It is promoted into the pool when a worker has to be replaced.
+  Worker standby_;
+  QTimer *slow_request_timer_;
 
   QAtomicInt next_id_;
 
@@ -165,8 +195,9 @@ class WorkerPool : public _WorkerPoolBase {
 template<typename HandlerType>
 WorkerPool<HandlerType>::WorkerPool(QObject *parent)
     : _WorkerPoolBase(parent),
-      worker_count_(1),
+      worker_count_(qMax(1, QThread::idealThreadCount() / 2)),
       next_worker_(0),
+      slow_request_timer_(new QTimer(this)),
       next_id_(0) {
 
   local_server_name_ = qApp->applicationName().toLower();
@@ -175,12 +206,18 @@ WorkerPool<HandlerType>::WorkerPool(QObject *parent)
     local_server_name_ = "workerpool";
   }
 
+  slow_request_timer_->setInterval(kSlowRequestCheckIntervalMs);
+  QObject::connect(slow_request_timer_, &QTimer::timeout, this, &WorkerPool::CheckSlowRequests);
+
 }
 
 template<typename HandlerType>
 WorkerPool<HandlerType>::~WorkerPool() {
 
-  for (const Worker &worker : workers_) {
+  QList<Worker> workers = workers_;
+  workers << standby_;
+
+  for (const Worker &worker : workers) {
     if (worker.local_socket_ && worker.process_) {
       QObject::disconnect(worker.process_, &QProcess::errorOccurred, this, &WorkerPool::ProcessError);
       QObject::disconnect(worker.process_, &QProcess::readyReadStandardOutput, this, &WorkerPool::ProcessReadyReadStandardOutput);
@@ -211,7 +248,7 @@ WorkerPool<HandlerType>::~WorkerPool() {
 template<typename HandlerType>
 void WorkerPool<HandlerType>::SetWorkerCount(const int count) {
   Q_ASSERT(workers_.isEmpty());
-  worker_count_ = count;
+  worker_count_ = count > 0 ? count : qMax(1, QThread::idealThreadCount() / 2);
 }
 
 template<typename HandlerType>
@@ -272,6 +309,11 @@ void WorkerPool<HandlerType>::DoStart() {
     workers_ << worker;
   }
 
+  // Start the warm standby so that replacing a worker later doesn't have to wait for process startup.
+  StartOneWorker(&standby_);
+
+  slow_request_timer_->start();
+
 }
 
 template<typename HandlerType>
@@ -367,12 +409,41 @@ void WorkerPool<HandlerType>::ProcessError(QProcess::ProcessError error) {
     default:
       // On any other error we just restart the process.
       qLog(Debug) << "Worker" << worker << "failed with error" << error << "- restarting";
-      StartOneWorker(worker);
+      if (worker == &standby_) {
+        StartOneWorker(&standby_);
+      }
+      else {
+        RestartWorker(worker);
+        // If the standby was promoted there is a worker ready for queued requests right away.
+        SendQueuedMessages();
+      }
       break;
   }
 
 }
 
+template<typename HandlerType>
+void WorkerPool<HandlerType>::RestartWorker(Worker *worker) {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  if (standby_.handler_ && !standby_.handler_->is_device_closed()) {
+    // The standby is already connected - promote it into this slot and spawn a replacement in the background.
+    DeleteQObjectPointerLater(&worker->local_server_);
+    DeleteQObjectPointerLater(&worker->local_socket_);
+    DeleteQObjectPointerLater(&worker->process_);
+    DeleteQObjectPointerLater(&worker->handler_);
+    *worker = standby_;
+    standby_ = Worker();
+    StartOneWorker(&standby_);
+  }
+  else {
+    // The standby isn't ready (still starting, or it died too) - start a new worker in place.
+    StartOneWorker(worker);
+  }
+
+}
+
 template<typename HandlerType>
 void WorkerPool<HandlerType>::ProcessReadyReadStandardOutput() {
 
@@ -438,32 +509,88 @@ void WorkerPool<HandlerType>::SendQueuedMessages() {
     ReplyType *reply = message_queue_.dequeue();
 
     // Find a worker for this message
-    HandlerType *handler = NextHandler();
-    if (!handler) {
-      // No available handlers - put the message on the front of the queue.
+    const int worker_index = NextWorkerIndex();
+    if (worker_index == -1) {
+      // No available workers - put the message on the front of the queue.
       message_queue_.prepend(reply);
-      qLog(Debug) << "No available handlers to process request";
+      qLog(Debug) << "No available workers to process request";
       break;
     }
 
-    handler->SendRequest(reply);
+    SendRequestToWorker(worker_index, reply);
   }
 
 }
 
 template<typename HandlerType>
-HandlerType *WorkerPool<HandlerType>::NextHandler() const {
+int WorkerPool<HandlerType>::NextWorkerIndex() {
+
+  int best = -1;
 
   for (int i = 0; i < workers_.count(); ++i) {
     const int worker_index = (next_worker_ + i) % workers_.count();
+    const Worker &worker = workers_[worker_index];
+
+    if (!worker.handler_ || worker.handler_->is_device_closed()) continue;
+    if (worker.request_sent_times_.count() >= kMaxWorkerQueueDepth) continue;
+
+    if (best == -1 || worker.request_sent_times_.count() < workers_[best].request_sent_times_.count()) {
+      best = worker_index;
+    }
+  }
+
+  next_worker_ = (next_worker_ + 1) % qMax(1, static_cast<int>(workers_.count()));
+
+  return best;
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::SendRequestToWorker(const int worker_index, ReplyType *reply) {
 
-    if (workers_[worker_index].handler_ && !workers_[worker_index].handler_->is_device_closed()) {
-      next_worker_ = (worker_index + 1) % workers_.count();
-      return workers_[worker_index].handler_;
+  const int id = reply->id();
+  Worker *worker = &workers_[worker_index];
+
+  worker->handler_->SendRequest(reply);
+  worker->request_sent_times_.insert(id, QDateTime::currentMSecsSinceEpoch());
+
+  QObject::connect(reply, &_MessageReplyBase::Finished, this, [this, worker_index, id]() {
+    if (worker_index >= 0 && worker_index < workers_.count()) {
+      workers_[worker_index].request_sent_times_.remove(id);
+    }
+  });
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::CheckSlowRequests() {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+  for (int i = 0; i < workers_.count(); ++i) {
+    Worker *worker = &workers_[i];
+    if (!worker->handler_ || worker->request_sent_times_.isEmpty()) continue;
+
+    const qint64 oldest = *std::min_element(worker->request_sent_times_.constBegin(), worker->request_sent_times_.constEnd());
+    if (now - oldest < kSlowRequestTimeoutMs) continue;
+
+    qLog(Warning) << "Worker" << worker << "has been stuck on a request for" << (now - oldest) / 1000 << "seconds - restarting it and reassigning its requests";
+
+    QList<ReplyType*> replies = worker->handler_->TakeAllPendingReplies();
+    worker->request_sent_times_.clear();
+    RestartWorker(worker);
+
+    {
+      QMutexLocker l(&message_queue_mutex_);
+      for (ReplyType *reply : replies) {
+        message_queue_.prepend(reply);
+      }
     }
   }
 
-  return nullptr;
+  SendQueuedMessages();
 
 }
 
@@ -0,0 +1,150 @@
+/* This file is part of Strawberry.
+   Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+
+   Strawberry is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Strawberry is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "taglibbufferedstream.h"
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include "core/logging.h"
+
+// Sized for common tag layouts: ID3v2 with a typical embedded cover fits in the head buffer,
+// ID3v1 and APE tags fit in the tail buffer.  Larger tags fall through to plain file reads.
+const qint64 TagLibBufferedStream::kHeadBufferSize = 256 * 1024;
+const qint64 TagLibBufferedStream::kTailBufferSize = 64 * 1024;
+
+TagLibBufferedStream::TagLibBufferedStream(const QString &filename)
+    : file_(filename),
+#ifdef Q_OS_WIN32
+      name_(filename.toStdWString()),
+#else
+      name_(QFile::encodeName(filename)),
+#endif
+      length_(0),
+      position_(0) {
+
+  if (file_.open(QIODevice::ReadOnly)) {
+    length_ = file_.size();
+  }
+
+}
+
+TagLibBufferedStream::~TagLibBufferedStream() = default;
+
+TagLib::FileName TagLibBufferedStream::name() const {
+#ifdef Q_OS_WIN32
+  return name_.c_str();
+#else
+  return name_.constData();
+#endif
+}
+
+TagLib::ByteVector TagLibBufferedStream::readBlock(unsigned long length) {
+
+  if (!file_.isOpen() || position_ >= length_) return TagLib::ByteVector();
+
+  const qint64 len = qMin(static_cast<qint64>(length), length_ - position_);
+  if (len <= 0) return TagLib::ByteVector();
+
+  TagLib::ByteVector data;
+  if (ReadFromBuffer(&head_, 0, qMin(kHeadBufferSize, length_), len, &data)) {
+    return data;
+  }
+  if (ReadFromBuffer(&tail_, qMax(static_cast<qint64>(0), length_ - kTailBufferSize), qMin(kTailBufferSize, length_), len, &data)) {
+    return data;
+  }
+
+  // A read in the middle of the file, most likely audio properties scanning frames - read it directly.
+  if (!file_.seek(position_)) return TagLib::ByteVector();
+  const QByteArray direct_data = file_.read(len);
+  position_ += direct_data.size();
+
+  return TagLib::ByteVector(direct_data.constData(), static_cast<unsigned int>(direct_data.size()));
+
+}
+
+bool TagLibBufferedStream::ReadFromBuffer(QByteArray *buffer, const qint64 buffer_start, const qint64 buffer_size, const qint64 len, TagLib::ByteVector *data) {
+
+  if (position_ < buffer_start || position_ + len > buffer_start + buffer_size) return false;
+
+  if (buffer->isEmpty()) {
+    if (!file_.seek(buffer_start)) return false;
+    *buffer = file_.read(buffer_size);
+  }
+
+  if (position_ + len > buffer_start + buffer->size()) return false;
+
+  *data = TagLib::ByteVector(buffer->constData() + (position_ - buffer_start), static_cast<unsigned int>(len));
+  position_ += len;
+
+  return true;
+
+}
+
+bool TagLibBufferedStream::readOnly() const {
+  return true;
+}
+
+bool TagLibBufferedStream::isOpen() const {
+  return file_.isOpen();
+}
+
+void TagLibBufferedStream::seek(long offset, Position p) {
+
+  switch (p) {
+    case Beginning:
+      position_ = offset;
+      break;
+    case Current:
+      position_ += offset;
+      break;
+    case End:
+      position_ = length_ + offset;
+      break;
+  }
+
+}
+
+long TagLibBufferedStream::tell() const {
+  return static_cast<long>(position_);
+}
+
+long TagLibBufferedStream::length() {
+  return static_cast<long>(length_);
+}
+
+void TagLibBufferedStream::writeBlock(const TagLib::ByteVector &data) {
+  Q_UNUSED(data);
+  qLog(Error) << "Attempt to write through read-only tag stream";
+}
+
+void TagLibBufferedStream::insert(const TagLib::ByteVector &data, unsigned long start, unsigned long replace) {
+  Q_UNUSED(data); Q_UNUSED(start); Q_UNUSED(replace);
+  qLog(Error) << "Attempt to write through read-only tag stream";
+}
+
+void TagLibBufferedStream::removeBlock(unsigned long start, unsigned long length) {
+  Q_UNUSED(start); Q_UNUSED(length);
+  qLog(Error) << "Attempt to write through read-only tag stream";
+}
+
+void TagLibBufferedStream::truncate(long length) {
+  Q_UNUSED(length);
+  qLog(Error) << "Attempt to write through read-only tag stream";
+}
@@ -0,0 +1,79 @@
+/* This file is part of Strawberry.
+   Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+
+   Strawberry is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Strawberry is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TAGLIBBUFFEREDSTREAM_H
+#define TAGLIBBUFFEREDSTREAM_H
+
+#include <string>
+
+#include <taglib/taglib.h>
+#include <taglib/tiostream.h>
+#include <taglib/tbytevector.h>
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// A read-only TagLib stream that buffers the head and the tail of the file.
+// TagLib's own file stream seeks and reads a few bytes at a time while parsing tags, which costs dozens
+// of round trips per file on network filesystems.  Tags live at the start (ID3v2, Vorbis comments, MP4
+// atoms) and at the end (ID3v1, APE) of a file, so one large read of each area serves almost every
+// request from memory; only reads into the middle of the file fall through to the file itself.
+// The file size is read once when the stream is opened and reused for every seek and length query.
+class TagLibBufferedStream : public TagLib::IOStream {
+ public:
+  explicit TagLibBufferedStream(const QString &filename);
+  ~TagLibBufferedStream() override;
+
+  TagLib::FileName name() const override;
+  TagLib::ByteVector readBlock(unsigned long length) override;
+  bool readOnly() const override;
+  bool isOpen() const override;
+  void seek(long offset, Position p = Beginning) override;
+  long tell() const override;
+  long length() override;
+
+  // This stream is only used for reading tags, the write interface is not implemented.
+  void writeBlock(const TagLib::ByteVector &data) override;
+  void insert(const TagLib::ByteVector &data, unsigned long start = 0, unsigned long replace = 0) override;
+  void removeBlock(unsigned long start = 0, unsigned long length = 0) override;
+  void truncate(long length) override;
+
+ private:
+  // Serves the read from the given buffer, loading it with one large read the first time it is touched.
+  // Returns false when the requested range is not fully inside the buffer region.
+  bool ReadFromBuffer(QByteArray *buffer, const qint64 buffer_start, const qint64 buffer_size, const qint64 len, TagLib::ByteVector *data);
+
+  static const qint64 kHeadBufferSize;
+  static const qint64 kTailBufferSize;
+
+  QFile file_;
+#ifdef Q_OS_WIN32
+  std::wstring name_;
+#else
+  QByteArray name_;
+#endif
+  qint64 length_;
+  qint64 position_;
+  QByteArray head_;
+  QByteArray tail_;
+
+  Q_DISABLE_COPY(TagLibBufferedStream)
+};
+
+#endif  // TAGLIBBUFFEREDSTREAM_H
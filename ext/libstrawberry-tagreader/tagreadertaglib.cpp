@@ -97,6 +97,8 @@
 #include "core/messagehandler.h"
 #include "utilities/timeconstants.h"
 
+#include "taglibbufferedstream.h"
+
 class FileRefFactory {
  public:
   FileRefFactory() = default;
@@ -193,8 +195,9 @@ bool TagReaderTagLib::IsMediaFile(const QString &filename) const {
 
   qLog(Debug) << "Checking for valid file" << filename;
 
-  std::unique_ptr<TagLib::FileRef> fileref(factory_->GetFileRef(filename));
-  return fileref && !fileref->isNull() && fileref->file() && fileref->tag();
+  TagLibBufferedStream stream(filename);
+  const TagLib::FileRef fileref(&stream);
+  return !fileref.isNull() && fileref.file() && fileref.tag();
 
 }
 
@@ -253,7 +256,9 @@ bool TagReaderTagLib::ReadFile(const QString &filename, spb::tagreader::SongMeta
 
   song->set_lastseen(QDateTime::currentDateTime().toSecsSinceEpoch());
 
-  std::unique_ptr<TagLib::FileRef> fileref(factory_->GetFileRef(filename));
+  // Read through the buffered stream - during a scan the many small reads TagLib does per file add up.
+  TagLibBufferedStream stream(filename);
+  std::unique_ptr<TagLib::FileRef> fileref = std::make_unique<TagLib::FileRef>(&stream);
   if (fileref->isNull()) {
     qLog(Info) << "TagLib hasn't been able to read" << filename << "file";
     return false;
@@ -1121,11 +1126,8 @@ QByteArray TagReaderTagLib::LoadEmbeddedArt(const QString &filename) const {
 
   qLog(Debug) << "Loading art from" << filename;
 
-#ifdef Q_OS_WIN32
-  TagLib::FileRef fileref(filename.toStdWString().c_str());
-#else
-  TagLib::FileRef fileref(QFile::encodeName(filename).constData());
-#endif
+  TagLibBufferedStream stream(filename);
+  TagLib::FileRef fileref(&stream);
 
   if (fileref.isNull() || !fileref.file()) return QByteArray();
 
@@ -18,22 +18,59 @@
 
 #include "config.h"
 
+#include <cstring>
 #include <string>
 
 #include <QCoreApplication>
 #include <QObject>
 #include <QIODevice>
 #include <QByteArray>
+#include <QSharedMemory>
+#include <QString>
 
 #include "tagreaderworker.h"
 
+const qint64 TagReaderWorker::kSharedMemoryThreshold = 256 * 1024;
+const int TagReaderWorker::kMaxSharedMemorySegments = 32;
+
 TagReaderWorker::TagReaderWorker(QIODevice *socket, QObject *parent)
-    : AbstractMessageHandler<spb::tagreader::Message>(socket, parent) {}
+    : AbstractMessageHandler<spb::tagreader::Message>(socket, parent),
+      next_shared_memory_id_(0) {}
 
 void TagReaderWorker::MessageArrived(const spb::tagreader::Message &message) {
 
   spb::tagreader::Message reply;
 
+  // Batches are handled here rather than in HandleMessage so the fallback reader applies per file instead of to the whole batch.
+  if (message.has_read_file_batch_request()) {
+    const spb::tagreader::ReadFileBatchRequest &request = message.read_file_batch_request();
+    for (int i = 0; i < request.filename_size(); ++i) {
+      const QString filename = QString::fromUtf8(request.filename(i).data(), request.filename(i).size());
+      spb::tagreader::ReadFileResponse *response = reply.mutable_read_file_batch_response()->add_responses();
+      if (!tag_reader_.ReadFile(filename, response->mutable_metadata())) {
+#if defined(USE_TAGLIB)
+        tag_reader_gme_.ReadFile(filename, response->mutable_metadata());
+#endif
+      }
+    }
+    SendReply(message, &reply);
+    return;
+  }
+
+  if (message.has_is_media_file_batch_request()) {
+    const spb::tagreader::IsMediaFileBatchRequest &request = message.is_media_file_batch_request();
+    for (int i = 0; i < request.filename_size(); ++i) {
+      const QString filename = QString::fromUtf8(request.filename(i).data(), request.filename(i).size());
+      bool success = tag_reader_.IsMediaFile(filename);
+#if defined(USE_TAGLIB)
+      if (!success) success = tag_reader_gme_.IsMediaFile(filename);
+#endif
+      reply.mutable_is_media_file_batch_response()->add_success(success);
+    }
+    SendReply(message, &reply);
+    return;
+  }
+
   bool success = HandleMessage(message, reply, &tag_reader_);
   if (!success) {
 #if defined(USE_TAGLIB)
@@ -49,10 +86,38 @@ void TagReaderWorker::DeviceClosed() {
 
   AbstractMessageHandler<spb::tagreader::Message>::DeviceClosed();
 
+  qDeleteAll(shared_memory_segments_);
+  shared_memory_segments_.clear();
+
   QCoreApplication::exit();
 
 }
 
+bool TagReaderWorker::ShareData(const QByteArray &data, spb::tagreader::LoadEmbeddedArtResponse *response) {
+
+  QSharedMemory *memory = new QSharedMemory(QString("strawberry-tagreader-%1-%2").arg(QCoreApplication::applicationPid()).arg(next_shared_memory_id_++));
+  if (!memory->create(data.size())) {
+    delete memory;
+    return false;
+  }
+
+  memcpy(memory->data(), data.constData(), data.size());
+
+  // The segment must stay attached here until the client has attached on its side,
+  // the client does so as soon as the reply arrives, so keeping the most recent segments alive is sufficient.
+  shared_memory_segments_ << memory;
+  while (shared_memory_segments_.count() > kMaxSharedMemorySegments) {
+    delete shared_memory_segments_.takeFirst();
+  }
+
+  const QByteArray key_data = memory->key().toUtf8();
+  response->set_shared_memory_key(key_data.constData(), key_data.length());
+  response->set_shared_memory_size(data.size());
+
+  return true;
+
+}
+
 bool TagReaderWorker::HandleMessage(const spb::tagreader::Message &message, spb::tagreader::Message &reply, TagReaderBase *reader) {
 
   if (message.has_is_media_file_request()) {
@@ -74,7 +139,10 @@ bool TagReaderWorker::HandleMessage(const spb::tagreader::Message &message, spb:
   else if (message.has_load_embedded_art_request()) {
     const QString filename = QString::fromUtf8(message.load_embedded_art_request().filename().data(), message.load_embedded_art_request().filename().size());
     QByteArray data = reader->LoadEmbeddedArt(filename);
-    reply.mutable_load_embedded_art_response()->set_data(data.constData(), data.size());
+    // Large covers are passed through shared memory so they are not serialized and copied through the socket.
+    if (data.size() < kSharedMemoryThreshold || !ShareData(data, reply.mutable_load_embedded_art_response())) {
+      reply.mutable_load_embedded_art_response()->set_data(data.constData(), data.size());
+    }
     return true;
   }
   else if (message.has_save_embedded_art_request()) {
@@ -22,6 +22,8 @@
 #include "config.h"
 
 #include <QObject>
+#include <QList>
+#include <QSharedMemory>
 
 #include "core/messagehandler.h"
 #if defined(USE_TAGLIB)
@@ -49,12 +51,24 @@ class TagReaderWorker : public AbstractMessageHandler<spb::tagreader::Message> {
   // Handle message using specific TagReaderBase implementation. Returns true on successful message handle.
   bool HandleMessage(const spb::tagreader::Message &message, spb::tagreader::Message &reply, TagReaderBase* reader);
 
+  // Copies a large payload into a new shared memory segment and fills in the response's key and size fields.
+  // Returns false when the segment could not be created, in which case the payload must be sent inline.
+  bool ShareData(const QByteArray &data, spb::tagreader::LoadEmbeddedArtResponse *response);
+
+  // Payloads smaller than this are sent inline over the socket.
+  static const qint64 kSharedMemoryThreshold;
+  // How many shared memory segments are kept alive for the client to attach to before the oldest is dropped.
+  static const int kMaxSharedMemorySegments;
+
 #if defined(USE_TAGLIB)
   TagReaderTagLib tag_reader_;
   TagReaderGME tag_reader_gme_;
 #elif defined(USE_TAGPARSER)
   TagReaderTagParser tag_reader_;
 #endif
+
+  QList<QSharedMemory*> shared_memory_segments_;
+  int next_shared_memory_id_;
 };
 
 #endif  // TAGREADERWORKER_H
@@ -29,7 +29,11 @@
 #include <cstdint>
 
 #include <QWidget>
+#include <QWindow>
+#include <QGuiApplication>
+#include <QScreen>
 #include <QVector>
+#include <QImage>
 #include <QPainter>
 #include <QPalette>
 #include <QBasicTimer>
@@ -68,7 +72,7 @@ AnalyzerBase::~AnalyzerBase() {
 }
 
 void AnalyzerBase::showEvent(QShowEvent*) {
-  timer_.start(timeout(), this);
+  timer_.start(pacedTimeout(), this);
 }
 
 void AnalyzerBase::hideEvent(QHideEvent*) {
@@ -80,11 +84,24 @@ void AnalyzerBase::ChangeTimeout(const int timeout) {
   timeout_ = timeout;
   if (timer_.isActive()) {
     timer_.stop();
-    timer_.start(timeout_, this);
+    timer_.start(pacedTimeout(), this);
   }
 
 }
 
+int AnalyzerBase::pacedTimeout() const {
+
+  // There is no point rendering frames faster than the screen can display them.
+  int interval = timeout_;
+  const QScreen *screen = window()->windowHandle() ? window()->windowHandle()->screen() : QGuiApplication::primaryScreen();
+  if (screen && screen->refreshRate() > 0) {
+    interval = qMax(interval, qRound(1000.0 / screen->refreshRate()));
+  }
+
+  return interval;
+
+}
+
 void AnalyzerBase::transform(Scope &scope) {
 
   QVector<float> aux(fht_->size());
@@ -104,12 +121,42 @@ void AnalyzerBase::transform(Scope &scope) {
 
 void AnalyzerBase::paintEvent(QPaintEvent *e) {
 
+  Q_UNUSED(e)
+
+  // The spectrum and bars are only rasterized into the backing image when the frame timer fired.
+  // Repaints for any other reason - expose events, scrolling of overlapping widgets - are a plain blit of the last frame.
+  if (new_frame_ || canvas_.size() != size() * devicePixelRatioF()) {
+    renderCanvas();
+  }
+
   QPainter p(this);
-  p.fillRect(e->rect(), palette().color(QPalette::Window));
+  p.drawImage(0, 0, canvas_);
+
+  new_frame_ = false;
+
+}
+
+void AnalyzerBase::renderCanvas() {
+
+  const qreal dpr = devicePixelRatioF();
+  if (canvas_.size() != size() * dpr) {
+    canvas_ = QImage(size() * dpr, QImage::Format_RGB32);
+    canvas_.setDevicePixelRatio(dpr);
+  }
+
+  QPainter p(&canvas_);
+  p.fillRect(rect(), palette().color(QPalette::Window));
 
   switch (engine_->state()) {
     case EngineBase::State::Playing: {
-      const EngineBase::Scope &thescope = engine_->scope(timeout_);
+      // Prefer the lock-free scope ring, which the audio thread fills without involving the GUI thread.
+      // Engines that don't publish frames (VLC) still go through the legacy scope.
+      EngineBase::ScopeFrame frame;
+      const bool have_frame = engine_->LatestScopeFrame(&frame) && frame.sample_count >= fht_->size() * 2;
+      if (have_frame) {
+        scratch_scope_.assign(frame.samples, frame.samples + frame.sample_count);
+      }
+      const EngineBase::Scope &thescope = have_frame ? scratch_scope_ : engine_->scope(timeout_);
       int i = 0;
 
       // convert to mono here - our built in analyzers need mono, but the engines provide interleaved pcm
@@ -136,8 +183,6 @@ void AnalyzerBase::paintEvent(QPaintEvent *e) {
       demo(p);
   }
 
-  new_frame_ = false;
-
 }
 
 int AnalyzerBase::resizeExponent(int exp) {
@@ -254,6 +299,11 @@ void AnalyzerBase::timerEvent(QTimerEvent *e) {
     return;
   }
 
+  // Don't burn CPU on frames nobody can see.  hideEvent stops the timer, but a minimized window doesn't hide its children.
+  if (!isVisible() || window()->isMinimized()) {
+    return;
+  }
+
   new_frame_ = true;
   update();
 
@@ -36,6 +36,7 @@
 #include <QWidget>
 #include <QBasicTimer>
 #include <QString>
+#include <QImage>
 #include <QPainter>
 
 #include "analyzer/fht.h"
@@ -71,6 +72,10 @@ class AnalyzerBase : public QWidget {
 
   int resizeExponent(int);
   int resizeForBands(const int);
+  // The timer interval, clamped so we never try to render more frames than the screen refreshes.
+  int pacedTimeout() const;
+  // Rasterizes one frame (spectrum transform plus bar painting) into canvas_.
+  void renderCanvas();
   virtual void init() {}
   virtual void transform(Scope&);
   virtual void analyze(QPainter &p, const Scope&, const bool new_frame) = 0;
@@ -84,6 +89,9 @@ class AnalyzerBase : public QWidget {
   FHT *fht_;
   EngineBase *engine_;
   Scope lastscope_;
+  // Holds the samples copied out of the engine's scope ring each tick, kept as a member to avoid reallocating.
+  EngineBase::Scope scratch_scope_;
+  QImage canvas_;
 
   bool new_frame_;
   bool is_playing_;
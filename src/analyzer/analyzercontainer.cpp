@@ -22,6 +22,7 @@
 #include <chrono>
 
 #include <QObject>
+#include <QGuiApplication>
 #include <QWidget>
 #include <QVariant>
 #include <QString>
@@ -49,6 +50,7 @@ using namespace std::chrono_literals;
 
 const char *AnalyzerContainer::kSettingsGroup = "Analyzer";
 const char *AnalyzerContainer::kSettingsFramerate = "framerate";
+const char *AnalyzerContainer::kSettingsThrottleUnfocused = "throttle_unfocused";
 
 // Framerates
 const int AnalyzerContainer::kLowFramerate = 20;
@@ -63,8 +65,11 @@ AnalyzerContainer::AnalyzerContainer(QWidget *parent)
       context_menu_framerate_(new QMenu(tr("Framerate"), this)),
       group_(new QActionGroup(this)),
       group_framerate_(new QActionGroup(this)),
+      throttle_action_(nullptr),
       double_click_timer_(new QTimer(this)),
       ignore_next_click_(false),
+      throttle_unfocused_(true),
+      app_active_(qApp->applicationState() == Qt::ApplicationActive),
       current_analyzer_(nullptr),
       engine_(nullptr) {
 
@@ -79,6 +84,11 @@ AnalyzerContainer::AnalyzerContainer(QWidget *parent)
   AddFramerate(tr("Super high (%1 fps)").arg(kSuperHighFramerate), kSuperHighFramerate);
 
   context_menu_->addMenu(context_menu_framerate_);
+
+  throttle_action_ = context_menu_->addAction(tr("Reduce framerate when window is unfocused"));
+  throttle_action_->setCheckable(true);
+  QObject::connect(throttle_action_, &QAction::toggled, this, &AnalyzerContainer::ToggleThrottleUnfocused);
+
   context_menu_->addSeparator();
 
   AddAnalyzerType<BlockAnalyzer>();
@@ -97,6 +107,8 @@ AnalyzerContainer::AnalyzerContainer(QWidget *parent)
   double_click_timer_->setInterval(250ms);
   QObject::connect(double_click_timer_, &QTimer::timeout, this, &AnalyzerContainer::ShowPopupMenu);
 
+  QObject::connect(qApp, &QGuiApplication::applicationStateChanged, this, &AnalyzerContainer::ApplicationStateChanged);
+
   Load();
 
 }
@@ -153,7 +165,7 @@ void AnalyzerContainer::ChangeAnalyzer(const int id) {
   current_analyzer_->set_engine(engine_);
   // Even if it is not supposed to happen, I don't want to get a dbz error
   current_framerate_ = current_framerate_ == 0 ? kMediumFramerate : current_framerate_;
-  current_analyzer_->ChangeTimeout(1000 / current_framerate_);
+  current_analyzer_->ChangeTimeout(1000 / EffectiveFramerate());
 
   layout()->addWidget(current_analyzer_);
 
@@ -163,15 +175,56 @@ void AnalyzerContainer::ChangeAnalyzer(const int id) {
 
 void AnalyzerContainer::ChangeFramerate(int new_framerate) {
 
+  // Even if it is not supposed to happen, I don't want to get a dbz error
+  new_framerate = new_framerate == 0 ? kMediumFramerate : new_framerate;
+  SaveFramerate(new_framerate);
+
   if (current_analyzer_) {
-    // Even if it is not supposed to happen, I don't want to get a dbz error
-    new_framerate = new_framerate == 0 ? kMediumFramerate : new_framerate;
-    current_analyzer_->ChangeTimeout(1000 / new_framerate);
+    current_analyzer_->ChangeTimeout(1000 / EffectiveFramerate());
 
     // notify the current analyzer that the framerate has changed
     current_analyzer_->framerateChanged();
   }
-  SaveFramerate(new_framerate);
+
+}
+
+int AnalyzerContainer::EffectiveFramerate() const {
+
+  if (throttle_unfocused_ && !app_active_) {
+    return qMin(kLowFramerate, current_framerate_);
+  }
+  return current_framerate_;
+
+}
+
+void AnalyzerContainer::ApplyFramerate() {
+
+  if (current_analyzer_) {
+    current_analyzer_->ChangeTimeout(1000 / EffectiveFramerate());
+  }
+
+}
+
+void AnalyzerContainer::ToggleThrottleUnfocused(const bool enabled) {
+
+  throttle_unfocused_ = enabled;
+
+  QSettings s;
+  s.beginGroup(kSettingsGroup);
+  s.setValue(kSettingsThrottleUnfocused, throttle_unfocused_);
+  s.endGroup();
+
+  ApplyFramerate();
+
+}
+
+void AnalyzerContainer::ApplicationStateChanged(const Qt::ApplicationState state) {
+
+  const bool active = state == Qt::ApplicationActive;
+  if (active == app_active_) return;
+  app_active_ = active;
+
+  if (throttle_unfocused_) ApplyFramerate();
 
 }
 
@@ -181,8 +234,11 @@ void AnalyzerContainer::Load() {
   s.beginGroup(kSettingsGroup);
   QString type = s.value("type", "BlockAnalyzer").toString();
   current_framerate_ = s.value(kSettingsFramerate, kMediumFramerate).toInt();
+  throttle_unfocused_ = s.value(kSettingsThrottleUnfocused, true).toBool();
   s.endGroup();
 
+  throttle_action_->setChecked(throttle_unfocused_);
+
   // Analyzer
   if (type.isEmpty()) {
     DisableAnalyzer();
@@ -49,6 +49,7 @@ class AnalyzerContainer : public QWidget {
 
   static const char *kSettingsGroup;
   static const char *kSettingsFramerate;
+  static const char *kSettingsThrottleUnfocused;
 
  signals:
   void WheelEvent(const int delta);
@@ -62,6 +63,8 @@ class AnalyzerContainer : public QWidget {
   void ChangeFramerate(int new_framerate);
   void DisableAnalyzer();
   void ShowPopupMenu();
+  void ToggleThrottleUnfocused(const bool enabled);
+  void ApplicationStateChanged(const Qt::ApplicationState state);
 
  private:
   static const int kLowFramerate;
@@ -72,6 +75,9 @@ class AnalyzerContainer : public QWidget {
   void Load();
   void Save();
   void SaveFramerate(const int framerate);
+  // The framerate the current analyzer should actually run at - drops to the low rate while the application is in the background.
+  int EffectiveFramerate() const;
+  void ApplyFramerate();
   template<typename T>
   void AddAnalyzerType();
   void AddFramerate(const QString &name, const int framerate);
@@ -88,9 +94,13 @@ class AnalyzerContainer : public QWidget {
   QList<QAction*> actions_;
   QAction *disable_action_;
 
+  QAction *throttle_action_;
+
   QTimer *double_click_timer_;
   QPoint last_click_pos_;
   bool ignore_next_click_;
+  bool throttle_unfocused_;
+  bool app_active_;
 
   AnalyzerBase *current_analyzer_;
   EngineBase *engine_;
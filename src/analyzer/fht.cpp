@@ -63,12 +63,15 @@ void FHT::makeCasTable(void) {
 
 }
 
+// The hot loops below are written as plain indexed loops over contiguous arrays without pointer walking,
+// so the compiler can auto-vectorize them for whatever SIMD instruction set it targets.
+
 void FHT::scale(float *p, float d) const {
-  for (int i = 0; i < (num_ / 2); i++) *p++ *= d;
+  for (int i = 0; i < (num_ / 2); i++) p[i] *= d;
 }
 
 void FHT::ewma(float *d, float *s, float w) const {
-  for (int i = 0; i < (num_ / 2); i++, d++, s++) *d = *d * w + *s * (1 - w);
+  for (int i = 0; i < (num_ / 2); i++) d[i] = d[i] * w + s[i] * (1 - w);
 }
 
 void FHT::logSpectrum(float *out, float *p) {
@@ -101,9 +104,10 @@ void FHT::logSpectrum(float *out, float *p) {
 void FHT::semiLogSpectrum(float *p) {
 
   power2(p);
-  for (int i = 0; i < (num_ / 2); i++, p++) {
-    float e = 10.0F * static_cast<float>(log10(sqrt(*p / static_cast<float>(2))));
-    *p = e < 0 ? 0 : e;
+  // 10 * log10(sqrt(x / 2)) == 5 * log10(x / 2), saving the square root.
+  for (int i = 0; i < (num_ / 2); i++) {
+    float e = 5.0F * log10f(p[i] * 0.5F);
+    p[i] = e < 0 ? 0 : e;
   }
 
 }
@@ -111,8 +115,8 @@ void FHT::semiLogSpectrum(float *p) {
 void FHT::spectrum(float *p) {
 
   power2(p);
-  for (int i = 0; i < (num_ / 2); i++, p++) {
-    *p = static_cast<float>(sqrt(*p / 2));
+  for (int i = 0; i < (num_ / 2); i++) {
+    p[i] = sqrtf(p[i] * 0.5F);
   }
 
 }
@@ -120,7 +124,7 @@ void FHT::spectrum(float *p) {
 void FHT::power(float *p) {
 
   power2(p);
-  for (int i = 0; i < (num_ / 2); i++) *p++ /= 2;
+  for (int i = 0; i < (num_ / 2); i++) p[i] *= 0.5F;
 
 }
 
@@ -128,14 +132,10 @@ void FHT::power2(float *p) {
 
   _transform(p, num_, 0);
 
-  *p = static_cast<float>(2 * pow(*p, 2));
-  p++;
+  p[0] = 2 * p[0] * p[0];
 
-  float *q = p + num_ - 2;
   for (int i = 1; i < (num_ / 2); i++) {
-    *p = static_cast<float>(pow(*p, 2) + pow(*q, 2));
-    p++;
-    q--;
+    p[i] = p[i] * p[i] + p[num_ - i] * p[num_ - i];
   }
 
 }
@@ -187,39 +187,34 @@ void FHT::_transform(float *p, int n, int k) {
     return;
   }
 
-  int i = 0, j = 0, ndiv2 = n / 2;
-  float a = 0.0, *t1 = nullptr, *t2 = nullptr, *t3 = nullptr, *t4 = nullptr, *ptab = nullptr, *pp = nullptr;
+  const int ndiv2 = n / 2;
+  float *buf = buf_();
 
-  for (i = 0, t1 = buf_(), t2 = buf_() + ndiv2, pp = &p[k]; i < ndiv2; i++)
-    *t1++ = *pp++, *t2++ = *pp++;
+  for (int i = 0; i < ndiv2; i++) {
+    buf[i] = p[k + 2 * i];
+    buf[ndiv2 + i] = p[k + 2 * i + 1];
+  }
 
-  std::copy(buf_(), buf_() + n, p + k);
+  std::copy(buf, buf + n, p + k);
 
   _transform(p, ndiv2, k);
   _transform(p, ndiv2, k + ndiv2);
 
-  j = num_ / ndiv2 - 1;
-  t1 = buf_();
-  t2 = t1 + ndiv2;
-  t3 = p + k + ndiv2;
-  ptab = tab_();
-  pp = p + k;
-
-  a = *ptab++ * *t3++;
-  a += *ptab * *pp;
-  ptab += j;
+  const int stride = num_ / ndiv2;
+  const float *tab = tab_();
 
-  *t1++ = *pp + a;
-  *t2++ = *pp++ - a;
-
-  for (i = 1, t4 = p + k + n; i < ndiv2; i++, ptab += j) {
-    a = *ptab++ * *t3++;
-    a += *ptab * *--t4;
+  {
+    const float a = tab[0] * p[k + ndiv2] + tab[1] * p[k];
+    buf[0] = p[k] + a;
+    buf[ndiv2] = p[k] - a;
+  }
 
-    *t1++ = *pp + a;
-    *t2++ = *pp++ - a;
+  for (int i = 1; i < ndiv2; i++) {
+    const float a = tab[stride * i] * p[k + ndiv2 + i] + tab[stride * i + 1] * p[k + n - i];
+    buf[i] = p[k + i] + a;
+    buf[ndiv2 + i] = p[k + i] - a;
   }
 
-  std::copy(buf_(), buf_() + n, p + k);
+  std::copy(buf, buf + n, p + k);
 
 }
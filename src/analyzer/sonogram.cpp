@@ -31,53 +31,57 @@
 const char *Sonogram::kName = QT_TRANSLATE_NOOP("AnalyzerContainer", "Sonogram");
 
 Sonogram::Sonogram(QWidget *parent)
-    : AnalyzerBase(parent, 9) {}
+    : AnalyzerBase(parent, 9), head_(0) {}
 
 void Sonogram::resizeEvent(QResizeEvent *e) {
 
   Q_UNUSED(e)
 
-  canvas_ = QPixmap(size());
-  canvas_.fill(palette().color(QPalette::Window));
+  history_ = QImage(size(), QImage::Format_RGB32);
+  history_.fill(palette().color(QPalette::Window));
+  head_ = 0;
 
 }
 
 void Sonogram::analyze(QPainter &p, const Scope &s, bool new_frame) {
 
-  if (!new_frame || engine_->state() == EngineBase::State::Paused) {
-    p.drawPixmap(0, 0, canvas_);
-    return;
-  }
+  if (history_.isNull()) return;
 
-  QPainter canvas_painter(&canvas_);
-  canvas_painter.drawPixmap(0, 0, canvas_, 1, 0, width() - 1, -1);
+  if (new_frame && engine_->state() != EngineBase::State::Paused) {
 
-  Scope::const_iterator it = s.begin(), end = s.end();
+    // Write only the newest column into the ring buffer, the older columns stay where they are.
+    Scope::const_iterator it = s.begin(), end = s.end();
 
-  for (int y = height() - 1; y;) {
-    QColor c;
-    if (it >= end || *it < .005) {
-      c = palette().color(QPalette::Window);
-    }
-    else if (*it < .05) {
-      c.setHsv(95, 255, 255 - static_cast<int>(*it * 4000.0));
-    }
-    else if (*it < 1.0) {
-      c.setHsv(95 - static_cast<int>(*it * 90.0), 255, 255);
-    }
-    else {
-      c = Qt::red;
+    for (int y = height() - 1; y;) {
+      QColor c;
+      if (it >= end || *it < .005) {
+        c = palette().color(QPalette::Window);
+      }
+      else if (*it < .05) {
+        c.setHsv(95, 255, 255 - static_cast<int>(*it * 4000.0));
+      }
+      else if (*it < 1.0) {
+        c.setHsv(95 - static_cast<int>(*it * 90.0), 255, 255);
+      }
+      else {
+        c = Qt::red;
+      }
+
+      reinterpret_cast<QRgb*>(history_.scanLine(y--))[head_] = c.rgb();
+
+      if (it < end) ++it;
     }
 
-    canvas_painter.setPen(c);
-    canvas_painter.drawPoint(width() - 1, y--);
+    head_ = (head_ + 1) % history_.width();
 
-    if (it < end) ++it;
   }
 
-  canvas_painter.end();
-
-  p.drawPixmap(0, 0, canvas_);
+  // Composite the ring as two blits: the columns after head_ are the oldest and go on the left.
+  const int w = history_.width();
+  p.drawImage(0, 0, history_, head_, 0, w - head_, -1);
+  if (head_ > 0) {
+    p.drawImage(w - head_, 0, history_, 0, 0, head_, -1);
+  }
 
 }
 
@@ -24,7 +24,7 @@
 #ifndef SONOGRAM_H
 #define SONOGRAM_H
 
-#include <QPixmap>
+#include <QImage>
 #include <QPainter>
 
 #include "analyzerbase.h"
@@ -43,7 +43,10 @@ class Sonogram : public AnalyzerBase {
   void demo(QPainter &p) override;
 
  private:
-  QPixmap canvas_;
+  // Circular column buffer: each frame writes one column at head_ instead of shifting the whole image,
+  // the paint composites the ring as two blits.
+  QImage history_;
+  int head_;
 };
 
 #endif  // SONOGRAM_H
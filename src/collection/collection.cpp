@@ -41,6 +41,7 @@
 #include "collectionwatcher.h"
 #include "collectionbackend.h"
 #include "collectionmodel.h"
+#include "covermanager/albumcoverloader.h"
 #include "playlist/playlistmanager.h"
 #include "scrobbler/lastfmimport.h"
 #include "settings/collectionsettingspage.h"
@@ -49,6 +50,8 @@ const char *SCollection::kSongsTable = "songs";
 const char *SCollection::kFtsTable = "songs_fts";
 const char *SCollection::kDirsTable = "directories";
 const char *SCollection::kSubdirsTable = "subdirectories";
+// How many songs to fetch per chunk when paging through the whole table.
+const int SCollection::kSyncChunkSize = 500;
 
 SCollection::SCollection(Application *app, QObject *parent)
     : QObject(parent),
@@ -118,14 +121,18 @@ void SCollection::Init() {
   QObject::connect(watcher_, &CollectionWatcher::SongsReadded, backend_, &CollectionBackend::MarkSongsUnavailable);
   QObject::connect(watcher_, &CollectionWatcher::SubdirsDiscovered, backend_, &CollectionBackend::AddOrUpdateSubdirs);
   QObject::connect(watcher_, &CollectionWatcher::SubdirsMTimeUpdated, backend_, &CollectionBackend::AddOrUpdateSubdirs);
+  QObject::connect(watcher_, &CollectionWatcher::SubdirsCheckpointed, backend_, &CollectionBackend::AddFullScanCheckpoints);
+  QObject::connect(watcher_, &CollectionWatcher::FullScanCompleted, backend_, &CollectionBackend::ClearFullScanCheckpoints);
+  QObject::connect(watcher_, &CollectionWatcher::ScannedAlbumArt, this, &SCollection::ScannedAlbumArt);
   QObject::connect(watcher_, &CollectionWatcher::CompilationsNeedUpdating, backend_, &CollectionBackend::CompilationsNeedUpdating);
   QObject::connect(watcher_, &CollectionWatcher::UpdateLastSeen, backend_, &CollectionBackend::UpdateLastSeen);
 
-  QObject::connect(app_->lastfm_import(), &LastFMImport::UpdateLastPlayed, backend_, &CollectionBackend::UpdateLastPlayed);
+  QObject::connect(app_->lastfm_import(), &LastFMImport::UpdateLastPlayed, backend_, QOverload<const CollectionBackend::LastPlayedUpdateList&>::of(&CollectionBackend::UpdateLastPlayed));
   QObject::connect(app_->lastfm_import(), &LastFMImport::UpdatePlayCount, backend_, &CollectionBackend::UpdatePlayCount);
 
   // This will start the watcher checking for updates
   backend_->LoadDirectoriesAsync();
+  backend_->UpdateSortKeysAsync();
 
 }
 
@@ -182,6 +189,10 @@ void SCollection::ReloadSettings() {
   s.beginGroup(CollectionSettingsPage::kSettingsGroup);
   save_playcounts_to_files_ = s.value("save_playcounts", false).toBool();
   save_ratings_to_files_ = s.value("save_ratings", false).toBool();
+  // Serve browse and filter queries from an in-memory mirror of the songs table, mainly useful when the database sits on slow storage.
+  if (s.value("in_memory_mirror", false).toBool()) {
+    backend_->EnableInMemoryMirrorAsync();
+  }
   s.endGroup();
 
 }
@@ -201,13 +212,23 @@ void SCollection::SyncPlaycountAndRatingToFiles() {
   const int task_id = app_->task_manager()->StartTask(tr("Saving playcounts and ratings"));
   app_->task_manager()->SetTaskBlocksCollectionScans(task_id);
 
-  const SongList songs = backend_->GetAllSongs();
-  const qint64 nb_songs = songs.size();
+  // Get any buffered play statistics written to the database before reading it back out.
+  backend_->FlushPlayStatisticsAsync();
+
+  // Page through the songs table in chunks instead of materializing the whole collection while writing tags.
+  const int nb_songs = backend_->GetAllSongsCount();
   int i = 0;
-  for (const Song &song : songs) {
-    TagReaderClient::Instance()->UpdateSongPlaycountBlocking(song);
-    TagReaderClient::Instance()->UpdateSongRatingBlocking(song);
-    app_->task_manager()->SetTaskProgress(task_id, ++i, nb_songs);
+  int last_rowid = -1;
+  forever {
+    const SongList songs = backend_->GetSongsChunk(kSyncChunkSize, last_rowid);
+    if (songs.isEmpty()) break;
+    last_rowid = songs.last().id();
+    for (const Song &song : songs) {
+      TagReaderClient::Instance()->UpdateSongPlaycountBlocking(song);
+      TagReaderClient::Instance()->UpdateSongRatingBlocking(song);
+      app_->task_manager()->SetTaskProgress(task_id, ++i, nb_songs);
+    }
+    if (songs.count() < kSyncChunkSize) break;
   }
   app_->task_manager()->SetTaskFinished(task_id);
 
@@ -228,3 +249,19 @@ void SCollection::SongsRatingChanged(const SongList &songs, const bool save_tags
   }
 
 }
+
+void SCollection::ScannedAlbumArt(const SongList &songs) {
+
+  // Request the scaled image at the size the collection view uses, so the pre-warmed cache entries are the ones browsing will hit.
+  AlbumCoverLoaderOptions cover_options;
+  cover_options.get_image_data_ = false;
+  cover_options.get_image_ = true;
+  cover_options.scale_output_image_ = true;
+  cover_options.pad_output_image_ = true;
+  cover_options.desired_height_ = CollectionModel::kPrettyCoverSize;
+
+  for (const Song &song : songs) {
+    app_->album_cover_loader()->LoadImageAsync(cover_options, song, AlbumCoverLoader::Priority::Low);
+  }
+
+}
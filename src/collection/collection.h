@@ -49,12 +49,14 @@ class SCollection : public QObject {
   static const char *kFtsTable;
   static const char *kDirsTable;
   static const char *kSubdirsTable;
+  static const int kSyncChunkSize;
 
   void Init();
   void Exit();
 
   CollectionBackend *backend() const { return backend_; }
   CollectionModel *model() const { return model_; }
+  CollectionWatcher *watcher() const { return watcher_; }
 
   QString full_rescan_reason(int schema_version) const { return full_rescan_revisions_.value(schema_version, QString()); }
 
@@ -79,6 +81,8 @@ class SCollection : public QObject {
   void ExitReceived();
   void SongsPlaycountChanged(const SongList &songs, const bool save_tags = false);
   void SongsRatingChanged(const SongList &songs, const bool save_tags = false);
+  // Queues low priority cover loads for freshly scanned albums, so the scaled cover cache is warm before the first browse.
+  void ScannedAlbumArt(const SongList &songs);
 
  signals:
   void Error(const QString &error);
@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QApplication>
 #include <QThread>
+#include <QTimer>
 #include <QMutex>
 #include <QSet>
 #include <QMap>
@@ -56,12 +57,23 @@
 #include "collectionquery.h"
 #include "collectiontask.h"
 
+const int CollectionBackend::kSmartPlaylistQueryCacheSize = 8;
+const int CollectionBackend::kMaxDirtyCompilationAlbums = 512;
+// Long enough that the flush lands well inside the next song, short enough that little is lost on a crash.
+const int CollectionBackend::kPlayStatisticsFlushIntervalMs = 30 * 1000;
+
 CollectionBackend::CollectionBackend(QObject *parent)
     : CollectionBackendInterface(parent),
       db_(nullptr),
       task_manager_(nullptr),
       source_(Song::Source::Unknown),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      add_songs_batch_size_(128),
+      songs_chunk_size_(0),
+      songs_chunk_last_rowid_(-1),
+      compilations_all_dirty_(true),
+      mirror_ready_(false),
+      statistics_flush_timer_(nullptr) {
 
   original_thread_ = thread();
 
@@ -96,6 +108,8 @@ void CollectionBackend::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
 
+  FlushPlayStatistics();
+
   moveToThread(original_thread_);
   emit ExitFinished();
 
@@ -130,6 +144,57 @@ void CollectionBackend::UpdateTotalAlbumCountAsync() {
   QMetaObject::invokeMethod(this, "UpdateTotalAlbumCount", Qt::QueuedConnection);
 }
 
+void CollectionBackend::UpdateSortKeysAsync() {
+  QMetaObject::invokeMethod(this, "UpdateSortKeys", Qt::QueuedConnection);
+}
+
+void CollectionBackend::UpdateSortKeys() {
+
+  // Backfills the collation key columns for rows written before the schema had them.
+  // New and rescanned songs get their keys in Song::BindToQuery, so after the first run this finds nothing to do.
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  QList<int> rowids;
+  QStringList artists;
+  QStringList albums;
+  {
+    SqlQuery q(db);
+    q.prepare(QString("SELECT ROWID, effective_albumartist, album FROM %1 WHERE artist_sortkey IS NULL OR album_sortkey IS NULL").arg(songs_table_));
+    if (!q.Exec()) {
+      ReportErrors(q);
+      return;
+    }
+    while (q.next()) {
+      rowids << q.value(0).toInt();
+      artists << q.value(1).toString();
+      albums << q.value(2).toString();
+    }
+  }
+
+  if (rowids.isEmpty()) return;
+
+  qLog(Debug) << "Backfilling collation keys for" << rowids.count() << "songs in" << songs_table_;
+
+  ScopedTransaction transaction(&db);
+
+  SqlQuery update(db);
+  update.prepare(QString("UPDATE %1 SET artist_sortkey = :artist_sortkey, album_sortkey = :album_sortkey WHERE ROWID = :rowid").arg(songs_table_));
+  for (int i = 0; i < rowids.count(); ++i) {
+    update.BindValue(":artist_sortkey", Song::SortKeyForArtist(artists[i]));
+    update.BindValue(":album_sortkey", Song::SortKeyForArtist(albums[i]));
+    update.BindValue(":rowid", rowids[i]);
+    if (!update.Exec()) {
+      ReportErrors(update);
+      return;
+    }
+  }
+
+  transaction.Commit();
+
+}
+
 void CollectionBackend::IncrementPlayCountAsync(const int id) {
   QMetaObject::invokeMethod(this, "IncrementPlayCount", Qt::QueuedConnection, Q_ARG(int, id));
 }
@@ -138,6 +203,10 @@ void CollectionBackend::IncrementSkipCountAsync(const int id, const float progre
   QMetaObject::invokeMethod(this, "IncrementSkipCount", Qt::QueuedConnection, Q_ARG(int, id), Q_ARG(float, progress));
 }
 
+void CollectionBackend::FlushPlayStatisticsAsync() {
+  QMetaObject::invokeMethod(this, "FlushPlayStatistics", Qt::QueuedConnection);
+}
+
 void CollectionBackend::ResetPlayStatisticsAsync(const int id, const bool save_tags) {
   QMetaObject::invokeMethod(this, "ResetPlayStatistics", Qt::QueuedConnection, Q_ARG(int, id), Q_ARG(bool, save_tags));
 }
@@ -271,8 +340,9 @@ void CollectionBackend::UpdateTotalSongCount() {
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
+  // The count tables are maintained by triggers on the songs table, so this is constant time instead of a table scan.
   SqlQuery q(db);
-  q.prepare(QString("SELECT COUNT(*) FROM %1 WHERE unavailable = 0").arg(songs_table_));
+  q.prepare(QString("SELECT songs FROM %1_counts").arg(songs_table_));
   if (!q.Exec()) {
     db_->ReportErrors(q);
     return;
@@ -292,7 +362,7 @@ void CollectionBackend::UpdateTotalArtistCount() {
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
-  q.prepare(QString("SELECT COUNT(DISTINCT artist) FROM %1 WHERE unavailable = 0").arg(songs_table_));
+  q.prepare(QString("SELECT COUNT(*) FROM %1_artists").arg(songs_table_));
   if (!q.Exec()) {
     db_->ReportErrors(q);
     return;
@@ -312,7 +382,7 @@ void CollectionBackend::UpdateTotalAlbumCount() {
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
-  q.prepare(QString("SELECT COUNT(*) FROM (SELECT DISTINCT effective_albumartist, album FROM %1 WHERE unavailable = 0)").arg(songs_table_));
+  q.prepare(QString("SELECT COUNT(*) FROM %1_albums").arg(songs_table_));
   if (!q.Exec()) {
     db_->ReportErrors(q);
     return;
@@ -371,6 +441,18 @@ void CollectionBackend::RemoveDirectory(const CollectionDirectory &dir) {
     }
   }
 
+  // Delete any full scan checkpoints left for this directory
+  {
+    SqlQuery q(db);
+    q.prepare("DELETE FROM fullscan_checkpoints WHERE subdirs_table = :subdirs_table AND directory_id = :id");
+    q.BindValue(":subdirs_table", subdirs_table_);
+    q.BindValue(":id", dir.id);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
   // Now remove the directory itself
   {
     SqlQuery q(db);
@@ -434,6 +516,42 @@ SongList CollectionBackend::SongsWithMissingFingerprint(const int id) {
 
 }
 
+QString CollectionBackend::FileFingerprint(const QUrl &url) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare("SELECT fingerprint FROM file_fingerprints WHERE url = :url");
+  q.BindUrlValue(":url", url);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return QString();
+  }
+  if (!q.next()) {
+    return QString();
+  }
+
+  return q.value(0).toString();
+
+}
+
+void CollectionBackend::UpdateFileFingerprint(const QUrl &url, const QString &fingerprint) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare("INSERT OR REPLACE INTO file_fingerprints (url, fingerprint) VALUES (:url, :fingerprint)");
+  q.BindUrlValue(":url", url);
+  q.BindValue(":fingerprint", fingerprint);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+  }
+
+}
+
+
 void CollectionBackend::SongPathChanged(const Song &song, const QFileInfo &new_file, const std::optional<int> new_collection_directory_id) {
 
   // Take a song and update its path
@@ -512,6 +630,70 @@ void CollectionBackend::AddOrUpdateSubdirs(const CollectionSubdirectoryList &sub
 
 }
 
+CollectionSubdirectoryList CollectionBackend::GetFullScanCheckpoints(const int directory_id) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare("SELECT path, mtime FROM fullscan_checkpoints WHERE subdirs_table = :subdirs_table AND directory_id = :directory_id");
+  q.BindValue(":subdirs_table", subdirs_table_);
+  q.BindValue(":directory_id", directory_id);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return CollectionSubdirectoryList();
+  }
+
+  CollectionSubdirectoryList subdirs;
+  while (q.next()) {
+    CollectionSubdirectory subdir;
+    subdir.directory_id = directory_id;
+    subdir.path = q.value(0).toString();
+    subdir.mtime = q.value(1).toLongLong();
+    subdirs << subdir;
+  }
+
+  return subdirs;
+
+}
+
+void CollectionBackend::AddFullScanCheckpoints(const CollectionSubdirectoryList &subdirs) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  ScopedTransaction transaction(&db);
+  for (const CollectionSubdirectory &subdir : subdirs) {
+    SqlQuery q(db);
+    q.prepare("INSERT OR REPLACE INTO fullscan_checkpoints (subdirs_table, directory_id, path, mtime) VALUES (:subdirs_table, :directory_id, :path, :mtime)");
+    q.BindValue(":subdirs_table", subdirs_table_);
+    q.BindValue(":directory_id", subdir.directory_id);
+    q.BindValue(":path", subdir.path);
+    q.BindValue(":mtime", subdir.mtime);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+  transaction.Commit();
+
+}
+
+void CollectionBackend::ClearFullScanCheckpoints(const int directory_id) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare("DELETE FROM fullscan_checkpoints WHERE subdirs_table = :subdirs_table AND directory_id = :directory_id");
+  q.BindValue(":subdirs_table", subdirs_table_);
+  q.BindValue(":directory_id", directory_id);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+  }
+
+}
+
 SongList CollectionBackend::GetAllSongs() {
 
   QMutexLocker l(db_->Mutex());
@@ -534,12 +716,89 @@ SongList CollectionBackend::GetAllSongs() {
 
 }
 
+int CollectionBackend::GetAllSongsCount() {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QString("SELECT COUNT(*) FROM %1").arg(songs_table_));
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return 0;
+  }
+  if (!q.next()) return 0;
+
+  return q.value(0).toInt();
+
+}
+
+SongList CollectionBackend::GetSongsChunk(const int chunk_size, const int after_rowid) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE ROWID > :after_rowid ORDER BY ROWID LIMIT :limit").arg(songs_table_));
+  q.BindIntValue(":after_rowid", after_rowid);
+  q.BindIntValue(":limit", chunk_size);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return SongList();
+  }
+
+  SongList songs;
+  songs.reserve(chunk_size);
+  while (q.next()) {
+    Song song;
+    song.InitFromQuery(q, true);
+    songs << song;
+  }
+  return songs;
+
+}
+
+void CollectionBackend::GetAllSongsChunkedAsync(const int chunk_size) {
+  QMetaObject::invokeMethod(this, "GetAllSongsChunked", Qt::QueuedConnection, Q_ARG(int, chunk_size));
+}
+
+void CollectionBackend::NextSongsChunkAsync() {
+  QMetaObject::invokeMethod(this, "NextSongsChunk", Qt::QueuedConnection);
+}
+
+void CollectionBackend::GetAllSongsChunked(const int chunk_size) {
+
+  songs_chunk_size_ = chunk_size;
+  songs_chunk_last_rowid_ = -1;
+  NextSongsChunk();
+
+}
+
+void CollectionBackend::NextSongsChunk() {
+
+  if (songs_chunk_size_ <= 0) return;
+
+  const SongList songs = GetSongsChunk(songs_chunk_size_, songs_chunk_last_rowid_);
+  if (!songs.isEmpty()) {
+    songs_chunk_last_rowid_ = songs.last().id();
+  }
+
+  // A short chunk means the table is exhausted, stop the stream so a stray NextSongsChunkAsync doesn't restart it.
+  const bool last = songs.count() < songs_chunk_size_;
+  if (last) songs_chunk_size_ = 0;
+
+  emit SongsChunkReceived(songs, last);
+
+}
+
 void CollectionBackend::AddOrUpdateSongsAsync(const SongList &songs) {
   QMetaObject::invokeMethod(this, "AddOrUpdateSongs", Qt::QueuedConnection, Q_ARG(SongList, songs));
 }
 
 void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
+  MarkCompilationsDirty(songs);
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -548,13 +807,29 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
   SongList added_songs;
   SongList deleted_songs;
 
+  // Prepare the statements once and reuse them for the whole batch.
+  SqlQuery check_dir(db);
+  if (!dirs_table_.isEmpty()) {
+    check_dir.prepare(QString("SELECT ROWID FROM %1 WHERE ROWID = :id").arg(dirs_table_));
+  }
+  SqlQuery update_song(db);
+  update_song.prepare(QString("UPDATE %1 SET " + Song::kUpdateSpec + " WHERE ROWID = :id").arg(songs_table_));
+  SqlQuery update_fts(db);
+  update_fts.prepare(QString("UPDATE %1 SET " + Song::kFtsUpdateSpec + " WHERE ROWID = :id").arg(fts_table_));
+  // The GetSongById/GetSongBySongId helpers interpolate the id into the statement text, so going through them here would re-prepare for every song.
+  SqlQuery select_song_by_id(db);
+  select_song_by_id.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE ROWID = :id").arg(songs_table_));
+  SqlQuery select_song_by_song_id(db);
+  select_song_by_song_id.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE SONG_ID = :song_id").arg(songs_table_));
+
+  // New songs are collected and flushed with multi-row inserts.
+  SongList new_song_batch;
+
   for (const Song &song : songs) {
 
     // Do a sanity check first - make sure the song's directory still exists
     // This is to fix a possible race condition when a directory is removed while CollectionWatcher is scanning it.
     if (!dirs_table_.isEmpty()) {
-      SqlQuery check_dir(db);
-      check_dir.prepare(QString("SELECT ROWID FROM %1 WHERE ROWID = :id").arg(dirs_table_));
       check_dir.BindValue(":id", song.directory_id());
       if (!check_dir.Exec()) {
         db_->ReportErrors(check_dir);
@@ -568,30 +843,29 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
     if (song.id() != -1) {  // This song exists in the DB.
 
       // Get the previous song data first
-      Song old_song(GetSongById(song.id()));
+      select_song_by_id.BindValue(":id", song.id());
+      if (!select_song_by_id.Exec()) {
+        db_->ReportErrors(select_song_by_id);
+        return;
+      }
+      if (!select_song_by_id.next()) continue;
+      Song old_song(source_);
+      old_song.InitFromQuery(select_song_by_id, true);
       if (!old_song.is_valid()) continue;
 
       // Update
-      {
-        SqlQuery q(db);
-        q.prepare(QString("UPDATE %1 SET " + Song::kUpdateSpec + " WHERE ROWID = :id").arg(songs_table_));
-        song.BindToQuery(&q);
-        q.BindValue(":id", song.id());
-        if (!q.Exec()) {
-          db_->ReportErrors(q);
-          return;
-        }
+      song.BindToQuery(&update_song);
+      update_song.BindValue(":id", song.id());
+      if (!update_song.Exec()) {
+        db_->ReportErrors(update_song);
+        return;
       }
 
-      {
-        SqlQuery q(db);
-        q.prepare(QString("UPDATE %1 SET " + Song::kFtsUpdateSpec + " WHERE ROWID = :id").arg(fts_table_));
-        song.BindToFtsQuery(&q);
-        q.BindValue(":id", song.id());
-        if (!q.Exec()) {
-          db_->ReportErrors(q);
-          return;
-        }
+      song.BindToFtsQuery(&update_fts);
+      update_fts.BindValue(":id", song.id());
+      if (!update_fts.Exec()) {
+        db_->ReportErrors(update_fts);
+        return;
       }
 
       deleted_songs << old_song;
@@ -603,7 +877,15 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
     else if (!song.song_id().isEmpty()) {  // Song has a unique id, check if the song exists.
 
       // Get the previous song data first
-      Song old_song(GetSongBySongId(song.song_id()));
+      select_song_by_song_id.BindValue(":song_id", song.song_id());
+      if (!select_song_by_song_id.Exec()) {
+        db_->ReportErrors(select_song_by_song_id);
+        return;
+      }
+      Song old_song(source_);
+      if (select_song_by_song_id.next()) {
+        old_song.InitFromQuery(select_song_by_song_id, true);
+      }
 
       if (old_song.is_valid() && old_song.id() != -1) {
 
@@ -611,26 +893,18 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
         new_song.set_id(old_song.id());
 
         // Update
-        {
-          SqlQuery q(db);
-          q.prepare(QString("UPDATE %1 SET " + Song::kUpdateSpec + " WHERE ROWID = :id").arg(songs_table_));
-          new_song.BindToQuery(&q);
-          q.BindValue(":id", new_song.id());
-          if (!q.Exec()) {
-            db_->ReportErrors(q);
-            return;
-          }
+        new_song.BindToQuery(&update_song);
+        update_song.BindValue(":id", new_song.id());
+        if (!update_song.Exec()) {
+          db_->ReportErrors(update_song);
+          return;
         }
 
-        {
-          SqlQuery q(db);
-          q.prepare(QString("UPDATE %1 SET " + Song::kFtsUpdateSpec + " WHERE ROWID = :id").arg(fts_table_));
-          new_song.BindToFtsQuery(&q);
-          q.BindValue(":id", new_song.id());
-          if (!q.Exec()) {
-            db_->ReportErrors(q);
-            return;
-          }
+        new_song.BindToFtsQuery(&update_fts);
+        update_fts.BindValue(":id", new_song.id());
+        if (!update_fts.Exec()) {
+          db_->ReportErrors(update_fts);
+          return;
         }
 
         deleted_songs << old_song;
@@ -641,39 +915,16 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
     }
 
     // Create new song
-
-    int id = -1;
-    {  // Insert the row and create a new ID
-      SqlQuery q(db);
-      q.prepare(QString("INSERT INTO %1 (" + Song::kColumnSpec + ") VALUES (" + Song::kBindSpec + ")").arg(songs_table_));
-      song.BindToQuery(&q);
-      if (!q.Exec()) {
-        db_->ReportErrors(q);
-        return;
-      }
-      // Get the new ID
-      id = q.lastInsertId().toInt();
-    }
-
-    if (id == -1) return;
-
-    {  // Add to the FTS index
-      SqlQuery q(db);
-      q.prepare(QString("INSERT INTO %1 (ROWID, " + Song::kFtsColumnSpec + ") VALUES (:id, " + Song::kFtsBindSpec + ")").arg(fts_table_));
-      q.BindValue(":id", id);
-      song.BindToFtsQuery(&q);
-      if (!q.Exec()) {
-        db_->ReportErrors(q);
-        return;
-      }
+    new_song_batch << song;
+    if (new_song_batch.count() >= add_songs_batch_size_) {
+      if (!AddSongsBatch(db, new_song_batch, &added_songs)) return;
+      new_song_batch.clear();
     }
 
-    Song song_copy(song);
-    song_copy.set_id(id);
-    added_songs << song_copy;
-
   }
 
+  if (!AddSongsBatch(db, new_song_batch, &added_songs)) return;
+
   transaction.Commit();
 
   if (!deleted_songs.isEmpty()) emit SongsDeleted(deleted_songs);
@@ -685,12 +936,80 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
 }
 
+bool CollectionBackend::AddSongsBatch(QSqlDatabase &db, const SongList &songs, SongList *added_songs) {
+
+  if (songs.isEmpty()) return true;
+
+  // Build one multi-row VALUES statement with every placeholder suffixed by its row number.
+  QStringList song_rows;
+  QStringList fts_rows;
+  song_rows.reserve(songs.count());
+  fts_rows.reserve(songs.count());
+  for (int i = 0; i < songs.count(); ++i) {
+    const QString suffix = QString("_%1").arg(i);
+    QStringList binds;
+    binds.reserve(Song::kColumns.count());
+    for (const QString &column : Song::kColumns) {
+      binds << ":" + column + suffix;
+    }
+    song_rows << "(" + binds.join(", ") + ")";
+    QStringList fts_binds;
+    fts_binds.reserve(Song::kFtsColumns.count());
+    for (const QString &column : Song::kFtsColumns) {
+      fts_binds << ":" + column + suffix;
+    }
+    fts_rows << "(:id" + suffix + ", " + fts_binds.join(", ") + ")";
+  }
+
+  int first_id = -1;
+  {  // Insert the rows and create the new IDs
+    SqlQuery q(db);
+    q.prepare(QString("INSERT INTO %1 (" + Song::kColumnSpec + ") VALUES " + song_rows.join(", ")).arg(songs_table_));
+    for (int i = 0; i < songs.count(); ++i) {
+      songs[i].BindToQuery(&q, QString("_%1").arg(i));
+    }
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return false;
+    }
+    // SQLite assigns consecutive ROWIDs to the rows of a single INSERT inside a transaction, so the first ID can be derived from the last.
+    first_id = q.lastInsertId().toInt() - songs.count() + 1;
+  }
+
+  if (first_id <= 0) return false;
+
+  {  // Add to the FTS index
+    SqlQuery q(db);
+    q.prepare(QString("INSERT INTO %1 (ROWID, " + Song::kFtsColumnSpec + ") VALUES " + fts_rows.join(", ")).arg(fts_table_));
+    for (int i = 0; i < songs.count(); ++i) {
+      const QString suffix = QString("_%1").arg(i);
+      q.BindValue(":id" + suffix, first_id + i);
+      songs[i].BindToFtsQuery(&q, suffix);
+    }
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return false;
+    }
+  }
+
+  for (int i = 0; i < songs.count(); ++i) {
+    Song song_copy(songs[i]);
+    song_copy.set_id(first_id + i);
+    *added_songs << song_copy;
+  }
+
+  return true;
+
+}
+
 void CollectionBackend::UpdateSongsBySongIDAsync(const SongMap &new_songs) {
   QMetaObject::invokeMethod(this, "UpdateSongsBySongID", Qt::QueuedConnection, Q_ARG(SongMap, new_songs));
 }
 
 void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
+  MarkCompilationsDirty(new_songs.values());
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -840,6 +1159,8 @@ void CollectionBackend::UpdateMTimesOnly(const SongList &songs) {
 
 void CollectionBackend::DeleteSongs(const SongList &songs) {
 
+  MarkCompilationsDirty(songs);
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -847,6 +1168,8 @@ void CollectionBackend::DeleteSongs(const SongList &songs) {
   remove.prepare(QString("DELETE FROM %1 WHERE ROWID = :id").arg(songs_table_));
   SqlQuery remove_fts(db);
   remove_fts.prepare(QString("DELETE FROM %1 WHERE ROWID = :id").arg(fts_table_));
+  SqlQuery remove_fingerprint(db);
+  remove_fingerprint.prepare("DELETE FROM file_fingerprints WHERE url = :url");
 
   ScopedTransaction transaction(&db);
   for (const Song &song : songs) {
@@ -861,6 +1184,12 @@ void CollectionBackend::DeleteSongs(const SongList &songs) {
       db_->ReportErrors(remove_fts);
       return;
     }
+
+    remove_fingerprint.BindUrlValue(":url", song.url());
+    if (!remove_fingerprint.Exec()) {
+      db_->ReportErrors(remove_fingerprint);
+      return;
+    }
   }
   transaction.Commit();
 
@@ -874,6 +1203,8 @@ void CollectionBackend::DeleteSongs(const SongList &songs) {
 
 void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool unavailable) {
 
+  MarkCompilationsDirty(songs);
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -908,7 +1239,7 @@ QStringList CollectionBackend::GetAll(const QString &column, const CollectionFil
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
-  CollectionQuery query(db, songs_table_, fts_table_, filter_options);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), filter_options);
   query.SetColumnSpec("DISTINCT " + column);
   query.AddCompilationRequirement(false);
 
@@ -936,13 +1267,13 @@ QStringList CollectionBackend::GetAllArtistsWithAlbums(const CollectionFilterOpt
   QSqlDatabase db(db_->Connect());
 
   // Albums with 'albumartist' field set:
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
   query.SetColumnSpec("DISTINCT albumartist");
   query.AddCompilationRequirement(false);
   query.AddWhere("album", "", "!=");
 
   // Albums with no 'albumartist' (extract 'artist'):
-  CollectionQuery query2(db, songs_table_, fts_table_, opt);
+  CollectionQuery query2(db, songs_read_table(), fts_read_table(), opt);
   query2.SetColumnSpec("DISTINCT artist");
   query2.AddCompilationRequirement(false);
   query2.AddWhere("album", "", "!=");
@@ -983,7 +1314,7 @@ SongList CollectionBackend::GetArtistSongs(const QString &effective_albumartist,
   QSqlDatabase db(db_->Connect());
   QMutexLocker l(db_->Mutex());
 
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
   query.AddCompilationRequirement(false);
   query.AddWhere("effective_albumartist", effective_albumartist);
 
@@ -1001,7 +1332,7 @@ SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist,
   QSqlDatabase db(db_->Connect());
   QMutexLocker l(db_->Mutex());
 
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
   query.AddCompilationRequirement(false);
   query.AddWhere("effective_albumartist", effective_albumartist);
   query.AddWhere("album", album);
@@ -1013,61 +1344,232 @@ SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist,
 
   return songs;
 
-}
+}
+
+SongList CollectionBackend::GetSongsByAlbum(const QString &album, const CollectionFilterOptions &opt) {
+
+  QSqlDatabase db(db_->Connect());
+  QMutexLocker l(db_->Mutex());
+
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
+  query.AddCompilationRequirement(false);
+  query.AddWhere("album", album);
+
+  SongList songs;
+  if (!ExecCollectionQuery(&query, songs)) {
+    ReportErrors(query);
+  }
+
+  return songs;
+
+}
+
+bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &songs) {
+
+  query->SetColumnSpec("%songs_table.ROWID, " + Song::kColumnSpec);
+
+  if (!query->Exec()) return false;
+
+  while (query->Next()) {
+    Song song(source_);
+    song.InitFromQuery(*query, true);
+    songs << song;
+  }
+  return true;
+
+}
+
+bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &songs) {
+
+  query->SetColumnSpec("%songs_table.ROWID, " + Song::kColumnSpec);
+
+  if (!query->Exec()) return false;
+
+  while (query->Next()) {
+    Song song(source_);
+    song.InitFromQuery(*query, true);
+    songs.insert(song.song_id(), song);
+  }
+  return true;
+
+}
+
+Song CollectionBackend::GetSongById(const int id) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+  return GetSongById(id, db);
+
+}
+
+void CollectionBackend::EnableInMemoryMirrorAsync() {
+  QMetaObject::invokeMethod(this, "EnableInMemoryMirror", Qt::QueuedConnection);
+}
+
+void CollectionBackend::EnableInMemoryMirror() {
+
+  if (mirror_ready_) return;
+
+  mirror_alias_ = songs_table_ + "_mirror";
+
+  if (!db_->AttachInMemoryDatabase(mirror_alias_)) return;
+
+  {
+    QMutexLocker l(db_->Mutex());
+    QSqlDatabase db(db_->Connect());
+
+    if (!MirrorCloneTableSchema(db, songs_table_) || !MirrorCloneTableSchema(db, fts_table_)) return;
 
-SongList CollectionBackend::GetSongsByAlbum(const QString &album, const CollectionFilterOptions &opt) {
+    ScopedTransaction transaction(&db);
 
-  QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
+    {
+      SqlQuery q(db);
+      q.prepare(QString("INSERT INTO %1.%2 (ROWID, " + Song::kColumnSpec + ") SELECT ROWID, " + Song::kColumnSpec + " FROM %2").arg(mirror_alias_, songs_table_));
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+    }
+    {
+      SqlQuery q(db);
+      q.prepare(QString("INSERT INTO %1.%2 (ROWID, " + Song::kFtsColumnSpec + ") SELECT ROWID, " + Song::kFtsColumnSpec + " FROM %2").arg(mirror_alias_, fts_table_));
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+    }
 
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
-  query.AddCompilationRequirement(false);
-  query.AddWhere("album", album);
+    transaction.Commit();
 
-  SongList songs;
-  if (!ExecCollectionQuery(&query, songs)) {
-    ReportErrors(query);
+    mirror_ready_ = true;
   }
 
-  return songs;
+  qLog(Debug) << "Serving" << songs_table_ << "browse and filter queries from in-memory mirror" << mirror_alias_;
+
+  // Keep the mirror converged with the on-disk tables. Every write path announces the affected songs through one of these signals.
+  QObject::connect(this, &CollectionBackend::SongsDiscovered, this, &CollectionBackend::MirrorRefreshSongs);
+  QObject::connect(this, &CollectionBackend::SongsDeleted, this, &CollectionBackend::MirrorRefreshSongs);
+  QObject::connect(this, &CollectionBackend::SongsStatisticsChanged, this, &CollectionBackend::MirrorRefreshSongs);
+  QObject::connect(this, &CollectionBackend::SongsRatingChanged, this, &CollectionBackend::MirrorRefreshSongs);
+  QObject::connect(this, &CollectionBackend::DatabaseReset, this, &CollectionBackend::MirrorClear);
 
 }
 
-bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &songs) {
+bool CollectionBackend::MirrorCloneTableSchema(QSqlDatabase &db, const QString &table) {
 
-  query->SetColumnSpec("%songs_table.ROWID, " + Song::kColumnSpec);
+  {
+    SqlQuery q(db);
+    q.prepare(QString("SELECT name FROM %1.sqlite_master WHERE type = 'table' AND name = :name").arg(mirror_alias_));
+    q.BindValue(":name", table);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return false;
+    }
+    if (q.next()) return true;
+  }
 
-  if (!query->Exec()) return false;
+  QString schema;
+  {
+    SqlQuery q(db);
+    q.prepare("SELECT sql FROM sqlite_master WHERE type = 'table' AND name = :name");
+    q.BindValue(":name", table);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return false;
+    }
+    if (!q.next()) {
+      qLog(Error) << "No schema found for table" << table;
+      return false;
+    }
+    schema = q.value(0).toString();
+  }
 
-  while (query->Next()) {
-    Song song(source_);
-    song.InitFromQuery(*query, true);
-    songs << song;
+  // Rewrite "CREATE [VIRTUAL] TABLE <name>" so the table is created inside the mirror database instead.
+  static const QRegularExpression create_regexp("^CREATE (VIRTUAL )?TABLE ", QRegularExpression::CaseInsensitiveOption);
+  const QRegularExpressionMatch match = create_regexp.match(schema);
+  if (!match.hasMatch()) {
+    qLog(Error) << "Unexpected schema for table" << table << schema;
+    return false;
+  }
+  schema.insert(match.capturedEnd(0), mirror_alias_ + ".");
+
+  SqlQuery q(db);
+  q.prepare(schema);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return false;
   }
+
   return true;
 
 }
 
-bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &songs) {
+void CollectionBackend::MirrorRefreshSongs(const SongList &songs) {
 
-  query->SetColumnSpec("%songs_table.ROWID, " + Song::kColumnSpec);
+  if (!mirror_ready_) return;
 
-  if (!query->Exec()) return false;
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
 
-  while (query->Next()) {
-    Song song(source_);
-    song.InitFromQuery(*query, true);
-    songs.insert(song.song_id(), song);
+  ScopedTransaction transaction(&db);
+
+  SqlQuery delete_song(db);
+  delete_song.prepare(QString("DELETE FROM %1.%2 WHERE ROWID = :id").arg(mirror_alias_, songs_table_));
+  SqlQuery delete_fts(db);
+  delete_fts.prepare(QString("DELETE FROM %1.%2 WHERE ROWID = :id").arg(mirror_alias_, fts_table_));
+  SqlQuery copy_song(db);
+  copy_song.prepare(QString("INSERT INTO %1.%2 (ROWID, " + Song::kColumnSpec + ") SELECT ROWID, " + Song::kColumnSpec + " FROM %2 WHERE ROWID = :id").arg(mirror_alias_, songs_table_));
+  SqlQuery copy_fts(db);
+  copy_fts.prepare(QString("INSERT INTO %1.%2 (ROWID, " + Song::kFtsColumnSpec + ") SELECT ROWID, " + Song::kFtsColumnSpec + " FROM %2 WHERE ROWID = :id").arg(mirror_alias_, fts_table_));
+
+  for (const Song &song : songs) {
+    if (song.id() == -1) continue;
+    delete_song.BindValue(":id", song.id());
+    if (!delete_song.Exec()) {
+      db_->ReportErrors(delete_song);
+      return;
+    }
+    delete_fts.BindValue(":id", song.id());
+    if (!delete_fts.Exec()) {
+      db_->ReportErrors(delete_fts);
+      return;
+    }
+    copy_song.BindValue(":id", song.id());
+    if (!copy_song.Exec()) {
+      db_->ReportErrors(copy_song);
+      return;
+    }
+    copy_fts.BindValue(":id", song.id());
+    if (!copy_fts.Exec()) {
+      db_->ReportErrors(copy_fts);
+      return;
+    }
   }
-  return true;
+
+  transaction.Commit();
 
 }
 
-Song CollectionBackend::GetSongById(const int id) {
+void CollectionBackend::MirrorClear() {
+
+  if (!mirror_ready_) return;
 
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
-  return GetSongById(id, db);
+
+  ScopedTransaction transaction(&db);
+
+  const QStringList tables = QStringList() << songs_table_ << fts_table_;
+  for (const QString &table : tables) {
+    SqlQuery q(db);
+    q.prepare(QString("DELETE FROM %1.%2").arg(mirror_alias_, table));
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  transaction.Commit();
 
 }
 
@@ -1211,6 +1713,53 @@ SongList CollectionBackend::GetSongsByUrl(const QUrl &url, const bool unavailabl
 }
 
 
+SongList CollectionBackend::GetSongsByUrls(const QList<QUrl> &urls) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SongList ret;
+
+  // Four bound encodings per URL (same forms as GetSongByUrl()), chunked to stay under the SQLite variable limit per statement.
+  const int chunk_size = 200;
+  for (int start = 0; start < urls.count(); start += chunk_size) {
+
+    const int count = qMin(chunk_size, static_cast<int>(urls.count()) - start);
+
+    QStringList placeholders;
+    placeholders.reserve(count * 4);
+    for (int i = 0; i < count * 4; ++i) {
+      placeholders << QString(":url%1").arg(i);
+    }
+
+    SqlQuery q(db);
+    q.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE url IN (%2) AND beginning = 0 AND unavailable = 0").arg(songs_table_, placeholders.join(", ")));
+
+    for (int i = 0; i < count; ++i) {
+      const QUrl &url = urls[start + i];
+      q.BindValue(placeholders[i * 4], url);
+      q.BindValue(placeholders[i * 4 + 1], url.toString());
+      q.BindValue(placeholders[i * 4 + 2], url.toString(QUrl::FullyEncoded));
+      q.BindValue(placeholders[i * 4 + 3], url.toEncoded());
+    }
+
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return ret;
+    }
+
+    while (q.next()) {
+      Song song(source_);
+      song.InitFromQuery(q, true);
+      ret << song;
+    }
+
+  }
+
+  return ret;
+
+}
+
 Song CollectionBackend::GetSongBySongId(const QString &song_id) {
 
   QMutexLocker l(db_->Mutex());
@@ -1297,7 +1846,7 @@ SongList CollectionBackend::GetCompilationSongs(const QString &album, const Coll
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
   query.SetColumnSpec("%songs_table.ROWID, " + Song::kColumnSpec);
   query.AddCompilationRequirement(true);
   query.AddWhere("album", album);
@@ -1317,15 +1866,55 @@ SongList CollectionBackend::GetCompilationSongs(const QString &album, const Coll
 
 }
 
+void CollectionBackend::MarkCompilationsDirty(const SongList &songs) {
+
+  if (compilations_all_dirty_) return;
+
+  for (const Song &song : songs) {
+    if (song.album().isEmpty()) continue;
+    dirty_compilation_albums_ << song.album();
+    if (dirty_compilation_albums_.count() > kMaxDirtyCompilationAlbums) {
+      // Too many albums touched to be worth tracking, fall back to a full walk on the next update.
+      dirty_compilation_albums_.clear();
+      compilations_all_dirty_ = true;
+      return;
+    }
+  }
+
+}
+
 void CollectionBackend::CompilationsNeedUpdating() {
 
+  // Only albums touched since the last run need re-evaluating.
+  // The first run after startup walks everything once to catch changes made while the app was closed.
+  const bool full_update = compilations_all_dirty_;
+  const QStringList dirty_albums = QStringList(dirty_compilation_albums_.begin(), dirty_compilation_albums_.end());
+  compilations_all_dirty_ = false;
+  dirty_compilation_albums_.clear();
+
+  if (!full_update && dirty_albums.isEmpty()) return;
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   // Look for albums that have songs by more than one 'effective album artist' in the same directory
 
   SqlQuery q(db);
-  q.prepare(QString("SELECT effective_albumartist, album, url, compilation_detected FROM %1 WHERE unavailable = 0 ORDER BY album").arg(songs_table_));
+  if (full_update) {
+    q.prepare(QString("SELECT effective_albumartist, album, url, compilation_detected FROM %1 WHERE unavailable = 0 ORDER BY album").arg(songs_table_));
+  }
+  else {
+    // Albums in other directories that share a touched name are re-evaluated too, that's harmless and keeps the filter simple.
+    QStringList placeholders;
+    placeholders.reserve(dirty_albums.count());
+    for (int i = 0; i < dirty_albums.count(); ++i) {
+      placeholders << QString(":album%1").arg(i);
+    }
+    q.prepare(QString("SELECT effective_albumartist, album, url, compilation_detected FROM %1 WHERE unavailable = 0 AND album IN (%2) ORDER BY album").arg(songs_table_, placeholders.join(", ")));
+    for (int i = 0; i < dirty_albums.count(); ++i) {
+      q.BindStringValue(placeholders[i], dirty_albums[i]);
+    }
+  }
   if (!q.Exec()) {
     db_->ReportErrors(q);
     return;
@@ -1434,7 +2023,7 @@ CollectionBackend::AlbumList CollectionBackend::GetAlbums(const QString &artist,
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
-  CollectionQuery query(db, songs_table_, fts_table_, opt);
+  CollectionQuery query(db, songs_read_table(), fts_read_table(), opt);
   query.SetColumnSpec("url, effective_albumartist, album, compilation_effective, art_automatic, art_manual, filetype, cue_path");
   query.SetOrderBy("effective_albumartist, album, url");
 
@@ -1739,20 +2328,21 @@ void CollectionBackend::IncrementPlayCount(const int id) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  // Write-behind: the increment only goes into the buffer here, so no disk write happens at the track boundary.
+  // The UI is told right away with the buffered values merged in; the database catches up when the flush timer fires.
+  PendingPlayStatistics &pending = pending_play_statistics_[id];
+  ++pending.playcount_delta;
+  pending.lastplayed = QDateTime::currentDateTime().toSecsSinceEpoch();
 
-  SqlQuery q(db);
-  q.prepare(QString("UPDATE %1 SET playcount = playcount + 1, lastplayed = :now WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(":now", QDateTime::currentDateTime().toSecsSinceEpoch());
-  q.BindValue(":id", id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
+  Song song = GetSongById(id);
+  if (song.is_valid()) {
+    song.set_playcount(song.playcount() + pending.playcount_delta);
+    song.set_skipcount(song.skipcount() + pending.skipcount_delta);
+    song.set_lastplayed(pending.lastplayed);
+    emit SongsStatisticsPending(SongList() << song);
   }
 
-  Song new_song = GetSongById(id, db);
-  emit SongsStatisticsChanged(SongList() << new_song);
+  SchedulePlayStatisticsFlush();
 
 }
 
@@ -1762,19 +2352,68 @@ void CollectionBackend::IncrementSkipCount(const int id, const float progress) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
+  PendingPlayStatistics &pending = pending_play_statistics_[id];
+  ++pending.skipcount_delta;
 
-  SqlQuery q(db);
-  q.prepare(QString("UPDATE %1 SET skipcount = skipcount + 1 WHERE ROWID = :id").arg(songs_table_));
-  q.BindValue(":id", id);
-  if (!q.Exec()) {
-    db_->ReportErrors(q);
-    return;
+  Song song = GetSongById(id);
+  if (song.is_valid()) {
+    song.set_playcount(song.playcount() + pending.playcount_delta);
+    song.set_skipcount(song.skipcount() + pending.skipcount_delta);
+    if (pending.lastplayed != -1) song.set_lastplayed(pending.lastplayed);
+    emit SongsStatisticsPending(SongList() << song);
+  }
+
+  SchedulePlayStatisticsFlush();
+
+}
+
+void CollectionBackend::SchedulePlayStatisticsFlush() {
+
+  if (!statistics_flush_timer_) {
+    // Created on first use so the timer lives on the backend thread.
+    statistics_flush_timer_ = new QTimer(this);
+    statistics_flush_timer_->setSingleShot(true);
+    statistics_flush_timer_->setInterval(kPlayStatisticsFlushIntervalMs);
+    QObject::connect(statistics_flush_timer_, &QTimer::timeout, this, &CollectionBackend::FlushPlayStatistics);
+  }
+
+  statistics_flush_timer_->start();
+
+}
+
+void CollectionBackend::FlushPlayStatistics() {
+
+  if (pending_play_statistics_.isEmpty()) return;
+
+  const QHash<int, PendingPlayStatistics> pending = pending_play_statistics_;
+  pending_play_statistics_.clear();
+
+  SongList changed_songs;
+  {
+    QMutexLocker l(db_->Mutex());
+    QSqlDatabase db(db_->Connect());
+    ScopedTransaction transaction(&db);
+
+    SqlQuery q(db);
+    q.prepare(QString("UPDATE %1 SET playcount = playcount + :playcount_delta, skipcount = skipcount + :skipcount_delta, lastplayed = max(lastplayed, :lastplayed) WHERE ROWID = :id").arg(songs_table_));
+
+    for (QHash<int, PendingPlayStatistics>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+      q.BindValue(":playcount_delta", it.value().playcount_delta);
+      q.BindValue(":skipcount_delta", it.value().skipcount_delta);
+      q.BindValue(":lastplayed", it.value().lastplayed);
+      q.BindValue(":id", it.key());
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
+      changed_songs << GetSongById(it.key(), db);
+    }
+
+    transaction.Commit();
   }
 
-  Song new_song = GetSongById(id, db);
-  emit SongsStatisticsChanged(SongList() << new_song);
+  // This is what triggers the tag writes when saving playcounts to files is enabled, deliberately after the buffering window.
+  emit SongsStatisticsChanged(changed_songs);
 
 }
 
@@ -1808,6 +2447,9 @@ bool CollectionBackend::ResetPlayStatistics(const QStringList &id_str_list) {
 
   if (id_str_list.isEmpty()) return false;
 
+  // Buffered deltas for these rows would be re-applied after the reset, so write them out first.
+  FlushPlayStatistics();
+
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
@@ -1861,7 +2503,7 @@ void CollectionBackend::DeleteAll() {
 
 }
 
-SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &search) {
+SongList CollectionBackend::SmartPlaylistsFindSongs(SmartPlaylistSearch &search) {
 
   QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
@@ -1869,21 +2511,59 @@ SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &s
   // Build the query
   QString sql = search.ToSql(songs_table());
 
+  // Reuse the statement prepared on the previous refill when the SQL text is unchanged.
+  const QString cache_key = db.connectionName() + sql;
+  std::shared_ptr<SqlQuery> query = smart_playlist_queries_.value(cache_key);
+  const bool from_cache = !!query;
+  if (!query) {
+    query = std::make_shared<SqlQuery>(db);
+    query->prepare(sql);
+  }
+  if (search.has_keyset()) {
+    query->BindValue(":keyset_value", search.keyset_value_);
+    query->BindValue(":keyset_value2", search.keyset_value_);
+    query->BindIntValue(":keyset_rowid", search.keyset_rowid_);
+  }
+
   // Run the query
   SongList ret;
-  SqlQuery query(db);
-  query.prepare(sql);
-  if (!query.Exec()) {
-    db_->ReportErrors(query);
-    return ret;
+  if (!query->Exec()) {
+    smart_playlist_queries_.remove(cache_key);
+    if (from_cache) {
+      // The cached statement may belong to a connection that has since been closed, retry once with a fresh one.
+      query = std::make_shared<SqlQuery>(db);
+      query->prepare(sql);
+      if (search.has_keyset()) {
+        query->BindValue(":keyset_value", search.keyset_value_);
+        query->BindValue(":keyset_value2", search.keyset_value_);
+        query->BindIntValue(":keyset_rowid", search.keyset_rowid_);
+      }
+    }
+    if (!from_cache || !query->Exec()) {
+      db_->ReportErrors(*query);
+      return ret;
+    }
   }
 
   // Read the results
-  while (query.next()) {
+  while (query->next()) {
     Song song;
-    song.InitFromQuery(query, true);
+    song.InitFromQuery(*query, true);
     ret << song;
+    if (search.sort_type_ != SmartPlaylistSearch::SortType::Random) {
+      // Remember the boundary of this page, the sort column is selected after the regular song columns.
+      search.keyset_value_ = query->value(Song::kColumns.count() + 1);
+      search.keyset_rowid_ = song.id();
+    }
+  }
+
+  if (search.sort_type_ != SmartPlaylistSearch::SortType::Random) {
+    if (!smart_playlist_queries_.contains(cache_key) && smart_playlist_queries_.count() >= kSmartPlaylistQueryCacheSize) {
+      smart_playlist_queries_.clear();
+    }
+    smart_playlist_queries_.insert(cache_key, query);
   }
+
   return ret;
 
 }
@@ -1891,7 +2571,8 @@ SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &s
 SongList CollectionBackend::SmartPlaylistsGetAllSongs() {
 
   // Get all the songs!
-  return SmartPlaylistsFindSongs(SmartPlaylistSearch(SmartPlaylistSearch::SearchType::All, SmartPlaylistSearch::TermList(), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Artist, -1));
+  SmartPlaylistSearch search(SmartPlaylistSearch::SearchType::All, SmartPlaylistSearch::TermList(), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Artist, -1);
+  return SmartPlaylistsFindSongs(search);
 
 }
 
@@ -1954,8 +2635,70 @@ void CollectionBackend::UpdateLastPlayed(const QString &artist, const QString &a
 
 }
 
+void CollectionBackend::UpdateLastPlayed(const LastPlayedUpdateList &updates) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+  ScopedTransaction transaction(&db);
+
+  SqlQuery select_with_album(db);
+  select_with_album.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE artist = :artist COLLATE NOCASE AND album = :album COLLATE NOCASE AND title = :title COLLATE NOCASE").arg(songs_table_));
+  SqlQuery select_without_album(db);
+  select_without_album.prepare(QString("SELECT ROWID, " + Song::kColumnSpec + " FROM %1 WHERE artist = :artist COLLATE NOCASE AND title = :title COLLATE NOCASE").arg(songs_table_));
+  SqlQuery update(db);
+  update.prepare(QString("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
+
+  SongList changed_songs;
+
+  for (const LastPlayedUpdate &entry : updates) {
+
+    SqlQuery &select = entry.album.isEmpty() ? select_without_album : select_with_album;
+    select.BindValue(":artist", entry.artist);
+    if (!entry.album.isEmpty()) select.BindValue(":album", entry.album);
+    select.BindValue(":title", entry.title);
+    if (!select.Exec()) {
+      db_->ReportErrors(select);
+      return;
+    }
+
+    SongList songs;
+    while (select.next()) {
+      Song song(source_);
+      song.InitFromQuery(select, true);
+      songs << song;
+    }
+    if (songs.isEmpty()) {
+      qLog(Debug) << "Could not find a matching song in the database for" << entry.artist << entry.album << entry.title;
+      continue;
+    }
+
+    for (const Song &song : songs) {
+      if (song.lastplayed() >= entry.lastplayed) {
+        continue;
+      }
+      update.BindValue(":lastplayed", entry.lastplayed);
+      update.BindValue(":id", song.id());
+      if (!update.Exec()) {
+        db_->ReportErrors(update);
+        continue;
+      }
+    }
+
+    changed_songs << songs;
+
+  }
+
+  transaction.Commit();
+
+  if (!changed_songs.isEmpty()) emit SongsStatisticsChanged(changed_songs);
+
+}
+
 void CollectionBackend::UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags) {
 
+  // Buffered increments for these rows would stack on top of the imported value, so write them out first.
+  FlushPlayStatistics();
+
   SongList songs = GetSongsBy(artist, QString(), title);
   if (songs.isEmpty()) {
     qLog(Debug) << "Could not find a matching song in the database for" << artist << title;
@@ -2023,6 +2766,47 @@ void CollectionBackend::UpdateSongsRatingAsync(const QList<int> &ids, const floa
   QMetaObject::invokeMethod(this, "UpdateSongsRating", Qt::QueuedConnection, Q_ARG(QList<int>, ids), Q_ARG(float, rating), Q_ARG(bool, save_tags));
 }
 
+void CollectionBackend::UpdateTrackLoudnessAsync(const QUrl &url, const double track_gain, const double track_peak) {
+  QMetaObject::invokeMethod(this, "UpdateTrackLoudness", Qt::QueuedConnection, Q_ARG(QUrl, url), Q_ARG(double, track_gain), Q_ARG(double, track_peak));
+}
+
+void CollectionBackend::UpdateTrackLoudness(const QUrl &url, const double track_gain, const double track_peak) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QString("UPDATE %1 SET rg_track_gain = :rg_track_gain, rg_track_peak = :rg_track_peak WHERE url = :url").arg(songs_table_));
+  q.BindDoubleOrNullValue(":rg_track_gain", track_gain);
+  q.BindDoubleOrNullValue(":rg_track_peak", track_peak);
+  q.BindUrlValue(":url", url);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return;
+  }
+
+}
+
+void CollectionBackend::UpdateSongFingerprintAsync(const QUrl &url, const QString &fingerprint) {
+  QMetaObject::invokeMethod(this, "UpdateSongFingerprint", Qt::QueuedConnection, Q_ARG(QUrl, url), Q_ARG(QString, fingerprint));
+}
+
+void CollectionBackend::UpdateSongFingerprint(const QUrl &url, const QString &fingerprint) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(QString("UPDATE %1 SET fingerprint = :fingerprint WHERE url = :url").arg(songs_table_));
+  q.BindValue(":fingerprint", fingerprint);
+  q.BindUrlValue(":url", url);
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return;
+  }
+
+}
+
 void CollectionBackend::UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days) {
 
   {
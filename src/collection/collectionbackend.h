@@ -24,12 +24,15 @@
 
 #include "config.h"
 
+#include <memory>
 #include <optional>
 
 #include <QtGlobal>
 #include <QObject>
 #include <QFileInfo>
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -43,6 +46,7 @@
 #include "collectiondirectory.h"
 
 class QThread;
+class QTimer;
 class TaskManager;
 class Database;
 class SmartPlaylistSearch;
@@ -123,6 +127,8 @@ class CollectionBackendInterface : public QObject {
   // Returns a section of a song with the given filename and beginning. If the section is not present in collection, returns invalid song.
   // Using default beginning value is suitable when searching for single-section songs.
   virtual Song GetSongByUrl(const QUrl &url, const qint64 beginning = 0) = 0;
+  // Batch version of GetSongByUrl() with beginning 0, so playlist parsers can resolve a whole chunk of entries with one query. URLs not in the collection are simply absent from the result.
+  virtual SongList GetSongsByUrls(const QList<QUrl> &urls) = 0;
 
   virtual void AddDirectory(const QString &path) = 0;
   virtual void RemoveDirectory(const CollectionDirectory &dir) = 0;
@@ -135,6 +141,15 @@ class CollectionBackend : public CollectionBackendInterface {
 
   Q_INVOKABLE explicit CollectionBackend(QObject *parent = nullptr);
 
+  struct LastPlayedUpdate {
+    LastPlayedUpdate() : lastplayed(0) {}
+    QString artist;
+    QString album;
+    QString title;
+    qint64 lastplayed;
+  };
+  using LastPlayedUpdateList = QList<LastPlayedUpdate>;
+
   void Init(Database *db, TaskManager *task_manager, const Song::Source source, const QString &songs_table, const QString &fts_table, const QString &dirs_table = QString(), const QString &subdirs_table = QString());
   void Close();
 
@@ -151,6 +166,15 @@ class CollectionBackend : public CollectionBackendInterface {
   QString dirs_table() const { return dirs_table_; }
   QString subdirs_table() const { return subdirs_table_; }
 
+  // Table names read-only browse and filter queries should use.
+  // They point at the in-memory mirror once it is ready and fall back to the on-disk tables otherwise.
+  QString songs_read_table() const { return mirror_ready_ ? mirror_alias_ + "." + songs_table_ : songs_table_; }
+  QString fts_read_table() const { return mirror_ready_ ? mirror_alias_ + "." + fts_table_ : fts_table_; }
+
+  // Copies the songs and fts tables into a shared in-memory database and serves read-only browse and filter queries from it,
+  // so they never touch the disk or compete with backend writes. The mirror is kept up to date from the songs changed signals.
+  void EnableInMemoryMirrorAsync();
+
   // Get a list of directories in the collection.  Emits DirectoriesDiscovered.
   void LoadDirectoriesAsync() override;
 
@@ -158,13 +182,29 @@ class CollectionBackend : public CollectionBackendInterface {
   void UpdateTotalArtistCountAsync() override;
   void UpdateTotalAlbumCountAsync() override;
 
+  // One-time backfill of the persisted collation key columns for rows written before they existed.
+  void UpdateSortKeysAsync();
+
   SongList FindSongsInDirectory(const int id) override;
   SongList SongsWithMissingFingerprint(const int id) override;
+  // Cheap per-file content fingerprint cache used by the watcher to skip rereading tags on full rescans.
+  QString FileFingerprint(const QUrl &url);
+  void UpdateFileFingerprint(const QUrl &url, const QString &fingerprint);
+  // Completed-subdirectory checkpoints written while a full scan runs, so a scan interrupted by a crash can resume where it left off.
+  CollectionSubdirectoryList GetFullScanCheckpoints(const int directory_id);
   CollectionSubdirectoryList SubdirsInDirectory(const int id) override;
   CollectionDirectoryList GetAllDirectories() override;
   void ChangeDirPath(const int id, const QString &old_path, const QString &new_path) override;
 
   SongList GetAllSongs() override;
+  int GetAllSongsCount();
+  // Returns up to chunk_size songs with ROWID greater than after_rowid, in ROWID order.
+  // Callers page through the table by passing the id of the last returned song back in, so peak memory stays bounded by the chunk size.
+  SongList GetSongsChunk(const int chunk_size, const int after_rowid = -1);
+  // Streams the whole songs table as fixed size chunks through SongsChunkReceived.
+  // The next chunk is only read once the consumer asks for it with NextSongsChunkAsync, so a slow consumer never has chunks piling up in its event queue.
+  void GetAllSongsChunkedAsync(const int chunk_size);
+  void NextSongsChunkAsync();
 
   QStringList GetAll(const QString &column, const CollectionFilterOptions &filter_options = CollectionFilterOptions());
   QStringList GetAllArtists(const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
@@ -191,6 +231,7 @@ class CollectionBackend : public CollectionBackendInterface {
 
   SongList GetSongsByUrl(const QUrl &url, const bool unavailable = false) override;
   Song GetSongByUrl(const QUrl &url, qint64 beginning = 0) override;
+  SongList GetSongsByUrls(const QList<QUrl> &urls) override;
 
   void AddDirectory(const QString &path) override;
   void RemoveDirectory(const CollectionDirectory &dir) override;
@@ -200,6 +241,7 @@ class CollectionBackend : public CollectionBackendInterface {
 
   void IncrementPlayCountAsync(const int id);
   void IncrementSkipCountAsync(const int id, const float progress);
+  void FlushPlayStatisticsAsync();
   void ResetPlayStatisticsAsync(const int id, const bool save_tags = false);
   void ResetPlayStatisticsAsync(const QList<int> &id_list, const bool save_tags = false);
 
@@ -211,32 +253,49 @@ class CollectionBackend : public CollectionBackendInterface {
   SongList GetSongsByFingerprint(const QString &fingerprint) override;
 
   SongList SmartPlaylistsGetAllSongs();
-  SongList SmartPlaylistsFindSongs(const SmartPlaylistSearch &search);
+  // Updates the keyset boundary in the search from the last row returned, so the caller can feed the search back in for the next page.
+  SongList SmartPlaylistsFindSongs(SmartPlaylistSearch &search);
 
   void AddOrUpdateSongsAsync(const SongList &songs);
   void UpdateSongsBySongIDAsync(const SongMap &new_songs);
 
+  // Number of new songs inserted per multi-row INSERT statement in AddOrUpdateSongs.
+  void SetAddSongsBatchSize(const int batch_size) { add_songs_batch_size_ = batch_size; }
+
   void UpdateSongRatingAsync(const int id, const float rating, const bool save_tags = false);
   void UpdateSongsRatingAsync(const QList<int> &ids, const float rating, const bool save_tags = false);
 
+  void UpdateTrackLoudnessAsync(const QUrl &url, const double track_gain, const double track_peak);
+
+  void UpdateSongFingerprintAsync(const QUrl &url, const QString &fingerprint);
+
  public slots:
   void Exit();
+  void EnableInMemoryMirror();
   void LoadDirectories();
+  void GetAllSongsChunked(const int chunk_size);
+  void NextSongsChunk();
   void UpdateTotalSongCount();
   void UpdateTotalArtistCount();
   void UpdateTotalAlbumCount();
+  void UpdateSortKeys();
   void AddOrUpdateSongs(const SongList &songs);
   void UpdateSongsBySongID(const SongMap &new_songs);
   void UpdateMTimesOnly(const SongList &songs);
   void DeleteSongs(const SongList &songs);
   void MarkSongsUnavailable(const SongList &songs, const bool unavailable = true);
   void AddOrUpdateSubdirs(const CollectionSubdirectoryList &subdirs);
+  void AddFullScanCheckpoints(const CollectionSubdirectoryList &subdirs);
+  void ClearFullScanCheckpoints(const int directory_id);
   void CompilationsNeedUpdating();
   void UpdateManualAlbumArt(const QString &effective_albumartist, const QString &album, const QUrl &cover_url, const bool clear_art_automatic = false);
   void UpdateAutomaticAlbumArt(const QString &effective_albumartist, const QString &album, const QUrl &cover_url, const bool clear_art_manual = false);
   void ForceCompilation(const QString &album, const QList<QString> &artists, const bool on);
   void IncrementPlayCount(const int id);
   void IncrementSkipCount(const int id, const float progress);
+  // Writes the buffered playcount/skipcount deltas to the database in one transaction.
+  // Runs from the flush timer, on shutdown and before any operation that rewrites the same rows.
+  void FlushPlayStatistics();
   void ResetPlayStatistics(const int id, const bool save_tags = false);
   void ResetPlayStatistics(const QList<int> &id_list, const bool save_tags = false);
   bool ResetPlayStatistics(const QStringList &id_str_list);
@@ -245,11 +304,18 @@ class CollectionBackend : public CollectionBackendInterface {
 
   SongList GetSongsBy(const QString &artist, const QString &album, const QString &title);
   void UpdateLastPlayed(const QString &artist, const QString &album, const QString &title, const qint64 lastplayed);
+  // Batched version used by the last.fm import, one transaction and one statistics change signal for the whole list.
+  void UpdateLastPlayed(const LastPlayedUpdateList &updates);
   void UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags = false);
 
   void UpdateSongRating(const int id, const float rating, const bool save_tags = false);
   void UpdateSongsRating(const QList<int> &id_list, const float rating, const bool save_tags = false);
 
+  void UpdateTrackLoudness(const QUrl &url, const double track_gain, const double track_peak);
+
+  // Saves an acoustic fingerprint computed outside the watcher, so tagging the same file again never has to re-decode it.
+  void UpdateSongFingerprint(const QUrl &url, const QString &fingerprint);
+
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExpireSongs(const int directory_id, const int expire_unavailable_songs_days);
 
@@ -259,7 +325,11 @@ class CollectionBackend : public CollectionBackendInterface {
 
   void SongsDiscovered(const SongList &songs);
   void SongsDeleted(const SongList &songs);
+  void SongsChunkReceived(const SongList &songs, const bool last);
   void SongsStatisticsChanged(const SongList &songs, const bool save_tags = false);
+  // Immediate UI-only notification with buffered statistics merged in; no disk write has happened yet.
+  // SongsStatisticsChanged follows once FlushPlayStatistics writes the deltas out.
+  void SongsStatisticsPending(const SongList &songs);
 
   void DatabaseReset();
 
@@ -284,6 +354,10 @@ class CollectionBackend : public CollectionBackendInterface {
   };
 
   bool UpdateCompilations(const QSqlDatabase &db, SongList &deleted_songs, SongList &added_songs, const QUrl &url, const bool compilation_detected);
+  // Remembers the album names touched by a batch so CompilationsNeedUpdating only re-evaluates those albums.
+  void MarkCompilationsDirty(const SongList &songs);
+  // Inserts a batch of new songs with one multi-row VALUES statement and adds them to the FTS index.
+  bool AddSongsBatch(QSqlDatabase &db, const SongList &songs, SongList *added_songs);
   AlbumList GetAlbums(const QString &artist, const QString &album_artist, const bool compilation_required = false, const CollectionFilterOptions &opt = CollectionFilterOptions());
   AlbumList GetAlbums(const QString &artist, const bool compilation_required, const CollectionFilterOptions &opt = CollectionFilterOptions());
   CollectionSubdirectoryList SubdirsInDirectory(const int id, QSqlDatabase &db);
@@ -294,6 +368,12 @@ class CollectionBackend : public CollectionBackendInterface {
   Song GetSongBySongId(const QString &song_id, QSqlDatabase &db);
   SongList GetSongsBySongId(const QStringList &song_ids, QSqlDatabase &db);
 
+  // Creates an empty copy of a songs or fts table inside the mirror database, using the schema from the on-disk table.
+  bool MirrorCloneTableSchema(QSqlDatabase &db, const QString &table);
+  // Copies the given songs back from the on-disk tables into the mirror, so it does not matter which columns a write changed.
+  void MirrorRefreshSongs(const SongList &songs);
+  void MirrorClear();
+
  private:
   Database *db_;
   TaskManager *task_manager_;
@@ -303,6 +383,45 @@ class CollectionBackend : public CollectionBackendInterface {
   QString subdirs_table_;
   QString fts_table_;
   QThread *original_thread_;
+  int add_songs_batch_size_;
+
+  // In-memory mirror of the songs and fts tables serving read-only browse and filter queries.
+  // mirror_ready_ only ever flips from false to true; a reader that still sees the old value simply queries the on-disk tables.
+  QString mirror_alias_;
+  bool mirror_ready_;
+
+  // Position of the chunked streaming reader, only touched on the backend thread.
+  int songs_chunk_size_;
+  int songs_chunk_last_rowid_;
+
+  // Album names touched since the last compilation update, only touched on the backend thread.
+  // When compilations_all_dirty_ is set the next update walks every album, used for the first run and when the set overflows.
+  QSet<QString> dirty_compilation_albums_;
+  bool compilations_all_dirty_;
+
+  static const int kMaxDirtyCompilationAlbums;
+
+  static const int kSmartPlaylistQueryCacheSize;
+  // Prepared statements for smart playlist refills, keyed by connection name and SQL text.
+  // Keyset refills re-run identical SQL with new bound boundary values, so preparing once per generator is enough.
+  QHash<QString, std::shared_ptr<SqlQuery>> smart_playlist_queries_;
+
+  void SchedulePlayStatisticsFlush();
+
+  struct PendingPlayStatistics {
+    PendingPlayStatistics() : playcount_delta(0), skipcount_delta(0), lastplayed(-1) {}
+
+    int playcount_delta;
+    int skipcount_delta;
+    qint64 lastplayed;
+  };
+
+  // Write-behind buffer for play statistics, keyed by song ROWID, only touched on the backend thread.
+  // Deferring the writes keeps the database and tag files untouched in the track transition window.
+  QHash<int, PendingPlayStatistics> pending_play_statistics_;
+  QTimer *statistics_flush_timer_;
+
+  static const int kPlayStatisticsFlushIntervalMs;
 
 };
 
@@ -29,7 +29,7 @@
 #include "core/filesystemmusicstorage.h"
 #include "core/iconloader.h"
 #include "core/musicstorage.h"
-#include "utilities/diskutils.h"
+#include "core/storagecapacitypoller.h"
 #include "collectiondirectory.h"
 #include "collectionbackend.h"
 #include "collectiondirectorymodel.h"
@@ -37,10 +37,12 @@
 CollectionDirectoryModel::CollectionDirectoryModel(CollectionBackend *backend, QObject *parent)
     : QStandardItemModel(parent),
       dir_icon_(IconLoader::Load("document-open-folder")),
-      backend_(backend) {
+      backend_(backend),
+      capacity_poller_(new StorageCapacityPoller(this)) {
 
   QObject::connect(backend_, &CollectionBackend::DirectoryDiscovered, this, &CollectionDirectoryModel::DirectoryDiscovered);
   QObject::connect(backend_, &CollectionBackend::DirectoryDeleted, this, &CollectionDirectoryModel::DirectoryDeleted);
+  QObject::connect(capacity_poller_, &StorageCapacityPoller::CapacityChanged, this, &CollectionDirectoryModel::CapacityChanged);
 
 }
 
@@ -94,12 +96,28 @@ QVariant CollectionDirectoryModel::data(const QModelIndex &idx, int role) const
     case MusicStorage::Role_Storage:
     case MusicStorage::Role_StorageForceConnect:
       return QVariant::fromValue(storage_[idx.row()]);
+    // Served from the poller's cache so a sleeping network mount can't block the GUI thread, refreshed values arrive through dataChanged.
     case MusicStorage::Role_FreeSpace:
-      return Utilities::FileSystemFreeSpace(data(idx, Qt::DisplayRole).toString());
+      return capacity_poller_->FreeSpace(data(idx, Qt::DisplayRole).toString());
     case MusicStorage::Role_Capacity:
-      return Utilities::FileSystemCapacity(data(idx, Qt::DisplayRole).toString());
+      return capacity_poller_->Capacity(data(idx, Qt::DisplayRole).toString());
     default:
       return QStandardItemModel::data(idx, role);
   }
 
 }
+
+void CollectionDirectoryModel::CapacityChanged(const QString &path, const quint64 capacity, const quint64 free_space) {
+
+  Q_UNUSED(capacity)
+  Q_UNUSED(free_space)
+
+  for (int i = 0; i < rowCount(); ++i) {
+    QStandardItem *current_item = item(i, 0);
+    if (current_item && current_item->text() == path) {
+      emit dataChanged(current_item->index(), current_item->index());
+      break;
+    }
+  }
+
+}
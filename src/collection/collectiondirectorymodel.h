@@ -37,6 +37,7 @@ class QModelIndex;
 struct CollectionDirectory;
 class CollectionBackend;
 class MusicStorage;
+class StorageCapacityPoller;
 
 class CollectionDirectoryModel : public QStandardItemModel {
   Q_OBJECT
@@ -55,12 +56,15 @@ class CollectionDirectoryModel : public QStandardItemModel {
   // To be called by the backend
   void DirectoryDiscovered(const CollectionDirectory &directories);
   void DirectoryDeleted(const CollectionDirectory &directories);
+  // Emits dataChanged for the directory whose free space was refreshed in the background.
+  void CapacityChanged(const QString &path, const quint64 capacity, const quint64 free_space);
 
  private:
   static const int kIdRole = Qt::UserRole + 1;
 
   QIcon dir_icon_;
   CollectionBackend *backend_;
+  StorageCapacityPoller *capacity_poller_;
   QList<std::shared_ptr<MusicStorage>> storage_;
 };
 
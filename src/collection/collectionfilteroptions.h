@@ -31,7 +31,7 @@ class CollectionFilterOptions {
 
   // Filter mode:
   // - use the all songs table
-  // - use the duplicated songs view; by duplicated we mean those songs for which the (artist, album, title) tuple is found more than once in the songs table
+  // - use the duplicated songs view; by duplicated we mean songs sharing an (artist, album, title) tuple, songs sharing artist, title and length to the second across albums (typically the same song from different rips), or songs with identical acoustic fingerprints regardless of tags
   // - use the untagged songs view; by untagged we mean those for which at least one of the (artist, album, title) tags is empty
   // Please note that additional filtering based on FTS table (the filter attribute) won't work in Duplicates and Untagged modes.
   enum class FilterMode {
@@ -511,9 +511,16 @@ void CollectionFilterWidget::FilterTextChanged(const QString &text) {
   // Searching with one or two characters can be very expensive on the database even with FTS,
   // so if there are a large number of songs in the database introduce a small delay before actually filtering the model,
   // so if the user is typing the first few characters of something it will be quicker.
-  const bool delay = (delay_behaviour_ == DelayBehaviour::AlwaysDelayed) || (delay_behaviour_ == DelayBehaviour::DelayedOnLargeLibraries && !text.isEmpty() && text.length() < 3 && model_->total_song_count() >= 100000);
+  // Queries that have measured slow get the delay too, regardless of library size, so they don't pile up while typing.
+  const qint64 last_query_duration = model_->last_query_duration();
+  const bool slow_queries = last_query_duration >= kSlowQueryThreshold;
+  const bool delay = (delay_behaviour_ == DelayBehaviour::AlwaysDelayed) || (delay_behaviour_ == DelayBehaviour::DelayedOnLargeLibraries && !text.isEmpty() && (slow_queries || (text.length() < 3 && model_->total_song_count() >= 100000)));
 
   if (delay) {
+    // Scale the debounce with the measured query latency: fast storage reacts almost immediately, slow storage waits for the typing to settle.
+    if (last_query_duration >= 0) {
+      filter_delay_->setInterval(static_cast<int>(qBound<qint64>(kFilterDelayMin, last_query_duration * 2, kFilterDelayMax)));
+    }
     filter_delay_->start();
   }
   else {
@@ -52,7 +52,12 @@ class CollectionFilterWidget : public QWidget {
   explicit CollectionFilterWidget(QWidget *parent = nullptr);
   ~CollectionFilterWidget() override;
 
-  static const int kFilterDelay = 500;  // msec
+  static const int kFilterDelay = 500;  // msec, used until the first re-query has been timed
+  // The debounce adapts to measured query latency and is clamped to this range.
+  static const int kFilterDelayMin = 100;   // msec
+  static const int kFilterDelayMax = 1000;  // msec
+  // Queries slower than this get the debounce even on small libraries, so slow storage doesn't pile up re-queries.
+  static const int kSlowQueryThreshold = 200;  // msec
 
   enum class DelayBehaviour {
     AlwaysInstant,
@@ -40,14 +40,20 @@ class CollectionItem : public SimpleTreeItem<CollectionItem> {
   explicit CollectionItem(SimpleTreeModel<CollectionItem> *_model)
       : SimpleTreeItem<CollectionItem>(Type_Root, _model),
         container_level(-1),
+        song_count(0),
         compilation_artist_node_(nullptr) {}
 
   explicit CollectionItem(Type _type, CollectionItem *_parent = nullptr)
       : SimpleTreeItem<CollectionItem>(_type, _parent),
         container_level(-1),
+        song_count(0),
         compilation_artist_node_(nullptr) {}
 
   int container_level;
+  // Number of songs below this container, filled in from the grouped container query.  0 when unknown.
+  int song_count;
+  // Divider key of a top-level container, cached at creation so deletes don't recompute it.
+  QString divider_key;
   Song metadata;
   CollectionItem *compilation_artist_node_;
 
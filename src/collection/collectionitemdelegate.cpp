@@ -29,6 +29,7 @@
 #include <QString>
 #include <QLocale>
 #include <QPixmap>
+#include <QPixmapCache>
 #include <QIcon>
 #include <QPainter>
 #include <QPalette>
@@ -56,10 +57,6 @@ void CollectionItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem
   if (is_divider) {
     QString text(idx.data().toString());
 
-    painter->save();
-
-    QRect text_rect(opt.rect);
-
     // Does this item have an icon?
     QPixmap pixmap;
     QVariant decoration = idx.data(Qt::DecorationRole);
@@ -72,46 +69,67 @@ void CollectionItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem
       }
     }
 
-    // Draw the icon at the left of the text rectangle
-    if (!pixmap.isNull()) {
-      QRect icon_rect(text_rect.topLeft(), opt.decorationSize);
-      const int padding = (text_rect.height() - icon_rect.height()) / 2;
-      icon_rect.adjust(padding, padding, padding, padding);
-      text_rect.moveLeft(icon_rect.right() + padding + 6);
+    // Divider rows are repainted on every scroll frame, so the rendered row is cached and scrolling just blits it.
+    const qreal pixel_ratio = painter->device()->devicePixelRatioF();
+    const QString cache_key = QString::asprintf("collection_divider %d %d %d %d %x %llx ", opt.rect.width(), opt.rect.height(), static_cast<int>(pixel_ratio * 100), opt.decorationSize.width(), opt.palette.color(QPalette::Text).rgb(), static_cast<qulonglong>(pixmap.cacheKey())) + opt.font.key() + " " + text;
+
+    QPixmap divider_pixmap;
+    if (!QPixmapCache::find(cache_key, &divider_pixmap)) {
+
+      divider_pixmap = QPixmap(opt.rect.size() * pixel_ratio);
+      divider_pixmap.setDevicePixelRatio(pixel_ratio);
+      divider_pixmap.fill(Qt::transparent);
+
+      QPainter p(&divider_pixmap);
+
+      const QRect rect(QPoint(0, 0), opt.rect.size());
+      QRect text_rect(rect);
 
-      if (pixmap.size() != opt.decorationSize) {
-        pixmap = pixmap.scaled(opt.decorationSize, Qt::KeepAspectRatio);
+      // Draw the icon at the left of the text rectangle
+      if (!pixmap.isNull()) {
+        QRect icon_rect(rect.topLeft(), opt.decorationSize);
+        const int padding = (text_rect.height() - icon_rect.height()) / 2;
+        icon_rect.adjust(padding, padding, padding, padding);
+        text_rect.moveLeft(icon_rect.right() + padding + 6);
+
+        if (pixmap.size() != opt.decorationSize) {
+          pixmap = pixmap.scaled(opt.decorationSize, Qt::KeepAspectRatio);
+        }
+
+        p.drawPixmap(icon_rect, pixmap);
+      }
+      else {
+        text_rect.setLeft(text_rect.left() + 30);
       }
 
-      painter->drawPixmap(icon_rect, pixmap);
-    }
-    else {
-      text_rect.setLeft(text_rect.left() + 30);
+      // Draw the text
+      QFont bold_font(opt.font);
+      bold_font.setBold(true);
+
+      p.setPen(opt.palette.color(QPalette::Text));
+      p.setFont(bold_font);
+      p.drawText(text_rect, text);
+
+      // Draw the line under the item
+      QColor line_color = opt.palette.color(QPalette::Text);
+      QLinearGradient grad_color(rect.bottomLeft(), rect.bottomRight());
+      const double fade_start_end = (rect.width() / 3.0) / rect.width();
+      line_color.setAlphaF(0.0);
+      grad_color.setColorAt(0, line_color);
+      line_color.setAlphaF(0.5);
+      grad_color.setColorAt(fade_start_end, line_color);
+      grad_color.setColorAt(1.0 - fade_start_end, line_color);
+      line_color.setAlphaF(0.0);
+      grad_color.setColorAt(1, line_color);
+      p.setPen(QPen(grad_color, 1));
+      p.drawLine(rect.bottomLeft(), rect.bottomRight());
+
+      p.end();
+
+      QPixmapCache::insert(cache_key, divider_pixmap);
     }
 
-    // Draw the text
-    QFont bold_font(opt.font);
-    bold_font.setBold(true);
-
-    painter->setPen(opt.palette.color(QPalette::Text));
-    painter->setFont(bold_font);
-    painter->drawText(text_rect, text);
-
-    // Draw the line under the item
-    QColor line_color = opt.palette.color(QPalette::Text);
-    QLinearGradient grad_color(opt.rect.bottomLeft(), opt.rect.bottomRight());
-    const double fade_start_end = (opt.rect.width() / 3.0) / opt.rect.width();
-    line_color.setAlphaF(0.0);
-    grad_color.setColorAt(0, line_color);
-    line_color.setAlphaF(0.5);
-    grad_color.setColorAt(fade_start_end, line_color);
-    grad_color.setColorAt(1.0 - fade_start_end, line_color);
-    line_color.setAlphaF(0.0);
-    grad_color.setColorAt(1, line_color);
-    painter->setPen(QPen(grad_color, 1));
-    painter->drawLine(opt.rect.bottomLeft(), opt.rect.bottomRight());
-
-    painter->restore();
+    painter->drawPixmap(opt.rect.topLeft(), divider_pixmap);
   }
   else {
     QStyledItemDelegate::paint(painter, opt, idx);
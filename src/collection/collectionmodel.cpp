@@ -36,7 +36,9 @@
 #include <QFutureWatcher>
 #include <QDataStream>
 #include <QMimeData>
+#include <QPersistentModelIndex>
 #include <QIODevice>
+#include <QFile>
 #include <QList>
 #include <QSet>
 #include <QMap>
@@ -47,8 +49,6 @@
 #include <QUrl>
 #include <QImage>
 #include <QChar>
-#include <QRegularExpression>
-#include <QPixmapCache>
 #include <QNetworkDiskCache>
 #include <QSettings>
 #include <QStandardPaths>
@@ -57,6 +57,8 @@
 #include "core/database.h"
 #include "core/iconloader.h"
 #include "core/logging.h"
+#include "core/pixmapbudget.h"
+#include "core/trace.h"
 #include "core/taskmanager.h"
 #include "core/sqlrow.h"
 #include "collectionfilteroptions.h"
@@ -75,6 +77,13 @@
 const int CollectionModel::kPrettyCoverSize = 32;
 const char *CollectionModel::kPixmapDiskCacheDir = "pixmapcache";
 
+namespace {
+// Version 3: SqlRow serialization changed from two value maps to a value list plus name index.
+constexpr int kSnapshotVersion = 3;
+// Name this model's album art is accounted under in the global pixmap budget.
+constexpr char kPixmapBudgetConsumer[] = "collection";
+}
+
 QNetworkDiskCache *CollectionModel::sIconCache = nullptr;
 
 CollectionModel::CollectionModel(CollectionBackend *backend, Application *app, QObject *parent)
@@ -90,6 +99,9 @@ CollectionModel::CollectionModel(CollectionBackend *backend, Application *app, Q
       artist_icon_(IconLoader::Load("folder-sound")),
       album_icon_(IconLoader::Load("cdcase")),
       init_task_id_(-1),
+      reset_async_in_progress_(false),
+      reset_async_pending_(false),
+      last_query_duration_msec_(-1),
       use_pretty_covers_(true),
       show_dividers_(true),
       use_disk_cache_(false),
@@ -130,6 +142,7 @@ CollectionModel::CollectionModel(CollectionBackend *backend, Application *app, Q
   QObject::connect(backend_, &CollectionBackend::TotalArtistCountUpdated, this, &CollectionModel::TotalArtistCountUpdatedSlot);
   QObject::connect(backend_, &CollectionBackend::TotalAlbumCountUpdated, this, &CollectionModel::TotalAlbumCountUpdatedSlot);
   QObject::connect(backend_, &CollectionBackend::SongsStatisticsChanged, this, &CollectionModel::SongsSlightlyChanged);
+  QObject::connect(backend_, &CollectionBackend::SongsStatisticsPending, this, &CollectionModel::SongsSlightlyChanged);
   QObject::connect(backend_, &CollectionBackend::SongsRatingChanged, this, &CollectionModel::SongsSlightlyChanged);
 
   backend_->UpdateTotalSongCountAsync();
@@ -169,7 +182,8 @@ void CollectionModel::ReloadSettings() {
 
   use_disk_cache_ = s.value(CollectionSettingsPage::kSettingsDiskCacheEnable, false).toBool();
 
-  QPixmapCache::setCacheLimit(static_cast<int>(MaximumCacheSize(&s, CollectionSettingsPage::kSettingsCacheSize, CollectionSettingsPage::kSettingsCacheSizeUnit, CollectionSettingsPage::kSettingsCacheSizeDefault) / 1024));
+  // The cache size setting caps the artwork pixmaps of all views together, not just this model's.
+  PixmapBudget::SetBudget(MaximumCacheSize(&s, CollectionSettingsPage::kSettingsCacheSize, CollectionSettingsPage::kSettingsCacheSizeUnit, CollectionSettingsPage::kSettingsCacheSizeDefault));
 
   if (sIconCache) {
     sIconCache->setMaximumCacheSize(MaximumCacheSize(&s, CollectionSettingsPage::kSettingsDiskCacheSize, CollectionSettingsPage::kSettingsDiskCacheSizeUnit, CollectionSettingsPage::kSettingsDiskCacheSizeDefault));
@@ -186,12 +200,22 @@ void CollectionModel::ReloadSettings() {
 void CollectionModel::Init(const bool async) {
 
   if (async) {
-    // Show a loading indicator in the model.
-    CollectionItem *loading = new CollectionItem(CollectionItem::Type_LoadingIndicator, root_);
-    loading->display_text = tr("Loading...");
-    loading->lazy_loaded = true;
-    beginResetModel();
-    endResetModel();
+    // Try the binary snapshot from the last run first, so the user sees the collection immediately while the database query runs.
+    QueryResult snapshot;
+    if (LoadSnapshot(&snapshot)) {
+      BeginReset();
+      root_->lazy_loaded = true;
+      PostQuery(root_, snapshot, false);
+      endResetModel();
+    }
+    else {
+      // Show a loading indicator in the model.
+      CollectionItem *loading = new CollectionItem(CollectionItem::Type_LoadingIndicator, root_);
+      loading->display_text = tr("Loading...");
+      loading->lazy_loaded = true;
+      beginResetModel();
+      endResetModel();
+    }
 
     // Show a loading indicator in the status bar too.
     if (app_) {
@@ -521,11 +545,53 @@ void CollectionModel::SongsDeleted(const SongList &songs) {
 
     }
     else {
-      // If we get here it means some of the songs we want to delete haven't been lazy-loaded yet.
-      // This is bad, because it would mean that to clean up empty parents we would need to lazy-load them all individually to see if they're empty.
-      // This can take a very long time, so better to just reset the model and be done with it.
-      Reset();
-      return;
+      // The song hasn't been lazy-loaded yet.
+      // Instead of resetting the whole model, find the deepest container that was created for it and ask the database whether it still has songs below it.
+      // If it doesn't, queue it for the empty-parent cleanup below; if it does, nothing visible changes.
+      CollectionItem *container = root_;
+      QString key;
+      bool found = true;
+      for (int i = 0; i < 3; ++i) {
+        GroupBy group_by = group_by_[i];
+        if (group_by == GroupBy::None) break;
+
+        if (!key.isEmpty()) key.append("-");
+
+        if (IsArtistGroupBy(group_by) && song.is_compilation()) {
+          if (container->compilation_artist_node_ == nullptr) {
+            found = false;
+            break;
+          }
+          container = container->compilation_artist_node_;
+          key = container->key;
+        }
+        else {
+          key.append(ContainerKey(group_by, separate_albums_by_grouping_, song));
+          if (container_nodes_[i].contains(key)) {
+            container = container_nodes_[i][key];
+          }
+          else {
+            found = false;
+            break;
+          }
+        }
+
+        if (!container->lazy_loaded) break;
+      }
+
+      if (!found || container == root_) continue;  // Nothing in the tree refers to this song.
+
+      if (container->lazy_loaded) {
+        // The containers down to song level are loaded but the song node is missing - the tree is inconsistent, so play it safe and reset.
+        Reset();
+        return;
+      }
+
+      if (!ContainerHasSongs(container)) {
+        // The container has no children in the model, so the cleanup below will remove it and consider its parents.
+        parents << container;
+      }
+
     }
   }
 
@@ -543,8 +609,11 @@ void CollectionModel::SongsDeleted(const SongList &songs) {
       if (node->parent != root_) parents << node->parent;
 
       // Maybe consider its divider node
-      if (node->container_level == 0) {
-        divider_keys << DividerKey(group_by_[0], node);
+      if (node->container_level == 0 && !node->divider_key.isEmpty()) {
+        if (--divider_counts_[node->divider_key] <= 0) {
+          divider_counts_.remove(node->divider_key);
+          divider_keys << node->divider_key;
+        }
       }
 
       // Special case the Various Artists node
@@ -557,7 +626,7 @@ void CollectionModel::SongsDeleted(const SongList &songs) {
 
       // Remove from pixmap cache
       const QString cache_key = AlbumIconPixmapCacheKey(ItemToIndex(node));
-      QPixmapCache::remove(cache_key);
+      PixmapBudget::Remove(kPixmapBudgetConsumer, cache_key);
       if (use_disk_cache_ && sIconCache) sIconCache->remove(AlbumIconPixmapDiskCacheKey(cache_key));
       if (pending_cache_keys_.contains(cache_key)) {
         pending_cache_keys_.remove(cache_key);
@@ -580,16 +649,10 @@ void CollectionModel::SongsDeleted(const SongList &songs) {
     }
   }
 
-  // Delete empty dividers
+  // Delete dividers whose last container went away, the counts make the scan over all containers unnecessary.
   for (const QString &divider_key : std::as_const(divider_keys)) {
     if (!divider_nodes_.contains(divider_key)) continue;
 
-    // Look to see if there are any other items still under this divider
-    QList<CollectionItem*> container_nodes = container_nodes_[0].values();
-    if (std::any_of(container_nodes.begin(), container_nodes.end(), [this, divider_key](CollectionItem *node){ return DividerKey(group_by_[0], node) == divider_key; })) {
-      continue;
-    }
-
     // Remove the divider
     int row = divider_nodes_[divider_key]->row;
     beginRemoveRows(ItemToIndex(root_), row, row);
@@ -628,7 +691,7 @@ QVariant CollectionModel::AlbumIcon(const QModelIndex &idx) {
   const QString cache_key = AlbumIconPixmapCacheKey(idx);
 
   QPixmap cached_pixmap;
-  if (QPixmapCache::find(cache_key, &cached_pixmap)) {
+  if (PixmapBudget::Find(kPixmapBudgetConsumer, cache_key, &cached_pixmap)) {
     return cached_pixmap;
   }
 
@@ -638,7 +701,7 @@ QVariant CollectionModel::AlbumIcon(const QModelIndex &idx) {
     if (disk_cache_img) {
       QImage cached_image;
       if (cached_image.load(disk_cache_img.get(), "XPM")) {
-        QPixmapCache::insert(cache_key, QPixmap::fromImage(cached_image));
+        PixmapBudget::Insert(kPixmapBudgetConsumer, cache_key, QPixmap::fromImage(cached_image));
         return QPixmap::fromImage(cached_image);
       }
     }
@@ -678,12 +741,12 @@ void CollectionModel::AlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultP
   // Insert this image in the cache.
   if (!result->success || result->image_scaled.isNull() || result->type == AlbumCoverLoaderResult::Type::ManuallyUnset) {
     // Set the no_cover image so we don't continually try to load art.
-    QPixmapCache::insert(cache_key, no_cover_icon_);
+    PixmapBudget::Insert(kPixmapBudgetConsumer, cache_key, no_cover_icon_);
   }
   else {
     QPixmap image_pixmap;
     image_pixmap = QPixmap::fromImage(result->image_scaled);
-    QPixmapCache::insert(cache_key, image_pixmap);
+    PixmapBudget::Insert(kPixmapBudgetConsumer, cache_key, image_pixmap);
   }
 
   // If we have a valid cover not already in the disk cache
@@ -739,7 +802,12 @@ QVariant CollectionModel::data(const CollectionItem *item, const int role) const
 
   switch (role) {
     case Qt::DisplayRole:
+      return item->DisplayText();
+
     case Qt::ToolTipRole:
+      if (item->type == CollectionItem::Type_Container && item->song_count > 0) {
+        return QString("%1 (%2)").arg(item->DisplayText()).arg(item->song_count);
+      }
       return item->DisplayText();
 
     case Qt::DecorationRole:
@@ -817,11 +885,12 @@ QVariant CollectionModel::data(const CollectionItem *item, const int role) const
 
 bool CollectionModel::HasCompilations(const QSqlDatabase &db, const CollectionFilterOptions &filter_options, const CollectionQueryOptions &query_options) {
 
-  CollectionQuery q(db, backend_->songs_table(), backend_->fts_table(), filter_options);
+  CollectionQuery q(db, backend_->songs_read_table(), backend_->fts_read_table(), filter_options);
   q.SetColumnSpec(query_options.column_spec());
   for (const CollectionQueryOptions::Where &where_clauses : query_options.where_clauses()) {
     q.AddWhere(where_clauses.column, where_clauses.value, where_clauses.op);
   }
+  if (!query_options.group_by().isEmpty()) q.SetGroupBy(query_options.group_by());
   q.AddCompilationRequirement(true);
   q.SetLimit(1);
 
@@ -834,6 +903,38 @@ bool CollectionModel::HasCompilations(const QSqlDatabase &db, const CollectionFi
 
 }
 
+bool CollectionModel::ContainerHasSongs(CollectionItem *item) {
+
+  CollectionQueryOptions query_options;
+  query_options.set_column_spec("%songs_table.ROWID");
+
+  // Walk up through the item's parents adding filters as necessary
+  for (CollectionItem *p = item; p && p->type == CollectionItem::Type_Container; p = p->parent) {
+    AddQueryWhere(group_by_[p->container_level], separate_albums_by_grouping_, p, &query_options);
+  }
+
+  QMutexLocker l(backend_->db()->Mutex());
+  QSqlDatabase db(backend_->db()->Connect());
+
+  CollectionQuery q(db, backend_->songs_read_table(), backend_->fts_read_table(), filter_options_);
+  q.SetColumnSpec(query_options.column_spec());
+  for (const CollectionQueryOptions::Where &where_clauses : query_options.where_clauses()) {
+    q.AddWhere(where_clauses.column, where_clauses.value, where_clauses.op);
+  }
+  if (query_options.compilation_requirement() != CollectionQueryOptions::CompilationRequirement::None) {
+    q.AddCompilationRequirement(query_options.compilation_requirement() == CollectionQueryOptions::CompilationRequirement::On);
+  }
+  q.SetLimit(1);
+
+  if (!q.Exec()) {
+    backend_->ReportErrors(q);
+    return true;  // Play it safe and keep the container.
+  }
+
+  return q.Next();
+
+}
+
 CollectionQueryOptions CollectionModel::PrepareQuery(CollectionItem *parent) {
 
   // Information about what we want the children to be
@@ -861,6 +962,8 @@ CollectionQueryOptions CollectionModel::PrepareQuery(CollectionItem *parent) {
 
 CollectionModel::QueryResult CollectionModel::RunQuery(const CollectionFilterOptions &filter_options, const CollectionQueryOptions &query_options) {
 
+  TRACE_SCOPE("CollectionModel::RunQuery");
+
   QMutexLocker l(backend_->db()->Mutex());
 
   QueryResult result;
@@ -872,11 +975,13 @@ CollectionModel::QueryResult CollectionModel::RunQuery(const CollectionFilterOpt
       result.create_va = true;
     }
 
-    CollectionQuery q(db, backend_->songs_table(), backend_->fts_table(), filter_options);
+    CollectionQuery q(db, backend_->songs_read_table(), backend_->fts_read_table(), filter_options);
     q.SetColumnSpec(query_options.column_spec());
     for (const CollectionQueryOptions::Where &where_clauses : query_options.where_clauses()) {
       q.AddWhere(where_clauses.column, where_clauses.value, where_clauses.op);
     }
+    if (!query_options.group_by().isEmpty()) q.SetGroupBy(query_options.group_by());
+    if (!query_options.order_by().isEmpty()) q.SetOrderBy(query_options.order_by());
 
     if (result.create_va) {
       q.AddCompilationRequirement(false);
@@ -943,6 +1048,15 @@ void CollectionModel::LazyPopulate(CollectionItem *parent, const bool signal) {
 
 void CollectionModel::ResetAsync() {
 
+  // Never stack re-queries: while one is running only remember that another is wanted.
+  // The pending one runs with the latest filter options once the current query finishes, and the superseded result is discarded.
+  if (reset_async_in_progress_) {
+    reset_async_pending_ = true;
+    return;
+  }
+  reset_async_in_progress_ = true;
+  reset_query_timer_.start();
+
   CollectionQueryOptions query_options = PrepareQuery(root_);
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -962,6 +1076,16 @@ void CollectionModel::ResetAsyncQueryFinished() {
   const struct QueryResult result = watcher->result();
   watcher->deleteLater();
 
+  reset_async_in_progress_ = false;
+  last_query_duration_msec_ = reset_query_timer_.elapsed();
+
+  if (reset_async_pending_) {
+    // The filter changed while this query was running, skip applying the stale result and re-query with the current options.
+    reset_async_pending_ = false;
+    ResetAsync();
+    return;
+  }
+
   BeginReset();
   root_->lazy_loaded = true;
 
@@ -976,17 +1100,85 @@ void CollectionModel::ResetAsyncQueryFinished() {
 
   endResetModel();
 
+  SaveSnapshot(result);
+
+}
+
+QString CollectionModel::SnapshotFilePath() const {
+
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/collectionmodel-" + backend_->songs_table() + ".snapshot";
+
+}
+
+bool CollectionModel::LoadSnapshot(QueryResult *result) {
+
+  QFile file(SnapshotFilePath());
+  if (!file.exists() || !file.open(QIODevice::ReadOnly)) return false;
+
+  uchar *data = file.map(0, file.size());
+  if (!data) return false;
+
+  const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<int>(file.size()));
+  QDataStream stream(bytes);
+
+  int version = 0;
+  stream >> version;
+  if (version != kSnapshotVersion) return false;
+
+  // The snapshot is only valid for the group by settings it was saved with.
+  for (int i = 0; i < 3; ++i) {
+    int group_by = 0;
+    stream >> group_by;
+    if (group_by != static_cast<int>(group_by_[i])) return false;
+  }
+  bool separate_albums_by_grouping = false;
+  stream >> separate_albums_by_grouping;
+  if (separate_albums_by_grouping != separate_albums_by_grouping_) return false;
+
+  stream >> result->create_va;
+  stream >> result->rows;
+
+  return stream.status() == QDataStream::Ok && !result->rows.isEmpty();
+
+}
+
+void CollectionModel::SaveSnapshot(const QueryResult &result) {
+
+  // Only snapshot the full unfiltered top level.
+  if (filter_options_.filter_mode() != CollectionFilterOptions::FilterMode::All || !filter_options_.filter_text().isEmpty() || filter_options_.max_age() != -1) {
+    return;
+  }
+
+  QFile file(SnapshotFilePath());
+  if (!file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Unable to save collection model snapshot to" << file.fileName() << file.errorString();
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream << kSnapshotVersion;
+  for (int i = 0; i < 3; ++i) {
+    stream << static_cast<int>(group_by_[i]);
+  }
+  stream << separate_albums_by_grouping_;
+  stream << result.create_va;
+  stream << result.rows;
+
 }
 
 void CollectionModel::BeginReset() {
 
   beginResetModel();
-  delete root_;
+  // Destroying a tree with hundreds of thousands of nodes takes seconds, so hand the old tree to a worker thread.
+  // Nothing refers to the old nodes anymore once the maps below are cleared, so it can be torn down concurrently.
+  CollectionItem *old_root = root_;
+  (void)QtConcurrent::run([old_root]() { delete old_root; });
   song_nodes_.clear();
   container_nodes_[0].clear();
   container_nodes_[1].clear();
   container_nodes_[2].clear();
   divider_nodes_.clear();
+  divider_counts_.clear();
   pending_art_.clear();
   pending_cache_keys_.clear();
 
@@ -1010,91 +1202,103 @@ void CollectionModel::Reset() {
 void CollectionModel::SetQueryColumnSpec(const GroupBy group_by, const bool separate_albums_by_grouping, CollectionQueryOptions *query_options) {
 
   // Say what group_by of thing we want to get back from the database.
+  // Container levels only need the grouping columns plus a song count - full Song rows are only hydrated for the leaf (GroupBy::None) level.
+  QString group_columns;
   switch (group_by) {
     case GroupBy::AlbumArtist:
-      query_options->set_column_spec("DISTINCT effective_albumartist");
+      group_columns = "effective_albumartist";
       break;
     case GroupBy::Artist:
-      query_options->set_column_spec("DISTINCT artist");
+      group_columns = "artist";
       break;
-    case GroupBy::Album:{
-      QString query("DISTINCT album, album_id");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::Album:
+      group_columns = "album, album_id";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
-    case GroupBy::AlbumDisc:{
-      QString query("DISTINCT album, album_id, disc");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::AlbumDisc:
+      group_columns = "album, album_id, disc";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
-    case GroupBy::YearAlbum:{
-      QString query("DISTINCT year, album, album_id");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::YearAlbum:
+      group_columns = "year, album, album_id";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
-    case GroupBy::YearAlbumDisc:{
-      QString query("DISTINCT year, album, album_id, disc");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::YearAlbumDisc:
+      group_columns = "year, album, album_id, disc";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
-    case GroupBy::OriginalYearAlbum:{
-      QString query("DISTINCT year, originalyear, album, album_id");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::OriginalYearAlbum:
+      group_columns = "year, originalyear, album, album_id";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
-    case GroupBy::OriginalYearAlbumDisc:{
-      QString query("DISTINCT year, originalyear, album, album_id, disc");
-      if (separate_albums_by_grouping) query.append(", grouping");
-      query_options->set_column_spec(query);
+    case GroupBy::OriginalYearAlbumDisc:
+      group_columns = "year, originalyear, album, album_id, disc";
+      if (separate_albums_by_grouping) group_columns.append(", grouping");
       break;
-    }
     case GroupBy::Disc:
-      query_options->set_column_spec("DISTINCT disc");
+      group_columns = "disc";
       break;
     case GroupBy::Year:
-      query_options->set_column_spec("DISTINCT year");
+      group_columns = "year";
       break;
     case GroupBy::OriginalYear:
-      query_options->set_column_spec("DISTINCT effective_originalyear");
+      group_columns = "effective_originalyear";
       break;
     case GroupBy::Genre:
-      query_options->set_column_spec("DISTINCT genre");
+      group_columns = "genre";
       break;
     case GroupBy::Composer:
-      query_options->set_column_spec("DISTINCT composer");
+      group_columns = "composer";
       break;
     case GroupBy::Performer:
-      query_options->set_column_spec("DISTINCT performer");
+      group_columns = "performer";
       break;
     case GroupBy::Grouping:
-      query_options->set_column_spec("DISTINCT grouping");
+      group_columns = "grouping";
       break;
     case GroupBy::FileType:
-      query_options->set_column_spec("DISTINCT filetype");
+      group_columns = "filetype";
       break;
     case GroupBy::Format:
-      query_options->set_column_spec("DISTINCT filetype, samplerate, bitdepth");
+      group_columns = "filetype, samplerate, bitdepth";
       break;
     case GroupBy::Samplerate:
-      query_options->set_column_spec("DISTINCT samplerate");
+      group_columns = "samplerate";
       break;
     case GroupBy::Bitdepth:
-      query_options->set_column_spec("DISTINCT bitdepth");
+      group_columns = "bitdepth";
       break;
     case GroupBy::Bitrate:
-      query_options->set_column_spec("DISTINCT bitrate");
+      group_columns = "bitrate";
       break;
     case GroupBy::None:
     case GroupBy::GroupByCount:
       query_options->set_column_spec("%songs_table.ROWID, " + Song::kColumnSpec);
+      // Presort on the indexed collation keys so the sort model sees mostly ordered input.
+      query_options->set_order_by("artist_sortkey, album_sortkey, disc, track");
+      return;
+  }
+
+  // For the groupings that have a persisted collation key, select it so the containers don't have to recompute it,
+  // and let SQLite presort on the index. MAX() keeps rows written before the sortkey columns existed (NULL keys) from
+  // splitting their container, the model falls back to computing the key for those.
+  QString key_column;
+  switch (group_by) {
+    case GroupBy::AlbumArtist:
+      key_column = ", MAX(artist_sortkey) AS artist_sortkey";
+      query_options->set_order_by("artist_sortkey");
+      break;
+    case GroupBy::Album:
+      key_column = ", MAX(album_sortkey) AS album_sortkey";
+      query_options->set_order_by("album_sortkey");
+      break;
+    default:
       break;
   }
 
+  query_options->set_column_spec(group_columns + key_column + ", COUNT(*) AS container_songcount");
+  query_options->set_group_by(group_columns);
+
 }
 
 void CollectionModel::AddQueryWhere(const GroupBy group_by, const bool separate_albums_by_grouping, CollectionItem *item, CollectionQueryOptions *query_options) {
@@ -1235,7 +1439,9 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       item->metadata.set_albumartist(row.value(0).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = TextOrUnknown(item->metadata.albumartist());
-      item->sort_text = SortTextForArtist(item->metadata.albumartist());
+      // Use the collation key persisted at scan time, fall back to computing it for rows written before the sortkey columns existed.
+      item->sort_text = row.value("artist_sortkey").toString();
+      if (item->sort_text.isEmpty()) item->sort_text = SortTextForArtist(item->metadata.albumartist());
       break;
     }
     case GroupBy::Artist:{
@@ -1248,17 +1454,18 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
     case GroupBy::Album:{
       item->metadata.set_album(row.value(0).toString());
       item->metadata.set_album_id(row.value(1).toString());
-      item->metadata.set_grouping(row.value(2).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(2).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = TextOrUnknown(item->metadata.album());
-      item->sort_text = SortTextForArtist(item->metadata.album());
+      item->sort_text = row.value("album_sortkey").toString();
+      if (item->sort_text.isEmpty()) item->sort_text = SortTextForArtist(item->metadata.album());
       break;
     }
     case GroupBy::AlbumDisc:{
       item->metadata.set_album(row.value(0).toString());
       item->metadata.set_album_id(row.value(1).toString());
       item->metadata.set_disc(row.value(2).toInt());
-      item->metadata.set_grouping(row.value(3).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(3).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = PrettyAlbumDisc(item->metadata.album(), item->metadata.disc());
       item->sort_text = item->metadata.album() + SortTextForNumber(std::max(0, item->metadata.disc()));
@@ -1268,7 +1475,7 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       item->metadata.set_year(row.value(0).toInt());
       item->metadata.set_album(row.value(1).toString());
       item->metadata.set_album_id(row.value(2).toString());
-      item->metadata.set_grouping(row.value(3).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(3).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = PrettyYearAlbum(item->metadata.year(), item->metadata.album());
       item->sort_text = SortTextForNumber(std::max(0, item->metadata.year())) + item->metadata.grouping() + item->metadata.album();
@@ -1279,7 +1486,7 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       item->metadata.set_album(row.value(1).toString());
       item->metadata.set_album_id(row.value(2).toString());
       item->metadata.set_disc(row.value(3).toInt());
-      item->metadata.set_grouping(row.value(4).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(4).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = PrettyYearAlbumDisc(item->metadata.year(), item->metadata.album(), item->metadata.disc());
       item->sort_text = SortTextForNumber(std::max(0, item->metadata.year())) + item->metadata.album() + SortTextForNumber(std::max(0, item->metadata.disc()));
@@ -1290,7 +1497,7 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       item->metadata.set_originalyear(row.value(1).toInt());
       item->metadata.set_album(row.value(2).toString());
       item->metadata.set_album_id(row.value(3).toString());
-      item->metadata.set_grouping(row.value(4).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(4).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = PrettyYearAlbum(item->metadata.effective_originalyear(), item->metadata.album());
       item->sort_text = SortTextForNumber(std::max(0, item->metadata.effective_originalyear())) + item->metadata.grouping() + item->metadata.album();
@@ -1302,7 +1509,7 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       item->metadata.set_album(row.value(2).toString());
       item->metadata.set_album_id(row.value(3).toString());
       item->metadata.set_disc(row.value(4).toInt());
-      item->metadata.set_grouping(row.value(5).toString());
+      if (separate_albums_by_grouping) item->metadata.set_grouping(row.value(5).toString());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, item->metadata));
       item->display_text = PrettyYearAlbumDisc(item->metadata.effective_originalyear(), item->metadata.album(), item->metadata.disc());
       item->sort_text = SortTextForNumber(std::max(0, item->metadata.effective_originalyear())) + item->metadata.album() + SortTextForNumber(std::max(0, item->metadata.disc()));
@@ -1415,6 +1622,10 @@ CollectionItem *CollectionModel::ItemFromQuery(const GroupBy group_by, const boo
       break;
   }
 
+  if (group_by != GroupBy::None && group_by != GroupBy::GroupByCount) {
+    item->song_count = row.value("container_songcount").toInt();
+  }
+
   FinishItem(group_by, signal, create_divider, parent, item);
 
   return item;
@@ -1434,7 +1645,7 @@ CollectionItem *CollectionModel::ItemFromSong(const GroupBy group_by, const bool
       item->metadata.set_albumartist(s.effective_albumartist());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, s));
       item->display_text = TextOrUnknown(s.effective_albumartist());
-      item->sort_text = SortTextForArtist(s.effective_albumartist());
+      item->sort_text = s.artist_sortkey().isEmpty() ? SortTextForArtist(s.effective_albumartist()) : s.artist_sortkey();
       break;
     }
     case GroupBy::Artist:{
@@ -1450,7 +1661,7 @@ CollectionItem *CollectionModel::ItemFromSong(const GroupBy group_by, const bool
       item->metadata.set_grouping(s.grouping());
       item->key.append(ContainerKey(group_by, separate_albums_by_grouping, s));
       item->display_text = TextOrUnknown(s.album());
-      item->sort_text = SortTextForArtist(s.album());
+      item->sort_text = s.album_sortkey().isEmpty() ? SortTextForArtist(s.album()) : s.album_sortkey();
       break;
     }
     case GroupBy::AlbumDisc:{
@@ -1632,9 +1843,11 @@ void CollectionModel::FinishItem(const GroupBy group_by, const bool signal, cons
 
   // Create the divider entry if we're supposed to
   if (create_divider && show_dividers_) {
-    QString divider_key = DividerKey(group_by, item);
+    const QString divider_key = DividerKey(group_by, item);
     if (!divider_key.isEmpty()) {
+      item->divider_key = divider_key;
       item->sort_text.prepend(divider_key + " ");
+      ++divider_counts_[divider_key];
     }
 
     if (!divider_key.isEmpty() && !divider_nodes_.contains(divider_key)) {
@@ -1700,31 +1913,14 @@ QString CollectionModel::PrettyDisc(const int disc) {
 
 QString CollectionModel::SortText(QString text) {
 
-  if (text.isEmpty()) {
-    text = " unknown";
-  }
-  else {
-    text = text.toLower();
-  }
-  text = text.remove(QRegularExpression("[^\\w ]", QRegularExpression::UseUnicodePropertiesOption));
-
-  return text;
+  // The actual normalization lives in Song so the scanner persists identical keys, see Song::SortKey.
+  return Song::SortKey(text);
 
 }
 
 QString CollectionModel::SortTextForArtist(QString artist) {
 
-  artist = SortText(artist);
-
-  for (const auto &i : Song::kArticles) {
-    if (artist.startsWith(i)) {
-      qint64 ilen = i.length();
-      artist = artist.right(artist.length() - ilen) + ", " + i.left(ilen - 1);
-      break;
-    }
-  }
-
-  return artist;
+  return Song::SortKeyForArtist(artist);
 
 }
 
@@ -1780,17 +1976,27 @@ QMimeData *CollectionModel::mimeData(const QModelIndexList &indexes) const {
   if (indexes.isEmpty()) return nullptr;
 
   SongMimeData *data = new SongMimeData;
-  QList<QUrl> urls;
-  QSet<int> song_ids;
-
   data->backend = backend_;
 
+  // Collecting the songs walks the dragged containers and queries the database for every unpopulated one,
+  // which freezes the UI for seconds when thousands of rows are dragged.
+  // Capture only the dragged indexes now and resolve the songs when the drop actually needs them.
+  QList<QPersistentModelIndex> persistent_indexes;
+  persistent_indexes.reserve(indexes.count());
   for (const QModelIndex &idx : indexes) {
-    GetChildSongs(IndexToItem(idx), &urls, &data->songs, &song_ids);
+    persistent_indexes << idx;
   }
 
-  data->setUrls(urls);
-  data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->songs);
+  data->set_song_resolver([this, persistent_indexes, data]() {
+    QModelIndexList valid_indexes;
+    valid_indexes.reserve(persistent_indexes.count());
+    for (const QPersistentModelIndex &idx : persistent_indexes) {
+      if (idx.isValid()) valid_indexes << idx;
+    }
+    SongList songs = GetChildSongs(valid_indexes);
+    data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(songs);
+    return songs;
+  });
 
   return data;
 
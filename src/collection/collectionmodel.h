@@ -33,9 +33,11 @@
 #include <QDataStream>
 #include <QMetaType>
 #include <QPair>
+#include <QElapsedTimer>
 #include <QSet>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QVariant>
 #include <QString>
 #include <QStringList>
@@ -187,6 +189,10 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
 
   void set_use_lazy_loading(const bool value) { use_lazy_loading_ = value; }
 
+  // How long the last full re-query took, in milliseconds, or -1 before the first one has finished.
+  // Used by CollectionFilterWidget to adapt its debounce to the actual storage speed.
+  qint64 last_query_duration() const { return last_query_duration_msec_; }
+
   QMap<QString, CollectionItem*> container_nodes(const int i) { return container_nodes_[i]; }
   QList<CollectionItem*> song_nodes() const { return song_nodes_.values(); }
   int divider_nodes_count() const { return divider_nodes_.count(); }
@@ -242,6 +248,15 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
 
   bool HasCompilations(const QSqlDatabase &db, const CollectionFilterOptions &filter_options, const CollectionQueryOptions &query_options);
 
+  // Checks whether the database still has songs below the given container, used to prune containers whose songs were never lazy-loaded.
+  bool ContainerHasSongs(CollectionItem *item);
+
+  // The top level query result is saved to a binary snapshot that is memory-mapped on the next cold start,
+  // so the collection shows up immediately while the real database query runs in the background.
+  QString SnapshotFilePath() const;
+  bool LoadSnapshot(QueryResult *result);
+  void SaveSnapshot(const QueryResult &result);
+
   void BeginReset();
 
   // Functions for working with queries and creating items.
@@ -294,7 +309,10 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   QMap<QString, CollectionItem*> container_nodes_[3];
 
   // Keyed on a letter, a year, a century, etc.
-  QMap<QString, CollectionItem*> divider_nodes_;
+  QHash<QString, CollectionItem*> divider_nodes_;
+
+  // Number of top-level containers under each divider key, so an empty divider is found without scanning all containers.
+  QHash<QString, int> divider_counts_;
 
   QIcon artist_icon_;
   QIcon album_icon_;
@@ -305,6 +323,13 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
 
   int init_task_id_;
 
+  // Serializes full re-queries: while one runs, later ResetAsync calls only set the pending flag,
+  // so at most one re-query is ever queued and a superseded result is discarded instead of applied.
+  bool reset_async_in_progress_;
+  bool reset_async_pending_;
+  QElapsedTimer reset_query_timer_;
+  qint64 last_query_duration_msec_;
+
   bool use_pretty_covers_;
   bool show_dividers_;
   bool use_disk_cache_;
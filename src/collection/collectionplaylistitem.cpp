@@ -51,6 +51,7 @@ bool CollectionPlaylistItem::InitFromQuery(const SqlRow &query) {
   // Rows from the songs tables come first
   song_.InitFromQuery(query, true);
   song_.set_source(Song::Source::Collection);
+  InvalidateFilterTextCache();
   return song_.is_valid();
 
 }
@@ -103,6 +103,7 @@ CollectionQuery::CollectionQuery(const QSqlDatabase &db, const QString &songs_ta
   if (filter_options.max_age() != -1) {
     qint64 cutoff = QDateTime::currentDateTime().toSecsSinceEpoch() - filter_options.max_age();
 
+    // Together with the implicit "unavailable = 0" clause this matches the partial idx_ctime index, so age-filtered views don't scan the whole songs table.
     where_clauses_ << "ctime > ?";
     bound_values_ << cutoff;
   }
@@ -181,9 +182,7 @@ void CollectionQuery::AddCompilationRequirement(const bool compilation) {
 QString CollectionQuery::GetInnerQuery() const {
   return duplicates_only_
              ? QString(" INNER JOIN (select * from duplicated_songs) dsongs        "
-                   "ON (%songs_table.artist = dsongs.dup_artist       "
-                   "AND %songs_table.album = dsongs.dup_album     "
-                   "AND %songs_table.title = dsongs.dup_title)    ")
+                   "ON (%songs_table.ROWID = dsongs.dup_rowid)    ")
              : QString();
 }
 
@@ -205,6 +204,8 @@ bool CollectionQuery::Exec() {
 
   if (!where_clauses.isEmpty()) sql += " WHERE " + where_clauses.join(" AND ");
 
+  if (!group_by_.isEmpty()) sql += " GROUP BY " + group_by_;
+
   if (!order_by_.isEmpty()) sql += " ORDER BY " + order_by_;
 
   if (limit_ != -1) sql += " LIMIT " + QString::number(limit_);
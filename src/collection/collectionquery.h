@@ -47,6 +47,7 @@ class CollectionQuery : public QSqlQuery {
   bool Next();
 
   QString column_spec() const { return column_spec_; }
+  QString group_by() const { return group_by_; }
   QString order_by() const { return order_by_; }
   QStringList where_clauses() const { return where_clauses_; }
   QVariantList bound_values() const { return bound_values_; }
@@ -58,6 +59,9 @@ class CollectionQuery : public QSqlQuery {
   // Sets contents of SELECT clause on the query (list of columns to get).
   void SetColumnSpec(const QString &column_spec) { column_spec_ = column_spec; }
 
+  // Sets a GROUP BY clause on the query.
+  void SetGroupBy(const QString &group_by) { group_by_ = group_by; }
+
   // Sets an ORDER BY clause on the query.
   void SetOrderBy(const QString &order_by) { order_by_ = order_by; }
 
@@ -81,6 +85,7 @@ class CollectionQuery : public QSqlQuery {
   QString fts_table_;
 
   QString column_spec_;
+  QString group_by_;
   QString order_by_;
   QStringList where_clauses_;
   QVariantList bound_values_;
@@ -43,10 +43,14 @@ class CollectionQueryOptions {
   };
 
   QString column_spec() const { return column_spec_; }
+  QString group_by() const { return group_by_; }
+  QString order_by() const { return order_by_; }
   CompilationRequirement compilation_requirement() const { return compilation_requirement_; }
   bool query_have_compilations() const { return query_have_compilations_; }
 
   void set_column_spec(const QString &column_spec) { column_spec_ = column_spec; }
+  void set_group_by(const QString &group_by) { group_by_ = group_by; }
+  void set_order_by(const QString &order_by) { order_by_ = order_by; }
   void set_compilation_requirement(const CompilationRequirement compilation_requirement) { compilation_requirement_ = compilation_requirement; }
   void set_query_have_compilations(const bool query_have_compilations) { query_have_compilations_ = query_have_compilations; }
 
@@ -55,6 +59,8 @@ class CollectionQueryOptions {
 
  private:
   QString column_spec_;
+  QString group_by_;
+  QString order_by_;
   CompilationRequirement compilation_requirement_;
   bool query_have_compilations_;
   QList<Where> where_clauses_;
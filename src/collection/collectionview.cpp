@@ -67,6 +67,9 @@
 #endif
 #include "dialogs/edittagdialog.h"
 #include "dialogs/deleteconfirmationdialog.h"
+#ifdef HAVE_GSTREAMER
+#  include "engine/analysismanager.h"
+#endif
 #include "organize/organizedialog.h"
 #include "organize/organizeerrordialog.h"
 #include "settings/collectionsettingspage.h"
@@ -92,6 +95,9 @@ CollectionView::CollectionView(QWidget *parent)
       action_edit_track_(nullptr),
       action_edit_tracks_(nullptr),
       action_rescan_songs_(nullptr),
+#ifdef HAVE_GSTREAMER
+      action_analyze_loudness_(nullptr),
+#endif
       action_show_in_browser_(nullptr),
       action_show_in_various_(nullptr),
       action_no_show_in_various_(nullptr),
@@ -368,6 +374,9 @@ void CollectionView::contextMenuEvent(QContextMenuEvent *e) {
     context_menu_->addSeparator();
 
     action_rescan_songs_ = context_menu_->addAction(tr("Rescan song(s)"), this, &CollectionView::RescanSongs);
+#ifdef HAVE_GSTREAMER
+    action_analyze_loudness_ = context_menu_->addAction(tr("Analyze loudness"), this, &CollectionView::AnalyzeLoudness);
+#endif
 
     context_menu_->addSeparator();
     action_show_in_various_ = context_menu_->addAction(tr("Show in various artists"), this, &CollectionView::ShowInVarious);
@@ -419,6 +428,11 @@ void CollectionView::contextMenuEvent(QContextMenuEvent *e) {
   action_rescan_songs_->setVisible(regular_editable > 0);
   action_rescan_songs_->setEnabled(regular_editable > 0);
 
+#ifdef HAVE_GSTREAMER
+  action_analyze_loudness_->setVisible(regular_editable > 0);
+  action_analyze_loudness_->setEnabled(regular_editable > 0);
+#endif
+
   action_organize_->setVisible(regular_elements == regular_editable);
 #ifndef Q_OS_WIN
   action_copy_to_device_->setVisible(regular_elements == regular_editable);
@@ -610,6 +624,14 @@ void CollectionView::RescanSongs() {
 
 }
 
+#ifdef HAVE_GSTREAMER
+void CollectionView::AnalyzeLoudness() {
+
+  app_->analysis_manager()->AnalyzeSongs(GetSelectedSongs());
+
+}
+#endif
+
 void CollectionView::CopyToDevice() {
 
 #ifndef Q_OS_WIN
@@ -107,6 +107,9 @@ class CollectionView : public AutoExpandingTreeView {
   void CopyToDevice();
   void EditTracks();
   void RescanSongs();
+#ifdef HAVE_GSTREAMER
+  void AnalyzeLoudness();
+#endif
   void ShowInBrowser() const;
   void ShowInVarious();
   void NoShowInVarious();
@@ -143,6 +146,9 @@ class CollectionView : public AutoExpandingTreeView {
   QAction *action_edit_track_;
   QAction *action_edit_tracks_;
   QAction *action_rescan_songs_;
+#ifdef HAVE_GSTREAMER
+  QAction *action_analyze_loudness_;
+#endif
   QAction *action_show_in_browser_;
   QAction *action_show_in_various_;
   QAction *action_no_show_in_various_;
@@ -21,6 +21,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <utility>
 #include <chrono>
 
@@ -33,9 +34,11 @@
 #include <QFileInfo>
 #include <QMetaObject>
 #include <QDateTime>
+#include <QCryptographicHash>
 #include <QHash>
 #include <QMap>
 #include <QList>
+#include <QMutexLocker>
 #include <QSet>
 #include <QTimer>
 #include <QString>
@@ -46,6 +49,7 @@
 
 #include "core/filesystemwatcherinterface.h"
 #include "core/logging.h"
+#include "core/trace.h"
 #include "core/tagreaderclient.h"
 #include "core/taskmanager.h"
 #include "utilities/imageutils.h"
@@ -67,6 +71,9 @@
 using namespace std::chrono_literals;
 
 QStringList CollectionWatcher::sValidImages = QStringList() << "jpg" << "png" << "gif" << "jpeg";
+const int CollectionWatcher::kRescanCoalesceMaxMs = 60000;
+const qint64 CollectionWatcher::kFingerprintBlockSize = 64 * 1024;
+const int CollectionWatcher::kFullScanCheckpointBatchSize = 50;
 
 CollectionWatcher::CollectionWatcher(Song::Source source, QObject *parent)
     : QObject(parent),
@@ -77,6 +84,9 @@ CollectionWatcher::CollectionWatcher(Song::Source source, QObject *parent)
       original_thread_(nullptr),
       scan_on_startup_(true),
       monitor_(true),
+      prewarm_album_art_(true),
+      scan_threads_(0),
+      scan_pool_(nullptr),
       song_tracking_(false),
       mark_songs_unavailable_(source_ == Song::Source::Collection),
       expire_unavailable_songs_days_(60),
@@ -87,6 +97,7 @@ CollectionWatcher::CollectionWatcher(Song::Source source, QObject *parent)
       rescan_timer_(new QTimer(this)),
       periodic_scan_timer_(new QTimer(this)),
       rescan_paused_(false),
+      rescan_first_queued_time_(0),
       total_watches_(0),
       cue_parser_(new CueParser(backend_, this)),
       last_scan_time_(0) {
@@ -141,6 +152,8 @@ void CollectionWatcher::ReloadSettings() {
   s.beginGroup(CollectionSettingsPage::kSettingsGroup);
   scan_on_startup_ = s.value("startup_scan", true).toBool();
   monitor_ = s.value("monitor", true).toBool();
+  prewarm_album_art_ = s.value("prewarm_album_art", true).toBool();
+  scan_threads_ = s.value("scan_threads", 0).toInt();
   QStringList filters = s.value("cover_art_patterns", QStringList() << "front" << "cover").toStringList();
   if (source_ == Song::Source::Collection) {
     song_tracking_ = s.value("song_tracking", false).toBool();
@@ -151,6 +164,7 @@ void CollectionWatcher::ReloadSettings() {
     mark_songs_unavailable_ = false;
   }
   expire_unavailable_songs_days_ = s.value("expire_unavailable_songs", 60).toInt();
+  rescan_timer_->setInterval(s.value("rescan_debounce_interval", 2000).toInt());
   overwrite_playcount_ = s.value("overwrite_playcount", false).toBool();
   overwrite_rating_ = s.value("overwrite_rating", false).toBool();
   s.endGroup();
@@ -194,7 +208,8 @@ CollectionWatcher::ScanTransaction::ScanTransaction(CollectionWatcher *watcher,
       watcher_(watcher),
       cached_songs_dirty_(true),
       cached_songs_missing_fingerprint_dirty_(true),
-      known_subdirs_dirty_(true) {
+      known_subdirs_dirty_(true),
+      checkpoints_enabled_(false) {
 
   QString description;
 
@@ -215,6 +230,10 @@ CollectionWatcher::ScanTransaction::~ScanTransaction() {
   // If we're stopping then don't commit the transaction
   if (!watcher_->stop_requested_ && !watcher_->abort_requested_) {
     CommitNewOrUpdatedSongs();
+    if (checkpoints_enabled_) {
+      // The full scan ran to completion, so the checkpoints have served their purpose.
+      emit watcher_->FullScanCompleted(dir_);
+    }
   }
 
   watcher_->task_manager_->SetTaskFinished(task_id_);
@@ -223,6 +242,7 @@ CollectionWatcher::ScanTransaction::~ScanTransaction() {
 
 void CollectionWatcher::ScanTransaction::AddToProgress(const quint64 n) {
 
+  QMutexLocker l(&cache_mutex_);
   progress_ += n;
   watcher_->task_manager_->SetTaskProgress(task_id_, progress_, progress_max_);
 
@@ -230,6 +250,7 @@ void CollectionWatcher::ScanTransaction::AddToProgress(const quint64 n) {
 
 void CollectionWatcher::ScanTransaction::AddToProgressMax(const quint64 n) {
 
+  QMutexLocker l(&cache_mutex_);
   progress_max_ += n;
   watcher_->task_manager_->SetTaskProgress(task_id_, progress_, progress_max_);
 
@@ -249,6 +270,7 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
 
   if (!new_songs.isEmpty()) {
     emit watcher_->NewOrUpdatedSongs(new_songs);
+    EmitScannedAlbumArt();
     new_songs.clear();
   }
 
@@ -264,6 +286,8 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
 
   if (!new_subdirs.isEmpty()) {
     emit watcher_->SubdirsDiscovered(new_subdirs);
+    new_subdirs_to_watch_ << new_subdirs;
+    new_subdirs.clear();
   }
 
   if (!touched_subdirs.isEmpty()) {
@@ -279,14 +303,14 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
   deleted_subdirs.clear();
 
   if (watcher_->monitor_) {
-    // Watch the new subdirectories
-    for (const CollectionSubdirectory &subdir : new_subdirs) {
+    // Watch the new subdirectories, including the ones a checkpoint flush already pushed to the backend.
+    for (const CollectionSubdirectory &subdir : new_subdirs_to_watch_) {
       if (watcher_->watched_dirs_.contains(dir_)) {
         watcher_->AddWatch(watcher_->watched_dirs_[dir_], subdir.path);
       }
     }
   }
-  new_subdirs.clear();
+  new_subdirs_to_watch_.clear();
 
   if (incremental_ || ignores_mtime_) {
     emit watcher_->UpdateLastSeen(dir_, expire_unavailable_songs_days_);
@@ -294,9 +318,29 @@ void CollectionWatcher::ScanTransaction::CommitNewOrUpdatedSongs() {
 
 }
 
+void CollectionWatcher::ScanTransaction::EmitScannedAlbumArt() {
+
+  if (!watcher_->prewarm_album_art_) return;
+
+  // One representative song per album, so each cover is decoded and thumbnailed once instead of per track.
+  QMap<QString, Song> albums;
+  for (const Song &song : std::as_const(new_songs)) {
+    if (!song.has_embedded_cover() && song.art_automatic().isEmpty()) continue;
+    const QString album_key = song.effective_albumartist() + "/" + song.album();
+    if (!albums.contains(album_key)) albums.insert(album_key, song);
+  }
+
+  if (!albums.isEmpty()) {
+    emit watcher_->ScannedAlbumArt(albums.values());
+  }
+
+}
+
 
 SongList CollectionWatcher::ScanTransaction::FindSongsInSubdirectory(const QString &path) {
 
+  QMutexLocker l(&cache_mutex_);
+
   if (cached_songs_dirty_) {
     const SongList songs = watcher_->backend_->FindSongsInDirectory(dir_);
     for (const Song &song : songs) {
@@ -315,6 +359,8 @@ SongList CollectionWatcher::ScanTransaction::FindSongsInSubdirectory(const QStri
 
 bool CollectionWatcher::ScanTransaction::HasSongsWithMissingFingerprint(const QString &path) {
 
+  QMutexLocker l(&cache_mutex_);
+
   if (cached_songs_missing_fingerprint_dirty_) {
     const SongList songs = watcher_->backend_->SongsWithMissingFingerprint(dir_);
     for (const Song &song : songs) {
@@ -330,6 +376,8 @@ bool CollectionWatcher::ScanTransaction::HasSongsWithMissingFingerprint(const QS
 
 void CollectionWatcher::ScanTransaction::SetKnownSubdirs(const CollectionSubdirectoryList &subdirs) {
 
+  QMutexLocker l(&cache_mutex_);
+
   known_subdirs_ = subdirs;
   known_subdirs_dirty_ = false;
 
@@ -337,8 +385,11 @@ void CollectionWatcher::ScanTransaction::SetKnownSubdirs(const CollectionSubdire
 
 bool CollectionWatcher::ScanTransaction::HasSeenSubdir(const QString &path) {
 
+  QMutexLocker l(&cache_mutex_);
+
   if (known_subdirs_dirty_) {
-    SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
+    known_subdirs_ = watcher_->backend_->SubdirsInDirectory(dir_);
+    known_subdirs_dirty_ = false;
   }
 
   return std::any_of(known_subdirs_.begin(), known_subdirs_.end(), [path](const CollectionSubdirectory &subdir) { return subdir.path == path && subdir.mtime != 0; });
@@ -347,8 +398,11 @@ bool CollectionWatcher::ScanTransaction::HasSeenSubdir(const QString &path) {
 
 CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetImmediateSubdirs(const QString &path) {
 
+  QMutexLocker l(&cache_mutex_);
+
   if (known_subdirs_dirty_) {
-    SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
+    known_subdirs_ = watcher_->backend_->SubdirsInDirectory(dir_);
+    known_subdirs_dirty_ = false;
   }
 
   CollectionSubdirectoryList ret;
@@ -362,29 +416,251 @@ CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetImmediateSubdi
 
 }
 
+bool CollectionWatcher::ScanTransaction::FileExists(const QString &path) {
+
+  QMutexLocker l(&cache_mutex_);
+
+  QHash<QString, bool>::const_iterator it = file_exists_cache_.constFind(path);
+  if (it != file_exists_cache_.constEnd()) {
+    return it.value();
+  }
+
+  const bool exists = QFile::exists(path);
+  file_exists_cache_.insert(path, exists);
+
+  return exists;
+
+}
+
+quint64 CollectionWatcher::ScanTransaction::CueMtime(const QString &cue_path) {
+
+  QMutexLocker l(&cache_mutex_);
+
+  QHash<QString, quint64>::const_iterator it = cue_mtime_cache_.constFind(cue_path);
+  if (it != cue_mtime_cache_.constEnd()) {
+    return it.value();
+  }
+
+  const quint64 mtime = GetMtimeForCue(cue_path);
+  cue_mtime_cache_.insert(cue_path, mtime);
+
+  return mtime;
+
+}
+
 CollectionSubdirectoryList CollectionWatcher::ScanTransaction::GetAllSubdirs() {
 
+  QMutexLocker l(&cache_mutex_);
+
   if (known_subdirs_dirty_) {
-    SetKnownSubdirs(watcher_->backend_->SubdirsInDirectory(dir_));
+    known_subdirs_ = watcher_->backend_->SubdirsInDirectory(dir_);
+    known_subdirs_dirty_ = false;
   }
 
   return known_subdirs_;
 
 }
 
+void CollectionWatcher::ScanTransaction::SetCheckpointedSubdirs(const CollectionSubdirectoryList &subdirs) {
+
+  QMutexLocker l(&cache_mutex_);
+
+  checkpoints_enabled_ = true;
+  for (const CollectionSubdirectory &subdir : subdirs) {
+    checkpointed_subdirs_.insert(subdir.path, subdir.mtime);
+  }
+
+}
+
+bool CollectionWatcher::ScanTransaction::HasCheckpoint(const QString &path, const qint64 mtime) {
+
+  QMutexLocker l(&cache_mutex_);
+
+  return mtime != 0 && checkpointed_subdirs_.value(path, 0) == mtime;
+
+}
+
+void CollectionWatcher::ScanTransaction::AddCheckpoint(const CollectionSubdirectory &subdir) {
+
+  if (!checkpoints_enabled_ || subdir.mtime == 0) return;
+
+  QMutexLocker locker(&results_mutex_);
+
+  pending_checkpoints_ << subdir;
+  if (pending_checkpoints_.count() >= kFullScanCheckpointBatchSize) {
+    FlushCheckpoints();
+  }
+
+}
+
+void CollectionWatcher::ScanTransaction::FlushCheckpoints() {
+
+  if (!deleted_songs.isEmpty()) {
+    if (mark_songs_unavailable_ && watcher_->source() == Song::Source::Collection) {
+      emit watcher_->SongsUnavailable(deleted_songs);
+    }
+    else {
+      emit watcher_->SongsDeleted(deleted_songs);
+    }
+    deleted_songs.clear();
+  }
+
+  if (!new_songs.isEmpty()) {
+    emit watcher_->NewOrUpdatedSongs(new_songs);
+    EmitScannedAlbumArt();
+    new_songs.clear();
+  }
+
+  if (!touched_songs.isEmpty()) {
+    emit watcher_->SongsMTimeUpdated(touched_songs);
+    touched_songs.clear();
+  }
+
+  if (!readded_songs.isEmpty()) {
+    emit watcher_->SongsReadded(readded_songs);
+    readded_songs.clear();
+  }
+
+  if (!new_subdirs.isEmpty()) {
+    emit watcher_->SubdirsDiscovered(new_subdirs);
+    new_subdirs_to_watch_ << new_subdirs;
+    new_subdirs.clear();
+  }
+
+  if (!touched_subdirs.isEmpty()) {
+    emit watcher_->SubdirsMTimeUpdated(touched_subdirs);
+    touched_subdirs.clear();
+  }
+
+  emit watcher_->SubdirsCheckpointed(pending_checkpoints_);
+  pending_checkpoints_.clear();
+
+}
+
+CollectionWatcher::ScanWorkerPool::ScanWorkerPool(CollectionWatcher *watcher, ScanTransaction *transaction, const int thread_count)
+    : watcher_(watcher),
+      transaction_(transaction),
+      jobs_pending_(0),
+      next_queue_(0) {
+
+  for (int i = 0; i < thread_count; ++i) {
+    queues_ << QQueue<ScanJob>();
+  }
+
+}
+
+void CollectionWatcher::ScanWorkerPool::AddJob(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, const bool force_noincremental) {
+
+  ScanJob job;
+  job.path = path;
+  job.subdir = subdir;
+  job.files_count = files_count;
+  job.force_noincremental = force_noincremental;
+
+  QMutexLocker l(&mutex_);
+  queues_[next_queue_].enqueue(job);
+  next_queue_ = (next_queue_ + 1) % queues_.count();
+  ++jobs_pending_;
+  wait_condition_.wakeOne();
+
+}
+
+bool CollectionWatcher::ScanWorkerPool::NextJob(const int worker, ScanJob *job) {
+
+  QMutexLocker l(&mutex_);
+
+  forever {
+
+    if (!queues_[worker].isEmpty()) {
+      *job = queues_[worker].dequeue();
+      return true;
+    }
+
+    // Our own queue is empty - steal from the longest queue of the other workers.
+    int longest = -1;
+    for (int i = 0; i < queues_.count(); ++i) {
+      if (!queues_[i].isEmpty() && (longest == -1 || queues_[i].count() > queues_[longest].count())) {
+        longest = i;
+      }
+    }
+    if (longest != -1) {
+      *job = queues_[longest].dequeue();
+      return true;
+    }
+
+    // All queues are empty. If no job is running anymore nothing can produce new work, so we are done.
+    if (jobs_pending_ <= 0 || watcher_->stop_requested_ || watcher_->abort_requested_) {
+      wait_condition_.wakeAll();
+      return false;
+    }
+
+    wait_condition_.wait(&mutex_);
+
+  }
+
+}
+
+void CollectionWatcher::ScanWorkerPool::RunWorker(const int worker) {
+
+  forever {
+
+    ScanJob job;
+    if (!NextJob(worker, &job)) return;
+
+    if (!watcher_->stop_requested_ && !watcher_->abort_requested_) {
+      watcher_->ScanSubdirectory(job.path, job.subdir, job.files_count, transaction_, job.force_noincremental);
+    }
+
+    QMutexLocker l(&mutex_);
+    --jobs_pending_;
+    if (jobs_pending_ <= 0) wait_condition_.wakeAll();
+
+  }
+
+}
+
+void CollectionWatcher::ScanWorkerPool::Wait() {
+
+  QList<QThread*> threads;
+  threads.reserve(queues_.count());
+  for (int i = 0; i < queues_.count(); ++i) {
+    QThread *thread = QThread::create([this, i]() { RunWorker(i); });
+    thread->setObjectName(QStringLiteral("CollectionScanWorker%1").arg(i + 1));
+    threads << thread;
+    thread->start();
+  }
+
+  for (QThread *thread : threads) {
+    thread->wait();
+    thread->deleteLater();
+  }
+
+}
+
 void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const CollectionSubdirectoryList &subdirs) {
 
   stop_requested_ = false;
 
   watched_dirs_[dir.id] = dir;
 
+  const int thread_count = ScanThreadCount();
+
   if (subdirs.isEmpty()) {
     // This is a new directory that we've never seen before. Scan it fully.
     ScanTransaction transaction(this, dir.id, false, false, mark_songs_unavailable_);
     const quint64 files_count = FilesCountForPath(&transaction, dir.path);
     transaction.SetKnownSubdirs(subdirs);
     transaction.AddToProgressMax(files_count);
-    ScanSubdirectory(dir.path, CollectionSubdirectory(), files_count, &transaction);
+    if (thread_count > 1) {
+      ScanWorkerPool pool(this, &transaction, thread_count);
+      scan_pool_ = &pool;
+      pool.AddJob(dir.path, CollectionSubdirectory(), files_count);
+      pool.Wait();
+      scan_pool_ = nullptr;
+    }
+    else {
+      ScanSubdirectory(dir.path, CollectionSubdirectory(), files_count, &transaction);
+    }
     last_scan_time_ = QDateTime::currentDateTime().toSecsSinceEpoch();
   }
   else {
@@ -394,12 +670,25 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
     const quint64 files_count = FilesCountForSubdirs(&transaction, subdirs, subdir_files_count);
     transaction.SetKnownSubdirs(subdirs);
     transaction.AddToProgressMax(files_count);
-    for (const CollectionSubdirectory &subdir : subdirs) {
-      if (stop_requested_ || abort_requested_) break;
-
-      if (scan_on_startup_) ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
-
-      if (monitor_) AddWatch(dir, subdir.path);
+    if (scan_on_startup_ && thread_count > 1) {
+      ScanWorkerPool pool(this, &transaction, thread_count);
+      scan_pool_ = &pool;
+      for (const CollectionSubdirectory &subdir : subdirs) {
+        pool.AddJob(subdir.path, subdir, subdir_files_count[subdir.path]);
+      }
+      pool.Wait();
+      scan_pool_ = nullptr;
+    }
+    else if (scan_on_startup_) {
+      for (const CollectionSubdirectory &subdir : subdirs) {
+        if (stop_requested_ || abort_requested_) break;
+        ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
+      }
+    }
+    if (monitor_) {
+      for (const CollectionSubdirectory &subdir : subdirs) {
+        AddWatch(dir, subdir.path);
+      }
     }
 
     last_scan_time_ = QDateTime::currentDateTime().toSecsSinceEpoch();
@@ -410,8 +699,16 @@ void CollectionWatcher::AddDirectory(const CollectionDirectory &dir, const Colle
 
 }
 
+int CollectionWatcher::ScanThreadCount() const {
+
+  return scan_threads_ > 0 ? scan_threads_ : QThread::idealThreadCount();
+
+}
+
 void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, ScanTransaction *t, const bool force_noincremental) {
 
+  TRACE_SCOPE("CollectionWatcher::ScanSubdirectory");
+
   QFileInfo path_info(path);
 
   // Do not scan symlinked dirs that are already in collection
@@ -437,8 +734,47 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
     return;
   }
 
+  // A subdirectory checkpointed by an interrupted full scan only gets a cheap verification pass:
+  // if its mtime still matches what the checkpoint recorded, requeue any children unknown to the database and move on without rereading tags.
+  if (t->ignores_mtime() && !songs_missing_fingerprint && t->HasCheckpoint(path, path_info.lastModified().toSecsSinceEpoch())) {
+    QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+      if (stop_requested_ || abort_requested_) return;
+      const QString child = it.next();
+      // Known subdirectories were queued from the database like in any other full scan.
+      if (t->HasSeenSubdir(child)) continue;
+      CollectionSubdirectory new_subdir;
+      new_subdir.directory_id = -1;
+      new_subdir.path = child;
+      new_subdir.mtime = QFileInfo(child).lastModified().toSecsSinceEpoch();
+      if (scan_pool_) {
+        scan_pool_->AddJob(child, new_subdir, 0, true);
+      }
+      else {
+        ScanSubdirectory(child, new_subdir, 0, t, true);
+      }
+    }
+    {
+      // Keep the subdirectory row fresh even though the files were skipped.
+      QMutexLocker locker(&t->results_mutex_);
+      CollectionSubdirectory updated_subdir;
+      updated_subdir.directory_id = t->dir();
+      updated_subdir.mtime = path_info.lastModified().toSecsSinceEpoch();
+      updated_subdir.path = path;
+      if (subdir.directory_id == -1) {
+        t->new_subdirs << updated_subdir;
+      }
+      else {
+        t->touched_subdirs << updated_subdir;
+      }
+    }
+    t->AddToProgress(files_count);
+    return;
+  }
+
   QMap<QString, QStringList> album_art;
   QStringList files_on_disk;
+  QStringList media_candidates;
   CollectionSubdirectoryList my_new_subdirs;
 
   // If a directory is moved then only its parent gets a changed notification, so we need to look and see if any of our children don't exist anymore.
@@ -480,8 +816,20 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         album_art[dir_part] << child;
         t->AddToProgress(1);
       }
-      else if (TagReaderClient::Instance()->IsMediaFileBlocking(child)) {
-        files_on_disk << child;
+      else {
+        media_candidates << child;
+      }
+    }
+  }
+
+  if (stop_requested_ || abort_requested_) return;
+
+  // Check all candidates with one batched round trip to the tagreader workers instead of a blocking call per file, the per-message overhead dominates for directories with many files.
+  if (!media_candidates.isEmpty()) {
+    const QList<bool> media_file_results = TagReaderClient::Instance()->IsMediaFileBatchBlocking(media_candidates);
+    for (int i = 0; i < media_candidates.count(); ++i) {
+      if (i < media_file_results.count() && media_file_results[i]) {
+        files_on_disk << media_candidates[i];
       }
       else {
         t->AddToProgress(1);
@@ -522,12 +870,12 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
       }
 
       // CUE sheet's path from collection (if any).
-      qint64 matching_song_cue_mtime = static_cast<qint64>(GetMtimeForCue(matching_song.cue_path()));
+      qint64 matching_song_cue_mtime = static_cast<qint64>(t->CueMtime(matching_song.cue_path()));
 
       // CUE sheet's path from this file (if any).
       qint64 new_cue_mtime = 0;
       if (!new_cue.isEmpty()) {
-        new_cue_mtime = static_cast<qint64>(GetMtimeForCue(new_cue));
+        new_cue_mtime = static_cast<qint64>(t->CueMtime(new_cue));
       }
 
       const bool cue_added = new_cue_mtime != 0 && !matching_song.has_cue();
@@ -539,7 +887,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
 
       // Also want to look to see whether the album art has changed
       QUrl image = ImageForSong(file, album_art);
-      if ((matching_song.art_automatic().isEmpty() && !image.isEmpty()) || (!matching_song.art_automatic().isEmpty() && !matching_song.has_embedded_cover() && !QFile::exists(matching_song.art_automatic().toLocalFile()))) {
+      if ((matching_song.art_automatic().isEmpty() && !image.isEmpty()) || (!matching_song.art_automatic().isEmpty() && !matching_song.has_embedded_cover() && !t->FileExists(matching_song.art_automatic().toLocalFile()))) {
         changed = true;
       }
 
@@ -557,8 +905,24 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         qLog(Debug) << file << "is missing fingerprint.";
       }
 
+      // Full rescans ignore mtimes because they are untrustworthy on some network mounts,
+      // but a cached content fingerprint can still prove the file is byte-identical and make rereading the tags unnecessary.
+      bool content_unchanged = false;
+      if (t->ignores_mtime() && !changed && !missing_fingerprint) {
+        const QString content_fingerprint = FileContentFingerprint(file);
+        if (!content_fingerprint.isEmpty()) {
+          if (content_fingerprint == backend_->FileFingerprint(QUrl::fromLocalFile(file))) {
+            qLog(Debug) << file << "is unchanged by content fingerprint, skipping tag reread.";
+            content_unchanged = true;
+          }
+          else {
+            backend_->UpdateFileFingerprint(QUrl::fromLocalFile(file), content_fingerprint);
+          }
+        }
+      }
+
       // The song's changed or missing fingerprint - create fingerprint and reread the metadata from file.
-      if (t->ignores_mtime() || changed || missing_fingerprint) {
+      if ((t->ignores_mtime() && !content_unchanged) || changed || missing_fingerprint) {
 
         QString fingerprint;
 #ifdef HAVE_SONGFINGERPRINTING
@@ -578,10 +942,18 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
           UpdateCueAssociatedSongs(file, path, fingerprint, new_cue, image, matching_songs, t);
         }
 
+        if (changed && !t->ignores_mtime()) {
+          const QString content_fingerprint = FileContentFingerprint(file);
+          if (!content_fingerprint.isEmpty()) {
+            backend_->UpdateFileFingerprint(QUrl::fromLocalFile(file), content_fingerprint);
+          }
+        }
+
       }
 
       // Nothing has changed - mark the song available without re-scanning
       else if (matching_song.is_unavailable()) {
+        QMutexLocker locker(&t->results_mutex_);
         t->readded_songs << matching_songs;
       }
 
@@ -611,24 +983,27 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
 
         // Make sure the songs aren't deleted, as they still exist elsewhere with a different file path.
         bool matching_songs_has_cue = false;
-        for (const Song &matching_song : matching_songs) {
-          QString matching_filename = matching_song.url().toLocalFile();
-          if (!t->files_changed_path_.contains(matching_filename)) {
-            t->files_changed_path_ << matching_filename;
-            qLog(Debug) << matching_filename << "has changed path to" << file;
-          }
-          if (t->deleted_songs.contains(matching_song)) {
-            t->deleted_songs.removeAll(matching_song);
-          }
-          if (matching_song.has_cue()) {
-            matching_songs_has_cue = true;
+        {
+          QMutexLocker locker(&t->results_mutex_);
+          for (const Song &matching_song : matching_songs) {
+            QString matching_filename = matching_song.url().toLocalFile();
+            if (!t->files_changed_path_.contains(matching_filename)) {
+              t->files_changed_path_ << matching_filename;
+              qLog(Debug) << matching_filename << "has changed path to" << file;
+            }
+            if (t->deleted_songs.contains(matching_song)) {
+              t->deleted_songs.removeAll(matching_song);
+            }
+            if (matching_song.has_cue()) {
+              matching_songs_has_cue = true;
+            }
           }
         }
 
         // CUE sheet's path from this file (if any).
         qint64 new_cue_mtime = 0;
         if (!new_cue.isEmpty()) {
-          new_cue_mtime = static_cast<qint64>(GetMtimeForCue(new_cue));
+          new_cue_mtime = static_cast<qint64>(t->CueMtime(new_cue));
         }
 
         // Get new album art
@@ -655,6 +1030,7 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
         // Choose an image for the song(s)
         QUrl image = ImageForSong(file, album_art);
 
+        QMutexLocker locker(&t->results_mutex_);
         for (Song song : songs) {
           song.set_directory_id(t->dir());
           if (song.art_automatic().isEmpty()) song.set_art_automatic(image);
@@ -665,36 +1041,56 @@ void CollectionWatcher::ScanSubdirectory(const QString &path, const CollectionSu
     t->AddToProgress(1);
   }
 
-  // Look for deleted songs
-  for (const Song &song : songs_in_db) {
-    QString file = song.url().toLocalFile();
-    if (!song.is_unavailable() && !files_on_disk.contains(file) && !t->files_changed_path_.contains(file)) {
-      qLog(Debug) << "Song deleted from disk:" << file;
-      t->deleted_songs << song;
+  {
+    QMutexLocker locker(&t->results_mutex_);
+
+    // Look for deleted songs
+    for (const Song &song : songs_in_db) {
+      QString file = song.url().toLocalFile();
+      if (!song.is_unavailable() && !files_on_disk.contains(file) && !t->files_changed_path_.contains(file)) {
+        qLog(Debug) << "Song deleted from disk:" << file;
+        t->deleted_songs << song;
+      }
     }
-  }
 
-  // Add this subdir to the new or touched list
-  CollectionSubdirectory updated_subdir;
-  updated_subdir.directory_id = t->dir();
-  updated_subdir.mtime = path_info.exists() ? path_info.lastModified().toSecsSinceEpoch() : 0;
-  updated_subdir.path = path;
+    // Add this subdir to the new or touched list
+    CollectionSubdirectory updated_subdir;
+    updated_subdir.directory_id = t->dir();
+    updated_subdir.mtime = path_info.exists() ? path_info.lastModified().toSecsSinceEpoch() : 0;
+    updated_subdir.path = path;
 
-  if (subdir.directory_id == -1) {
-    t->new_subdirs << updated_subdir;
-  }
-  else {
-    t->touched_subdirs << updated_subdir;
+    if (subdir.directory_id == -1) {
+      t->new_subdirs << updated_subdir;
+    }
+    else {
+      t->touched_subdirs << updated_subdir;
+    }
+
+    if (updated_subdir.mtime == 0) {  // CollectionSubdirectory deleted, mark it for removal from the watcher.
+      t->deleted_subdirs << updated_subdir;
+    }
   }
 
-  if (updated_subdir.mtime == 0) {  // CollectionSubdirectory deleted, mark it for removal from the watcher.
-    t->deleted_subdirs << updated_subdir;
+  // This subdirectory is fully processed - record a checkpoint so an interrupted full scan does not redo it on resume.
+  // The mtime from before the scan is recorded on purpose: if the directory changed while it was being scanned, the resume pass rescans it.
+  if (t->ignores_mtime()) {
+    CollectionSubdirectory completed_subdir;
+    completed_subdir.directory_id = t->dir();
+    completed_subdir.path = path;
+    completed_subdir.mtime = path_info.exists() ? path_info.lastModified().toSecsSinceEpoch() : 0;
+    t->AddCheckpoint(completed_subdir);
   }
 
-  // Recurse into the new subdirs that we found
+  // Recurse into the new subdirs that we found.
+  // When a scanner pool is active, hand them to the pool instead so other threads can pick them up.
   for (const CollectionSubdirectory &my_new_subdir : my_new_subdirs) {
     if (stop_requested_ || abort_requested_) return;
-    ScanSubdirectory(my_new_subdir.path, my_new_subdir, 0, t, true);
+    if (scan_pool_) {
+      scan_pool_->AddJob(my_new_subdir.path, my_new_subdir, 0, true);
+    }
+    else {
+      ScanSubdirectory(my_new_subdir.path, my_new_subdir, 0, t, true);
+    }
   }
 
 }
@@ -738,11 +1134,13 @@ void CollectionWatcher::UpdateCueAssociatedSongs(const QString &file,
       used_ids.insert(matching_cue_song.id());
     }
     else {  // A new section
+      QMutexLocker locker(&t->results_mutex_);
       t->new_songs << new_cue_song;
     }
   }
 
   // Sections that are now missing
+  QMutexLocker locker(&t->results_mutex_);
   for (const Song &old_cue : old_cue_songs) {
     if (!used_ids.contains(old_cue.id())) {
       t->deleted_songs << old_cue;
@@ -761,6 +1159,7 @@ void CollectionWatcher::UpdateNonCueAssociatedSong(const QString &file,
   // If a CUE got deleted, we turn it's first section into the new 'raw' (cueless) song, and we just remove the rest of the sections from the collection
   const Song &matching_song = matching_songs.first();
   if (cue_deleted) {
+    QMutexLocker locker(&t->results_mutex_);
     for (const Song &song : matching_songs) {
       if (!song.IsAllMetadataEqual(matching_song)) {
         t->deleted_songs << song;
@@ -887,6 +1286,7 @@ void CollectionWatcher::AddChangedSong(const QString &file, const Song &matching
 
   }
 
+  QMutexLocker locker(&t->results_mutex_);
   if (notify_new) {
     t->new_songs << new_song;
   }
@@ -991,6 +1391,27 @@ bool CollectionWatcher::FindSongsByFingerprint(const QString &file, const SongLi
 
 }
 
+QString CollectionWatcher::FileContentFingerprint(const QString &file) {
+
+  QFile f(file);
+  if (!f.open(QIODevice::ReadOnly)) return QString();
+
+  const qint64 size = f.size();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(f.read(kFingerprintBlockSize));
+  if (size > kFingerprintBlockSize * 2) {
+    f.seek(size - kFingerprintBlockSize);
+    hash.addData(f.read(kFingerprintBlockSize));
+  }
+  else if (size > kFingerprintBlockSize) {
+    hash.addData(f.readAll());
+  }
+
+  return QString::number(size) + "-" + hash.result().toHex();
+
+}
+
 void CollectionWatcher::DirectoryChanged(const QString &subdir) {
 
   // Find what dir it was in
@@ -1002,20 +1423,44 @@ void CollectionWatcher::DirectoryChanged(const QString &subdir) {
 
   qLog(Debug) << "Subdir" << subdir << "changed under directory" << dir.path << "id" << dir.id;
 
-  // Queue the subdir for rescanning
-  if (!rescan_queue_[dir.id].contains(subdir)) rescan_queue_[dir.id] << subdir;
+  // Queue the subdir for rescanning.
+  // Paths are normalized first so events for the same subdirectory with and without a trailing slash coalesce into one entry.
+  const QString path = QDir::cleanPath(subdir);
+  if (!rescan_queue_[dir.id].contains(path)) rescan_queue_[dir.id] << path;
 
-  if (!rescan_paused_) rescan_timer_->start();
+  if (rescan_first_queued_time_ == 0) rescan_first_queued_time_ = QDateTime::currentMSecsSinceEpoch();
+
+  if (!rescan_paused_) {
+    // Restarting the timer on every event merges event bursts into one rescan,
+    // but a continuous stream of events (a large rsync into the share) must not postpone the rescan forever.
+    if (QDateTime::currentMSecsSinceEpoch() - rescan_first_queued_time_ >= kRescanCoalesceMaxMs) {
+      rescan_timer_->stop();
+      RescanPathsNow();
+    }
+    else {
+      rescan_timer_->start();
+    }
+  }
 
 }
 
 void CollectionWatcher::RescanPathsNow() {
 
+  rescan_first_queued_time_ = 0;
+
   QList<int> dirs = rescan_queue_.keys();
   for (const int dir : dirs) {
     if (stop_requested_ || abort_requested_) break;
     ScanTransaction transaction(this, dir, false, false, mark_songs_unavailable_);
 
+    // Scan the directory containing the currently playing song first so its changes show up before the rest of the backlog.
+    if (!current_song_path_.isEmpty()) {
+      QStringList &paths = rescan_queue_[dir];
+      std::stable_sort(paths.begin(), paths.end(), [this](const QString &a, const QString &b) {
+        return current_song_path_.startsWith(a) && !current_song_path_.startsWith(b);
+      });
+    }
+
     QMap<QString, quint64> subdir_files_count;
     for (const QString &path : rescan_queue_[dir]) {
       quint64 files_count = FilesCountForPath(&transaction, path);
@@ -1116,6 +1561,12 @@ void CollectionWatcher::SetRescanPaused(bool pause) {
 
 }
 
+void CollectionWatcher::CurrentSongChanged(const Song &song) {
+
+  current_song_path_ = song.url().isLocalFile() ? DirectoryPart(song.url().toLocalFile()) : QString();
+
+}
+
 void CollectionWatcher::IncrementalScanAsync() {
 
   QMetaObject::invokeMethod(this, "IncrementalScanNow", Qt::QueuedConnection);
@@ -1151,6 +1602,16 @@ void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mt
     if (stop_requested_ || abort_requested_) break;
 
     ScanTransaction transaction(this, dir.id, incremental, ignore_mtimes, mark_songs_unavailable_);
+
+    if (ignore_mtimes) {
+      // Full scans are checkpointed, so subdirectories completed by a previous interrupted run only get a cheap mtime verification.
+      const CollectionSubdirectoryList checkpoints = backend_->GetFullScanCheckpoints(dir.id);
+      if (!checkpoints.isEmpty()) {
+        qLog(Info) << "Resuming full scan of" << dir.path << "-" << checkpoints.count() << "subdirectories already completed";
+      }
+      transaction.SetCheckpointedSubdirs(checkpoints);
+    }
+
     CollectionSubdirectoryList subdirs(transaction.GetAllSubdirs());
 
     if (subdirs.isEmpty()) {
@@ -1165,9 +1626,21 @@ void CollectionWatcher::PerformScan(const bool incremental, const bool ignore_mt
     quint64 files_count = FilesCountForSubdirs(&transaction, subdirs, subdir_files_count);
     transaction.AddToProgressMax(files_count);
 
-    for (const CollectionSubdirectory &subdir : subdirs) {
-      if (stop_requested_ || abort_requested_) break;
-      ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
+    const int thread_count = ScanThreadCount();
+    if (thread_count > 1) {
+      ScanWorkerPool pool(this, &transaction, thread_count);
+      scan_pool_ = &pool;
+      for (const CollectionSubdirectory &subdir : subdirs) {
+        pool.AddJob(subdir.path, subdir, subdir_files_count[subdir.path]);
+      }
+      pool.Wait();
+      scan_pool_ = nullptr;
+    }
+    else {
+      for (const CollectionSubdirectory &subdir : subdirs) {
+        if (stop_requested_ || abort_requested_) break;
+        ScanSubdirectory(subdir.path, subdir, subdir_files_count[subdir.path], &transaction);
+      }
     }
 
   }
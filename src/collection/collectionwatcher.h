@@ -29,10 +29,13 @@
 #include <QHash>
 #include <QMap>
 #include <QMultiMap>
+#include <QMutex>
+#include <QQueue>
 #include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <QWaitCondition>
 
 #include "collectiondirectory.h"
 #include "core/song.h"
@@ -77,6 +80,10 @@ class CollectionWatcher : public QObject {
   void SongsReadded(const SongList &songs, const bool unavailable = false);
   void SubdirsDiscovered(const CollectionSubdirectoryList &subdirs);
   void SubdirsMTimeUpdated(const CollectionSubdirectoryList &subdirs);
+  void SubdirsCheckpointed(const CollectionSubdirectoryList &subdirs);
+  void FullScanCompleted(const int directory_id);
+  // One representative song per album that was scanned with cover art, so the cover cache can be pre-warmed before the first browse.
+  void ScannedAlbumArt(const SongList &songs);
   void CompilationsNeedUpdating();
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExitFinished();
@@ -87,6 +94,8 @@ class CollectionWatcher : public QObject {
   void AddDirectory(const CollectionDirectory &dir, const CollectionSubdirectoryList &subdirs);
   void RemoveDirectory(const CollectionDirectory &dir);
   void SetRescanPaused(bool pause);
+  // Remembers the directory of the currently playing song so queued rescans of it are run first.
+  void CurrentSongChanged(const Song &song);
 
  private:
   // This class encapsulates a full or partial scan of a directory.
@@ -102,11 +111,22 @@ class CollectionWatcher : public QObject {
 
     SongList FindSongsInSubdirectory(const QString &path);
     bool HasSongsWithMissingFingerprint(const QString &path);
+    // Memoized stat calls, shared by every file scanned in this transaction.
+    // All songs of an album typically point at the same cover and cue files, so on network mounts the repeated stats dominate.
+    // Negative results are cached too.
+    bool FileExists(const QString &path);
+    quint64 CueMtime(const QString &cue_path);
     bool HasSeenSubdir(const QString &path);
     void SetKnownSubdirs(const CollectionSubdirectoryList &subdirs);
     CollectionSubdirectoryList GetImmediateSubdirs(const QString &path);
     CollectionSubdirectoryList GetAllSubdirs();
 
+    // Completed-subdirectory checkpoints, persisted periodically during a full scan so a scan interrupted by a crash can resume where it left off.
+    // Calling SetCheckpointedSubdirs turns checkpointing on for this transaction; the list may be empty when there is nothing to resume.
+    void SetCheckpointedSubdirs(const CollectionSubdirectoryList &subdirs);
+    bool HasCheckpoint(const QString &path, const qint64 mtime);
+    void AddCheckpoint(const CollectionSubdirectory &subdir);
+
     void AddToProgress(const quint64 n = 1);
     void AddToProgressMax(const quint64 n);
 
@@ -127,10 +147,22 @@ class CollectionWatcher : public QObject {
 
     QStringList files_changed_path_;
 
+    // Serializes access to the result lists above when subdirectories are scanned by multiple threads at once.
+    QMutex results_mutex_;
+
    private:
     ScanTransaction(const ScanTransaction&) {}
     ScanTransaction &operator=(const ScanTransaction&) { return *this; }
 
+    // Emits one representative song per album in new_songs that carries cover art, so the cover cache can be pre-warmed.
+    // Must be called before new_songs is cleared.
+    void EmitScannedAlbumArt();
+
+    // Pushes the gathered results to the backend followed by the pending checkpoints.
+    // The queued connections deliver both in order on the database thread, so a crash can only lose work that was not checkpointed yet.
+    // Must be called with results_mutex_ held.
+    void FlushCheckpoints();
+
     int task_id_;
     quint64 progress_;
     quint64 progress_max_;
@@ -150,6 +182,8 @@ class CollectionWatcher : public QObject {
 
     CollectionWatcher *watcher_;
 
+    QMutex cache_mutex_;
+
     QMultiMap<QString, Song> cached_songs_;
     bool cached_songs_dirty_;
 
@@ -158,6 +192,49 @@ class CollectionWatcher : public QObject {
 
     CollectionSubdirectoryList known_subdirs_;
     bool known_subdirs_dirty_;
+
+    bool checkpoints_enabled_;
+    // Checkpoints left behind by a previous interrupted full scan, path -> subdirectory mtime at the time it was checkpointed.
+    QHash<QString, qint64> checkpointed_subdirs_;
+    CollectionSubdirectoryList pending_checkpoints_;
+    // New subdirectories whose discovery was already flushed to the backend but that still need a filesystem watch added in the dtor.
+    CollectionSubdirectoryList new_subdirs_to_watch_;
+
+    QHash<QString, bool> file_exists_cache_;
+    QHash<QString, quint64> cue_mtime_cache_;
+  };
+
+  // Distributes subdirectory scans for one transaction across a pool of scanner threads.
+  // Every worker has its own queue of pending subdirectories.
+  // Subdirectories discovered while scanning are queued round-robin, and a worker whose own queue runs dry steals from the longest queue of the others.
+  class ScanWorkerPool {
+   public:
+    ScanWorkerPool(CollectionWatcher *watcher, ScanTransaction *transaction, const int thread_count);
+
+    void AddJob(const QString &path, const CollectionSubdirectory &subdir, const quint64 files_count, const bool force_noincremental = false);
+
+    // Starts the workers and blocks until every queued subdirectory, including the ones discovered along the way, has been scanned.
+    void Wait();
+
+   private:
+    struct ScanJob {
+      QString path;
+      CollectionSubdirectory subdir;
+      quint64 files_count;
+      bool force_noincremental;
+    };
+
+    bool NextJob(const int worker, ScanJob *job);
+    void RunWorker(const int worker);
+
+    CollectionWatcher *watcher_;
+    ScanTransaction *transaction_;
+
+    QMutex mutex_;
+    QWaitCondition wait_condition_;
+    QList<QQueue<ScanJob>> queues_;
+    int jobs_pending_;
+    int next_queue_;
   };
 
  private slots:
@@ -173,6 +250,8 @@ class CollectionWatcher : public QObject {
 
  private:
   static bool FindSongsByPath(const SongList &songs, const QString &path, SongList *out);
+  // Cheap content fingerprint (file size + hash of the first and last blocks), used to prove a file unchanged when mtimes are untrustworthy.
+  static QString FileContentFingerprint(const QString &file);
   bool FindSongsByFingerprint(const QString &file, const QString &fingerprint, SongList *out);
   static bool FindSongsByFingerprint(const QString &file, const SongList &songs, const QString &fingerprint, SongList *out);
   inline static QString NoExtensionPart(const QString &fileName);
@@ -198,6 +277,8 @@ class CollectionWatcher : public QObject {
   quint64 FilesCountForPath(ScanTransaction *t, const QString &path);
   quint64 FilesCountForSubdirs(ScanTransaction *t, const CollectionSubdirectoryList &subdirs, QMap<QString, quint64> &subdir_files_count);
 
+  int ScanThreadCount() const;
+
   QString FindCueFilename(const QString &filename);
 
  private:
@@ -216,6 +297,9 @@ class CollectionWatcher : public QObject {
 
   bool scan_on_startup_;
   bool monitor_;
+  bool prewarm_album_art_;
+  int scan_threads_;
+  ScanWorkerPool *scan_pool_;
   bool song_tracking_;
   bool mark_songs_unavailable_;
   int expire_unavailable_songs_days_;
@@ -230,6 +314,9 @@ class CollectionWatcher : public QObject {
   QTimer *periodic_scan_timer_;
   QMap<int, QStringList> rescan_queue_;  // dir id -> list of subdirs to be scanned
   bool rescan_paused_;
+  // When the first pending change event was queued, so a continuous stream of events cannot postpone the rescan forever.
+  qint64 rescan_first_queued_time_;
+  QString current_song_path_;
 
   int total_watches_;
 
@@ -237,6 +324,13 @@ class CollectionWatcher : public QObject {
 
   static QStringList sValidImages;
 
+  // Upper bound on how long change events are coalesced before a rescan is forced.
+  static const int kRescanCoalesceMaxMs;
+  // How much of the head and tail of a file goes into the content fingerprint.
+  static const qint64 kFingerprintBlockSize;
+  // How many completed subdirectories are collected before a full scan checkpoint is flushed to the backend.
+  static const int kFullScanCheckpointBatchSize;
+
   qint64 last_scan_time_;
 
 };
@@ -36,6 +36,9 @@
 #include <QMenu>
 #include <QContextMenuEvent>
 #include <QPaintEvent>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
 
 #include "utilities/imageutils.h"
 #include "covermanager/albumcoverchoicecontroller.h"
@@ -54,7 +57,8 @@ ContextAlbum::ContextAlbum(QWidget *parent)
       timeline_fade_(new QTimeLine(kFadeTimeLineMs, this)),
       image_strawberry_(":/pictures/strawberry.png"),
       image_original_(image_strawberry_),
-      pixmap_current_opacity_(1.0) {
+      pixmap_current_opacity_(1.0),
+      scale_cover_id_(0) {
 
   setObjectName("context-widget-album");
 
@@ -153,6 +157,8 @@ void ContextAlbum::SetImage(QImage image) {
   qreal opacity_previous = pixmap_current_opacity_;
 
   image_original_ = image;
+  // Cleared so the old cover is not drawn again at the new opacity while the scaled pixmap is still being produced.
+  pixmap_current_ = QPixmap();
   pixmap_current_opacity_ = 0.0;
   ScaleCover();
 
@@ -235,26 +241,47 @@ void ContextAlbum::FadePreviousCoverFinished(std::shared_ptr<PreviousCover> prev
 
 void ContextAlbum::ScaleCover() {
 
-  QImage image = ImageUtils::ScaleAndPad(image_original_, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
-  if (image.isNull()) {
-    pixmap_current_ = QPixmap();
-  }
-  else {
-    pixmap_current_ = QPixmap::fromImage(image);
-  }
+  // Scaled on a worker thread - large covers stall the GUI thread noticeably when scaled synchronously.
+  // The id guards against an older scale finishing after a newer one.
+  const quint64 id = ++scale_cover_id_;
+  QFuture<QImage> future = QtConcurrent::run(&ImageUtils::ScaleAndPad, image_original_, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
+  QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>();
+  QObject::connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, id]() {
+    QImage image = watcher->result();
+    watcher->deleteLater();
+    if (id != scale_cover_id_) return;
+    if (image.isNull()) {
+      pixmap_current_ = QPixmap();
+    }
+    else {
+      pixmap_current_ = QPixmap::fromImage(image);
+    }
+    updateGeometry();
+    update();
+  });
+  watcher->setFuture(future);
 
 }
 
 void ContextAlbum::ScalePreviousCovers() {
 
   for (std::shared_ptr<PreviousCover> previous_cover : previous_covers_) {
-    QImage image = ImageUtils::ScaleAndPad(previous_cover->image, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
-    if (image.isNull()) {
-      previous_cover->pixmap = QPixmap();
-    }
-    else {
-      previous_cover->pixmap = QPixmap::fromImage(image);
-    }
+    QFuture<QImage> future = QtConcurrent::run(&ImageUtils::ScaleAndPad, previous_cover->image, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>();
+    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, previous_cover]() {
+      QImage image = watcher->result();
+      watcher->deleteLater();
+      // The cover may have finished fading out while it was scaled.
+      if (!previous_covers_.contains(previous_cover)) return;
+      if (image.isNull()) {
+        previous_cover->pixmap = QPixmap();
+      }
+      else {
+        previous_cover->pixmap = QPixmap::fromImage(image);
+      }
+      update();
+    });
+    watcher->setFuture(future);
   }
 
 }
@@ -107,6 +107,7 @@ class ContextAlbum : public QWidget {
   QPixmap pixmap_current_;
   qreal pixmap_current_opacity_;
   std::unique_ptr<QMovie> spinner_animation_;
+  quint64 scale_cover_id_;
 };
 
 #endif  // CONTEXTALBUM_H
@@ -30,13 +30,17 @@
 #include <QObject>
 #include <QThread>
 #include <QString>
+#include <QElapsedTimer>
+#include <QTimer>
 
 #include "core/lazy.h"
 #include "core/tagreaderclient.h"
 #include "core/logging.h"
+#include "core/trace.h"
 
 #include "database.h"
 #include "taskmanager.h"
+#include "threadpoolmanager.h"
 #include "player.h"
 #include "networkaccessmanager.h"
 
@@ -96,11 +100,61 @@
 #  include "moodbar/moodbarloader.h"
 #endif
 
+#ifdef HAVE_GSTREAMER
+#  include "engine/analysismanager.h"
+#endif
+
 #include "radios/radioservices.h"
 #include "radios/radiobackend.h"
 
 using namespace std::chrono_literals;
 
+namespace {
+
+// Startup is split into phases so a slow service constructor is visible and attributable:
+// "critical" is what the Application constructor forces, "visible" anything forced while the main window is being built,
+// and "background" the rest, brought up once the event loop has gone idle.
+struct ServiceInitRecord {
+  const char *name;
+  const char *phase;
+  qint64 started_ms;
+  qint64 elapsed_ms;
+};
+
+const char *sStartupPhase = "critical";
+QList<ServiceInitRecord> sServiceInitRecords;
+
+qint64 SinceStartupMs() {
+
+  static const QElapsedTimer sStartupTimer = []() {
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+  }();
+
+  return sStartupTimer.elapsed();
+
+}
+
+// All service accessors funnel through here so first construction gets timed and tagged with the current startup phase.
+// Services are only ever constructed on the main thread, so the bookkeeping needs no locking.
+template<typename T>
+T *InitService(const char *name, const Lazy<T> &lazy) {
+
+  if (lazy) return lazy.get();
+
+  TRACE_SCOPE(name);
+
+  const qint64 started_ms = SinceStartupMs();
+  T *service = lazy.get();
+  sServiceInitRecords << ServiceInitRecord{ name, sStartupPhase, started_ms, SinceStartupMs() - started_ms };
+
+  return service;
+
+}
+
+}  // namespace
+
 class ApplicationImpl {
  public:
   explicit ApplicationImpl(Application *app) :
@@ -117,6 +171,7 @@ class ApplicationImpl {
           return db;
         }),
         task_manager_([app]() { return new TaskManager(app); }),
+        thread_pool_manager_([app]() { return new ThreadPoolManager(app, app); }),
         player_([app]() { return new Player(app, app); }),
         network_([app]() { return new NetworkAccessManager(app); }),
         device_finders_([app]() { return new DeviceFinders(app); }),
@@ -150,6 +205,7 @@ class ApplicationImpl {
         }),
         album_cover_loader_([app]() {
           AlbumCoverLoader *loader = new AlbumCoverLoader(app);
+          loader->set_task_manager(app->task_manager());
           app->MoveToNewThread(loader);
           return loader;
         }),
@@ -191,6 +247,9 @@ class ApplicationImpl {
 #ifdef HAVE_MOODBAR
         moodbar_loader_([app]() { return new MoodbarLoader(app, app); }),
         moodbar_controller_([app]() { return new MoodbarController(app, app); }),
+#endif
+#ifdef HAVE_GSTREAMER
+        analysis_manager_([app]() { return new AnalysisManager(app, app); }),
 #endif
         lastfm_import_([app]() { return new LastFMImport(app->network(), app); })
   {}
@@ -198,6 +257,7 @@ class ApplicationImpl {
   Lazy<TagReaderClient> tag_reader_client_;
   Lazy<Database> database_;
   Lazy<TaskManager> task_manager_;
+  Lazy<ThreadPoolManager> thread_pool_manager_;
   Lazy<Player> player_;
   Lazy<NetworkAccessManager> network_;
   Lazy<DeviceFinders> device_finders_;
@@ -217,6 +277,9 @@ class ApplicationImpl {
 #ifdef HAVE_MOODBAR
   Lazy<MoodbarLoader> moodbar_loader_;
   Lazy<MoodbarController> moodbar_controller_;
+#endif
+#ifdef HAVE_GSTREAMER
+  Lazy<AnalysisManager> analysis_manager_;
 #endif
   Lazy<LastFMImport> lastfm_import_;
 
@@ -228,9 +291,40 @@ Application::Application(QObject *parent)
   device_finders()->Init();
   collection()->Init();
   tag_reader_client();
+#ifdef HAVE_GSTREAMER
+  // Instantiated up front so it can watch for newly discovered songs.
+  analysis_manager();
+#endif
 
   QObject::connect(database(), &Database::Error, this, &Application::ErrorAdded);
 
+  // Everything the main window forces from here on belongs to the "visible" phase.
+  // The rest is brought up in the background well after first paint, but before the user is likely to need it.
+  sStartupPhase = "visible";
+  QTimer::singleShot(5s, this, &Application::InitializeBackgroundServices);
+
+}
+
+void Application::InitializeBackgroundServices() {
+
+  sStartupPhase = "background";
+
+  // Force the services nothing has asked for yet so their first real use doesn't pay for construction.
+  cover_providers();
+  lyrics_providers();
+  scrobbler();
+  internet_services();
+  radio_services();
+  lastfm_import();
+#ifndef Q_OS_WIN
+  device_manager();
+#endif
+
+  qLog(Debug) << "Startup service initialization:";
+  for (const ServiceInitRecord &record : sServiceInitRecords) {
+    qLog(Debug) << QString("%1 %2 at %3 ms, took %4 ms").arg(record.phase, -10).arg(record.name, -24).arg(record.started_ms, 6).arg(record.elapsed_ms, 5);
+  }
+
 }
 
 Application::~Application() {
@@ -273,6 +367,10 @@ void Application::MoveToThread(QObject *object, QThread *thread) {
 
 void Application::Exit() {
 
+  // Playlists save themselves incrementally during runtime; this only hands over changes still in a debounce window.
+  // Queued before the playlist backend's exit request so the backend drains them before it shuts down.
+  playlist_manager()->FlushDirtyPlaylists();
+
   wait_for_exit_ << tag_reader_client()
                  << collection()
                  << playlist_backend()
@@ -328,29 +426,33 @@ void Application::AddError(const QString &message) { emit ErrorAdded(message); }
 void Application::ReloadSettings() { emit SettingsChanged(); }
 void Application::OpenSettingsDialogAtPage(SettingsDialog::Page page) { emit SettingsDialogRequested(page); }
 
-TagReaderClient *Application::tag_reader_client() const { return p_->tag_reader_client_.get(); }
-Database *Application::database() const { return p_->database_.get(); }
-TaskManager *Application::task_manager() const { return p_->task_manager_.get(); }
-Player *Application::player() const { return p_->player_.get(); }
-NetworkAccessManager *Application::network() const { return p_->network_.get(); }
-DeviceFinders *Application::device_finders() const { return p_->device_finders_.get(); }
+TagReaderClient *Application::tag_reader_client() const { return InitService("TagReaderClient", p_->tag_reader_client_); }
+Database *Application::database() const { return InitService("Database", p_->database_); }
+TaskManager *Application::task_manager() const { return InitService("TaskManager", p_->task_manager_); }
+ThreadPoolManager *Application::thread_pool_manager() const { return InitService("ThreadPoolManager", p_->thread_pool_manager_); }
+Player *Application::player() const { return InitService("Player", p_->player_); }
+NetworkAccessManager *Application::network() const { return InitService("NetworkAccessManager", p_->network_); }
+DeviceFinders *Application::device_finders() const { return InitService("DeviceFinders", p_->device_finders_); }
 #ifndef Q_OS_WIN
-DeviceManager *Application::device_manager() const { return p_->device_manager_.get(); }
+DeviceManager *Application::device_manager() const { return InitService("DeviceManager", p_->device_manager_); }
 #endif
-SCollection *Application::collection() const { return p_->collection_.get(); }
+SCollection *Application::collection() const { return InitService("SCollection", p_->collection_); }
 CollectionBackend *Application::collection_backend() const { return collection()->backend(); }
 CollectionModel *Application::collection_model() const { return collection()->model(); }
-AlbumCoverLoader *Application::album_cover_loader() const { return p_->album_cover_loader_.get(); }
-CoverProviders *Application::cover_providers() const { return p_->cover_providers_.get(); }
-CurrentAlbumCoverLoader *Application::current_albumcover_loader() const { return p_->current_albumcover_loader_.get(); }
-LyricsProviders *Application::lyrics_providers() const { return p_->lyrics_providers_.get(); }
-PlaylistBackend *Application::playlist_backend() const { return p_->playlist_backend_.get(); }
-PlaylistManager *Application::playlist_manager() const { return p_->playlist_manager_.get(); }
-InternetServices *Application::internet_services() const { return p_->internet_services_.get(); }
-RadioServices *Application::radio_services() const { return p_->radio_services_.get(); }
-AudioScrobbler *Application::scrobbler() const { return p_->scrobbler_.get(); }
-LastFMImport *Application::lastfm_import() const { return p_->lastfm_import_.get(); }
+AlbumCoverLoader *Application::album_cover_loader() const { return InitService("AlbumCoverLoader", p_->album_cover_loader_); }
+CoverProviders *Application::cover_providers() const { return InitService("CoverProviders", p_->cover_providers_); }
+CurrentAlbumCoverLoader *Application::current_albumcover_loader() const { return InitService("CurrentAlbumCoverLoader", p_->current_albumcover_loader_); }
+LyricsProviders *Application::lyrics_providers() const { return InitService("LyricsProviders", p_->lyrics_providers_); }
+PlaylistBackend *Application::playlist_backend() const { return InitService("PlaylistBackend", p_->playlist_backend_); }
+PlaylistManager *Application::playlist_manager() const { return InitService("PlaylistManager", p_->playlist_manager_); }
+InternetServices *Application::internet_services() const { return InitService("InternetServices", p_->internet_services_); }
+RadioServices *Application::radio_services() const { return InitService("RadioServices", p_->radio_services_); }
+AudioScrobbler *Application::scrobbler() const { return InitService("AudioScrobbler", p_->scrobbler_); }
+LastFMImport *Application::lastfm_import() const { return InitService("LastFMImport", p_->lastfm_import_); }
 #ifdef HAVE_MOODBAR
-MoodbarController *Application::moodbar_controller() const { return p_->moodbar_controller_.get(); }
-MoodbarLoader *Application::moodbar_loader() const { return p_->moodbar_loader_.get(); }
+MoodbarController *Application::moodbar_controller() const { return InitService("MoodbarController", p_->moodbar_controller_); }
+MoodbarLoader *Application::moodbar_loader() const { return InitService("MoodbarLoader", p_->moodbar_loader_); }
+#endif
+#ifdef HAVE_GSTREAMER
+AnalysisManager *Application::analysis_manager() const { return InitService("AnalysisManager", p_->analysis_manager_); }
 #endif
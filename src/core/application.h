@@ -36,6 +36,7 @@
 class QThread;
 
 class TaskManager;
+class ThreadPoolManager;
 class ApplicationImpl;
 class TagReaderClient;
 class Database;
@@ -63,6 +64,9 @@ class RadioServices;
 class MoodbarController;
 class MoodbarLoader;
 #endif
+#ifdef HAVE_GSTREAMER
+class AnalysisManager;
+#endif
 
 class Application : public QObject {
   Q_OBJECT
@@ -74,6 +78,7 @@ class Application : public QObject {
   TagReaderClient *tag_reader_client() const;
   Database *database() const;
   TaskManager *task_manager() const;
+  ThreadPoolManager *thread_pool_manager() const;
   Player *player() const;
   NetworkAccessManager *network() const;
   DeviceFinders *device_finders() const;
@@ -103,6 +108,9 @@ class Application : public QObject {
   MoodbarController *moodbar_controller() const;
   MoodbarLoader *moodbar_loader() const;
 #endif
+#ifdef HAVE_GSTREAMER
+  AnalysisManager *analysis_manager() const;
+#endif
 
   LastFMImport *lastfm_import() const;
 
@@ -113,6 +121,7 @@ class Application : public QObject {
 
  private slots:
   void ExitReceived();
+  void InitializeBackgroundServices();
 
  public slots:
   void AddError(const QString &message);
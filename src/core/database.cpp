@@ -24,12 +24,17 @@
 #include <sqlite3.h>
 #include <boost/scope_exit.hpp>
 
+#include <chrono>
+
 #include <QObject>
 #include <QThread>
 #include <QMutex>
 #include <QIODevice>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
@@ -39,18 +44,28 @@
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QStandardPaths>
+#include <QtEndian>
 
 #include "core/logging.h"
 #include "taskmanager.h"
 #include "database.h"
 #include "application.h"
+#include "player.h"
+#include "engine/enginebase.h"
 #include "sqlquery.h"
 #include "scopedtransaction.h"
 
+using namespace std::chrono_literals;
+
 const char *Database::kDatabaseFilename = "strawberry.db";
-const int Database::kSchemaVersion = 16;
+const int Database::kSchemaVersion = 24;
 const int Database::kMinSupportedSchemaVersion = 10;
 const char *Database::kMagicAllSongsTables = "%allsongstables";
+const int Database::kWalCheckpointIntervalSeconds = 60;
+const qint64 Database::kWalTruncateSize = 16 * 1024 * 1024;
+const int Database::kMaintenanceIntervalSeconds = 6 * 60 * 60;
+// Caps how many rows ANALYZE scans per index so a maintenance pass stays cheap even on a large collection.
+const int Database::kAnalysisLimit = 400;
 
 int Database::sNextConnectionId = 1;
 QMutex Database::sNextConnectionIdMutex;
@@ -62,9 +77,12 @@ Database::Database(Application *app, QObject *parent, const QString &database_na
       mutex_(QMutex::Recursive),
 #endif
       injected_database_name_(database_name),
+      last_backup_change_counter_(0),
       query_hash_(0),
       startup_schema_version_(-1),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      checkpoint_timer_(new QTimer(this)),
+      maintenance_timer_(new QTimer(this)) {
 
   original_thread_ = thread();
 
@@ -75,6 +93,14 @@ Database::Database(Application *app, QObject *parent, const QString &database_na
 
   directory_ = QDir::toNativeSeparators(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
 
+  checkpoint_timer_->setInterval(kWalCheckpointIntervalSeconds * 1000);
+  QObject::connect(checkpoint_timer_, &QTimer::timeout, this, &Database::Checkpoint);
+  checkpoint_timer_->start();
+
+  maintenance_timer_->setInterval(kMaintenanceIntervalSeconds * 1000);
+  QObject::connect(maintenance_timer_, &QTimer::timeout, this, &Database::Maintenance);
+  maintenance_timer_->start();
+
   QMutexLocker l(&mutex_);
   Connect();
 
@@ -88,6 +114,11 @@ Database::~Database() {
     qLog(Error) << "Connection" << connection_id << "is still open!";
   }
 
+  const QList<sqlite3*> memory_database_handles = memory_databases_.values();
+  for (sqlite3 *handle : memory_database_handles) {
+    sqlite3_close(handle);
+  }
+
 }
 
 void Database::ExitAsync() {
@@ -97,6 +128,8 @@ void Database::ExitAsync() {
 void Database::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
+  checkpoint_timer_->stop();
+  maintenance_timer_->stop();
   Close();
   moveToThread(original_thread_);
   emit ExitFinished();
@@ -125,9 +158,28 @@ QSqlDatabase Database::Connect() {
     db = QSqlDatabase::addDatabase("QSQLITE", connection_id);
   }
   if (db.isOpen()) {
+    // Databases registered after this connection was opened still have to be attached to it.
+    QSet<QString> &attached = attached_to_connection_[connection_id];
+    if (attached.count() != attached_databases_.count()) {
+      const QStringList keys = attached_databases_.keys();
+      for (const QString &key : keys) {
+        if (attached.contains(key)) continue;
+        SqlQuery q(db);
+        q.prepare("ATTACH DATABASE :filename AS :alias");
+        q.BindValue(":filename", attached_databases_[key].filename_);
+        q.BindValue(":alias", key);
+        if (q.Exec()) {
+          attached.insert(key);
+        }
+        else {
+          ReportErrors(q);
+        }
+      }
+    }
     return db;
   }
-  db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=30000");
+  // URI handling is needed so shared in-memory databases can be attached.
+  db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=30000;QSQLITE_OPEN_URI=1");
   //qLog(Debug) << "Opened database with connection id" << connection_id;
 
   if (injected_database_name_.isNull()) {
@@ -142,6 +194,28 @@ QSqlDatabase Database::Connect() {
     return db;
   }
 
+  if (db.databaseName() != ":memory:") {
+    // Use WAL so writers don't block readers and the query paths get stable read snapshots while a scan is committing.
+    // Automatic checkpointing is disabled, the background checkpoint scheduler takes care of it instead.
+    {
+      SqlQuery q(db);
+      q.prepare("PRAGMA journal_mode=WAL");
+      if (!q.Exec() || !q.next() || q.value(0).toString().compare("wal", Qt::CaseInsensitive) != 0) {
+        qLog(Warning) << "Failed to set database journal mode to WAL";
+      }
+    }
+    {
+      SqlQuery q(db);
+      q.prepare("PRAGMA synchronous=NORMAL");
+      if (!q.Exec()) ReportErrors(q);
+    }
+    {
+      SqlQuery q(db);
+      q.prepare("PRAGMA wal_autocheckpoint=0");
+      if (!q.Exec()) ReportErrors(q);
+    }
+  }
+
   if (db.tables().count() == 0) {
     // Set up initial schema
     qLog(Info) << "Creating initial database schema";
@@ -167,6 +241,7 @@ QSqlDatabase Database::Connect() {
     if (!q.Exec()) {
       qFatal("Couldn't attach external database '%s'", key.toLatin1().constData());
     }
+    attached_to_connection_[connection_id].insert(key);
   }
 
   if (startup_schema_version_ == -1) {
@@ -192,6 +267,84 @@ QSqlDatabase Database::Connect() {
 
 }
 
+void Database::Checkpoint() {
+
+  QMutexLocker l(&mutex_);
+  QSqlDatabase db(Connect());
+  if (!db.isOpen() || db.databaseName() == ":memory:") return;
+
+  // Truncate the WAL file once it has grown past the threshold, otherwise just move its content into the database while we're idle.
+  const qint64 wal_size = QFileInfo(db.databaseName() + "-wal").size();
+
+  SqlQuery q(db);
+  if (wal_size >= kWalTruncateSize) {
+    q.prepare("PRAGMA wal_checkpoint(TRUNCATE)");
+  }
+  else {
+    q.prepare("PRAGMA wal_checkpoint(PASSIVE)");
+  }
+  if (!q.Exec()) {
+    ReportErrors(q);
+  }
+
+}
+
+void Database::Maintenance() {
+
+  // Leave the database alone while scans, transcodes or other tasks are doing real work, the next interval will try again.
+  if (app_ && !app_->task_manager()->GetTasks().isEmpty()) return;
+
+  QMutexLocker l(&mutex_);
+  QSqlDatabase db(Connect());
+  if (!db.isOpen() || db.databaseName() == ":memory:") return;
+
+  const int task_id = app_->task_manager()->StartTask(tr("Database maintenance"));
+  TaskManager::ScopedTask t(task_id, app_->task_manager());
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // Refresh the query planner statistics.
+  // With an analysis limit set, PRAGMA optimize only re-analyzes tables whose content changed enough to matter and samples a bounded number of rows per index.
+  {
+    SqlQuery q(db);
+    q.prepare(QString("PRAGMA analysis_limit=%1").arg(kAnalysisLimit));
+    if (!q.Exec()) {
+      ReportErrors(q);
+      return;
+    }
+  }
+  {
+    SqlQuery q(db);
+    q.prepare("PRAGMA optimize");
+    if (!q.Exec()) {
+      ReportErrors(q);
+      return;
+    }
+  }
+
+  qLog(Debug) << "Database statistics refresh took" << timer.restart() << "ms";
+
+  // A quick index health check, much cheaper than the full integrity_check done before backups.
+  {
+    SqlQuery q(db);
+    q.prepare("PRAGMA quick_check(10)");
+    if (!q.Exec()) {
+      ReportErrors(q);
+      return;
+    }
+    while (q.next()) {
+      const QString message = q.value(0).toString();
+      // If no errors are found, a single row with the value "ok" is returned
+      if (message == "ok") break;
+      app_->AddError("Database: " + message);
+    }
+  }
+
+  qLog(Debug) << "Database quick check took" << timer.elapsed() << "ms";
+
+}
+
 void Database::Close() {
 
   QMutexLocker l(&connect_mutex_);
@@ -210,6 +363,8 @@ void Database::Close() {
     QSqlDatabase::removeDatabase(connection_id);
   }
 
+  attached_to_connection_.remove(connection_id);
+
 }
 
 int Database::SchemaVersion(QSqlDatabase *db) {
@@ -298,6 +453,35 @@ void Database::AttachDatabaseOnDbConnection(const QString &database_name, const
 
 }
 
+bool Database::AttachInMemoryDatabase(const QString &database_name) {
+
+  const QString uri = QString("file:%1?mode=memory&cache=shared").arg(database_name);
+
+  {
+    QMutexLocker l(&connect_mutex_);
+    if (!memory_databases_.contains(database_name)) {
+      sqlite3 *handle = nullptr;
+      const QByteArray uri_data = uri.toUtf8();
+      if (sqlite3_open_v2(uri_data.constData(), &handle, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK) {
+        if (handle) {
+          qLog(Error) << "Failed to create in-memory database" << database_name << sqlite3_errmsg(handle);
+          sqlite3_close(handle);
+        }
+        else {
+          qLog(Error) << "Failed to create in-memory database" << database_name;
+        }
+        return false;
+      }
+      memory_databases_.insert(database_name, handle);
+    }
+  }
+
+  AttachDatabase(database_name, AttachedDatabase(uri, QString(), true));
+
+  return true;
+
+}
+
 void Database::DetachDatabase(const QString &database_name) {
 
   QMutexLocker l(&mutex_);
@@ -412,6 +596,12 @@ void Database::ExecSongTablesCommands(QSqlDatabase &db, const QStringList &song_
           continue;
         }
 
+        // Same hack for playlist_items: it stores song rows but is not a collection songs table,
+        // so the statistics count tables and their triggers don't apply to it - they would only tax every playlist row write.
+        if (table == "playlist_items" && (command.contains(QString(kMagicAllSongsTables) + "_counts") || command.contains(QString(kMagicAllSongsTables) + "_artists") || command.contains(QString(kMagicAllSongsTables) + "_albums"))) {
+          continue;
+        }
+
         qLog(Info) << "Updating" << table << "for" << kMagicAllSongsTables;
         QString new_command(command);
         new_command.replace(kMagicAllSongsTables, table);
@@ -518,20 +708,53 @@ bool Database::IntegrityCheck(const QSqlDatabase &db) {
 
 void Database::DoBackup() {
 
+  // Backing up competes with streaming and scans for disk, so put it off while something is playing.
+  if (app_->player()->GetState() == EngineBase::State::Playing) {
+    QTimer::singleShot(5min, this, &Database::DoBackup);
+    return;
+  }
+
   QSqlDatabase db(Connect());
 
   if (!db.isOpen()) return;
 
-  // Before we overwrite anything, make sure the database is not corrupt
-  QMutexLocker l(&mutex_);
+  // Nothing was checkpointed into the file since the last backup, so the copy would be identical.
+  // The WAL checkpoint timer runs often enough that pending changes only stay invisible to this check briefly.
+  const quint32 change_counter = FileChangeCounter(db.databaseName());
+  if (change_counter != 0 && change_counter == last_backup_change_counter_) {
+    qLog(Debug) << "Database unchanged since last backup, skipping backup";
+    return;
+  }
+
+  bool ok = false;
+  {
+    // Before we overwrite anything, make sure the database is not corrupt.
+    // Only the integrity check needs the mutex - the backup itself runs on separate connections and must not lock out writers.
+    QMutexLocker l(&mutex_);
+    ok = IntegrityCheck(db);
+  }
 
-  const bool ok = IntegrityCheck(db);
   if (ok && SchemaVersion(&db) == kSchemaVersion) {
-    BackupFile(db.databaseName());
+    if (BackupFile(db.databaseName())) {
+      last_backup_change_counter_ = FileChangeCounter(db.databaseName());
+    }
   }
 
 }
 
+quint32 Database::FileChangeCounter(const QString &filename) {
+
+  // The file change counter lives at offset 24 of the SQLite header and is bumped whenever content is written to the file.
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly) || !file.seek(24)) return 0;
+  const QByteArray data = file.read(4);
+  if (data.size() != 4) return 0;
+
+  return qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(data.constData()));
+
+}
+
 bool Database::OpenDatabase(const QString &filename, sqlite3 **connection) {
 
   const QByteArray filename_data = filename.toUtf8();
@@ -550,7 +773,12 @@ bool Database::OpenDatabase(const QString &filename, sqlite3 **connection) {
 
 }
 
-void Database::BackupFile(const QString &filename) {
+// How many pages to copy per backup step and how long to sleep between steps.
+// Sleeping releases the source database lock so backend writers can proceed; a write restarts the copy via the backup API's restart semantics.
+constexpr int kBackupStepPages = 16;
+constexpr int kBackupStepSleepMs = 25;
+
+bool Database::BackupFile(const QString &filename) {
 
   qLog(Debug) << "Starting database backup";
   QString dest_filename = QString("%1.bak").arg(filename);
@@ -569,28 +797,32 @@ void Database::BackupFile(const QString &filename) {
 
   bool success = OpenDatabase(filename, &source_connection);
   if (!success) {
-    return;
+    return false;
   }
 
   success = OpenDatabase(dest_filename, &dest_connection);
   if (!success) {
-    return;
+    return false;
   }
 
   sqlite3_backup *backup = sqlite3_backup_init(dest_connection, "main", source_connection, "main");
   if (!backup) {
     const char *error_message = sqlite3_errmsg(dest_connection);
     qLog(Error) << "Failed to start database backup:" << error_message;
-    return;
+    return false;
   }
 
   int ret = SQLITE_OK;
   do {
-    ret = sqlite3_backup_step(backup, 16);
+    ret = sqlite3_backup_step(backup, kBackupStepPages);
     const int page_count = sqlite3_backup_pagecount(backup);
     app_->task_manager()->SetTaskProgress(task_id, page_count - sqlite3_backup_remaining(backup), page_count);
+    // SQLITE_BUSY and SQLITE_LOCKED are transient - a writer has the database, so back off and try the step again.
+    if (ret == SQLITE_OK || ret == SQLITE_BUSY || ret == SQLITE_LOCKED) {
+      sqlite3_sleep(kBackupStepSleepMs);
+    }
   }
-  while (ret == SQLITE_OK);
+  while (ret == SQLITE_OK || ret == SQLITE_BUSY || ret == SQLITE_LOCKED);
 
   if (ret != SQLITE_DONE) {
     qLog(Error) << "Database backup failed";
@@ -598,4 +830,6 @@ void Database::BackupFile(const QString &filename) {
 
   sqlite3_backup_finish(backup);
 
+  return ret == SQLITE_DONE;
+
 }
@@ -30,6 +30,8 @@
 #include <QObject>
 #include <QMutex>
 #include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
@@ -41,6 +43,7 @@
 #include "sqlquery.h"
 
 class QThread;
+class QTimer;
 class Application;
 
 class Database : public QObject {
@@ -64,6 +67,10 @@ class Database : public QObject {
   static const int kMinSupportedSchemaVersion;
   static const char *kDatabaseFilename;
   static const char *kMagicAllSongsTables;
+  static const int kWalCheckpointIntervalSeconds;
+  static const qint64 kWalTruncateSize;
+  static const int kMaintenanceIntervalSeconds;
+  static const int kAnalysisLimit;
 
   void ExitAsync();
   QSqlDatabase Connect();
@@ -86,6 +93,10 @@ class Database : public QObject {
   void AttachDatabaseOnDbConnection(const QString &database_name, const AttachedDatabase &database, QSqlDatabase &db);
   void DetachDatabase(const QString &database_name);
 
+  // Creates a named shared in-memory database and attaches it to every connection, including connections that are already open.
+  // The memory database stays alive for the lifetime of this object. Returns false if it could not be created.
+  bool AttachInMemoryDatabase(const QString &database_name);
+
  signals:
   void ExitFinished();
   void Error(const QString &error);
@@ -93,6 +104,8 @@ class Database : public QObject {
 
  private slots:
   void Exit();
+  void Checkpoint();
+  void Maintenance();
 
  public slots:
   void DoBackup();
@@ -108,14 +121,22 @@ class Database : public QObject {
   void UrlEncodeFilenameColumn(const QString &table, QSqlDatabase &db);
   QStringList SongsTables(QSqlDatabase &db, const int schema_version);
   bool IntegrityCheck(const QSqlDatabase &db);
-  void BackupFile(const QString &filename);
+  bool BackupFile(const QString &filename);
   static bool OpenDatabase(const QString &filename, sqlite3 **connection);
+  // Reads the change counter from the SQLite file header, used as a generation counter to skip backups when nothing was written.
+  static quint32 FileChangeCounter(const QString &filename);
 
   Application *app_;
 
   // Alias -> filename
   QMap<QString, AttachedDatabase> attached_databases_;
 
+  // Keep-alive handles for shared in-memory databases, without one the memory database would be destroyed as soon as the last connection using it closes.
+  QHash<QString, sqlite3*> memory_databases_;
+
+  // Aliases already attached per connection, so databases registered later can still be attached to connections that were opened earlier.
+  QHash<QString, QSet<QString>> attached_to_connection_;
+
   QString directory_;
   QMutex connect_mutex_;
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
@@ -127,6 +148,9 @@ class Database : public QObject {
   // This ID makes the QSqlDatabase name unique to the object as well as the thread
   int connection_id_;
 
+  // Change counter of the database file when it was last backed up successfully, 0 if it never was.
+  quint32 last_backup_change_counter_;
+
   static QMutex sNextConnectionIdMutex;
   static int sNextConnectionId;
 
@@ -141,6 +165,12 @@ class Database : public QObject {
 
   QThread *original_thread_;
 
+  // Periodically moves WAL content into the database while the database is otherwise idle.
+  QTimer *checkpoint_timer_;
+
+  // Periodically refreshes query planner statistics and checks index health, skipped while other tasks are running.
+  QTimer *maintenance_timer_;
+
 };
 
 class MemoryDatabase : public Database {
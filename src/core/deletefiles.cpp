@@ -22,6 +22,10 @@
 #include "config.h"
 
 #include <QtGlobal>
+#include <QtConcurrent>
+#include <QAtomicInt>
+#include <QFutureSynchronizer>
+#include <QMutexLocker>
 #include <QThread>
 #include <QTimer>
 #include <QString>
@@ -42,6 +46,7 @@ DeleteFiles::DeleteFiles(TaskManager *task_manager, std::shared_ptr<MusicStorage
       storage_(storage),
       use_trash_(use_trash),
       started_(false),
+      max_concurrent_deletes_(1),
       task_id_(0),
       progress_(0) {
   original_thread_ = thread();
@@ -84,6 +89,7 @@ void DeleteFiles::ProcessSomeFiles() {
 
   if (!started_) {
     storage_->StartDelete();
+    max_concurrent_deletes_ = storage_->MaxConcurrentDeletes();
     started_ = true;
   }
 
@@ -108,21 +114,51 @@ void DeleteFiles::ProcessSomeFiles() {
 
   // We process files in batches so we can be cancelled part-way through.
 
-  const qint64 n = qMin(static_cast<qint64>(songs_.count()), static_cast<qint64>(progress_ + kBatchSize));
-  for (; progress_ < n; ++progress_) {
-    task_manager_->SetTaskProgress(task_id_, progress_, songs_.count());
-
-    const Song &song = songs_[progress_];
-
-    MusicStorage::DeleteJob job;
-    job.metadata_ = song;
-    job.use_trash_ = use_trash_;
+  const int n = static_cast<int>(qMin(static_cast<qint64>(songs_.count()), static_cast<qint64>(progress_ + kBatchSize)));
 
-    if (!storage_->DeleteFromStorage(job)) {
-      songs_with_errors_ << song;
+  if (max_concurrent_deletes_ <= 1) {
+    for (; progress_ < n; ++progress_) {
+      task_manager_->SetTaskProgress(task_id_, progress_, songs_.count());
+      if (!DeleteSong(songs_[progress_])) {
+        songs_with_errors_ << songs_[progress_];
+      }
+    }
+  }
+  else {
+    // The storage allows several deletes in flight, so slow mounts are not paced by one round trip per file.
+    // Workers pull the next index from a shared counter until the batch is exhausted.
+    const int first = progress_;
+    QAtomicInt next_index(first);
+    QAtomicInt done(0);
+    QFutureSynchronizer<void> sync;
+    const int workers = qMin(max_concurrent_deletes_, n - first);
+    for (int w = 0; w < workers; ++w) {
+      sync.addFuture(QtConcurrent::run([this, first, n, &next_index, &done]() {
+        forever {
+          const int i = next_index.fetchAndAddRelaxed(1);
+          if (i >= n) return;
+          if (!DeleteSong(songs_[i])) {
+            QMutexLocker l(&errors_mutex_);
+            songs_with_errors_ << songs_[i];
+          }
+          task_manager_->SetTaskProgress(task_id_, first + done.fetchAndAddRelaxed(1) + 1, songs_.count());
+        }
+      }));
     }
+    sync.waitForFinished();
+    progress_ = n;
   }
 
   QTimer::singleShot(0, this, &DeleteFiles::ProcessSomeFiles);
 
 }
+
+bool DeleteFiles::DeleteSong(const Song &song) {
+
+  MusicStorage::DeleteJob job;
+  job.metadata_ = song;
+  job.use_trash_ = use_trash_;
+
+  return storage_->DeleteFromStorage(job);
+
+}
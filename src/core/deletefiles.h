@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <QObject>
+#include <QMutex>
 #include <QStringList>
 
 #include "song.h"
@@ -54,6 +55,8 @@ class DeleteFiles : public QObject {
   void ProcessSomeFiles();
 
  private:
+  bool DeleteSong(const Song &song);
+
   QThread *thread_;
   QThread *original_thread_;
   TaskManager *task_manager_;
@@ -63,10 +66,12 @@ class DeleteFiles : public QObject {
   bool use_trash_;
 
   bool started_;
+  int max_concurrent_deletes_;
 
   int task_id_;
   int progress_;
 
+  QMutex errors_mutex_;
   SongList songs_with_errors_;
 };
 
@@ -40,7 +40,9 @@ class FilesystemMusicStorage : public virtual MusicStorage {
   std::optional<int> collection_directory_id() const override { return collection_directory_id_; }
 
   bool CopyToStorage(const CopyJob &job) override;
+  int MaxConcurrentCopies() const override;
   bool DeleteFromStorage(const DeleteJob &job) override;
+  int MaxConcurrentDeletes() const override;
 
  private:
   Song::Source source_;
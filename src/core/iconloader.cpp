@@ -21,6 +21,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QIcon>
@@ -33,11 +34,20 @@
 #include "settings/appearancesettingspage.h"
 #include "iconloader.h"
 
+namespace {
+// Icons built by Load(), kept for the lifetime of the process.
+// Icons are only used from the GUI thread, so access needs no locking.
+QHash<QString, QIcon> sIconCache;
+}  // namespace
+
 bool IconLoader::system_icons_ = false;
 bool IconLoader::custom_icons_ = false;
 
 void IconLoader::Init() {
 
+  // The icon sources below depend on the settings read here, so anything cached from before is stale.
+  sIconCache.clear();
+
 #if !defined(Q_OS_MACOS) && !defined(Q_OS_WIN)
   QSettings s;
   s.beginGroup(AppearanceSettingsPage::kSettingsGroup);
@@ -54,13 +64,30 @@ void IconLoader::Init() {
 
 QIcon IconLoader::Load(const QString &name, const bool system_icon, const int fixed_size, const int min_size, const int max_size) {
 
-  QIcon ret;
-
   if (name.isEmpty()) {
     qLog(Error) << "Icon name is empty!";
-    return ret;
+    return QIcon();
   }
 
+  // The same icons are requested over and over while the UI is built, and QIcon only shares its engine,
+  // and with it Qt's cached pixmaps, between copies of the same instance.
+  // Keeping the built icons around makes the path probing and PNG decoding below happen once per icon instead of once per caller.
+  const QString cache_key = QString("%1/%2/%3/%4/%5").arg(name).arg(system_icon ? 1 : 0).arg(fixed_size).arg(min_size).arg(max_size);
+  if (sIconCache.contains(cache_key)) {
+    return sIconCache[cache_key];
+  }
+
+  const QIcon ret = LoadUncached(name, system_icon, fixed_size, min_size, max_size);
+  sIconCache.insert(cache_key, ret);
+
+  return ret;
+
+}
+
+QIcon IconLoader::LoadUncached(const QString &name, const bool system_icon, const int fixed_size, const int min_size, const int max_size) {
+
+  QIcon ret;
+
   QList<int> sizes;
   if (fixed_size == 0) {
     sizes << 22 << 32 << 48 << 64 << 128;
@@ -0,0 +1,181 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <QFile>
+#include <QSocketNotifier>
+#include <QString>
+#include <QTimer>
+
+#include "core/logging.h"
+#include "filesystemwatcherinterface.h"
+#include "linuxfslistener.h"
+
+namespace {
+// How long to wait after the first event before emitting, so a burst of events for the same directory (an album rip, a sync job) collapses into one PathChanged per directory.
+constexpr int kCoalesceIntervalMs = 200;
+// Directory-level events matching what QFileSystemWatcher reports for watched directories.
+constexpr uint32_t kWatchMask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+}  // namespace
+
+LinuxFSListener::LinuxFSListener(QObject *parent)
+    : FileSystemWatcherInterface(parent),
+      fd_(-1),
+      notifier_(nullptr),
+      coalesce_timer_(new QTimer(this)),
+      logged_watch_limit_(false) {
+
+  coalesce_timer_->setSingleShot(true);
+  coalesce_timer_->setInterval(kCoalesceIntervalMs);
+  QObject::connect(coalesce_timer_, &QTimer::timeout, this, &LinuxFSListener::EmitChangedPaths);
+
+}
+
+LinuxFSListener::~LinuxFSListener() {
+
+  if (fd_ >= 0) close(fd_);
+
+}
+
+void LinuxFSListener::Init() {
+
+  fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd_ < 0) {
+    qLog(Error) << "Failed to initialize inotify:" << strerror(errno);
+    return;
+  }
+
+  notifier_ = new QSocketNotifier(fd_, QSocketNotifier::Read, this);
+  QObject::connect(notifier_, &QSocketNotifier::activated, this, &LinuxFSListener::ReadEvents);
+
+}
+
+void LinuxFSListener::AddPath(const QString &path) {
+
+  if (fd_ < 0 || wds_by_path_.contains(path)) return;
+
+  const int wd = inotify_add_watch(fd_, QFile::encodeName(path).constData(), kWatchMask);
+  if (wd < 0) {
+    if (errno == ENOSPC && !logged_watch_limit_) {
+      // Log the sysctl hint only once, a large collection would otherwise repeat it for every directory past the limit.
+      qLog(Error) << "Reached the inotify watch limit, consider raising fs.inotify.max_user_watches.";
+      logged_watch_limit_ = true;
+    }
+    qLog(Error) << "Failed to add watch for path" << path << strerror(errno);
+    return;
+  }
+
+  paths_by_wd_.insert(wd, path);
+  wds_by_path_.insert(path, wd);
+
+}
+
+void LinuxFSListener::RemovePath(const QString &path) {
+
+  if (fd_ < 0) return;
+
+  if (!wds_by_path_.contains(path)) {
+    qLog(Error) << "Failed to remove watch for path" << path;
+    return;
+  }
+
+  const int wd = wds_by_path_.take(path);
+  paths_by_wd_.remove(wd);
+  inotify_rm_watch(fd_, wd);
+
+}
+
+void LinuxFSListener::Clear() {
+
+  if (fd_ >= 0) {
+    const QList<int> wds = paths_by_wd_.keys();
+    for (const int wd : wds) {
+      inotify_rm_watch(fd_, wd);
+    }
+  }
+
+  paths_by_wd_.clear();
+  wds_by_path_.clear();
+  changed_paths_.clear();
+  coalesce_timer_->stop();
+
+}
+
+void LinuxFSListener::ReadEvents() {
+
+  // Big enough for a batch of events with filenames, the kernel delivers at most what fits.
+  alignas(struct inotify_event) char buffer[16384];
+
+  forever {
+
+    const ssize_t len = read(fd_, buffer, sizeof(buffer));
+    if (len <= 0) break;
+
+    ssize_t offset = 0;
+    while (offset + static_cast<ssize_t>(sizeof(struct inotify_event)) <= len) {
+
+      const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(struct inotify_event)) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        // The kernel dropped events, we no longer know which directories changed, so rescan all of them.
+        qLog(Warning) << "inotify event queue overflowed, marking all watched directories as changed.";
+        const QList<QString> paths = paths_by_wd_.values();
+        for (const QString &path : paths) changed_paths_.insert(path);
+        continue;
+      }
+
+      if (!paths_by_wd_.contains(event->wd)) continue;
+
+      const QString path = paths_by_wd_.value(event->wd);
+      changed_paths_.insert(path);
+
+      if (event->mask & IN_IGNORED) {
+        // The watch is gone, either the directory was deleted or moved, or the watch was removed.
+        paths_by_wd_.remove(event->wd);
+        wds_by_path_.remove(path);
+      }
+
+    }
+
+  }
+
+  if (!changed_paths_.isEmpty() && !coalesce_timer_->isActive()) {
+    coalesce_timer_->start();
+  }
+
+}
+
+void LinuxFSListener::EmitChangedPaths() {
+
+  const QSet<QString> changed_paths = changed_paths_;
+  changed_paths_.clear();
+
+  for (const QString &path : changed_paths) {
+    emit PathChanged(path);
+  }
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LINUXFSLISTENER_H
+#define LINUXFSLISTENER_H
+
+#include "config.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include "filesystemwatcherinterface.h"
+
+class QTimer;
+class QSocketNotifier;
+
+// Watches directories with a single inotify descriptor instead of going through QFileSystemWatcher.
+// QFileSystemWatcher keeps its path lists in flat arrays, so registering a large collection directory by directory is quadratic and dominates startup on big libraries.
+// Here a watch registration is one inotify_add_watch() call and two hash inserts, and events are coalesced per directory before they are emitted, so a burst of writes into one directory triggers a single rescan.
+// The listener lives on the collection watcher's thread and all work happens there; no extra thread is needed because inotify registration is cheap and reads are non-blocking.
+class LinuxFSListener : public FileSystemWatcherInterface {
+  Q_OBJECT
+
+ public:
+  explicit LinuxFSListener(QObject *parent = nullptr);
+  ~LinuxFSListener() override;
+
+  void Init() override;
+  void AddPath(const QString &path) override;
+  void RemovePath(const QString &path) override;
+  void Clear() override;
+
+ private slots:
+  void ReadEvents();
+  void EmitChangedPaths();
+
+ private:
+  int fd_;
+  QSocketNotifier *notifier_;
+  QTimer *coalesce_timer_;
+  QHash<int, QString> paths_by_wd_;
+  QHash<QString, int> wds_by_path_;
+  QSet<QString> changed_paths_;
+  bool logged_watch_limit_;
+
+};
+
+#endif  // LINUXFSLISTENER_H
@@ -73,8 +73,12 @@
 #include <QToolButton>
 #include <QCheckBox>
 #include <QClipboard>
+#include <QDateTime>
+#include <QStandardPaths>
 
 #include "core/logging.h"
+#include "core/playbacklatency.h"
+#include "core/trace.h"
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
@@ -91,6 +95,7 @@
 #include "player.h"
 #include "filesystemmusicstorage.h"
 #include "deletefiles.h"
+#include "settingswriter.h"
 #ifdef Q_OS_MACOS
 #  include "mac_startup.h"
 #  include "macsystemtrayicon.h"
@@ -130,6 +135,7 @@
 #include "collection/collectionquery.h"
 #include "collection/collectionview.h"
 #include "collection/collectionviewcontainer.h"
+#include "collection/collectionwatcher.h"
 #include "playlist/playlist.h"
 #include "playlist/playlistbackend.h"
 #include "playlist/playlistcontainer.h"
@@ -259,9 +265,29 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
 #endif
       context_view_(new ContextView(this)),
       collection_view_(new CollectionViewContainer(this)),
-      file_view_(new FileView(this)),
+      file_view_([this]() {
+        FileView *file_view = new FileView(this);
+        QObject::connect(file_view, &FileView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
+        QObject::connect(file_view, &FileView::PathChanged, this, &MainWindow::FilePathChanged);
+#ifdef HAVE_GSTREAMER
+        QObject::connect(file_view, &FileView::CopyToCollection, this, &MainWindow::CopyFilesToCollection);
+        QObject::connect(file_view, &FileView::MoveToCollection, this, &MainWindow::MoveFilesToCollection);
+        QObject::connect(file_view, &FileView::EditTags, this, &MainWindow::EditFileTags);
+#  ifndef Q_OS_WIN
+        QObject::connect(file_view, &FileView::CopyToDevice, this, &MainWindow::CopyFilesToDevice);
+#  endif
+#endif
+        file_view->SetTaskManager(app_->task_manager());
+        file_view->SetPath(settings_.value("file_path", QDir::homePath()).toString());
+        return file_view;
+      }),
 #ifndef Q_OS_WIN
-      device_view_(new DeviceViewContainer(this)),
+      device_view_([this]() {
+        DeviceViewContainer *device_view = new DeviceViewContainer(this);
+        device_view->view()->SetApplication(app_);
+        QObject::connect(device_view->view(), &DeviceView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        return device_view;
+      }),
 #endif
       playlist_list_(new PlaylistListContainer(this)),
       queue_view_(new QueueView(this)),
@@ -292,17 +318,46 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
         QObject::connect(add_stream_dialog, &AddStreamDialog::accepted, this, &MainWindow::AddStreamAccepted);
         return add_stream_dialog;
       }),
-      smartplaylists_view_(new SmartPlaylistsViewContainer(app, this)),
+      smartplaylists_view_([this, app]() {
+        SmartPlaylistsViewContainer *smartplaylists_view = new SmartPlaylistsViewContainer(app, this);
+        QObject::connect(smartplaylists_view, &SmartPlaylistsViewContainer::AddToPlaylist, this, &MainWindow::AddToPlaylist);
+        return smartplaylists_view;
+      }),
 #ifdef HAVE_SUBSONIC
-      subsonic_view_(new InternetSongsView(app_, app->internet_services()->ServiceBySource(Song::Source::Subsonic), SubsonicSettingsPage::kSettingsGroup, SettingsDialog::Page::Subsonic, this)),
+      subsonic_view_([this, app]() {
+        InternetSongsView *subsonic_view = new InternetSongsView(app_, app->internet_services()->ServiceBySource(Song::Source::Subsonic), SubsonicSettingsPage::kSettingsGroup, SettingsDialog::Page::Subsonic, this);
+        QObject::connect(subsonic_view->view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        return subsonic_view;
+      }),
 #endif
 #ifdef HAVE_TIDAL
-      tidal_view_(new InternetTabsView(app_, app->internet_services()->ServiceBySource(Song::Source::Tidal), TidalSettingsPage::kSettingsGroup, SettingsDialog::Page::Tidal, this)),
+      tidal_view_([this, app]() {
+        InternetTabsView *tidal_view = new InternetTabsView(app_, app->internet_services()->ServiceBySource(Song::Source::Tidal), TidalSettingsPage::kSettingsGroup, SettingsDialog::Page::Tidal, this);
+        QObject::connect(tidal_view->artists_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(tidal_view->albums_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(tidal_view->songs_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(tidal_view->search_view(), &InternetSearchView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
+        return tidal_view;
+      }),
 #endif
 #ifdef HAVE_QOBUZ
-      qobuz_view_(new InternetTabsView(app_, app->internet_services()->ServiceBySource(Song::Source::Qobuz), QobuzSettingsPage::kSettingsGroup, SettingsDialog::Page::Qobuz, this)),
+      qobuz_view_([this, app]() {
+        InternetTabsView *qobuz_view = new InternetTabsView(app_, app->internet_services()->ServiceBySource(Song::Source::Qobuz), QobuzSettingsPage::kSettingsGroup, SettingsDialog::Page::Qobuz, this);
+        QObject::connect(qobuz_view->artists_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(qobuz_view->albums_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(qobuz_view->songs_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        QObject::connect(qobuz_view->search_view(), &InternetSearchView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
+        return qobuz_view;
+      }),
 #endif
-      radio_view_(new RadioViewContainer(this)),
+      radio_view_([this]() {
+        RadioViewContainer *radio_view = new RadioViewContainer(this);
+        radio_view->view()->setModel(app_->radio_services()->sort_model());
+        QObject::connect(radio_view, &RadioViewContainer::Refresh, app_->radio_services(), &RadioServices::RefreshChannels);
+        QObject::connect(radio_view->view(), &RadioView::GetChannels, app_->radio_services(), &RadioServices::GetChannels);
+        QObject::connect(radio_view->view(), &RadioView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
+        return radio_view;
+      }),
       lastfm_import_dialog_(new LastFMImportDialog(app_->lastfm_import(), this)),
       collection_show_all_(nullptr),
       collection_show_duplicates_(nullptr),
@@ -365,24 +420,25 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   StyleHelper::setBaseColor(palette().color(QPalette::Highlight).darker());
 
   // Add tabs to the fancy tab widget
+  // Tabs the user may never open get lazy views, built the first time their tab is shown.
   ui_->tabs->AddTab(context_view_, "context", IconLoader::Load("strawberry", true, 0, 32), tr("Context"));
   ui_->tabs->AddTab(collection_view_, "collection", IconLoader::Load("library-music", true, 0, 32), tr("Collection"));
   ui_->tabs->AddTab(queue_view_, "queue", IconLoader::Load("footsteps", true, 0, 32), tr("Queue"));
   ui_->tabs->AddTab(playlist_list_, "playlists", IconLoader::Load("view-media-playlist", true, 0, 32), tr("Playlists"));
-  ui_->tabs->AddTab(smartplaylists_view_, "smartplaylists", IconLoader::Load("view-media-playlist", true, 0, 32), tr("Smart playlists"));
-  ui_->tabs->AddTab(file_view_, "files", IconLoader::Load("document-open", true, 0, 32), tr("Files"));
-  ui_->tabs->AddTab(radio_view_, "radios", IconLoader::Load("radio", true, 0, 32), tr("Radios"));
+  ui_->tabs->AddLazyTab([this]() { return smartplaylists_view_.get(); }, "smartplaylists", IconLoader::Load("view-media-playlist", true, 0, 32), tr("Smart playlists"));
+  ui_->tabs->AddLazyTab([this]() { return file_view_.get(); }, "files", IconLoader::Load("document-open", true, 0, 32), tr("Files"));
+  ui_->tabs->AddLazyTab([this]() { return radio_view_.get(); }, "radios", IconLoader::Load("radio", true, 0, 32), tr("Radios"));
 #ifndef Q_OS_WIN
-  ui_->tabs->AddTab(device_view_, "devices", IconLoader::Load("device", true, 0, 32), tr("Devices"));
+  ui_->tabs->AddLazyTab([this]() { return device_view_.get(); }, "devices", IconLoader::Load("device", true, 0, 32), tr("Devices"));
 #endif
 #ifdef HAVE_SUBSONIC
-  ui_->tabs->AddTab(subsonic_view_, "subsonic", IconLoader::Load("subsonic", true, 0, 32), tr("Subsonic"));
+  ui_->tabs->AddLazyTab([this]() { return subsonic_view_.get(); }, "subsonic", IconLoader::Load("subsonic", true, 0, 32), tr("Subsonic"));
 #endif
 #ifdef HAVE_TIDAL
-  ui_->tabs->AddTab(tidal_view_, "tidal", IconLoader::Load("tidal", true, 0, 32), tr("Tidal"));
+  ui_->tabs->AddLazyTab([this]() { return tidal_view_.get(); }, "tidal", IconLoader::Load("tidal", true, 0, 32), tr("Tidal"));
 #endif
 #ifdef HAVE_QOBUZ
-  ui_->tabs->AddTab(qobuz_view_, "qobuz", IconLoader::Load("qobuz", true, 0, 32), tr("Qobuz"));
+  ui_->tabs->AddLazyTab([this]() { return qobuz_view_.get(); }, "qobuz", IconLoader::Load("qobuz", true, 0, 32), tr("Qobuz"));
 #endif
 
   // Add the playing widget to the fancy tab widget
@@ -423,15 +479,10 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
 
   collection_view_->view()->setModel(collection_sort_model_);
   collection_view_->view()->SetApplication(app_);
-#ifndef Q_OS_WIN
-  device_view_->view()->SetApplication(app_);
-#endif
   playlist_list_->SetApplication(app_);
 
   organize_dialog_->SetDestinationModel(app_->collection()->model()->directory_model());
 
-  radio_view_->view()->setModel(app_->radio_services()->sort_model());
-
   // Icons
   qLog(Debug) << "Creating UI";
 
@@ -491,19 +542,6 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   ui_->action_toggle_scrobbling->setIcon(IconLoader::Load("scrobble-disabled"));
   ui_->action_love->setIcon(IconLoader::Load("love"));
 
-  // File view connections
-  QObject::connect(file_view_, &FileView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
-  QObject::connect(file_view_, &FileView::PathChanged, this, &MainWindow::FilePathChanged);
-#ifdef HAVE_GSTREAMER
-  QObject::connect(file_view_, &FileView::CopyToCollection, this, &MainWindow::CopyFilesToCollection);
-  QObject::connect(file_view_, &FileView::MoveToCollection, this, &MainWindow::MoveFilesToCollection);
-  QObject::connect(file_view_, &FileView::EditTags, this, &MainWindow::EditFileTags);
-#  ifndef Q_OS_WIN
-  QObject::connect(file_view_, &FileView::CopyToDevice, this, &MainWindow::CopyFilesToDevice);
-#  endif
-#endif
-  file_view_->SetTaskManager(app_->task_manager());
-
   // Action connections
   QObject::connect(ui_->action_next_track, &QAction::triggered, app_->player(), &Player::Next);
   QObject::connect(ui_->action_previous_track, &QAction::triggered, app_->player(), &Player::Previous);
@@ -613,6 +651,7 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
 
   QObject::connect(app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, this, &MainWindow::SongChanged);
   QObject::connect(app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, app_->player(), &Player::CurrentMetadataChanged);
+  QObject::connect(app_->playlist_manager(), &PlaylistManager::CurrentSongChanged, app_->collection()->watcher(), &CollectionWatcher::CurrentSongChanged);
   QObject::connect(app_->playlist_manager(), &PlaylistManager::EditingFinished, this, &MainWindow::PlaylistEditFinished);
   QObject::connect(app_->playlist_manager(), &PlaylistManager::Error, this, &MainWindow::ShowErrorDialog);
   QObject::connect(app_->playlist_manager(), &PlaylistManager::SummaryTextChanged, ui_->playlist_summary, &QLabel::setText);
@@ -659,11 +698,6 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   QObject::connect(album_cover_choice_controller_->search_cover_auto_action(), &QAction::triggered, this, &MainWindow::SearchCoverAutomatically);
   QObject::connect(album_cover_choice_controller_->search_cover_auto_action(), &QAction::toggled, this, &MainWindow::ToggleSearchCoverAuto);
 
-#ifndef Q_OS_WIN
-  // Devices connections
-  QObject::connect(device_view_->view(), &DeviceView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-#endif
-
   // Collection filter widget
   QActionGroup *collection_view_group = new QActionGroup(this);
 
@@ -692,31 +726,12 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   collection_view_->filter_widget()->AddMenuAction(separator);
   collection_view_->filter_widget()->AddMenuAction(collection_config_action);
 
-#ifdef HAVE_SUBSONIC
-  QObject::connect(subsonic_view_->view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-#endif
-
 #ifdef HAVE_TIDAL
-  QObject::connect(tidal_view_->artists_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(tidal_view_->albums_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(tidal_view_->songs_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(tidal_view_->search_view(), &InternetSearchView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
   if (TidalService *tidalservice = qobject_cast<TidalService*>(app_->internet_services()->ServiceBySource(Song::Source::Tidal))) {
     QObject::connect(this, &MainWindow::AuthorizationUrlReceived, tidalservice, &TidalService::AuthorizationUrlReceived);
   }
 #endif
 
-#ifdef HAVE_QOBUZ
-  QObject::connect(qobuz_view_->artists_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(qobuz_view_->albums_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(qobuz_view_->songs_collection_view(), &InternetCollectionView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-  QObject::connect(qobuz_view_->search_view(), &InternetSearchView::AddToPlaylist, this, &MainWindow::AddToPlaylist);
-#endif
-
-  QObject::connect(radio_view_, &RadioViewContainer::Refresh, app_->radio_services(), &RadioServices::RefreshChannels);
-  QObject::connect(radio_view_->view(), &RadioView::GetChannels, app_->radio_services(), &RadioServices::GetChannels);
-  QObject::connect(radio_view_->view(), &RadioView::AddToPlaylistSignal, this, &MainWindow::AddToPlaylist);
-
   // Playlist menu
   QObject::connect(playlist_menu_, &QMenu::aboutToHide, this, &MainWindow::PlaylistMenuHidden);
   playlist_play_pause_ = playlist_menu_->addAction(tr("Play"), this, &MainWindow::PlaylistPlay);
@@ -872,6 +887,8 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   QObject::connect(this, &MainWindow::SearchCoverInProgress, ui_->widget_playing, &PlayingWidget::SearchCoverInProgress);
 
   QObject::connect(ui_->action_console, &QAction::triggered, this, &MainWindow::ShowConsole);
+  QObject::connect(ui_->action_dump_trace, &QAction::triggered, this, &MainWindow::DumpTrace);
+  QObject::connect(ui_->action_playback_latency, &QAction::triggered, this, &MainWindow::ShowPlaybackLatency);
   PlayingWidgetPositionChanged(ui_->widget_playing->show_above_status_bar());
 
   StyleSheetLoader *css_loader = new StyleSheetLoader(this);
@@ -893,9 +910,6 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
   QObject::connect(app_->playlist_manager()->sequence(), &PlaylistSequence::RepeatModeChanged, osd_, &OSDBase::RepeatModeChanged);
   QObject::connect(app_->playlist_manager()->sequence(), &PlaylistSequence::ShuffleModeChanged, osd_, &OSDBase::ShuffleModeChanged);
 
-  // Smart playlists
-  QObject::connect(smartplaylists_view_, &SmartPlaylistsViewContainer::AddToPlaylist, this, &MainWindow::AddToPlaylist);
-
   ScrobbleButtonVisibilityChanged(app_->scrobbler()->ScrobbleButton());
   LoveButtonVisibilityChanged(app_->scrobbler()->LoveButton());
   ScrobblingEnabledChanged(app_->scrobbler()->IsEnabled());
@@ -928,8 +942,6 @@ MainWindow::MainWindow(Application *app, std::shared_ptr<SystemTrayIcon> tray_ic
 
   TabSwitched();
 
-  file_view_->SetPath(settings_.value("file_path", QDir::homePath()).toString());
-
   // Users often collapse one side of the splitter by mistake and don't know how to restore it. This must be set after the state is restored above.
   ui_->splitter->setChildrenCollapsible(false);
 
@@ -1134,10 +1146,10 @@ void MainWindow::ReloadSettings() {
   bool enable_subsonic = s.value("enabled", false).toBool();
   s.endGroup();
   if (enable_subsonic) {
-    ui_->tabs->EnableTab(subsonic_view_);
+    ui_->tabs->EnableTab("subsonic");
   }
   else {
-    ui_->tabs->DisableTab(subsonic_view_);
+    ui_->tabs->DisableTab("subsonic");
   }
   app_->scrobbler()->Service<SubsonicScrobbler>()->ReloadSettings();
 #endif
@@ -1147,10 +1159,10 @@ void MainWindow::ReloadSettings() {
   bool enable_tidal = s.value("enabled", false).toBool();
   s.endGroup();
   if (enable_tidal) {
-    ui_->tabs->EnableTab(tidal_view_);
+    ui_->tabs->EnableTab("tidal");
   }
   else {
-    ui_->tabs->DisableTab(tidal_view_);
+    ui_->tabs->DisableTab("tidal");
   }
 #endif
 
@@ -1159,10 +1171,10 @@ void MainWindow::ReloadSettings() {
   bool enable_qobuz = s.value("enabled", false).toBool();
   s.endGroup();
   if (enable_qobuz) {
-    ui_->tabs->EnableTab(qobuz_view_);
+    ui_->tabs->EnableTab("qobuz");
   }
   else {
-    ui_->tabs->DisableTab(qobuz_view_);
+    ui_->tabs->DisableTab("qobuz");
   }
 #endif
 
@@ -1183,11 +1195,11 @@ void MainWindow::ReloadAllSettings() {
   app_->playlist_manager()->playlist_container()->ReloadSettings();
   album_cover_choice_controller_->ReloadSettings();
   context_view_->ReloadSettings();
-  file_view_->ReloadSettings();
+  if (file_view_) file_view_->ReloadSettings();
   queue_view_->ReloadSettings();
   playlist_list_->ReloadSettings();
-  smartplaylists_view_->ReloadSettings();
-  radio_view_->ReloadSettings();
+  if (smartplaylists_view_) smartplaylists_view_->ReloadSettings();
+  if (radio_view_) radio_view_->ReloadSettings();
   app_->internet_services()->ReloadSettings();
   app_->radio_services()->ReloadSettings();
   app_->cover_providers()->ReloadSettings();
@@ -1196,13 +1208,13 @@ void MainWindow::ReloadAllSettings() {
   app_->moodbar_controller()->ReloadSettings();
 #endif
 #ifdef HAVE_SUBSONIC
-  subsonic_view_->ReloadSettings();
+  if (subsonic_view_) subsonic_view_->ReloadSettings();
 #endif
 #ifdef HAVE_TIDAL
-  tidal_view_->ReloadSettings();
+  if (tidal_view_) tidal_view_->ReloadSettings();
 #endif
 #ifdef HAVE_QOBUZ
-  qobuz_view_->ReloadSettings();
+  if (qobuz_view_) qobuz_view_->ReloadSettings();
 #endif
 
 }
@@ -1225,6 +1237,9 @@ void MainWindow::SaveSettings() {
   settings_.setValue("show_sidebar", ui_->action_toggle_show_sidebar->isChecked());
   settings_.setValue("search_for_cover_auto", album_cover_choice_controller_->search_cover_auto_action()->isChecked());
 
+  // Make sure queued settings writes reach the file before we exit.
+  SettingsWriter::Flush();
+
 }
 
 void MainWindow::Exit() {
@@ -1419,7 +1434,7 @@ void MainWindow::TrackSkipped(PlaylistItemPtr item) {
 
 void MainWindow::TabSwitched() {
 
-  if (playing_widget_ && ui_->action_toggle_show_sidebar->isChecked() && (ui_->tabs->currentIndex() != ui_->tabs->IndexOfTab(context_view_) || !context_view_->album_enabled())) {
+  if (playing_widget_ && ui_->action_toggle_show_sidebar->isChecked() && (ui_->tabs->currentIndex() != ui_->tabs->IndexOfTab("context") || !context_view_->album_enabled())) {
     ui_->widget_playing->SetEnabled();
   }
   else {
@@ -2931,7 +2946,7 @@ void MainWindow::AutoCompleteTags() {
 
   // Create the tag fetching stuff if it hasn't been already
   if (!tag_fetcher_) {
-    tag_fetcher_ = std::make_unique<TagFetcher>(app_->network());
+    tag_fetcher_ = std::make_unique<TagFetcher>(app_->network(), app_->collection_backend());
     track_selection_dialog_ = std::make_unique<TrackSelectionDialog>();
     track_selection_dialog_->set_save_on_close(true);
 
@@ -3009,6 +3024,30 @@ void MainWindow::ShowConsole() {
 
 }
 
+void MainWindow::DumpTrace() {
+
+  const QString filename = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/trace-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".json";
+  if (Trace::Dump(filename)) {
+    qLog(Info) << "Wrote trace events to" << filename;
+    QMessageBox::information(this, tr("Dump trace"), tr("Wrote trace events to %1, load the file through chrome://tracing or ui.perfetto.dev.").arg(filename));
+  }
+  else {
+    QMessageBox::warning(this, tr("Dump trace"), tr("Could not write trace file %1").arg(filename));
+  }
+
+}
+
+void MainWindow::ShowPlaybackLatency() {
+
+  const QString filename = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/playback-latency-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".csv";
+  QString message = PlaybackLatency::Summary();
+  if (PlaybackLatency::Export(filename)) {
+    message += "\n" + tr("Wrote the individual measurements to %1.").arg(filename);
+  }
+  QMessageBox::information(this, tr("Playback start latency"), message);
+
+}
+
 void MainWindow::keyPressEvent(QKeyEvent *e) {
 
   if (e->key() == Qt::Key_Space) {
@@ -3206,21 +3245,21 @@ void MainWindow::PlaylistDelete() {
 
 void MainWindow::FocusSearchField() {
 
-  if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab(collection_view_) && !collection_view_->filter_widget()->SearchFieldHasFocus()) {
+  if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab("collection") && !collection_view_->filter_widget()->SearchFieldHasFocus()) {
     collection_view_->filter_widget()->FocusSearchField();
   }
 #ifdef HAVE_SUBSONIC
-  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab(subsonic_view_) && !subsonic_view_->SearchFieldHasFocus()) {
+  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab("subsonic") && !subsonic_view_->SearchFieldHasFocus()) {
     subsonic_view_->FocusSearchField();
   }
 #endif
 #ifdef HAVE_TIDAL
-  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab(tidal_view_) && !tidal_view_->SearchFieldHasFocus()) {
+  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab("tidal") && !tidal_view_->SearchFieldHasFocus()) {
     tidal_view_->FocusSearchField();
   }
 #endif
 #ifdef HAVE_QOBUZ
-  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab(qobuz_view_) && !qobuz_view_->SearchFieldHasFocus()) {
+  else if (ui_->tabs->currentIndex() == ui_->tabs->IndexOfTab("qobuz") && !qobuz_view_->SearchFieldHasFocus()) {
     qobuz_view_->FocusSearchField();
   }
 #endif
@@ -247,6 +247,8 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   void HandleNotificationPreview(const OSDBase::Behaviour type, const QString &line1, const QString &line2);
 
   void ShowConsole();
+  void DumpTrace();
+  void ShowPlaybackLatency();
 
   void LoadCoverFromFile();
   void SaveCoverToFile();
@@ -309,9 +311,10 @@ class MainWindow : public QMainWindow, public PlatformInterface {
 
   ContextView *context_view_;
   CollectionViewContainer *collection_view_;
-  FileView *file_view_;
+  // The views below are created lazily the first time their tab is shown, so they don't slow down startup.
+  Lazy<FileView> file_view_;
 #ifndef Q_OS_WIN
-  DeviceViewContainer *device_view_;
+  Lazy<DeviceViewContainer> device_view_;
 #endif
   PlaylistListContainer *playlist_list_;
   QueueView *queue_view_;
@@ -332,13 +335,19 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   std::unique_ptr<TrackSelectionDialog> track_selection_dialog_;
   PlaylistItemPtrList autocomplete_tag_items_;
 
-  SmartPlaylistsViewContainer *smartplaylists_view_;
+  Lazy<SmartPlaylistsViewContainer> smartplaylists_view_;
 
-  InternetSongsView *subsonic_view_;
-  InternetTabsView *tidal_view_;
-  InternetTabsView *qobuz_view_;
+#ifdef HAVE_SUBSONIC
+  Lazy<InternetSongsView> subsonic_view_;
+#endif
+#ifdef HAVE_TIDAL
+  Lazy<InternetTabsView> tidal_view_;
+#endif
+#ifdef HAVE_QOBUZ
+  Lazy<InternetTabsView> qobuz_view_;
+#endif
 
-  RadioViewContainer *radio_view_;
+  Lazy<RadioViewContainer> radio_view_;
 
   LastFMImportDialog *lastfm_import_dialog_;
 
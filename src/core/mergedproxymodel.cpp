@@ -497,13 +497,11 @@ void MergedProxyModel::fetchMore(const QModelIndex &parent) {
 
 QAbstractItemModel *MergedProxyModel::GetModel(const QModelIndex &source_index) const {
 
-  // This is essentially const_cast<QAbstractItemModel*>(source_index.model()), but without the const_cast
+  // The const_cast is safe because the model is only handed back if it is one of our own submodels.
   const QAbstractItemModel *const_model = source_index.model();
   if (const_model == sourceModel()) return sourceModel();
-  QList<QAbstractItemModel*> submodels = merge_points_.keys();
-  for (QAbstractItemModel *submodel : submodels) {
-    if (submodel == const_model) return submodel;
-  }
+  QAbstractItemModel *submodel = const_cast<QAbstractItemModel*>(const_model);
+  if (merge_points_.contains(submodel)) return submodel;
 
   return nullptr;
 
@@ -69,7 +69,8 @@ class MimeData : public QMimeData {
 
   // Returns a pretty name for a playlist containing songs described by this MimeData object.
   // By pretty name we mean the value of 'name_for_new_playlist_' or generic "Playlist" string if the 'name_for_new_playlist_' attribute is empty.
-  QString get_name_for_new_playlist() {
+  // Virtual so that lazily resolved mime data can fill in the name on first use.
+  virtual QString get_name_for_new_playlist() const {
     return name_for_new_playlist_.isEmpty() ? tr("Playlist") : name_for_new_playlist_;
   }
 };
@@ -97,11 +97,13 @@ namespace mpris {
 const char *Mpris2::kMprisObjectPath = "/org/mpris/MediaPlayer2";
 const char *Mpris2::kServiceName = "org.mpris.MediaPlayer2.strawberry";
 const char *Mpris2::kFreedesktopPath = "org.freedesktop.DBus.Properties";
+const char *Mpris2::kLevelsInterface = "org.strawberrymusicplayer.strawberry.Levels";
 
 Mpris2::Mpris2(Application *app, QObject *parent)
     : QObject(parent),
       app_(app),
-      app_name_(QCoreApplication::applicationName()) {
+      app_name_(QCoreApplication::applicationName()),
+      properties_flush_queued_(false) {
 
   new Mpris2Root(this);
   new Mpris2TrackList(this);
@@ -121,6 +123,7 @@ Mpris2::Mpris2(Application *app, QObject *parent)
   QObject::connect(app_->current_albumcover_loader(), &CurrentAlbumCoverLoader::AlbumCoverLoaded, this, &Mpris2::AlbumCoverLoaded);
 
   QObject::connect(app_->player()->engine(), &EngineBase::StateChanged, this, &Mpris2::EngineStateChanged);
+  QObject::connect(app_->player()->engine(), &EngineBase::LevelSnapshotPublished, this, &Mpris2::EngineLevelSnapshotPublished);
   QObject::connect(app_->player(), &Player::VolumeChanged, this, &Mpris2::VolumeChanged);
   QObject::connect(app_->player(), &Player::Seeked, this, &Mpris2::Seeked);
 
@@ -180,6 +183,26 @@ void Mpris2::VolumeChanged() {
   EmitNotification("Volume");
 }
 
+void Mpris2::EngineLevelSnapshotPublished() {
+
+  // Not part of MPRIS, but published on the same object so level consumers only have to watch one service.
+  // The signal carries the measurements directly instead of going through PropertiesChanged - these come at a fixed rate and are never worth caching.
+  EngineBase::LevelSnapshot snapshot;
+  if (!app_->player()->engine()->LatestLevelSnapshot(&snapshot)) return;
+
+  QVariantList rms_db;
+  QVariantList peak_db;
+  for (int i = 0; i < snapshot.channels; ++i) {
+    rms_db << snapshot.rms_db[i];
+    peak_db << snapshot.peak_db[i];
+  }
+
+  QDBusMessage msg = QDBusMessage::createSignal(kMprisObjectPath, kLevelsInterface, "LevelsChanged");
+  msg.setArguments(QVariantList() << snapshot.endtime_nanosec << QVariant(rms_db) << QVariant(peak_db));
+  QDBusConnection::sessionBus().send(msg);
+
+}
+
 void Mpris2::ShuffleModeChanged() { EmitNotification("Shuffle"); }
 
 void Mpris2::RepeatModeChanged() {
@@ -196,12 +219,35 @@ void Mpris2::EmitNotification(const QString &name, const QVariant &value) {
 
 void Mpris2::EmitNotification(const QString &name, const QVariant &value, const QString &mprisEntity) {
 
-  QDBusMessage msg = QDBusMessage::createSignal(kMprisObjectPath, kFreedesktopPath, "PropertiesChanged");
-  QVariantMap map;
-  map.insert(name, value);
-  QVariantList args = QVariantList() << mprisEntity << map << QStringList();
-  msg.setArguments(args);
-  QDBusConnection::sessionBus().send(msg);
+  // A single playlist mutation or state change touches several properties at once, and sending each one as its own PropertiesChanged signal floods the session bus.
+  // Queue the change instead, drop values identical to what was last sent, and flush one signal per interface once control returns to the event loop.
+  if (emitted_properties_.contains(mprisEntity) && emitted_properties_[mprisEntity].contains(name) && emitted_properties_[mprisEntity][name] == value) {
+    return;
+  }
+
+  pending_properties_[mprisEntity][name] = value;
+  emitted_properties_[mprisEntity][name] = value;
+
+  if (!properties_flush_queued_) {
+    properties_flush_queued_ = true;
+    QMetaObject::invokeMethod(this, &Mpris2::EmitPendingNotifications, Qt::QueuedConnection);
+  }
+
+}
+
+void Mpris2::EmitPendingNotifications() {
+
+  properties_flush_queued_ = false;
+
+  const QMap<QString, QVariantMap> pending = pending_properties_;
+  pending_properties_.clear();
+
+  for (QMap<QString, QVariantMap>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+    QDBusMessage msg = QDBusMessage::createSignal(kMprisObjectPath, kFreedesktopPath, "PropertiesChanged");
+    QVariantList args = QVariantList() << it.key() << it.value() << QStringList();
+    msg.setArguments(args);
+    QDBusConnection::sessionBus().send(msg);
+  }
 
 }
 
@@ -637,7 +683,8 @@ void Mpris2::PlaylistChangedSlot(Playlist *playlist) {
 
 void Mpris2::PlaylistCollectionChanged(Playlist *playlist) {
   Q_UNUSED(playlist);
-  EmitNotification("PlaylistCount", "", "org.mpris.MediaPlayer2.Playlists");
+  // Sending the real count makes the change detectable by the diff in EmitNotification; an empty placeholder value would be deduplicated after the first emission.
+  EmitNotification("PlaylistCount", PlaylistCount(), "org.mpris.MediaPlayer2.Playlists");
 }
 
 }  // namespace mpris
@@ -205,6 +205,7 @@ class Mpris2 : public QObject {
   void AlbumCoverLoaded(const Song &song, AlbumCoverLoaderResultPtr result = AlbumCoverLoaderResultPtr());
   void EngineStateChanged(EngineBase::State newState);
   void VolumeChanged();
+  void EngineLevelSnapshotPublished();
 
   void PlaylistManagerInitialized();
   void CurrentSongChanged(const Song &song);
@@ -212,6 +213,7 @@ class Mpris2 : public QObject {
   void RepeatModeChanged();
   void PlaylistChangedSlot(Playlist *playlist);
   void PlaylistCollectionChanged(Playlist *playlist);
+  void EmitPendingNotifications();
 
  private:
   void EmitNotification(const QString &name);
@@ -230,6 +232,7 @@ class Mpris2 : public QObject {
   static const char *kMprisObjectPath;
   static const char *kServiceName;
   static const char *kFreedesktopPath;
+  static const char *kLevelsInterface;
 
   Application *app_;
 
@@ -239,6 +242,12 @@ class Mpris2 : public QObject {
   QString desktop_file_;
   QVariantMap last_metadata_;
 
+  // Property changes queued by EmitNotification, keyed by MPRIS interface.
+  // They are coalesced into one PropertiesChanged signal per interface per event loop turn, and values the bus has already seen are dropped.
+  QMap<QString, QVariantMap> pending_properties_;
+  QMap<QString, QVariantMap> emitted_properties_;
+  bool properties_flush_queued_;
+
 };
 
 }  // namespace mpris
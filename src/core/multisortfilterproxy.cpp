@@ -24,6 +24,8 @@
 #include <QObject>
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
+#include <QHash>
+#include <QList>
 #include <QMetaType>
 #include <QDateTime>
 #include <QVariant>
@@ -39,16 +41,76 @@ void MultiSortFilterProxy::AddSortSpec(int role, Qt::SortOrder order) {
   sorting_ << SortSpec(role, order);
 }
 
-bool MultiSortFilterProxy::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+void MultiSortFilterProxy::Resort() {
+
+  sort_key_cache_.clear();
+  invalidate();
+
+}
+
+void MultiSortFilterProxy::setSourceModel(QAbstractItemModel *source_model) {
+
+  if (sourceModel()) {
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::dataChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::modelReset, this, &MultiSortFilterProxy::InvalidateSortKeys);
+  }
+
+  QSortFilterProxyModel::setSourceModel(source_model);
+  sort_key_cache_.clear();
+
+  if (sourceModel()) {
+    QObject::connect(sourceModel(), &QAbstractItemModel::dataChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &MultiSortFilterProxy::InvalidateSortKeys);
+    QObject::connect(sourceModel(), &QAbstractItemModel::modelReset, this, &MultiSortFilterProxy::InvalidateSortKeys);
+  }
+
+}
+
+void MultiSortFilterProxy::InvalidateSortKeys() {
+
+  // Row numbers baked into the cached source indexes shift on any structural change, so the whole cache goes.
+  // Rebuilding it costs one data() call per row and role on the next sort pass.
+  sort_key_cache_.clear();
 
+}
+
+QList<QVariant> MultiSortFilterProxy::SortKeys(const QModelIndex &idx) const {
+
+  if (sort_key_cache_.contains(idx)) {
+    return sort_key_cache_[idx];
+  }
+
+  QList<QVariant> keys;
+  keys.reserve(sorting_.count());
   for (const SortSpec &spec : sorting_) {
-    const int ret = Compare(left.data(spec.first), right.data(spec.first));
+    keys << idx.data(spec.first);
+  }
+  sort_key_cache_.insert(idx, keys);
+
+  return keys;
+
+}
+
+bool MultiSortFilterProxy::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+
+  // data() on the source model resolves the role per call, which dominates when sorting tens of thousands of rows.
+  // The extracted keys are cached per source index instead, so each row is only queried once per sort pass.
+  const QList<QVariant> left_keys = SortKeys(left);
+  const QList<QVariant> right_keys = SortKeys(right);
+
+  for (int i = 0; i < sorting_.count(); ++i) {
+    const int ret = Compare(left_keys[i], right_keys[i]);
 
     if (ret < 0) {
-      return spec.second == Qt::AscendingOrder;
+      return sorting_[i].second == Qt::AscendingOrder;
     }
     else if (ret > 0) {
-      return spec.second != Qt::AscendingOrder;
+      return sorting_[i].second != Qt::AscendingOrder;
     }
   }
 
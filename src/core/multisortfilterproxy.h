@@ -24,6 +24,7 @@
 #include "config.h"
 
 #include <QSortFilterProxyModel>
+#include <QHash>
 #include <QList>
 #include <QPair>
 #include <QVariant>
@@ -38,14 +39,27 @@ class MultiSortFilterProxy : public QSortFilterProxyModel {
 
   void AddSortSpec(int role, Qt::SortOrder order = Qt::AscendingOrder);
 
+  // Re-sorts and re-filters the whole view in one pass.
+  // Cheaper than the incremental per-row sorting when a loader has just repopulated the source model.
+  void Resort();
+
+  void setSourceModel(QAbstractItemModel *source_model) override;
+
  protected:
   bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 
+ private slots:
+  void InvalidateSortKeys();
+
  private:
   int Compare(const QVariant &left, const QVariant &right) const;
+  QList<QVariant> SortKeys(const QModelIndex &idx) const;
 
   using SortSpec = QPair<int, Qt::SortOrder>;
   QList<SortSpec> sorting_;
+
+  // Sort keys extracted per source index, so a sort pass calls data() once per row instead of once per comparison.
+  mutable QHash<QModelIndex, QList<QVariant>> sort_key_cache_;
 };
 
 #endif  // MULTISORTFILTERPROXY_H
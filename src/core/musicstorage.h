@@ -89,10 +89,16 @@ class MusicStorage {
 
   virtual bool StartCopy(QList<Song::FileType> *supported_types) { Q_UNUSED(supported_types); return true; }
   virtual bool CopyToStorage(const CopyJob &job) = 0;
+  // How many CopyToStorage calls may safely run at the same time.
+  // Plain filesystem destinations override this, protocol based storages such as MTP and GIO mounts stay serial.
+  virtual int MaxConcurrentCopies() const { return 1; }
   virtual void FinishCopy(bool success) { Q_UNUSED(success); }
 
   virtual void StartDelete() {}
   virtual bool DeleteFromStorage(const DeleteJob &job) = 0;
+  // How many DeleteFromStorage calls may safely run at the same time.
+  // Plain filesystem storages override this, device storages mutate shared state per delete and stay serial.
+  virtual int MaxConcurrentDeletes() const { return 1; }
   virtual void FinishDelete(bool success) { Q_UNUSED(success); }
 
   virtual void Eject() {}
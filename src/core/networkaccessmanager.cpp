@@ -21,27 +21,91 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QCoreApplication>
 #include <QIODevice>
 #include <QByteArray>
+#include <QPair>
+#include <QList>
 #include <QString>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QDateTime>
+#include <QAbstractNetworkCache>
 #include <QNetworkAccessManager>
+#include <QNetworkCacheMetaData>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 
+#include "core/logging.h"
 #include "networkaccessmanager.h"
 #include "threadsafenetworkdiskcache.h"
 
+const QNetworkRequest::Attribute NetworkAccessManager::kCacheTtlAttribute = QNetworkRequest::User;
+const int NetworkAccessManager::kRequestsLogInterval = 100;
+
 NetworkAccessManager::NetworkAccessManager(QObject *parent)
-    : QNetworkAccessManager(parent) {
+    : QNetworkAccessManager(parent),
+      requests_finished_(0),
+      requests_http2_(0) {
 
   setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
   setCache(new ThreadSafeNetworkDiskCache(this));
 
 }
 
+void NetworkAccessManager::SetCacheTtl(QNetworkRequest *request, const int ttl_secs) {
+  request->setAttribute(kCacheTtlAttribute, ttl_secs);
+}
+
+QUrl NetworkAccessManager::CanonicalUrl(const QUrl &url) {
+
+  QUrlQuery url_query(url);
+  QList<QPair<QString, QString>> query_items = url_query.queryItems(QUrl::FullyEncoded);
+  std::stable_sort(query_items.begin(), query_items.end(), [](const QPair<QString, QString> &a, const QPair<QString, QString> &b) { return a.first < b.first; });
+
+  QUrlQuery sorted_query;
+  sorted_query.setQueryItems(query_items);
+
+  QUrl canonical_url(url);
+  canonical_url.setQuery(sorted_query);
+
+  return canonical_url;
+
+}
+
+void NetworkAccessManager::SaveResponseToCache(QNetworkReply *reply, const int ttl_secs) {
+
+  QAbstractNetworkCache *network_cache = cache();
+  if (!network_cache) return;
+
+  if (reply->error() != QNetworkReply::NoError) return;
+  if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) return;
+  const int status_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  if (status_code < 200 || status_code > 299) return;
+
+  QNetworkCacheMetaData metadata;
+  metadata.setUrl(reply->request().url());
+  metadata.setSaveToDisk(true);
+  metadata.setExpirationDate(QDateTime::currentDateTime().addSecs(ttl_secs));
+  if (reply->header(QNetworkRequest::ContentTypeHeader).isValid()) {
+    metadata.setRawHeaders(QNetworkCacheMetaData::RawHeaderList() << qMakePair(QByteArray("Content-Type"), reply->header(QNetworkRequest::ContentTypeHeader).toString().toUtf8()));
+  }
+
+  // Peek instead of read so the data is still available to the reply's own handler, which is connected after this one.
+  const QByteArray data = reply->peek(reply->bytesAvailable());
+
+  QIODevice *device = network_cache->prepare(metadata);
+  if (!device) return;
+  device->write(data);
+  network_cache->insert(device);
+
+}
+
 QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) {
 
   QByteArray user_agent;
@@ -65,6 +129,35 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     new_request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
   }
 
-  return QNetworkAccessManager::createRequest(op, new_request, outgoingData);
+  // The cache keys on the exact request URL, canonicalize the query for requests with a TTL override so the same search always hits the same entry.
+  const int cache_ttl_secs = new_request.attribute(kCacheTtlAttribute).toInt();
+  if (op == QNetworkAccessManager::GetOperation && cache_ttl_secs > 0) {
+    new_request.setUrl(CanonicalUrl(new_request.url()));
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+  // Allow HTTP/2 unless the caller has changed the setting already, so bursts of requests to the same host share one multiplexed connection.
+  if (!new_request.attribute(QNetworkRequest::Http2AllowedAttribute).isValid()) {
+    new_request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+  }
+#endif
+
+  QNetworkReply *reply = QNetworkAccessManager::createRequest(op, new_request, outgoingData);
+
+  if (op == QNetworkAccessManager::GetOperation && cache_ttl_secs > 0) {
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_ttl_secs]() { SaveResponseToCache(reply, cache_ttl_secs); });
+  }
+
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+    ++requests_finished_;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    if (reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()) ++requests_http2_;
+#endif
+    if (requests_finished_ % kRequestsLogInterval == 0) {
+      qLog(Debug) << "Network:" << requests_finished_ << "replies finished," << requests_http2_ << "over HTTP/2";
+    }
+  });
+
+  return reply;
 
 }
@@ -31,6 +31,7 @@
 
 class QIODevice;
 class QNetworkReply;
+class QUrl;
 
 class NetworkAccessManager : public QNetworkAccessManager {
   Q_OBJECT
@@ -38,8 +39,25 @@ class NetworkAccessManager : public QNetworkAccessManager {
  public:
   explicit NetworkAccessManager(QObject *parent = nullptr);
 
+  // API responses usually carry no-store or no-cache headers, so they are never cached even when repeated searches send identical queries.
+  // Setting a TTL on a GET request stores the response in the network cache with that expiration regardless of what the server's cache headers say,
+  // and the query of the request URL is canonicalized so permuted but identical queries share one cache entry.
+  static void SetCacheTtl(QNetworkRequest *request, const int ttl_secs);
+
  protected:
   QNetworkReply *createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) override;
+
+ private:
+  static QUrl CanonicalUrl(const QUrl &url);
+  void SaveResponseToCache(QNetworkReply *reply, const int ttl_secs);
+
+ private:
+  static const QNetworkRequest::Attribute kCacheTtlAttribute;
+
+  // Counters to verify connection reuse, logged every kRequestsLogInterval finished replies.
+  static const int kRequestsLogInterval;
+  int requests_finished_;
+  int requests_http2_;
 };
 
 #endif  // NETWORKACCESSMANAGER_H
@@ -20,40 +20,94 @@
 
 #include "config.h"
 
+#include <algorithm>
+
 #include <QObject>
 #include <QNetworkReply>
 #include <QTimerEvent>
 
 #include "networktimeouts.h"
 
+const int NetworkTimeouts::kMinTimeoutMsec = 1500;
+const int NetworkTimeouts::kMinLatencySamples = 4;
+const int NetworkTimeouts::kMaxLatencySamples = 32;
+
 NetworkTimeouts::NetworkTimeouts(const int timeout_msec, QObject *parent)
     : QObject(parent),
       timeout_msec_(timeout_msec) {}
 
 void NetworkTimeouts::AddReply(QNetworkReply *reply) {
 
-  if (timers_.contains(reply)) return;
+  if (replies_.contains(reply)) return;
 
-  QObject::connect(reply, &QNetworkReply::destroyed, this, &NetworkTimeouts::ReplyFinished);
+  QObject::connect(reply, &QNetworkReply::destroyed, this, &NetworkTimeouts::ReplyDestroyed);
   QObject::connect(reply, &QNetworkReply::finished, this, &NetworkTimeouts::ReplyFinished);
-  timers_[reply] = startTimer(timeout_msec_);
+
+  ReplyData data;
+  data.host = reply->url().host();
+  data.timer_id = startTimer(TimeoutForHost(data.host));
+  data.elapsed.start();
+  replies_[reply] = data;
+
+}
+
+int NetworkTimeouts::TimeoutForHost(const QString &host) const {
+
+  if (!latencies_by_host_.contains(host)) return timeout_msec_;
+
+  const QList<qint64> &latencies = latencies_by_host_[host];
+  if (latencies.count() < kMinLatencySamples) return timeout_msec_;
+
+  // Twice the worst recent latency plus fixed slack stands in for "p99 plus margin" at this sample count.
+  const qint64 worst = *std::max_element(latencies.constBegin(), latencies.constEnd());
+  return qBound(static_cast<qint64>(kMinTimeoutMsec), worst * 2 + 500, static_cast<qint64>(timeout_msec_));
+
+}
+
+void NetworkTimeouts::RecordLatency(const QString &host, const qint64 latency_msec) {
+
+  QList<qint64> &latencies = latencies_by_host_[host];
+  latencies << latency_msec;
+  while (latencies.count() > kMaxLatencySamples) latencies.removeFirst();
 
 }
 
 void NetworkTimeouts::ReplyFinished() {
 
   QNetworkReply *reply = reinterpret_cast<QNetworkReply*>(sender());
-  if (timers_.contains(reply)) {
-    killTimer(timers_.take(reply));
+  if (replies_.contains(reply)) {
+    const ReplyData data = replies_.take(reply);
+    killTimer(data.timer_id);
+    if (reply->error() == QNetworkReply::NoError) {
+      RecordLatency(data.host, data.elapsed.elapsed());
+    }
+  }
+
+}
+
+void NetworkTimeouts::ReplyDestroyed(QObject *object) {
+
+  // The reply is half destructed here, so only the pointer value may be used.
+  QNetworkReply *reply = reinterpret_cast<QNetworkReply*>(object);
+  if (replies_.contains(reply)) {
+    killTimer(replies_.take(reply).timer_id);
   }
 
 }
 
 void NetworkTimeouts::timerEvent(QTimerEvent *e) {
 
-  QNetworkReply *reply = timers_.key(e->timerId());
-  if (reply) {
-    reply->abort();
+  for (QHash<QNetworkReply*, ReplyData>::iterator it = replies_.begin(); it != replies_.end(); ++it) {
+    if (it.value().timer_id == e->timerId()) {
+      QNetworkReply *reply = it.key();
+      // A timeout means the history no longer predicts this host, so drop it and let the
+      // following requests fall back to the full configured timeout instead of aborting in a cascade.
+      latencies_by_host_.remove(it.value().host);
+      killTimer(it.value().timer_id);
+      replies_.erase(it);  // clazy:exclude=strict-iterators
+      reply->abort();
+      break;
+    }
   }
 
 }
@@ -25,7 +25,10 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QElapsedTimer>
 #include <QHash>
+#include <QList>
+#include <QString>
 
 class QNetworkReply;
 class QTimerEvent;
@@ -44,10 +47,28 @@ class NetworkTimeouts : public QObject {
 
  private slots:
   void ReplyFinished();
+  void ReplyDestroyed(QObject *object);
 
  private:
+  // The deadline for a host with enough history is derived from its recently observed latencies, with the configured
+  // timeout as the ceiling - so a LAN server fails fast while a slow remote API still gets the full allowance.
+  int TimeoutForHost(const QString &host) const;
+  void RecordLatency(const QString &host, const qint64 latency_msec);
+
+ private:
+  struct ReplyData {
+    int timer_id = 0;
+    QString host;
+    QElapsedTimer elapsed;
+  };
+
+  static const int kMinTimeoutMsec;
+  static const int kMinLatencySamples;
+  static const int kMaxLatencySamples;
+
   int timeout_msec_;
-  QHash<QNetworkReply*, int> timers_;
+  QHash<QNetworkReply*, ReplyData> replies_;
+  QHash<QString, QList<qint64>> latencies_by_host_;
 
 };
 
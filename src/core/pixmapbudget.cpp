@@ -0,0 +1,169 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "pixmapbudget.h"
+
+#include <functional>
+#include <list>
+#include <utility>
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QThread>
+#include <QHash>
+#include <QMap>
+#include <QPixmap>
+#include <QString>
+
+#include "logging.h"
+
+namespace {
+
+// 160MB, matching the old default QPixmapCache limit.  Overridden from the collection settings on startup.
+constexpr qint64 kDefaultBudgetBytes = 160 * 1024 * 1024;
+
+struct Entry {
+  QString consumer;
+  QString key;
+  QPixmap pixmap;
+  qint64 cost;
+};
+
+struct Budget {
+  Budget() : max_bytes(kDefaultBudgetBytes), total_bytes(0) {}
+
+  qint64 max_bytes;
+  qint64 total_bytes;
+
+  // Most recently used entries are at the front.
+  std::list<Entry> entries;
+  // Composite consumer + key -> position in the LRU list.
+  QHash<QString, std::list<Entry>::iterator> lookup;
+
+  QMap<QString, qint64> consumer_bytes;
+  QMap<QString, std::function<void(const QString&)>> eviction_callbacks;
+};
+
+Budget *budget() {
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+  static Budget budget;
+  return &budget;
+}
+
+QString CompositeKey(const QString &consumer, const QString &key) {
+  return consumer + QLatin1Char('\n') + key;
+}
+
+qint64 PixmapCost(const QPixmap &pixmap) {
+  return static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+void RemoveEntry(Budget *b, const std::list<Entry>::iterator it, const bool evicted) {
+
+  b->total_bytes -= it->cost;
+  b->consumer_bytes[it->consumer] -= it->cost;
+  b->lookup.remove(CompositeKey(it->consumer, it->key));
+
+  if (evicted && b->eviction_callbacks.contains(it->consumer)) {
+    b->eviction_callbacks[it->consumer](it->key);
+  }
+
+  b->entries.erase(it);
+
+}
+
+void EvictUntilWithinBudget(Budget *b) {
+
+  while (b->total_bytes > b->max_bytes && !b->entries.empty()) {
+    RemoveEntry(b, std::prev(b->entries.end()), true);
+  }
+
+}
+
+}  // namespace
+
+void PixmapBudget::SetBudget(const qint64 max_bytes) {
+
+  Budget *b = budget();
+  b->max_bytes = qMax(static_cast<qint64>(0), max_bytes);
+  EvictUntilWithinBudget(b);
+
+}
+
+void PixmapBudget::RegisterEvictionCallback(const QString &consumer, std::function<void(const QString &key)> callback) {
+  budget()->eviction_callbacks[consumer] = std::move(callback);
+}
+
+bool PixmapBudget::Find(const QString &consumer, const QString &key, QPixmap *pixmap) {
+
+  Budget *b = budget();
+
+  const auto lookup_it = b->lookup.constFind(CompositeKey(consumer, key));
+  if (lookup_it == b->lookup.constEnd()) return false;
+
+  // Mark as most recently used.
+  b->entries.splice(b->entries.begin(), b->entries, lookup_it.value());
+
+  *pixmap = lookup_it.value()->pixmap;
+  return true;
+
+}
+
+void PixmapBudget::Insert(const QString &consumer, const QString &key, const QPixmap &pixmap) {
+
+  Budget *b = budget();
+
+  const qint64 cost = PixmapCost(pixmap);
+  if (cost > b->max_bytes) {
+    qLog(Warning) << "Pixmap" << key << "of" << cost << "bytes exceeds the whole pixmap budget, not caching it";
+    return;
+  }
+
+  const auto lookup_it = b->lookup.constFind(CompositeKey(consumer, key));
+  if (lookup_it != b->lookup.constEnd()) {
+    RemoveEntry(b, lookup_it.value(), false);
+  }
+
+  b->entries.push_front(Entry{consumer, key, pixmap, cost});
+  b->lookup[CompositeKey(consumer, key)] = b->entries.begin();
+  b->total_bytes += cost;
+  b->consumer_bytes[consumer] += cost;
+
+  EvictUntilWithinBudget(b);
+
+}
+
+void PixmapBudget::Remove(const QString &consumer, const QString &key) {
+
+  Budget *b = budget();
+
+  const auto lookup_it = b->lookup.constFind(CompositeKey(consumer, key));
+  if (lookup_it != b->lookup.constEnd()) {
+    RemoveEntry(b, lookup_it.value(), false);
+  }
+
+}
+
+qint64 PixmapBudget::ConsumerBytes(const QString &consumer) {
+  return budget()->consumer_bytes.value(consumer, 0);
+}
+
+qint64 PixmapBudget::TotalBytes() {
+  return budget()->total_bytes;
+}
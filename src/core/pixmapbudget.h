@@ -0,0 +1,56 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PIXMAPBUDGET_H
+#define PIXMAPBUDGET_H
+
+#include <functional>
+
+#include <QtGlobal>
+#include <QPixmap>
+#include <QString>
+
+// One memory budget for all the scaled artwork the views keep around.
+// Every view used to fill QPixmapCache independently, so the total pixmap
+// memory depended on how much the user browsed and nobody knew who was using
+// it.  Views insert and look up their pixmaps here under a consumer name
+// instead; the budget keeps per-consumer byte accounting and evicts the least
+// recently used pixmaps - across all consumers - once the configured cap is
+// exceeded.  A view finding its pixmap gone simply re-requests it, exactly as
+// it already does on a cold cache; the optional eviction callback lets a
+// consumer drop bookkeeping it keeps per cached key.
+//
+// Like QPixmapCache this may only be used from the main thread.
+class PixmapBudget {
+ public:
+  // Sets the global cap in bytes.  Evicts immediately if the cache is over the new cap.
+  static void SetBudget(const qint64 max_bytes);
+
+  // Registers a callback that is invoked with the key of every pixmap of this consumer that gets evicted.
+  static void RegisterEvictionCallback(const QString &consumer, std::function<void(const QString &key)> callback);
+
+  static bool Find(const QString &consumer, const QString &key, QPixmap *pixmap);
+  static void Insert(const QString &consumer, const QString &key, const QPixmap &pixmap);
+  static void Remove(const QString &consumer, const QString &key);
+
+  static qint64 ConsumerBytes(const QString &consumer);
+  static qint64 TotalBytes();
+};
+
+#endif  // PIXMAPBUDGET_H
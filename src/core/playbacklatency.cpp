@@ -0,0 +1,154 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <algorithm>
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QTextStream>
+
+#include "core/logging.h"
+#include "playbacklatency.h"
+
+namespace PlaybackLatency {
+
+namespace {
+
+constexpr int kStageCount = 4;
+// Enough history for percentiles without unbounded growth over a long session.
+constexpr int kMaxRecords = 512;
+
+const char *kStageNames[kStageCount] = { "url resolved", "engine load", "pipeline created", "first buffer" };
+
+// One finished playback start. Values are microseconds since Begin(), -1 for stages the start skipped.
+struct Record {
+  qint64 stages_us[kStageCount];
+};
+
+QMutex mutex;
+QElapsedTimer timer;
+bool pending = false;
+Record current;
+QList<Record> records;
+// Checked lock-free for every buffer on the streaming thread, only the first buffer after Begin() takes the mutex.
+QAtomicInt awaiting_first_buffer;
+
+qint64 Percentile(QList<qint64> values, const int percent) {
+
+  std::sort(values.begin(), values.end());
+  const int idx = std::min(static_cast<int>(values.count() * percent / 100), static_cast<int>(values.count() - 1));
+  return values[idx];
+
+}
+
+}  // namespace
+
+void Begin() {
+
+  QMutexLocker l(&mutex);
+
+  timer.start();
+  for (int i = 0; i < kStageCount; ++i) current.stages_us[i] = -1;
+  pending = true;
+  awaiting_first_buffer.storeRelease(1);
+
+}
+
+void Mark(const Stage stage) {
+
+  QMutexLocker l(&mutex);
+
+  if (!pending) return;
+  current.stages_us[static_cast<int>(stage)] = timer.nsecsElapsed() / 1000;
+
+}
+
+void MarkFirstBuffer() {
+
+  if (!awaiting_first_buffer.testAndSetAcquire(1, 0)) return;
+
+  QMutexLocker l(&mutex);
+
+  if (!pending) return;
+  pending = false;
+
+  current.stages_us[static_cast<int>(Stage::FirstBuffer)] = timer.nsecsElapsed() / 1000;
+  records << current;
+  while (records.count() > kMaxRecords) records.removeFirst();
+
+  qLog(Debug) << "Playback start took" << current.stages_us[static_cast<int>(Stage::FirstBuffer)] / 1000 << "ms from click to first buffer";
+
+}
+
+QString Summary() {
+
+  QMutexLocker l(&mutex);
+
+  if (records.isEmpty()) {
+    return QObject::tr("No playback starts have been measured yet.");
+  }
+
+  QString ret = QObject::tr("Playback starts measured: %1").arg(records.count());
+
+  for (int stage = 0; stage < kStageCount; ++stage) {
+    QList<qint64> values;
+    values.reserve(records.count());
+    for (const Record &record : records) {
+      if (record.stages_us[stage] >= 0) values << record.stages_us[stage];
+    }
+    if (values.isEmpty()) continue;
+    ret += "\n" + QString("%1: p50 %2 ms, p95 %3 ms, p99 %4 ms").arg(kStageNames[stage]).arg(Percentile(values, 50) / 1000).arg(Percentile(values, 95) / 1000).arg(Percentile(values, 99) / 1000);
+  }
+
+  return ret;
+
+}
+
+bool Export(const QString &filename) {
+
+  QMutexLocker l(&mutex);
+
+  if (records.isEmpty()) return false;
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+
+  QTextStream stream(&file);
+  stream << "url_resolved_us,engine_load_us,pipeline_created_us,first_buffer_us\n";
+  for (const Record &record : records) {
+    for (int stage = 0; stage < kStageCount; ++stage) {
+      if (stage > 0) stream << ",";
+      stream << record.stages_us[stage];
+    }
+    stream << "\n";
+  }
+
+  return true;
+
+}
+
+}  // namespace PlaybackLatency
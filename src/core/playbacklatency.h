@@ -0,0 +1,58 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PLAYBACKLATENCY_H
+#define PLAYBACKLATENCY_H
+
+#include "config.h"
+
+#include <QString>
+
+// Measures the time from the user action that starts playback until audio flows, with markers at the stages along the way.
+// The path spans Player, the URL handlers, engine load and pipeline construction across several threads, so each stage records its elapsed-since-click time into one pending measurement,
+// which is completed by the first buffer through the pipeline. Finished measurements are kept in a bounded history for percentile statistics and export.
+
+namespace PlaybackLatency {
+
+// The stages a playback start passes through, in order. A start may skip stages (no URL handler, cached pipeline).
+enum class Stage {
+  UrlResolved = 0,
+  EngineLoad,
+  PipelineCreated,
+  FirstBuffer,
+};
+
+// Starts a new measurement. Called from the user-action path, any unfinished previous measurement is discarded.
+void Begin();
+
+// Records the elapsed time since Begin() for one stage. Does nothing when no measurement is pending.
+void Mark(const Stage stage);
+
+// Completes the pending measurement. Called for every buffer from the streaming thread, so it is cheap when nothing is pending.
+void MarkFirstBuffer();
+
+// A readable percentile table (p50/p95/p99 per stage) over the recorded starts.
+QString Summary();
+
+// Writes one CSV line per recorded start to filename. Returns false when there is nothing to export or the file can't be opened.
+bool Export(const QString &filename);
+
+}  // namespace PlaybackLatency
+
+#endif  // PLAYBACKLATENCY_H
@@ -33,9 +33,11 @@
 #include <QString>
 #include <QUrl>
 #include <QDateTime>
+#include <QTimer>
 #include <QSettings>
 
 #include "core/logging.h"
+#include "core/playbacklatency.h"
 #include "utilities/timeconstants.h"
 
 #include "song.h"
@@ -90,7 +92,9 @@ Player::Player(Application *app, QObject *parent)
       greyout_(true),
       menu_previousmode_(BehaviourSettingsPage::PreviousBehaviour::DontRestart),
       seek_step_sec_(10),
-      play_offset_nanosec_(0) {
+      play_offset_nanosec_(0),
+      timer_url_prefetch_(new QTimer(this)),
+      url_prefetch_gap_nanosec_(0) {
 
   QSettings s;
   s.beginGroup(BackendSettingsPage::kSettingsGroup);
@@ -99,6 +103,10 @@ Player::Player(Application *app, QObject *parent)
 
   CreateEngine(enginetype);
 
+  timer_url_prefetch_->setInterval(5000);
+  QObject::connect(timer_url_prefetch_, &QTimer::timeout, this, &Player::PrefetchNextTrackUrl);
+  timer_url_prefetch_->start();
+
 }
 
 EngineBase::Type Player::CreateEngine(EngineBase::Type enginetype) {
@@ -209,6 +217,10 @@ void Player::ReloadSettings() {
   seek_step_sec_ = s.value("seek_step_sec", 10).toInt();
   s.endGroup();
 
+  s.beginGroup(kSettingsGroup);
+  url_prefetch_gap_nanosec_ = s.value("stream_url_prefetch_seconds", 30).toInt() * kNsecPerSec;
+  s.endGroup();
+
   engine_->ReloadSettings();
 
 }
@@ -279,6 +291,8 @@ void Player::HandleLoadResult(const UrlHandler::LoadResult &result) {
 
     case UrlHandler::LoadResult::Type::TrackAvailable: {
 
+      PlaybackLatency::Mark(PlaybackLatency::Stage::UrlResolved);
+
       qLog(Debug) << "URL handler for" << result.media_url_ << "returned" << result.stream_url_;
 
       Song song;
@@ -697,6 +711,8 @@ void Player::VolumeDown() {
 
 void Player::PlayAt(const int index, const quint64 offset_nanosec, EngineBase::TrackChangeFlags change, const Playlist::AutoScroll autoscroll, const bool reshuffle, const bool force_inform) {
 
+  PlaybackLatency::Begin();
+
   pause_time_ = QDateTime();
   play_offset_nanosec_ = offset_nanosec;
 
@@ -753,7 +769,8 @@ void Player::SeekTo(const quint64 seconds) {
   }
 
   const qint64 nanosec = qBound(0LL, static_cast<qint64>(seconds) * kNsecPerSec, length_nanosec);
-  engine_->Seek(nanosec);
+  // User scrubbing tolerates landing a frame early, so let the engine take the fast path.
+  engine_->Seek(nanosec, true);
 
   qLog(Debug) << "Track seeked to" << nanosec << "ns - updating scrobble point";
   app_->playlist_manager()->active()->UpdateScrobblePoint(nanosec);
@@ -849,6 +866,31 @@ void Player::TogglePrettyOSD() {
   if (current_item_) emit ForceShowOSD(current_item_->Metadata(), true);
 }
 
+void Player::PrefetchNextTrackUrl() {
+
+  if (!engine_ || engine_->state() != EngineBase::State::Playing) return;
+  if (url_prefetch_gap_nanosec_ <= 0) return;
+
+  const int next_row = app_->playlist_manager()->active()->next_row();
+  if (next_row == -1) return;
+  PlaylistItemPtr next_item = app_->playlist_manager()->active()->item_at(next_row);
+  if (!next_item) return;
+
+  // Only tracks that still need a URL handler round-trip are worth prefetching.
+  // Once resolved the stream URL is stored in the item's temporary metadata, so TrackAboutToEnd can preload it straight away.
+  QUrl url = next_item->StreamUrl();
+  if (!url_handlers_.contains(url.scheme())) return;
+  if (loading_async_.contains(url)) return;
+
+  const qint64 length_nanosec = engine_->length_nanosec();
+  if (length_nanosec <= 0) return;
+  if (length_nanosec - engine_->position_nanosec() > url_prefetch_gap_nanosec_) return;
+
+  qLog(Debug) << "Prefetching stream URL for" << url;
+  HandleLoadResult(url_handlers_[url.scheme()]->StartLoading(url));
+
+}
+
 void Player::TrackAboutToEnd() {
 
   const bool has_next_row = app_->playlist_manager()->active()->next_row() != -1;
@@ -40,6 +40,7 @@
 #include "playlist/playlistitem.h"
 #include "settings/behavioursettingspage.h"
 
+class QTimer;
 class Application;
 class Song;
 class AnalyzerContainer;
@@ -194,6 +195,7 @@ class Player : public PlayerInterface {
  private slots:
   void EngineStateChanged(const EngineBase::State);
   void EngineMetadataReceived(const EngineMetadata &engine_metadata);
+  void PrefetchNextTrackUrl();
   void TrackAboutToEnd();
   void TrackEnded();
   // Play the next item on the playlist - disregarding radio stations like last.fm that might have more tracks.
@@ -247,6 +249,10 @@ class Player : public PlayerInterface {
   QDateTime pause_time_;
   quint64 play_offset_nanosec_;
 
+  // Resolves the next queued item's stream URL through its URL handler ahead of the engine's preload, so streamed tracks can change without a gap.
+  QTimer *timer_url_prefetch_;
+  qint64 url_prefetch_gap_nanosec_;
+
 };
 
 #endif  // PLAYER_H
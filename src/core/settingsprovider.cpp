@@ -22,14 +22,16 @@
 #include "config.h"
 
 #include "settingsprovider.h"
+#include "settingswriter.h"
 
 SettingsProvider::SettingsProvider() = default;
 
-DefaultSettingsProvider::DefaultSettingsProvider() = default;
+DefaultSettingsProvider::DefaultSettingsProvider() : in_array_(false) {}
 
 void DefaultSettingsProvider::set_group(const char *group) {
   while (!backend_.group().isEmpty()) backend_.endGroup();
 
+  group_ = group;
   backend_.beginGroup(group);
 }
 
@@ -38,14 +40,22 @@ QVariant DefaultSettingsProvider::value(const QString &key, const QVariant &defa
 }
 
 void DefaultSettingsProvider::setValue(const QString &key, const QVariant &value) {
-  backend_.setValue(key, value);
+  // Array entries need the backend's array prefix, everything else goes through the write-behind queue.
+  if (in_array_) {
+    backend_.setValue(key, value);
+  }
+  else {
+    SettingsWriter::QueueValue(group_, key, value);
+  }
 }
 
 int DefaultSettingsProvider::beginReadArray(const QString &prefix) {
+  in_array_ = true;
   return backend_.beginReadArray(prefix);
 }
 
 void DefaultSettingsProvider::beginWriteArray(const QString &prefix, int size) {
+  in_array_ = true;
   backend_.beginWriteArray(prefix, size);
 }
 
@@ -53,4 +63,7 @@ void DefaultSettingsProvider::setArrayIndex(int i) {
   backend_.setArrayIndex(i);
 }
 
-void DefaultSettingsProvider::endArray() { backend_.endArray(); }
+void DefaultSettingsProvider::endArray() {
+  in_array_ = false;
+  backend_.endArray();
+}
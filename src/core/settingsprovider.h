@@ -61,6 +61,8 @@ class DefaultSettingsProvider : public SettingsProvider {
 
  private:
   QSettings backend_;
+  QString group_;
+  bool in_array_;
 
   Q_DISABLE_COPY(DefaultSettingsProvider)
 };
@@ -0,0 +1,117 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QSettings>
+
+#include "settingswriter.h"
+
+const int SettingsWriter::kWriteDelayMs = 500;
+
+SettingsWriterBackend::SettingsWriterBackend(QObject *parent) : QObject(parent) {}
+
+void SettingsWriterBackend::Apply(const QString &group, const QVariantHash &values) {
+
+  // The QSettings destructor syncs the file - on this thread, which is the point.
+  QSettings s;
+  s.beginGroup(group);
+  for (QVariantHash::const_iterator it = values.constBegin(); it != values.constEnd(); ++it) {
+    s.setValue(it.key(), it.value());
+  }
+  s.endGroup();
+
+}
+
+void SettingsWriterBackend::Sync() {
+  QSettings s;
+  s.sync();
+}
+
+SettingsWriter::SettingsWriter(QObject *parent) : QObject(parent) {
+
+  backend_.moveToThread(&thread_);
+  thread_.setObjectName("SettingsWriter");
+  thread_.start(QThread::IdlePriority);
+
+  timer_.setSingleShot(true);
+  timer_.setInterval(kWriteDelayMs);
+  QObject::connect(&timer_, &QTimer::timeout, this, &SettingsWriter::WritePending);
+
+}
+
+SettingsWriter::~SettingsWriter() {
+
+  DoFlush();
+
+  thread_.quit();
+  thread_.wait();
+
+}
+
+SettingsWriter *SettingsWriter::Instance() {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  static SettingsWriter *writer = new SettingsWriter(qApp);
+  return writer;
+
+}
+
+void SettingsWriter::QueueValue(const QString &group, const QString &key, const QVariant &value) {
+
+  SettingsWriter *writer = Instance();
+
+  writer->pending_[group].insert(key, value);
+
+  // Restart the quiet window, so a burst of changes results in one write.
+  writer->timer_.start();
+
+}
+
+void SettingsWriter::Flush() {
+  Instance()->DoFlush();
+}
+
+void SettingsWriter::WritePending() {
+
+  for (QHash<QString, QVariantHash>::const_iterator it = pending_.constBegin(); it != pending_.constEnd(); ++it) {
+    QMetaObject::invokeMethod(&backend_, "Apply", Qt::QueuedConnection, Q_ARG(QString, it.key()), Q_ARG(QVariantHash, it.value()));
+  }
+  pending_.clear();
+
+}
+
+void SettingsWriter::DoFlush() {
+
+  timer_.stop();
+
+  // Blocking calls so queued batches that are already on the backend's thread are written first, in order.
+  for (QHash<QString, QVariantHash>::const_iterator it = pending_.constBegin(); it != pending_.constEnd(); ++it) {
+    QMetaObject::invokeMethod(&backend_, "Apply", Qt::BlockingQueuedConnection, Q_ARG(QString, it.key()), Q_ARG(QVariantHash, it.value()));
+  }
+  pending_.clear();
+
+  // Also acts as a barrier for batches the timer already queued to the backend's thread.
+  QMetaObject::invokeMethod(&backend_, "Sync", Qt::BlockingQueuedConnection);
+
+}
@@ -0,0 +1,86 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SETTINGSWRITER_H
+#define SETTINGSWRITER_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+
+// Applies queued settings values and syncs them to the settings file.
+// Lives on the SettingsWriter's thread so the file writes happen off the GUI thread.
+class SettingsWriterBackend : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit SettingsWriterBackend(QObject *parent = nullptr);
+
+ public slots:
+  void Apply(const QString &group, const QVariantHash &values);
+  void Sync();
+};
+
+// Write-behind layer for settings that are saved on every change, like view state.
+// Writing through a temporary QSettings syncs the settings file synchronously on the GUI thread,
+// so a burst of changes (header resizes, splitter drags) causes a burst of file writes.
+// Values queued here are coalesced per group over a short quiet window and written on a
+// background thread.  Unwritten values are flushed when the writer is destroyed on exit.
+//
+// QSettings instances in the same process share their view of the file, so once a queued
+// value is applied it is visible to every QSettings reader; until then readers see the old
+// value, which is fine for state that is only read back on startup.
+class SettingsWriter : public QObject {
+  Q_OBJECT
+
+ public:
+  ~SettingsWriter() override;
+
+  // Queues a value for writing.  Must be called from the GUI thread.
+  static void QueueValue(const QString &group, const QString &key, const QVariant &value);
+
+  // Writes all queued values and syncs the settings file before returning.  Must be called from the GUI thread.
+  static void Flush();
+
+ private slots:
+  void WritePending();
+
+ private:
+  explicit SettingsWriter(QObject *parent = nullptr);
+  static SettingsWriter *Instance();
+
+  void DoFlush();
+
+  static const int kWriteDelayMs;
+
+  QThread thread_;
+  SettingsWriterBackend backend_;
+  QTimer timer_;
+  QHash<QString, QVariantHash> pending_;
+
+  Q_DISABLE_COPY(SettingsWriter)
+};
+
+#endif  // SETTINGSWRITER_H
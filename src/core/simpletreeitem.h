@@ -25,6 +25,7 @@
 #include "config.h"
 
 #include <QList>
+#include <QHash>
 #include <QString>
 #include <QAbstractItemModel>
 
@@ -59,6 +60,10 @@ class SimpleTreeItem {
 
   T *parent;
   QList<T*> children;
+  // Index over the children's keys, rebuilt lazily by ChildByKey() after a structural change.
+  // Built lazily because keys are typically filled in after a child has been attached to its parent.
+  mutable QHash<QString, T*> children_by_key;
+  mutable bool children_by_key_dirty;
   QAbstractItemModel *child_model;
 
   SimpleTreeModel<T> *model;
@@ -70,6 +75,7 @@ SimpleTreeItem<T>::SimpleTreeItem(int _type, SimpleTreeModel<T> *_model)
       row(0),
       lazy_loaded(true),
       parent(nullptr),
+      children_by_key_dirty(true),
       child_model(nullptr),
       model(_model) {}
 
@@ -79,11 +85,13 @@ SimpleTreeItem<T>::SimpleTreeItem(int _type, const QString &_key, T *_parent)
       key(_key),
       lazy_loaded(false),
       parent(_parent),
+      children_by_key_dirty(true),
       child_model(nullptr),
       model(_parent ? _parent->model : nullptr) {
   if (parent) {
     row = parent->children.count();
     parent->children << static_cast<T*>(this);
+    parent->children_by_key_dirty = true;
   }
 }
 
@@ -92,11 +100,13 @@ SimpleTreeItem<T>::SimpleTreeItem(int _type, T *_parent)
     : type(_type),
       lazy_loaded(false),
       parent(_parent),
+      children_by_key_dirty(true),
       child_model(nullptr),
       model(_parent ? _parent->model : nullptr) {
   if (parent) {
     row = parent->children.count();
     parent->children << static_cast<T*>(this);
+    parent->children_by_key_dirty = true;
   }
 }
 
@@ -108,6 +118,7 @@ void SimpleTreeItem<T>::InsertNotify(T *_parent) {
 
   model->BeginInsert(parent, row);
   parent->children << static_cast<T*>(this);
+  parent->children_by_key_dirty = true;
   model->EndInsert();
 }
 
@@ -115,6 +126,7 @@ template<typename T>
 void SimpleTreeItem<T>::DeleteNotify(int child_row) {
   model->BeginDelete(static_cast<T*>(this), child_row);
   delete children.takeAt(child_row);
+  children_by_key_dirty = true;
 
   // Adjust row numbers of those below it :(
   for (int i = child_row; i < children.count(); ++i) children[i]->row--;
@@ -128,6 +140,8 @@ void SimpleTreeItem<T>::ClearNotify() {
 
     qDeleteAll(children);
     children.clear();
+    children_by_key.clear();
+    children_by_key_dirty = true;
 
     model->EndDelete();
   }
@@ -146,6 +160,7 @@ SimpleTreeItem<T>::~SimpleTreeItem() {
 template<typename T>
 void SimpleTreeItem<T>::Delete(int child_row) {
   delete children.takeAt(child_row);
+  children_by_key_dirty = true;
 
   // Adjust row numbers of those below it :(
   for (int i = child_row; i < children.count(); ++i) children[i]->row--;
@@ -153,10 +168,22 @@ void SimpleTreeItem<T>::Delete(int child_row) {
 
 template<typename T>
 T *SimpleTreeItem<T>::ChildByKey(const QString &_key) const {
-  for (T *child : children) {
-    if (child->key == _key) return child;
+
+  // With nodes holding thousands of children a linear scan per lookup makes bulk inserts quadratic,
+  // so the keys are indexed in a hash that is rebuilt on the first lookup after a structural change.
+  // A child whose key changes without a structural change is not picked up until the next rebuild.
+  if (children_by_key_dirty) {
+    children_by_key.clear();
+    children_by_key.reserve(children.count());
+    for (T *child : children) {
+      // First match wins, same as the linear scan this replaces.
+      if (!children_by_key.contains(child->key)) children_by_key.insert(child->key, child);
+    }
+    children_by_key_dirty = false;
   }
-  return nullptr;
+
+  return children_by_key.value(_key, nullptr);
+
 }
 
 #endif  // SIMPLETREEITEM_H
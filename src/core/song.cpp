@@ -58,6 +58,7 @@
 #include "sqlquery.h"
 #include "mpris_common.h"
 #include "sqlrow.h"
+#include "stringpool.h"
 #include "tagreadermessages.pb.h"
 
 const QStringList Song::kColumns = QStringList() << "title"
@@ -132,6 +133,12 @@ const QStringList Song::kColumns = QStringList() << "title"
                                                  << "musicbrainz_release_group_id"
                                                  << "musicbrainz_work_id"
 
+                                                 << "rg_track_gain"
+                                                 << "rg_track_peak"
+
+                                                 << "artist_sortkey"
+                                                 << "album_sortkey"
+
 						 ;
 
 const QString Song::kColumnSpec = Song::kColumns.join(", ");
@@ -161,6 +168,8 @@ const QRegularExpression Song::kTitleRemoveMisc(" ?-? ((\\(|\\[)?)(Remastered|Re
 
 const QStringList Song::kArticles = QStringList() << "the " << "a " << "an ";
 
+const QRegularExpression Song::kSortKeyStrip("[^\\w ]", QRegularExpression::UseUnicodePropertiesOption);
+
 const QStringList Song::kAcceptedExtensions = QStringList() << "wav" << "flac" << "wv" << "ogg" << "oga" << "opus" << "spx" << "ape" << "mpc"
                                                             << "mp2" << "mp3" <<  "m4a" << "mp4" << "aac" << "asf" << "asx" << "wma"
                                                             << "aif << aiff" << "mka" << "tta" << "dsf" << "dsd"
@@ -233,6 +242,9 @@ struct Song::Private : public QSharedData {
 
   float rating_;                // Database rating, initial rating read from tag.
 
+  double rg_track_gain_;        // ReplayGain track gain in dB from loudness analysis, NaN when not analyzed.
+  double rg_track_peak_;        // ReplayGain linear track peak from loudness analysis, NaN when not analyzed.
+
   QString acoustid_id_;
   QString acoustid_fingerprint_;
 
@@ -247,6 +259,9 @@ struct Song::Private : public QSharedData {
   QString musicbrainz_release_group_id_;
   QString musicbrainz_work_id_;
 
+  QString artist_sortkey_;      // Persisted collation keys, see Song::SortKey.
+  QString album_sortkey_;
+
   QUrl stream_url_;             // Temporary stream url set by url handler.
   bool init_from_file_;         // Whether this song was loaded from a file using taglib.
   bool suspicious_tags_;        // Whether our encoding guesser thinks these tags might be incorrectly encoded.
@@ -289,6 +304,9 @@ Song::Private::Private(const Source source)
 
       rating_(-1),
 
+      rg_track_gain_(qQNaN()),
+      rg_track_peak_(qQNaN()),
+
       init_from_file_(false),
       suspicious_tags_(false)
 
@@ -325,6 +343,8 @@ const QString &Song::effective_albumartist() const { return d->albumartist_.isEm
 const QString &Song::effective_albumartist_sortable() const { return d->albumartist_.isEmpty() ? d->artist_sortable_ : d->albumartist_sortable_; }
 const QString &Song::playlist_albumartist() const { return is_compilation() ? d->albumartist_ : effective_albumartist(); }
 const QString &Song::playlist_albumartist_sortable() const { return is_compilation() ? d->albumartist_sortable_ : effective_albumartist_sortable(); }
+const QString &Song::artist_sortkey() const { return d->artist_sortkey_; }
+const QString &Song::album_sortkey() const { return d->album_sortkey_; }
 int Song::track() const { return d->track_; }
 int Song::disc() const { return d->disc_; }
 int Song::year() const { return d->year_; }
@@ -462,6 +482,11 @@ bool Song::has_cue() const { return !d->cue_path_.isEmpty(); }
 
 float Song::rating() const { return d->rating_; }
 
+double Song::rg_track_gain() const { return d->rg_track_gain_; }
+double Song::rg_track_peak() const { return d->rg_track_peak_; }
+bool Song::has_rg_track_gain() const { return !qIsNaN(d->rg_track_gain_); }
+bool Song::has_rg_track_peak() const { return !qIsNaN(d->rg_track_peak_); }
+
 const QString &Song::acoustid_id() const { return d->acoustid_id_; }
 const QString &Song::acoustid_fingerprint() const { return d->acoustid_fingerprint_; }
 
@@ -530,19 +555,49 @@ QString Song::sortable(const QString &v) {
   return copy;
 }
 
+QString Song::SortKey(QString text) {
+
+  if (text.isEmpty()) {
+    text = " unknown";
+  }
+  else {
+    text = text.toLower();
+  }
+  text = text.remove(kSortKeyStrip);
+
+  return text;
+
+}
+
+QString Song::SortKeyForArtist(QString artist) {
+
+  artist = SortKey(artist);
+
+  for (const auto &i : kArticles) {
+    if (artist.startsWith(i)) {
+      qint64 ilen = i.length();
+      artist = artist.right(artist.length() - ilen) + ", " + i.left(ilen - 1);
+      break;
+    }
+  }
+
+  return artist;
+
+}
+
 void Song::set_title(const QString &v) { d->title_sortable_ = sortable(v); d->title_ = v; }
-void Song::set_album(const QString &v) { d->album_sortable_ = sortable(v); d->album_ = v; }
-void Song::set_artist(const QString &v) { d->artist_sortable_ = sortable(v); d->artist_ = v; }
-void Song::set_albumartist(const QString &v) { d->albumartist_sortable_ = sortable(v); d->albumartist_ = v; }
+void Song::set_album(const QString &v) { d->album_sortable_ = StringPool::Intern(sortable(v)); d->album_ = StringPool::Intern(v); }
+void Song::set_artist(const QString &v) { d->artist_sortable_ = StringPool::Intern(sortable(v)); d->artist_ = StringPool::Intern(v); }
+void Song::set_albumartist(const QString &v) { d->albumartist_sortable_ = StringPool::Intern(sortable(v)); d->albumartist_ = StringPool::Intern(v); }
 void Song::set_track(const int v) { d->track_ = v; }
 void Song::set_disc(const int v) { d->disc_ = v; }
 void Song::set_year(const int v) { d->year_ = v; }
 void Song::set_originalyear(const int v) { d->originalyear_ = v; }
-void Song::set_genre(const QString &v) { d->genre_ = v; }
+void Song::set_genre(const QString &v) { d->genre_ = StringPool::Intern(v); }
 void Song::set_compilation(bool v) { d->compilation_ = v; }
-void Song::set_composer(const QString &v) { d->composer_ = v; }
-void Song::set_performer(const QString &v) { d->performer_ = v; }
-void Song::set_grouping(const QString &v) { d->grouping_ = v; }
+void Song::set_composer(const QString &v) { d->composer_ = StringPool::Intern(v); }
+void Song::set_performer(const QString &v) { d->performer_ = StringPool::Intern(v); }
+void Song::set_grouping(const QString &v) { d->grouping_ = StringPool::Intern(v); }
 void Song::set_comment(const QString &v) { d->comment_ = v; }
 void Song::set_lyrics(const QString &v) { d->lyrics_ = v; }
 
@@ -554,7 +609,11 @@ void Song::set_bitrate(const int v) { d->bitrate_ = v; }
 void Song::set_samplerate(const int v) { d->samplerate_ = v; }
 void Song::set_bitdepth(const int v) { d->bitdepth_ = v; }
 
-void Song::set_source(const Source v) { d->source_ = v; }
+void Song::set_source(const Source v) {
+  // Skip no-op writes: touching d would detach the implicitly shared data, giving every copy made from the same song its own full allocation.
+  if (source() == v) return;
+  d->source_ = v;
+}
 void Song::set_directory_id(const int v) { d->directory_id_ = v; }
 void Song::set_url(const QUrl &v) { d->url_ = v; }
 void Song::set_basefilename(const QString &v) { d->basefilename_ = v; }
@@ -581,6 +640,9 @@ void Song::set_cue_path(const QString &v) { d->cue_path_ = v; }
 
 void Song::set_rating(const float v) { d->rating_ = v; }
 
+void Song::set_rg_track_gain(const double v) { d->rg_track_gain_ = v; }
+void Song::set_rg_track_peak(const double v) { d->rg_track_peak_ = v; }
+
 void Song::set_acoustid_id(const QString &v) { d->acoustid_id_ = v; }
 void Song::set_acoustid_fingerprint(const QString &v) { d->acoustid_fingerprint_ = v; }
 
@@ -1084,11 +1146,12 @@ void Song::InitFromQuery(const SqlRow &q, const bool reliable_metadata) {
   d->disc_ = q.ValueToInt("disc");
   d->year_ = q.ValueToInt("year");
   d->originalyear_ = q.ValueToInt("originalyear");
-  d->genre_ = q.ValueToString("genre");
+  // Through the setters so the values are interned - these columns repeat across most of a collection.
+  set_genre(q.ValueToString("genre"));
   d->compilation_ = q.value("compilation").toBool();
-  d->composer_ = q.ValueToString("composer");
-  d->performer_ = q.ValueToString("performer");
-  d->grouping_ = q.ValueToString("grouping");
+  set_composer(q.ValueToString("composer"));
+  set_performer(q.ValueToString("performer"));
+  set_grouping(q.ValueToString("grouping"));
   d->comment_ = q.ValueToString("comment");
   d->lyrics_ = q.ValueToString("lyrics");
   d->artist_id_ = q.ValueToString("artist_id");
@@ -1152,6 +1215,12 @@ void Song::InitFromQuery(const SqlRow &q, const bool reliable_metadata) {
   d->musicbrainz_release_group_id_ = q.ValueToString("musicbrainz_release_group_id");
   d->musicbrainz_work_id_ = q.ValueToString("musicbrainz_work_id");
 
+  d->rg_track_gain_ = q.value("rg_track_gain").isNull() ? qQNaN() : q.value("rg_track_gain").toDouble();
+  d->rg_track_peak_ = q.value("rg_track_peak").isNull() ? qQNaN() : q.value("rg_track_peak").toDouble();
+
+  d->artist_sortkey_ = q.ValueToString("artist_sortkey");
+  d->album_sortkey_ = q.ValueToString("album_sortkey");
+
   d->valid_ = true;
   d->init_from_file_ = reliable_metadata;
 
@@ -1439,95 +1508,106 @@ bool Song::MergeFromEngineMetadata(const EngineMetadata &engine_metadata) {
 
 }
 
-void Song::BindToQuery(SqlQuery *query) const {
+void Song::BindToQuery(SqlQuery *query) const { BindToQuery(query, QString()); }
+
+void Song::BindToQuery(SqlQuery *query, const QString &suffix) const {
 
   // Remember to bind these in the same order as kBindSpec
 
-  query->BindStringValue(":title", d->title_);
-  query->BindStringValue(":album", d->album_);
-  query->BindStringValue(":artist", d->artist_);
-  query->BindStringValue(":albumartist", d->albumartist_);
-  query->BindIntValue(":track", d->track_);
-  query->BindIntValue(":disc", d->disc_);
-  query->BindIntValue(":year", d->year_);
-  query->BindIntValue(":originalyear", d->originalyear_);
-  query->BindStringValue(":genre", d->genre_);
-  query->BindBoolValue(":compilation", d->compilation_);
-  query->BindStringValue(":composer", d->composer_);
-  query->BindStringValue(":performer", d->performer_);
-  query->BindStringValue(":grouping", d->grouping_);
-  query->BindStringValue(":comment", d->comment_);
-  query->BindStringValue(":lyrics", d->lyrics_);
-
-  query->BindStringValue(":artist_id", d->artist_id_);
-  query->BindStringValue(":album_id", d->album_id_);
-  query->BindStringValue(":song_id", d->song_id_);
-
-  query->BindValue(":beginning", d->beginning_);
-  query->BindLongLongValue(":length", length_nanosec());
-
-  query->BindIntValue(":bitrate", d->bitrate_);
-  query->BindIntValue(":samplerate", d->samplerate_);
-  query->BindIntValue(":bitdepth", d->bitdepth_);
-
-  query->BindValue(":source", static_cast<int>(d->source_));
-  query->BindNotNullIntValue(":directory_id", d->directory_id_);
-  query->BindUrlValue(":url", d->url_);
-  query->BindValue(":filetype", static_cast<int>(d->filetype_));
-  query->BindLongLongValueOrZero(":filesize", d->filesize_);
-  query->BindLongLongValueOrZero(":mtime", d->mtime_);
-  query->BindLongLongValueOrZero(":ctime", d->ctime_);
-  query->BindBoolValue(":unavailable", d->unavailable_);
-
-  query->BindStringValue(":fingerprint", d->fingerprint_);
-
-  query->BindValue(":playcount", d->playcount_);
-  query->BindValue(":skipcount", d->skipcount_);
-  query->BindLongLongValue(":lastplayed", d->lastplayed_);
-  query->BindLongLongValue(":lastseen", d->lastseen_);
-
-  query->BindBoolValue(":compilation_detected", d->compilation_detected_);
-  query->BindBoolValue(":compilation_on", d->compilation_on_);
-  query->BindBoolValue(":compilation_off", d->compilation_off_);
-  query->BindBoolValue(":compilation_effective", is_compilation());
-
-  query->BindUrlValue(":art_automatic", d->art_automatic_);
-  query->BindUrlValue(":art_manual", d->art_manual_);
-
-  query->BindStringValue(":effective_albumartist", effective_albumartist());
-  query->BindIntValue(":effective_originalyear", effective_originalyear());
-
-  query->BindValue(":cue_path", d->cue_path_);
-
-  query->BindFloatValue(":rating", d->rating_);
-
-  query->BindStringValue(":acoustid_id", d->acoustid_id_);
-  query->BindStringValue(":acoustid_fingerprint", d->acoustid_fingerprint_);
-
-  query->BindStringValue(":musicbrainz_album_artist_id", d->musicbrainz_album_artist_id_);
-  query->BindStringValue(":musicbrainz_artist_id", d->musicbrainz_artist_id_);
-  query->BindStringValue(":musicbrainz_original_artist_id", d->musicbrainz_original_artist_id_);
-  query->BindStringValue(":musicbrainz_album_id", d->musicbrainz_album_id_);
-  query->BindStringValue(":musicbrainz_original_album_id", d->musicbrainz_original_album_id_);
-  query->BindStringValue(":musicbrainz_recording_id", d->musicbrainz_recording_id_);
-  query->BindStringValue(":musicbrainz_track_id", d->musicbrainz_track_id_);
-  query->BindStringValue(":musicbrainz_disc_id", d->musicbrainz_disc_id_);
-  query->BindStringValue(":musicbrainz_release_group_id", d->musicbrainz_release_group_id_);
-  query->BindStringValue(":musicbrainz_work_id", d->musicbrainz_work_id_);
-
-}
-
-void Song::BindToFtsQuery(SqlQuery *query) const {
-
-  query->BindValue(":ftstitle", d->title_);
-  query->BindValue(":ftsalbum", d->album_);
-  query->BindValue(":ftsartist", d->artist_);
-  query->BindValue(":ftsalbumartist", d->albumartist_);
-  query->BindValue(":ftscomposer", d->composer_);
-  query->BindValue(":ftsperformer", d->performer_);
-  query->BindValue(":ftsgrouping", d->grouping_);
-  query->BindValue(":ftsgenre", d->genre_);
-  query->BindValue(":ftscomment", d->comment_);
+  query->BindStringValue(":title" + suffix, d->title_);
+  query->BindStringValue(":album" + suffix, d->album_);
+  query->BindStringValue(":artist" + suffix, d->artist_);
+  query->BindStringValue(":albumartist" + suffix, d->albumartist_);
+  query->BindIntValue(":track" + suffix, d->track_);
+  query->BindIntValue(":disc" + suffix, d->disc_);
+  query->BindIntValue(":year" + suffix, d->year_);
+  query->BindIntValue(":originalyear" + suffix, d->originalyear_);
+  query->BindStringValue(":genre" + suffix, d->genre_);
+  query->BindBoolValue(":compilation" + suffix, d->compilation_);
+  query->BindStringValue(":composer" + suffix, d->composer_);
+  query->BindStringValue(":performer" + suffix, d->performer_);
+  query->BindStringValue(":grouping" + suffix, d->grouping_);
+  query->BindStringValue(":comment" + suffix, d->comment_);
+  query->BindStringValue(":lyrics" + suffix, d->lyrics_);
+
+  query->BindStringValue(":artist_id" + suffix, d->artist_id_);
+  query->BindStringValue(":album_id" + suffix, d->album_id_);
+  query->BindStringValue(":song_id" + suffix, d->song_id_);
+
+  query->BindValue(":beginning" + suffix, d->beginning_);
+  query->BindLongLongValue(":length" + suffix, length_nanosec());
+
+  query->BindIntValue(":bitrate" + suffix, d->bitrate_);
+  query->BindIntValue(":samplerate" + suffix, d->samplerate_);
+  query->BindIntValue(":bitdepth" + suffix, d->bitdepth_);
+
+  query->BindValue(":source" + suffix, static_cast<int>(d->source_));
+  query->BindNotNullIntValue(":directory_id" + suffix, d->directory_id_);
+  query->BindUrlValue(":url" + suffix, d->url_);
+  query->BindValue(":filetype" + suffix, static_cast<int>(d->filetype_));
+  query->BindLongLongValueOrZero(":filesize" + suffix, d->filesize_);
+  query->BindLongLongValueOrZero(":mtime" + suffix, d->mtime_);
+  query->BindLongLongValueOrZero(":ctime" + suffix, d->ctime_);
+  query->BindBoolValue(":unavailable" + suffix, d->unavailable_);
+
+  query->BindStringValue(":fingerprint" + suffix, d->fingerprint_);
+
+  query->BindValue(":playcount" + suffix, d->playcount_);
+  query->BindValue(":skipcount" + suffix, d->skipcount_);
+  query->BindLongLongValue(":lastplayed" + suffix, d->lastplayed_);
+  query->BindLongLongValue(":lastseen" + suffix, d->lastseen_);
+
+  query->BindBoolValue(":compilation_detected" + suffix, d->compilation_detected_);
+  query->BindBoolValue(":compilation_on" + suffix, d->compilation_on_);
+  query->BindBoolValue(":compilation_off" + suffix, d->compilation_off_);
+  query->BindBoolValue(":compilation_effective" + suffix, is_compilation());
+
+  query->BindUrlValue(":art_automatic" + suffix, d->art_automatic_);
+  query->BindUrlValue(":art_manual" + suffix, d->art_manual_);
+
+  query->BindStringValue(":effective_albumartist" + suffix, effective_albumartist());
+  query->BindIntValue(":effective_originalyear" + suffix, effective_originalyear());
+
+  query->BindValue(":cue_path" + suffix, d->cue_path_);
+
+  query->BindFloatValue(":rating" + suffix, d->rating_);
+
+  query->BindStringValue(":acoustid_id" + suffix, d->acoustid_id_);
+  query->BindStringValue(":acoustid_fingerprint" + suffix, d->acoustid_fingerprint_);
+
+  query->BindStringValue(":musicbrainz_album_artist_id" + suffix, d->musicbrainz_album_artist_id_);
+  query->BindStringValue(":musicbrainz_artist_id" + suffix, d->musicbrainz_artist_id_);
+  query->BindStringValue(":musicbrainz_original_artist_id" + suffix, d->musicbrainz_original_artist_id_);
+  query->BindStringValue(":musicbrainz_album_id" + suffix, d->musicbrainz_album_id_);
+  query->BindStringValue(":musicbrainz_original_album_id" + suffix, d->musicbrainz_original_album_id_);
+  query->BindStringValue(":musicbrainz_recording_id" + suffix, d->musicbrainz_recording_id_);
+  query->BindStringValue(":musicbrainz_track_id" + suffix, d->musicbrainz_track_id_);
+  query->BindStringValue(":musicbrainz_disc_id" + suffix, d->musicbrainz_disc_id_);
+  query->BindStringValue(":musicbrainz_release_group_id" + suffix, d->musicbrainz_release_group_id_);
+  query->BindStringValue(":musicbrainz_work_id" + suffix, d->musicbrainz_work_id_);
+
+  query->BindDoubleOrNullValue(":rg_track_gain" + suffix, d->rg_track_gain_);
+  query->BindDoubleOrNullValue(":rg_track_peak" + suffix, d->rg_track_peak_);
+
+  // Always recomputed on write so the persisted keys match the metadata being stored.
+  query->BindStringValue(":artist_sortkey" + suffix, SortKeyForArtist(effective_albumartist()));
+  query->BindStringValue(":album_sortkey" + suffix, SortKeyForArtist(album()));
+
+}
+
+void Song::BindToFtsQuery(SqlQuery *query) const { BindToFtsQuery(query, QString()); }
+
+void Song::BindToFtsQuery(SqlQuery *query, const QString &suffix) const {
+
+  query->BindValue(":ftstitle" + suffix, d->title_);
+  query->BindValue(":ftsalbum" + suffix, d->album_);
+  query->BindValue(":ftsartist" + suffix, d->artist_);
+  query->BindValue(":ftsalbumartist" + suffix, d->albumartist_);
+  query->BindValue(":ftscomposer" + suffix, d->composer_);
+  query->BindValue(":ftsperformer" + suffix, d->performer_);
+  query->BindValue(":ftsgrouping" + suffix, d->grouping_);
+  query->BindValue(":ftsgenre" + suffix, d->genre_);
+  query->BindValue(":ftscomment" + suffix, d->comment_);
 
 }
 
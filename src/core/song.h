@@ -129,6 +129,7 @@ class Song {
   static const QRegularExpression kAlbumRemoveDisc;
   static const QRegularExpression kAlbumRemoveMisc;
   static const QRegularExpression kTitleRemoveMisc;
+  static const QRegularExpression kSortKeyStrip;
 
   static const QStringList kArticles;
 
@@ -136,6 +137,10 @@ class Song {
 
   static QString JoinSpec(const QString &table);
 
+  // Normalized collation keys, persisted in the songs tables (artist_sortkey, album_sortkey) so sort-heavy UI builds don't have to recompute them.
+  static QString SortKey(QString text);
+  static QString SortKeyForArtist(QString artist);
+
   static Source SourceFromURL(const QUrl &url);
   static QString TextForSource(const Source source);
   static QString DescriptionForSource(const Source source);
@@ -188,7 +193,10 @@ class Song {
 
   // Save
   void BindToQuery(SqlQuery *query) const;
+  // Binds with the given suffix appended to every placeholder name, for multi-row inserts.
+  void BindToQuery(SqlQuery *query, const QString &suffix) const;
   void BindToFtsQuery(SqlQuery *query) const;
+  void BindToFtsQuery(SqlQuery *query, const QString &suffix) const;
   void ToXesam(QVariantMap *map) const;
   void ToProtobuf(spb::tagreader::SongMetadata *pb) const;
 
@@ -205,6 +213,9 @@ class Song {
   const QString &artist_sortable() const;
   const QString &albumartist() const;
   const QString &albumartist_sortable() const;
+  // Collation keys as read back from the database, empty for rows written before the columns existed.
+  const QString &artist_sortkey() const;
+  const QString &album_sortkey() const;
   int track() const;
   int disc() const;
   int year() const;
@@ -257,6 +268,11 @@ class Song {
 
   float rating() const;
 
+  double rg_track_gain() const;
+  double rg_track_peak() const;
+  bool has_rg_track_gain() const;
+  bool has_rg_track_peak() const;
+
   const QString &acoustid_id() const;
   const QString &acoustid_fingerprint() const;
 
@@ -398,6 +414,9 @@ class Song {
 
   void set_rating(const float v);
 
+  void set_rg_track_gain(const double v);
+  void set_rg_track_peak(const double v);
+
   void set_acoustid_id(const QString &v);
   void set_acoustid_fingerprint(const QString &v);
 
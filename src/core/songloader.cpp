@@ -63,7 +63,11 @@
 #endif
 
 QSet<QString> SongLoader::sRawUriSchemes;
+QMutex SongLoader::sTypefindCacheMutex;
+QHash<QString, QString> SongLoader::sTypefindCache;
 const int SongLoader::kDefaultTimeout = 5000;
+const int SongLoader::kHttpTimeout = 3000;
+const int SongLoader::kRemoteFsTimeout = 8000;
 
 SongLoader::SongLoader(CollectionBackendInterface *collection, const Player *player, QObject *parent)
     : QObject(parent),
@@ -126,6 +130,18 @@ SongLoader::Result SongLoader::Load(const QUrl &url) {
 
   if (player_->engine()->type() == EngineBase::Type::GStreamer) {
 #ifdef HAVE_GSTREAMER
+    // A previous probe already identified this extension as an audio stream, so skip spinning up a typefind pipeline for it.
+    const QString extension = QFileInfo(url_.path()).suffix().toLower();
+    if (!extension.isEmpty()) {
+      QMutexLocker l(&sTypefindCacheMutex);
+      if (sTypefindCache.contains(extension)) {
+        mime_type_ = sTypefindCache.value(extension);
+        AddAsRawStream();
+        return Result::Success;
+      }
+    }
+    // Dead HTTP entries in stale playlists are the common case - their deadline is per loader, so only this URL waits for it.
+    if (timeout_ == kDefaultTimeout) timeout_ = TimeoutForScheme(url_.scheme());
     preload_func_ = std::bind(&SongLoader::LoadRemote, this);
     return Result::BlockingLoadRequired;
 #else
@@ -420,10 +436,22 @@ void SongLoader::Timeout() {
 
   state_ = State::Finished;
   success_ = false;
+  errors_ << tr("Gave up waiting for %1 after %2 seconds.").arg(url_.toString()).arg(timeout_ / 1000);
   StopTypefind();
 
 }
 
+int SongLoader::TimeoutForScheme(const QString &scheme) {
+
+  // A dead HTTP server either refuses quickly or never answers - give up on it sooner.
+  if (scheme == "http" || scheme == "https") return kHttpTimeout;
+  // Remote filesystems can take a while just to establish the connection.
+  if (scheme == "ssh" || scheme == "sftp" || scheme == "ftp" || scheme == "smb" || scheme == "nfs") return kRemoteFsTimeout;
+
+  return kDefaultTimeout;
+
+}
+
 void SongLoader::StopTypefind() {
 
 #ifdef HAVE_GSTREAMER
@@ -551,6 +579,12 @@ void SongLoader::TypeFound(GstElement*, uint, GstCaps *caps, void *self) {
   }
 
   // Nope, not a playlist - we're done
+  // Remember the result, so the next entry with the same extension skips the probe entirely.
+  const QString extension = QFileInfo(instance->url_.path()).suffix().toLower();
+  if (!extension.isEmpty()) {
+    QMutexLocker l(&sTypefindCacheMutex);
+    sTypefindCache.insert(extension, instance->mime_type_);
+  }
   instance->StopTypefindAsync(true);
 
 }
@@ -36,6 +36,8 @@
 #include <QObject>
 #include <QThreadPool>
 #include <QByteArray>
+#include <QHash>
+#include <QMutex>
 #include <QSet>
 #include <QString>
 #include <QStringList>
@@ -68,6 +70,8 @@ class SongLoader : public QObject {
   };
 
   static const int kDefaultTimeout;
+  static const int kHttpTimeout;
+  static const int kRemoteFsTimeout;
 
   const QUrl &url() const { return url_; }
   const SongList &songs() const { return songs_; }
@@ -137,9 +141,17 @@ class SongLoader : public QObject {
 
   void ScheduleTimeoutAsync();
 
+  // Probes run concurrently, one loader per dropped URL - pick a deadline that matches how the scheme fails.
+  static int TimeoutForScheme(const QString &scheme);
+
  private:
   static QSet<QString> sRawUriSchemes;
 
+  // Mime types from earlier typefind runs keyed by file extension, so the probe pipeline is only spun up once per extension in a big drop.
+  // Only non-playlist results are cached - playlists have to be fetched every time for their contents.
+  static QMutex sTypefindCacheMutex;
+  static QHash<QString, QString> sTypefindCache;
+
   QUrl url_;
   SongList songs_;
 
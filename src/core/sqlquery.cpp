@@ -19,13 +19,46 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
 #include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 
+#include "logging.h"
 #include "sqlquery.h"
 
+namespace {
+
+// Latency histogram bucket upper bounds, the last bucket is open-ended.
+const qint64 kHistogramBucketsUs[] = { 1000, 10000, 100000, 1000000 };
+const int kHistogramBucketCount = 5;
+
+struct QueryStats {
+  QueryStats() : count(0), total_us(0), max_us(0), buckets{} {}
+
+  quint64 count;
+  qint64 total_us;
+  qint64 max_us;
+  quint64 buckets[kHistogramBucketCount];
+};
+
+QMutex sTimingMutex;
+QHash<QString, QueryStats> sQueryStats;
+std::atomic<bool> sTimingEnabled(qEnvironmentVariableIsSet("STRAWBERRY_SQL_TIMING"));
+std::atomic<int> sSlowQueryThresholdMs(qEnvironmentVariableIsSet("STRAWBERRY_SLOW_QUERY_MS") ? qEnvironmentVariableIntValue("STRAWBERRY_SLOW_QUERY_MS") : 250);
+
+}  // namespace
+
 void SqlQuery::BindValue(const QString &placeholder, const QVariant &value) {
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -72,6 +105,12 @@ void SqlQuery::BindFloatValue(const QString &placeholder, const float value) {
 
 }
 
+void SqlQuery::BindDoubleOrNullValue(const QString &placeholder, const double value) {
+
+  BindValue(placeholder, qIsNaN(value) ? QVariant() : QVariant(value));
+
+}
+
 void SqlQuery::BindBoolValue(const QString &placeholder, const bool value) {
 
   BindValue(placeholder, value ? 1 : 0);
@@ -86,7 +125,15 @@ void SqlQuery::BindNotNullIntValue(const QString &placeholder, const int value)
 
 bool SqlQuery::Exec() {
 
+  const bool timing = sTimingEnabled.load(std::memory_order_relaxed);
+  QElapsedTimer timer;
+  if (timing) timer.start();
+
   bool success = exec();
+
+  // The statement text with placeholders still in place, used as the pattern key before values are substituted in below.
+  const QString pattern = lastQuery();
+
   last_query_ = executedQuery();
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -102,6 +149,8 @@ bool SqlQuery::Exec() {
   }
 #endif
 
+  if (timing) RecordTiming(pattern, timer.nsecsElapsed() / 1000);
+
   return success;
 
 }
@@ -111,3 +160,63 @@ QString SqlQuery::LastQuery() const {
   return last_query_;
 
 }
+
+void SqlQuery::RecordTiming(const QString &pattern, const qint64 elapsed_us) {
+
+  {
+    QMutexLocker l(&sTimingMutex);
+    QueryStats &stats = sQueryStats[pattern];
+    ++stats.count;
+    stats.total_us += elapsed_us;
+    stats.max_us = std::max(stats.max_us, elapsed_us);
+    int bucket = 0;
+    while (bucket < kHistogramBucketCount - 1 && elapsed_us >= kHistogramBucketsUs[bucket]) ++bucket;
+    ++stats.buckets[bucket];
+  }
+
+  if (elapsed_us / 1000 >= sSlowQueryThresholdMs.load(std::memory_order_relaxed)) {
+    qLog(Warning) << "Slow query took" << elapsed_us / 1000 << "ms:" << last_query_;
+  }
+
+}
+
+void SqlQuery::SetTimingEnabled(const bool enabled) {
+  sTimingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool SqlQuery::TimingEnabled() {
+  return sTimingEnabled.load(std::memory_order_relaxed);
+}
+
+void SqlQuery::ResetTiming() {
+
+  QMutexLocker l(&sTimingMutex);
+  sQueryStats.clear();
+
+}
+
+QString SqlQuery::TimingSummary() {
+
+  QMutexLocker l(&sTimingMutex);
+
+  if (sQueryStats.isEmpty()) {
+    return TimingEnabled() ? QString("No queries recorded yet.") : QString("Query timing capture is disabled, enable it with .timings on or the STRAWBERRY_SQL_TIMING environment variable.");
+  }
+
+  QStringList patterns = QStringList(sQueryStats.keys());
+  std::sort(patterns.begin(), patterns.end(), [](const QString &a, const QString &b) { return sQueryStats[a].total_us > sQueryStats[b].total_us; });
+
+  QStringList lines;
+  lines << QString("%1 %2 %3 %4  %5").arg("count", 8).arg("total ms", 10).arg("avg ms", 8).arg("max ms", 8).arg("<1ms/<10ms/<100ms/<1s/>=1s  statement");
+  for (const QString &pattern : patterns) {
+    const QueryStats &stats = sQueryStats[pattern];
+    QStringList buckets;
+    for (int i = 0; i < kHistogramBucketCount; ++i) {
+      buckets << QString::number(stats.buckets[i]);
+    }
+    lines << QString("%1 %2 %3 %4  %5  %6").arg(stats.count, 8).arg(stats.total_us / 1000, 10).arg(stats.total_us / 1000 / static_cast<qint64>(stats.count), 8).arg(stats.max_us / 1000, 8).arg(buckets.join("/"), -25).arg(pattern.simplified());
+  }
+
+  return lines.join("\n");
+
+}
@@ -40,13 +40,25 @@ class SqlQuery : public QSqlQuery {
   void BindLongLongValue(const QString &placeholder, const qint64 value);
   void BindLongLongValueOrZero(const QString &placeholder, const qint64 value);
   void BindFloatValue(const QString &placeholder, const float value);
+  void BindDoubleOrNullValue(const QString &placeholder, const double value);
   void BindBoolValue(const QString &placeholder, const bool value);
   void BindNotNullIntValue(const QString &placeholder, const int value);
 
   bool Exec();
   QString LastQuery() const;
 
+  // Opt-in timing capture shared by every SqlQuery in the process, for diagnosing stalls caused by slow statements.
+  // Enabled with the console's .timings command or the STRAWBERRY_SQL_TIMING environment variable.
+  // Executions slower than the threshold (STRAWBERRY_SLOW_QUERY_MS, default 250) log the expanded SQL with bound values.
+  static void SetTimingEnabled(const bool enabled);
+  static bool TimingEnabled();
+  static void ResetTiming();
+  // Per-statement-pattern summary with a latency histogram, most expensive patterns first.
+  static QString TimingSummary();
+
  private:
+  void RecordTiming(const QString &pattern, const qint64 elapsed_us);
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
   QMap<QString, QVariant> bound_values_;
 #endif
@@ -19,6 +19,7 @@
 
 #include "config.h"
 
+#include <QDataStream>
 #include <QVariant>
 #include <QString>
 #include <QUrl>
@@ -29,14 +30,33 @@
 
 SqlRow::SqlRow(const QSqlQuery &query) { Init(query); }
 
+SqlRow::SqlRow(const QSqlQuery &query, const QStringList &field_names) { Init(query, field_names); }
+
+SqlRow::SqlRow() {}
+
 void SqlRow::Init(const QSqlQuery &query) {
 
   const QSqlRecord r = query.record();
+  QStringList field_names;
+  field_names.reserve(r.count());
   for (int i = 0; i < r.count(); ++i) {
-    columns_by_number_.insert(i, query.value(i));
-    const QString field_name = r.fieldName(i);
-    if (!columns_by_name_.contains(field_name) || columns_by_name_[field_name].isNull()) {
-      columns_by_name_.insert(field_name, query.value(i));
+    field_names << r.fieldName(i);
+  }
+
+  Init(query, field_names);
+
+}
+
+void SqlRow::Init(const QSqlQuery &query, const QStringList &field_names) {
+
+  values_.reserve(field_names.count());
+  columns_by_name_.reserve(field_names.count());
+  for (int i = 0; i < field_names.count(); ++i) {
+    values_ << query.value(i);
+    const QString &field_name = field_names[i];
+    const int existing = columns_by_name_.value(field_name, -1);
+    if (existing == -1 || values_.at(existing).isNull()) {
+      columns_by_name_.insert(field_name, i);
     }
   }
 
@@ -44,8 +64,8 @@ void SqlRow::Init(const QSqlQuery &query) {
 
 const QVariant SqlRow::value(const int number) const {
 
-  if (columns_by_number_.contains(number)) {
-    return columns_by_number_[number];
+  if (number >= 0 && number < values_.count()) {
+    return values_.at(number);
   }
   else {
     return QVariant();
@@ -55,8 +75,9 @@ const QVariant SqlRow::value(const int number) const {
 
 const QVariant SqlRow::value(const QString &name) const {
 
-  if (columns_by_name_.contains(name)) {
-    return columns_by_name_[name];
+  const int number = columns_by_name_.value(name, -1);
+  if (number != -1) {
+    return values_.at(number);
   }
   else {
     return QVariant();
@@ -65,29 +86,47 @@ const QVariant SqlRow::value(const QString &name) const {
 }
 
 QString SqlRow::ValueToString(const QString &n) const {
-  return value(n).isNull() ? QString() : value(n).toString();
+  const QVariant v = value(n);
+  return v.isNull() ? QString() : v.toString();
 }
 
 QUrl SqlRow::ValueToUrl(const QString &n) const {
-  return value(n).isNull() ? QUrl() : QUrl(value(n).toString());
+  const QVariant v = value(n);
+  return v.isNull() ? QUrl() : QUrl(v.toString());
 }
 
 int SqlRow::ValueToInt(const QString &n) const {
-  return value(n).isNull() ? -1 : value(n).toInt();
+  const QVariant v = value(n);
+  return v.isNull() ? -1 : v.toInt();
 }
 
 uint SqlRow::ValueToUInt(const QString &n) const {
-  return value(n).isNull() || value(n).toInt() < 0 ? 0 : value(n).toInt();
+  const QVariant v = value(n);
+  const int i = v.isNull() ? -1 : v.toInt();
+  return i < 0 ? 0 : i;
 }
 
 qint64 SqlRow::ValueToLongLong(const QString &n) const {
-  return value(n).isNull() ? -1 : value(n).toLongLong();
+  const QVariant v = value(n);
+  return v.isNull() ? -1 : v.toLongLong();
 }
 
 float SqlRow::ValueToFloat(const QString &n) const {
-  return value(n).isNull() ? -1.0F : value(n).toFloat();
+  const QVariant v = value(n);
+  return v.isNull() ? -1.0F : v.toFloat();
 }
 
 bool SqlRow::ValueToBool(const QString &n) const {
-  return !value(n).isNull() && value(n).toInt() == 1;
+  const QVariant v = value(n);
+  return !v.isNull() && v.toInt() == 1;
+}
+
+QDataStream &operator<<(QDataStream &stream, const SqlRow &row) {
+  stream << row.values_ << row.columns_by_name_;
+  return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, SqlRow &row) {
+  stream >> row.values_ >> row.columns_by_name_;
+  return stream;
 }
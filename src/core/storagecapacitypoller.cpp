@@ -0,0 +1,83 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <utility>
+
+#include <QObject>
+#include <QDateTime>
+#include <QString>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include "utilities/diskutils.h"
+
+#include "storagecapacitypoller.h"
+
+namespace {
+// How long a cached value is served before a background refresh is scheduled.
+constexpr qint64 kRefreshIntervalMsec = 60 * 1000;
+}  // namespace
+
+StorageCapacityPoller::StorageCapacityPoller(QObject *parent) : QObject(parent) {}
+
+quint64 StorageCapacityPoller::FreeSpace(const QString &path) {
+
+  ScheduleRefresh(path);
+
+  return entries_[path].free_space;
+
+}
+
+quint64 StorageCapacityPoller::Capacity(const QString &path) {
+
+  ScheduleRefresh(path);
+
+  return entries_[path].capacity;
+
+}
+
+void StorageCapacityPoller::ScheduleRefresh(const QString &path) {
+
+  Entry &entry = entries_[path];
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  if (entry.refreshing || (entry.last_refresh_time != 0 && now - entry.last_refresh_time < kRefreshIntervalMsec)) return;
+  entry.refreshing = true;
+
+  QFuture<std::pair<quint64, quint64>> future = QtConcurrent::run([path]() {
+    return std::make_pair(Utilities::FileSystemCapacity(path), Utilities::FileSystemFreeSpace(path));
+  });
+  QFutureWatcher<std::pair<quint64, quint64>> *watcher = new QFutureWatcher<std::pair<quint64, quint64>>();
+  QObject::connect(watcher, &QFutureWatcher<std::pair<quint64, quint64>>::finished, this, [this, watcher, path]() {
+    const std::pair<quint64, quint64> result = watcher->result();
+    watcher->deleteLater();
+    Entry &entry = entries_[path];
+    entry.refreshing = false;
+    entry.last_refresh_time = QDateTime::currentMSecsSinceEpoch();
+    if (entry.capacity != result.first || entry.free_space != result.second) {
+      entry.capacity = result.first;
+      entry.free_space = result.second;
+      emit CapacityChanged(path, entry.capacity, entry.free_space);
+    }
+  });
+  watcher->setFuture(future);
+
+}
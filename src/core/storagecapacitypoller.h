@@ -0,0 +1,66 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STORAGECAPACITYPOLLER_H
+#define STORAGECAPACITYPOLLER_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QObject>
+#include <QMap>
+#include <QString>
+
+// Asynchronous free-space and capacity lookups for storage paths.
+// Statting a sleeping NAS or a slow network mount can block for seconds, so
+// callers on the GUI thread get the cached last-known values back immediately
+// while the actual filesystem query runs in the thread pool.  CapacityChanged
+// is emitted when a refresh comes back with different numbers, and cached
+// values are refreshed at most once a minute.
+class StorageCapacityPoller : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit StorageCapacityPoller(QObject *parent = nullptr);
+
+  // Return the cached values for path, 0 while the first lookup is still in flight.
+  // Both schedule a background refresh when the cached value is stale.
+  quint64 FreeSpace(const QString &path);
+  quint64 Capacity(const QString &path);
+
+ signals:
+  void CapacityChanged(const QString &path, const quint64 capacity, const quint64 free_space);
+
+ private:
+  void ScheduleRefresh(const QString &path);
+
+ private:
+  struct Entry {
+    explicit Entry() : capacity(0), free_space(0), last_refresh_time(0), refreshing(false) {}
+    quint64 capacity;
+    quint64 free_space;
+    qint64 last_refresh_time;
+    bool refreshing;
+  };
+
+  QMap<QString, Entry> entries_;
+
+};
+
+#endif  // STORAGECAPACITYPOLLER_H
@@ -0,0 +1,53 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QString>
+
+#include "stringpool.h"
+
+const int StringPool::kMaxSize = 500000;
+
+QMutex StringPool::mutex_;
+QSet<QString> StringPool::pool_;
+
+QString StringPool::Intern(const QString &value) {
+
+  if (value.isEmpty()) return value;
+
+  QMutexLocker l(&mutex_);
+
+  QSet<QString>::const_iterator it = pool_.constFind(value);
+  if (it != pool_.constEnd()) {
+    return *it;
+  }
+
+  if (pool_.count() >= kMaxSize) {
+    pool_.clear();
+  }
+
+  pool_.insert(value);
+
+  return value;
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include "config.h"
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+// A global, thread-safe pool of interned strings.
+// Low cardinality metadata fields (artist, album, genre, ...) are repeated across hundreds of thousands of Song objects,
+// Intern() makes identical values share one implicitly shared QString allocation,
+// which also lets QString equality take the same-data fast path on hot filter code.
+class StringPool {
+ public:
+  // Returns a copy of value sharing one allocation with every other interned occurrence of the same string.
+  static QString Intern(const QString &value);
+
+ private:
+  // The pool is cleared when it grows beyond this many entries, previously returned strings remain valid.
+  static const int kMaxSize;
+
+  static QMutex mutex_;
+  static QSet<QString> pool_;
+};
+
+#endif  // STRINGPOOL_H
@@ -42,20 +42,26 @@ StyleSheetLoader::StyleSheetLoader(QObject *parent) : QObject(parent) {}
 
 void StyleSheetLoader::SetStyleSheet(QWidget *widget, const QString &filename) {
 
-  // Load the file
-  QFile file(filename);
-  if (!file.open(QIODevice::ReadOnly)) {
-    qLog(Error) << "Could not open stylesheet file" << filename << "for reading:" << file.errorString();
-    return;
-  }
-  QTextStream stream(&file);
+  // Load the file, unless it was read before
   QString stylesheet;
-  forever {
-    QString line = stream.readLine();
-    stylesheet.append(line);
-    if (stream.atEnd()) break;
+  if (stylesheet_templates_.contains(filename)) {
+    stylesheet = stylesheet_templates_[filename];
+  }
+  else {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+      qLog(Error) << "Could not open stylesheet file" << filename << "for reading:" << file.errorString();
+      return;
+    }
+    QTextStream stream(&file);
+    forever {
+      QString line = stream.readLine();
+      stylesheet.append(line);
+      if (stream.atEnd()) break;
+    }
+    file.close();
+    stylesheet_templates_.insert(filename, stylesheet);
   }
-  file.close();
 
   std::shared_ptr<StyleSheetData> styledata = std::make_shared<StyleSheetData>();
   styledata->filename_ = filename;
@@ -70,10 +76,21 @@ void StyleSheetLoader::SetStyleSheet(QWidget *widget, const QString &filename) {
 
 void StyleSheetLoader::UpdateStyleSheet(QWidget *widget, std::shared_ptr<StyleSheetData> styledata) {
 
+  QPalette p(widget->palette());
+
+  const QPair<QString, qint64> cache_key(styledata->filename_, p.cacheKey());
+  if (processed_stylesheets_.contains(cache_key)) {
+    const QString &stylesheet = processed_stylesheets_[cache_key];
+    if (stylesheet != styledata->stylesheet_current_) {
+      styledata->stylesheet_current_ = stylesheet;
+      widget->setStyleSheet(stylesheet);
+    }
+    return;
+  }
+
   QString stylesheet = styledata->stylesheet_template_;
 
   // Replace %palette-role with actual colours
-  QPalette p(widget->palette());
 
   {
     QColor alt = p.color(QPalette::AlternateBase);
@@ -115,6 +132,10 @@ void StyleSheetLoader::UpdateStyleSheet(QWidget *widget, std::shared_ptr<StyleSh
   stylesheet.replace("macos", "*");
 #endif
 
+  // Palette cache keys are never reused, so old entries can't produce stale hits - just stop the hash growing without bound.
+  if (processed_stylesheets_.count() >= 32) processed_stylesheets_.clear();
+  processed_stylesheets_.insert(cache_key, stylesheet);
+
   if (stylesheet != styledata->stylesheet_current_) {
     styledata->stylesheet_current_ = stylesheet;
     widget->setStyleSheet(stylesheet);
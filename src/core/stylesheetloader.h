@@ -63,6 +63,14 @@ class StyleSheetLoader : public QObject {
 
  private:
   QHash<QWidget*, std::shared_ptr<StyleSheetData>> styledata_;
+
+  // Raw stylesheet templates keyed by filename, so repeated SetStyleSheet calls don't re-read the file.
+  QHash<QString, QString> stylesheet_templates_;
+
+  // Processed stylesheet text keyed by (filename, palette cache key).
+  // A theme change delivers a PaletteChange to every styled widget, and they share a handful of palettes,
+  // so the variable substitution over the whole template only has to run once per palette instead of once per widget.
+  QHash<QPair<QString, qint64>, QString> processed_stylesheets_;
 };
 
 #endif  // STYLESHEETLOADER_H
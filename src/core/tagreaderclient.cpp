@@ -28,8 +28,12 @@
 #include <QThread>
 #include <QByteArray>
 #include <QString>
+#include <QStringList>
 #include <QImage>
+#include <QSharedMemory>
+#include <QMutexLocker>
 #include <QSettings>
+#include <QTimer>
 
 #include "core/logging.h"
 #include "core/workerpool.h"
@@ -39,9 +43,10 @@
 #include "settings/collectionsettingspage.h"
 
 const char *TagReaderClient::kWorkerExecutableName = "strawberry-tagreader";
+const int TagReaderClient::kMaxReadFileBatchSize = 64;
 TagReaderClient *TagReaderClient::sInstance = nullptr;
 
-TagReaderClient::TagReaderClient(QObject *parent) : QObject(parent), worker_pool_(new WorkerPool<HandlerType>(this)) {
+TagReaderClient::TagReaderClient(QObject *parent) : QObject(parent), worker_pool_(new WorkerPool<HandlerType>(this)), save_timer_(new QTimer(this)) {
 
   sInstance = this;
   original_thread_ = thread();
@@ -49,6 +54,13 @@ TagReaderClient::TagReaderClient(QObject *parent) : QObject(parent), worker_pool
   worker_pool_->SetExecutableName(kWorkerExecutableName);
   QObject::connect(worker_pool_, &WorkerPool<HandlerType>::WorkerFailedToStart, this, &TagReaderClient::WorkerFailedToStart);
 
+  QSettings settings;
+  settings.beginGroup(CollectionSettingsPage::kSettingsGroup);
+  save_timer_->setInterval(settings.value("tag_save_debounce_interval", 5000).toInt());
+  settings.endGroup();
+  save_timer_->setSingleShot(true);
+  QObject::connect(save_timer_, &QTimer::timeout, this, &TagReaderClient::FlushPendingSaves);
+
 }
 
 void TagReaderClient::Start() { worker_pool_->Start(); }
@@ -60,6 +72,11 @@ void TagReaderClient::ExitAsync() {
 void TagReaderClient::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
+
+  // Make sure no coalesced tag writes are lost on shutdown.
+  save_timer_->stop();
+  FlushPendingSaves();
+
   moveToThread(original_thread_);
   emit ExitFinished();
 
@@ -81,6 +98,20 @@ TagReaderReply *TagReaderClient::IsMediaFile(const QString &filename) {
 
 }
 
+TagReaderReply *TagReaderClient::IsMediaFileBatch(const QStringList &filenames) {
+
+  spb::tagreader::Message message;
+  spb::tagreader::IsMediaFileBatchRequest *request = message.mutable_is_media_file_batch_request();
+
+  for (const QString &filename : filenames) {
+    const QByteArray filename_data = filename.toUtf8();
+    request->add_filename(filename_data.constData(), filename_data.length());
+  }
+
+  return worker_pool_->SendMessageWithReply(&message);
+
+}
+
 TagReaderReply *TagReaderClient::ReadFile(const QString &filename) {
 
   spb::tagreader::Message message;
@@ -93,6 +124,20 @@ TagReaderReply *TagReaderClient::ReadFile(const QString &filename) {
 
 }
 
+TagReaderReply *TagReaderClient::ReadFileBatch(const QStringList &filenames) {
+
+  spb::tagreader::Message message;
+  spb::tagreader::ReadFileBatchRequest *request = message.mutable_read_file_batch_request();
+
+  for (const QString &filename : filenames) {
+    const QByteArray filename_data = filename.toUtf8();
+    request->add_filename(filename_data.constData(), filename_data.length());
+  }
+
+  return worker_pool_->SendMessageWithReply(&message);
+
+}
+
 TagReaderReply *TagReaderClient::SaveFile(const QString &filename, const Song &metadata, const SaveTags save_tags, const SavePlaycount save_playcount, const SaveRating save_rating, const SaveCoverOptions &save_cover_options) {
 
   spb::tagreader::Message message;
@@ -168,11 +213,15 @@ TagReaderReply *TagReaderClient::UpdateSongPlaycount(const Song &metadata) {
 
 void TagReaderClient::UpdateSongsPlaycount(const SongList &songs) {
 
-  for (const Song &song : songs) {
-    TagReaderReply *reply = UpdateSongPlaycount(song);
-    QObject::connect(reply, &TagReaderReply::Finished, reply, &TagReaderReply::deleteLater);
+  {
+    QMutexLocker l(&save_queue_mutex_);
+    for (const Song &song : songs) {
+      pending_playcount_saves_.insert(song.url().toLocalFile(), song);
+    }
   }
 
+  QMetaObject::invokeMethod(this, "StartSaveTimer", Qt::QueuedConnection);
+
 }
 
 TagReaderReply *TagReaderClient::UpdateSongRating(const Song &metadata) {
@@ -190,8 +239,49 @@ TagReaderReply *TagReaderClient::UpdateSongRating(const Song &metadata) {
 
 void TagReaderClient::UpdateSongsRating(const SongList &songs) {
 
-  for (const Song &song : songs) {
-    TagReaderReply *reply = UpdateSongRating(song);
+  {
+    QMutexLocker l(&save_queue_mutex_);
+    for (const Song &song : songs) {
+      pending_rating_saves_.insert(song.url().toLocalFile(), song);
+    }
+  }
+
+  QMetaObject::invokeMethod(this, "StartSaveTimer", Qt::QueuedConnection);
+
+}
+
+void TagReaderClient::StartSaveTimer() {
+
+  if (!save_timer_->isActive()) save_timer_->start();
+
+}
+
+void TagReaderClient::FlushPendingSaves() {
+
+  QMap<QString, Song> playcount_saves;
+  QMap<QString, Song> rating_saves;
+  {
+    QMutexLocker l(&save_queue_mutex_);
+    playcount_saves.swap(pending_playcount_saves_);
+    rating_saves.swap(pending_rating_saves_);
+  }
+
+  for (QMap<QString, Song>::const_iterator it = playcount_saves.constBegin(); it != playcount_saves.constEnd(); ++it) {
+    if (rating_saves.contains(it.key())) {
+      // Both a playcount and a rating update are pending for this file - write them in one save.
+      Song song = it.value();
+      song.set_rating(rating_saves.take(it.key()).rating());
+      TagReaderReply *reply = SaveFile(it.key(), song, SaveTags::Off, SavePlaycount::On, SaveRating::On);
+      QObject::connect(reply, &TagReaderReply::Finished, reply, &TagReaderReply::deleteLater);
+    }
+    else {
+      TagReaderReply *reply = UpdateSongPlaycount(it.value());
+      QObject::connect(reply, &TagReaderReply::Finished, reply, &TagReaderReply::deleteLater);
+    }
+  }
+
+  for (QMap<QString, Song>::const_iterator it = rating_saves.constBegin(); it != rating_saves.constEnd(); ++it) {
+    TagReaderReply *reply = UpdateSongRating(it.value());
     QObject::connect(reply, &TagReaderReply::Finished, reply, &TagReaderReply::deleteLater);
   }
 
@@ -225,6 +315,66 @@ void TagReaderClient::ReadFileBlocking(const QString &filename, Song *song) {
 
 }
 
+QList<bool> TagReaderClient::IsMediaFileBatchBlocking(const QStringList &filenames) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+
+  QList<bool> results;
+  results.reserve(filenames.count());
+
+  // Send all chunks up front so the workers can pipeline them, then collect the replies in order.
+  QList<TagReaderReply*> replies;
+  QList<int> chunk_sizes;
+  for (qint64 i = 0; i < filenames.count(); i += kMaxReadFileBatchSize) {
+    const QStringList chunk = filenames.mid(static_cast<int>(i), kMaxReadFileBatchSize);
+    chunk_sizes << chunk.count();
+    replies << IsMediaFileBatch(chunk);
+  }
+
+  for (int c = 0; c < replies.count(); ++c) {
+    TagReaderReply *reply = replies[c];
+    const bool finished = reply->WaitForFinished();
+    const spb::tagreader::IsMediaFileBatchResponse &response = reply->message().is_media_file_batch_response();
+    // Pad short or failed replies with false so the results stay aligned with the request.
+    for (int i = 0; i < chunk_sizes[c]; ++i) {
+      results << (finished && i < response.success_size() ? response.success(i) : false);
+    }
+    reply->deleteLater();
+  }
+
+  return results;
+
+}
+
+SongList TagReaderClient::ReadFileBatchBlocking(const QStringList &filenames) {
+
+  Q_ASSERT(QThread::currentThread() != thread());
+
+  SongList songs;
+  songs.reserve(filenames.count());
+
+  // Send all chunks up front so the workers can pipeline them, then collect the replies in order.
+  QList<TagReaderReply*> replies;
+  for (qint64 i = 0; i < filenames.count(); i += kMaxReadFileBatchSize) {
+    replies << ReadFileBatch(filenames.mid(static_cast<int>(i), kMaxReadFileBatchSize));
+  }
+
+  for (TagReaderReply *reply : replies) {
+    if (reply->WaitForFinished()) {
+      const spb::tagreader::ReadFileBatchResponse &response = reply->message().read_file_batch_response();
+      for (int i = 0; i < response.responses_size(); ++i) {
+        Song song;
+        song.InitFromProtobuf(response.responses(i).metadata());
+        if (song.is_valid()) songs << song;
+      }
+    }
+    reply->deleteLater();
+  }
+
+  return songs;
+
+}
+
 bool TagReaderClient::SaveFileBlocking(const QString &filename, const Song &metadata, const SaveTags save_tags, const SavePlaycount save_playcount, const SaveRating save_rating, const SaveCoverOptions &save_cover_options) {
 
   Q_ASSERT(QThread::currentThread() != thread());
@@ -249,8 +399,7 @@ QByteArray TagReaderClient::LoadEmbeddedArtBlocking(const QString &filename) {
 
   TagReaderReply *reply = LoadEmbeddedArt(filename);
   if (reply->WaitForFinished()) {
-    const std::string &data_str = reply->message().load_embedded_art_response().data();
-    ret = QByteArray(data_str.data(), static_cast<qint64>(data_str.size()));
+    ret = EmbeddedArtFromResponse(reply->message().load_embedded_art_response());
   }
   reply->deleteLater();
 
@@ -266,8 +415,7 @@ QImage TagReaderClient::LoadEmbeddedArtAsImageBlocking(const QString &filename)
 
   TagReaderReply *reply = LoadEmbeddedArt(filename);
   if (reply->WaitForFinished()) {
-    const std::string &data_str = reply->message().load_embedded_art_response().data();
-    ret.loadFromData(QByteArray(data_str.data(), static_cast<qint64>(data_str.size())));
+    ret.loadFromData(EmbeddedArtFromResponse(reply->message().load_embedded_art_response()));
   }
   reply->deleteLater();
 
@@ -275,6 +423,24 @@ QImage TagReaderClient::LoadEmbeddedArtAsImageBlocking(const QString &filename)
 
 }
 
+QByteArray TagReaderClient::EmbeddedArtFromResponse(const spb::tagreader::LoadEmbeddedArtResponse &response) {
+
+  if (response.has_shared_memory_key()) {
+    QSharedMemory memory(QString::fromUtf8(response.shared_memory_key().data(), response.shared_memory_key().size()));
+    if (memory.attach(QSharedMemory::ReadOnly)) {
+      const QByteArray data(static_cast<const char*>(memory.constData()), static_cast<qint64>(response.shared_memory_size()));
+      memory.detach();
+      return data;
+    }
+    qLog(Error) << "Unable to attach to tagreader shared memory segment" << QString::fromUtf8(response.shared_memory_key().data(), response.shared_memory_key().size()) << memory.errorString();
+    return QByteArray();
+  }
+
+  const std::string &data_str = response.data();
+  return QByteArray(data_str.data(), static_cast<qint64>(data_str.size()));
+
+}
+
 bool TagReaderClient::SaveEmbeddedArtBlocking(const QString &filename, const SaveCoverOptions &save_cover_options) {
 
   Q_ASSERT(QThread::currentThread() != thread());
@@ -26,6 +26,10 @@
 
 #include <QObject>
 #include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <QTimer>
 #include <QString>
 #include <QImage>
 
@@ -49,6 +53,7 @@ class TagReaderClient : public QObject {
   using ReplyType = HandlerType::ReplyType;
 
   static const char *kWorkerExecutableName;
+  static const int kMaxReadFileBatchSize;
 
   void Start();
   void ExitAsync();
@@ -80,7 +85,9 @@ class TagReaderClient : public QObject {
   };
 
   ReplyType *IsMediaFile(const QString &filename);
+  ReplyType *IsMediaFileBatch(const QStringList &filenames);
   ReplyType *ReadFile(const QString &filename);
+  ReplyType *ReadFileBatch(const QStringList &filenames);
   ReplyType *SaveFile(const QString &filename, const Song &metadata, const SaveTags save_tags = SaveTags::On, const SavePlaycount save_playcount = SavePlaycount::Off, const SaveRating save_rating = SaveRating::Off, const SaveCoverOptions &save_cover_options = SaveCoverOptions());
   ReplyType *LoadEmbeddedArt(const QString &filename);
   ReplyType *SaveEmbeddedArt(const QString &filename, const SaveCoverOptions &save_cover_options);
@@ -90,8 +97,12 @@ class TagReaderClient : public QObject {
   // Convenience functions that call the above functions and wait for a response.
   // These block the calling thread with a semaphore, and must NOT be called from the TagReaderClient's thread.
   void ReadFileBlocking(const QString &filename, Song *song);
+  // Reads the given files in chunks of kMaxReadFileBatchSize per worker message, returning the valid songs in request order.
+  SongList ReadFileBatchBlocking(const QStringList &filenames);
   bool SaveFileBlocking(const QString &filename, const Song &metadata, const SaveTags save_tags = SaveTags::On, const SavePlaycount save_playcount = SavePlaycount::Off, const SaveRating save_rating = SaveRating::Off, const SaveCoverOptions &save_cover_options = SaveCoverOptions());
   bool IsMediaFileBlocking(const QString &filename);
+  // Checks the given files in chunks of kMaxReadFileBatchSize per worker message, returning one result per file in request order.
+  QList<bool> IsMediaFileBatchBlocking(const QStringList &filenames);
   QByteArray LoadEmbeddedArtBlocking(const QString &filename);
   QImage LoadEmbeddedArtAsImageBlocking(const QString &filename);
   bool SaveEmbeddedArtBlocking(const QString &filename, const SaveCoverOptions &save_cover_options);
@@ -101,12 +112,17 @@ class TagReaderClient : public QObject {
   // TODO: Make this not a singleton
   static TagReaderClient *Instance() { return sInstance; }
 
+  // Extracts embedded art from a response, attaching to the worker's shared memory segment for large payloads.
+  static QByteArray EmbeddedArtFromResponse(const spb::tagreader::LoadEmbeddedArtResponse &response);
+
  signals:
   void ExitFinished();
 
  private slots:
   void Exit();
   void WorkerFailedToStart();
+  void StartSaveTimer();
+  void FlushPendingSaves();
 
  public slots:
   void UpdateSongsPlaycount(const SongList &songs);
@@ -118,6 +134,14 @@ class TagReaderClient : public QObject {
   WorkerPool<HandlerType> *worker_pool_;
   QList<spb::tagreader::Message> message_queue_;
   QThread *original_thread_;
+
+  // Write-behind queue for playcount and rating tag writes.
+  // Pending updates are coalesced per file over the save timer's window and flushed in one file save,
+  // so bulk rating an album or scrobbler playcount ticks do not rewrite the same file repeatedly.
+  QMutex save_queue_mutex_;
+  QMap<QString, Song> pending_playcount_saves_;
+  QMap<QString, Song> pending_rating_saves_;
+  QTimer *save_timer_;
 };
 
 using TagReaderReply = TagReaderClient::ReplyType;
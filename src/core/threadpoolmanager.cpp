@@ -0,0 +1,82 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QObject>
+#include <QThread>
+#include <QThreadPool>
+
+#include "core/logging.h"
+#include "application.h"
+#include "player.h"
+#include "threadpoolmanager.h"
+
+ThreadPoolManager::ThreadPoolManager(Application *app, QObject *parent)
+    : QObject(parent),
+      interactive_pool_(new QThreadPool(this)),
+      background_pool_(new QThreadPool(this)),
+      playback_active_(false) {
+
+  interactive_pool_->setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+
+  ApplyLimits();
+
+  QObject::connect(app->player(), &Player::Playing, this, &ThreadPoolManager::PlaybackActive);
+  QObject::connect(app->player(), &Player::Paused, this, &ThreadPoolManager::PlaybackInactive);
+  QObject::connect(app->player(), &Player::Stopped, this, &ThreadPoolManager::PlaybackInactive);
+
+}
+
+QThreadPool *ThreadPoolManager::Pool(const QoS qos) const {
+
+  switch (qos) {
+    case QoS::Interactive: return interactive_pool_;
+    case QoS::Background:  return background_pool_;
+  }
+
+  return interactive_pool_;
+
+}
+
+void ThreadPoolManager::PlaybackActive() {
+
+  if (playback_active_) return;
+  playback_active_ = true;
+  ApplyLimits();
+
+}
+
+void ThreadPoolManager::PlaybackInactive() {
+
+  if (!playback_active_) return;
+  playback_active_ = false;
+  ApplyLimits();
+
+}
+
+void ThreadPoolManager::ApplyLimits() {
+
+  // Jobs already running are not interrupted - lowering the limit only stops the pool picking up new jobs until enough finish.
+  const int background_threads = playback_active_ ? 1 : qMax(1, QThread::idealThreadCount() / 2);
+  background_pool_->setMaxThreadCount(background_threads);
+
+  qLog(Debug) << "Background pool limited to" << background_threads << "threads";
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef THREADPOOLMANAGER_H
+#define THREADPOOLMANAGER_H
+
+#include "config.h"
+
+#include <QObject>
+
+class QThreadPool;
+class Application;
+
+// Process-wide thread pools with quality of service classes, so batch work doesn't oversubscribe the machine
+// and can be throttled while playback is active.
+// Subsystems that host a QObject with an event loop on a dedicated thread (database, collection watcher)
+// can't run on a pool - this is for run-to-completion jobs.
+class ThreadPoolManager : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit ThreadPoolManager(Application *app, QObject *parent = nullptr);
+
+  enum class QoS {
+    // Work the user is waiting on right now, like loading the songs behind a drag and drop.
+    Interactive,
+    // Batch work nobody is waiting on, like cover exports. Throttled to one thread while playback is active.
+    Background
+  };
+
+  QThreadPool *Pool(const QoS qos) const;
+
+ private slots:
+  void PlaybackActive();
+  void PlaybackInactive();
+
+ private:
+  void ApplyLimits();
+
+  QThreadPool *interactive_pool_;
+  QThreadPool *background_pool_;
+
+  bool playback_active_;
+};
+
+#endif  // THREADPOOLMANAGER_H
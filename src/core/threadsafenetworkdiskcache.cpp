@@ -25,6 +25,8 @@
 #include <QObject>
 #include <QCoreApplication>
 #include <QStandardPaths>
+#include <QBuffer>
+#include <QDateTime>
 #include <QIODevice>
 #include <QMutex>
 #include <QNetworkDiskCache>
@@ -36,20 +38,26 @@
 
 QMutex ThreadSafeNetworkDiskCache::sMutex;
 int ThreadSafeNetworkDiskCache::sInstances = 0;
-QNetworkDiskCache *ThreadSafeNetworkDiskCache::sCache = nullptr;
+ThreadSafeNetworkDiskCache::Shard ThreadSafeNetworkDiskCache::sShards[kShardCount];
+QHash<QIODevice*, int> ThreadSafeNetworkDiskCache::sPreparedDevices;
+QMutex ThreadSafeNetworkDiskCache::sMemoryCacheMutex;
+QCache<QUrl, ThreadSafeNetworkDiskCache::CachedEntry> ThreadSafeNetworkDiskCache::sMemoryCache(kMemoryCacheSizeBytes);
 
 ThreadSafeNetworkDiskCache::ThreadSafeNetworkDiskCache(QObject *parent) : QAbstractNetworkCache(parent) {
 
   QMutexLocker l(&sMutex);
   ++sInstances;
 
-  if (!sCache) {
-    sCache = new QNetworkDiskCache;
+  if (!sShards[0].cache) {
 #ifdef Q_OS_WIN32
-    sCache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/strawberry/networkcache");
+    const QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/strawberry/networkcache";
 #else
-    sCache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/networkcache");
+    const QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/networkcache";
 #endif
+    for (int i = 0; i < kShardCount; ++i) {
+      sShards[i].cache = new QNetworkDiskCache;
+      sShards[i].cache->setCacheDirectory(cache_dir + "/shard" + QString::number(i));
+    }
   }
 
 }
@@ -59,49 +67,172 @@ ThreadSafeNetworkDiskCache::~ThreadSafeNetworkDiskCache() {
   QMutexLocker l(&sMutex);
   --sInstances;
 
-  if (sCache && sInstances == 0) {
-    sCache->deleteLater();
-    sCache = nullptr;
+  if (sShards[0].cache && sInstances == 0) {
+    for (int i = 0; i < kShardCount; ++i) {
+      sShards[i].cache->deleteLater();
+      sShards[i].cache = nullptr;
+    }
+    sPreparedDevices.clear();
   }
 
 }
 
+int ThreadSafeNetworkDiskCache::ShardIndexForUrl(const QUrl &url) {
+  return static_cast<int>(qHash(url) % static_cast<uint>(kShardCount));
+}
+
 qint64 ThreadSafeNetworkDiskCache::cacheSize() const {
-  QMutexLocker l(&sMutex);
-  return sCache->cacheSize();
+
+  qint64 size = 0;
+  for (int i = 0; i < kShardCount; ++i) {
+    QMutexLocker l(&sShards[i].mutex);
+    size += sShards[i].cache->cacheSize();
+  }
+
+  return size;
+
 }
 
 QIODevice *ThreadSafeNetworkDiskCache::data(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->data(url);
+
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    if (CachedEntry *entry = sMemoryCache.object(url)) {
+      if (entry->metadata.expirationDate().isValid() && entry->metadata.expirationDate() <= QDateTime::currentDateTime()) {
+        sMemoryCache.remove(url);
+      }
+      else {
+        QBuffer *buffer = new QBuffer;
+        buffer->setData(entry->data);
+        buffer->open(QIODevice::ReadOnly);
+        return buffer;
+      }
+    }
+  }
+
+  QIODevice *device = nullptr;
+  QNetworkCacheMetaData disk_metadata;
+  {
+    Shard &shard = sShards[ShardIndexForUrl(url)];
+    QMutexLocker l(&shard.mutex);
+    device = shard.cache->data(url);
+    if (device) disk_metadata = shard.cache->metaData(url);
+  }
+  if (!device) return nullptr;
+
+  // Keep small entries in memory so repeated lookups within a session skip the disk.
+  if (device->size() <= kMemoryCacheMaxEntryBytes) {
+    const QByteArray data = device->readAll();
+    delete device;
+    {
+      QMutexLocker l(&sMemoryCacheMutex);
+      sMemoryCache.insert(url, new CachedEntry{disk_metadata, data}, qMax(1, static_cast<int>(data.size())));
+    }
+    QBuffer *buffer = new QBuffer;
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    return buffer;
+  }
+
+  return device;
+
 }
 
 void ThreadSafeNetworkDiskCache::insert(QIODevice *device) {
-  QMutexLocker l(&sMutex);
-  sCache->insert(device);
+
+  int shard_idx = 0;
+  {
+    QMutexLocker l(&sMutex);
+    if (!sPreparedDevices.contains(device)) return;
+    shard_idx = sPreparedDevices.take(device);
+  }
+
+  Shard &shard = sShards[shard_idx];
+  QMutexLocker l(&shard.mutex);
+  shard.cache->insert(device);
+
 }
 
 QNetworkCacheMetaData ThreadSafeNetworkDiskCache::metaData(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->metaData(url);
+
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    if (CachedEntry *entry = sMemoryCache.object(url)) {
+      return entry->metadata;
+    }
+  }
+
+  Shard &shard = sShards[ShardIndexForUrl(url)];
+  QMutexLocker l(&shard.mutex);
+  return shard.cache->metaData(url);
+
 }
 
 QIODevice *ThreadSafeNetworkDiskCache::prepare(const QNetworkCacheMetaData &metaData) {
-  QMutexLocker l(&sMutex);
-  return sCache->prepare(metaData);
+
+  // The entry is about to be rewritten, drop any stale copy held in memory.
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    sMemoryCache.remove(metaData.url());
+  }
+
+  const int shard_idx = ShardIndexForUrl(metaData.url());
+
+  QIODevice *device = nullptr;
+  {
+    Shard &shard = sShards[shard_idx];
+    QMutexLocker l(&shard.mutex);
+    device = shard.cache->prepare(metaData);
+  }
+
+  // Remember which shard prepared the device, insert() only gets the device back.
+  if (device) {
+    QMutexLocker l(&sMutex);
+    sPreparedDevices[device] = shard_idx;
+  }
+
+  return device;
+
 }
 
 bool ThreadSafeNetworkDiskCache::remove(const QUrl &url) {
-  QMutexLocker l(&sMutex);
-  return sCache->remove(url);
+
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    sMemoryCache.remove(url);
+  }
+
+  Shard &shard = sShards[ShardIndexForUrl(url)];
+  QMutexLocker l(&shard.mutex);
+  return shard.cache->remove(url);
+
 }
 
 void ThreadSafeNetworkDiskCache::updateMetaData(const QNetworkCacheMetaData &metaData) {
-  QMutexLocker l(&sMutex);
-  sCache->updateMetaData(metaData);
+
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    if (CachedEntry *entry = sMemoryCache.object(metaData.url())) {
+      entry->metadata = metaData;
+    }
+  }
+
+  Shard &shard = sShards[ShardIndexForUrl(metaData.url())];
+  QMutexLocker l(&shard.mutex);
+  shard.cache->updateMetaData(metaData);
+
 }
 
 void ThreadSafeNetworkDiskCache::clear() {
-  QMutexLocker l(&sMutex);
-  sCache->clear();
+
+  {
+    QMutexLocker l(&sMemoryCacheMutex);
+    sMemoryCache.clear();
+  }
+
+  for (int i = 0; i < kShardCount; ++i) {
+    QMutexLocker l(&sShards[i].mutex);
+    sShards[i].cache->clear();
+  }
+
 }
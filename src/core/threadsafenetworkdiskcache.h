@@ -27,7 +27,10 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QAbstractNetworkCache>
+#include <QByteArray>
+#include <QCache>
 #include <QMutex>
+#include <QHash>
 #include <QUrl>
 #include <QNetworkCacheMetaData>
 
@@ -53,9 +56,32 @@ class ThreadSafeNetworkDiskCache : public QAbstractNetworkCache {
   void clear() override;
 
  private:
+  // The cache is sharded by URL hash so concurrent requests for different URLs don't serialize on one lock.
+  struct Shard {
+    Shard() : cache(nullptr) {}
+    QMutex mutex;
+    QNetworkDiskCache *cache;
+  };
+
+  // Entries read from or written through the disk cache are also kept in a small in-memory cache,
+  // so repeated lookups within a session don't hit the disk again.
+  struct CachedEntry {
+    QNetworkCacheMetaData metadata;
+    QByteArray data;
+  };
+
+  static const int kShardCount = 4;
+  static const int kMemoryCacheSizeBytes = 4 * 1024 * 1024;
+  static const int kMemoryCacheMaxEntryBytes = 256 * 1024;
+
+  static int ShardIndexForUrl(const QUrl &url);
+
   static QMutex sMutex;
   static int sInstances;
-  static QNetworkDiskCache *sCache;
+  static Shard sShards[kShardCount];
+  static QHash<QIODevice*, int> sPreparedDevices;
+  static QMutex sMemoryCacheMutex;
+  static QCache<QUrl, CachedEntry> sMemoryCache;
 };
 
 #endif  // THREADSAFENETWORKDISKCACHE_H
@@ -0,0 +1,138 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <atomic>
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QThread>
+
+#include "trace.h"
+
+namespace Trace {
+
+namespace {
+
+// Events recorded per thread between dumps, older events are overwritten once a thread wraps around.
+const int kBufferCapacity = 4096;
+
+struct Event {
+  const char *name;
+  qint64 start_us;
+  qint64 duration_us;
+};
+
+// Single writer (the owning thread), only Dump() reads from other threads.
+// Those reads are deliberately unsynchronized, a torn event in a diagnostic dump is acceptable.
+struct ThreadBuffer {
+  ThreadBuffer() : thread_id(reinterpret_cast<quint64>(QThread::currentThreadId())), count(0) {}
+
+  quint64 thread_id;
+  std::atomic<int> count;
+  Event events[kBufferCapacity];
+};
+
+QMutex sBuffersMutex;
+QList<ThreadBuffer*> *sBuffers = nullptr;
+
+qint64 NowUs() {
+
+  static const QElapsedTimer timer = [] { QElapsedTimer t; t.start(); return t; }();
+  return timer.nsecsElapsed() / 1000;
+
+}
+
+ThreadBuffer *BufferForThisThread() {
+
+  thread_local ThreadBuffer *buffer = nullptr;
+  if (!buffer) {
+    // Deliberately never freed: events recorded by threads that have since exited stay available for the dump.
+    buffer = new ThreadBuffer;
+    QMutexLocker l(&sBuffersMutex);
+    if (!sBuffers) sBuffers = new QList<ThreadBuffer*>;
+    sBuffers->append(buffer);
+  }
+  return buffer;
+
+}
+
+}  // namespace
+
+ScopedEvent::ScopedEvent(const char *name) : name_(name), start_us_(NowUs()) {}
+
+ScopedEvent::~ScopedEvent() {
+
+  ThreadBuffer *buffer = BufferForThisThread();
+  const int slot = buffer->count.fetch_add(1, std::memory_order_relaxed) % kBufferCapacity;
+  Event &event = buffer->events[slot];
+  event.name = name_;
+  event.start_us = start_us_;
+  event.duration_us = NowUs() - start_us_;
+
+}
+
+bool Dump(const QString &filename) {
+
+  QJsonArray events;
+  {
+    QMutexLocker l(&sBuffersMutex);
+    if (sBuffers) {
+      for (const ThreadBuffer *buffer : *sBuffers) {
+        const int count = qMin(buffer->count.load(std::memory_order_relaxed), kBufferCapacity);
+        for (int i = 0; i < count; ++i) {
+          const Event &event = buffer->events[i];
+          QJsonObject object;
+          object["name"] = QString::fromUtf8(event.name);
+          object["ph"] = "X";
+          object["pid"] = QCoreApplication::applicationPid();
+          object["tid"] = static_cast<qint64>(buffer->thread_id);
+          object["ts"] = event.start_us;
+          object["dur"] = event.duration_us;
+          events << object;
+        }
+      }
+    }
+  }
+
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = "ms";
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  file.close();
+
+  return true;
+
+}
+
+}  // namespace Trace
@@ -0,0 +1,56 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+
+// Lightweight in-process tracing for the hot paths that qLog is too noisy for.
+// TRACE_SCOPE records the enclosing scope into a per-thread ring buffer with no locking on the hot path,
+// and Trace::Dump() writes everything recorded so far as JSON that chrome://tracing and ui.perfetto.dev can load.
+
+namespace Trace {
+
+// Records the enclosing scope as one complete event when it is destroyed.
+// The name must be a string literal, only the pointer is stored.
+class ScopedEvent {
+ public:
+  explicit ScopedEvent(const char *name);
+  ~ScopedEvent();
+
+ private:
+  const char *name_;
+  qint64 start_us_;
+
+  Q_DISABLE_COPY(ScopedEvent)
+};
+
+// Writes all recorded events to filename in the chrome://tracing JSON format.
+// Returns false when the file can't be opened.
+bool Dump(const QString &filename);
+
+}  // namespace Trace
+
+#define TRACE_SCOPE(name) const Trace::ScopedEvent trace_scoped_event_(name)
+
+#endif  // TRACE_H
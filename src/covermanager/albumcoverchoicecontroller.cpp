@@ -683,6 +683,9 @@ void AlbumCoverChoiceController::SaveCoverEmbeddedAutomatic(const Song &song, Al
         QMutexLocker l(&mutex_cover_save_tasks_);
         cover_save_tasks_.insert(id, song);
       }
+      // Update the model optimistically from the in-memory image while the files are rewritten in the background, SaveEmbeddedCoverAsyncFinished rolls this back on failure.
+      Song song_copy = song;
+      SaveArtAutomaticToSong(&song_copy, result->image_data.isEmpty() && result->image.isNull() ? QUrl() : QUrl::fromLocalFile(Song::kEmbeddedCover));
     });
     watcher->setFuture(future);
   }
@@ -719,8 +722,13 @@ void AlbumCoverChoiceController::SaveCoverEmbeddedAutomatic(const Song &song, co
       urls.reserve(songs.count());
       for (const Song &s : songs) urls << s.url();
       quint64 id = app_->album_cover_loader()->SaveEmbeddedCoverAsync(urls, cover_filename);
-      QMutexLocker l(&mutex_cover_save_tasks_);
-      cover_save_tasks_.insert(id, song);
+      {
+        QMutexLocker l(&mutex_cover_save_tasks_);
+        cover_save_tasks_.insert(id, song);
+      }
+      // Update the model optimistically while the files are rewritten in the background, SaveEmbeddedCoverAsyncFinished rolls this back on failure.
+      Song song_copy = song;
+      SaveArtAutomaticToSong(&song_copy, QUrl::fromLocalFile(Song::kEmbeddedCover));
     });
     watcher->setFuture(future);
   }
@@ -816,9 +824,10 @@ void AlbumCoverChoiceController::SaveEmbeddedCoverAsyncFinished(quint64 id, cons
   if (!cover_save_tasks_.contains(id)) return;
 
   Song song = cover_save_tasks_.take(id);
-  if (success) {
-    if (cleared) SaveArtAutomaticToSong(&song, QUrl());
-    else SaveArtAutomaticToSong(&song, QUrl::fromLocalFile(Song::kEmbeddedCover));
-  }
+  if (success) return;  // The model was already updated optimistically when the save was dispatched.
+
+  // Roll back the optimistic update: a failed save leaves the files without the new cover, a failed clear leaves the old one in place.
+  if (cleared) SaveArtAutomaticToSong(&song, QUrl::fromLocalFile(Song::kEmbeddedCover));
+  else SaveArtAutomaticToSong(&song, QUrl());
 
 }
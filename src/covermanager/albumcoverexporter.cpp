@@ -23,21 +23,19 @@
 #include <QObject>
 #include <QThreadPool>
 
+#include "core/application.h"
 #include "core/song.h"
+#include "core/threadpoolmanager.h"
 #include "albumcoverexport.h"
 #include "albumcoverexporter.h"
 #include "coverexportrunnable.h"
 
-const int AlbumCoverExporter::kMaxConcurrentRequests = 3;
-
-AlbumCoverExporter::AlbumCoverExporter(QObject *parent)
+AlbumCoverExporter::AlbumCoverExporter(Application *app, QObject *parent)
     : QObject(parent),
-      thread_pool_(new QThreadPool(this)),
+      thread_pool_(app->thread_pool_manager()->Pool(ThreadPoolManager::QoS::Background)),
       exported_(0),
       skipped_(0),
-      all_(0) {
-  thread_pool_->setMaxThreadCount(kMaxConcurrentRequests);
-}
+      all_(0) {}
 
 void AlbumCoverExporter::SetDialogResult(const AlbumCoverExport::DialogResult &dialog_result) {
   dialog_result_ = dialog_result;
@@ -48,7 +46,12 @@ void AlbumCoverExporter::AddExportRequest(const Song &song) {
   all_ = static_cast<int>(requests_.count());
 }
 
-void AlbumCoverExporter::Cancel() { requests_.clear(); }
+void AlbumCoverExporter::Cancel() {
+
+  qDeleteAll(requests_);
+  requests_.clear();
+
+}
 
 void AlbumCoverExporter::StartExporting() {
 
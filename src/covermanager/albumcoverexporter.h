@@ -30,6 +30,7 @@
 #include "albumcoverexport.h"
 
 class QThreadPool;
+class Application;
 class Song;
 class CoverExportRunnable;
 
@@ -37,9 +38,7 @@ class AlbumCoverExporter : public QObject {
   Q_OBJECT
 
  public:
-  explicit AlbumCoverExporter(QObject *parent = nullptr);
-
-  static const int kMaxConcurrentRequests;
+  explicit AlbumCoverExporter(Application *app, QObject *parent = nullptr);
 
   void SetDialogResult(const AlbumCoverExport::DialogResult &dialog_result);
   void AddExportRequest(const Song &song);
@@ -60,6 +59,7 @@ class AlbumCoverExporter : public QObject {
   AlbumCoverExport::DialogResult dialog_result_;
 
   QQueue<CoverExportRunnable*> requests_;
+  // The shared background pool - exporting is batch work, so it gets throttled while playback is active.
   QThreadPool *thread_pool_;
 
   int exported_;
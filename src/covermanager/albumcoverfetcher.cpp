@@ -26,6 +26,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QTimer>
+#include <QDateTime>
 #include <QString>
 
 #include "core/networkaccessmanager.h"
@@ -36,6 +37,7 @@
 using namespace std::chrono_literals;
 
 const int AlbumCoverFetcher::kMaxConcurrentRequests = 5;
+const qint64 AlbumCoverFetcher::kResultCacheStaleAgeMs = 60 * 60 * 1000;  // 1 hour
 
 AlbumCoverFetcher::AlbumCoverFetcher(CoverProviders *cover_providers, NetworkAccessManager *network, QObject *parent)
     : QObject(parent),
@@ -72,6 +74,35 @@ quint64 AlbumCoverFetcher::FetchAlbumCover(const QString &artist, const QString
   request.search = false;
   request.batch = batch;
 
+  const QString cache_key = CoverResultCacheKey(request);
+
+  // Serve a previous result for the same query instantly, whether it found a cover or not.
+  // Stale entries are refreshed in the background so the next fetch gets a current answer.
+  if (cover_result_cache_.contains(cache_key)) {
+    const CachedCoverResult &cached = cover_result_cache_[cache_key];
+    AlbumCoverImageResultPtr result = cached.result;
+    const quint64 id = request.id;
+    QTimer::singleShot(0, this, [this, id, result]() { emit AlbumCoverFetched(id, result, CoverSearchStatistics()); });
+    if (QDateTime::currentMSecsSinceEpoch() - cached.timestamp >= kResultCacheStaleAgeMs && !pending_fetch_keys_.contains(cache_key)) {
+      CoverSearchRequest refresh_request = request;
+      refresh_request.id = ++next_id_;
+      background_refresh_requests_ << refresh_request.id;
+      fetch_request_keys_[refresh_request.id] = cache_key;
+      pending_fetch_keys_ << cache_key;
+      AddRequest(refresh_request);
+    }
+    return request.id;
+  }
+
+  // A search for the same query is already running or queued, piggyback on it instead of hitting the providers again.
+  if (pending_fetch_keys_.contains(cache_key)) {
+    waiting_requests_.insert(cache_key, request.id);
+    return request.id;
+  }
+
+  fetch_request_keys_[request.id] = cache_key;
+  pending_fetch_keys_ << cache_key;
+
   AddRequest(request);
   return request.id;
 
@@ -115,6 +146,15 @@ void AlbumCoverFetcher::Clear() {
   }
   active_requests_.clear();
 
+  fetch_request_keys_.clear();
+  pending_fetch_keys_.clear();
+  waiting_requests_.clear();
+  background_refresh_requests_.clear();
+
+}
+
+QString AlbumCoverFetcher::CoverResultCacheKey(const CoverSearchRequest &request) {
+  return request.artist.toLower() + "/" + request.album.toLower() + "/" + request.title.toLower();
 }
 
 void AlbumCoverFetcher::StartRequests() {
@@ -156,6 +196,27 @@ void AlbumCoverFetcher::SingleCoverFetched(const quint64 request_id, AlbumCoverI
   AlbumCoverFetcherSearch *search = active_requests_.take(request_id);
 
   search->deleteLater();
+
+  if (fetch_request_keys_.contains(request_id)) {
+    const QString cache_key = fetch_request_keys_.take(request_id);
+    pending_fetch_keys_.remove(cache_key);
+    CachedCoverResult cached;
+    cached.result = result;
+    cached.timestamp = QDateTime::currentMSecsSinceEpoch();
+    cover_result_cache_[cache_key] = cached;
+    // Answer any requests for the same query that piggybacked on this search.
+    const QList<quint64> waiting = waiting_requests_.values(cache_key);
+    waiting_requests_.remove(cache_key);
+    for (const quint64 waiting_id : waiting) {
+      emit AlbumCoverFetched(waiting_id, result, CoverSearchStatistics());
+    }
+  }
+
+  if (background_refresh_requests_.contains(request_id)) {
+    background_refresh_requests_.remove(request_id);
+    return;
+  }
+
   emit AlbumCoverFetched(request_id, result, search->statistics());
 
 }
@@ -30,6 +30,7 @@
 #include <QSet>
 #include <QList>
 #include <QHash>
+#include <QMultiHash>
 #include <QQueue>
 #include <QByteArray>
 #include <QString>
@@ -111,6 +112,7 @@ class AlbumCoverFetcher : public QObject {
   ~AlbumCoverFetcher() override;
 
   static const int kMaxConcurrentRequests;
+  static const qint64 kResultCacheStaleAgeMs;
 
   quint64 SearchForCovers(const QString &artist, const QString &album, const QString &title = QString());
   quint64 FetchAlbumCover(const QString &artist, const QString &album, const QString &title, const bool batch);
@@ -127,8 +129,17 @@ class AlbumCoverFetcher : public QObject {
   void StartRequests();
 
  private:
+  // A fetched cover (including a fetch that found nothing), kept so repeated fetches for the same artist/album answer instantly.
+  struct CachedCoverResult {
+    explicit CachedCoverResult() : timestamp(0) {}
+    AlbumCoverImageResultPtr result;
+    qint64 timestamp;
+  };
+
   void AddRequest(const CoverSearchRequest &req);
 
+  static QString CoverResultCacheKey(const CoverSearchRequest &request);
+
   CoverProviders *cover_providers_;
   NetworkAccessManager *network_;
   quint64 next_id_;
@@ -136,6 +147,12 @@ class AlbumCoverFetcher : public QObject {
   QQueue<CoverSearchRequest> queued_requests_;
   QHash<quint64, AlbumCoverFetcherSearch*> active_requests_;
 
+  QHash<QString, CachedCoverResult> cover_result_cache_;
+  QHash<quint64, QString> fetch_request_keys_;
+  QSet<QString> pending_fetch_keys_;
+  QMultiHash<QString, quint64> waiting_requests_;
+  QSet<quint64> background_refresh_requests_;
+
   QTimer *request_starter_;
 
 };
@@ -38,14 +38,20 @@
 #include <QString>
 #include <QUrl>
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QImage>
 #include <QPainter>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QNetworkDiskCache>
+#include <QNetworkCacheMetaData>
 
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
 #include "core/tagreaderclient.h"
+#include "core/taskmanager.h"
+#include "core/trace.h"
 #include "utilities/mimeutils.h"
 #include "utilities/imageutils.h"
 #include "albumcoverloader.h"
@@ -53,16 +59,22 @@
 #include "albumcoverloaderresult.h"
 #include "albumcoverimageresult.h"
 
+const char *AlbumCoverLoader::kScaledCoverCacheDir = "scaledcovers";
+
 AlbumCoverLoader::AlbumCoverLoader(QObject *parent)
     : QObject(parent),
       network_(new NetworkAccessManager(this)),
+      scaled_cover_cache_(new QNetworkDiskCache(this)),
       stop_requested_(false),
       load_image_async_id_(1),
       save_image_async_id_(1),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      task_manager_(nullptr) {
 
   original_thread_ = thread();
 
+  scaled_cover_cache_->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + kScaledCoverCacheDir);
+
 }
 
 void AlbumCoverLoader::ExitAsync() {
@@ -87,7 +99,14 @@ void AlbumCoverLoader::CancelTask(const quint64 id) {
     TaskPtr task = *it;
     if (task->id == id) {
       tasks_.erase(it);  // clazy:exclude=strict-iterators
-      break;
+      return;
+    }
+  }
+  for (QQueue<TaskPtr>::iterator it = low_priority_tasks_.begin(); it != low_priority_tasks_.end(); ++it) {
+    TaskPtr task = *it;
+    if (task->id == id) {
+      low_priority_tasks_.erase(it);  // clazy:exclude=strict-iterators
+      return;
     }
   }
 
@@ -105,13 +124,23 @@ void AlbumCoverLoader::CancelTasks(const QSet<quint64> &ids) {
       ++it;
     }
   }
+  for (QQueue<TaskPtr>::iterator it = low_priority_tasks_.begin(); it != low_priority_tasks_.end();) {
+    TaskPtr task = *it;
+    if (ids.contains(task->id)) {
+      it = low_priority_tasks_.erase(it);  // clazy:exclude=strict-iterators
+    }
+    else {
+      ++it;
+    }
+  }
 
 }
 
-quint64 AlbumCoverLoader::LoadImageAsync(const AlbumCoverLoaderOptions &options, const Song &song) {
+quint64 AlbumCoverLoader::LoadImageAsync(const AlbumCoverLoaderOptions &options, const Song &song, const Priority priority) {
 
   TaskPtr task = std::make_shared<Task>();
   task->options = options;
+  task->priority = priority;
   task->song = song;
   task->state = State::Manual;
   task->album_cover = std::make_shared<AlbumCoverImageResult>();
@@ -163,7 +192,15 @@ quint64 AlbumCoverLoader::EnqueueTask(TaskPtr task) {
   {
     QMutexLocker l(&mutex_load_image_async_);
     task->id = load_image_async_id_++;
-    tasks_.enqueue(task);
+    if (task->priority == Priority::High) {
+      tasks_.prepend(task);
+    }
+    else if (task->priority == Priority::Low) {
+      low_priority_tasks_.enqueue(task);
+    }
+    else {
+      tasks_.enqueue(task);
+    }
   }
 
   QMetaObject::invokeMethod(this, "ProcessTasks", Qt::QueuedConnection);
@@ -179,8 +216,15 @@ void AlbumCoverLoader::ProcessTasks() {
     TaskPtr task;
     {
       QMutexLocker l(&mutex_load_image_async_);
-      if (tasks_.isEmpty()) return;
-      task = tasks_.dequeue();
+      if (!tasks_.isEmpty()) {
+        task = tasks_.dequeue();
+      }
+      else if (!low_priority_tasks_.isEmpty()) {
+        task = low_priority_tasks_.dequeue();
+      }
+      else {
+        return;
+      }
     }
 
     ProcessTask(task);
@@ -190,6 +234,8 @@ void AlbumCoverLoader::ProcessTasks() {
 
 void AlbumCoverLoader::ProcessTask(TaskPtr task) {
 
+  TRACE_SCOPE("AlbumCoverLoader::ProcessTask");
+
   TryLoadResult result = TryLoadImage(task);
   if (result.started_async) {
     // The image is being loaded from a remote URL, we'll carry on later when it's done
@@ -197,11 +243,18 @@ void AlbumCoverLoader::ProcessTask(TaskPtr task) {
   }
 
   if (result.loaded_success) {
+    if (!task->image_scaled_from_cache.isNull()) {
+      emit AlbumCoverLoaded(task->id, std::make_shared<AlbumCoverLoaderResult>(result.loaded_success, result.type, result.album_cover, task->image_scaled_from_cache, QImage(), task->art_updated));
+      return;
+    }
     result.album_cover->mime_type = Utilities::MimeTypeFromData(result.album_cover->image_data);
     QImage image_scaled;
     QImage image_thumbnail;
     if (task->options.get_image_ && task->options.scale_output_image_) {
       image_scaled = ImageUtils::ScaleAndPad(result.album_cover->image, task->options.scale_output_image_, task->options.pad_output_image_, task->options.desired_height_);
+      if (!image_scaled.isNull() && ScaledCoverCacheable(task, result.album_cover->cover_url)) {
+        SaveScaledCoverToCache(ScaledCoverCacheKey(result.album_cover->cover_url, task->options), image_scaled);
+      }
     }
     if (task->options.get_image_ && task->options.create_thumbnail_) {
       image_thumbnail = ImageUtils::CreateThumbnail(result.album_cover->image, task->options.pad_thumbnail_image_, task->options.thumbnail_size_);
@@ -286,6 +339,13 @@ AlbumCoverLoader::TryLoadResult AlbumCoverLoader::TryLoadImage(TaskPtr task) {
     }
 
     if (cover_url.isLocalFile()) {
+      if (ScaledCoverCacheable(task, cover_url)) {
+        const QImage image_scaled = LoadScaledCoverFromCache(ScaledCoverCacheKey(cover_url, task->options));
+        if (!image_scaled.isNull()) {
+          task->image_scaled_from_cache = image_scaled;
+          return TryLoadResult(false, true, type, std::make_shared<AlbumCoverImageResult>(cover_url));
+        }
+      }
       QFile file(cover_url.toLocalFile());
       if (file.exists()) {
         if (file.open(QIODevice::ReadOnly)) {
@@ -308,6 +368,13 @@ AlbumCoverLoader::TryLoadResult AlbumCoverLoader::TryLoadImage(TaskPtr task) {
       }
     }
     else if (cover_url.scheme().isEmpty()) {  // Assume a local file with no scheme.
+      if (ScaledCoverCacheable(task, cover_url)) {
+        const QImage image_scaled = LoadScaledCoverFromCache(ScaledCoverCacheKey(cover_url, task->options));
+        if (!image_scaled.isNull()) {
+          task->image_scaled_from_cache = image_scaled;
+          return TryLoadResult(false, true, type, std::make_shared<AlbumCoverImageResult>(cover_url));
+        }
+      }
       QFile file(cover_url.path());
       if (file.exists()) {
         if (file.open(QIODevice::ReadOnly)) {
@@ -345,6 +412,55 @@ AlbumCoverLoader::TryLoadResult AlbumCoverLoader::TryLoadImage(TaskPtr task) {
 
 }
 
+bool AlbumCoverLoader::ScaledCoverCacheable(TaskPtr task, const QUrl &cover_url) const {
+
+  // The cache can only short-circuit the decode when the caller wants just the scaled image, and a stale entry can only be detected for cover files on disk.
+  if (!task->options.scale_output_image_ || task->options.get_image_data_ || task->options.create_thumbnail_) return false;
+  if (!cover_url.isLocalFile() && !cover_url.scheme().isEmpty()) return false;
+
+  const QString cover_file = cover_url.isLocalFile() ? cover_url.toLocalFile() : cover_url.path();
+  return !cover_file.isEmpty() && cover_file != Song::kManuallyUnsetCover && cover_file != Song::kEmbeddedCover;
+
+}
+
+QUrl AlbumCoverLoader::ScaledCoverCacheKey(const QUrl &cover_url, const AlbumCoverLoaderOptions &options) const {
+
+  // The modification time is part of the key, so a replaced cover file misses the cache and the stale entry ages out through eviction.
+  const QString cover_file = cover_url.isLocalFile() ? cover_url.toLocalFile() : cover_url.path();
+  const QString cache_key = cover_file + "/" + QString::number(QFileInfo(cover_file).lastModified().toSecsSinceEpoch()) + "/" + QString::number(options.desired_height_) + "/" + QString::number(options.pad_output_image_ ? 1 : 0);
+
+  return QUrl(QUrl::toPercentEncoding(cache_key));
+
+}
+
+QImage AlbumCoverLoader::LoadScaledCoverFromCache(const QUrl &cache_key) const {
+
+  std::unique_ptr<QIODevice> device(scaled_cover_cache_->data(cache_key));
+  if (!device) return QImage();
+
+  QImage image_scaled;
+  image_scaled.load(device.get(), "PNG");
+
+  return image_scaled;
+
+}
+
+void AlbumCoverLoader::SaveScaledCoverToCache(const QUrl &cache_key, const QImage &image_scaled) {
+
+  std::unique_ptr<QIODevice> device(scaled_cover_cache_->data(cache_key));
+  if (device) return;
+
+  QNetworkCacheMetaData metadata;
+  metadata.setSaveToDisk(true);
+  metadata.setUrl(cache_key);
+  QIODevice *device_cache = scaled_cover_cache_->prepare(metadata);
+  if (device_cache) {
+    image_scaled.save(device_cache, "PNG");
+    scaled_cover_cache_->insert(device_cache);
+  }
+
+}
+
 void AlbumCoverLoader::RemoteFetchFinished(QNetworkReply *reply, const QUrl &cover_url) {
 
   reply->deleteLater();
@@ -497,9 +613,7 @@ void AlbumCoverLoader::SaveEmbeddedCover(const quint64 id, const QString &song_f
 void AlbumCoverLoader::SaveEmbeddedCover(const quint64 id, const QList<QUrl> &urls, const QImage &image) {
 
   if (image.isNull()) {
-    for (const QUrl &url : urls) {
-      SaveEmbeddedCover(id, url.toLocalFile(), QByteArray());
-    }
+    SaveEmbeddedCover(id, urls, QByteArray());
     return;
   }
   else {
@@ -542,6 +656,13 @@ void AlbumCoverLoader::SaveEmbeddedCover(const quint64 id, const QList<QUrl> &ur
 
 void AlbumCoverLoader::SaveEmbeddedCover(const quint64 id, const QList<QUrl> &urls, const QByteArray &image_data) {
 
+  // The files are rewritten one by one by the tagreader workers, show the progress for batches so a whole album doesn't look stuck.
+  if (task_manager_ && urls.count() > 1) {
+    const int task_id = task_manager_->StartTask(image_data.isEmpty() ? tr("Clearing embedded covers") : tr("Saving embedded covers"));
+    task_manager_->SetTaskProgress(task_id, 0, urls.count());
+    save_embedded_cover_tasks_.insert(id, task_id);
+  }
+
   for (const QUrl &url : urls) {
     SaveEmbeddedCover(id, url.toLocalFile(), image_data);
   }
@@ -554,7 +675,14 @@ void AlbumCoverLoader::SaveEmbeddedArtFinished(const quint64 id, TagReaderReply
     tagreader_save_embedded_art_requests_.remove(id, reply);
   }
 
+  if (save_embedded_cover_tasks_.contains(id) && task_manager_) {
+    task_manager_->IncreaseTaskProgress(save_embedded_cover_tasks_[id], 1);
+  }
+
   if (!tagreader_save_embedded_art_requests_.contains(id)) {
+    if (save_embedded_cover_tasks_.contains(id) && task_manager_) {
+      task_manager_->SetTaskFinished(save_embedded_cover_tasks_.take(id));
+    }
     emit SaveEmbeddedCoverAsyncFinished(id, reply->is_successful(), cleared);
   }
 
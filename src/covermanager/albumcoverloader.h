@@ -30,6 +30,7 @@
 #include <QPair>
 #include <QSet>
 #include <QHash>
+#include <QMap>
 #include <QMultiMap>
 #include <QQueue>
 #include <QByteArray>
@@ -45,7 +46,9 @@
 
 class QThread;
 class QNetworkReply;
+class QNetworkDiskCache;
 class NetworkAccessManager;
+class TaskManager;
 
 class AlbumCoverLoader : public QObject {
   Q_OBJECT
@@ -59,10 +62,18 @@ class AlbumCoverLoader : public QObject {
     Automatic
   };
 
+  // High priority tasks jump the queue, so the now-playing cover isn't stuck behind a flood of browse-view prefetches.
+  // Low priority tasks only run when nothing else is queued; used for scan-time cover pre-warming.
+  enum class Priority {
+    Low,
+    Normal,
+    High
+  };
+
   void ExitAsync();
   void Stop() { stop_requested_ = true; }
 
-  quint64 LoadImageAsync(const AlbumCoverLoaderOptions &options, const Song &song);
+  quint64 LoadImageAsync(const AlbumCoverLoaderOptions &options, const Song &song, const Priority priority = Priority::Normal);
   quint64 LoadImageAsync(const AlbumCoverLoaderOptions &options, const QUrl &art_automatic, const QUrl &art_manual, const QUrl &song_url = QUrl(), const Song::Source song_source = Song::Source::Unknown);
   quint64 LoadImageAsync(const AlbumCoverLoaderOptions &options, AlbumCoverImageResultPtr album_cover);
   quint64 LoadImageAsync(const AlbumCoverLoaderOptions &options, const QImage &image);
@@ -70,6 +81,9 @@ class AlbumCoverLoader : public QObject {
   void CancelTask(const quint64 id);
   void CancelTasks(const QSet<quint64> &ids);
 
+  // Optional, must be set before the loader is moved to its thread.  Used to show progress for batch embedded cover saves.
+  void set_task_manager(TaskManager *task_manager) { task_manager_ = task_manager; }
+
   quint64 SaveEmbeddedCoverAsync(const QString &song_filename, const QString &cover_filename);
   quint64 SaveEmbeddedCoverAsync(const QString &song_filename, const QImage &image);
   quint64 SaveEmbeddedCoverAsync(const QString &song_filename, const QByteArray &image_data);
@@ -99,13 +113,15 @@ class AlbumCoverLoader : public QObject {
  protected:
 
   struct Task {
-    explicit Task() : id(0), state(State::None), type(AlbumCoverLoaderResult::Type::None), art_updated(false), redirects(0) {}
+    explicit Task() : id(0), priority(Priority::Normal), state(State::None), type(AlbumCoverLoaderResult::Type::None), art_updated(false), redirects(0) {}
 
     AlbumCoverLoaderOptions options;
 
     quint64 id;
+    Priority priority;
     Song song;
     AlbumCoverImageResultPtr album_cover;
+    QImage image_scaled_from_cache;
     State state;
     AlbumCoverLoaderResult::Type type;
     bool art_updated;
@@ -135,23 +151,37 @@ class AlbumCoverLoader : public QObject {
   void NextState(TaskPtr task);
   TryLoadResult TryLoadImage(TaskPtr task);
 
+  // Persistent cache for scaled cover images, so cover-heavy views don't re-decode the full-size image on every launch.
+  // Only usable for tasks that want just the scaled image, and only for cover files on disk.
+  bool ScaledCoverCacheable(TaskPtr task, const QUrl &cover_url) const;
+  QUrl ScaledCoverCacheKey(const QUrl &cover_url, const AlbumCoverLoaderOptions &options) const;
+  QImage LoadScaledCoverFromCache(const QUrl &cache_key) const;
+  void SaveScaledCoverToCache(const QUrl &cache_key, const QImage &image_scaled);
+
   NetworkAccessManager *network_;
+  QNetworkDiskCache *scaled_cover_cache_;
 
   bool stop_requested_;
 
   QMutex mutex_load_image_async_;
   QMutex mutex_save_image_async_;
   QQueue<TaskPtr> tasks_;
+  QQueue<TaskPtr> low_priority_tasks_;
   QHash<QNetworkReply*, TaskPtr> remote_tasks_;
   quint64 load_image_async_id_;
   quint64 save_image_async_id_;
 
   static const int kMaxRedirects = 3;
+  static const char *kScaledCoverCacheDir;
 
   QThread *original_thread_;
 
   QMultiMap<quint64, TagReaderReply*> tagreader_save_embedded_art_requests_;
 
+  TaskManager *task_manager_;
+  // TaskManager task ids for batch embedded cover saves, keyed by the async save id.
+  QMap<quint64, int> save_embedded_cover_tasks_;
+
 };
 
 #endif  // ALBUMCOVERLOADER_H
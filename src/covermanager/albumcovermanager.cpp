@@ -60,6 +60,8 @@
 #include <QKeySequence>
 #include <QSettings>
 #include <QFlags>
+#include <QRect>
+#include <QScrollBar>
 #include <QSize>
 #include <QtEvents>
 
@@ -109,7 +111,7 @@ AlbumCoverManager::AlbumCoverManager(Application *app, CollectionBackend *collec
       cover_fetcher_(new AlbumCoverFetcher(app_->cover_providers(), app_->network(), this)),
       cover_searcher_(nullptr),
       cover_export_(nullptr),
-      cover_exporter_(new AlbumCoverExporter(this)),
+      cover_exporter_(new AlbumCoverExporter(app, this)),
       artist_icon_(IconLoader::Load("folder-sound")),
       all_artists_icon_(IconLoader::Load("library-music")),
       image_nocover_thumbnail_(ImageUtils::GenerateNoCoverImage(QSize(120 * devicePixelRatio(), 120 * devicePixelRatio()))),
@@ -220,6 +222,10 @@ void AlbumCoverManager::Init() {
   QObject::connect(ui_->action_add_to_playlist, &QAction::triggered, this, &AlbumCoverManager::AddSelectedToPlaylist);
   QObject::connect(ui_->action_load, &QAction::triggered, this, &AlbumCoverManager::LoadSelectedToPlaylist);
 
+  // Cover loads are driven by what's visible, queue more as the list is scrolled or relaid out
+  QObject::connect(ui_->albums->verticalScrollBar(), &QScrollBar::valueChanged, this, &AlbumCoverManager::LoadVisibleCovers);
+  QObject::connect(ui_->albums->verticalScrollBar(), &QScrollBar::rangeChanged, this, &AlbumCoverManager::LoadVisibleCovers);
+
   // Restore settings
   QSettings s;
   s.beginGroup(kSettingsGroup);
@@ -319,6 +325,9 @@ void AlbumCoverManager::CancelRequests() {
 #else
   app_->album_cover_loader()->CancelTasks(QSet<quint64>::fromList(cover_loading_tasks_.keys()));
 #endif
+  for (AlbumItem *item : std::as_const(cover_loading_tasks_)) {
+    item->cover_requested = false;
+  }
   cover_loading_tasks_.clear();
   cover_save_tasks_.clear();
   cover_save_tasks2_.clear();
@@ -423,8 +432,6 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
     if (!info.art_automatic.isEmpty() || !info.art_manual.isEmpty()) {
       item->setData(Role_PathAutomatic, info.art_automatic);
       item->setData(Role_PathManual, info.art_manual);
-      quint64 id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options_, info.art_automatic, info.art_manual, info.urls.first());
-      cover_loading_tasks_[id] = item;
     }
 
   }
@@ -433,11 +440,46 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
 
 }
 
+void AlbumCoverManager::LoadVisibleCovers() {
+
+  const QRect viewport_rect = ui_->albums->viewport()->rect();
+  // Prefetch one screenful above and below the viewport
+  const QRect load_rect = viewport_rect.adjusted(0, -viewport_rect.height(), 0, viewport_rect.height());
+
+  // Cancel loads for items that have scrolled well out of view, they are re-queued when scrolled back.
+  QSet<quint64> cancel_ids;
+  for (QMap<quint64, AlbumItem*>::const_iterator it = cover_loading_tasks_.constBegin(); it != cover_loading_tasks_.constEnd(); ++it) {
+    AlbumItem *item = it.value();
+    if (item->isHidden() || !load_rect.intersects(ui_->albums->visualItemRect(item))) {
+      item->cover_requested = false;
+      cancel_ids << it.key();
+    }
+  }
+  if (!cancel_ids.isEmpty()) {
+    app_->album_cover_loader()->CancelTasks(cancel_ids);
+    for (const quint64 id : cancel_ids) cover_loading_tasks_.remove(id);
+  }
+
+  for (int i = 0; i < ui_->albums->count(); ++i) {
+    AlbumItem *item = static_cast<AlbumItem*>(ui_->albums->item(i));
+    if (item->cover_requested || item->cover_loaded || item->isHidden()) continue;
+    const QUrl art_automatic = item->data(Role_PathAutomatic).toUrl();
+    const QUrl art_manual = item->data(Role_PathManual).toUrl();
+    if (art_automatic.isEmpty() && art_manual.isEmpty()) continue;
+    if (!load_rect.intersects(ui_->albums->visualItemRect(item))) continue;
+    item->cover_requested = true;
+    quint64 id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options_, art_automatic, art_manual, item->urls.first());
+    cover_loading_tasks_[id] = item;
+  }
+
+}
+
 void AlbumCoverManager::AlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultPtr result) {
 
   if (!cover_loading_tasks_.contains(id)) return;
 
   AlbumItem *item = cover_loading_tasks_.take(id);
+  item->cover_loaded = true;
 
   if (!result || !result->success || result->image_scaled.isNull() || result->type == AlbumCoverLoaderResult::Type::ManuallyUnset) {
     item->setIcon(icon_nocover_item_);
@@ -486,6 +528,8 @@ void AlbumCoverManager::UpdateFilter() {
   ui_->total_albums->setText(QString::number(total_count));
   ui_->without_cover->setText(QString::number(without_cover));
 
+  LoadVisibleCovers();
+
 }
 
 bool AlbumCoverManager::ShouldHide(const AlbumItem &item, const QString &filter, const HideCovers hide_covers) const {
@@ -690,6 +734,8 @@ void AlbumCoverManager::UpdateCoverInList(AlbumItem *item, const QUrl &cover_url
 
   quint64 id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options_, QUrl(), cover_url);
   item->setData(Role_PathManual, cover_url);
+  item->cover_requested = true;
+  item->cover_loaded = false;
   cover_loading_tasks_[id] = item;
 
 }
@@ -888,7 +934,7 @@ SongList AlbumCoverManager::GetSongsInAlbum(const QModelIndex &idx) const {
   QMutexLocker l(collection_backend_->db()->Mutex());
   QSqlDatabase db(collection_backend_->db()->Connect());
 
-  CollectionQuery q(db, collection_backend_->songs_table(), collection_backend_->fts_table());
+  CollectionQuery q(db, collection_backend_->songs_read_table(), collection_backend_->fts_read_table());
   q.SetColumnSpec("ROWID," + Song::kColumnSpec);
   q.AddWhere("album", idx.data(Role_Album).toString());
   q.SetOrderBy("disc, track, title");
@@ -1065,7 +1111,17 @@ void AlbumCoverManager::UpdateExportStatus(const int exported, const int skipped
 }
 
 bool AlbumCoverManager::ItemHasCover(const AlbumItem &item) const {
-  return item.icon().cacheKey() != icon_nocover_item_.cacheKey();
+
+  // The icon is authoritative once the cover has actually been loaded
+  if (item.icon().cacheKey() != icon_nocover_item_.cacheKey()) return true;
+  if (item.cover_loaded) return false;
+
+  // Not loaded yet (covers load lazily as items become visible), so judge from the stored art paths
+  const QUrl art_manual = item.data(Role_PathManual).toUrl();
+  if (art_manual.path() == Song::kManuallyUnsetCover) return false;
+
+  return !art_manual.isEmpty() || !item.data(Role_PathAutomatic).toUrl().isEmpty();
+
 }
 
 void AlbumCoverManager::SaveEmbeddedCoverAsyncFinished(quint64 id, const bool success) {
@@ -65,8 +65,10 @@ class Ui_CoverManager;
 
 class AlbumItem : public QListWidgetItem {
  public:
-  AlbumItem(const QIcon &icon, const QString &text, QListWidget *parent = nullptr, int type = Type) : QListWidgetItem(icon, text, parent, type) {};
+  AlbumItem(const QIcon &icon, const QString &text, QListWidget *parent = nullptr, int type = Type) : QListWidgetItem(icon, text, parent, type), cover_requested(false), cover_loaded(false) {};
   QList<QUrl> urls;
+  bool cover_requested;
+  bool cover_loaded;
 
  private:
   Q_DISABLE_COPY(AlbumItem)
@@ -153,6 +155,7 @@ class AlbumCoverManager : public QMainWindow {
  private slots:
   void ArtistChanged(QListWidgetItem *current);
   void AlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultPtr result);
+  void LoadVisibleCovers();
   void UpdateFilter();
   void FetchAlbumCovers();
   void ExportCovers();
@@ -25,6 +25,7 @@
 #include <QSize>
 #include <QString>
 #include <QImage>
+#include <QImageReader>
 
 #include "core/song.h"
 #include "core/tagreaderclient.h"
@@ -83,37 +84,37 @@ void CoverExportRunnable::ProcessAndExportCover() {
 
   QString cover_path = GetCoverPath();
 
+  const bool embedded = song_.has_embedded_cover();
+
   // either embedded or disk - the one we'll export for the current album
   QImage cover;
-
-  QImage embedded_cover;
-  QImage disk_cover;
+  QSize cover_size;
 
   // load embedded cover if any
-  if (song_.has_embedded_cover()) {
-    embedded_cover = TagReaderClient::Instance()->LoadEmbeddedArtAsImageBlocking(song_.url().toLocalFile());
+  if (embedded) {
+    cover = TagReaderClient::Instance()->LoadEmbeddedArtAsImageBlocking(song_.url().toLocalFile());
 
-    if (embedded_cover.isNull()) {
+    if (cover.isNull()) {
       EmitCoverSkipped();
       return;
     }
-    cover = embedded_cover;
+    cover_size = cover.size();
   }
-
-  // load a file cover which iss mandatory if there's no embedded cover
-  disk_cover.load(cover_path);
-
-  if (embedded_cover.isNull()) {
-    if (disk_cover.isNull()) {
-      EmitCoverSkipped();
-      return;
+  else {
+    // A file cover is mandatory if there's no embedded cover.
+    // Only the dimensions are needed up front, so read them from the image header and defer the full decode until we know the cover will actually be written.
+    cover_size = QImageReader(cover_path).size();
+    if (!cover_size.isValid()) {
+      if (!cover.load(cover_path)) {
+        EmitCoverSkipped();
+        return;
+      }
+      cover_size = cover.size();
     }
-    cover = disk_cover;
   }
 
-  // rescale if necessary
   if (dialog_result_.IsSizeForced()) {
-    cover = cover.scaled(QSize(dialog_result_.width_, dialog_result_.height_), Qt::IgnoreAspectRatio);
+    cover_size = QSize(dialog_result_.width_, dialog_result_.height_);
   }
 
   QString dir = song_.url().toLocalFile().section('/', 0, -2);
@@ -132,10 +133,9 @@ void CoverExportRunnable::ProcessAndExportCover() {
 
     // if the mode is "overwrite smaller" then skip the cover if a bigger one is already available in the folder
     if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::Smaller) {
-      QImage existing;
-      existing.load(new_file);
+      const QSize existing_size = QImageReader(new_file).size();
 
-      if (existing.isNull() || existing.size().height() >= cover.size().height() || existing.size().width() >= cover.size().width()) {
+      if (!existing_size.isValid() || existing_size.height() >= cover_size.height() || existing_size.width() >= cover_size.width()) {
 
         EmitCoverSkipped();
         return;
@@ -148,6 +148,27 @@ void CoverExportRunnable::ProcessAndExportCover() {
     }
   }
 
+  // No rescaling to do, so the file can be copied as is instead of being decoded and re-encoded.
+  if (!embedded && !dialog_result_.IsSizeForced()) {
+    if (QFile::copy(cover_path, new_file)) {
+      EmitCoverExported();
+    }
+    else {
+      EmitCoverSkipped();
+    }
+    return;
+  }
+
+  if (cover.isNull() && !cover.load(cover_path)) {
+    EmitCoverSkipped();
+    return;
+  }
+
+  // rescale if necessary
+  if (dialog_result_.IsSizeForced()) {
+    cover = cover.scaled(QSize(dialog_result_.width_, dialog_result_.height_), Qt::IgnoreAspectRatio);
+  }
+
   if (cover.save(new_file)) {
     EmitCoverExported();
   }
@@ -25,6 +25,9 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QBuffer>
+#include <QByteArray>
+#include <QCryptographicHash>
 #include <QDir>
 #include <QImage>
 #include <QTemporaryFile>
@@ -36,6 +39,8 @@
 #include "albumcoverloaderresult.h"
 #include "currentalbumcoverloader.h"
 
+const int CurrentAlbumCoverLoader::kMaxTempCoverFiles = 20;
+
 CurrentAlbumCoverLoader::CurrentAlbumCoverLoader(Application *app, QObject *parent)
     : QObject(parent),
       app_(app),
@@ -58,15 +63,54 @@ CurrentAlbumCoverLoader::CurrentAlbumCoverLoader(Application *app, QObject *pare
 
 CurrentAlbumCoverLoader::~CurrentAlbumCoverLoader() {
 
-  if (temp_cover_) temp_cover_->remove();
-  if (temp_cover_thumbnail_) temp_cover_thumbnail_->remove();
+  const QList<std::shared_ptr<QTemporaryFile>> temp_cover_files = temp_cover_files_.values();
+  for (std::shared_ptr<QTemporaryFile> temp_cover_file : temp_cover_files) {  // clazy:exclude=range-loop-reference
+    temp_cover_file->remove();
+  }
+
+}
+
+std::shared_ptr<QTemporaryFile> CurrentAlbumCoverLoader::TempCoverFile(const QByteArray &key) {
+
+  if (!temp_cover_files_.contains(key)) return nullptr;
+
+  temp_cover_files_lru_.removeOne(key);
+  temp_cover_files_lru_ << key;
+
+  return temp_cover_files_.value(key);
+
+}
+
+std::shared_ptr<QTemporaryFile> CurrentAlbumCoverLoader::WriteTempCoverFile(const QByteArray &key, const QByteArray &data) {
+
+  std::shared_ptr<QTemporaryFile> file = std::make_shared<QTemporaryFile>(temp_file_pattern_);
+  file->setAutoRemove(true);
+  if (!file->open()) {
+    qLog(Error) << "Failed to open" << file->fileName() << file->errorString();
+    return nullptr;
+  }
+  if (file->write(data) != data.size() || !file->flush()) {
+    qLog(Error) << "Failed to save cover image to" << file->fileName() << file->errorString();
+    return nullptr;
+  }
+
+  temp_cover_files_.insert(key, file);
+  temp_cover_files_lru_ << key;
+  while (temp_cover_files_lru_.count() > kMaxTempCoverFiles) {
+    temp_cover_files_.remove(temp_cover_files_lru_.takeFirst());
+  }
+
+  return file;
 
 }
 
 void CurrentAlbumCoverLoader::LoadAlbumCover(const Song &song) {
 
+  // A request still queued for the previous track is superseded now, drop it instead of letting it run first.
+  if (id_ != 0) app_->album_cover_loader()->CancelTask(id_);
+
   last_song_ = song;
-  id_ = app_->album_cover_loader()->LoadImageAsync(options_, last_song_);
+  id_ = app_->album_cover_loader()->LoadImageAsync(options_, last_song_, AlbumCoverLoader::Priority::High);
 
 }
 
@@ -76,35 +120,49 @@ void CurrentAlbumCoverLoader::TempAlbumCoverLoaded(const quint64 id, AlbumCoverL
   id_ = 0;
 
   if (result && !result->album_cover->image.isNull()) {
-    temp_cover_ = std::make_unique<QTemporaryFile>(temp_file_pattern_);
-    temp_cover_->setAutoRemove(true);
-    if (temp_cover_->open()) {
-      if (result->album_cover->image.save(temp_cover_->fileName(), "JPEG")) {
-        result->temp_cover_url = QUrl::fromLocalFile(temp_cover_->fileName());
-      }
-      else {
-        qLog(Error) << "Failed to save cover image to" << temp_cover_->fileName() << temp_cover_->errorString();
+    // This runs on the GUI thread right at the track change, and re-encoding a full size cover to JPEG
+    // is slow enough to cause a visible hiccup, so when the cover already is a JPEG its original bytes
+    // are written out as they are and the encoder is only used as a fallback.
+    QByteArray cover_data;
+    if (result->album_cover->is_jpeg()) {
+      cover_data = result->album_cover->image_data;
+    }
+    else {
+      QBuffer buffer(&cover_data);
+      if (buffer.open(QIODevice::WriteOnly)) {
+        result->album_cover->image.save(&buffer, "JPEG");
       }
     }
+    if (cover_data.isEmpty()) {
+      qLog(Error) << "Failed to encode cover image for" << last_song_.effective_albumartist() << last_song_.effective_album();
+    }
     else {
-      qLog(Error) << "Failed to open" << temp_cover_->fileName() << temp_cover_->errorString();
+      const QByteArray cover_key = QCryptographicHash::hash(cover_data, QCryptographicHash::Sha1) + "-cover";
+      std::shared_ptr<QTemporaryFile> temp_cover = TempCoverFile(cover_key);
+      if (!temp_cover) temp_cover = WriteTempCoverFile(cover_key, cover_data);
+      if (temp_cover) {
+        result->temp_cover_url = QUrl::fromLocalFile(temp_cover->fileName());
+      }
     }
   }
 
   QUrl thumbnail_url;
   if (result && !result->image_thumbnail.isNull()) {
-    temp_cover_thumbnail_ = std::make_unique<QTemporaryFile>(temp_file_pattern_);
-    temp_cover_thumbnail_->setAutoRemove(true);
-    if (temp_cover_thumbnail_->open()) {
-      if (result->image_thumbnail.save(temp_cover_thumbnail_->fileName(), "JPEG")) {
-        thumbnail_url = QUrl::fromLocalFile(temp_cover_thumbnail_->fileName());
-      }
-      else {
-        qLog(Error) << "Unable to save cover thumbnail image to" << temp_cover_thumbnail_->fileName();
-      }
+    QByteArray thumbnail_data;
+    QBuffer buffer(&thumbnail_data);
+    if (buffer.open(QIODevice::WriteOnly)) {
+      result->image_thumbnail.save(&buffer, "JPEG");
+    }
+    if (thumbnail_data.isEmpty()) {
+      qLog(Error) << "Failed to encode cover thumbnail image for" << last_song_.effective_albumartist() << last_song_.effective_album();
     }
     else {
-      qLog(Error) << "Unable to open" << temp_cover_thumbnail_->fileName();
+      const QByteArray thumbnail_key = QCryptographicHash::hash(thumbnail_data, QCryptographicHash::Sha1) + "-thumbnail";
+      std::shared_ptr<QTemporaryFile> temp_cover_thumbnail = TempCoverFile(thumbnail_key);
+      if (!temp_cover_thumbnail) temp_cover_thumbnail = WriteTempCoverFile(thumbnail_key, thumbnail_data);
+      if (temp_cover_thumbnail) {
+        thumbnail_url = QUrl::fromLocalFile(temp_cover_thumbnail->fileName());
+      }
     }
   }
 
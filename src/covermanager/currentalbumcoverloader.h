@@ -28,6 +28,9 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
 #include <QString>
 #include <QImage>
 #include <QTemporaryFile>
@@ -59,13 +62,21 @@ class CurrentAlbumCoverLoader : public QObject {
   void TempAlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultPtr result);
 
  private:
+  // The exported temp files are keyed by a hash of the cover content, so consecutive tracks from the same album reuse
+  // the files written for the previous track instead of rewriting identical bytes on every transition.
+  std::shared_ptr<QTemporaryFile> TempCoverFile(const QByteArray &key);
+  std::shared_ptr<QTemporaryFile> WriteTempCoverFile(const QByteArray &key, const QByteArray &data);
+
+ private:
+  static const int kMaxTempCoverFiles;
+
   Application *app_;
   AlbumCoverLoaderOptions options_;
 
   QString temp_file_pattern_;
 
-  std::unique_ptr<QTemporaryFile> temp_cover_;
-  std::unique_ptr<QTemporaryFile> temp_cover_thumbnail_;
+  QHash<QByteArray, std::shared_ptr<QTemporaryFile>> temp_cover_files_;
+  QList<QByteArray> temp_cover_files_lru_;  // least recently used first
   quint64 id_;
 
   Song last_song_;
@@ -96,6 +96,7 @@ bool DeezerCoverProvider::StartSearch(const QString &artist, const QString &albu
   url.setQuery(url_query);
   QNetworkRequest req(url);
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, id]() { HandleSearchReply(reply, id); });
@@ -53,6 +53,8 @@ const char *DiscogsCoverProvider::kUrlSearch = "https://api.discogs.com/database
 const char *DiscogsCoverProvider::kAccessKeyB64 = "dGh6ZnljUGJlZ1NEeXBuSFFxSVk=";
 const char *DiscogsCoverProvider::kSecretKeyB64 = "ZkFIcmlaSER4aHhRSlF2U3d0bm5ZVmdxeXFLWUl0UXI=";
 const int DiscogsCoverProvider::kRequestsDelay = 1000;
+// Discogs rate limits aggressively, keep responses for a week so re-fetch storms after a cache clear are served locally.
+const int DiscogsCoverProvider::kCacheTtlSecs = 7 * 24 * 60 * 60;
 
 DiscogsCoverProvider::DiscogsCoverProvider(Application *app, NetworkAccessManager *network, QObject *parent)
     : JsonCoverProvider("Discogs", false, false, 0.0, false, false, app, network, parent),
@@ -168,6 +170,7 @@ QNetworkReply *DiscogsCoverProvider::CreateRequest(QUrl url, const ParamList &pa
 
   QNetworkRequest req(url);
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+  NetworkAccessManager::SetCacheTtl(&req, kCacheTtlSecs);
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
 
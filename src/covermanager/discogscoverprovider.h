@@ -95,6 +95,7 @@ class DiscogsCoverProvider : public JsonCoverProvider {
   static const char *kAccessKeyB64;
   static const char *kSecretKeyB64;
   static const int kRequestsDelay;
+  static const int kCacheTtlSecs;
 
   QTimer *timer_flush_requests_;
   QQueue<std::shared_ptr<DiscogsCoverSearchContext>> queue_search_requests_;
@@ -39,6 +39,9 @@ class JsonCoverProvider : public CoverProvider {
   explicit JsonCoverProvider(const QString &name, const bool enabled, const bool authentication_required, const float quality, const bool batch, const bool allow_missing_album, Application *app, NetworkAccessManager *network, QObject *parent);
 
  protected:
+  // Default TTL for caching provider API responses, see NetworkAccessManager::SetCacheTtl().
+  static const int kDefaultSearchCacheTtlSecs = 24 * 60 * 60;
+
   QJsonObject ExtractJsonObj(const QByteArray &data);
 };
 
@@ -99,6 +99,7 @@ void MusicbrainzCoverProvider::SendSearchRequest(const SearchRequest &request) {
   url.setQuery(url_query);
   QNetworkRequest req(url);
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { HandleSearchReply(reply, request.id); });
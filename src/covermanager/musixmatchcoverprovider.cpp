@@ -70,6 +70,7 @@ bool MusixmatchCoverProvider::StartSearch(const QString &artist, const QString &
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
   req.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
 #endif
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, id, artist, album]() { HandleSearchReply(reply, id, artist, album); });
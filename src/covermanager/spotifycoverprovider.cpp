@@ -393,6 +393,7 @@ bool SpotifyCoverProvider::StartSearch(const QString &artist, const QString &alb
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
   req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
   req.setRawHeader("Authorization", "Bearer " + access_token_.toUtf8());
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
 
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
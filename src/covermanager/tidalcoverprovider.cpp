@@ -98,6 +98,7 @@ bool TidalCoverProvider::StartSearch(const QString &artist, const QString &album
   req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
   if (service_->oauth() && !service_->access_token().isEmpty()) req.setRawHeader("authorization", "Bearer " + service_->access_token().toUtf8());
   else if (!service_->session_id().isEmpty()) req.setRawHeader("X-Tidal-SessionId", service_->session_id().toUtf8());
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
 
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
@@ -27,6 +27,7 @@
 #include <glib-object.h>
 
 #include <QtGlobal>
+#include <QtConcurrent>
 #include <QObject>
 #include <QMutex>
 #include <QByteArray>
@@ -50,7 +51,11 @@ CddaSongLoader::CddaSongLoader(const QUrl &url, QObject *parent)
       cdio_(nullptr) {}
 
 CddaSongLoader::~CddaSongLoader() {
+
+  // Wait for a load on the worker thread to finish before tearing down the cdio handle.
+  QMutexLocker locker(&mutex_load_);
   if (cdio_) cdio_destroy(cdio_);
+
 }
 
 QUrl CddaSongLoader::GetUrlFromTrack(int track_number) const {
@@ -66,6 +71,17 @@ QUrl CddaSongLoader::GetUrlFromTrack(int track_number) const {
 
 void CddaSongLoader::LoadSongs() {
 
+  // The load blocks on drive spin-up and the gstreamer bus for seconds, so it runs on a worker thread and the results arrive through the signals.
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  (void)QtConcurrent::run(&CddaSongLoader::LoadSongsBlocking, this);
+#else
+  (void)QtConcurrent::run(this, &CddaSongLoader::LoadSongsBlocking);
+#endif
+
+}
+
+void CddaSongLoader::LoadSongsBlocking() {
+
   QMutexLocker locker(&mutex_load_);
   cdio_ = cdio_open(url_.path().toLocal8Bit().constData(), DRIVER_DEVICE);
   if (cdio_ == nullptr) {
@@ -154,15 +170,32 @@ void CddaSongLoader::LoadSongs() {
   // Get TOC and TAG messages
   GstMessage *msg = nullptr;
   GstMessage *msg_toc = nullptr;
-  GstMessage *msg_tag = nullptr;
+#ifdef HAVE_MUSICBRAINZ
+  bool discid_requested = false;
+#endif
   while ((msg = gst_bus_timed_pop_filtered(GST_ELEMENT_BUS(pipeline), GST_SECOND, static_cast<GstMessageType>(GST_MESSAGE_TOC | GST_MESSAGE_TAG)))) {
     if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TOC) {
       if (msg_toc) gst_message_unref(msg_toc);  // Shouldn't happen, but just in case
       msg_toc = msg;
     }
     else if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_TAG) {
-      if (msg_tag) gst_message_unref(msg_tag);
-      msg_tag = msg;
+#ifdef HAVE_MUSICBRAINZ
+      // Start the MusicBrainz lookup as soon as the discid tag arrives, concurrently with waiting for the rest of the bus messages.
+      if (!discid_requested) {
+        GstTagList *tags = nullptr;
+        gst_message_parse_tag(msg, &tags);
+        char *string_mb = nullptr;
+        if (gst_tag_list_get_string(tags, GST_TAG_CDDA_MUSICBRAINZ_DISCID, &string_mb)) {
+          const QString musicbrainz_discid(string_mb);
+          qLog(Info) << "MusicBrainz discid: " << musicbrainz_discid;
+          QMetaObject::invokeMethod(this, "StartMusicBrainzRequest", Qt::QueuedConnection, Q_ARG(QString, musicbrainz_discid));
+          g_free(string_mb);
+          discid_requested = true;
+        }
+        if (tags) gst_tag_list_unref(tags);
+      }
+#endif
+      gst_message_unref(msg);
     }
   }
 
@@ -187,26 +220,6 @@ void CddaSongLoader::LoadSongs() {
   }
   emit SongsDurationLoaded(songs);
 
-#ifdef HAVE_MUSICBRAINZ
-  // Handle TAG message: generate MusicBrainz DiscId
-  if (msg_tag) {
-    GstTagList *tags = nullptr;
-    gst_message_parse_tag(msg_tag, &tags);
-    char *string_mb = nullptr;
-    if (gst_tag_list_get_string(tags, GST_TAG_CDDA_MUSICBRAINZ_DISCID, &string_mb)) {
-      QString musicbrainz_discid(string_mb);
-      qLog(Info) << "MusicBrainz discid: " << musicbrainz_discid;
-
-      MusicBrainzClient *musicbrainz_client = new MusicBrainzClient(network_);
-      QObject::connect(musicbrainz_client, &MusicBrainzClient::DiscIdFinished, this, &CddaSongLoader::AudioCDTagsLoaded);
-      musicbrainz_client->StartDiscIdRequest(musicbrainz_discid);
-      g_free(string_mb);
-      gst_message_unref(msg_tag);
-      gst_tag_list_unref(tags);
-    }
-  }
-#endif
-
   gst_element_set_state(pipeline, GST_STATE_NULL);
   // This will also cause cdda_ to be unref'd.
   gst_object_unref(pipeline);
@@ -214,6 +227,14 @@ void CddaSongLoader::LoadSongs() {
 }
 
 #ifdef HAVE_MUSICBRAINZ
+void CddaSongLoader::StartMusicBrainzRequest(const QString &musicbrainz_discid) {
+
+  MusicBrainzClient *musicbrainz_client = new MusicBrainzClient(network_);
+  QObject::connect(musicbrainz_client, &MusicBrainzClient::DiscIdFinished, this, &CddaSongLoader::AudioCDTagsLoaded);
+  musicbrainz_client->StartDiscIdRequest(musicbrainz_discid);
+
+}
+
 void CddaSongLoader::AudioCDTagsLoaded(const QString &artist, const QString &album, const MusicBrainzClient::ResultList &results) {
 
   MusicBrainzClient *musicbrainz_client = qobject_cast<MusicBrainzClient*>(sender());
@@ -51,10 +51,12 @@ class CddaSongLoader : public QObject {
   ~CddaSongLoader() override;
 
   // Load songs. Signals declared below will be emitted anytime new information will be available.
+  // Returns immediately, the loading itself blocks on drive spin-up and runs on a worker thread.
   void LoadSongs();
   bool HasChanged();
 
  private:
+  void LoadSongsBlocking();
   void Error(const QString &error);
   QUrl GetUrlFromTrack(const int track_number) const;
 
@@ -66,6 +68,8 @@ class CddaSongLoader : public QObject {
 
  private slots:
 #ifdef HAVE_MUSICBRAINZ
+  // Invoked from the worker thread with a queued connection, because the client needs this thread's event loop for its replies.
+  void StartMusicBrainzRequest(const QString &musicbrainz_discid);
   void AudioCDTagsLoaded(const QString &artist, const QString &album, const MusicBrainzClient::ResultList &results);
 #endif
 
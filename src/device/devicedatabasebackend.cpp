@@ -35,7 +35,9 @@
 #include "core/scopedtransaction.h"
 #include "devicedatabasebackend.h"
 
-const int DeviceDatabaseBackend::kDeviceSchemaVersion = 3;
+// Device tables older than this are dropped and recreated on connect.
+// Version 5 covers tables created without the ReplayGain columns, which all SQL built from Song::kColumnSpec depends on.
+const int DeviceDatabaseBackend::kDeviceSchemaVersion = 5;
 
 DeviceDatabaseBackend::DeviceDatabaseBackend(QObject *parent)
     : QObject(parent),
@@ -208,6 +210,16 @@ void DeviceDatabaseBackend::RemoveDevice(const int id) {
     }
   }
 
+  // Remove the materialized count tables for the device.  The triggers maintaining them go away with the songs table.
+  for (const QString &suffix : QStringList() << "counts" << "artists" << "albums") {
+    SqlQuery q(db);
+    q.prepare(QString("DROP TABLE IF EXISTS device_%1_songs_%2").arg(id).arg(suffix));
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
   t.Commit();
 
 }
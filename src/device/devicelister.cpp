@@ -63,7 +63,8 @@ void DeviceLister::Start() {
   QObject::connect(thread_, &QThread::started, this, &DeviceLister::ThreadStarted);
 
   moveToThread(thread_);
-  thread_->start();
+  // Init() does blocking bus enumeration when the thread starts, keep it out of the way of the startup work.
+  thread_->start(QThread::LowPriority);
   qLog(Debug) << this << "moved to thread" << thread_;
 
 }
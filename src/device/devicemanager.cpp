@@ -87,7 +87,8 @@ const int DeviceManager::kDeviceIconOverlaySize = 16;
 DeviceManager::DeviceManager(Application *app, QObject *parent)
     : SimpleTreeModel<DeviceInfo>(new DeviceInfo(this), parent),
       app_(app),
-      not_connected_overlay_(IconLoader::Load("edit-delete")) {
+      not_connected_overlay_(IconLoader::Load("edit-delete")),
+      deferred_listers_started_(false) {
 
   thread_pool_.setMaxThreadCount(1);
   QObject::connect(app_->task_manager(), &TaskManager::TasksChanged, this, &DeviceManager::TasksChanged);
@@ -110,19 +111,13 @@ DeviceManager::DeviceManager(Application *app, QObject *parent)
   connected_devices_model_ = new DeviceStateFilterModel(this);
   connected_devices_model_->setSourceModel(this);
 
-// CD devices are detected via the DiskArbitration framework instead on MacOs.
-#if defined(HAVE_AUDIOCD) && defined(HAVE_GSTREAMER) && !defined(Q_OS_MACOS)
-  AddLister(new CddaLister);
-#endif
+  // The CDDA and MTP listers poll hardware when they initialize and are deferred until the devices view is first shown, see StartDeferredListers().
 #if defined(HAVE_DBUS) && defined(HAVE_UDISKS2)
   AddLister(new Udisks2Lister);
 #endif
 #ifdef HAVE_GIO
   AddLister(new GioLister);
 #endif
-#if defined(Q_OS_MACOS) and defined(HAVE_LIBMTP)
-  AddLister(new MacOsDeviceLister);
-#endif
 
 #if defined(HAVE_AUDIOCD) && defined(HAVE_GSTREAMER)
   AddDeviceClass<CddaDevice>();
@@ -389,6 +384,21 @@ QVariant DeviceManager::data(const QModelIndex &idx, int role) const {
 
 }
 
+void DeviceManager::StartDeferredListers() {
+
+  if (deferred_listers_started_) return;
+  deferred_listers_started_ = true;
+
+// CD devices are detected via the DiskArbitration framework instead on MacOs.
+#if defined(HAVE_AUDIOCD) && defined(HAVE_GSTREAMER) && !defined(Q_OS_MACOS)
+  AddLister(new CddaLister);
+#endif
+#if defined(Q_OS_MACOS) and defined(HAVE_LIBMTP)
+  AddLister(new MacOsDeviceLister);
+#endif
+
+}
+
 void DeviceManager::AddLister(DeviceLister *lister) {
 
   listers_ << lister;
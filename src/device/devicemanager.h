@@ -112,6 +112,9 @@ class DeviceManager : public SimpleTreeModel<DeviceInfo> {
 
   void SetDeviceOptions(const QModelIndex &idx, const QString &friendly_name, const QString &icon_name, const MusicStorage::TranscodeMode mode, const Song::FileType format);
 
+  // Starts the listers that poll hardware when they initialize. Called when the devices view is first shown so they don't slow down startup.
+  void StartDeferredListers();
+
   // QAbstractItemModel
   QVariant data(const QModelIndex &idx, int role = Qt::DisplayRole) const override;
 
@@ -162,6 +165,8 @@ class DeviceManager : public SimpleTreeModel<DeviceInfo> {
   QList<DeviceLister*> listers_;
   QList<DeviceInfo*> devices_;
 
+  bool deferred_listers_started_;
+
   QMultiMap<QString, QMetaObject> device_classes_;
 
   // Map of task ID to device index
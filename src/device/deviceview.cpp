@@ -357,6 +357,15 @@ void DeviceView::Properties() {
   properties_dialog_->ShowDevice(MapToDevice(menu_index_));
 }
 
+void DeviceView::showEvent(QShowEvent *e) {
+
+  AutoExpandingTreeView::showEvent(e);
+
+  // The listers that poll hardware are only started once someone actually looks at the devices view.
+  if (app_) app_->device_manager()->StartDeferredListers();
+
+}
+
 void DeviceView::mouseDoubleClickEvent(QMouseEvent *e) {
 
   AutoExpandingTreeView::mouseDoubleClickEvent(e);
@@ -43,6 +43,7 @@ class QMenu;
 class QAction;
 class QMouseEvent;
 class QContextMenuEvent;
+class QShowEvent;
 
 class Application;
 class DeviceProperties;
@@ -76,6 +77,7 @@ class DeviceView : public AutoExpandingTreeView {
  protected:
   void contextMenuEvent(QContextMenuEvent*) override;
   void mouseDoubleClickEvent(QMouseEvent *e) override;
+  void showEvent(QShowEvent *e) override;
 
  private slots:
   // Device menu actions
@@ -61,6 +61,8 @@ FilesystemDevice::FilesystemDevice(const QUrl &url, DeviceLister *lister, const
   QObject::connect(watcher_, &CollectionWatcher::SongsReadded, backend_, &CollectionBackend::MarkSongsUnavailable);
   QObject::connect(watcher_, &CollectionWatcher::SubdirsDiscovered, backend_, &CollectionBackend::AddOrUpdateSubdirs);
   QObject::connect(watcher_, &CollectionWatcher::SubdirsMTimeUpdated, backend_, &CollectionBackend::AddOrUpdateSubdirs);
+  QObject::connect(watcher_, &CollectionWatcher::SubdirsCheckpointed, backend_, &CollectionBackend::AddFullScanCheckpoints);
+  QObject::connect(watcher_, &CollectionWatcher::FullScanCompleted, backend_, &CollectionBackend::ClearFullScanCheckpoints);
   QObject::connect(watcher_, &CollectionWatcher::CompilationsNeedUpdating, backend_, &CollectionBackend::CompilationsNeedUpdating);
   QObject::connect(watcher_, &CollectionWatcher::UpdateLastSeen, backend_, &CollectionBackend::UpdateLastSeen);
   QObject::connect(watcher_, &CollectionWatcher::ScanStarted, this, &FilesystemDevice::TaskStarted);
@@ -89,6 +89,11 @@ GPodDevice::~GPodDevice() {
 
 void GPodDevice::ConnectAsync() {
 
+  if (!first_time_) {
+    // The songs from the previous connect are still in the device table, so attach the cached model right away and let the loader reconcile in the background.
+    emit DeviceConnectFinished(unique_id_, true);
+  }
+
   loader_thread_->start();
 
 }
@@ -125,7 +130,8 @@ void GPodDevice::LoadFinished(Itdb_iTunesDB *db, const bool success) {
   if (closing_) {
     ConnectedDevice::Close();
   }
-  else {
+  else if (first_time_ || !success) {
+    // When the cached model was attached in ConnectAsync() the view already shows this device, so only failures need reporting here.
     emit DeviceConnectFinished(unique_id_, success);
   }
 
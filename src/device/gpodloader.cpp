@@ -27,7 +27,9 @@
 #include <QObject>
 #include <QDir>
 #include <QByteArray>
+#include <QMap>
 #include <QString>
+#include <QUrl>
 
 #include "collection/collectionbackend.h"
 #include "core/logging.h"
@@ -101,12 +103,31 @@ Itdb_iTunesDB *GPodLoader::TryLoad() {
     songs << song;
   }
 
-  // Need to remove all the existing songs in the database first
-  backend_->DeleteSongs(backend_->FindSongsInDirectory(1));
-
   if (!abort_) {
-    // Add the songs we've just loaded
-    backend_->AddOrUpdateSongs(songs);
+    // Reconcile against the songs stored by the previous connect instead of deleting and rewriting the whole device table.
+    // On an unchanged iPod the connect becomes a read-only pass over the database.
+    const SongList previous_songs = backend_->FindSongsInDirectory(1);
+    QMap<QUrl, Song> previous_songs_by_url;
+    for (const Song &previous_song : previous_songs) {
+      previous_songs_by_url.insert(previous_song.url(), previous_song);
+    }
+
+    SongList songs_to_update;
+    for (Song &song : songs) {
+      if (previous_songs_by_url.contains(song.url())) {
+        const Song previous_song = previous_songs_by_url.take(song.url());
+        if (song.IsMetadataEqual(previous_song)) continue;
+        // Take over the row of the previous song so this becomes an update instead of a duplicate insert.
+        song.set_id(previous_song.id());
+      }
+      songs_to_update << song;
+    }
+
+    // Whatever is left was not seen on the device this time.
+    const SongList songs_to_delete = previous_songs_by_url.values();
+
+    if (!songs_to_delete.isEmpty()) backend_->DeleteSongs(songs_to_delete);
+    if (!songs_to_update.isEmpty()) backend_->AddOrUpdateSongs(songs_to_update);
   }
 
   // This is done in the loader thread so close the unique DB connection.
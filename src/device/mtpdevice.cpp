@@ -93,6 +93,11 @@ bool MtpDevice::Init() {
 
 void MtpDevice::ConnectAsync() {
 
+  if (!first_time_) {
+    // The songs from the previous connect are still in the device table, so attach the cached model right away and let the loader reconcile in the background.
+    emit DeviceConnectFinished(unique_id_, true);
+  }
+
   db_busy_.lock();
   loader_thread_->start();
 
@@ -122,7 +127,8 @@ void MtpDevice::LoadFinished(const bool success, MtpConnection *connection) {
   if (closing_) {
     ConnectedDevice::Close();
   }
-  else {
+  else if (first_time_ || !success) {
+    // When the cached model was attached in ConnectAsync() the view already shows this device, so only failures need reporting here.
     emit DeviceConnectFinished(unique_id_, success);
   }
 
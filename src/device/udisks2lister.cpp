@@ -37,6 +37,7 @@
 #include <QDBusObjectPath>
 #include <QDBusConnection>
 #include <QDBusError>
+#include <QDBusMessage>
 #include <QDBusPendingReply>
 #include <QDBusArgument>
 #include <QJsonArray>
@@ -47,7 +48,6 @@
 #include "udisks2lister.h"
 
 #include "objectmanager.h"
-#include "udisks2block.h"
 #include "udisks2drive.h"
 #include "udisks2filesystem.h"
 #include "udisks2job.h"
@@ -191,7 +191,13 @@ bool Udisks2Lister::Init() {
     return false;
   }
 
-  QList<QDBusObjectPath> paths = reply.value().keys();
+  // The reply already carries every interface and property of every object, so enumeration needs no further D-Bus calls.
+  const ManagedObjectList objects = reply.value();
+  for (auto it = objects.constBegin(); it != objects.constEnd(); ++it) {
+    object_cache_[it.key()] = it.value();
+  }
+
+  const QList<QDBusObjectPath> paths = objects.keys();
   for (const QDBusObjectPath &path : paths) {
     PartitionData partition_data = ReadPartitionData(path);
 
@@ -215,6 +221,11 @@ bool Udisks2Lister::Init() {
 
 void Udisks2Lister::DBusInterfaceAdded(const QDBusObjectPath &path, const InterfacesAndProperties &interfaces) {
 
+  // Merge into the local object cache so device properties can be read without going back to D-Bus.
+  for (auto interface = interfaces.constBegin(); interface != interfaces.constEnd(); ++interface) {
+    object_cache_[path][interface.key()] = interface.value();
+  }
+
   for (auto interface = interfaces.constBegin(); interface != interfaces.constEnd(); ++interface) {
 
     if (interface.key() != "org.freedesktop.UDisks2.Job") continue;
@@ -253,8 +264,16 @@ void Udisks2Lister::DBusInterfaceAdded(const QDBusObjectPath &path, const Interf
 }
 
 void Udisks2Lister::DBusInterfaceRemoved(const QDBusObjectPath &path, const QStringList &interfaces) {
-  Q_UNUSED(interfaces);
+
+  if (object_cache_.contains(path)) {
+    for (const QString &interface : interfaces) {
+      object_cache_[path].remove(interface);
+    }
+    if (object_cache_[path].isEmpty()) object_cache_.remove(path);
+  }
+
   if (!isPendingJob(path)) RemoveDevice(path);
+
 }
 
 bool Udisks2Lister::isPendingJob(const QDBusObjectPath &job_path) {
@@ -318,7 +337,7 @@ void Udisks2Lister::JobCompleted(const bool success, const QString &message) {
   qLog(Debug) << "Pending Job Completed | Path = " << job->path() << " | Mount? = " << mounting_jobs_[jobPath].is_mount << " | Success = " << success;
 
   for (const auto &mounted_object : mounting_jobs_[jobPath].mounted_partitions) {
-    auto partition_data = ReadPartitionData(mounted_object);
+    auto partition_data = ReadPartitionData(mounted_object, true);
     if (partition_data.dbus_path.isEmpty()) continue;
 
     mounting_jobs_[jobPath].is_mount ? HandleFinishedMountJob(partition_data) : HandleFinishedUnmountJob(partition_data, mounted_object);
@@ -357,51 +376,90 @@ void Udisks2Lister::HandleFinishedUnmountJob(const PartitionData &partition_data
 
 }
 
-Udisks2Lister::PartitionData Udisks2Lister::ReadPartitionData(const QDBusObjectPath &path) {
+Udisks2Lister::PartitionData Udisks2Lister::ReadPartitionData(const QDBusObjectPath &path, const bool refresh_mount_points) {
 
   PartitionData result;
-  OrgFreedesktopUDisks2FilesystemInterface filesystem(udisks2_service_, path.path(), QDBusConnection::systemBus());
-  OrgFreedesktopUDisks2BlockInterface block(udisks2_service_, path.path(), QDBusConnection::systemBus());
 
-  if (filesystem.isValid() && block.isValid() && !filesystem.mountPoints().empty()) {
-    OrgFreedesktopUDisks2DriveInterface drive(udisks2_service_, block.drive().path(), QDBusConnection::systemBus());
+  if (!object_cache_.contains(path)) return result;
+  const InterfacesAndProperties interfaces = object_cache_[path];
+  if (!interfaces.contains("org.freedesktop.UDisks2.Filesystem") || !interfaces.contains("org.freedesktop.UDisks2.Block")) return result;
 
-    if (drive.isValid() && drive.mediaRemovable()) {
-      result.dbus_path = path.path();
-      result.dbus_drive_path = block.drive().path();
+  const QVariantMap filesystem = InterfaceProperties(path, "org.freedesktop.UDisks2.Filesystem", refresh_mount_points);
+  const QStringList mount_paths = MountPointsFromProperty(filesystem["MountPoints"]);
+  if (mount_paths.isEmpty()) return result;
 
-      result.serial = drive.serial();
-      result.vendor = drive.vendor();
-      result.model = drive.model();
+  const QVariantMap block = interfaces["org.freedesktop.UDisks2.Block"];
+  const QDBusObjectPath drive_path = qvariant_cast<QDBusObjectPath>(block["Drive"]);
+  const QVariantMap drive = InterfaceProperties(drive_path, "org.freedesktop.UDisks2.Drive");
+  if (drive.isEmpty() || !drive["MediaRemovable"].toBool()) return result;
 
-      result.label = block.idLabel();
-      result.uuid = block.idUUID();
-      result.capacity = drive.size();
+  result.dbus_path = path.path();
+  result.dbus_drive_path = drive_path.path();
 
-      if (result.label.isEmpty()) {
-        result.friendly_name = result.model + " " + result.uuid;
-      }
-      else {
-        result.friendly_name = result.label;
-      }
+  result.serial = drive["Serial"].toString();
+  result.vendor = drive["Vendor"].toString();
+  result.model = drive["Model"].toString();
 
-      for (const QByteArray &p : filesystem.mountPoints()) {
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)  // Workaround a bytearray to string conversion issue with Qt 6
-        QString mountpoint = QByteArray(p.data(), static_cast<qint64>(strlen(p.data())));
-#else
-        QString mountpoint = p;
-#endif
-        result.mount_paths.push_back(mountpoint);
-      }
+  result.label = block["IdLabel"].toString();
+  result.uuid = block["IdUUID"].toString();
+  result.capacity = drive["Size"].toULongLong();
 
-      result.free_space = Utilities::FileSystemFreeSpace(result.mount_paths.at(0));
-    }
+  if (result.label.isEmpty()) {
+    result.friendly_name = result.model + " " + result.uuid;
+  }
+  else {
+    result.friendly_name = result.label;
   }
 
+  result.mount_paths = mount_paths;
+  result.free_space = Utilities::FileSystemFreeSpace(result.mount_paths.at(0));
+
   return result;
 
 }
 
+QVariantMap Udisks2Lister::InterfaceProperties(const QDBusObjectPath &path, const QString &interface, const bool refresh) {
+
+  if (!refresh && object_cache_.contains(path) && object_cache_[path].contains(interface)) {
+    return object_cache_[path][interface];
+  }
+
+  QDBusMessage message = QDBusMessage::createMethodCall(udisks2_service_, path.path(), "org.freedesktop.DBus.Properties", "GetAll");
+  message << interface;
+  QDBusPendingReply<QVariantMap> reply = QDBusConnection::systemBus().asyncCall(message);
+  reply.waitForFinished();
+
+  if (!reply.isValid()) {
+    qLog(Warning) << "Error getting properties of" << interface << "on" << path.path() << ":" << reply.error().name() << reply.error().message();
+    return QVariantMap();
+  }
+
+  object_cache_[path][interface] = reply.value();
+
+  return reply.value();
+
+}
+
+QStringList Udisks2Lister::MountPointsFromProperty(const QVariant &value) {
+
+  QStringList ret;
+
+  const QDBusArgument array = value.value<QDBusArgument>();
+  if (array.currentType() != QDBusArgument::ArrayType) return ret;
+
+  array.beginArray();
+  while (!array.atEnd()) {
+    QByteArray mountpoint_data;
+    array >> mountpoint_data;
+    // Mount points come as null terminated byte arrays.
+    ret << QString::fromUtf8(mountpoint_data.constData());
+  }
+  array.endArray();
+
+  return ret;
+
+}
+
 QString Udisks2Lister::PartitionData::unique_id() const {
   return QString("Udisks2/%1/%2/%3/%4/%5")
       .arg(serial, vendor, model)
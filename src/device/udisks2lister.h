@@ -114,7 +114,12 @@ class Udisks2Lister : public DeviceLister {
     QStringList mount_paths;
   };
 
-  static PartitionData ReadPartitionData(const QDBusObjectPath &path);
+  // Builds partition data from the local object cache instead of issuing per-property D-Bus calls.
+  // refresh_mount_points re-reads the filesystem properties with a single GetAll call, needed after a mount job since the cached mount points predate the mount.
+  PartitionData ReadPartitionData(const QDBusObjectPath &path, const bool refresh_mount_points = false);
+  // Returns the cached properties of one interface on an object, fetching them with a single GetAll call when missing or a refresh is requested.
+  QVariantMap InterfaceProperties(const QDBusObjectPath &path, const QString &interface, const bool refresh = false);
+  static QStringList MountPointsFromProperty(const QVariant &value);
   void HandleFinishedMountJob(const Udisks2Lister::PartitionData &partition_data);
   void HandleFinishedUnmountJob(const Udisks2Lister::PartitionData &partition_data, const QDBusObjectPath &mounted_object);
 
@@ -124,6 +129,10 @@ class Udisks2Lister : public DeviceLister {
  private:
   std::unique_ptr<OrgFreedesktopDBusObjectManagerInterface> udisks2_interface_;
 
+  // Interfaces and properties of every UDisks2 object, filled by the initial GetManagedObjects call and kept in sync from the InterfacesAdded/InterfacesRemoved signals.
+  // Only touched from the D-Bus slots, so it needs no locking.
+  QMap<QDBusObjectPath, InterfacesAndProperties> object_cache_;
+
   static constexpr char udisks2_service_[] = "org.freedesktop.UDisks2";
 };
 
@@ -39,6 +39,7 @@
 #include "core/logging.h"
 #include "core/application.h"
 #include "core/database.h"
+#include "core/sqlquery.h"
 
 Console::Console(Application *app, QWidget *parent) : QDialog(parent), ui_{}, app_(app) {
 
@@ -58,6 +59,29 @@ Console::Console(Application *app, QWidget *parent) : QDialog(parent), ui_{}, ap
 
 void Console::RunQuery() {
 
+  // Dot commands control the query timing capture, everything else goes to the database.
+  const QString text = ui_.query->text().trimmed();
+  if (text == ".timings" || text == ".timings on" || text == ".timings off" || text == ".timings reset") {
+    ui_.output->append("<b>&gt; " + text.toHtmlEscaped() + "</b>");
+    if (text == ".timings on") {
+      SqlQuery::SetTimingEnabled(true);
+      ui_.output->append("Query timing capture enabled.");
+    }
+    else if (text == ".timings off") {
+      SqlQuery::SetTimingEnabled(false);
+      ui_.output->append("Query timing capture disabled.");
+    }
+    else if (text == ".timings reset") {
+      SqlQuery::ResetTiming();
+      ui_.output->append("Query timing statistics cleared.");
+    }
+    else {
+      ui_.output->append("<pre>" + SqlQuery::TimingSummary().toHtmlEscaped() + "</pre>");
+    }
+    ui_.output->verticalScrollBar()->setValue(ui_.output->verticalScrollBar()->maximum());
+    return;
+  }
+
   QSqlDatabase db = app_->database()->Connect();
   QSqlQuery query(db);
   query.prepare(ui_.query->text());
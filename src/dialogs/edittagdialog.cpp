@@ -74,6 +74,7 @@
 #include "core/iconloader.h"
 #include "core/logging.h"
 #include "core/tagreaderclient.h"
+#include "core/taskmanager.h"
 #include "utilities/strutils.h"
 #include "utilities/timeutils.h"
 #include "utilities/imageutils.h"
@@ -109,7 +110,7 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       app_(app),
       album_cover_choice_controller_(new AlbumCoverChoiceController(this)),
 #ifdef HAVE_MUSICBRAINZ
-      tag_fetcher_(new TagFetcher(app->network(), this)),
+      tag_fetcher_(new TagFetcher(app->network(), app->collection_backend(), this)),
       results_dialog_(new TrackSelectionDialog(this)),
 #endif
       image_no_cover_thumbnail_(ImageUtils::GenerateNoCoverImage(QSize(128, 128))),
@@ -118,7 +119,9 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       summary_cover_art_id_(-1),
       tags_cover_art_id_(-1),
       cover_art_is_set_(false),
-      save_tag_pending_(0) {
+      save_tag_pending_(0),
+      save_tag_total_(0),
+      save_task_id_(-1) {
 
   QObject::connect(app_->album_cover_loader(), &AlbumCoverLoader::AlbumCoverLoaded, this, &EditTagDialog::AlbumCoverLoaded);
 
@@ -302,11 +305,14 @@ void EditTagDialog::hideEvent(QHideEvent *e) {
 
 void EditTagDialog::accept() {
 
-  // Show the loading indicator
-  if (!SetLoading(tr("Saving tracks") + "...")) return;
+  if (loading_ || save_tag_pending_ > 0) return;
 
   SaveData();
 
+  // The writes are applied in the background, visible in the task manager.
+  // QDialog::accept() is called when they have all completed, so the playlist items are not reloaded before the tags are on disk.
+  hide();
+
 }
 
 bool EditTagDialog::eventFilter(QObject *o, QEvent *e) {
@@ -389,18 +395,26 @@ QList<EditTagDialog::Data> EditTagDialog::LoadData(const SongList &songs) {
 
   QList<Data> ret;
 
+  // Try reloading the tags from file.
+  // Read as one batch, so the tag reader workers pipeline the files instead of paying one blocking round trip each.
+  QStringList filenames;
+  QMap<QString, Song> songs_by_filename;
   for (const Song &song : songs) {
     if (song.IsEditable()) {
-      // Try reloading the tags from file
-      Song copy(song);
-      TagReaderClient::Instance()->ReadFileBlocking(copy.url().toLocalFile(), &copy);
-      if (copy.is_valid()) {
-        copy.MergeUserSetData(song, false, false);
-        ret << Data(copy);
-      }
+      const QString filename = song.url().toLocalFile();
+      filenames << filename;  // clazy:exclude=reserve-candidates
+      songs_by_filename.insert(filename, song);
     }
   }
 
+  const SongList read_songs = TagReaderClient::Instance()->ReadFileBatchBlocking(filenames);
+  for (Song song : read_songs) {
+    const QString filename = song.url().toLocalFile();
+    if (!songs_by_filename.contains(filename)) continue;
+    song.MergeUserSetData(songs_by_filename.value(filename), false, false);
+    ret << Data(song);
+  }
+
   return ret;
 
 }
@@ -1247,18 +1261,34 @@ void EditTagDialog::SaveData() {
 
   }
 
-  if (save_tag_pending_ <= 0) SaveDataFinished();
+  if (save_tag_pending_ > 0) {
+    save_tag_total_ = save_tag_pending_;
+    save_task_id_ = app_->task_manager()->StartTask(tr("Saving tracks"));
+    app_->task_manager()->SetTaskProgress(save_task_id_, 0, save_tag_total_);
+  }
+  else {
+    SaveDataFinished();
+  }
 
 }
 
 void EditTagDialog::SaveDataFinished() {
 
+  if (save_task_id_ != -1) {
+    app_->task_manager()->SetTaskFinished(save_task_id_);
+    save_task_id_ = -1;
+  }
+  save_tag_total_ = 0;
+
   if (!collection_songs_.isEmpty()) {
     app_->collection_backend()->AddOrUpdateSongsAsync(collection_songs_.values());
     collection_songs_.clear();
   }
 
-  if (!SetLoading(QString())) return;
+  if (!save_errors_.isEmpty()) {
+    emit Error(tr("An error occurred writing metadata to '%1'").arg(save_errors_.join("', '")));
+    save_errors_.clear();
+  }
 
   QDialog::accept();
 
@@ -1362,6 +1392,9 @@ void EditTagDialog::FetchTagSongChosen(const Song &original_song, const Song &ne
 void EditTagDialog::SongSaveTagsComplete(TagReaderReply *reply, const QString &filename, Song song, const UpdateCoverAction cover_action) {
 
   --save_tag_pending_;
+  if (save_task_id_ != -1) {
+    app_->task_manager()->SetTaskProgress(save_task_id_, save_tag_total_ - save_tag_pending_, save_tag_total_);
+  }
   const bool success = reply->message().save_file_response().success();
   reply->deleteLater();
 
@@ -1389,14 +1422,15 @@ void EditTagDialog::SongSaveTagsComplete(TagReaderReply *reply, const QString &f
           song.set_manually_unset_cover();
           break;
       }
-      collection_songs_.insert(song.id(), song);
+      // Updated per completed file, so the collection reflects the writes as they finish instead of only when the whole batch is done.
+      app_->collection_backend()->AddOrUpdateSongsAsync(SongList() << song);
     }
     if (cover_action != UpdateCoverAction::None && song == app_->current_albumcover_loader()->last_song()) {
       app_->current_albumcover_loader()->LoadAlbumCover(song);
     }
   }
   else {
-    emit Error(tr("An error occurred writing metadata to '%1'").arg(filename));
+    save_errors_ << filename;
   }
 
   if (save_tag_pending_ <= 0) SaveDataFinished();
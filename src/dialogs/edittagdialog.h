@@ -30,6 +30,7 @@
 #include <QDialog>
 #include <QVariant>
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 #include <QList>
 #include <QMap>
@@ -205,6 +206,9 @@ class EditTagDialog : public QDialog {
   QPushButton *next_button_;
 
   int save_tag_pending_;
+  int save_tag_total_;
+  int save_task_id_;
+  QStringList save_errors_;
 
   QMap<int, Song> collection_songs_;
 };
@@ -0,0 +1,189 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "analysismanager.h"
+
+#include "config.h"
+
+#include <chrono>
+
+#include <QtGlobal>
+#include <QObject>
+#include <QThread>
+#include <QCoreApplication>
+#include <QTimer>
+#include <QString>
+#include <QUrl>
+#include <QSettings>
+
+#include "core/application.h"
+#include "core/logging.h"
+#include "collection/collectionbackend.h"
+#include "settings/collectionsettingspage.h"
+#ifdef HAVE_MOODBAR
+#  include "moodbar/moodbarloader.h"
+#  include "settings/moodbarsettingspage.h"
+#endif
+
+#include "analysispipeline.h"
+
+using namespace std::chrono_literals;
+
+AnalysisManager::AnalysisManager(Application *app, QObject *parent)
+    : QObject(parent),
+      app_(app),
+      thread_(new QThread(this)),
+      kMaxActiveRequests(qMax(1, QThread::idealThreadCount() / 2)),
+      analyze_loudness_new_songs_(false),
+      moodbar_enabled_(false),
+      fingerprint_new_songs_(false) {
+
+  QObject::connect(app, &Application::SettingsChanged, this, &AnalysisManager::ReloadSettings);
+  QObject::connect(app->collection_backend(), &CollectionBackend::SongsDiscovered, this, &AnalysisManager::AnalyzeNewSongs);
+  ReloadSettings();
+
+}
+
+AnalysisManager::~AnalysisManager() {
+  thread_->quit();
+  thread_->wait(1000);
+}
+
+void AnalysisManager::ReloadSettings() {
+
+  QSettings s;
+  s.beginGroup(CollectionSettingsPage::kSettingsGroup);
+  analyze_loudness_new_songs_ = s.value("auto_loudness_analysis", false).toBool();
+  // The watcher fingerprints songs while scanning when song tracking is on, this only fills in songs it missed.
+  fingerprint_new_songs_ = s.value("song_tracking", false).toBool();
+  s.endGroup();
+
+#ifdef HAVE_MOODBAR
+  s.beginGroup(MoodbarSettingsPage::kSettingsGroup);
+  moodbar_enabled_ = s.value("show", false).toBool();
+  s.endGroup();
+#endif
+
+}
+
+void AnalysisManager::AnalyzeSongs(const SongList &songs) {
+
+  for (const Song &song : songs) {
+    // An explicit request always re-analyzes loudness, the other analyses tag along when they are missing.
+    AnalysisPipeline::Analyses analyses = MissingAnalyses(song);
+    analyses.loudness = true;
+    Enqueue(song, analyses);
+  }
+
+}
+
+void AnalysisManager::AnalyzeNewSongs(const SongList &songs) {
+
+  for (const Song &song : songs) {
+    const AnalysisPipeline::Analyses analyses = MissingAnalyses(song);
+    if (!analyses.loudness && !analyses.moodbar && !analyses.fingerprint) continue;
+    Enqueue(song, analyses);
+  }
+
+}
+
+AnalysisPipeline::Analyses AnalysisManager::MissingAnalyses(const Song &song) const {
+
+  AnalysisPipeline::Analyses analyses;
+
+  analyses.loudness = analyze_loudness_new_songs_ && !song.has_rg_track_gain();
+
+#ifdef HAVE_MOODBAR
+  analyses.moodbar = moodbar_enabled_ && !app_->moodbar_loader()->HasCachedData(song.url());
+#endif
+
+#if defined(HAVE_SONGFINGERPRINTING) || defined(HAVE_MUSICBRAINZ)
+  analyses.fingerprint = fingerprint_new_songs_ && song.fingerprint().isEmpty();
+#endif
+
+  return analyses;
+
+}
+
+void AnalysisManager::Enqueue(const Song &song, const AnalysisPipeline::Analyses analyses) {
+
+  // Songs with a cue are only a section of the file, whole-file analysis would be wrong for them.
+  if (!song.url().isLocalFile() || song.has_cue()) return;
+
+  const QUrl url = song.url();
+
+  if (requests_.contains(url)) return;
+
+  if (!thread_->isRunning()) thread_->start(QThread::IdlePriority);
+
+  AnalysisPipeline *pipeline = new AnalysisPipeline(url, analyses);
+  pipeline->moveToThread(thread_);
+  QObject::connect(pipeline, &AnalysisPipeline::Finished, this, [this, pipeline, url]() { RequestFinished(pipeline, url); });
+
+  requests_[url] = pipeline;
+  queued_requests_ << url;
+
+  MaybeTakeNextRequest();
+
+}
+
+void AnalysisManager::MaybeTakeNextRequest() {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  if (active_requests_.count() >= kMaxActiveRequests || queued_requests_.isEmpty()) {
+    return;
+  }
+
+  const QUrl url = queued_requests_.takeFirst();
+  active_requests_ << url;
+
+  qLog(Info) << "Analyzing" << url.toLocalFile();
+  QMetaObject::invokeMethod(requests_[url], "Start", Qt::QueuedConnection);
+
+}
+
+void AnalysisManager::RequestFinished(AnalysisPipeline *request, const QUrl &url) {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  if (request->success()) {
+    if (request->analyses().loudness && request->have_loudness()) {
+      qLog(Info) << "Loudness analysis for" << url.toLocalFile() << "gain" << request->track_gain() << "dB peak" << request->track_peak();
+      app_->collection_backend()->UpdateTrackLoudnessAsync(url, request->track_gain(), request->track_peak());
+    }
+#ifdef HAVE_MOODBAR
+    if (!request->moodbar_data().isEmpty()) {
+      app_->moodbar_loader()->OfferData(url, request->moodbar_data());
+    }
+#endif
+    if (!request->fingerprint().isEmpty()) {
+      app_->collection_backend()->UpdateSongFingerprintAsync(url, request->fingerprint());
+    }
+  }
+
+  // Remove the request from the active list and delete it
+  requests_.remove(url);
+  active_requests_.remove(url);
+
+  QTimer::singleShot(1s, request, &AnalysisPipeline::deleteLater);
+
+  MaybeTakeNextRequest();
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ANALYSISMANAGER_H
+#define ANALYSISMANAGER_H
+
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QUrl>
+
+#include "core/song.h"
+#include "analysispipeline.h"
+
+class QThread;
+class Application;
+
+// Batch audio analysis for the collection.
+// Runs a bounded pool of headless AnalysisPipelines on a low priority thread; each pipeline decodes the file once
+// and fans the audio out to every analysis the song still needs - ReplayGain loudness, moodbar data and the
+// acoustic fingerprint - so enabling several features costs one decode per track instead of one per feature.
+// Results are stored in the songs table and the moodbar cache.
+class AnalysisManager : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit AnalysisManager(Application *app, QObject *parent = nullptr);
+  ~AnalysisManager() override;
+
+ public slots:
+  // Queues every local song in the list for loudness analysis, re-analyzing songs that already have stored values.
+  // Moodbar data and fingerprints the songs are missing are produced in the same pass when those features are enabled.
+  void AnalyzeSongs(const SongList &songs);
+  // Queues local songs that are missing results for an enabled analysis.  Connected to CollectionBackend::SongsDiscovered.
+  void AnalyzeNewSongs(const SongList &songs);
+
+ private slots:
+  void ReloadSettings();
+
+  void RequestFinished(AnalysisPipeline *request, const QUrl &url);
+  void MaybeTakeNextRequest();
+
+ private:
+  // Which analyses this song is missing, limited to the features that are enabled.
+  AnalysisPipeline::Analyses MissingAnalyses(const Song &song) const;
+  void Enqueue(const Song &song, const AnalysisPipeline::Analyses analyses);
+
+ private:
+  Application *app_;
+  QThread *thread_;
+
+  const int kMaxActiveRequests;
+
+  QMap<QUrl, AnalysisPipeline*> requests_;
+  QList<QUrl> queued_requests_;
+  QSet<QUrl> active_requests_;
+
+  bool analyze_loudness_new_songs_;
+  bool moodbar_enabled_;
+  bool fingerprint_new_songs_;
+};
+
+#endif  // ANALYSISMANAGER_H
@@ -0,0 +1,412 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "analysispipeline.h"
+
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#if defined(HAVE_SONGFINGERPRINTING) || defined(HAVE_MUSICBRAINZ)
+#  include <chromaprint.h>
+#endif
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QThread>
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include "core/logging.h"
+#include "core/signalchecker.h"
+#include "utilities/threadutils.h"
+
+#ifdef HAVE_MOODBAR
+#  include "moodbar/moodbarbuilder.h"
+#  include "ext/gstmoodbar/gstfastspectrum.h"
+#endif
+
+const int AnalysisPipeline::kMoodbarBands = 128;
+// Chromaprint expects mono 16-bit ints at a sample rate of 11025Hz and only needs the beginning of the track.
+const int AnalysisPipeline::kFingerprintDecodeRate = 11025;
+const int AnalysisPipeline::kFingerprintDecodeChannels = 1;
+const int AnalysisPipeline::kFingerprintLengthSecs = 30;
+
+AnalysisPipeline::AnalysisPipeline(const QUrl &url, const Analyses analyses, QObject *parent)
+    : QObject(parent),
+      url_(url),
+      analyses_(analyses),
+      pipeline_(nullptr),
+      tee_element_(nullptr),
+      success_(false),
+      running_(false),
+      have_gain_(false),
+      have_peak_(false),
+      track_gain_(0.0),
+      track_peak_(0.0) {}
+
+AnalysisPipeline::~AnalysisPipeline() { Cleanup(); }
+
+GstElement *AnalysisPipeline::CreateElement(const QString &factory_name) {
+
+  GstElement *ret = gst_element_factory_make(factory_name.toLatin1().constData(), nullptr);
+
+  if (ret) {
+    gst_bin_add(GST_BIN(pipeline_), ret);
+  }
+  else {
+    qLog(Warning) << "Unable to create gstreamer element" << factory_name;
+  }
+
+  return ret;
+
+}
+
+QByteArray AnalysisPipeline::ToGstUrl(const QUrl &url) {
+
+  if (url.isLocalFile() && !url.host().isEmpty()) {
+    QString str = "file:////" + url.host() + url.path();
+    return str.toUtf8();
+  }
+
+  return url.toEncoded();
+}
+
+bool AnalysisPipeline::AddLoudnessConsumer(GstElement *tee) {
+
+  GstElement *queue = CreateElement("queue");
+  GstElement *convert = CreateElement("audioconvert");
+  GstElement *resample = CreateElement("audioresample");
+  GstElement *rganalysis = CreateElement("rganalysis");
+  GstElement *fakesink = CreateElement("fakesink");
+
+  if (!queue || !convert || !resample || !rganalysis || !fakesink) return false;
+
+  g_object_set(rganalysis, "num-tracks", 1, nullptr);
+
+  return gst_element_link_many(tee, queue, convert, resample, rganalysis, fakesink, nullptr);
+
+}
+
+bool AnalysisPipeline::AddMoodbarConsumer(GstElement *tee) {
+
+#ifdef HAVE_MOODBAR
+  GstElement *queue = CreateElement("queue");
+  GstElement *convert = CreateElement("audioconvert");
+  GstElement *spectrum = CreateElement("fastspectrum");
+  GstElement *fakesink = CreateElement("fakesink");
+
+  if (!queue || !convert || !spectrum || !fakesink) return false;
+
+  g_object_set(spectrum, "bands", kMoodbarBands, nullptr);
+
+  moodbar_builder_ = std::make_unique<MoodbarBuilder>();
+
+  GstFastSpectrum *fast_spectrum = reinterpret_cast<GstFastSpectrum*>(spectrum);
+  fast_spectrum->output_callback = [this](double *magnitudes, int size) { moodbar_builder_->AddFrame(magnitudes, size); };
+
+  return gst_element_link_many(tee, queue, convert, spectrum, fakesink, nullptr);
+#else
+  Q_UNUSED(tee)
+  return true;
+#endif
+
+}
+
+bool AnalysisPipeline::AddFingerprintConsumer(GstElement *tee) {
+
+#if defined(HAVE_SONGFINGERPRINTING) || defined(HAVE_MUSICBRAINZ)
+  GstElement *queue = CreateElement("queue");
+  GstElement *convert = CreateElement("audioconvert");
+  GstElement *resample = CreateElement("audioresample");
+  GstElement *sink = CreateElement("appsink");
+
+  if (!queue || !convert || !resample || !sink) return false;
+
+  if (!gst_element_link_many(tee, queue, convert, resample, nullptr)) return false;
+
+  GstCaps *caps = gst_caps_new_simple("audio/x-raw", "format", G_TYPE_STRING, "S16LE", "channels", G_TYPE_INT, kFingerprintDecodeChannels, "rate", G_TYPE_INT, kFingerprintDecodeRate, nullptr);
+  const bool linked = gst_element_link_filtered(resample, sink, caps);
+  gst_caps_unref(caps);
+  if (!linked) return false;
+
+  GstAppSinkCallbacks callbacks;
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.new_sample = NewFingerprintBufferCallback;
+  gst_app_sink_set_callbacks(reinterpret_cast<GstAppSink*>(sink), &callbacks, this, nullptr);
+  g_object_set(G_OBJECT(sink), "sync", FALSE, nullptr);
+  g_object_set(G_OBJECT(sink), "emit-signals", TRUE, nullptr);
+
+  return fingerprint_buffer_.open(QIODevice::WriteOnly);
+#else
+  Q_UNUSED(tee)
+  return true;
+#endif
+
+}
+
+void AnalysisPipeline::Start() {
+
+  Q_ASSERT(QThread::currentThread() != qApp->thread());
+
+  Utilities::SetThreadIOPriority(Utilities::IoPriority::IOPRIO_CLASS_IDLE);
+
+  if (pipeline_) {
+    return;
+  }
+
+  pipeline_ = gst_pipeline_new("analysis-pipeline");
+
+  GstElement *decodebin = CreateElement("uridecodebin");
+  tee_element_ = CreateElement("tee");
+
+  bool ok = decodebin && tee_element_;
+  if (ok && analyses_.loudness) ok = AddLoudnessConsumer(tee_element_);
+  if (ok && analyses_.moodbar) ok = AddMoodbarConsumer(tee_element_);
+  if (ok && analyses_.fingerprint) ok = AddFingerprintConsumer(tee_element_);
+
+  if (!ok) {
+    qLog(Error) << "Failed to set up analysis pipeline";
+    gst_object_unref(GST_OBJECT(pipeline_));
+    pipeline_ = nullptr;
+    tee_element_ = nullptr;
+    emit Finished(false);
+    return;
+  }
+
+  // Set properties
+
+  QByteArray gst_url = ToGstUrl(url_);
+  g_object_set(decodebin, "uri", gst_url.constData(), nullptr);
+
+  // Connect signals
+  CHECKED_GCONNECT(decodebin, "pad-added", &NewPadCallback, this);
+  GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+  if (bus) {
+    gst_bus_set_sync_handler(bus, BusCallbackSync, this, nullptr);
+    gst_object_unref(bus);
+  }
+
+  // Start playing
+  running_ = true;
+  gst_element_set_state(pipeline_, GST_STATE_PLAYING);
+
+}
+
+void AnalysisPipeline::ReportError(GstMessage *msg) {
+
+  GError *error = nullptr;
+  gchar *debugs = nullptr;
+
+  gst_message_parse_error(msg, &error, &debugs);
+  QString message = QString::fromLocal8Bit(error->message);
+
+  g_error_free(error);
+  g_free(debugs);
+
+  qLog(Error) << "Error analyzing" << url_ << ":" << message;
+
+}
+
+void AnalysisPipeline::TagMessageReceived(GstMessage *msg) {
+
+  GstTagList *taglist = nullptr;
+  gst_message_parse_tag(msg, &taglist);
+  if (!taglist) return;
+
+  double value = 0.0;
+  if (gst_tag_list_get_double(taglist, GST_TAG_TRACK_GAIN, &value)) {
+    track_gain_ = value;
+    have_gain_ = true;
+  }
+  if (gst_tag_list_get_double(taglist, GST_TAG_TRACK_PEAK, &value)) {
+    track_peak_ = value;
+    have_peak_ = true;
+  }
+
+  gst_tag_list_unref(taglist);
+
+}
+
+void AnalysisPipeline::NewPadCallback(GstElement*, GstPad *pad, gpointer data) {
+
+  AnalysisPipeline *self = reinterpret_cast<AnalysisPipeline*>(data);
+
+  if (!self->running_) {
+    qLog(Warning) << "Received gstreamer callback after pipeline has stopped.";
+    return;
+  }
+
+  GstPad *const audiopad = gst_element_get_static_pad(self->tee_element_, "sink");
+  if (!audiopad) return;
+
+  if (GST_PAD_IS_LINKED(audiopad)) {
+    qLog(Warning) << "audiopad is already linked, unlinking old pad";
+    gst_pad_unlink(audiopad, GST_PAD_PEER(audiopad));
+  }
+
+  gst_pad_link(pad, audiopad);
+  gst_object_unref(audiopad);
+
+#ifdef HAVE_MOODBAR
+  if (self->moodbar_builder_) {
+    int rate = 0;
+    GstCaps *caps = gst_pad_get_current_caps(pad);
+    if (caps) {
+      GstStructure *structure = gst_caps_get_structure(caps, 0);
+      if (structure) {
+        gst_structure_get_int(structure, "rate", &rate);
+      }
+      gst_caps_unref(caps);
+    }
+    self->moodbar_builder_->Init(kMoodbarBands, rate);
+  }
+#endif
+
+}
+
+GstFlowReturn AnalysisPipeline::NewFingerprintBufferCallback(GstAppSink *app_sink, gpointer data) {
+
+  AnalysisPipeline *self = reinterpret_cast<AnalysisPipeline*>(data);
+
+  GstSample *sample = gst_app_sink_pull_sample(app_sink);
+  if (!sample) return GST_FLOW_ERROR;
+  GstBuffer *buffer = gst_sample_get_buffer(sample);
+  if (buffer) {
+    // The rest of the track still flows through for the other consumers, chromaprint just stops collecting.
+    const qint64 max_size = static_cast<qint64>(kFingerprintLengthSecs) * kFingerprintDecodeRate * kFingerprintDecodeChannels * 2;
+    if (self->fingerprint_buffer_.size() < max_size) {
+      GstMapInfo map;
+      if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+        self->fingerprint_buffer_.write(reinterpret_cast<const char*>(map.data), static_cast<qint64>(map.size));
+        gst_buffer_unmap(buffer, &map);
+      }
+    }
+  }
+  gst_sample_unref(sample);
+
+  return GST_FLOW_OK;
+
+}
+
+GstBusSyncReply AnalysisPipeline::BusCallbackSync(GstBus*, GstMessage *msg, gpointer data) {
+
+  AnalysisPipeline *self = reinterpret_cast<AnalysisPipeline*>(data);
+
+  switch (GST_MESSAGE_TYPE(msg)) {
+    case GST_MESSAGE_TAG:
+      self->TagMessageReceived(msg);
+      break;
+
+    case GST_MESSAGE_EOS:
+      self->Stop(true);
+      break;
+
+    case GST_MESSAGE_ERROR:
+      self->ReportError(msg);
+      self->Stop(false);
+      break;
+
+    default:
+      break;
+  }
+  return GST_BUS_PASS;
+
+}
+
+QString AnalysisPipeline::FingerprintFromBuffer() const {
+
+#if defined(HAVE_SONGFINGERPRINTING) || defined(HAVE_MUSICBRAINZ)
+  const QByteArray data = fingerprint_buffer_.data();
+  if (data.isEmpty()) return QString();
+
+  ChromaprintContext *chromaprint = chromaprint_new(CHROMAPRINT_ALGORITHM_DEFAULT);
+  chromaprint_start(chromaprint, kFingerprintDecodeRate, kFingerprintDecodeChannels);
+  chromaprint_feed(chromaprint, reinterpret_cast<const int16_t*>(data.constData()), static_cast<int>(data.size() / 2));
+  chromaprint_finish(chromaprint);
+
+  uint32_t *fprint = nullptr;
+  int size = 0;
+  QByteArray fingerprint;
+  if (chromaprint_get_raw_fingerprint(chromaprint, &fprint, &size) == 1) {
+    char *encoded = nullptr;
+    int encoded_size = 0;
+    if (chromaprint_encode_fingerprint(fprint, size, CHROMAPRINT_ALGORITHM_DEFAULT, &encoded, &encoded_size, 1) == 1) {
+      fingerprint.append(encoded, encoded_size);
+      chromaprint_dealloc(encoded);
+    }
+    chromaprint_dealloc(fprint);
+  }
+  chromaprint_free(chromaprint);
+
+  return QString::fromLatin1(fingerprint);
+#else
+  return QString();
+#endif
+
+}
+
+void AnalysisPipeline::Stop(const bool success) {
+
+  success_ = success;
+  running_ = false;
+
+#ifdef HAVE_MOODBAR
+  if (moodbar_builder_) {
+    moodbar_data_ = moodbar_builder_->Finish(1000);
+    moodbar_builder_.reset();
+  }
+#endif
+
+  if (fingerprint_buffer_.isOpen()) {
+    fingerprint_buffer_.close();
+    if (success) fingerprint_ = FingerprintFromBuffer();
+  }
+
+  emit Finished(success);
+
+}
+
+void AnalysisPipeline::Cleanup() {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+  Q_ASSERT(QThread::currentThread() != qApp->thread());
+
+  running_ = false;
+  if (pipeline_) {
+    GstBus *bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+    if (bus) {
+      gst_bus_set_sync_handler(bus, nullptr, nullptr, nullptr);
+      gst_object_unref(bus);
+    }
+
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+    tee_element_ = nullptr;
+  }
+
+}
@@ -0,0 +1,126 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ANALYSISPIPELINE_H
+#define ANALYSISPIPELINE_H
+
+#include "config.h"
+
+#include <memory>
+
+#include <QObject>
+#include <QBuffer>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#ifdef HAVE_MOODBAR
+class MoodbarBuilder;
+#endif
+
+// Decodes a local music file once and fans the decoded audio out through a tee to the requested analysis consumers,
+// so running several analyses on the same file costs one decode instead of one per consumer.
+class AnalysisPipeline : public QObject {
+  Q_OBJECT
+
+ public:
+  // Which analyses to run in this pass, at least one must be enabled.
+  // Consumers whose feature was disabled at build time are silently skipped.
+  struct Analyses {
+    Analyses() : loudness(false), moodbar(false), fingerprint(false) {}
+    bool loudness;
+    bool moodbar;
+    bool fingerprint;
+  };
+
+  explicit AnalysisPipeline(const QUrl &url, const Analyses analyses, QObject *parent = nullptr);
+  ~AnalysisPipeline() override;
+
+  Analyses analyses() const { return analyses_; }
+  bool success() const { return success_; }
+
+  // ReplayGain track gain in dB and linear track peak, only valid when have_loudness() is true.
+  bool have_loudness() const { return have_gain_ && have_peak_; }
+  double track_gain() const { return track_gain_; }
+  double track_peak() const { return track_peak_; }
+
+  // Moodbar data, empty when moodbar analysis was not requested or produced nothing.
+  QByteArray moodbar_data() const { return moodbar_data_; }
+
+  // Encoded chromaprint fingerprint, empty when fingerprinting was not requested or failed.
+  QString fingerprint() const { return fingerprint_; }
+
+ public slots:
+  void Start();
+
+ signals:
+  void Finished(const bool success);
+
+ private:
+  GstElement *CreateElement(const QString &factory_name);
+  bool AddLoudnessConsumer(GstElement *tee);
+  bool AddMoodbarConsumer(GstElement *tee);
+  bool AddFingerprintConsumer(GstElement *tee);
+
+  QByteArray ToGstUrl(const QUrl &url);
+  void ReportError(GstMessage *msg);
+  void TagMessageReceived(GstMessage *msg);
+  void Stop(const bool success);
+  void Cleanup();
+  QString FingerprintFromBuffer() const;
+
+  static void NewPadCallback(GstElement*, GstPad *pad, gpointer data);
+  static GstFlowReturn NewFingerprintBufferCallback(GstAppSink *app_sink, gpointer data);
+  static GstBusSyncReply BusCallbackSync(GstBus*, GstMessage *msg, gpointer data);
+
+ private:
+  static const int kMoodbarBands;
+  static const int kFingerprintDecodeRate;
+  static const int kFingerprintDecodeChannels;
+  static const int kFingerprintLengthSecs;
+
+  QUrl url_;
+  Analyses analyses_;
+  GstElement *pipeline_;
+  GstElement *tee_element_;
+
+  bool success_;
+  bool running_;
+
+  bool have_gain_;
+  bool have_peak_;
+  double track_gain_;
+  double track_peak_;
+
+#ifdef HAVE_MOODBAR
+  std::unique_ptr<MoodbarBuilder> moodbar_builder_;
+#endif
+  QByteArray moodbar_data_;
+
+  // Raw S16LE mono samples for chromaprint, capped at kFingerprintLengthSecs worth of audio.
+  QBuffer fingerprint_buffer_;
+  QString fingerprint_;
+};
+
+#endif  // ANALYSISPIPELINE_H
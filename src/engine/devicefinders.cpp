@@ -20,6 +20,7 @@
 #include "config.h"
 
 #include <QtAlgorithms>
+#include <QtConcurrent>
 #include <QObject>
 #include <QList>
 
@@ -48,11 +49,31 @@
 DeviceFinders::DeviceFinders(QObject *parent) : QObject(parent) {}
 
 DeviceFinders::~DeviceFinders() {
+  init_future_.waitForFinished();
   qDeleteAll(device_finders_);
 }
 
 void DeviceFinders::Init() {
 
+  // Probing is done in the background so engine startup doesn't have to wait for device enumeration.
+  // The engine only ever uses the configured sink, nobody needs the list until the backend settings page or the context view asks for it.
+  init_future_ = QtConcurrent::run([this]() { InitAsync(); });
+
+}
+
+QList<DeviceFinder*> DeviceFinders::ListFinders() {
+
+  if (!init_future_.isFinished()) {
+    qLog(Debug) << "Waiting for device probing to finish";
+    init_future_.waitForFinished();
+  }
+
+  return device_finders_;
+
+}
+
+void DeviceFinders::InitAsync() {
+
   QList<DeviceFinder*> device_finders;
 
 #ifdef HAVE_ALSA
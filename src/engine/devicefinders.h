@@ -23,6 +23,7 @@
 #include "config.h"
 
 #include <QObject>
+#include <QFuture>
 #include <QList>
 #include <QString>
 
@@ -35,10 +36,15 @@ class DeviceFinders : public QObject {
   explicit DeviceFinders(QObject *parent = nullptr);
   ~DeviceFinders() override;
 
+  // Starts probing for output devices on a background thread, probing ALSA and PulseAudio can take seconds with many devices attached.
   void Init();
-  QList<DeviceFinder*> ListFinders() { return device_finders_; }
+  // Returns the finders, waiting for the background probe to finish first if it is still running.
+  QList<DeviceFinder*> ListFinders();
 
  private:
+  void InitAsync();
+
+  QFuture<void> init_future_;
   QList<DeviceFinder*> device_finders_;
 
 };
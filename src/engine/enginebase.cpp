@@ -23,7 +23,9 @@
 
 #include "config.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstring>
 
 #include <QtGlobal>
 #include <QVariant>
@@ -54,6 +56,7 @@ EngineBase::EngineBase(QObject *parent)
       buffer_duration_nanosec_(BackendSettingsPage::kDefaultBufferDuration * kNsecPerMsec),
       buffer_low_watermark_(BackendSettingsPage::kDefaultBufferLowWatermark),
       buffer_high_watermark_(BackendSettingsPage::kDefaultBufferHighWatermark),
+      preload_prefetch_bytes_(BackendSettingsPage::kDefaultPreloadPrefetchBytes),
       fadeout_enabled_(true),
       crossfade_enabled_(true),
       autocrossfade_enabled_(false),
@@ -69,10 +72,94 @@ EngineBase::EngineBase(QObject *parent)
       bs2b_enabled_(false),
       http2_enabled_(true),
       strict_ssl_enabled_(false),
-      about_to_end_emitted_(false) {}
+      level_meter_enabled_(false),
+      about_to_end_emitted_(false) {
+
+  scope_ring_latest_.store(-1, std::memory_order_relaxed);
+  for (int i = 0; i < kScopeRingFrames; ++i) {
+    scope_ring_sequences_[i].store(0, std::memory_order_relaxed);
+  }
+
+  level_ring_latest_.store(-1, std::memory_order_relaxed);
+  for (int i = 0; i < kLevelRingFrames; ++i) {
+    level_ring_sequences_[i].store(0, std::memory_order_relaxed);
+  }
+
+}
 
 EngineBase::~EngineBase() = default;
 
+void EngineBase::PublishScopeFrame(const int16_t *samples, const int sample_count, const qint64 timestamp_nanosec) {
+
+  const int slot = (scope_ring_latest_.load(std::memory_order_relaxed) + 1) % kScopeRingFrames;
+  ScopeFrame &frame = scope_ring_[slot];
+  std::atomic<quint32> &sequence = scope_ring_sequences_[slot];
+
+  // Odd sequence marks the slot as being written, readers throw away anything they copied while it was odd.
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+
+  frame.sample_count = qMin(sample_count, kScopeSize);
+  frame.timestamp_nanosec = timestamp_nanosec;
+  memcpy(frame.samples, samples, frame.sample_count * sizeof(int16_t));
+
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+  scope_ring_latest_.store(slot, std::memory_order_release);
+
+}
+
+bool EngineBase::LatestScopeFrame(ScopeFrame *frame) const {
+
+  for (int attempt = 0; attempt < kScopeRingFrames; ++attempt) {
+    const int slot = scope_ring_latest_.load(std::memory_order_acquire);
+    if (slot < 0) return false;
+    const quint32 sequence_before = scope_ring_sequences_[slot].load(std::memory_order_acquire);
+    if (sequence_before & 1U) continue;
+    *frame = scope_ring_[slot];
+    // The payload copy must not be reordered past the validating sequence load, or a torn frame can pass the check.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const quint32 sequence_after = scope_ring_sequences_[slot].load(std::memory_order_acquire);
+    if (sequence_before == sequence_after) return true;
+  }
+
+  return false;
+
+}
+
+void EngineBase::PublishLevelSnapshot(const LevelSnapshot &snapshot) {
+
+  const int slot = (level_ring_latest_.load(std::memory_order_relaxed) + 1) % kLevelRingFrames;
+  std::atomic<quint32> &sequence = level_ring_sequences_[slot];
+
+  // Odd sequence marks the slot as being written, readers throw away anything they copied while it was odd.
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+
+  level_ring_[slot] = snapshot;
+
+  sequence.fetch_add(1, std::memory_order_acq_rel);
+  level_ring_latest_.store(slot, std::memory_order_release);
+
+  emit LevelSnapshotPublished();
+
+}
+
+bool EngineBase::LatestLevelSnapshot(LevelSnapshot *snapshot) const {
+
+  for (int attempt = 0; attempt < kLevelRingFrames; ++attempt) {
+    const int slot = level_ring_latest_.load(std::memory_order_acquire);
+    if (slot < 0) return false;
+    const quint32 sequence_before = level_ring_sequences_[slot].load(std::memory_order_acquire);
+    if (sequence_before & 1U) continue;
+    *snapshot = level_ring_[slot];
+    // The payload copy must not be reordered past the validating sequence load, or a torn snapshot can pass the check.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const quint32 sequence_after = level_ring_sequences_[slot].load(std::memory_order_acquire);
+    if (sequence_before == sequence_after) return true;
+  }
+
+  return false;
+
+}
+
 EngineBase::Type EngineBase::TypeFromName(const QString &name) {
 
   if (name.compare("gstreamer", Qt::CaseInsensitive) == 0) return Type::GStreamer;
@@ -160,6 +247,7 @@ void EngineBase::ReloadSettings() {
   buffer_duration_nanosec_ = s.value("bufferduration", BackendSettingsPage::kDefaultBufferDuration).toLongLong() * kNsecPerMsec;
   buffer_low_watermark_ = s.value("bufferlowwatermark", BackendSettingsPage::kDefaultBufferLowWatermark).toDouble();
   buffer_high_watermark_ = s.value("bufferhighwatermark", BackendSettingsPage::kDefaultBufferHighWatermark).toDouble();
+  preload_prefetch_bytes_ = s.value("preloadprefetchbytes", BackendSettingsPage::kDefaultPreloadPrefetchBytes).toLongLong();
 
   rg_enabled_ = s.value("rgenabled", false).toBool();
   rg_mode_ = s.value("rgmode", 0).toInt();
@@ -188,6 +276,8 @@ void EngineBase::ReloadSettings() {
 
   strict_ssl_enabled_ = s.value("strict_ssl", false).toBool();
 
+  level_meter_enabled_ = s.value("level_meter", false).toBool();
+
   s.endGroup();
 
   s.beginGroup(NetworkProxySettingsPage::kSettingsGroup);
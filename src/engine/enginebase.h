@@ -27,6 +27,7 @@
 #include "config.h"
 
 #include <sys/types.h>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -96,6 +97,27 @@ class EngineBase : public QObject {
 
   using Scope = std::vector<int16_t>;
 
+  static const int kScopeSize = 1024;
+
+  // A fixed-size window of interleaved PCM with the timestamp of its first sample.
+  // Published by the engine's audio thread into a small seqlock ring, see PublishScopeFrame() and LatestScopeFrame().
+  struct ScopeFrame {
+    qint64 timestamp_nanosec = -1;
+    int sample_count = 0;
+    int16_t samples[kScopeSize] = {};
+  };
+
+  static const int kLevelMeterMaxChannels = 8;
+
+  // A fixed-rate per-channel loudness summary in decibels, measured by the engine's level tap.
+  // Published by the engine's streaming thread into a small seqlock ring, see PublishLevelSnapshot() and LatestLevelSnapshot().
+  struct LevelSnapshot {
+    qint64 endtime_nanosec = -1;
+    int channels = 0;
+    double rms_db[kLevelMeterMaxChannels] = {};
+    double peak_db[kLevelMeterMaxChannels] = {};
+  };
+
   static Type TypeFromName(const QString &name);
   static QString Name(const Type type);
   static QString Description(const Type type);
@@ -109,7 +131,9 @@ class EngineBase : public QObject {
   virtual void Stop(const bool stop_after = false) = 0;
   virtual void Pause() = 0;
   virtual void Unpause() = 0;
-  virtual void Seek(const quint64 offset_nanosec) = 0;
+  // Set fast for interactive scrubbing, where the engine may trade a frame of accuracy for speed.
+  // Track starts, CUE sections and resume positions must seek with fast = false so they are sample accurate.
+  virtual void Seek(const quint64 offset_nanosec, const bool fast = false) = 0;
   virtual void SetVolumeSW(const uint percent) = 0;
 
   virtual qint64 position_nanosec() const = 0;
@@ -117,6 +141,14 @@ class EngineBase : public QObject {
 
   virtual const Scope &scope(const int chunk_length) { Q_UNUSED(chunk_length); return scope_; }
 
+  // Copies the latest stable PCM window out of the scope ring.  Never blocks the audio thread and takes no locks, readers retry if the writer tore the slot they were reading.
+  // Returns false if the engine has not published any frames.  Safe to call from any thread and from several consumers at once.
+  bool LatestScopeFrame(ScopeFrame *frame) const;
+
+  // Copies the latest level measurement out of the level ring, same lock-free scheme as LatestScopeFrame().
+  // Returns false if no measurement has been published yet, which is also the case when the level tap is disabled.
+  bool LatestLevelSnapshot(LevelSnapshot *snapshot) const;
+
   // Sets new values for the beginning and end markers of the currently playing song.
   // This doesn't change the state of engine or the stream's current position.
   virtual void RefreshMarkers(const quint64 beginning_nanosec, const qint64 end_nanosec) {
@@ -151,8 +183,6 @@ class EngineBase : public QObject {
   bool crossfade_same_album() const { return crossfade_same_album_; }
   bool IsEqualizerEnabled() { return equalizer_enabled_; }
 
-  static const int kScopeSize = 1024;
-
   QVariant device() { return device_; }
 
  public slots:
@@ -187,7 +217,19 @@ class EngineBase : public QObject {
 
   void VolumeChanged(const uint volume);
 
+  // Emitted after a new level measurement was published, so fixed-rate consumers do not have to poll the ring.
+  // Receivers pick the measurement up with LatestLevelSnapshot().
+  void LevelSnapshotPublished();
+
  protected:
+  // Publishes a PCM window into the scope ring.  Called by the engine's audio thread only - the ring assumes a single producer.
+  // Anything beyond kScopeSize samples is truncated.
+  void PublishScopeFrame(const int16_t *samples, const int sample_count, const qint64 timestamp_nanosec);
+
+  // Publishes a level measurement into the level ring and emits LevelSnapshotPublished.
+  // Called by the engine's streaming thread only - the ring assumes a single producer.
+  void PublishLevelSnapshot(const LevelSnapshot &snapshot);
+
   bool volume_control_;
   uint volume_;
   quint64 beginning_nanosec_;
@@ -213,6 +255,7 @@ class EngineBase : public QObject {
   quint64 buffer_duration_nanosec_;
   double buffer_low_watermark_;
   double buffer_high_watermark_;
+  qint64 preload_prefetch_bytes_;
 
   // Fadeout
   bool fadeout_enabled_;
@@ -239,9 +282,24 @@ class EngineBase : public QObject {
   bool bs2b_enabled_;
   bool http2_enabled_;
   bool strict_ssl_enabled_;
+  bool level_meter_enabled_;
 
   bool about_to_end_emitted_;
 
+ private:
+  // Scope ring: the producer bumps the slot's sequence to odd, fills it, bumps it back to even and then advances latest.
+  // Readers copy a slot and accept the copy only if the sequence was even and unchanged around it.
+  static const int kScopeRingFrames = 8;
+  ScopeFrame scope_ring_[kScopeRingFrames];
+  std::atomic<quint32> scope_ring_sequences_[kScopeRingFrames];
+  std::atomic<int> scope_ring_latest_;
+
+  // Level ring, same seqlock scheme as the scope ring above.
+  static const int kLevelRingFrames = 4;
+  LevelSnapshot level_ring_[kLevelRingFrames];
+  std::atomic<quint32> level_ring_sequences_[kLevelRingFrames];
+  std::atomic<int> level_ring_latest_;
+
   Q_DISABLE_COPY(EngineBase)
 };
 
@@ -48,6 +48,7 @@
 #include <QTimerEvent>
 
 #include "core/logging.h"
+#include "core/playbacklatency.h"
 #include "core/taskmanager.h"
 #include "core/signalchecker.h"
 #include "utilities/timeconstants.h"
@@ -73,6 +74,7 @@ const int GstEngine::kDiscoveryTimeoutS = 10;
 const qint64 GstEngine::kTimerIntervalNanosec = 1000 * kNsecPerMsec;  // 1s
 const qint64 GstEngine::kPreloadGapNanosec = 8000 * kNsecPerMsec;     // 8s
 const qint64 GstEngine::kSeekDelayNanosec = 100 * kNsecPerMsec;       // 100msec
+const int GstEngine::kMaxScopeBuffersInFlight = 8;
 
 GstEngine::GstEngine(TaskManager *task_manager, QObject *parent)
     : EngineBase(parent),
@@ -88,6 +90,7 @@ GstEngine::GstEngine(TaskManager *task_manager, QObject *parent)
       seek_timer_(new QTimer(this)),
       waiting_to_seek_(false),
       seek_pos_(0),
+      seek_fast_(false),
       timer_id_(-1),
       is_fading_out_to_pause_(false),
       has_faded_out_(false),
@@ -178,6 +181,8 @@ void GstEngine::StartPreloading(const QUrl &media_url, const QUrl &stream_url, c
 
 bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const EngineBase::TrackChangeFlags change, const bool force_stop_at_end, const quint64 beginning_nanosec, const qint64 end_nanosec) {
 
+  PlaybackLatency::Mark(PlaybackLatency::Stage::EngineLoad);
+
   EnsureInitialized();
 
   EngineBase::Load(stream_url, media_url, change, force_stop_at_end, beginning_nanosec, end_nanosec);
@@ -229,6 +234,9 @@ bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const Engine
     }
   }
 
+  // Construct the pipeline for the next track change once this one is underway.
+  QTimer::singleShot(0, this, &GstEngine::EnsureSparePipeline);
+
   return true;
 
 }
@@ -331,16 +339,18 @@ void GstEngine::Unpause() {
   }
 }
 
-void GstEngine::Seek(const quint64 offset_nanosec) {
+void GstEngine::Seek(const quint64 offset_nanosec, const bool fast) {
 
   if (!current_pipeline_) return;
 
+  // Coalescing can merge a scrub with an exact seek; only stay fast when every merged request allows it.
+  seek_fast_ = fast && (!waiting_to_seek_ || seek_fast_);
   seek_pos_ = beginning_nanosec_ + offset_nanosec;
   waiting_to_seek_ = true;
 
+  // Apply right away if allowed, otherwise the request is absorbed into seek_pos_ and applied on the timer tick.
   if (!seek_timer_->isActive()) {
     SeekNow();
-    seek_timer_->start();  // Stop us from seeking again for a little while
   }
 }
 
@@ -352,6 +362,13 @@ qint64 GstEngine::position_nanosec() const {
 
   if (!current_pipeline_) return 0;
 
+  // While a coalesced seek is waiting for the rate limit, report the requested target instead of the stale pipeline position.
+  // The slider tracks the drag instead of snapping back, and held seek keys accumulate because SeekForward computes the next step from here.
+  if (waiting_to_seek_) {
+    const qint64 pending = static_cast<qint64>(seek_pos_) - static_cast<qint64>(beginning_nanosec_);
+    return std::max(0LL, pending);
+  }
+
   const qint64 result = current_pipeline_->position() - static_cast<qint64>(beginning_nanosec_);
   return std::max(0LL, result);
 
@@ -452,13 +469,35 @@ void GstEngine::ReloadSettings() {
 
   if (output_.isEmpty()) output_ = kAutoSink;
 
+  // The output, device and most other settings are baked into a pipeline at construction time, so a pre-built spare is stale now.
+  spare_pipeline_.reset();
+
 }
 
 void GstEngine::ConsumeBuffer(GstBuffer *buffer, const int pipeline_id, const QString &format) {
 
+  // Publish a window into the lock-free scope ring, so consumers on other threads can read PCM without going through the GUI-thread scope machinery.
+  // Only one pipeline feeds this at a time - fadeout pipelines have their buffer consumers removed.
+  if (format.startsWith("S16LE")) {
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      PublishScopeFrame(reinterpret_cast<const int16_t*>(map.data), static_cast<int>(map.size / sizeof(int16_t)), static_cast<qint64>(GST_BUFFER_PTS(buffer)));
+      gst_buffer_unmap(buffer, &map);
+    }
+  }
+
+  // If the GUI thread is not keeping up, drop the buffer instead of queueing it.
+  // The scope only ever shows the latest buffer anyway, and an unbounded event queue would pin every dropped frame's audio data in memory.
+  if (scope_buffers_in_flight_.loadAcquire() >= kMaxScopeBuffersInFlight) {
+    gst_buffer_unref(buffer);
+    return;
+  }
+  scope_buffers_in_flight_.ref();
+
   // Schedule this to run in the GUI thread.  The buffer gets added to the queue and unreffed by UpdateScope.
   if (!QMetaObject::invokeMethod(this, "AddBufferToScope", Q_ARG(GstBuffer*, buffer), Q_ARG(int, pipeline_id), Q_ARG(QString, format))) {
     qLog(Warning) << "Failed to invoke AddBufferToScope on GstEngine";
+    scope_buffers_in_flight_.deref();
     gst_buffer_unref(buffer);
   }
 
@@ -468,6 +507,7 @@ void GstEngine::SetStereoBalancerEnabled(const bool enabled) {
 
   stereo_balancer_enabled_ = enabled;
   if (current_pipeline_) current_pipeline_->set_stereo_balancer_enabled(enabled);
+  if (spare_pipeline_) spare_pipeline_->set_stereo_balancer_enabled(enabled);
 
 }
 
@@ -482,6 +522,7 @@ void GstEngine::SetEqualizerEnabled(const bool enabled) {
 
   equalizer_enabled_ = enabled;
   if (current_pipeline_) current_pipeline_->set_equalizer_enabled(enabled);
+  if (spare_pipeline_) spare_pipeline_->set_equalizer_enabled(enabled);
 
 }
 
@@ -498,6 +539,7 @@ void GstEngine::AddBufferConsumer(GstBufferConsumer *consumer) {
 
   buffer_consumers_ << consumer;
   if (current_pipeline_) current_pipeline_->AddBufferConsumer(consumer);
+  if (spare_pipeline_) spare_pipeline_->AddBufferConsumer(consumer);
 
 }
 
@@ -505,6 +547,7 @@ void GstEngine::RemoveBufferConsumer(GstBufferConsumer *consumer) {
 
   buffer_consumers_.removeAll(consumer);
   if (current_pipeline_) current_pipeline_->RemoveBufferConsumer(consumer);
+  if (spare_pipeline_) spare_pipeline_->RemoveBufferConsumer(consumer);
 
 }
 
@@ -583,6 +626,8 @@ void GstEngine::NewMetaData(const int pipeline_id, const EngineMetadata &engine_
 
 void GstEngine::AddBufferToScope(GstBuffer *buf, const int pipeline_id, const QString &format) {
 
+  scope_buffers_in_flight_.deref();
+
   if (!current_pipeline_ || current_pipeline_->id() != pipeline_id) {
     gst_buffer_unref(buf);
     return;
@@ -628,10 +673,14 @@ void GstEngine::SeekNow() {
 
   if (!current_pipeline_) return;
 
-  if (!current_pipeline_->Seek(static_cast<qint64>(seek_pos_))) {
+  if (!current_pipeline_->Seek(static_cast<qint64>(seek_pos_), seek_fast_)) {
     qLog(Warning) << "Seek failed";
   }
 
+  // Every flushing seek opens a fresh quiet window, including the ones applied on the timer tick.
+  // Without this, a held seek key alternates between a coalesced and an immediate seek and flushes twice as often.
+  seek_timer_->start();
+
 }
 
 void GstEngine::PlayDone(const GstStateChangeReturn ret, const quint64 offset_nanosec, const int pipeline_id) {
@@ -694,6 +743,36 @@ void GstEngine::BufferingFinished() {
 
 }
 
+void GstEngine::PipelineBufferTargetChanged(const int pipeline_id, const quint64 target_nanosec) {
+
+  if (!current_pipeline_ || current_pipeline_->id() != pipeline_id) return;
+
+  const QString host = current_pipeline_->stream_url().host();
+  if (host.isEmpty()) return;
+
+  if (target_nanosec > buffer_targets_by_host_.value(host, 0)) {
+    buffer_targets_by_host_.insert(host, target_nanosec);
+  }
+
+}
+
+void GstEngine::PipelineLevelMeasured(const int pipeline_id, const qint64 endtime_nanosec, const QList<double> &rms_db, const QList<double> &peak_db) {
+
+  Q_UNUSED(pipeline_id)
+
+  // Runs on the pipeline's bus thread.  Deliberately does not look at current_pipeline_ (owned by the GUI thread) - fadeout pipelines are disconnected in StartFadeout, so only one pipeline gets here at a time.
+  LevelSnapshot snapshot;
+  snapshot.endtime_nanosec = endtime_nanosec;
+  snapshot.channels = qMin(static_cast<int>(qMax(rms_db.count(), peak_db.count())), kLevelMeterMaxChannels);
+  for (int i = 0; i < snapshot.channels; ++i) {
+    if (i < rms_db.count()) snapshot.rms_db[i] = rms_db[i];
+    if (i < peak_db.count()) snapshot.peak_db[i] = peak_db[i];
+  }
+
+  PublishLevelSnapshot(snapshot);
+
+}
+
 QByteArray GstEngine::FixupUrl(const QUrl &url) {
 
   EnsureInitialized();
@@ -788,10 +867,12 @@ std::shared_ptr<GstEnginePipeline> GstEngine::CreatePipeline() {
   ret->set_buffer_duration_nanosec(buffer_duration_nanosec_);
   ret->set_buffer_low_watermark(buffer_low_watermark_);
   ret->set_buffer_high_watermark(buffer_high_watermark_);
+  ret->set_next_url_prefetch_bytes(preload_prefetch_bytes_);
   ret->set_proxy_settings(proxy_address_, proxy_authentication_, proxy_user_, proxy_pass_);
   ret->set_channels(channels_enabled_, channels_);
   ret->set_bs2b_enabled(bs2b_enabled_);
   ret->set_strict_ssl_enabled(strict_ssl_enabled_);
+  ret->set_level_meter_enabled(level_meter_enabled_);
   ret->set_fading_enabled(fadeout_enabled_ || autocrossfade_enabled_ || fadeout_pause_enabled_);
 
   ret->AddBufferConsumer(this);
@@ -805,8 +886,12 @@ std::shared_ptr<GstEnginePipeline> GstEngine::CreatePipeline() {
   QObject::connect(ret.get(), &GstEnginePipeline::BufferingStarted, this, &GstEngine::BufferingStarted);
   QObject::connect(ret.get(), &GstEnginePipeline::BufferingProgress, this, &GstEngine::BufferingProgress);
   QObject::connect(ret.get(), &GstEnginePipeline::BufferingFinished, this, &GstEngine::BufferingFinished);
+  QObject::connect(ret.get(), &GstEnginePipeline::BufferTargetChanged, this, &GstEngine::PipelineBufferTargetChanged);
   QObject::connect(ret.get(), &GstEnginePipeline::VolumeChanged, this, &EngineBase::UpdateVolume);
   QObject::connect(ret.get(), &GstEnginePipeline::AboutToFinish, this, &EngineBase::EmitAboutToFinish);
+  // Direct connection: runs on the pipeline's bus thread and publishes into the lock-free level ring.
+  // Only one pipeline feeds the ring at a time - fadeout pipelines are disconnected in StartFadeout.
+  QObject::connect(ret.get(), &GstEnginePipeline::LevelMeasured, this, &GstEngine::PipelineLevelMeasured, Qt::DirectConnection);
 
   return ret;
 
@@ -814,7 +899,17 @@ std::shared_ptr<GstEnginePipeline> GstEngine::CreatePipeline() {
 
 std::shared_ptr<GstEnginePipeline> GstEngine::CreatePipeline(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec) {
 
-  std::shared_ptr<GstEnginePipeline> ret = CreatePipeline();
+  // Use the pipeline that was constructed ahead of time if there is one, so the track change only pays for setting the URL.
+  // Element creation and linking takes long enough on slow machines to be audible in the track-start latency.
+  std::shared_ptr<GstEnginePipeline> ret;
+  if (spare_pipeline_) {
+    ret = spare_pipeline_;
+    spare_pipeline_.reset();
+  }
+  else {
+    ret = CreatePipeline();
+  }
+
   QString error;
   if (!ret->InitFromUrl(media_url, stream_url, gst_url, end_nanosec, error)) {
     ret.reset();
@@ -822,11 +917,29 @@ std::shared_ptr<GstEnginePipeline> GstEngine::CreatePipeline(const QUrl &media_u
     emit StateChanged(EngineBase::State::Error);
     emit FatalError();
   }
+  else if (!stream_url.host().isEmpty() && buffer_targets_by_host_.contains(stream_url.host())) {
+    // This host has underrun before, start out with the buffer target it ended up needing.
+    ret->SetBufferTarget(buffer_targets_by_host_.value(stream_url.host()));
+  }
 
   return ret;
 
 }
 
+void GstEngine::EnsureSparePipeline() {
+
+  if (spare_pipeline_) return;
+
+  spare_pipeline_ = CreatePipeline();
+  QString error;
+  if (!spare_pipeline_->InitPipeline(error)) {
+    // Not fatal, the next Load falls back to constructing a pipeline itself and reports any error then.
+    qLog(Debug) << "Failed to construct spare pipeline:" << error;
+    spare_pipeline_.reset();
+  }
+
+}
+
 void GstEngine::UpdateScope(const int chunk_length) {
 
   using sample_type = EngineBase::Scope::value_type;
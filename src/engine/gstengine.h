@@ -32,8 +32,10 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QAtomicInt>
 #include <QFuture>
 #include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QUrl>
@@ -66,7 +68,7 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   void Stop(const bool stop_after = false) override;
   void Pause() override;
   void Unpause() override;
-  void Seek(const quint64 offset_nanosec) override;
+  void Seek(const quint64 offset_nanosec, const bool fast = false) override;
 
  protected:
   void SetVolumeSW(const uint volume) override;
@@ -121,6 +123,10 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   void BufferingStarted();
   void BufferingProgress(int percent);
   void BufferingFinished();
+  void PipelineBufferTargetChanged(const int pipeline_id, const quint64 target_nanosec);
+
+  // Called on the pipeline's bus thread (direct connection), must only touch the lock-free level ring.
+  void PipelineLevelMeasured(const int pipeline_id, const qint64 endtime_nanosec, const QList<double> &rms_db, const QList<double> &peak_db);
 
  private:
   QByteArray FixupUrl(const QUrl &url);
@@ -134,6 +140,9 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   std::shared_ptr<GstEnginePipeline> CreatePipeline();
   std::shared_ptr<GstEnginePipeline> CreatePipeline(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec);
 
+  // Constructs the spare pipeline if there isn't one already.  Scheduled off the track-start critical path after each Load.
+  void EnsureSparePipeline();
+
   void UpdateScope(int chunk_length);
 
   static void StreamDiscovered(GstDiscoverer*, GstDiscovererInfo *info, GError*, gpointer self);
@@ -156,6 +165,7 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   static const qint64 kTimerIntervalNanosec;
   static const qint64 kPreloadGapNanosec;
   static const qint64 kSeekDelayNanosec;
+  static const int kMaxScopeBuffersInFlight;
 
   TaskManager *task_manager_;
   GstStartup *gst_startup_;
@@ -163,14 +173,24 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
 
   int buffering_task_id_;
 
+  // Buffer targets learned from underruns, keyed by host, so the history survives track changes within a session.
+  QHash<QString, quint64> buffer_targets_by_host_;
+
   std::shared_ptr<GstEnginePipeline> current_pipeline_;
   std::shared_ptr<GstEnginePipeline> fadeout_pipeline_;
   std::shared_ptr<GstEnginePipeline> fadeout_pause_pipeline_;
 
+  // A fully constructed but idle pipeline, built ahead of time so a track change only has to set the URL.
+  // Reset whenever a setting that is baked in at construction time changes.
+  std::shared_ptr<GstEnginePipeline> spare_pipeline_;
+
   QList<GstBufferConsumer*> buffer_consumers_;
 
   GstBuffer *latest_buffer_;
 
+  // Number of buffers handed to ConsumeBuffer that AddBufferToScope has not picked up yet.  Written from the streaming thread.
+  QAtomicInt scope_buffers_in_flight_;
+
   bool stereo_balancer_enabled_;
   float stereo_balance_;
 
@@ -182,6 +202,7 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   QTimer *seek_timer_;
   bool waiting_to_seek_;
   quint64 seek_pos_;
+  bool seek_fast_;
 
   int timer_id_;
 
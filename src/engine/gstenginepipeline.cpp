@@ -25,10 +25,13 @@
 #include <cstdint>
 #include <cstring>
 #include <cmath>
+#include <limits>
 #include <glib.h>
 #include <glib-object.h>
 #include <gst/gst.h>
 #include <gst/audio/audio.h>
+#include <gst/controller/gstinterpolationcontrolsource.h>
+#include <gst/controller/gstdirectcontrolbinding.h>
 
 #include <QtGlobal>
 #include <QObject>
@@ -37,6 +40,8 @@
 #include <QMutex>
 #include <QMetaType>
 #include <QByteArray>
+#include <QFile>
+#include <QElapsedTimer>
 #include <QList>
 #include <QVariant>
 #include <QString>
@@ -47,6 +52,8 @@
 #include <QUuid>
 
 #include "core/logging.h"
+#include "core/playbacklatency.h"
+#include "core/trace.h"
 #include "core/signalchecker.h"
 #include "utilities/timeconstants.h"
 #include "settings/backendsettingspage.h"
@@ -57,6 +64,10 @@
 
 constexpr int GstEnginePipeline::kGstStateTimeoutNanosecs = 10000000;
 constexpr int GstEnginePipeline::kFaderFudgeMsec = 2000;
+constexpr int GstEnginePipeline::kMaxBufferGrowthFactor = 4;
+constexpr int GstEnginePipeline::kFaderCurvePoints = 64;
+
+constexpr quint64 GstEnginePipeline::kLevelMeterIntervalNanosec = 100 * kNsecPerMsec;
 
 constexpr int GstEnginePipeline::kEqBandCount = 10;
 constexpr int GstEnginePipeline::kEqBandFrequencies[] = { 60, 170, 310, 600, 1000, 3000, 6000, 12000, 14000, 16000 };
@@ -74,6 +85,7 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       fading_enabled_(false),
       stereo_balance_(0.0F),
       eq_preamp_(0),
+      eq_preamp_applied_(std::numeric_limits<float>::lowest()),
       rg_mode_(0),
       rg_preamp_(0.0),
       rg_fallbackgain_(0.0),
@@ -82,11 +94,15 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       buffer_low_watermark_(BackendSettingsPage::kDefaultBufferLowWatermark),
       buffer_high_watermark_(BackendSettingsPage::kDefaultBufferHighWatermark),
       buffering_(false),
+      buffer_target_nanosec_(0),
+      buffer_underruns_(0),
+      next_url_prefetch_bytes_(BackendSettingsPage::kDefaultPreloadPrefetchBytes),
       proxy_authentication_(false),
       channels_enabled_(false),
       channels_(0),
       bs2b_enabled_(false),
       strict_ssl_enabled_(false),
+      level_meter_enabled_(false),
       segment_start_(0),
       segment_start_received_(false),
       end_offset_nanosec_(-1),
@@ -97,12 +113,14 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       pipeline_is_initialized_(false),
       pipeline_is_connected_(false),
       pending_seek_nanosec_(-1),
+      pending_seek_fast_(false),
       last_known_position_ns_(0),
       next_uri_set_(false),
       volume_set_(false),
       volume_internal_(-1.0),
       volume_percent_(100),
       use_fudge_timer_(false),
+      fader_control_binding_(nullptr),
       pipeline_(nullptr),
       audiobin_(nullptr),
       audiosink_(nullptr),
@@ -114,7 +132,9 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       audiopanorama_(nullptr),
       equalizer_(nullptr),
       equalizer_preamp_(nullptr),
+      level_meter_(nullptr),
       eventprobe_(nullptr),
+      bufferprobe_(nullptr),
       upstream_events_probe_cb_id_(0),
       buffer_probe_cb_id_(0),
       playbin_probe_cb_id_(0),
@@ -127,7 +147,12 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       about_to_finish_(false) {
 
   eq_band_gains_.reserve(kEqBandCount);
-  for (int i = 0; i < kEqBandCount; ++i) eq_band_gains_ << 0;
+  eq_band_gains_applied_.reserve(kEqBandCount);
+  for (int i = 0; i < kEqBandCount; ++i) {
+    eq_band_gains_ << 0;
+    // Sentinel outside the valid gain range, so the first UpdateEqualizer() writes every band.
+    eq_band_gains_applied_ << std::numeric_limits<float>::lowest();
+  }
 
 }
 
@@ -142,6 +167,8 @@ GstEnginePipeline::~GstEnginePipeline() {
       fader_.reset();
     }
 
+    RemoveFaderControlBinding();
+
     if (element_added_cb_id_ != -1) {
       g_signal_handler_disconnect(G_OBJECT(audiobin_), element_added_cb_id_);
     }
@@ -171,7 +198,7 @@ GstEnginePipeline::~GstEnginePipeline() {
     }
 
     if (buffer_probe_cb_id_ != 0) {
-      GstPad *pad = gst_element_get_static_pad(audioqueueconverter_, "src");
+      GstPad *pad = gst_element_get_static_pad(bufferprobe_, "src");
       if (pad) {
         gst_pad_remove_probe(pad, buffer_probe_cb_id_);
         gst_object_unref(pad);
@@ -249,6 +276,10 @@ void GstEnginePipeline::set_buffer_high_watermark(const double value) {
   buffer_high_watermark_ = value;
 }
 
+void GstEnginePipeline::set_next_url_prefetch_bytes(const qint64 bytes) {
+  next_url_prefetch_bytes_ = bytes;
+}
+
 void GstEnginePipeline::set_proxy_settings(const QString &address, const bool authentication, const QString &user, const QString &pass) {
   proxy_address_ = address;
   proxy_authentication_ = authentication;
@@ -269,6 +300,10 @@ void GstEnginePipeline::set_strict_ssl_enabled(const bool enabled) {
   strict_ssl_enabled_ = enabled;
 }
 
+void GstEnginePipeline::set_level_meter_enabled(const bool enabled) {
+  level_meter_enabled_ = enabled;
+}
+
 void GstEnginePipeline::set_fading_enabled(const bool enabled) {
   fading_enabled_ = enabled;
 }
@@ -289,12 +324,9 @@ GstElement *GstEnginePipeline::CreateElement(const QString &factory_name, const
 
 }
 
-bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, QString &error) {
+bool GstEnginePipeline::InitPipeline(QString &error) {
 
-  media_url_ = media_url;
-  stream_url_ = stream_url;
-  gst_url_ = gst_url;
-  end_offset_nanosec_ = end_nanosec;
+  TRACE_SCOPE("GstEnginePipeline::InitPipeline");
 
   guint version_major = 0, version_minor = 0, version_micro = 0, version_nano = 0;
   gst_plugins_base_version(&version_major, &version_minor, &version_micro, &version_nano);
@@ -333,9 +365,26 @@ bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_ur
   flags &= ~0x00000010;
   g_object_set(G_OBJECT(pipeline_), "flags", flags, nullptr);
 
+  pipeline_is_connected_ = true;
+
+  return true;
+
+}
+
+bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, QString &error) {
+
+  TRACE_SCOPE("GstEnginePipeline::InitFromUrl");
+
+  if (!pipeline_ && !InitPipeline(error)) return false;
+
+  media_url_ = media_url;
+  stream_url_ = stream_url;
+  gst_url_ = gst_url;
+  end_offset_nanosec_ = end_nanosec;
+
   g_object_set(G_OBJECT(pipeline_), "uri", gst_url.constData(), nullptr);
 
-  pipeline_is_connected_ = true;
+  PlaybackLatency::Mark(PlaybackLatency::Stage::PipelineCreated);
 
   return true;
 
@@ -467,6 +516,12 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
     SetupVolume(audiosink_);
   }
 
+  // With every DSP stage disabled there is nothing for the audioconvert elements to do, yet they still negotiate and sit in the chain, which costs CPU on hi-res streams and breaks bit-perfect output for formats the sink accepts natively (such as DSD).
+  // In that case build a minimal passthrough chain that links the queue straight to the sink.
+  // Any enabled DSP stage, a forced channel count or software volume (when the sink has no volume of its own) needs converted raw audio, so the full chain is built instead.
+  // Settings changes rebuild the pipeline, so the decision only has to hold for the lifetime of this audiobin.
+  const bool passthrough = !rg_enabled_ && !eq_enabled_ && !stereo_balancer_enabled_ && !bs2b_enabled_ && !fading_enabled_ && !level_meter_enabled_ && !(volume_enabled_ && !volume_) && !(channels_enabled_ && channels_ > 0);
+
   // Create all the other elements
 
   audioqueue_ = CreateElement("queue2", "audioqueue", audiobin_, error);
@@ -474,14 +529,16 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
     return false;
   }
 
-  audioqueueconverter_ = CreateElement("audioconvert", "audioqueueconverter", audiobin_, error);
-  if (!audioqueueconverter_) {
-    return false;
-  }
-
-  GstElement *audiosinkconverter = CreateElement("audioconvert", "audiosinkconverter", audiobin_, error);
-  if (!audiosinkconverter) {
-    return false;
+  GstElement *audiosinkconverter = nullptr;
+  if (!passthrough) {
+    audioqueueconverter_ = CreateElement("audioconvert", "audioqueueconverter", audiobin_, error);
+    if (!audioqueueconverter_) {
+      return false;
+    }
+    audiosinkconverter = CreateElement("audioconvert", "audiosinkconverter", audiobin_, error);
+    if (!audiosinkconverter) {
+      return false;
+    }
   }
 
   // Create the volume element if it's enabled.
@@ -559,7 +616,7 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
   }
 
   // Create the replaygain elements if it's enabled.
-  eventprobe_ = audioqueueconverter_;
+  eventprobe_ = passthrough ? audioqueue_ : audioqueueconverter_;
   GstElement *rgvolume = nullptr;
   GstElement *rglimiter = nullptr;
   GstElement *rgconverter = nullptr;
@@ -592,6 +649,17 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
     }
   }
 
+  // Create the level meter if it's enabled.
+  // The level element measures RMS and peak in place on the streaming thread and posts the results as bus messages, no buffers are copied.
+  if (level_meter_enabled_) {
+    level_meter_ = CreateElement("level", "level_meter", audiobin_, error);
+    if (!level_meter_) {
+      return false;
+    }
+    g_object_set(G_OBJECT(level_meter_), "interval", kLevelMeterIntervalNanosec, nullptr);
+    g_object_set(G_OBJECT(level_meter_), "post-messages", TRUE, nullptr);
+  }
+
   {  // Create a pad on the outside of the audiobin and connect it to the pad of the first element.
     GstPad *pad = gst_element_get_static_pad(audioqueue_, "sink");
     if (pad) {
@@ -617,102 +685,127 @@ bool GstEnginePipeline::InitAudioBin(QString &error) {
   g_object_set(G_OBJECT(audioqueue_), "max-size-buffers", 0, nullptr);
   g_object_set(G_OBJECT(audioqueue_), "max-size-bytes", 0, nullptr);
   if (buffer_duration_nanosec_ > 0) {
-    qLog(Debug) << "Setting buffer duration:" << buffer_duration_nanosec_ << "low watermark:" << buffer_low_watermark_ << "high watermark:" << buffer_high_watermark_;
+    if (buffer_target_nanosec_ < buffer_duration_nanosec_) buffer_target_nanosec_ = buffer_duration_nanosec_;
+    qLog(Debug) << "Setting buffer duration:" << buffer_target_nanosec_ << "low watermark:" << buffer_low_watermark_ << "high watermark:" << buffer_high_watermark_;
     g_object_set(G_OBJECT(audioqueue_), "use-buffering", true, nullptr);
-    g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_duration_nanosec_, nullptr);
+    g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_target_nanosec_, nullptr);
     g_object_set(G_OBJECT(audioqueue_), "low-watermark", buffer_low_watermark_, nullptr);
     g_object_set(G_OBJECT(audioqueue_), "high-watermark", buffer_high_watermark_, nullptr);
   }
 
   // Link all elements
 
-  if (!gst_element_link(audioqueue_, audioqueueconverter_)) {
-    error = "Failed to link audio queue to audio queue converter.";
-    return false;
-  }
-
-  GstElement *element_link = audioqueueconverter_;  // The next element to link from.
-
-  // Link replaygain elements if enabled.
-  if (rg_enabled_ && rgvolume && rglimiter && rgconverter) {
-    if (!gst_element_link_many(element_link, rgvolume, rglimiter, rgconverter, nullptr)) {
-      error = "Failed to link replaygain volume, limiter and converter elements.";
+  if (passthrough) {
+    // Minimal chain: no conversion and no caps filter, so the sink negotiates directly with the source format.
+    qLog(Debug) << "Bit-perfect passthrough, linking audio queue directly to" << output_;
+    if (!gst_element_link(audioqueue_, audiosink_)) {
+      error = "Failed to link audio queue to audio sink for passthrough.";
       return false;
     }
-    element_link = rgconverter;
   }
 
-  // Link equalizer elements if enabled.
-  if (eq_enabled_ && equalizer_ && equalizer_preamp_) {
-    if (!gst_element_link_many(element_link, equalizer_preamp_, equalizer_, nullptr)) {
-      error = "Failed to link equalizer and equalizer preamp elements.";
+  else {
+
+    if (!gst_element_link(audioqueue_, audioqueueconverter_)) {
+      error = "Failed to link audio queue to audio queue converter.";
       return false;
     }
-    element_link = equalizer_;
-  }
 
-  // Link stereo balancer elements if enabled.
-  if (stereo_balancer_enabled_ && audiopanorama_) {
-    if (!gst_element_link(element_link, audiopanorama_)) {
-      error = "Failed to link audio panorama (stereo balancer).";
-      return false;
+    GstElement *element_link = audioqueueconverter_;  // The next element to link from.
+
+    // Link replaygain elements if enabled.
+    if (rg_enabled_ && rgvolume && rglimiter && rgconverter) {
+      if (!gst_element_link_many(element_link, rgvolume, rglimiter, rgconverter, nullptr)) {
+        error = "Failed to link replaygain volume, limiter and converter elements.";
+        return false;
+      }
+      element_link = rgconverter;
     }
-    element_link = audiopanorama_;
-  }
 
-  // Link software volume element if enabled.
-  if (volume_enabled_ && volume_sw_) {
-    if (!gst_element_link(element_link, volume_sw_)) {
-      error = "Failed to link software volume.";
-      return false;
+    // Link equalizer elements if enabled.
+    if (eq_enabled_ && equalizer_ && equalizer_preamp_) {
+      if (!gst_element_link_many(element_link, equalizer_preamp_, equalizer_, nullptr)) {
+        error = "Failed to link equalizer and equalizer preamp elements.";
+        return false;
+      }
+      element_link = equalizer_;
     }
-    element_link = volume_sw_;
-  }
 
-  // Link fading volume element if enabled.
-  if (fading_enabled_ && volume_fading_) {
-    if (!gst_element_link(element_link, volume_fading_)) {
-      error = "Failed to link fading volume.";
-      return false;
+    // Link stereo balancer elements if enabled.
+    if (stereo_balancer_enabled_ && audiopanorama_) {
+      if (!gst_element_link(element_link, audiopanorama_)) {
+        error = "Failed to link audio panorama (stereo balancer).";
+        return false;
+      }
+      element_link = audiopanorama_;
     }
-    element_link = volume_fading_;
-  }
 
-  // Link bs2b element if enabled.
-  if (bs2b_enabled_ && bs2b) {
-    qLog(Debug) << "Enabling bs2b";
-    if (!gst_element_link(element_link, bs2b)) {
-      error = "Failed to link bs2b.";
-      return false;
+    // Link software volume element if enabled.
+    if (volume_enabled_ && volume_sw_) {
+      if (!gst_element_link(element_link, volume_sw_)) {
+        error = "Failed to link software volume.";
+        return false;
+      }
+      element_link = volume_sw_;
     }
-    element_link = bs2b;
-  }
 
-  if (!gst_element_link(element_link, audiosinkconverter)) {
-    error = "Failed to link audio sink converter.";
-    return false;
-  }
+    // Link fading volume element if enabled.
+    if (fading_enabled_ && volume_fading_) {
+      if (!gst_element_link(element_link, volume_fading_)) {
+        error = "Failed to link fading volume.";
+        return false;
+      }
+      element_link = volume_fading_;
+    }
 
-  {
-    GstCaps *caps = gst_caps_new_empty_simple("audio/x-raw");
-    if (!caps) {
-      error = "Failed to create caps for raw audio.";
-      return false;
+    // Link bs2b element if enabled.
+    if (bs2b_enabled_ && bs2b) {
+      qLog(Debug) << "Enabling bs2b";
+      if (!gst_element_link(element_link, bs2b)) {
+        error = "Failed to link bs2b.";
+        return false;
+      }
+      element_link = bs2b;
     }
-    if (channels_enabled_ && channels_ > 0) {
-      qLog(Debug) << "Setting channels to" << channels_;
-      gst_caps_set_simple(caps, "channels", G_TYPE_INT, channels_, nullptr);
+
+    // Link the level meter if enabled.
+    // It goes last before the sink converter so it measures the fully processed signal.
+    if (level_meter_enabled_ && level_meter_) {
+      if (!gst_element_link(element_link, level_meter_)) {
+        error = "Failed to link level meter.";
+        return false;
+      }
+      element_link = level_meter_;
     }
-    const bool link_filtered_result = gst_element_link_filtered(audiosinkconverter, audiosink_, caps);
-    gst_caps_unref(caps);
-    if (!link_filtered_result) {
-      error = "Failed to link audio sink converter to audio sink with filter for " + output_;
+
+    if (!gst_element_link(element_link, audiosinkconverter)) {
+      error = "Failed to link audio sink converter.";
       return false;
     }
+
+    {
+      GstCaps *caps = gst_caps_new_empty_simple("audio/x-raw");
+      if (!caps) {
+        error = "Failed to create caps for raw audio.";
+        return false;
+      }
+      if (channels_enabled_ && channels_ > 0) {
+        qLog(Debug) << "Setting channels to" << channels_;
+        gst_caps_set_simple(caps, "channels", G_TYPE_INT, channels_, nullptr);
+      }
+      const bool link_filtered_result = gst_element_link_filtered(audiosinkconverter, audiosink_, caps);
+      gst_caps_unref(caps);
+      if (!link_filtered_result) {
+        error = "Failed to link audio sink converter to audio sink with filter for " + output_;
+        return false;
+      }
+    }
+
   }
 
   {  // Add probes and handlers.
-    GstPad *pad = gst_element_get_static_pad(audioqueueconverter_, "src");
+    bufferprobe_ = passthrough ? audioqueue_ : audioqueueconverter_;
+    GstPad *pad = gst_element_get_static_pad(bufferprobe_, "src");
     if (pad) {
       buffer_probe_cb_id_ = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, BufferProbeCallback, this, nullptr);
       gst_object_unref(pad);
@@ -888,7 +981,7 @@ void GstEnginePipeline::PadAddedCallback(GstElement *element, GstPad *pad, gpoin
 
   instance->pipeline_is_connected_ = true;
   if (instance->pending_seek_nanosec_ != -1 && instance->pipeline_is_initialized_) {
-    QMetaObject::invokeMethod(instance, "Seek", Qt::QueuedConnection, Q_ARG(qint64, instance->pending_seek_nanosec_));
+    QMetaObject::invokeMethod(instance, "Seek", Qt::QueuedConnection, Q_ARG(qint64, instance->pending_seek_nanosec_), Q_ARG(bool, instance->pending_seek_fast_));
   }
 
 }
@@ -937,6 +1030,8 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
 
   GstEnginePipeline *instance = reinterpret_cast<GstEnginePipeline*>(self);
 
+  PlaybackLatency::MarkFirstBuffer();
+
   QString format;
   int channels = 1;
   int rate = 0;
@@ -959,7 +1054,17 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
   quint64 duration = GST_BUFFER_DURATION(buf);
   qint64 end_time = static_cast<qint64>(start_time + duration);
 
-  if (format.startsWith("S16LE")) {
+  QList<GstBufferConsumer*> consumers;
+  {
+    QMutexLocker l(&instance->buffer_consumers_mutex_);
+    consumers = instance->buffer_consumers_;
+  }
+
+  // The fan-out below only takes a reference per consumer, the one real copy on this path is the conversion to S16 for the analyzer.
+  // Skip it entirely when nobody is consuming buffers.
+  if (consumers.isEmpty()) {
+  }
+  else if (format.startsWith("S16LE")) {
     instance->logged_unsupported_analyzer_format_ = false;
   }
   else if (format.startsWith("S32LE")) {
@@ -1057,12 +1162,6 @@ GstPadProbeReturn GstEnginePipeline::BufferProbeCallback(GstPad *pad, GstPadProb
     qLog(Error) << "Unsupported audio format for the analyzer" << format;
   }
 
-  QList<GstBufferConsumer*> consumers;
-  {
-    QMutexLocker l(&instance->buffer_consumers_mutex_);
-    consumers = instance->buffer_consumers_;
-  }
-
   for (GstBufferConsumer *consumer : consumers) {
     gst_buffer_ref(buf);
     consumer->ConsumeBuffer(buf, instance->id(), format);
@@ -1254,6 +1353,51 @@ void GstEnginePipeline::ElementMessageReceived(GstMessage *msg) {
     // Set the redirect URL.  In mmssrc redirect messages come during the initial state change to PLAYING, so callers can pick up this URL after the state change has failed.
     redirect_url_ = uri;
   }
+  else if (gst_structure_has_name(structure, "level")) {
+    LevelMessageReceived(msg);
+  }
+
+}
+
+void GstEnginePipeline::LevelMessageReceived(GstMessage *msg) {
+
+  const GstStructure *structure = gst_message_get_structure(msg);
+
+  GstClockTime endtime = GST_CLOCK_TIME_NONE;
+  if (!gst_structure_get_clock_time(structure, "endtime", &endtime)) {
+    endtime = GST_CLOCK_TIME_NONE;
+  }
+  const qint64 endtime_nanosec = endtime == GST_CLOCK_TIME_NONE ? -1 : static_cast<qint64>(endtime);
+
+  QList<double> rms_db;
+  QList<double> peak_db;
+
+  // The level element ships its per-channel values as GValueArrays of doubles.
+  // GValueArray is deprecated in GLib but is still what the element posts.
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+  const GValue *rms_value = gst_structure_get_value(structure, "rms");
+  if (rms_value) {
+    GValueArray *rms_array = reinterpret_cast<GValueArray*>(g_value_get_boxed(rms_value));
+    if (rms_array) {
+      for (guint i = 0; i < rms_array->n_values; ++i) {
+        rms_db << g_value_get_double(g_value_array_get_nth(rms_array, i));
+      }
+    }
+  }
+  const GValue *peak_value = gst_structure_get_value(structure, "peak");
+  if (peak_value) {
+    GValueArray *peak_array = reinterpret_cast<GValueArray*>(g_value_get_boxed(peak_value));
+    if (peak_array) {
+      for (guint i = 0; i < peak_array->n_values; ++i) {
+        peak_db << g_value_get_double(g_value_array_get_nth(peak_array, i));
+      }
+    }
+  }
+G_GNUC_END_IGNORE_DEPRECATIONS
+
+  if (rms_db.isEmpty() && peak_db.isEmpty()) return;
+
+  emit LevelMeasured(id(), endtime_nanosec, rms_db, peak_db);
 
 }
 
@@ -1395,7 +1539,7 @@ void GstEnginePipeline::StateChangedMessageReceived(GstMessage *msg) {
       SetVolume(volume_percent_);
     }
     if (pending_seek_nanosec_ != -1 && pipeline_is_connected_) {
-      QMetaObject::invokeMethod(this, "Seek", Qt::QueuedConnection, Q_ARG(qint64, pending_seek_nanosec_));
+      QMetaObject::invokeMethod(this, "Seek", Qt::QueuedConnection, Q_ARG(qint64, pending_seek_nanosec_), Q_ARG(bool, pending_seek_fast_));
     }
   }
 
@@ -1429,6 +1573,14 @@ void GstEnginePipeline::BufferingMessageReceived(GstMessage *msg) {
     buffering_ = true;
     emit BufferingStarted();
 
+    // The queue drained while playing, so the target was too small for this link.
+    // Grow it for remote sources before refilling, so a slow connection doesn't underrun over and over at the same level.
+    ++buffer_underruns_;
+    if (!stream_url_.isLocalFile() && buffer_duration_nanosec_ > 0) {
+      SetBufferTarget(buffer_target_nanosec_ * 2);
+      emit BufferTargetChanged(id_, buffer_target_nanosec_);
+    }
+
     SetState(GST_STATE_PAUSED);
   }
   else if (percent == 100 && buffering_) {
@@ -1477,7 +1629,7 @@ QFuture<GstStateChangeReturn> GstEnginePipeline::SetState(const GstState state)
   return QtConcurrent::run(&set_state_threadpool_, &gst_element_set_state, pipeline_, state);
 }
 
-bool GstEnginePipeline::Seek(const qint64 nanosec) {
+bool GstEnginePipeline::Seek(const qint64 nanosec, const bool fast) {
 
   if (ignore_next_seek_) {
     ignore_next_seek_ = false;
@@ -1486,18 +1638,45 @@ bool GstEnginePipeline::Seek(const qint64 nanosec) {
 
   if (!pipeline_is_connected_ || !pipeline_is_initialized_) {
     pending_seek_nanosec_ = nanosec;
+    pending_seek_fast_ = fast;
     return true;
   }
 
   if (next_uri_set_) {
     pending_seek_nanosec_ = nanosec;
+    pending_seek_fast_ = fast;
     SetState(GST_STATE_READY);
     return true;
   }
 
   pending_seek_nanosec_ = -1;
   last_known_position_ns_ = nanosec;
-  return gst_element_seek_simple(pipeline_, GST_FORMAT_TIME, GST_SEEK_FLAG_FLUSH, nanosec);
+
+  // Fast seeks go to the nearest frame boundary at or before the requested position instead of asking for a sample accurate seek.
+  // This lets the demuxer jump straight to an indexed position rather than decode towards the exact sample,
+  // which makes scrubbing through long lossless files near-instant.  A FLAC frame is ~100ms, so the inaccuracy is inaudible while dragging.
+  // Track starts, CUE sections and resume positions seek accurately, otherwise the tail of the previous CUE track would be audible.
+  GstSeekFlags flags = GST_SEEK_FLAG_FLUSH;
+  if (fast) {
+    flags = static_cast<GstSeekFlags>(flags | GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_BEFORE);
+  }
+
+  return gst_element_seek_simple(pipeline_, GST_FORMAT_TIME, flags, nanosec);
+
+}
+
+void GstEnginePipeline::SetBufferTarget(const quint64 target_nanosec) {
+
+  if (buffer_duration_nanosec_ == 0) return;
+
+  const quint64 target = qMin(target_nanosec, buffer_duration_nanosec_ * kMaxBufferGrowthFactor);
+  if (target <= buffer_target_nanosec_) return;
+
+  buffer_target_nanosec_ = target;
+  if (audioqueue_) {
+    qLog(Debug) << "Growing buffer target to" << buffer_target_nanosec_ / kNsecPerMsec << "ms after" << buffer_underruns_ << "underruns for" << stream_url_;
+    g_object_set(G_OBJECT(audioqueue_), "max-size-time", buffer_target_nanosec_, nullptr);
+  }
 
 }
 
@@ -1553,7 +1732,9 @@ void GstEnginePipeline::UpdateEqualizer() {
 
   if (!equalizer_ || !equalizer_preamp_) return;
 
-  // Update band gains
+  // Update band gains.
+  // Only bands whose gain actually changed are written: every write makes the element recompute
+  // its filter, which is audible as crackle on weak DSPs when a slider drag rewrites all bands.
   for (int i = 0; i < kEqBandCount; ++i) {
     float gain = eq_enabled_ ? static_cast<float>(eq_band_gains_[i]) : static_cast<float>(0.0);
     if (gain < 0) {
@@ -1563,6 +1744,9 @@ void GstEnginePipeline::UpdateEqualizer() {
       gain *= 0.12F;
     }
 
+    if (qFuzzyCompare(eq_band_gains_applied_[i], gain)) continue;
+    eq_band_gains_applied_[i] = gain;
+
     const int index_in_eq = i + 1;
     // Offset because of the first dummy band we created.
     GstObject *band = GST_OBJECT(gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(equalizer_), index_in_eq));
@@ -1574,7 +1758,10 @@ void GstEnginePipeline::UpdateEqualizer() {
   float preamp = 1.0F;
   if (eq_enabled_) preamp = static_cast<float>(eq_preamp_ + 100) * 0.01F;  // To scale from 0.0 to 2.0
 
-  g_object_set(G_OBJECT(equalizer_preamp_), "volume", preamp, nullptr);
+  if (!qFuzzyCompare(eq_preamp_applied_, preamp)) {
+    eq_preamp_applied_ = preamp;
+    g_object_set(G_OBJECT(equalizer_preamp_), "volume", preamp, nullptr);
+  }
 
 }
 
@@ -1601,22 +1788,87 @@ void GstEnginePipeline::StartFader(const qint64 duration_nanosec, const QTimeLin
     }
     timeline->deleteLater();
   });
-  QObject::connect(fader_.get(), &QTimeLine::valueChanged, this, &GstEnginePipeline::SetFaderVolume);
   QObject::connect(fader_.get(), &QTimeLine::finished, this, &GstEnginePipeline::FaderTimelineFinished);
   fader_->setDirection(direction);
   fader_->setEasingCurve(shape);
   fader_->setCurrentTime(static_cast<int>(start_time));
+
+  // Bind the precomputed curve to the fading volume element, so the ramp is evaluated per buffer on the streaming thread and stays smooth no matter how busy the GUI thread is.
+  // The timeline keeps running alongside, but only as the completion timer and to position a replacement fader.
+  if (!SetupFaderControlBinding(duration_msec, start_time)) {
+    // No control binding, fall back to driving the volume from timeline ticks.
+    QObject::connect(fader_.get(), &QTimeLine::valueChanged, this, &GstEnginePipeline::SetFaderVolume);
+    SetFaderVolume(fader_->currentValue());
+  }
+
   fader_->resume();
 
   fader_fudge_timer_.stop();
   use_fudge_timer_ = use_fudge_timer;
 
-  SetFaderVolume(fader_->currentValue());
+}
+
+bool GstEnginePipeline::SetupFaderControlBinding(const qint64 duration_msec, const qint64 start_time_msec) {
+
+  if (!pipeline_ || !volume_fading_ || duration_msec <= 0) return false;
+
+  RemoveFaderControlBinding();
+
+  const qint64 remaining_msec = fader_->direction() == QTimeLine::Forward ? duration_msec - start_time_msec : start_time_msec;
+  if (remaining_msec <= 0) return false;
+
+  // The volume element evaluates the control points at each buffer's timestamp, which is in the same stream time domain as the position query.
+  // The queried position lags the buffers inside the audio bin slightly, so the curve starts a moment early - inaudible at fade durations.
+  gint64 position = 0;
+  if (!gst_element_query_position(pipeline_, GST_FORMAT_TIME, &position) || position < 0) position = 0;
+
+  GstControlSource *control_source = gst_interpolation_control_source_new();
+  if (!control_source) return false;
+  g_object_set(G_OBJECT(control_source), "mode", GST_INTERPOLATION_MODE_LINEAR, nullptr);
+
+  // Sample the easing curve into control points covering the remaining part of the fade.
+  GstTimedValueControlSource *timed_values = GST_TIMED_VALUE_CONTROL_SOURCE(control_source);
+  const QEasingCurve curve(fader_->easingCurve());
+  for (int i = 0; i <= kFaderCurvePoints; ++i) {
+    const qint64 offset_msec = remaining_msec * i / kFaderCurvePoints;
+    const qint64 timeline_msec = fader_->direction() == QTimeLine::Forward ? start_time_msec + offset_msec : start_time_msec - offset_msec;
+    const qreal value = curve.valueForProgress(static_cast<qreal>(timeline_msec) / static_cast<qreal>(duration_msec));
+    gst_timed_value_control_source_set(timed_values, static_cast<GstClockTime>(position + offset_msec * kNsecPerMsec), value);
+  }
+
+  // The absolute binding maps the control values straight to the property, instead of scaling them to the property's full 0..10 range.
+  fader_control_binding_ = gst_direct_control_binding_new_absolute(GST_OBJECT(volume_fading_), "volume", control_source);
+  gst_object_unref(control_source);
+  if (!fader_control_binding_) return false;
+
+  if (!gst_object_add_control_binding(GST_OBJECT(volume_fading_), fader_control_binding_)) {
+    gst_object_unref(fader_control_binding_);
+    fader_control_binding_ = nullptr;
+    return false;
+  }
+
+  return true;
+
+}
+
+void GstEnginePipeline::RemoveFaderControlBinding() {
+
+  if (!fader_control_binding_) return;
+
+  if (volume_fading_) {
+    gst_object_remove_control_binding(GST_OBJECT(volume_fading_), fader_control_binding_);
+  }
+  fader_control_binding_ = nullptr;
 
 }
 
 void GstEnginePipeline::FaderTimelineFinished() {
 
+  // Drop the control binding and pin the end value, so the volume can be set directly again.
+  const qreal final_value = fader_->currentValue();
+  RemoveFaderControlBinding();
+  SetFaderVolume(final_value);
+
   fader_.reset();
 
   // Wait a little while longer before emitting the finished signal (and probably destroying the pipeline) to account for delays in the audio server/driver.
@@ -1667,12 +1919,45 @@ void GstEnginePipeline::PrepareNextUrl(const QUrl &media_url, const QUrl &stream
   next_beginning_offset_nanosec_ = beginning_nanosec;
   next_end_offset_nanosec_ = end_nanosec;
 
+  // The player calls this well before the current track finishes,
+  // use that head start to pull the beginning of the next file into the OS page cache,
+  // so that when about-to-finish swaps the source the first buffers are served from memory instead of waiting on slow (e.g. network mounted) storage.
+  if (next_url_prefetch_bytes_ > 0 && next_stream_url_.isLocalFile() && next_stream_url_ != prefetched_url_) {
+    prefetched_url_ = next_stream_url_;
+    const QString filename = next_stream_url_.toLocalFile();
+    const qint64 prefetch_bytes = next_url_prefetch_bytes_;
+    (void)QtConcurrent::run([filename, prefetch_bytes]() { PrefetchNextUrl(filename, prefetch_bytes); });
+  }
+
   if (about_to_finish_) {
     SetNextUrl();
   }
 
 }
 
+void GstEnginePipeline::PrefetchNextUrl(const QString &filename, const qint64 max_bytes) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qLog(Debug) << "Unable to prefetch" << filename << file.errorString();
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  qint64 remaining = max_bytes;
+  QByteArray buffer;
+  while (remaining > 0) {
+    buffer = file.read(qMin(remaining, static_cast<qint64>(256 * 1024)));
+    if (buffer.isEmpty()) break;
+    remaining -= buffer.size();
+  }
+
+  qLog(Debug) << "Prefetched" << max_bytes - remaining << "bytes of" << filename << "in" << timer.elapsed() << "ms";
+
+}
+
 void GstEnginePipeline::SetNextUrl() {
 
   if (about_to_finish_ && has_next_valid_url() && !next_uri_set_) {
@@ -69,13 +69,19 @@ class GstEnginePipeline : public QObject {
   void set_buffer_duration_nanosec(const quint64 duration_nanosec);
   void set_buffer_low_watermark(const double value);
   void set_buffer_high_watermark(const double value);
+  void set_next_url_prefetch_bytes(const qint64 bytes);
   void set_proxy_settings(const QString &address, const bool authentication, const QString &user, const QString &pass);
   void set_channels(const bool enabled, const int channels);
   void set_bs2b_enabled(const bool enabled);
   void set_strict_ssl_enabled(const bool enabled);
+  void set_level_meter_enabled(const bool enabled);
   void set_fading_enabled(const bool enabled);
 
-  // Creates the pipeline, returns false on error
+  // Creates the playbin and the audio bin without assigning a URL yet, returns false on error.
+  // GstEngine uses this to construct a pipeline ahead of time, so the next track change only has to set the URL.
+  bool InitPipeline(QString &error);
+
+  // Creates the pipeline (unless InitPipeline was already called) and assigns the URL, returns false on error
   bool InitFromUrl(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, QString &error);
 
   // GstBufferConsumers get fed audio data.  Thread-safe.
@@ -85,11 +91,15 @@ class GstEnginePipeline : public QObject {
 
   // Control the music playback
   QFuture<GstStateChangeReturn> SetState(const GstState state);
-  Q_INVOKABLE bool Seek(const qint64 nanosec);
+  Q_INVOKABLE bool Seek(const qint64 nanosec, const bool fast);
   void SetVolume(const uint volume_percent);
   void SetStereoBalance(const float value);
   void SetEqualizerParams(const int preamp, const QList<int> &band_gains);
 
+  // Grows the buffering target applied to the audio queue, capped at kMaxBufferGrowthFactor times the configured duration.
+  // Only ever grows, a target smaller than the current one is ignored.
+  void SetBufferTarget(const quint64 target_nanosec);
+
   void StartFader(const qint64 duration_nanosec, const QTimeLine::Direction direction = QTimeLine::Forward, const QEasingCurve::Type shape = QEasingCurve::Linear, const bool use_fudge_timer = true);
 
   // If this is set then it will be loaded automatically when playback finishes for gapless playback
@@ -119,6 +129,10 @@ class GstEnginePipeline : public QObject {
   // Don't allow the user to change the playback state (playing/paused) while the pipeline is buffering.
   bool is_buffering() const { return buffering_; }
 
+  // Buffer health, for debugging and for GstEngine's per-host underrun history.
+  quint64 buffer_target_nanosec() const { return buffer_target_nanosec_; }
+  int buffer_underruns() const { return buffer_underruns_; }
+
   QByteArray redirect_url() const { return redirect_url_; }
 
   QString source_device() const { return source_device_; }
@@ -138,9 +152,14 @@ class GstEnginePipeline : public QObject {
   void BufferingStarted();
   void BufferingProgress(const int percent);
   void BufferingFinished();
+  void BufferTargetChanged(const int pipeline_id, const quint64 target_nanosec);
 
   void AboutToFinish();
 
+  // Per-channel RMS and peak levels in decibels, posted by the level element at a fixed interval.
+  // Emitted from the pipeline's bus thread.
+  void LevelMeasured(const int pipeline_id, const qint64 endtime_nanosec, const QList<double> &rms_db, const QList<double> &peak_db);
+
  protected:
   void timerEvent(QTimerEvent*) override;
 
@@ -149,6 +168,11 @@ class GstEnginePipeline : public QObject {
   bool InitAudioBin(QString &error);
   void SetupVolume(GstElement *element);
 
+  // Samples the fader's easing curve into a control source bound to the fading volume element,
+  // so the ramp is applied per buffer on the streaming thread.  Returns false if the binding could not be set up.
+  bool SetupFaderControlBinding(const qint64 duration_msec, const qint64 start_time_msec);
+  void RemoveFaderControlBinding();
+
   // Static callbacks.  The GstEnginePipeline instance is passed in the last argument.
   static GstPadProbeReturn UpstreamEventsProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self);
   static GstPadProbeReturn BufferProbeCallback(GstPad *pad, GstPadProbeInfo *info, gpointer self);
@@ -165,6 +189,7 @@ class GstEnginePipeline : public QObject {
   void TagMessageReceived(GstMessage *msg);
   void ErrorMessageReceived(GstMessage *msg);
   void ElementMessageReceived(GstMessage *msg);
+  void LevelMessageReceived(GstMessage *msg);
   void StateChangedMessageReceived(GstMessage *msg);
   void BufferingMessageReceived(GstMessage *msg);
   void StreamStatusMessageReceived(GstMessage *msg);
@@ -176,14 +201,21 @@ class GstEnginePipeline : public QObject {
   void UpdateStereoBalance();
   void UpdateEqualizer();
 
+  // Reads up to max_bytes from the beginning of the file and throws the data away, priming the OS page cache for the gapless transition.  Runs on a worker thread.
+  static void PrefetchNextUrl(const QString &filename, const qint64 max_bytes);
+
  private slots:
   void FaderTimelineFinished();
 
  private:
   static const int kGstStateTimeoutNanosecs;
   static const int kFaderFudgeMsec;
+  static const int kMaxBufferGrowthFactor;
+  static const int kFaderCurvePoints;
   static const int kEqBandCount;
   static const int kEqBandFrequencies[];
+  // How often the level element posts a measurement.  The element measures in place on the streaming thread, no buffers are copied.
+  static const quint64 kLevelMeterIntervalNanosec;
 
   // Using == to compare two pipelines is a bad idea, because new ones often get created in the same address as old ones.  This ID will be unique for each pipeline.
   // Threading warning: access to the static ID field isn't protected by a mutex because all pipeline creation is currently done in the main thread.
@@ -208,6 +240,9 @@ class GstEnginePipeline : public QObject {
   // Equalizer
   int eq_preamp_;
   QList<int> eq_band_gains_;
+  // Gains as last written to the element, so UpdateEqualizer only touches bands that actually changed.
+  float eq_preamp_applied_;
+  QList<float> eq_band_gains_applied_;
 
   // ReplayGain
   int rg_mode_;
@@ -220,6 +255,14 @@ class GstEnginePipeline : public QObject {
   double buffer_low_watermark_;
   double buffer_high_watermark_;
   bool buffering_;
+  // The max-size-time currently applied to the audio queue.  Starts at buffer_duration_nanosec_ and grows after underruns on remote sources.
+  quint64 buffer_target_nanosec_;
+  // How many times the queue drained while playing.
+  int buffer_underruns_;
+
+  // How much of the next track to read ahead into the page cache when it is queued for gapless playback, 0 disables prefetching.
+  qint64 next_url_prefetch_bytes_;
+  QUrl prefetched_url_;
 
   // Proxy
   QString proxy_address_;
@@ -234,6 +277,7 @@ class GstEnginePipeline : public QObject {
   // Options
   bool bs2b_enabled_;
   bool strict_ssl_enabled_;
+  bool level_meter_enabled_;
 
   // These get called when there is a new audio buffer available
   QList<GstBufferConsumer*> buffer_consumers_;
@@ -273,6 +317,7 @@ class GstEnginePipeline : public QObject {
   bool pipeline_is_initialized_;
   bool pipeline_is_connected_;
   qint64 pending_seek_nanosec_;
+  bool pending_seek_fast_;
 
   // We can only use gst_element_query_position() when the pipeline is in
   // PAUSED nor PLAYING state. Whenever we get a new position (e.g. after a correct call to gst_element_query_position() or after a seek), we store
@@ -289,6 +334,8 @@ class GstEnginePipeline : public QObject {
   std::shared_ptr<QTimeLine> fader_;
   QBasicTimer fader_fudge_timer_;
   bool use_fudge_timer_;
+  // The precomputed fade curve currently bound to volume_fading_, owned by the element while bound.
+  GstControlBinding *fader_control_binding_;
 
   GstElement *pipeline_;
   GstElement *audiobin_;
@@ -301,7 +348,9 @@ class GstEnginePipeline : public QObject {
   GstElement *audiopanorama_;
   GstElement *equalizer_;
   GstElement *equalizer_preamp_;
+  GstElement *level_meter_;
   GstElement *eventprobe_;
+  GstElement *bufferprobe_;
 
   gulong upstream_events_probe_cb_id_;
   gulong buffer_probe_cb_id_;
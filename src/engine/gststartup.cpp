@@ -58,9 +58,16 @@ gpointer GstStartup::GLibMainLoopThreadFunc(gpointer) {
 
 }
 
+QFuture<void> GstStartup::Warmup() {
+
+  static const QFuture<void> future = QtConcurrent::run(&GstStartup::InitializeGStreamer);
+  return future;
+
+}
+
 GstStartup::GstStartup(QObject *parent) : QObject(parent) {
 
-  initializing_ = QtConcurrent::run(&GstStartup::InitializeGStreamer);
+  initializing_ = Warmup();
 
   const QMetaObject *mo = QAbstractEventDispatcher::instance(qApp->thread())->metaObject();
   if (mo && strcmp(mo->className(), "QEventDispatcherGlib") != 0 && strcmp(mo->superClass()->className(), "QEventDispatcherGlib") != 0) {
@@ -36,6 +36,10 @@ class GstStartup : public QObject {
   explicit GstStartup(QObject *parent = nullptr);
   ~GstStartup() override;
 
+  // Kicks off gst_init and the registry scan on a background thread the first time it is called, and returns the same future on every call.
+  // main() calls this right after the QApplication exists, so a cold registry scan overlaps UI construction instead of delaying the first play.
+  static QFuture<void> Warmup();
+
   void EnsureInitialized() { initializing_.waitForFinished(); }
 
  private:
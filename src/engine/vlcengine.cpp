@@ -170,7 +170,9 @@ void VLCEngine::Unpause() {
 
 }
 
-void VLCEngine::Seek(const quint64 offset_nanosec) {
+void VLCEngine::Seek(const quint64 offset_nanosec, const bool fast) {
+
+  Q_UNUSED(fast);
 
   if (!Initialized()) return;
 
@@ -52,7 +52,7 @@ class VLCEngine : public EngineBase {
   void Stop(const bool stop_after = false) override;
   void Pause() override;
   void Unpause() override;
-  void Seek(const quint64 offset_nanosec) override;
+  void Seek(const quint64 offset_nanosec, const bool fast = false) override;
 
  protected:
   void SetVolumeSW(const uint percent) override;
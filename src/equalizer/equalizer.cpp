@@ -42,6 +42,7 @@
 #include <QComboBox>
 #include <QBoxLayout>
 #include <QSettings>
+#include <QTimer>
 
 #include "core/iconloader.h"
 #include "equalizer.h"
@@ -51,14 +52,20 @@
 const char *Equalizer::kGainText[] = { "60", "170", "310", "600", "1k", "3k", "6k", "12k", "14k", "16k" };
 
 const char *Equalizer::kSettingsGroup = "Equalizer";
+const int Equalizer::kParametersChangedTimeoutMsec = 40;
 
 Equalizer::Equalizer(QWidget *parent)
     : QDialog(parent),
       ui_(new Ui_Equalizer),
-      loading_(false) {
+      loading_(false),
+      timer_parameters_changed_(new QTimer(this)) {
 
   ui_->setupUi(this);
 
+  timer_parameters_changed_->setSingleShot(true);
+  timer_parameters_changed_->setInterval(kParametersChangedTimeoutMsec);
+  QObject::connect(timer_parameters_changed_, &QTimer::timeout, this, &Equalizer::EmitParametersChanged);
+
   // Icons
   ui_->preset_del->setIcon(IconLoader::Load("list-remove"));
   ui_->preset_save->setIcon(IconLoader::Load("document-save"));
@@ -315,6 +322,14 @@ void Equalizer::EqualizerEnabledChangedSlot(const bool enabled) {
 void Equalizer::EqualizerParametersChangedSlot() {
 
   if (loading_) return;
+  // The timer is not restarted, so during a drag the parameters go out at most once per interval
+  // and the final position is picked up by the last tick, instead of flooding the pipeline with one update per mouse event.
+  if (!timer_parameters_changed_->isActive()) timer_parameters_changed_->start();
+
+}
+
+void Equalizer::EmitParametersChanged() {
+
   emit EqualizerParametersChanged(preamp_value(), gain_values());
 
 }
@@ -33,6 +33,7 @@
 
 class QWidget;
 class QCloseEvent;
+class QTimer;
 
 class EqualizerSlider;
 class Ui_Equalizer;
@@ -47,6 +48,7 @@ class Equalizer : public QDialog {
   static const int kBands = 10;
   static const char *kGainText[kBands];
   static const char *kSettingsGroup;
+  static const int kParametersChangedTimeoutMsec;
 
   struct Params {
     Params();
@@ -80,6 +82,7 @@ class Equalizer : public QDialog {
   void StereoBalanceSliderChanged(const int value);
   void EqualizerEnabledChangedSlot(const bool enabled);
   void EqualizerParametersChangedSlot();
+  void EmitParametersChanged();
   void PresetChanged(const QString &name);
   void PresetChanged(const int index);
   void SavePreset();
@@ -96,6 +99,8 @@ class Equalizer : public QDialog {
  private:
   Ui_Equalizer *ui_;
   bool loading_;
+  // Coalesces slider movements, so a drag emits the parameters at a bounded rate instead of once per mouse event.
+  QTimer *timer_parameters_changed_;
 
   QString last_preset_;
 
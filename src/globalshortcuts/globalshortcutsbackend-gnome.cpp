@@ -47,7 +47,7 @@ GlobalShortcutsBackendGnome::GlobalShortcutsBackendGnome(GlobalShortcutsManager
       is_connected_(false) {}
 
 bool GlobalShortcutsBackendGnome::IsAvailable() const {
-  return IsGnomeAvailable();
+  return manager_->IsDBusServiceRegistered(kService1) || manager_->IsDBusServiceRegistered(kService2);
 }
 
 bool GlobalShortcutsBackendGnome::IsGnomeAvailable() {
@@ -61,10 +61,10 @@ bool GlobalShortcutsBackendGnome::DoRegister() {
   qLog(Debug) << "Registering";
 
   if (!interface_) {
-    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(kService1)) {
+    if (manager_->IsDBusServiceRegistered(kService1)) {
       interface_ = new OrgGnomeSettingsDaemonMediaKeysInterface(kService1, kPath, QDBusConnection::sessionBus(), this);
     }
-    else if (QDBusConnection::sessionBus().interface()->isServiceRegistered(kService2)) {
+    else if (manager_->IsDBusServiceRegistered(kService2)) {
       interface_ = new OrgGnomeSettingsDaemonMediaKeysInterface(kService2, kPath, QDBusConnection::sessionBus(), this);
     }
   }
@@ -26,6 +26,7 @@
 #include <QDBusReply>
 #include <QDBusObjectPath>
 #include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QKeySequence>
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #  include <QKeyCombination>
@@ -54,16 +55,16 @@ bool GlobalShortcutsBackendKDE::IsKDEAvailable() {
 
 bool GlobalShortcutsBackendKDE::IsAvailable() const {
 
-  return IsKDEAvailable();
+  return manager_->IsDBusServiceRegistered(kKdeService);
 
 }
 
-bool GlobalShortcutsBackendKDE::IsMediaShortcut(const GlobalShortcutsManager::Shortcut &shortcut) const {
+bool GlobalShortcutsBackendKDE::IsMediaShortcut(const QAction *action) const {
 
-  return (shortcut.action->shortcut() == QKeySequence(Qt::Key_MediaPlay) ||
-          shortcut.action->shortcut() == QKeySequence(Qt::Key_MediaStop) ||
-          shortcut.action->shortcut() == QKeySequence(Qt::Key_MediaNext) ||
-          shortcut.action->shortcut() == QKeySequence(Qt::Key_MediaPrevious));
+  return (action->shortcut() == QKeySequence(Qt::Key_MediaPlay) ||
+          action->shortcut() == QKeySequence(Qt::Key_MediaStop) ||
+          action->shortcut() == QKeySequence(Qt::Key_MediaNext) ||
+          action->shortcut() == QKeySequence(Qt::Key_MediaPrevious));
 
 }
 
@@ -72,7 +73,7 @@ bool GlobalShortcutsBackendKDE::DoRegister() {
 
   qLog(Debug) << "Registering";
 
-  if (!QDBusConnection::sessionBus().interface()->isServiceRegistered(kKdeService)) {
+  if (!manager_->IsDBusServiceRegistered(kKdeService)) {
     qLog(Warning) << "KGlobalAccel is not registered";
     return false;
   }
@@ -152,20 +153,41 @@ bool GlobalShortcutsBackendKDE::RegisterShortcut(const GlobalShortcutsManager::S
 
   QList<QKeySequence> active_shortcut = QList<QKeySequence>() << shortcut.action->shortcut();
 
-  const QList<int> result = interface_->setShortcut(action_id, ToIntList(active_shortcut), 0x2);
-  const QList<QKeySequence> result_sequence = ToKeySequenceList(result);
+  // Sent asynchronously so the registrations for all shortcuts are pipelined over the bus in one flush,
+  // instead of paying one blocking round trip per shortcut at startup.
+  QDBusPendingReply<QList<int>> reply = interface_->setShortcut(action_id, ToIntList(active_shortcut), 0x2);
+  QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
+  const QString id = shortcut.id;
+  QAction *action = shortcut.action;
+  QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, id, action, active_shortcut]() {
+    SetShortcutFinished(watcher, id, action, active_shortcut);
+  });
+
+  return true;
+
+}
+
+void GlobalShortcutsBackendKDE::SetShortcutFinished(QDBusPendingCallWatcher *watcher, const QString &id, QAction *action, const QList<QKeySequence> &active_shortcut) {
+
+  QDBusPendingReply<QList<int>> reply = *watcher;
+  watcher->deleteLater();
+
+  if (reply.isError()) {
+    qLog(Error) << "Failed to set shortcut" << id << reply.error().name() << reply.error().message();
+    return;
+  }
+
+  const QList<QKeySequence> result_sequence = ToKeySequenceList(reply.value());
   if (result_sequence == active_shortcut) {
-    qLog(Info) << "Registered shortcut" << shortcut.id << shortcut.action->shortcut();
+    qLog(Info) << "Registered shortcut" << id << action->shortcut();
   }
   else {
     qLog(Error) << "KGlobalAccel returned" << result_sequence << "when setting shortcut" << active_shortcut;
-    if (!result_sequence.isEmpty() && !IsMediaShortcut(shortcut)) {
-      shortcut.action->setShortcut(result_sequence[0]);
+    if (!result_sequence.isEmpty() && !IsMediaShortcut(action)) {
+      action->setShortcut(result_sequence[0]);
     }
   }
 
-  return true;
-
 }
 
 QStringList GlobalShortcutsBackendKDE::GetActionId(const QString &id, const QAction *action) {
@@ -51,7 +51,7 @@ class GlobalShortcutsBackendKDE : public GlobalShortcutsBackend {
   void DoUnregister() override;
 
  private:
-  bool IsMediaShortcut(const GlobalShortcutsManager::Shortcut &shortcut) const;
+  bool IsMediaShortcut(const QAction *action) const;
   bool RegisterShortcut(const GlobalShortcutsManager::Shortcut &shortcut);
   static QStringList GetActionId(const QString &id, const QAction *action);
   static QList<int> ToIntList(const QList<QKeySequence> &sequence_list);
@@ -59,6 +59,7 @@ class GlobalShortcutsBackendKDE : public GlobalShortcutsBackend {
 
  private slots:
   void RegisterFinished(QDBusPendingCallWatcher *watcher);
+  void SetShortcutFinished(QDBusPendingCallWatcher *watcher, const QString &id, QAction *action, const QList<QKeySequence> &active_shortcut);
   void GlobalShortcutPressed(const QString &component_unique, const QString &shortcut_unique, qint64);
 
  private:
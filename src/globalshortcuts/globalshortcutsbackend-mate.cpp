@@ -46,7 +46,7 @@ GlobalShortcutsBackendMate::GlobalShortcutsBackendMate(GlobalShortcutsManager *m
 
 bool GlobalShortcutsBackendMate::IsAvailable() const {
 
-  return IsMateAvailable();
+  return manager_->IsDBusServiceRegistered(kService1) || manager_->IsDBusServiceRegistered(kService2);
 
 }
 
@@ -61,10 +61,10 @@ bool GlobalShortcutsBackendMate::DoRegister() {
   qLog(Debug) << "Registering";
 
   if (!interface_) {
-    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(kService1)) {
+    if (manager_->IsDBusServiceRegistered(kService1)) {
       interface_ = new OrgMateSettingsDaemonMediaKeysInterface(kService1, kPath, QDBusConnection::sessionBus(), this);
     }
-    else if (QDBusConnection::sessionBus().interface()->isServiceRegistered(kService2)) {
+    else if (manager_->IsDBusServiceRegistered(kService2)) {
       interface_ = new OrgMateSettingsDaemonMediaKeysInterface(kService2, kPath, QDBusConnection::sessionBus(), this);
     }
   }
@@ -26,10 +26,19 @@
 #include <QApplication>
 #include <QWidget>
 #include <QString>
+#include <QStringList>
 #include <QAction>
 #include <QShortcut>
 #include <QKeySequence>
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
+#  include <QDBusConnection>
+#  include <QDBusConnectionInterface>
+#  include <QDBusPendingCallWatcher>
+#  include <QDBusPendingReply>
+#endif
+
+#include "core/logging.h"
 #include "globalshortcutsmanager.h"
 #include "globalshortcutsbackend.h"
 
@@ -98,10 +107,47 @@ GlobalShortcutsManager::GlobalShortcutsManager(QWidget *parent) : QWidget(parent
   backends_ << new GlobalShortcutsBackendX11(this, this);
 #endif
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
+  // One async ListNames answers the availability probes of all the D-Bus backends,
+  // instead of each backend doing its own blocking round trip; registration starts when the reply arrives.
+  if (QDBusConnection::sessionBus().isConnected()) {
+    QDBusPendingCall call = QDBusConnection::sessionBus().interface()->asyncCall("ListNames");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this, &GlobalShortcutsManager::DBusServiceNamesReceived);
+  }
+  else {
+    ReloadSettings();
+  }
+#else
   ReloadSettings();
+#endif
 
 }
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
+
+void GlobalShortcutsManager::DBusServiceNamesReceived(QDBusPendingCallWatcher *watcher) {
+
+  QDBusPendingReply<QStringList> reply = *watcher;
+  watcher->deleteLater();
+
+  if (reply.isError()) {
+    qLog(Error) << "ListNames failed:" << reply.error().name() << reply.error().message();
+  }
+  else {
+    const QStringList services = reply.value();
+    dbus_services_.clear();
+    for (const QString &service : services) {
+      dbus_services_.insert(service);
+    }
+  }
+
+  ReloadSettings();
+
+}
+
+#endif  // defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
+
 void GlobalShortcutsManager::ReloadSettings() {
 
   backends_enabled_.clear();
@@ -30,6 +30,7 @@
 #include <QWidget>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QKeySequence>
 #include <QSettings>
@@ -38,6 +39,9 @@
 
 class QShortcut;
 class QAction;
+#ifdef HAVE_DBUS
+class QDBusPendingCallWatcher;
+#endif
 
 class GlobalShortcutsManager : public QWidget {
   Q_OBJECT
@@ -58,6 +62,8 @@ class GlobalShortcutsManager : public QWidget {
   static bool IsKdeAvailable();
   static bool IsGnomeAvailable();
   static bool IsMateAvailable();
+  // Answered from the service name snapshot fetched once at startup, so backend probes don't each do their own bus round trip.
+  bool IsDBusServiceRegistered(const QString &service) const { return dbus_services_.contains(service); }
 #endif  // defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
 
 #ifdef HAVE_X11_GLOBALSHORTCUTS
@@ -97,6 +103,11 @@ class GlobalShortcutsManager : public QWidget {
   void ToggleScrobbling();
   void Love();
 
+ private slots:
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS) && defined(HAVE_DBUS)
+  void DBusServiceNamesReceived(QDBusPendingCallWatcher *watcher);
+#endif
+
  private:
   void AddShortcut(const QString &id, const QString &name, std::function<void()> signal, const QKeySequence &default_key = QKeySequence(0));
   Shortcut AddShortcut(const QString &id, const QString &name, const QKeySequence &default_key);
@@ -106,6 +117,7 @@ class GlobalShortcutsManager : public QWidget {
   QSettings settings_;
   QList<GlobalShortcutsBackend::Type> backends_enabled_;
   QMap<QString, Shortcut> shortcuts_;
+  QSet<QString> dbus_services_;
 };
 
 #endif  // GLOBALSHORTCUTSMANAGER_H
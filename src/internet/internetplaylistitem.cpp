@@ -53,6 +53,7 @@ bool InternetPlaylistItem::InitFromQuery(const SqlRow &query) {
 
   metadata_.InitFromQuery(query, false);
   InitMetadata();
+  InvalidateFilterTextCache();
   return true;
 
 }
@@ -45,7 +45,10 @@ class InternetPlaylistItem : public PlaylistItem {
   Song OriginalMetadata() const override { return metadata_; }
   QUrl Url() const override;
 
-  void SetMetadata(const Song &metadata) override { metadata_ = metadata; }
+  void SetMetadata(const Song &metadata) override {
+    metadata_ = metadata;
+    InvalidateFilterTextCache();
+  }
   void SetArtManual(const QUrl &cover_url) override;
 
  protected:
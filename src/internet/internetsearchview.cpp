@@ -34,13 +34,13 @@
 #include <QWidget>
 #include <QTimer>
 #include <QPair>
+#include <QSet>
 #include <QList>
 #include <QMap>
 #include <QString>
 #include <QStringList>
 #include <QRegularExpression>
 #include <QPixmap>
-#include <QPixmapCache>
 #include <QPainter>
 #include <QPalette>
 #include <QColor>
@@ -65,6 +65,7 @@
 #include <QHideEvent>
 
 #include "core/application.h"
+#include "core/pixmapbudget.h"
 #include "core/mimedata.h"
 #include "core/iconloader.h"
 #include "core/song.h"
@@ -86,6 +87,11 @@
 const int InternetSearchView::kSwapModelsTimeoutMsec = 250;
 const int InternetSearchView::kDelayedSearchTimeoutMs = 200;
 const int InternetSearchView::kArtHeight = 32;
+const int InternetSearchView::kMaxCachedQueries = 20;
+
+namespace {
+constexpr char kPixmapBudgetConsumer[] = "internetsearch";
+}
 
 InternetSearchView::InternetSearchView(QWidget *parent)
     : QWidget(parent),
@@ -389,12 +395,13 @@ void InternetSearchView::TextEdited(const QString &text) {
   const QString trimmed(text.trimmed());
 
   search_error_ = false;
-  cover_loader_tasks_.clear();
+  CancelPendingCoverLoads();
 
   // Add results to the back model, switch models after some delay.
   back_model_->Clear();
   current_model_ = back_model_;
   current_proxy_ = back_proxy_;
+  current_urls_.clear();
   swap_models_timer_->start();
 
   // Cancel the last search (if any) and start the new one.
@@ -411,13 +418,15 @@ void InternetSearchView::TextEdited(const QString &text) {
   else {
     ui_->progressbar->reset();
     last_search_id_ = SearchAsync(trimmed, search_type_);
+    // Answer from the results of a previous search right away, the network response merges on top when it arrives.
+    AddCachedResults(trimmed);
   }
 
 }
 
 void InternetSearchView::SwapModels() {
 
-  cover_loader_tasks_.clear();
+  CancelPendingCoverLoads();
 
   std::swap(front_model_, back_model_);
   std::swap(front_proxy_, back_proxy_);
@@ -480,7 +489,7 @@ int InternetSearchView::SearchAsync(const QString &query, const SearchType type)
 void InternetSearchView::SearchAsync(const int id, const QString &query, const SearchType type) {
 
   const int service_id = service_->Search(query, type);
-  pending_searches_[service_id] = PendingState(id, TokenizeQuery(query));
+  pending_searches_[service_id] = PendingState(id, TokenizeQuery(query), query, type);
 
 }
 
@@ -510,6 +519,8 @@ void InternetSearchView::SearchDone(const int service_id, const SongMap &songs,
     it->pixmap_cache_key_ = PixmapCacheKey(*it);
   }
 
+  CacheResults(state.query_, state.type_, results);
+
   AddResults(search_id, results);
 
 }
@@ -532,10 +543,71 @@ void InternetSearchView::AddResults(const int id, const InternetSearchView::Resu
 
   if (id != last_search_id_ || results.isEmpty()) return;
 
+  // Merge incrementally: skip songs already shown from the local query cache instead of rebuilding the model.
+  ResultList results_new;
+  results_new.reserve(results.count());
+  for (const Result &result : results) {
+    if (current_urls_.contains(result.metadata_.url())) continue;
+    current_urls_ << result.metadata_.url();
+    results_new << result;
+  }
+
   ui_->label_status->clear();
   ui_->progressbar->reset();
   ui_->progressbar->hide();
-  current_model_->AddResults(results);
+  if (!results_new.isEmpty()) {
+    current_model_->AddResults(results_new);
+  }
+
+}
+
+void InternetSearchView::AddCachedResults(const QString &query) {
+
+  // Prefer an exact hit, otherwise take the longest cached query this one extends and filter its results with the new tokens.
+  int cached_index = -1;
+  for (int i = 0; i < cached_queries_.count(); ++i) {
+    const CachedQuery &cached_query = cached_queries_[i];
+    if (cached_query.type_ != search_type_) continue;
+    if (query.startsWith(cached_query.query_, Qt::CaseInsensitive)) {
+      if (cached_index == -1 || cached_query.query_.length() > cached_queries_[cached_index].query_.length()) {
+        cached_index = i;
+      }
+    }
+  }
+  if (cached_index == -1) return;
+
+  const QStringList tokens = TokenizeQuery(query);
+  ResultList results;
+  for (const Result &result : cached_queries_[cached_index].results_) {
+    if (Matches(tokens, result.metadata_.artist() + " " + result.metadata_.album() + " " + result.metadata_.title())) {
+      results << result;
+    }
+  }
+
+  if (!results.isEmpty()) {
+    AddResults(last_search_id_, results);
+  }
+
+}
+
+void InternetSearchView::CacheResults(const QString &query, const SearchType type, const ResultList &results) {
+
+  for (int i = 0; i < cached_queries_.count(); ++i) {
+    if (cached_queries_[i].type_ == type && cached_queries_[i].query_.compare(query, Qt::CaseInsensitive) == 0) {
+      cached_queries_.removeAt(i);
+      break;
+    }
+  }
+
+  CachedQuery cached_query;
+  cached_query.query_ = query;
+  cached_query.type_ = type;
+  cached_query.results_ = results;
+  cached_queries_ << cached_query;
+
+  while (cached_queries_.count() > kMaxCachedQueries) {
+    cached_queries_.removeFirst();
+  }
 
 }
 
@@ -543,6 +615,14 @@ void InternetSearchView::SearchError(const int id, const QString &error) {
 
   if (id != last_search_id_) return;
 
+  // Keep locally cached results on screen if the network search fails, only show the error when there is nothing to show.
+  if (!current_urls_.isEmpty()) {
+    ui_->label_status->clear();
+    ui_->progressbar->reset();
+    ui_->progressbar->hide();
+    return;
+  }
+
   search_error_ = true;
   ui_->label_helptext->setText(error);
   ui_->label_status->clear();
@@ -700,7 +780,7 @@ void InternetSearchView::SetGroupBy(const CollectionModel::Grouping g) {
   // Clear requests: changing "group by" on the models will cause all the items to be removed/added again,
   // so all the QModelIndex here will become invalid. New requests will be created for those
   // songs when they will be displayed again anyway (when InternetSearchItemDelegate::paint will call LazyLoadAlbumCover)
-  cover_loader_tasks_.clear();
+  CancelPendingCoverLoads();
 
   // Update the models
   front_model_->SetGroupBy(g, true);
@@ -801,7 +881,7 @@ QString InternetSearchView::PixmapCacheKey(const InternetSearchView::Result &res
 }
 
 bool InternetSearchView::FindCachedPixmap(const InternetSearchView::Result &result, QPixmap *pixmap) const {
-  return QPixmapCache::find(result.pixmap_cache_key_, pixmap);
+  return PixmapBudget::Find(kPixmapBudgetConsumer, result.pixmap_cache_key_, pixmap);
 }
 
 void InternetSearchView::LazyLoadAlbumCover(const QModelIndex &proxy_index) {
@@ -847,30 +927,53 @@ void InternetSearchView::LazyLoadAlbumCover(const QModelIndex &proxy_index) {
   const InternetSearchView::Result result = item_song->data(InternetSearchModel::Role_Result).value<InternetSearchView::Result>();
 
   QPixmap cached_pixmap;
-  if (QPixmapCache::find(result.pixmap_cache_key_, &cached_pixmap)) {
+  if (PixmapBudget::Find(kPixmapBudgetConsumer, result.pixmap_cache_key_, &cached_pixmap)) {
     item_album->setData(cached_pixmap, Qt::DecorationRole);
   }
+  else if (cover_loader_pending_indexes_.contains(result.pixmap_cache_key_)) {
+    // A load for this cover is already in flight - add this row to its fan-out list instead of fetching the same art again.
+    cover_loader_pending_indexes_[result.pixmap_cache_key_] << source_index;
+  }
   else {
-    quint64 loader_id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options_, result.metadata_);
-    cover_loader_tasks_[loader_id] = qMakePair(source_index, result.pixmap_cache_key_);
+    // High priority because this request came from painting a visible row, so it should not queue behind background prefetches.
+    quint64 loader_id = app_->album_cover_loader()->LoadImageAsync(cover_loader_options_, result.metadata_, AlbumCoverLoader::Priority::High);
+    cover_loader_tasks_[loader_id] = result.pixmap_cache_key_;
+    cover_loader_pending_indexes_[result.pixmap_cache_key_] << source_index;
   }
 
 }
 
+void InternetSearchView::CancelPendingCoverLoads() {
+
+  // The rows these loads were for are being discarded, so tell the loader to drop the work instead of just ignoring the results.
+  if (!cover_loader_tasks_.isEmpty()) {
+    QSet<quint64> ids;
+    for (QMap<quint64, QString>::const_iterator it = cover_loader_tasks_.constBegin(); it != cover_loader_tasks_.constEnd(); ++it) {
+      ids << it.key();
+    }
+    app_->album_cover_loader()->CancelTasks(ids);
+  }
+
+  cover_loader_tasks_.clear();
+  cover_loader_pending_indexes_.clear();
+
+}
+
 void InternetSearchView::AlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultPtr albumcover_result) {
 
   if (!cover_loader_tasks_.contains(id)) return;
 
-  QPair<QModelIndex, QString> cover_loader_task = cover_loader_tasks_.take(id);
-  QModelIndex idx = cover_loader_task.first;
-  QString key = cover_loader_task.second;
+  const QString key = cover_loader_tasks_.take(id);
+  const QList<QModelIndex> indexes = cover_loader_pending_indexes_.take(key);
 
   if (albumcover_result && albumcover_result->success && !albumcover_result->image_scaled.isNull()) {
     QPixmap pixmap = QPixmap::fromImage(albumcover_result->image_scaled);
     if (!pixmap.isNull()) {
-      QPixmapCache::insert(key, pixmap);
+      PixmapBudget::Insert(kPixmapBudgetConsumer, key, pixmap);
     }
-    if (idx.isValid()) {
+    // Fan the one downloaded cover out to every album row that was waiting for it.
+    for (const QModelIndex &idx : indexes) {
+      if (!idx.isValid()) continue;
       QStandardItem *item = front_model_->itemFromIndex(idx);
       if (item) {
         item->setData(albumcover_result->image_scaled, Qt::DecorationRole);
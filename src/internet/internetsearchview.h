@@ -92,10 +92,12 @@ class InternetSearchView : public QWidget {
 
  protected:
   struct PendingState {
-    PendingState() : orig_id_(-1) {}
-    PendingState(int orig_id, const QStringList &tokens) : orig_id_(orig_id), tokens_(tokens) {}
+    PendingState() : orig_id_(-1), type_(SearchType::Artists) {}
+    PendingState(int orig_id, const QStringList &tokens, const QString &query, const SearchType type) : orig_id_(orig_id), tokens_(tokens), query_(query), type_(type) {}
     int orig_id_;
     QStringList tokens_;
+    QString query_;
+    SearchType type_;
 
     bool operator<(const PendingState &b) const {
       return orig_id_ < b.orig_id_;
@@ -122,6 +124,12 @@ class InternetSearchView : public QWidget {
     SearchType type_;
   };
 
+  struct CachedQuery {
+    QString query_;
+    SearchType type_;
+    ResultList results_;
+  };
+
   bool SearchKeyEvent(QKeyEvent *e);
   bool ResultsContextMenuEvent(QContextMenuEvent *e);
 
@@ -134,9 +142,13 @@ class InternetSearchView : public QWidget {
   void SearchError(const int id, const QString &error);
   void CancelSearch(const int id);
 
+  void AddCachedResults(const QString &query);
+  void CacheResults(const QString &query, const SearchType type, const ResultList &results);
+
   QString PixmapCacheKey(const Result &result) const;
   bool FindCachedPixmap(const Result &result, QPixmap *pixmap) const;
   int LoadAlbumCoverAsync(const Result &result);
+  void CancelPendingCoverLoads();
 
  signals:
   void AddToPlaylist(QMimeData*);
@@ -182,6 +194,7 @@ class InternetSearchView : public QWidget {
   static const int kSwapModelsTimeoutMsec;
   static const int kDelayedSearchTimeoutMs;
   static const int kArtHeight;
+  static const int kMaxCachedQueries;
 
  private:
   Application *app_;
@@ -215,8 +228,17 @@ class InternetSearchView : public QWidget {
   QMap<int, DelayedSearch> delayed_searches_;
   QMap<int, PendingState> pending_searches_;
 
+  // Results of recently completed searches, newest last.
+  // Used to answer exact and prefix-extension queries instantly while the network search runs.
+  QList<CachedQuery> cached_queries_;
+  // URLs already shown for the current search, so network responses merge on top of cached results without duplicates.
+  QSet<QUrl> current_urls_;
+
   AlbumCoverLoaderOptions cover_loader_options_;
-  QMap<quint64, QPair<QModelIndex, QString>> cover_loader_tasks_;
+  // One loader task per distinct cover: id maps to the pixmap cache key, and the key maps to every album row waiting for that cover.
+  // A search returning many tracks of one album downloads its art once and fans it out.
+  QMap<quint64, QString> cover_loader_tasks_;
+  QMap<QString, QList<QModelIndex>> cover_loader_pending_indexes_;
 
 };
 Q_DECLARE_METATYPE(InternetSearchView::Result)
@@ -62,6 +62,7 @@ bool AuddLyricsProvider::StartSearch(const int id, const LyricsSearchRequest &re
   url.setQuery(url_query);
   QNetworkRequest req(url);
   req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+  NetworkAccessManager::SetCacheTtl(&req, kDefaultSearchCacheTtlSecs);
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, id, request]() { HandleSearchReply(reply, id, request); });
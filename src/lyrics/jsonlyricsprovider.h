@@ -41,6 +41,9 @@ class JsonLyricsProvider : public LyricsProvider {
   explicit JsonLyricsProvider(const QString &name, const bool enabled, const bool authentication_required, NetworkAccessManager *network, QObject *parent = nullptr);
 
  protected:
+  // Default TTL for caching provider API responses, see NetworkAccessManager::SetCacheTtl().
+  static const int kDefaultSearchCacheTtlSecs = 24 * 60 * 60;
+
   QByteArray ExtractData(QNetworkReply *reply);
   QJsonObject ExtractJsonObj(const QByteArray &data);
   QJsonObject ExtractJsonObj(QNetworkReply *reply);
@@ -23,10 +23,22 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QSettings>
+#include <QStandardPaths>
 #include <QTimer>
 #include <QString>
 
+#include "core/logging.h"
 #include "core/song.h"
+#include "settings/lyricssettingspage.h"
 #include "lyricsfetcher.h"
 #include "lyricsfetchersearch.h"
 #include "lyricssearchrequest.h"
@@ -35,16 +47,37 @@
 using namespace std::chrono_literals;
 
 const int LyricsFetcher::kMaxConcurrentRequests = 5;
+const int LyricsFetcher::kDefaultCacheRefreshDays = 90;
 
 LyricsFetcher::LyricsFetcher(LyricsProviders *lyrics_providers, QObject *parent)
     : QObject(parent),
       lyrics_providers_(lyrics_providers),
       next_id_(0),
-      request_starter_(new QTimer(this)) {
+      request_starter_(new QTimer(this)),
+      cache_filename_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/lyricscache.json"),
+      cache_dirty_(false),
+      cache_flush_timer_(new QTimer(this)) {
 
   request_starter_->setInterval(500ms);
   QObject::connect(request_starter_, &QTimer::timeout, this, &LyricsFetcher::StartRequests);
 
+  QSettings s;
+  s.beginGroup(LyricsSettingsPage::kSettingsGroup);
+  cache_refresh_secs_ = s.value("cache_refresh_days", kDefaultCacheRefreshDays).toLongLong() * 24 * 60 * 60;
+  s.endGroup();
+
+  cache_flush_timer_->setSingleShot(true);
+  cache_flush_timer_->setInterval(10s);
+  QObject::connect(cache_flush_timer_, &QTimer::timeout, this, &LyricsFetcher::WriteCache);
+
+  ReadCache();
+
+}
+
+LyricsFetcher::~LyricsFetcher() {
+
+  if (cache_dirty_) WriteCache();
+
 }
 
 quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title) {
@@ -57,8 +90,32 @@ quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QStrin
   search_request.title = title;
   search_request.title.remove(Song::kTitleRemoveMisc);
 
+  const quint64 id = ++next_id_;
+  const QString key = CacheKey(search_request);
+
+  bool have_fresh_lyrics = false;
+  if (cache_.contains(key)) {
+    const CacheEntry entry = cache_[key];
+    have_fresh_lyrics = QDateTime::currentSecsSinceEpoch() - entry.timestamp < cache_refresh_secs_;
+    // Answer from the cache straight away.
+    // Queued so the signal arrives after the caller has received the request id, the same order a provider reply would have.
+    QMetaObject::invokeMethod(this, [this, id, entry]() { emit LyricsFetched(id, entry.provider, entry.lyrics); }, Qt::QueuedConnection);
+  }
+  if (have_fresh_lyrics) return id;
+
+  // A stale cache entry still gets refreshed in the background, the cached lyrics above just hide the wait.
+
+  if (inflight_searches_.contains(key)) {
+    // The same song is already being searched, wait for that result instead of hitting the providers twice.
+    waiting_ids_[inflight_searches_[key]] << id;
+    return id;
+  }
+
+  inflight_searches_.insert(key, id);
+  search_keys_.insert(id, key);
+
   Request request;
-  request.id = ++next_id_;
+  request.id = id;
   request.search_request = search_request;
   AddRequest(request);
 
@@ -66,6 +123,13 @@ quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QStrin
 
 }
 
+QString LyricsFetcher::CacheKey(const LyricsSearchRequest &search_request) {
+
+  const QString key = search_request.artist.toLower() + "\x1e" + search_request.title.toLower();
+  return QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+
+}
+
 void LyricsFetcher::AddRequest(const Request &request) {
 
   queued_requests_.enqueue(request);
@@ -87,6 +151,10 @@ void LyricsFetcher::Clear() {
   }
   active_requests_.clear();
 
+  inflight_searches_.clear();
+  waiting_ids_.clear();
+  search_keys_.clear();
+
 }
 
 void LyricsFetcher::StartRequests() {
@@ -117,8 +185,17 @@ void LyricsFetcher::SingleSearchFinished(const quint64 request_id, const LyricsS
 
   LyricsFetcherSearch *search = active_requests_.take(request_id);
   search->deleteLater();
+
+  const QString key = search_keys_.take(request_id);
+  if (!key.isEmpty()) inflight_searches_.remove(key);
+
   emit SearchFinished(request_id, results);
 
+  const QList<quint64> waiting_ids = waiting_ids_.take(request_id);
+  for (const quint64 waiting_id : waiting_ids) {
+    emit SearchFinished(waiting_id, results);
+  }
+
 }
 
 void LyricsFetcher::SingleLyricsFetched(const quint64 request_id, const QString &provider, const QString &lyrics) {
@@ -127,6 +204,98 @@ void LyricsFetcher::SingleLyricsFetched(const quint64 request_id, const QString
 
   LyricsFetcherSearch *search = active_requests_.take(request_id);
   search->deleteLater();
+
+  const QString key = search_keys_.take(request_id);
+  if (!key.isEmpty()) {
+    inflight_searches_.remove(key);
+    if (!lyrics.isEmpty()) {
+      CacheEntry entry;
+      entry.provider = provider;
+      entry.lyrics = lyrics;
+      entry.timestamp = QDateTime::currentSecsSinceEpoch();
+      cache_.insert(key, entry);
+      ScheduleCacheWrite();
+    }
+  }
+
   emit LyricsFetched(request_id, provider, lyrics);
 
+  const QList<quint64> waiting_ids = waiting_ids_.take(request_id);
+  for (const quint64 waiting_id : waiting_ids) {
+    emit LyricsFetched(waiting_id, provider, lyrics);
+  }
+
+}
+
+void LyricsFetcher::ReadCache() {
+
+  QFile file(cache_filename_);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return;
+  const QByteArray data = file.readAll();
+  file.close();
+
+  if (data.isEmpty()) return;
+
+  QJsonParseError error;
+  QJsonDocument json_doc = QJsonDocument::fromJson(data, &error);
+  if (error.error != QJsonParseError::NoError || !json_doc.isObject()) {
+    qLog(Error) << "Lyrics cache is missing JSON data.";
+    return;
+  }
+  QJsonValue json_entries = json_doc.object()["entries"];
+  if (!json_entries.isArray()) {
+    qLog(Error) << "Lyrics cache JSON entries is not an array.";
+    return;
+  }
+
+  const QJsonArray json_array = json_entries.toArray();
+  for (const QJsonValue &value : json_array) {
+    if (!value.isObject()) continue;
+    QJsonObject json_obj = value.toObject();
+    if (!json_obj.contains("key") || !json_obj.contains("lyrics")) continue;
+    CacheEntry entry;
+    entry.provider = json_obj["provider"].toString();
+    entry.lyrics = json_obj["lyrics"].toString();
+    entry.timestamp = json_obj["timestamp"].toVariant().toLongLong();
+    cache_.insert(json_obj["key"].toString(), entry);
+  }
+
+  qLog(Debug) << "Loaded" << cache_.count() << "lyrics cache entries from" << cache_filename_;
+
+}
+
+void LyricsFetcher::ScheduleCacheWrite() {
+
+  cache_dirty_ = true;
+  if (!cache_flush_timer_->isActive()) cache_flush_timer_->start();
+
+}
+
+void LyricsFetcher::WriteCache() {
+
+  cache_dirty_ = false;
+
+  QJsonArray json_array;
+  for (QHash<QString, CacheEntry>::const_iterator it = cache_.constBegin(); it != cache_.constEnd(); ++it) {
+    QJsonObject json_obj;
+    json_obj["key"] = it.key();
+    json_obj["provider"] = it.value().provider;
+    json_obj["lyrics"] = it.value().lyrics;
+    json_obj["timestamp"] = it.value().timestamp;
+    json_array << json_obj;
+  }
+  QJsonObject json_obj;
+  json_obj["entries"] = json_array;
+
+  QDir dir;
+  dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QFile file(cache_filename_);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qLog(Error) << "Could not open lyrics cache file" << cache_filename_ << "for writing.";
+    return;
+  }
+  file.write(QJsonDocument(json_obj).toJson(QJsonDocument::Compact));
+  file.close();
+
 }
@@ -44,7 +44,7 @@ class LyricsFetcher : public QObject {
 
  public:
   explicit LyricsFetcher(LyricsProviders *lyrics_providers, QObject *parent = nullptr);
-  ~LyricsFetcher() override {}
+  ~LyricsFetcher() override;
 
   struct Request {
     Request() : id(0) {}
@@ -57,6 +57,9 @@ class LyricsFetcher : public QObject {
 
  private:
   void AddRequest(const Request &request);
+  static QString CacheKey(const LyricsSearchRequest &search_request);
+  void ReadCache();
+  void ScheduleCacheWrite();
 
  signals:
   void LyricsFetched(const quint64 request_id, const QString &provider, const QString &lyrics);
@@ -66,9 +69,18 @@ class LyricsFetcher : public QObject {
   void SingleSearchFinished(const quint64 request_id, const LyricsSearchResults &results);
   void SingleLyricsFetched(const quint64 request_id, const QString &provider, const QString &lyrics);
   void StartRequests();
+  void WriteCache();
 
  private:
+  struct CacheEntry {
+    CacheEntry() : timestamp(0) {}
+    QString provider;
+    QString lyrics;
+    qint64 timestamp;
+  };
+
   static const int kMaxConcurrentRequests;
+  static const int kDefaultCacheRefreshDays;
 
   LyricsProviders *lyrics_providers_;
   quint64 next_id_;
@@ -78,6 +90,19 @@ class LyricsFetcher : public QObject {
 
   QTimer *request_starter_;
 
+  // Lyrics fetched once are kept on disk so replaying a song doesn't hit the rate-limited providers again.
+  // Entries older than the refresh age still get an instant cached answer, followed by a background refresh.
+  QString cache_filename_;
+  QHash<QString, CacheEntry> cache_;
+  bool cache_dirty_;
+  qint64 cache_refresh_secs_;
+  QTimer *cache_flush_timer_;
+
+  // In-flight deduplication: only one search runs per (artist, title), extra requests just wait for its result.
+  QHash<QString, quint64> inflight_searches_;
+  QHash<quint64, QList<quint64>> waiting_ids_;
+  QHash<quint64, QString> search_keys_;
+
 };
 
 #endif  // LYRICSFETCHER_H
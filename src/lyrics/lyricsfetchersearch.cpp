@@ -37,6 +37,21 @@ const int LyricsFetcherSearch::kSearchTimeoutMs = 3000;
 const int LyricsFetcherSearch::kGoodLyricsLength = 60;
 const float LyricsFetcherSearch::kHighScore = 2.5;
 
+namespace {
+
+// Per-provider statistics collected over the lifetime of the process and used to order dispatches,
+// so providers that historically answer with lyrics, and answer fast, are asked first.
+// Only touched from the thread the searches run on, so no locking.
+struct ProviderStats {
+  ProviderStats() : searches(0), successes(0), total_latency_ms(0) {}
+  int searches;
+  int successes;
+  qint64 total_latency_ms;
+};
+QHash<QString, ProviderStats> sProviderStats;
+
+}  // namespace
+
 LyricsFetcherSearch::LyricsFetcherSearch(const quint64 id, const LyricsSearchRequest &request, QObject *parent)
     : QObject(parent),
       id_(id),
@@ -68,6 +83,8 @@ void LyricsFetcherSearch::Start(LyricsProviders *lyrics_providers) {
   QList<LyricsProvider*> lyrics_providers_sorted = lyrics_providers->List();
   std::stable_sort(lyrics_providers_sorted.begin(), lyrics_providers_sorted.end(), ProviderCompareOrder);
 
+  search_timer_.start();
+
   for (LyricsProvider *provider : lyrics_providers_sorted) {
     if (!provider->is_enabled() || !provider->IsAuthenticated()) continue;
     QObject::connect(provider, &LyricsProvider::SearchFinished, this, &LyricsFetcherSearch::ProviderSearchFinished);
@@ -75,6 +92,9 @@ void LyricsFetcherSearch::Start(LyricsProviders *lyrics_providers) {
     const bool success = provider->StartSearch(id, request_);
     if (success) {
       pending_requests_.insert(id, provider);
+      request_start_ms_.insert(id, search_timer_.elapsed());
+      // Counted at dispatch so searches that time out or get cancelled still weigh against the provider.
+      ++sProviderStats[provider->name()].searches;
     }
   }
 
@@ -87,6 +107,13 @@ void LyricsFetcherSearch::ProviderSearchFinished(const int id, const LyricsSearc
   if (!pending_requests_.contains(id)) return;
   LyricsProvider *provider = pending_requests_.take(id);
 
+  const qint64 latency_ms = search_timer_.elapsed() - request_start_ms_.take(id);
+  if (!results.isEmpty()) {
+    ProviderStats &stats = sProviderStats[provider->name()];
+    ++stats.successes;
+    stats.total_latency_ms += latency_ms;
+  }
+
   LyricsSearchResults results_copy(results);
   float higest_score = 0.0;
   for (int i = 0; i < results_copy.count(); ++i) {
@@ -150,7 +177,24 @@ void LyricsFetcherSearch::Cancel() {
 }
 
 bool LyricsFetcherSearch::ProviderCompareOrder(LyricsProvider *a, LyricsProvider *b) {
+
+  const ProviderStats stats_a = sProviderStats.value(a->name());
+  const ProviderStats stats_b = sProviderStats.value(b->name());
+
+  // Without history for both providers, fall back to the configured order.
+  if (stats_a.searches == 0 || stats_b.searches == 0) return a->order() < b->order();
+
+  const double success_rate_a = static_cast<double>(stats_a.successes) / stats_a.searches;
+  const double success_rate_b = static_cast<double>(stats_b.successes) / stats_b.searches;
+  if (success_rate_a != success_rate_b) return success_rate_a > success_rate_b;
+
+  // Same success rate: the provider with the lower average latency goes first.
+  const qint64 avg_latency_a = stats_a.successes > 0 ? stats_a.total_latency_ms / stats_a.successes : kSearchTimeoutMs;
+  const qint64 avg_latency_b = stats_b.successes > 0 ? stats_b.total_latency_ms / stats_b.successes : kSearchTimeoutMs;
+  if (avg_latency_a != avg_latency_b) return avg_latency_a < avg_latency_b;
+
   return a->order() < b->order();
+
 }
 
 bool LyricsFetcherSearch::LyricsSearchResultCompareScore(const LyricsSearchResult &a, const LyricsSearchResult &b) {
@@ -24,6 +24,8 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMap>
 #include <QString>
 
@@ -67,6 +69,10 @@ class LyricsFetcherSearch : public QObject {
   QMap<int, LyricsProvider*> pending_requests_;
   bool cancel_requested_;
 
+  // For the per-provider latency/success statistics that order future dispatches.
+  QElapsedTimer search_timer_;
+  QHash<int, qint64> request_start_ms_;
+
 };
 
 #endif  // LYRICSFETCHERSEARCH_H
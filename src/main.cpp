@@ -91,6 +91,9 @@
 #include "core/commandlineoptions.h"
 #include "core/application.h"
 #include "core/networkproxyfactory.h"
+#ifdef HAVE_GSTREAMER
+#  include "engine/gststartup.h"
+#endif
 #ifdef Q_OS_MACOS
 #  include "core/macsystemtrayicon.h"
 #else
@@ -133,13 +136,6 @@ int main(int argc, char *argv[]) {
   QCoreApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
 #endif
 
-  // This makes us show up nicely in gnome-volume-control
-  g_set_application_name("Strawberry");
-  g_setenv("PULSE_PROP_application.icon_name", "strawberry", TRUE);
-  g_setenv("PULSE_PROP_media.role", "music", TRUE);
-
-  RegisterMetaTypes();
-
   // Initialize logging.  Log levels are set after the commandline options are parsed below.
   logging::Init();
   g_log_set_default_handler(reinterpret_cast<GLogFunc>(&logging::GLog), nullptr);
@@ -153,6 +149,8 @@ int main(int argc, char *argv[]) {
     if (!options.Parse()) return 1;
     logging::SetLevels(options.log_levels());
     if (core_app.isSecondary()) {
+      // A second instance launched just to enqueue files or activate the window stops here -
+      // forward the options to the running instance and exit before any GUI initialization.
       if (options.is_empty()) {
         qLog(Info) << "Strawberry is already running - activating existing window (1)";
       }
@@ -163,6 +161,13 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // This makes us show up nicely in gnome-volume-control
+  g_set_application_name("Strawberry");
+  g_setenv("PULSE_PROP_application.icon_name", "strawberry", TRUE);
+  g_setenv("PULSE_PROP_media.role", "music", TRUE);
+
+  RegisterMetaTypes();
+
 #ifdef Q_OS_MACOS
   // Must happen after QCoreApplication::setOrganizationName().
   setenv("XDG_CONFIG_HOME", QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation).toLocal8Bit().constData(), 1);
@@ -216,6 +221,12 @@ int main(int argc, char *argv[]) {
   }
 #endif
 
+#ifdef HAVE_GSTREAMER
+  // Start the GStreamer registry scan now, so a cold cache scan overlaps the rest of the startup instead of delaying the first play.
+  // The engine waits on the same future before it is used.
+  GstStartup::Warmup();
+#endif
+
   // Gnome on Ubuntu has menu icons disabled by default.  I think that's a bad idea, and makes some menus in Strawberry look confusing.
   QCoreApplication::setAttribute(Qt::AA_DontShowIconsInMenus, false);
 
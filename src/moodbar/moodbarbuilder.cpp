@@ -58,6 +58,21 @@ void MoodbarBuilder::Init(int bands, int rate_hz) {
     barkband_table_.append(barkband);
   }
 
+  // The table is monotonic, so each bark band covers one contiguous range of
+  // spectrum bins.  Remember where each range starts.
+  barkband_starts_.clear();
+  barkband_starts_.reserve(sBarkBandCount + 1);
+  barkband = -1;
+  for (int i = 0; i < barkband_table_.count(); ++i) {
+    while (barkband < static_cast<int>(barkband_table_[i])) {
+      barkband_starts_.append(i);
+      ++barkband;
+    }
+  }
+  while (barkband_starts_.count() < sBarkBandCount + 1) {
+    barkband_starts_.append(barkband_table_.count());
+  }
+
 }
 
 void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
@@ -66,14 +81,18 @@ void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
     return;
   }
 
-  // Calculate total magnitudes for different bark bands.
+  // Calculate total magnitudes for different bark bands.  Each band is one
+  // contiguous run of spectrum bins, so each sum is a plain reduction the
+  // compiler can vectorize instead of a scatter through the lookup table.
   double bands[sBarkBandCount];
-  for (int i = 0; i < sBarkBandCount; ++i) {
-    bands[i] = 0.0;
-  }
-
-  for (int i = 0; i < size; ++i) {
-    bands[barkband_table_[i]] += magnitudes[i];
+  for (int band = 0; band < sBarkBandCount; ++band) {
+    const int start = qMin(barkband_starts_[band], size);
+    const int end = qMin(barkband_starts_[band + 1], size);
+    double sum = 0.0;
+    for (int i = start; i < end; ++i) {
+      sum += magnitudes[i];
+    }
+    bands[band] = sum;
   }
 
   // Now divide the bark bands into thirds and compute their total amplitudes.
@@ -88,10 +107,21 @@ void MoodbarBuilder::AddFrame(const double *magnitudes, int size) {
 
 void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
 
-  double mini = vals->at(0).*member;
-  double maxi = vals->at(0).*member;
-  for (int i = 1; i < vals->count(); i++) {
-    const double value = vals->at(i).*member;
+  const int count = vals->count();
+
+  // Copy the channel into a contiguous buffer once so the reduction passes
+  // below run over packed doubles instead of striding through Rgb structs.
+  QList<double> values;
+  values.reserve(count);
+  for (const Rgb &rgb : *vals) {
+    values.append(rgb.*member);
+  }
+  const double *v = values.constData();
+
+  double mini = v[0];
+  double maxi = v[0];
+  for (int i = 1; i < count; i++) {
+    const double value = v[i];
     if (value > maxi) {
       maxi = value;
     }
@@ -101,10 +131,10 @@ void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
   }
 
   double avg = 0;
-  for (const Rgb &rgb : *vals) {
-    const double value = rgb.*member;
+  for (int i = 0; i < count; ++i) {
+    const double value = v[i];
     if (value != mini && value != maxi) {
-      avg += value / static_cast<double>(vals->count());
+      avg += value / static_cast<double>(count);
     }
   }
 
@@ -112,8 +142,8 @@ void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
   double tb = 0;
   double avgu = 0;
   double avgb = 0;
-  for (const Rgb &rgb : *vals) {
-    const double value = rgb.*member;
+  for (int i = 0; i < count; ++i) {
+    const double value = v[i];
     if (value != mini && value != maxi) {
       if (value > avg) {
         avgu += value;
@@ -132,8 +162,8 @@ void MoodbarBuilder::Normalize(QList<Rgb> *vals, double Rgb::*member) {
   tb = 0;
   double avguu = 0;
   double avgbb = 0;
-  for (const Rgb &rgb : *vals) {
-    const double value = rgb.*member;
+  for (int i = 0; i < count; ++i) {
+    const double value = v[i];
     if (value != mini && value != maxi) {
       if (value > avgu) {
         avguu += value;
@@ -42,6 +42,8 @@ class MoodbarBuilder {
   static void Normalize(QList<Rgb> *vals, double Rgb::*member);
 
   QList<uint> barkband_table_;
+  // First spectrum bin of every bark band, so AddFrame can sum each band as one contiguous run.
+  QList<int> barkband_starts_;
   int bands_;
   int rate_hz_;
 
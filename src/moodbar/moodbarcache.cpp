@@ -0,0 +1,155 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "moodbarcache.h"
+
+#include <QtGlobal>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include "core/logging.h"
+
+const quint32 MoodbarCache::kMagic = 0x4d6f6f64;  // "Mood"
+const quint32 MoodbarCache::kVersion = 1;
+
+// File layout: magic, version, then a sequence of records, each being
+// [quint32 url length][url utf-8][quint32 data length][data].
+// Records are only ever appended, a song that is reanalyzed gets a new record
+// and the index simply points at the newest one.
+
+MoodbarCache::MoodbarCache(const QString &filename, QObject *parent)
+    : QObject(parent),
+      file_(filename) {
+
+  QDir dir(QFileInfo(filename).dir());
+  if (!dir.exists()) dir.mkpath(dir.path());
+
+  Open();
+
+}
+
+MoodbarCache::~MoodbarCache() {
+
+  // QFile unmaps all remaining mappings when it is closed.
+  file_.close();
+
+}
+
+void MoodbarCache::Open() {
+
+  if (!file_.open(QIODevice::ReadWrite)) {
+    qLog(Error) << "Could not open moodbar cache" << file_.fileName() << file_.errorString();
+    return;
+  }
+
+  QDataStream s(&file_);
+
+  if (file_.size() == 0) {
+    s << kMagic << kVersion;
+    return;
+  }
+
+  quint32 magic = 0, version = 0;
+  s >> magic >> version;
+  if (magic != kMagic || version != kVersion) {
+    qLog(Warning) << "Moodbar cache" << file_.fileName() << "has an unknown format, recreating it";
+    file_.resize(0);
+    s << kMagic << kVersion;
+    return;
+  }
+
+  // Build the index by walking the records, the data itself is skipped and
+  // only mapped when it is first looked up.
+  while (!s.atEnd()) {
+    const qint64 record_offset = file_.pos();
+
+    quint32 url_len = 0;
+    s >> url_len;
+    const QByteArray url_utf8 = file_.read(url_len);
+    quint32 data_len = 0;
+    s >> data_len;
+
+    if (url_utf8.size() != static_cast<int>(url_len) || file_.pos() + data_len > file_.size()) {
+      qLog(Warning) << "Moodbar cache" << file_.fileName() << "is truncated at offset" << record_offset << "- dropping the partial record";
+      file_.resize(record_offset);
+      break;
+    }
+
+    Entry entry;
+    entry.offset = file_.pos();
+    entry.size = data_len;
+    entries_[QUrl::fromEncoded(url_utf8)] = entry;
+
+    file_.seek(entry.offset + data_len);
+  }
+
+  file_.seek(file_.size());
+
+}
+
+bool MoodbarCache::Contains(const QUrl &url) const {
+  return entries_.contains(url);
+}
+
+QByteArray MoodbarCache::Lookup(const QUrl &url) {
+
+  if (!entries_.contains(url)) return QByteArray();
+
+  Entry &entry = entries_[url];
+  if (!entry.mapped) {
+    entry.mapped = file_.map(entry.offset, entry.size);
+    if (!entry.mapped) {
+      qLog(Error) << "Could not map moodbar cache record for" << url;
+      return QByteArray();
+    }
+  }
+
+  return QByteArray::fromRawData(reinterpret_cast<const char*>(entry.mapped), entry.size);
+
+}
+
+void MoodbarCache::Insert(const QUrl &url, const QByteArray &data) {
+
+  if (!file_.isOpen() || data.isEmpty()) return;
+
+  const QByteArray url_utf8 = url.toEncoded();
+
+  file_.seek(file_.size());
+  QDataStream s(&file_);
+  s << static_cast<quint32>(url_utf8.size());
+  file_.write(url_utf8);
+  s << static_cast<quint32>(data.size());
+
+  Entry entry;
+  entry.offset = file_.pos();
+  entry.size = data.size();
+
+  if (file_.write(data) != data.size()) {
+    qLog(Error) << "Error writing to moodbar cache" << file_.fileName() << file_.errorString();
+    file_.resize(entry.offset - url_utf8.size() - 2 * static_cast<qint64>(sizeof(quint32)));
+    return;
+  }
+
+  entries_[url] = entry;
+
+}
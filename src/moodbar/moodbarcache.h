@@ -0,0 +1,70 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2026, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MOODBARCACHE_H
+#define MOODBARCACHE_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QFile>
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+// Stores moodbar data for all songs in one append-only file instead of one
+// file per song.  Records are looked up through an in-memory index built by
+// scanning the file once on open, and are memory-mapped on first access so
+// Lookup() returns the bytes without copying them.  Mappings stay valid until
+// the cache is destroyed.
+class MoodbarCache : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit MoodbarCache(const QString &filename, QObject *parent = nullptr);
+  ~MoodbarCache() override;
+
+  bool Contains(const QUrl &url) const;
+
+  // Returns the cached moodbar data for url, or a null QByteArray.  The
+  // returned bytes point directly into the mapped cache file and remain valid
+  // for the lifetime of this object.
+  QByteArray Lookup(const QUrl &url);
+
+  void Insert(const QUrl &url, const QByteArray &data);
+
+ private:
+  struct Entry {
+    Entry() : offset(0), size(0), mapped(nullptr) {}
+    qint64 offset;
+    quint32 size;
+    const uchar *mapped;
+  };
+
+  void Open();
+
+ private:
+  static const quint32 kMagic;
+  static const quint32 kVersion;
+
+  QFile file_;
+  QHash<QUrl, Entry> entries_;
+};
+
+#endif  // MOODBARCACHE_H
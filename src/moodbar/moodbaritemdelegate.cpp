@@ -19,6 +19,7 @@
 
 #include <QApplication>
 #include <QtConcurrentRun>
+#include <QScrollBar>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QAbstractItemModel>
@@ -53,6 +54,7 @@ MoodbarItemDelegate::MoodbarItemDelegate(Application *app, PlaylistView *view, Q
       style_(MoodbarRenderer::MoodbarStyle::Normal) {
 
   QObject::connect(app_, &Application::SettingsChanged, this, &MoodbarItemDelegate::ReloadSettings);
+  QObject::connect(view_->verticalScrollBar(), &QScrollBar::valueChanged, this, &MoodbarItemDelegate::CancelLoadsForHiddenRows);
   ReloadSettings();
 
 }
@@ -145,7 +147,7 @@ void MoodbarItemDelegate::StartLoadingData(const QUrl &url, const bool has_cue,
   // Load a mood file for this song and generate some colors from it
   QByteArray bytes;
   MoodbarPipeline *pipeline = nullptr;
-  switch (app_->moodbar_loader()->Load(url, has_cue, &bytes, &pipeline)) {
+  switch (app_->moodbar_loader()->Load(url, has_cue, &bytes, &pipeline, MoodbarLoader::Priority::VisibleRow)) {
     case MoodbarLoader::Result::CannotLoad:
       data->state_ = Data::State::CannotLoad;
       break;
@@ -163,6 +165,33 @@ void MoodbarItemDelegate::StartLoadingData(const QUrl &url, const bool has_cue,
 
 }
 
+void MoodbarItemDelegate::CancelLoadsForHiddenRows() {
+
+  const QRect viewport_rect(view_->viewport()->rect());
+
+  const QList<QUrl> urls = data_.keys();
+  for (const QUrl &url : urls) {
+    Data *data = data_[url];
+    if (!data || data->state_ != Data::State::LoadingData) continue;
+
+    bool visible = false;
+    for (const QPersistentModelIndex &idx : std::as_const(data->indexes_)) {
+      if (idx.isValid() && view_->visualRect(idx).intersects(viewport_rect)) {
+        visible = true;
+        break;
+      }
+    }
+    if (visible) continue;
+
+    // Only forget rows whose pipeline hadn't started yet - scrolling back will
+    // simply queue them again.
+    if (app_->moodbar_loader()->CancelRequest(url)) {
+      data_.remove(url);
+    }
+  }
+
+}
+
 bool MoodbarItemDelegate::RemoveFromCacheIfIndexesInvalid(const QUrl &url, Data *data) {
 
   QSet<QPersistentModelIndex> indexes = data->indexes_;
@@ -50,6 +50,9 @@ class MoodbarItemDelegate : public QItemDelegate {
  private slots:
   void ReloadSettings();
 
+  // Cancels queued moodbar requests for rows that were scrolled out of view.
+  void CancelLoadsForHiddenRows();
+
   void DataLoaded(const QUrl &url, MoodbarPipeline *pipeline);
   void ColorsLoaded(const QUrl &url, const ColorVector &colors);
   void ImageLoaded(const QUrl &url, const QImage &image);
@@ -17,7 +17,6 @@
 
 #include "moodbarloader.h"
 
-#include <memory>
 #include <chrono>
 
 #include <QtGlobal>
@@ -29,8 +28,6 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QAbstractNetworkCache>
-#include <QNetworkDiskCache>
 #include <QTimer>
 #include <QByteArray>
 #include <QString>
@@ -40,6 +37,7 @@
 #include "core/application.h"
 #include "core/logging.h"
 
+#include "moodbarcache.h"
 #include "moodbarpipeline.h"
 
 #include "settings/moodbarsettingspage.h"
@@ -52,14 +50,11 @@ using namespace std::chrono_literals;
 
 MoodbarLoader::MoodbarLoader(Application *app, QObject *parent)
     : QObject(parent),
-      cache_(new QNetworkDiskCache(this)),
+      cache_(new MoodbarCache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/moodbar/moodbar.cache", this)),
       thread_(new QThread(this)),
       kMaxActiveRequests(qMax(1, QThread::idealThreadCount() / 2)),
       save_(false) {
 
-  cache_->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/moodbar");
-  cache_->setMaximumCacheSize(60 * 1024 * 1024);  // 60MB - enough for 20,000 moodbars
-
   QObject::connect(app, &Application::SettingsChanged, this, &MoodbarLoader::ReloadSettings);
   ReloadSettings();
 
@@ -91,7 +86,32 @@ QStringList MoodbarLoader::MoodFilenames(const QString &song_filename) {
 
 }
 
-MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline) {
+bool MoodbarLoader::HasCachedData(const QUrl &url) const {
+
+  if (!url.isLocalFile()) return false;
+
+  if (cache_->Contains(url)) return true;
+
+  for (const QString &possible_mood_file : MoodFilenames(url.toLocalFile())) {
+    if (QFile::exists(possible_mood_file)) return true;
+  }
+
+  return false;
+
+}
+
+void MoodbarLoader::OfferData(const QUrl &url, const QByteArray &data) {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  if (data.isEmpty() || cache_->Contains(url)) return;
+
+  cache_->Insert(url, data);
+  if (save_) SaveMoodFile(url, data);
+
+}
+
+MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline, const Priority priority) {
 
   if (!url.isLocalFile() || has_cue) {
     return Result::CannotLoad;
@@ -99,6 +119,7 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
 
   // Are we in the middle of loading this moodbar already?
   if (requests_.contains(url)) {
+    Promote(url, priority);
     *async_pipeline = requests_[url];
     return Result::WillLoadAsync;
   }
@@ -121,14 +142,13 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
     }
   }
 
-  // Maybe it exists in the cache?
-  std::unique_ptr<QIODevice> cache_device(cache_->data(url));
-  if (cache_device) {
+  // Maybe it exists in the cache?  The returned bytes point straight into the
+  // mapped cache file, no copy is made.
+  const QByteArray cached_data = cache_->Lookup(url);
+  if (!cached_data.isEmpty()) {
     qLog(Info) << "Loading cached moodbar data for" << filename;
-    *data = cache_device->readAll();
-    if (!data->isEmpty()) {
-      return Result::Loaded;
-    }
+    *data = cached_data;
+    return Result::Loaded;
   }
 
   if (!thread_->isRunning()) thread_->start(QThread::IdlePriority);
@@ -139,7 +159,7 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
   QObject::connect(pipeline, &MoodbarPipeline::Finished, this, [this, pipeline, url]() { RequestFinished(pipeline, url); });
 
   requests_[url] = pipeline;
-  queued_requests_ << url;
+  queued_requests_[static_cast<int>(priority)] << url;
 
   MaybeTakeNextRequest();
 
@@ -148,19 +168,82 @@ MoodbarLoader::Result MoodbarLoader::Load(const QUrl &url, const bool has_cue, Q
 
 }
 
+void MoodbarLoader::SaveMoodFile(const QUrl &url, const QByteArray &data) {
+
+  QList<QString> mood_filenames = MoodFilenames(url.toLocalFile());
+  const QString mood_filename(mood_filenames[0]);
+  QFile mood_file(mood_filename);
+  if (mood_file.open(QIODevice::WriteOnly)) {
+    if (mood_file.write(data) <= 0) {
+      qLog(Error) << "Error writing to mood file" << mood_filename << mood_file.errorString();
+    }
+    mood_file.close();
+#ifdef Q_OS_WIN32
+    if (!SetFileAttributes(reinterpret_cast<LPCTSTR>(mood_filename.utf16()), FILE_ATTRIBUTE_HIDDEN)) {
+      qLog(Warning) << "Error setting hidden attribute for file" << mood_filename;
+    }
+#endif
+  }
+  else {
+    qLog(Error) << "Error opening mood file" << mood_filename << "for writing:" << mood_file.errorString();
+  }
+
+}
+
+void MoodbarLoader::Promote(const QUrl &url, const Priority priority) {
+
+  // Look for the URL in the tiers below the requested one and move it up.
+  const int tier = static_cast<int>(priority);
+  for (int i = tier + 1; i < kPriorityCount; ++i) {
+    if (queued_requests_[i].removeOne(url)) {
+      queued_requests_[tier] << url;
+      return;
+    }
+  }
+
+}
+
+bool MoodbarLoader::CancelRequest(const QUrl &url) {
+
+  Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+  if (!requests_.contains(url) || active_requests_.contains(url)) {
+    return false;
+  }
+
+  // The pipeline may be shared with whoever displays the currently playing
+  // song - never cancel that tier.
+  if (queued_requests_[static_cast<int>(Priority::CurrentSong)].contains(url)) {
+    return false;
+  }
+
+  for (int i = 0; i < kPriorityCount; ++i) {
+    queued_requests_[i].removeOne(url);
+  }
+  requests_.take(url)->deleteLater();
+
+  return true;
+
+}
+
 void MoodbarLoader::MaybeTakeNextRequest() {
 
   Q_ASSERT(QThread::currentThread() == qApp->thread());
 
-  if (active_requests_.count() >= kMaxActiveRequests || queued_requests_.isEmpty()) {
+  if (active_requests_.count() >= kMaxActiveRequests) {
     return;
   }
 
-  const QUrl url = queued_requests_.takeFirst();
-  active_requests_ << url;
+  for (int i = 0; i < kPriorityCount; ++i) {
+    if (queued_requests_[i].isEmpty()) continue;
 
-  qLog(Info) << "Creating moodbar data for" << url.toLocalFile();
-  QMetaObject::invokeMethod(requests_[url], "Start", Qt::QueuedConnection);
+    const QUrl url = queued_requests_[i].takeFirst();
+    active_requests_ << url;
+
+    qLog(Info) << "Creating moodbar data for" << url.toLocalFile();
+    QMetaObject::invokeMethod(requests_[url], "Start", Qt::QueuedConnection);
+    return;
+  }
 
 }
 
@@ -172,36 +255,10 @@ void MoodbarLoader::RequestFinished(MoodbarPipeline *request, const QUrl &url) {
     qLog(Info) << "Moodbar data generated successfully for" << url.toLocalFile();
 
     // Save the data in the cache
-    QNetworkCacheMetaData metadata;
-    metadata.setUrl(url);
-
-    QIODevice *cache_file = cache_->prepare(metadata);
-    if (cache_file) {
-      if (cache_file->write(request->data()) > 0) {
-        cache_->insert(cache_file);
-      }
-    }
+    cache_->Insert(url, request->data());
 
     // Save the data alongside the original as well if we're configured to.
-    if (save_) {
-      QList<QString> mood_filenames = MoodFilenames(url.toLocalFile());
-      const QString mood_filename(mood_filenames[0]);
-      QFile mood_file(mood_filename);
-      if (mood_file.open(QIODevice::WriteOnly)) {
-        if (mood_file.write(request->data()) <= 0) {
-          qLog(Error) << "Error writing to mood file" << mood_filename << mood_file.errorString();
-        }
-        mood_file.close();
-#ifdef Q_OS_WIN32
-        if (!SetFileAttributes(reinterpret_cast<LPCTSTR>(mood_filename.utf16()), FILE_ATTRIBUTE_HIDDEN)) {
-          qLog(Warning) << "Error setting hidden attribute for file" << mood_filename;
-        }
-#endif
-      }
-      else {
-        qLog(Error) << "Error opening mood file" << mood_filename << "for writing:" << mood_file.errorString();
-      }
-    }
+    if (save_) SaveMoodFile(url, request->data());
   }
 
   // Remove the request from the active list and delete it
@@ -28,8 +28,8 @@
 
 class QThread;
 class QByteArray;
-class QNetworkDiskCache;
 class Application;
+class MoodbarCache;
 class MoodbarPipeline;
 
 class MoodbarLoader : public QObject {
@@ -52,7 +52,35 @@ class MoodbarLoader : public QObject {
     WillLoadAsync
   };
 
-  Result Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline);
+  // Queued requests are started highest tier first.  A request that is asked
+  // for again at a higher tier is promoted.
+  enum class Priority {
+    // The song that is playing right now.
+    CurrentSong = 0,
+
+    // Rows that are visible in a playlist.
+    VisibleRow = 1,
+
+    // Speculative work nobody is waiting for yet.
+    Prefetch = 2
+  };
+
+  Result Load(const QUrl &url, const bool has_cue, QByteArray *data, MoodbarPipeline **async_pipeline, const Priority priority = Priority::VisibleRow);
+
+  // Whether moodbar data for this URL is already in the cache or in a .mood
+  // file next to the song, in other words whether Load() would succeed
+  // without analyzing the file.
+  bool HasCachedData(const QUrl &url) const;
+
+  // Stores moodbar data that was produced outside this loader, for example by
+  // a batch analysis pass, so later Load() calls for the URL hit the cache.
+  void OfferData(const QUrl &url, const QByteArray &data);
+
+  // Forgets a queued request whose result is no longer wanted, for example
+  // because its playlist rows were scrolled out of view.  Returns false if the
+  // request already started, was requested for the current song, or doesn't
+  // exist - in those cases it will finish normally.
+  bool CancelRequest(const QUrl &url);
 
  private slots:
   void ReloadSettings();
@@ -62,15 +90,19 @@ class MoodbarLoader : public QObject {
 
  private:
   static QStringList MoodFilenames(const QString &song_filename);
+  void Promote(const QUrl &url, const Priority priority);
+  void SaveMoodFile(const QUrl &url, const QByteArray &data);
 
  private:
-  QNetworkDiskCache *cache_;
+  static const int kPriorityCount = 3;
+
+  MoodbarCache *cache_;
   QThread *thread_;
 
   const int kMaxActiveRequests;
 
   QMap<QUrl, MoodbarPipeline*> requests_;
-  QList<QUrl> queued_requests_;
+  QList<QUrl> queued_requests_[kPriorityCount];
   QSet<QUrl> active_requests_;
 
   bool save_;
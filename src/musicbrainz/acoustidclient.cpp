@@ -29,6 +29,7 @@
 #include <QList>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 #include <QUrl>
 #include <QUrlQuery>
 #include <QtAlgorithms>
@@ -49,11 +50,21 @@
 const char *AcoustidClient::kClientId = "0qjUoxbowg";
 const char *AcoustidClient::kUrl = "https://api.acoustid.org/v2/lookup";
 const int AcoustidClient::kDefaultTimeout = 5000;  // msec
+const int AcoustidClient::kMaxBatchSize = 10;
+const int AcoustidClient::kRequestsDelay = 350;  // msec, the Acoustid webservice allows 3 requests per second
 
 AcoustidClient::AcoustidClient(NetworkAccessManager *network, QObject *parent)
     : QObject(parent),
       network_(network),
-      timeouts_(new NetworkTimeouts(kDefaultTimeout, this)) {}
+      timeouts_(new NetworkTimeouts(kDefaultTimeout, this)),
+      batch_timer_(new QTimer(this)) {
+
+  // The first flush runs at zero interval so every Start() from the same event loop turn lands in the same batch.
+  // After a dispatch the timer is restarted with kRequestsDelay to pace the remaining batches.
+  batch_timer_->setSingleShot(true);
+  QObject::connect(batch_timer_, &QTimer::timeout, this, &AcoustidClient::FlushLookups);
+
+}
 
 AcoustidClient::~AcoustidClient() {
 
@@ -65,41 +76,94 @@ void AcoustidClient::SetTimeout(const int msec) { timeouts_->SetTimeout(msec); }
 
 void AcoustidClient::Start(const int id, const QString &fingerprint, int duration_msec) {
 
+  PendingLookup lookup;
+  lookup.id = id;
+  lookup.fingerprint = fingerprint;
+  lookup.duration_msec = duration_msec;
+  queued_lookups_ << lookup;
+
+  if (!batch_timer_->isActive()) batch_timer_->start(0);
+
+}
+
+void AcoustidClient::FlushLookups() {
+
   using Param = QPair<QString, QString>;
   using ParamList = QList<Param>;
 
-  const ParamList params = ParamList() << Param("format", "json")
-                                       << Param("client", kClientId)
-                                       << Param("duration", QString::number(duration_msec / kMsecPerSec))
-                                       << Param("meta", "recordingids+sources")
-                                       << Param("fingerprint", fingerprint);
+  // One batch per tick.  Dispatching every queued batch at once would exceed the webservice rate limit when tagging a large box set, the timer keeps the requests flowing at the allowed pace instead.
+  if (!queued_lookups_.isEmpty()) {
 
-  QUrlQuery url_query;
-  url_query.setQueryItems(params);
-  QUrl url(kUrl);
-  url.setQuery(url_query);
+    const QList<PendingLookup> batch = queued_lookups_.mid(0, kMaxBatchSize);
+    queued_lookups_ = queued_lookups_.mid(batch.count());
 
-  QNetworkRequest req(url);
-  req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
-  QNetworkReply *reply = network_->get(req);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, id]() { RequestFinished(reply, id); });
-  requests_[id] = reply;
+    ParamList params = ParamList() << Param("format", "json")
+                                   << Param("client", kClientId)
+                                   << Param("meta", "recordingids+sources");
+
+    // Batch lookup syntax: one numbered fingerprint.N/duration.N pair per song, demultiplexed by index in the response.
+    QList<int> ids;
+    ids.reserve(batch.count());
+    for (int i = 0; i < batch.count(); ++i) {
+      params << Param(QString("duration.%1").arg(i), QString::number(batch[i].duration_msec / kMsecPerSec))
+             << Param(QString("fingerprint.%1").arg(i), batch[i].fingerprint);
+      ids << batch[i].id;
+    }
 
-  timeouts_->AddReply(reply);
+    QUrlQuery url_query;
+    url_query.setQueryItems(params);
+
+    // POST because a batch of fingerprints is far too large for a request URL.
+    QNetworkRequest req((QUrl(kUrl)));
+    req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
+    QNetworkReply *reply = network_->post(req, url_query.toString(QUrl::FullyEncoded).toUtf8());
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply]() { RequestFinished(reply); });
+
+    for (const int id : ids) {
+      requests_[id] = reply;
+    }
+    batches_[reply] = ids;
+
+    timeouts_->AddReply(reply);
+
+    // Restarted even when this emptied the queue, so a Start() arriving within the delay is still paced.
+    batch_timer_->start(kRequestsDelay);
+
+  }
 
 }
 
 void AcoustidClient::Cancel(const int id) {
 
-  if (requests_.contains(id)) delete requests_.take(id);
+  for (int i = 0; i < queued_lookups_.count(); ++i) {
+    if (queued_lookups_[i].id == id) {
+      queued_lookups_.removeAt(i);
+      return;
+    }
+  }
+
+  if (!requests_.contains(id)) return;
+  QNetworkReply *reply = requests_.take(id);
+
+  // The id's slot is blanked rather than removed so the remaining ids keep their positions in the batch.
+  QList<int> &ids = batches_[reply];
+  ids.replace(ids.indexOf(id), -1);
+  if (std::all_of(ids.begin(), ids.end(), [](const int i) { return i == -1; })) {
+    batches_.remove(reply);
+    delete reply;
+  }
 
 }
 
 void AcoustidClient::CancelAll() {
 
-  QList<QNetworkReply*> replies = requests_.values();
+  queued_lookups_.clear();
+
+  QList<QNetworkReply*> replies = batches_.keys();
   qDeleteAll(replies);
   requests_.clear();
+  batches_.clear();
 
 }
 
@@ -119,11 +183,50 @@ struct IdSource {
 
 }  // namespace
 
-void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id) {
+// Get the results:
+// -in a first step, gather ids and their corresponding number of sources
+// -then sort results by number of sources (the results are originally
+//  unsorted but results with more sources are likely to be more accurate)
+// -keep only the ids, as sources where useful only to sort the results
+QStringList AcoustidClient::ExtractMbids(const QJsonArray &json_results) {
+
+  // List of <id, nb of sources> pairs
+  QList<IdSource> id_source_list;
+
+  for (const QJsonValue v : json_results) {
+    QJsonObject r = v.toObject();
+    if (!r["recordings"].isUndefined()) {
+      QJsonArray json_recordings = r["recordings"].toArray();
+      for (const QJsonValueRef recording : json_recordings) {
+        QJsonObject o = recording.toObject();
+        if (!o["id"].isUndefined()) {
+          id_source_list << IdSource(o["id"].toString(), o["sources"].toInt());
+        }
+      }
+    }
+  }
+
+  std::stable_sort(id_source_list.begin(), id_source_list.end());
+
+  QStringList id_list;
+  id_list.reserve(id_source_list.count());
+  for (const IdSource &is : id_source_list) {
+    id_list << is.id_;
+  }
+
+  return id_list;
+
+}
+
+void AcoustidClient::RequestFinished(QNetworkReply *reply) {
 
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
-  requests_.remove(request_id);
+
+  const QList<int> ids = batches_.take(reply);
+  for (const int id : ids) {
+    if (id != -1) requests_.remove(id);
+  }
 
   if (reply->error() != QNetworkReply::NoError || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
     if (reply->error() != QNetworkReply::NoError) {
@@ -132,7 +235,9 @@ void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id)
     else {
       qLog(Error) << QString("Acoustid: Received HTTP code %1").arg(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
     }
-    emit Finished(request_id, QStringList());
+    for (const int id : ids) {
+      if (id != -1) emit Finished(id, QStringList());
+    }
     return;
   }
 
@@ -140,7 +245,9 @@ void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id)
   QJsonDocument json_document = QJsonDocument::fromJson(reply->readAll(), &error);
 
   if (error.error != QJsonParseError::NoError) {
-    emit Finished(request_id, QStringList());
+    for (const int id : ids) {
+      if (id != -1) emit Finished(id, QStringList());
+    }
     return;
   }
 
@@ -148,42 +255,35 @@ void AcoustidClient::RequestFinished(QNetworkReply *reply, const int request_id)
 
   QString status = json_object["status"].toString();
   if (status != "ok") {
-    emit Finished(request_id, QStringList(), status);
+    for (const int id : ids) {
+      if (id != -1) emit Finished(id, QStringList(), status);
+    }
     return;
   }
 
-  // Get the results:
-  // -in a first step, gather ids and their corresponding number of sources
-  // -then sort results by number of sources (the results are originally
-  //  unsorted but results with more sources are likely to be more accurate)
-  // -keep only the ids, as sources where useful only to sort the results
-  QJsonArray json_results = json_object["results"].toArray();
-
-  // List of <id, nb of sources> pairs
-  QList<IdSource> id_source_list;
-
-  for (const QJsonValueRef v : json_results) {
-    QJsonObject r = v.toObject();
-    if (!r["recordings"].isUndefined()) {
-      QJsonArray json_recordings = r["recordings"].toArray();
-      for (const QJsonValueRef recording : json_recordings) {
-        QJsonObject o = recording.toObject();
-        if (!o["id"].isUndefined()) {
-          id_source_list << IdSource(o["id"].toString(), o["sources"].toInt());
-        }
-      }
+  // Batch responses carry one entry per fingerprint in a "fingerprints" array, demultiplexed back to the caller ids by index.
+  // Single-lookup responses put the results at the top level, kept as a fallback.
+  if (json_object.contains("fingerprints")) {
+    QList<bool> answered;
+    for (int i = 0; i < ids.count(); ++i) answered << false;
+    const QJsonArray json_fingerprints = json_object["fingerprints"].toArray();
+    for (const QJsonValue v : json_fingerprints) {
+      QJsonObject json_fingerprint = v.toObject();
+      const int index = json_fingerprint["index"].toInt(-1);
+      if (index < 0 || index >= ids.count() || answered[index]) continue;
+      answered[index] = true;
+      if (ids[index] != -1) emit Finished(ids[index], ExtractMbids(json_fingerprint["results"].toArray()));
+    }
+    for (int i = 0; i < ids.count(); ++i) {
+      if (!answered[i] && ids[i] != -1) emit Finished(ids[i], QStringList());
     }
   }
-
-  std::stable_sort(id_source_list.begin(), id_source_list.end());
-
-  QList<QString> id_list;
-  id_list.reserve(id_source_list.count());
-  for (const IdSource &is : id_source_list) {
-    id_list << is.id_;
+  else {
+    const QStringList id_list = ExtractMbids(json_object["results"].toArray());
+    for (const int id : ids) {
+      if (id != -1) emit Finished(id, id_list);
+    }
   }
 
-  emit Finished(request_id, id_list);
-
 }
 
@@ -25,11 +25,15 @@
 #include "config.h"
 
 #include <QObject>
+#include <QHash>
+#include <QList>
 #include <QMap>
 #include <QString>
 #include <QStringList>
 
+class QJsonArray;
 class QNetworkReply;
+class QTimer;
 class NetworkAccessManager;
 class NetworkTimeouts;
 
@@ -50,6 +54,7 @@ class AcoustidClient : public QObject {
   void SetTimeout(const int msec);
 
   // Starts a request and returns immediately.  Finished() will be emitted later with the same ID.
+  // Requests started in the same event loop turn are combined into batch lookups, so starting many at once (like tagging a whole album) costs a handful of round trips instead of one per song.
   void Start(const int id, const QString &fingerprint, int duration_msec);
 
   // Cancels the request with the given ID.  Finished() will never be emitted for that ID.  Does nothing if there is no request with the given ID.
@@ -62,16 +67,35 @@ class AcoustidClient : public QObject {
   void Finished(const int id, const QStringList &mbid_list, const QString &error = QString());
 
  private slots:
-  void RequestFinished(QNetworkReply *reply, const int id);
+  void FlushLookups();
+  void RequestFinished(QNetworkReply *reply);
+
+ private:
+  struct PendingLookup {
+    PendingLookup() : id(-1), duration_msec(0) {}
+    int id;
+    QString fingerprint;
+    int duration_msec;
+  };
+
+  static QStringList ExtractMbids(const QJsonArray &json_results);
 
  private:
   static const char *kClientId;
   static const char *kUrl;
   static const int kDefaultTimeout;
+  static const int kMaxBatchSize;
+  static const int kRequestsDelay;
 
   NetworkAccessManager *network_;
   NetworkTimeouts *timeouts_;
+
+  QList<PendingLookup> queued_lookups_;
+  QTimer *batch_timer_;
+
+  // Each in-flight reply carries a whole batch. The list holds the caller ids in fingerprint.N order, cancelled entries are set to -1 so the positions stay valid for demultiplexing.
   QMap<int, QNetworkReply*> requests_;
+  QHash<QNetworkReply*, QList<int>> batches_;
 
 };
 
@@ -24,8 +24,11 @@
 #include <algorithm>
 
 #include <QObject>
+#include <QDir>
+#include <QFile>
 #include <QSet>
 #include <QList>
+#include <QStandardPaths>
 #include <QVariant>
 #include <QString>
 #include <QStringList>
@@ -37,6 +40,7 @@
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QJsonParseError>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QXmlStreamReader>
@@ -59,17 +63,27 @@ MusicBrainzClient::MusicBrainzClient(QNetworkAccessManager *network, QObject *pa
     : QObject(parent),
       network_(network),
       timeouts_(new NetworkTimeouts(kDefaultTimeout, this)),
-      timer_flush_requests_(new QTimer(this)) {
+      timer_flush_requests_(new QTimer(this)),
+      cache_filename_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/musicbrainzcache.json"),
+      cache_dirty_(false),
+      timer_cache_flush_(new QTimer(this)) {
 
   timer_flush_requests_->setInterval(kRequestsDelay);
   timer_flush_requests_->setSingleShot(true);
   QObject::connect(timer_flush_requests_, &QTimer::timeout, this, &MusicBrainzClient::FlushRequests);
 
+  timer_cache_flush_->setSingleShot(true);
+  timer_cache_flush_->setInterval(10000);
+  QObject::connect(timer_cache_flush_, &QTimer::timeout, this, &MusicBrainzClient::WriteCache);
+
+  ReadCache();
+
 }
 
 MusicBrainzClient::~MusicBrainzClient() {
 
   CancelAll();
+  if (cache_dirty_) WriteCache();
 
 }
 
@@ -135,15 +149,29 @@ void MusicBrainzClient::CancelAll() {
 void MusicBrainzClient::Start(const int id, const QStringList &mbid_list) {
 
   int request_number = 0;
+  bool needs_network = false;
   for (const QString &mbid : mbid_list) {
     ++request_number;
     if (request_number > kMaxRequestPerTrack) break;
+    if (cache_.contains(mbid)) {
+      // Cached lookups answer straight away and never consume a rate limiter slot.
+      pending_results_[id] << PendingResults(request_number, cache_[mbid]);
+      continue;
+    }
     Request request(id, mbid, request_number);
     requests_pending_.insert(id, request);
+    needs_network = true;
+  }
+
+  if (!needs_network) {
+    // All recordings were cached. Queued so the signal arrives after Start() has returned, like a reply would.
+    QMetaObject::invokeMethod(this, [this, id]() { EmitFinished(id); }, Qt::QueuedConnection);
+    return;
   }
 
   if (!timer_flush_requests_->isActive()) {
-    timer_flush_requests_->start();
+    // The rate limiter paces dispatches, it does not delay the first one.
+    FlushRequests();
   }
 
 }
@@ -168,28 +196,49 @@ void MusicBrainzClient::StartDiscIdRequest(const QString &discid) {
 
 void MusicBrainzClient::FlushRequests() {
 
-  if (!requests_.isEmpty() || requests_pending_.isEmpty()) return;
+  // One dispatch per rate limiter tick. Unlike before, a slow reply does not hold the next dispatch back, the timer alone paces the requests.
+  bool dispatched = false;
+  while (!requests_pending_.isEmpty()) {
 
-  Request request = requests_pending_.take(requests_pending_.firstKey());
+    Request request = requests_pending_.take(requests_pending_.firstKey());
 
-  const ParamList params = ParamList() << Param("inc", "artists+releases+media");
+    // A lookup for the same recording under another track id may have completed since this one was queued.
+    if (cache_.contains(request.mbid)) {
+      pending_results_[request.id] << PendingResults(request.number, cache_[request.mbid]);
+      if (!requests_.contains(request.id) && !requests_pending_.contains(request.id)) {
+        EmitFinished(request.id);
+      }
+      continue;
+    }
 
-  QUrlQuery url_query;
-  url_query.setQueryItems(params);
-  QUrl url(kTrackUrl + request.mbid);
-  url.setQuery(url_query);
+    const ParamList params = ParamList() << Param("inc", "artists+releases+media");
 
-  QNetworkRequest req(url);
-  req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
-  QNetworkReply *reply = network_->get(req);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { RequestFinished(reply, request.id, request.number); });
-  requests_.insert(request.id, reply);
+    QUrlQuery url_query;
+    url_query.setQueryItems(params);
+    QUrl url(kTrackUrl + request.mbid);
+    url.setQuery(url_query);
 
-  timeouts_->AddReply(reply);
+    QNetworkRequest req(url);
+    req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+    QNetworkReply *reply = network_->get(req);
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { RequestFinished(reply, request.id, request.mbid, request.number); });
+    requests_.insert(request.id, reply);
+
+    timeouts_->AddReply(reply);
+
+    dispatched = true;
+    break;
+
+  }
+
+  // Restarted even when the queue is empty so a Start() arriving within the delay is still paced.
+  if (dispatched) {
+    timer_flush_requests_->start();
+  }
 
 }
 
-void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, const int request_number) {
+void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, const QString &mbid, const int request_number) {
 
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
@@ -199,7 +248,7 @@ void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, cons
     qLog(Debug) << "MusicBrainz: Unknown reply received:" << nb_removed << "requests removed, while only one was supposed to be removed";
   }
 
-  if (!timer_flush_requests_->isActive() && requests_.isEmpty() && !requests_pending_.isEmpty()) {
+  if (!timer_flush_requests_->isActive() && !requests_pending_.isEmpty()) {
     timer_flush_requests_->start();
   }
 
@@ -219,19 +268,120 @@ void MusicBrainzClient::RequestFinished(QNetworkReply *reply, const int id, cons
       }
     }
     pending_results_[id] << PendingResults(request_number, res);
+
+    // Successful lookups (even ones without usable tracks) go into the cache, errors do not.
+    cache_.insert(mbid, res);
+    ScheduleCacheWrite();
   }
 
   // No more pending requests for this id: emit the results we have.
   if (!requests_.contains(id) && !requests_pending_.contains(id)) {
-    // Merge the results we have
-    ResultList ret;
-    QList<PendingResults> result_list_list = pending_results_.take(id);
-    std::sort(result_list_list.begin(), result_list_list.end());
-    for (const PendingResults &result_list : result_list_list) {
-      ret << result_list.results_;
+    EmitFinished(id, error);
+  }
+
+}
+
+void MusicBrainzClient::EmitFinished(const int id, const QString &error) {
+
+  // Merge the results we have
+  ResultList ret;
+  QList<PendingResults> result_list_list = pending_results_.take(id);
+  std::sort(result_list_list.begin(), result_list_list.end());
+  for (const PendingResults &result_list : result_list_list) {
+    ret << result_list.results_;
+  }
+  emit Finished(id, UniqueResults(ret, UniqueResultsSortOption::KeepOriginalOrder), error);
+
+}
+
+void MusicBrainzClient::ReadCache() {
+
+  QFile file(cache_filename_);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return;
+  const QByteArray data = file.readAll();
+  file.close();
+
+  if (data.isEmpty()) return;
+
+  QJsonParseError json_error;
+  QJsonDocument json_doc = QJsonDocument::fromJson(data, &json_error);
+  if (json_error.error != QJsonParseError::NoError || !json_doc.isObject()) {
+    qLog(Error) << "MusicBrainz cache is missing JSON data.";
+    return;
+  }
+  QJsonValue json_entries = json_doc.object()["entries"];
+  if (!json_entries.isArray()) {
+    qLog(Error) << "MusicBrainz cache JSON entries is not an array.";
+    return;
+  }
+
+  const QJsonArray json_array = json_entries.toArray();
+  for (const QJsonValue &value : json_array) {
+    if (!value.isObject()) continue;
+    QJsonObject json_obj = value.toObject();
+    if (!json_obj.contains("mbid") || !json_obj["results"].isArray()) continue;
+    ResultList results;
+    const QJsonArray json_results = json_obj["results"].toArray();
+    for (const QJsonValue &json_result_value : json_results) {
+      QJsonObject json_result = json_result_value.toObject();
+      Result result;
+      result.title_ = json_result["title"].toString();
+      result.artist_ = json_result["artist"].toString();
+      result.album_ = json_result["album"].toString();
+      result.duration_msec_ = json_result["duration_msec"].toInt();
+      result.track_ = json_result["track"].toInt();
+      result.year_ = json_result["year"].toInt(-1);
+      results << result;
     }
-    emit Finished(id, UniqueResults(ret, UniqueResultsSortOption::KeepOriginalOrder), error);
+    cache_.insert(json_obj["mbid"].toString(), results);
+  }
+
+  qLog(Debug) << "Loaded" << cache_.count() << "MusicBrainz cache entries from" << cache_filename_;
+
+}
+
+void MusicBrainzClient::ScheduleCacheWrite() {
+
+  cache_dirty_ = true;
+  if (!timer_cache_flush_->isActive()) timer_cache_flush_->start();
+
+}
+
+void MusicBrainzClient::WriteCache() {
+
+  cache_dirty_ = false;
+
+  QJsonArray json_array;
+  for (QHash<QString, ResultList>::const_iterator it = cache_.constBegin(); it != cache_.constEnd(); ++it) {
+    QJsonArray json_results;
+    for (const Result &result : it.value()) {
+      QJsonObject json_result;
+      json_result["title"] = result.title_;
+      json_result["artist"] = result.artist_;
+      json_result["album"] = result.album_;
+      json_result["duration_msec"] = result.duration_msec_;
+      json_result["track"] = result.track_;
+      json_result["year"] = result.year_;
+      json_results << json_result;
+    }
+    QJsonObject json_obj;
+    json_obj["mbid"] = it.key();
+    json_obj["results"] = json_results;
+    json_array << json_obj;
+  }
+  QJsonObject json_obj;
+  json_obj["entries"] = json_array;
+
+  QDir dir;
+  dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  QFile file(cache_filename_);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qLog(Error) << "Could not open MusicBrainz cache file" << cache_filename_ << "for writing.";
+    return;
   }
+  file.write(QJsonDocument(json_obj).toJson(QJsonDocument::Compact));
+  file.close();
 
 }
 
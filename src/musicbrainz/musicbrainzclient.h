@@ -26,6 +26,7 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QMultiMap>
@@ -108,8 +109,9 @@ class MusicBrainzClient : public QObject {
  private slots:
   void FlushRequests();
   // id identifies the track, and request_number means it's the 'request_number'th request for this track
-  void RequestFinished(QNetworkReply *reply, const int id, const int request_number);
+  void RequestFinished(QNetworkReply *reply, const int id, const QString &mbid, const int request_number);
   void DiscIdRequestFinished(const QString &discid, QNetworkReply *reply);
+  void WriteCache();
 
  private:
   using Param = QPair<QString, QString>;
@@ -199,6 +201,10 @@ class MusicBrainzClient : public QObject {
   static ResultList UniqueResults(const ResultList &results, UniqueResultsSortOption opt = UniqueResultsSortOption::SortResults);
   static void Error(const QString &error, const QVariant &debug = QVariant());
 
+  void EmitFinished(const int id, const QString &error = QString());
+  void ReadCache();
+  void ScheduleCacheWrite();
+
  private:
 
   static const char *kTrackUrl;
@@ -216,6 +222,13 @@ class MusicBrainzClient : public QObject {
   QMap<int, QList<PendingResults>> pending_results_;
   QTimer *timer_flush_requests_;
 
+  // Parsed recording lookups keyed by MBID, kept on disk so re-tagging overlapping albums never repeats a lookup.
+  // The rate limiter only applies to cache misses.
+  QString cache_filename_;
+  QHash<QString, ResultList> cache_;
+  bool cache_dirty_;
+  QTimer *timer_cache_flush_;
+
 };
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -21,8 +21,6 @@
 
 #include "config.h"
 
-#include <algorithm>
-
 #include <QObject>
 #include <QtConcurrentMap>
 #include <QFuture>
@@ -30,17 +28,19 @@
 #include <QString>
 
 #include "core/networkaccessmanager.h"
+#include "collection/collectionbackend.h"
 #include "utilities/timeconstants.h"
 #include "engine/chromaprinter.h"
 #include "acoustidclient.h"
 #include "musicbrainzclient.h"
 #include "tagfetcher.h"
 
-TagFetcher::TagFetcher(NetworkAccessManager *network, QObject *parent)
+TagFetcher::TagFetcher(NetworkAccessManager *network, CollectionBackend *collection_backend, QObject *parent)
     : QObject(parent),
       fingerprint_watcher_(nullptr),
       acoustid_client_(new AcoustidClient(network, this)),
-      musicbrainz_client_(new MusicBrainzClient(network, this)) {
+      musicbrainz_client_(new MusicBrainzClient(network, this)),
+      collection_backend_(collection_backend) {
 
   QObject::connect(acoustid_client_, &AcoustidClient::Finished, this, &TagFetcher::PuidsFound);
   QObject::connect(musicbrainz_client_, &MusicBrainzClient::Finished, this, &TagFetcher::TagsFetched);
@@ -57,26 +57,26 @@ void TagFetcher::StartFetch(const SongList &songs) {
 
   songs_ = songs;
 
-  bool have_fingerprints = true;
-  if (std::any_of(songs.begin(), songs.end(), [](const Song &song) { return song.fingerprint().isEmpty(); })) {
-    have_fingerprints = false;
-  }
-
-  if (have_fingerprints) {
-    for (int i = 0; i < songs_.count(); ++i) {
-      const Song &song = songs_[i];
+  // Only decode songs that are missing a fingerprint, songs fingerprinted earlier go straight to identification.
+  SongList songs_to_fingerprint;
+  for (int i = 0; i < songs_.count(); ++i) {
+    const Song &song = songs_[i];
+    if (song.fingerprint().isEmpty()) {
+      fingerprint_indexes_ << i;
+      songs_to_fingerprint << song;
+      emit Progress(song, tr("Fingerprinting song"));
+    }
+    else {
       emit Progress(song, tr("Identifying song"));
       acoustid_client_->Start(i, song.fingerprint(), static_cast<int>(song.length_nanosec() / kNsecPerMsec));
     }
   }
-  else {
-    QFuture<QString> future = QtConcurrent::mapped(songs_, GetFingerprint);
+
+  if (!songs_to_fingerprint.isEmpty()) {
+    QFuture<QString> future = QtConcurrent::mapped(songs_to_fingerprint, GetFingerprint);
     fingerprint_watcher_ = new QFutureWatcher<QString>(this);
     QObject::connect(fingerprint_watcher_, &QFutureWatcher<QString>::resultReadyAt, this, &TagFetcher::FingerprintFound);
     fingerprint_watcher_->setFuture(future);
-    for (const Song &song : songs_) {
-      emit Progress(song, tr("Fingerprinting song"));
-    }
   }
 
 }
@@ -93,24 +93,31 @@ void TagFetcher::Cancel() {
   acoustid_client_->CancelAll();
   musicbrainz_client_->CancelAll();
   songs_.clear();
+  fingerprint_indexes_.clear();
 
 }
 
 void TagFetcher::FingerprintFound(const int index) {
 
   QFutureWatcher<QString> *watcher = reinterpret_cast<QFutureWatcher<QString>*>(sender());
-  if (!watcher || index >= songs_.count()) return;
+  if (!watcher || index >= fingerprint_indexes_.count()) return;
 
   const QString fingerprint = watcher->resultAt(index);
-  const Song &song = songs_[index];
+  const int song_index = fingerprint_indexes_[index];
+  const Song &song = songs_[song_index];
 
   if (fingerprint.isEmpty()) {
     emit ResultAvailable(song, SongList());
     return;
   }
 
+  // Cache the fingerprint in the collection so tagging this song again never decodes the file a second time.
+  if (collection_backend_ && song.source() == Song::Source::Collection && song.id() >= 0) {
+    collection_backend_->UpdateSongFingerprintAsync(song.url(), fingerprint);
+  }
+
   emit Progress(song, tr("Identifying song"));
-  acoustid_client_->Start(index, fingerprint, static_cast<int>(song.length_nanosec() / kNsecPerMsec));
+  acoustid_client_->Start(song_index, fingerprint, static_cast<int>(song.length_nanosec() / kNsecPerMsec));
 
 }
 
@@ -26,6 +26,7 @@
 
 #include <QObject>
 #include <QFutureWatcher>
+#include <QList>
 #include <QString>
 #include <QStringList>
 
@@ -34,6 +35,7 @@
 
 class NetworkAccessManager;
 class AcoustidClient;
+class CollectionBackend;
 
 class TagFetcher : public QObject {
   Q_OBJECT
@@ -41,7 +43,7 @@ class TagFetcher : public QObject {
   // High level interface to Fingerprinter, AcoustidClient and MusicBrainzClient.
 
  public:
-  explicit TagFetcher(NetworkAccessManager *network, QObject *parent = nullptr);
+  explicit TagFetcher(NetworkAccessManager *network, CollectionBackend *collection_backend = nullptr, QObject *parent = nullptr);
 
   void StartFetch(const SongList &songs);
 
@@ -63,8 +65,11 @@ class TagFetcher : public QObject {
   QFutureWatcher<QString> *fingerprint_watcher_;
   AcoustidClient *acoustid_client_;
   MusicBrainzClient *musicbrainz_client_;
+  CollectionBackend *collection_backend_;
 
   SongList songs_;
+  // Maps fingerprint job results back to positions in songs_, only songs missing a fingerprint are decoded.
+  QList<int> fingerprint_indexes_;
 };
 
 #endif  // TAGFETCHER_H
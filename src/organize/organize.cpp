@@ -32,6 +32,10 @@
 #include <QString>
 #include <QUrl>
 #include <QImage>
+#include <QMutexLocker>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 #include "core/logging.h"
 #include "core/taskmanager.h"
@@ -73,7 +77,9 @@ Organize::Organize(TaskManager *task_manager, std::shared_ptr<MusicStorage> dest
       started_(false),
       task_id_(0),
       current_copy_progress_(0),
-      finished_(false) {
+      finished_(false),
+      max_concurrent_copies_(1),
+      copies_in_flight_(0) {
 
   original_thread_ = thread();
 
@@ -128,11 +134,16 @@ void Organize::ProcessSomeFiles() {
       }
       tasks_pending_.clear();
     }
+    max_concurrent_copies_ = destination_->MaxConcurrentCopies();
     started_ = true;
   }
 
   // None left?
   if (tasks_pending_.isEmpty()) {
+    if (copies_in_flight_ > 0) {
+      // Just wait - CopyJobFinished will start us off again when the last copy lands.
+      return;
+    }
 #ifdef HAVE_GSTREAMER
     if (!tasks_transcoding_.isEmpty()) {
       // Just wait - FileTranscoded will start us off again in a little while
@@ -248,6 +259,33 @@ void Organize::ProcessSomeFiles() {
 
     job.progress_ = std::bind(&Organize::SetSongProgress, this, std::placeholders::_1, !task.transcoded_filename_.isEmpty());
 
+    if (max_concurrent_copies_ > 1) {
+      // Defer tasks whose destination is already being written, so the first task in queue order wins and the rest see the finished file.
+      if (copies_in_flight_ >= max_concurrent_copies_ || destinations_in_flight_.contains(job.destination_)) {
+        tasks_pending_.prepend(task);
+        break;
+      }
+      destinations_in_flight_ << job.destination_;
+      ++copies_in_flight_;
+      {
+        QMutexLocker l(&copy_progress_mutex_);
+        copy_progress_[job.destination_] = 0.0F;
+      }
+      const QString destination = job.destination_;
+      job.progress_ = [this, destination](float copy_progress) { SetJobProgress(destination, copy_progress); };
+      std::shared_ptr<MusicStorage> storage = destination_;
+      MusicStorage::CopyJob parallel_job = job;
+      QFuture<bool> future = QtConcurrent::run([storage, parallel_job]() { return storage->CopyToStorage(parallel_job); });
+      QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+      QObject::connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, task, song]() {
+        const bool success = watcher->result();
+        watcher->deleteLater();
+        CopyJobFinished(task, song, success);
+      });
+      watcher->setFuture(future);
+      continue;
+    }
+
     if (destination_->CopyToStorage(job)) {
       if (job.remove_original_ && (destination_->source() == Song::Source::Collection || destination_->source() == Song::Source::Device)) {
         // Notify other aspects of system that song has been invalidated
@@ -276,6 +314,41 @@ void Organize::ProcessSomeFiles() {
 
 }
 
+void Organize::CopyJobFinished(const Task &task, const Song &song, const bool success) {
+
+  destinations_in_flight_.remove(task.song_info_.new_filename_);
+  --copies_in_flight_;
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    copy_progress_.remove(task.song_info_.new_filename_);
+  }
+
+  if (success) {
+    if (!copy_ && (destination_->source() == Song::Source::Collection || destination_->source() == Song::Source::Device)) {
+      // Notify other aspects of system that song has been invalidated
+      QString root = destination_->LocalPath();
+      QFileInfo new_file = QFileInfo(root + "/" + task.song_info_.new_filename_);
+      emit SongPathChanged(song, new_file, destination_->collection_directory_id());
+    }
+  }
+  else {
+    files_with_errors_ << task.song_info_.song_.basefilename();
+  }
+
+  // Clean up the temporary transcoded file
+  if (!task.transcoded_filename_.isEmpty()) {
+    QFile::remove(task.transcoded_filename_);
+  }
+
+  tasks_complete_++;
+  UpdateProgress();
+
+  if (!finished_ && !process_files_timer_->isActive()) {
+    process_files_timer_->start();
+  }
+
+}
+
 #ifdef HAVE_GSTREAMER
 Song::FileType Organize::CheckTranscode(Song::FileType original_type) const {
 
@@ -313,6 +386,19 @@ void Organize::SetSongProgress(float progress, bool transcoded) {
 
 }
 
+void Organize::SetJobProgress(const QString &destination, const float progress) {
+
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    if (!copy_progress_.contains(destination)) return;
+    copy_progress_[destination] = progress;
+  }
+
+  // Called from a worker thread, aggregate on this object's thread.
+  QMetaObject::invokeMethod(this, "UpdateProgress", Qt::QueuedConnection);
+
+}
+
 void Organize::UpdateProgress() {
 
   const quint64 total = task_count_ * 100;
@@ -344,6 +430,14 @@ void Organize::UpdateProgress() {
   // Add the progress of the track that's currently copying
   progress += current_copy_progress_;
 
+  // Add the progress of copies running in parallel
+  {
+    QMutexLocker l(&copy_progress_mutex_);
+    for (QHash<QString, float>::const_iterator it = copy_progress_.constBegin(); it != copy_progress_.constEnd(); ++it) {
+      progress += qBound(0, static_cast<int>(it.value() * 100.0F), 99);
+    }
+  }
+
   task_manager_->SetTaskProgress(task_id_, progress, total);
 
 }
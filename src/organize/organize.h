@@ -34,6 +34,8 @@
 #include <QList>
 #include <QVector>
 #include <QMap>
+#include <QHash>
+#include <QMutex>
 #include <QString>
 #include <QStringList>
 
@@ -86,9 +88,12 @@ class Organize : public QObject {
   void FileTranscoded(const QString &input, const QString &output, bool success);
   void LogLine(const QString &message);
 
+ private slots:
+  void UpdateProgress();
+
  private:
   void SetSongProgress(float progress, bool transcoded = false);
-  void UpdateProgress();
+  void SetJobProgress(const QString &destination, const float progress);
 #ifdef HAVE_GSTREAMER
   Song::FileType CheckTranscode(Song::FileType original_type) const;
 #endif
@@ -106,6 +111,8 @@ class Organize : public QObject {
     Song::FileType new_filetype_;
   };
 
+  void CopyJobFinished(const Task &task, const Song &song, const bool success);
+
   QThread *thread_;
   QThread *original_thread_;
   TaskManager *task_manager_;
@@ -135,6 +142,14 @@ class Organize : public QObject {
   int current_copy_progress_;
   bool finished_;
 
+  // Copies dispatched to the thread pool for destinations that allow more than one CopyToStorage call at a time.
+  // Completion bookkeeping happens back on this object's thread, only the progress map is touched from the workers.
+  int max_concurrent_copies_;
+  int copies_in_flight_;
+  QSet<QString> destinations_in_flight_;
+  QMutex copy_progress_mutex_;
+  QHash<QString, float> copy_progress_;
+
   QStringList files_with_errors_;
   QStringList log_;
 };
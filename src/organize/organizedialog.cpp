@@ -154,6 +154,9 @@ void OrganizeDialog::SetDestinationModel(QAbstractItemModel *model, const bool d
 
   ui_->destination->setModel(model);
 
+  // Free space is polled in the background, redraw the bar when a refreshed value arrives for the selected destination.
+  QObject::connect(model, &QAbstractItemModel::dataChanged, this, &OrganizeDialog::UpdatePreviews, Qt::UniqueConnection);
+
   ui_->eject_after->setVisible(devices);
 
   devices_ = devices;
@@ -397,8 +400,7 @@ void OrganizeDialog::SetLoadingSongs(const bool loading) {
 
 SongList OrganizeDialog::LoadSongsBlocking(const QStringList &filenames) {
 
-  SongList songs;
-  Song song;
+  QStringList files;
 
   QStringList filenames_copy = filenames;
   while (!filenames_copy.isEmpty()) {
@@ -413,11 +415,10 @@ SongList OrganizeDialog::LoadSongsBlocking(const QStringList &filenames) {
       continue;
     }
 
-    TagReaderClient::Instance()->ReadFileBlocking(filename, &song);
-    if (song.is_valid()) songs << song;
+    files << filename;
   }
 
-  return songs;
+  return TagReaderClient::Instance()->ReadFileBatchBlocking(files);
 
 }
 
@@ -501,6 +502,22 @@ void OrganizeDialog::UpdatePreviews() {
 
   const bool format_valid = !has_local_destination || format_.IsValid();
 
+  // Everything below re-evaluates the pattern for every song and rebuilds the preview list, which is what
+  // makes typing in the naming field lag with thousands of songs.
+  // UpdatePreviews is wired to several signals that often fire together, so skip when the inputs are unchanged.
+  const QString preview_state_key = format_.format() + "|" +
+                                    QString::number(format_.remove_problematic()) +
+                                    QString::number(format_.remove_non_fat()) +
+                                    QString::number(format_.remove_non_ascii()) +
+                                    QString::number(format_.allow_ascii_ext()) +
+                                    QString::number(format_.replace_spaces()) + "|" +
+                                    QString::number(ui_->destination->currentIndex()) + "|" +
+                                    QString::number(songs_.count()) + "|" +
+                                    QString::number(total_size_) + "|" +
+                                    QString::number(free);
+  if (preview_state_key == preview_state_key_) return;
+  preview_state_key_ = preview_state_key;
+
   // Are we going to enable the ok button?
   bool ok = format_valid && !songs_.isEmpty();
   if (capacity != 0 && total_size_ > free) ok = false;
@@ -118,6 +118,8 @@ class OrganizeDialog : public QDialog {
   QFuture<SongList> songs_future_;
   SongList songs_;
   Organize::NewSongInfoList new_songs_info_;
+  // Inputs the last preview was computed from, so UpdatePreviews can skip re-evaluating every song when nothing relevant changed.
+  QString preview_state_key_;
   quint64 total_size_;
   QString playlist_;
 
@@ -84,11 +84,99 @@ OrganizeFormat::OrganizeFormat(const QString &format)
       remove_non_fat_(false),
       remove_non_ascii_(false),
       allow_ascii_ext_(false),
-      replace_spaces_(true) {}
+      replace_spaces_(true) {
+  Compile();
+}
 
 void OrganizeFormat::set_format(const QString &v) {
   format_ = v;
   format_.replace('\\', '/');
+  Compile();
+}
+
+void OrganizeFormat::Compile() {
+
+  static const QRegularExpression block_regexp(kBlockPattern);
+
+  compiled_.clear();
+
+  qint64 pos = 0;
+  QRegularExpressionMatch re_match;
+  for (re_match = block_regexp.match(format_, pos); re_match.hasMatch(); re_match = block_regexp.match(format_, pos)) {
+    if (re_match.capturedStart() > pos) {
+      compiled_ << CompileTags(format_.mid(pos, re_match.capturedStart() - pos));
+    }
+    FormatNode node(FormatNode::Type::Block);
+    node.children = CompileTags(re_match.captured(1));
+    compiled_ << node;
+    pos = re_match.capturedEnd();
+  }
+  if (pos < format_.length()) {
+    compiled_ << CompileTags(format_.mid(pos));
+  }
+
+}
+
+QList<OrganizeFormat::FormatNode> OrganizeFormat::CompileTags(const QString &text) const {
+
+  static const QRegularExpression tag_regexp(kTagPattern);
+
+  QList<FormatNode> nodes;
+
+  qint64 pos = 0;
+  QRegularExpressionMatch re_match;
+  for (re_match = tag_regexp.match(text, pos); re_match.hasMatch(); re_match = tag_regexp.match(text, pos)) {
+    if (re_match.capturedStart() > pos) {
+      nodes << FormatNode(FormatNode::Type::Text, text.mid(pos, re_match.capturedStart() - pos));
+    }
+    nodes << FormatNode(FormatNode::Type::Tag, re_match.captured(1));
+    pos = re_match.capturedEnd();
+  }
+  if (pos < text.length()) {
+    nodes << FormatNode(FormatNode::Type::Text, text.mid(pos));
+  }
+
+  return nodes;
+
+}
+
+QString OrganizeFormat::Evaluate(const QList<FormatNode> &nodes, const Song &song, bool *have_tagdata, bool *any_empty) const {
+
+  QString result;
+  bool empty = false;
+
+  for (const FormatNode &node : nodes) {
+    switch (node.type) {
+      case FormatNode::Type::Text:
+        result += node.text;
+        break;
+      case FormatNode::Type::Tag:{
+        const QString value = TagValue(node.text, song);
+        if (value.isEmpty()) {
+          empty = true;
+        }
+        else if (have_tagdata && kUniqueTags.contains(node.text)) {
+          *have_tagdata = true;
+        }
+        result += value;
+        break;
+      }
+      case FormatNode::Type::Block:{
+        // A block only makes it into the result when every tag inside it has a value.
+        bool block_empty = false;
+        const QString value = Evaluate(node.children, song, have_tagdata, &block_empty);
+        if (!block_empty) result += value;
+        break;
+      }
+    }
+  }
+
+  if (any_empty) {
+    *any_empty = empty;
+  }
+
+  return result;
+
 }
 
 bool OrganizeFormat::IsValid() const {
@@ -104,7 +192,7 @@ bool OrganizeFormat::IsValid() const {
 OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(const Song &song, QString extension) const {
 
   bool unique_filename = false;
-  QString filepath = ParseBlock(format_, song, &unique_filename);
+  QString filepath = Evaluate(compiled_, song, &unique_filename);
 
   if (filepath.isEmpty()) {
     filepath = song.basefilename();
@@ -200,51 +288,6 @@ OrganizeFormat::GetFilenameForSongResult OrganizeFormat::GetFilenameForSong(cons
 
 }
 
-QString OrganizeFormat::ParseBlock(QString block, const Song &song, bool *have_tagdata, bool *any_empty) const {
-
-  // Find any blocks first
-  qint64 pos = 0;
-  const QRegularExpression block_regexp(kBlockPattern);
-  QRegularExpressionMatch re_match;
-  for (re_match = block_regexp.match(block, pos); re_match.hasMatch(); re_match = block_regexp.match(block, pos)) {
-    pos = re_match.capturedStart();
-    // Recursively parse the block
-    bool empty = false;
-    QString value = ParseBlock(re_match.captured(1), song, have_tagdata, &empty);
-    if (empty) value = "";
-
-    // Replace the block's value
-    block.replace(pos, re_match.capturedLength(), value);
-    pos += value.length();
-  }
-
-  // Now look for tags
-  bool empty = false;
-  pos = 0;
-  const QRegularExpression tag_regexp(kTagPattern);
-  for (re_match = tag_regexp.match(block, pos); re_match.hasMatch(); re_match = tag_regexp.match(block, pos)) {
-    pos = re_match.capturedStart();
-    const QString tag = re_match.captured(1);
-    const QString value = TagValue(tag, song);
-    if (value.isEmpty()) {
-      empty = true;
-    }
-    else if (have_tagdata && kUniqueTags.contains(tag)) {
-      *have_tagdata = true;
-    }
-
-    block.replace(pos, re_match.capturedLength(), value);
-    pos += value.length();
-  }
-
-  if (any_empty) {
-    *any_empty = empty;
-  }
-
-  return block;
-
-}
-
 QString OrganizeFormat::TagValue(const QString &tag, const Song &song) const {
 
   QString value;
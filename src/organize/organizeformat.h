@@ -25,6 +25,7 @@
 #include "config.h"
 
 #include <QObject>
+#include <QList>
 #include <QString>
 #include <QStringList>
 #include <QRgb>
@@ -90,10 +91,27 @@ class OrganizeFormat {
   static const QStringList kKnownTags;
   static const QStringList kUniqueTags;
 
-  QString ParseBlock(QString block, const Song &song, bool *have_tagdata = nullptr, bool *any_empty = nullptr) const;
+  // The pattern compiled into a flat token program - literal text, %tags and {conditional blocks} of the former two -
+  // so evaluating it for a song is a walk over the tokens instead of regular expression scans per song.
+  struct FormatNode {
+    enum class Type {
+      Text,
+      Tag,
+      Block
+    };
+    explicit FormatNode(const Type _type = Type::Text, const QString &_text = QString()) : type(_type), text(_text) {}
+    Type type;
+    QString text;
+    QList<FormatNode> children;  // Only used for blocks.
+  };
+
+  void Compile();
+  QList<FormatNode> CompileTags(const QString &text) const;
+  QString Evaluate(const QList<FormatNode> &nodes, const Song &song, bool *have_tagdata = nullptr, bool *any_empty = nullptr) const;
   QString TagValue(const QString &tag, const Song &song) const;
 
   QString format_;
+  QList<FormatNode> compiled_;
   bool remove_problematic_;
   bool remove_non_fat_;
   bool remove_non_ascii_;
@@ -32,6 +32,7 @@
 
 #include <QObject>
 #include <QCoreApplication>
+#include <QCollator>
 #include <QtConcurrent>
 #include <QFuture>
 #include <QFutureWatcher>
@@ -108,10 +109,16 @@ const char *Playlist::kSettingsGroup = "Playlist";
 const int Playlist::kUndoStackSize = 20;
 const int Playlist::kUndoItemLimit = 500;
 
+const int Playlist::kDynamicPrefetchThreshold = 5;
+const int Playlist::kDynamicPrefetchBatchSize = 10;
+
+// Reshuffling this many items or more is done on a worker thread so re-randomizing a large playlist doesn't stall the UI.
+const int Playlist::kAsyncReshuffleThreshold = 10000;
+
 const qint64 Playlist::kMinScrobblePointNsecs = 31LL * kNsecPerSec;
 const qint64 Playlist::kMaxScrobblePointNsecs = 240LL * kNsecPerSec;
 
-Playlist::Playlist(PlaylistBackend *backend, TaskManager *task_manager, CollectionBackend *collection, const int id, const QString &special_type, const bool favorite, QObject *parent)
+Playlist::Playlist(PlaylistBackend *backend, TaskManager *task_manager, CollectionBackend *collection, const int id, const QString &special_type, const bool favorite, const bool lazy_restore, QObject *parent)
     : QAbstractListModel(parent),
       is_loading_(false),
       filter_(new PlaylistFilter(this)),
@@ -122,17 +129,22 @@ Playlist::Playlist(PlaylistBackend *backend, TaskManager *task_manager, Collecti
       collection_(collection),
       id_(id),
       favorite_(favorite),
+      total_length_nanosec_(0),
+      total_length_dirty_(true),
       current_is_paused_(false),
       current_virtual_index_(-1),
       is_shuffled_(false),
+      reshuffle_generation_(0),
       playlist_sequence_(nullptr),
       ignore_sorting_(false),
       undo_stack_(new QUndoStack(this)),
       special_type_(special_type),
       cancel_restore_(false),
+      restore_pending_(lazy_restore),
       scrobbled_(false),
       scrobble_point_(-1),
       editing_(-1),
+      dynamic_prefetch_in_progress_(false),
       auto_sort_(false),
       sort_column_(Column_Title),
       sort_order_(Qt::AscendingOrder) {
@@ -142,7 +154,13 @@ Playlist::Playlist(PlaylistBackend *backend, TaskManager *task_manager, Collecti
   QObject::connect(this, &Playlist::rowsInserted, this, &Playlist::PlaylistChanged);
   QObject::connect(this, &Playlist::rowsRemoved, this, &Playlist::PlaylistChanged);
 
-  Restore();
+  // Keep the cached total length in step with the model so the status bar doesn't iterate the whole playlist.
+  QObject::connect(this, &Playlist::rowsInserted, this, &Playlist::TotalLengthRowsInserted);
+  QObject::connect(this, &Playlist::rowsAboutToBeRemoved, this, &Playlist::TotalLengthRowsAboutToBeRemoved);
+  QObject::connect(this, &Playlist::dataChanged, this, &Playlist::TotalLengthInvalidate);
+
+  // Playlists on background tabs can be created with lazy_restore, deferring the item load until PlaylistManager asks for it.
+  if (!lazy_restore) Restore();
 
   filter_->setSourceModel(this);
   queue_->setSourceModel(this);
@@ -282,13 +300,23 @@ QVariant Playlist::data(const QModelIndex &idx, int role) const {
     case Role_CanSetRating:
       return idx.column() == Column_Rating && items_[idx.row()]->IsLocalCollectionItem() && items_[idx.row()]->Metadata().id() != -1;
 
+    case Role_FilterText: {
+      PlaylistItemPtr item = items_[idx.row()];
+      if (item->HasFilterTextCache(idx.column())) {
+        return item->FilterTextCache(idx.column());
+      }
+      const QString text = data(idx, Qt::DisplayRole).toString().toLower();
+      item->SetFilterTextCache(idx.column(), text);
+      return text;
+    }
+
     case Qt::EditRole:
     case Qt::ToolTipRole:
     case Qt::DisplayRole: {
       PlaylistItemPtr item = items_[idx.row()];
       Song song = item->Metadata();
 
-      // Don't forget to change Playlist::CompareItems when adding new columns
+      // Don't forget to change Playlist::SortItems when adding new columns
       switch (idx.column()) {
         case Column_Title:              return song.PrettyTitle();
         case Column_Artist:             return song.artist();
@@ -725,11 +753,43 @@ void Playlist::set_current_row(const int i, const AutoScroll autoscroll, const b
 
 void Playlist::InsertDynamicItems(const int count) {
 
-  PlaylistGeneratorInserter *inserter = new PlaylistGeneratorInserter(task_manager_, collection_, this);
-  QObject::connect(inserter, &PlaylistGeneratorInserter::Error, this, &Playlist::Error);
-  QObject::connect(inserter, &PlaylistGeneratorInserter::PlayRequested, this, &Playlist::PlayRequested);
+  // Serve the insert from the prefetched buffer when it has enough items, so no database work happens at the track transition.
+  if (dynamic_prefetched_items_.count() >= count) {
+    const PlaylistItemPtrList items = dynamic_prefetched_items_.mid(0, count);
+    dynamic_prefetched_items_ = dynamic_prefetched_items_.mid(count);
+    InsertItems(items, -1, false, false);
+    PrefetchDynamicItems();
+  }
+  else {
+    PlaylistGeneratorInserter *inserter = new PlaylistGeneratorInserter(task_manager_, collection_, this);
+    QObject::connect(inserter, &PlaylistGeneratorInserter::Error, this, &Playlist::Error);
+    QObject::connect(inserter, &PlaylistGeneratorInserter::PlayRequested, this, &Playlist::PlayRequested);
+    // The generator is stateful, so wait until this generation is done before prefetching the next batch.
+    QObject::connect(inserter, &QObject::destroyed, this, &Playlist::PrefetchDynamicItems);
+
+    inserter->Load(this, -1, false, false, false, dynamic_playlist_, count);
+  }
+
+}
 
-  inserter->Load(this, -1, false, false, false, dynamic_playlist_, count);
+void Playlist::PrefetchDynamicItems() {
+
+  if (!dynamic_playlist_ || dynamic_prefetch_in_progress_) return;
+  if (dynamic_prefetched_items_.count() >= kDynamicPrefetchThreshold) return;
+
+  dynamic_prefetch_in_progress_ = true;
+
+  PlaylistGeneratorPtr generator = dynamic_playlist_;
+  QFuture<PlaylistItemPtrList> future = QtConcurrent::run([generator]() { return generator->GenerateMore(kDynamicPrefetchBatchSize); });
+  QFutureWatcher<PlaylistItemPtrList> *watcher = new QFutureWatcher<PlaylistItemPtrList>(this);
+  QObject::connect(watcher, &QFutureWatcher<PlaylistItemPtrList>::finished, this, [this, watcher, generator]() {
+    watcher->deleteLater();
+    dynamic_prefetch_in_progress_ = false;
+    // The dynamic playlist may have been changed or turned off while the batch was generating.
+    if (generator != dynamic_playlist_) return;
+    dynamic_prefetched_items_.append(watcher->result());
+  });
+  watcher->setFuture(future);
 
 }
 
@@ -777,10 +837,10 @@ bool Playlist::dropMimeData(const QMimeData *data, Qt::DropAction action, int ro
     // Dragged from a collection
     // We want to check if these songs are from the actual local file backend, if they are we treat them differently.
     if (song_data->backend && song_data->backend->songs_table() == SCollection::kSongsTable) {
-      InsertSongItems<CollectionPlaylistItem>(song_data->songs, row, play_now, enqueue_now, enqueue_next_now);
+      InsertSongItems<CollectionPlaylistItem>(song_data->resolved_songs(), row, play_now, enqueue_now, enqueue_next_now);
     }
     else {
-      InsertSongItems<SongPlaylistItem>(song_data->songs, row, play_now, enqueue_now, enqueue_next_now);
+      InsertSongItems<SongPlaylistItem>(song_data->resolved_songs(), row, play_now, enqueue_now, enqueue_next_now);
     }
   }
   else if (const PlaylistItemMimeData *item_data = qobject_cast<const PlaylistItemMimeData*>(data)) {
@@ -877,6 +937,11 @@ void Playlist::InsertSmartPlaylist(PlaylistGeneratorPtr generator, const int pos
   PlaylistGeneratorInserter *inserter = new PlaylistGeneratorInserter(task_manager_, collection_, this);
   QObject::connect(inserter, &PlaylistGeneratorInserter::Error, this, &Playlist::Error);
 
+  if (generator->is_dynamic()) {
+    // Once the initial fill is done, get a buffer of upcoming items ready ahead of the first track transition.
+    QObject::connect(inserter, &QObject::destroyed, this, &Playlist::PrefetchDynamicItems);
+  }
+
   inserter->Load(this, pos, play_now, enqueue, enqueue_next, generator);
 
   if (generator->is_dynamic()) {
@@ -888,6 +953,7 @@ void Playlist::InsertSmartPlaylist(PlaylistGeneratorPtr generator, const int pos
 void Playlist::TurnOnDynamicPlaylist(PlaylistGeneratorPtr gen) {
 
   dynamic_playlist_ = gen;
+  dynamic_prefetched_items_.clear();
   ShuffleModeChanged(PlaylistSequence::ShuffleMode::Off);
   emit DynamicModeChanged(true);
 
@@ -1075,6 +1141,8 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   const int start = pos == -1 ? static_cast<int>(items_.count()) : pos;
   const int end = start + static_cast<int>(items.count()) - 1;
 
+  QList<int> collection_song_ids_added;
+
   beginInsertRows(QModelIndex(), start, end);
   for (int i = start; i <= end; ++i) {
     PlaylistItemPtr item = items[i - start];
@@ -1084,6 +1152,7 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
     if (item->source() == Song::Source::Collection) {
       int id = item->Metadata().id();
       if (id != -1) {
+        if (!collection_items_by_id_.contains(id)) collection_song_ids_added << id;
         collection_items_by_id_.insert(id, item);
       }
     }
@@ -1096,6 +1165,8 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   }
   endInsertRows();
 
+  if (!collection_song_ids_added.isEmpty()) emit CollectionSongsAdded(collection_song_ids_added);
+
   if (enqueue) {
     QModelIndexList indexes;
     for (int i = start; i <= end; ++i) {
@@ -1190,6 +1261,8 @@ void Playlist::UpdateItems(SongList songs) {
   // then we remove song from our list because we will not need to check it again.
   // And we also update undo actions.
 
+  QList<int> collection_song_ids_added;
+
   for (int i = 0; i < items_.size(); i++) {
     // Update current items list
     QMutableListIterator<Song> it(songs);
@@ -1202,6 +1275,7 @@ void Playlist::UpdateItems(SongList songs) {
           if (song.is_collection_song()) {
             new_item = std::make_shared<CollectionPlaylistItem>(song);
             if (collection_items_by_id_.contains(song.id(), item)) collection_items_by_id_.remove(song.id(), item);
+            if (!collection_items_by_id_.contains(song.id())) collection_song_ids_added << song.id();
             collection_items_by_id_.insert(song.id(), new_item);
           }
           else {
@@ -1233,6 +1307,8 @@ void Playlist::UpdateItems(SongList songs) {
     }
   }
 
+  if (!collection_song_ids_added.isEmpty()) emit CollectionSongsAdded(collection_song_ids_added);
+
   emit PlaylistChanged();
 
   ScheduleSave();
@@ -1279,71 +1355,150 @@ QMimeData *Playlist::mimeData(const QModelIndexList &indexes) const {
 
 }
 
-bool Playlist::CompareItems(const int column, const Qt::SortOrder order, std::shared_ptr<PlaylistItem> _a, std::shared_ptr<PlaylistItem> _b) {
+namespace {
 
-  std::shared_ptr<PlaylistItem> a = order == Qt::AscendingOrder ? _a : _b;
-  std::shared_ptr<PlaylistItem> b = order == Qt::AscendingOrder ? _b : _a;
+// Applies the permutation described by indices to the range [begin, end).
+void ApplySortPermutation(const PlaylistItemPtrList::iterator begin, const QList<int> &indices) {
 
-#define cmp(field) return a->Metadata().field() < b->Metadata().field()
-#define strcmp(field) return QString::localeAwareCompare(a->Metadata().field().toLower(), b->Metadata().field().toLower()) < 0;
+  PlaylistItemPtrList sorted;
+  sorted.reserve(indices.count());
+  for (const int i : indices) {
+    sorted << *(begin + i);
+  }
+  std::copy(sorted.begin(), sorted.end(), begin);
 
-  switch (column) {
+}
 
-    case Column_Title:        strcmp(title_sortable);
-    case Column_Artist:       strcmp(artist_sortable);
-    case Column_Album:        strcmp(album_sortable);
-    case Column_Length:       cmp(length_nanosec);
-    case Column_Track:        cmp(track);
-    case Column_Disc:         cmp(disc);
-    case Column_Year:         cmp(year);
-    case Column_OriginalYear: cmp(originalyear);
-    case Column_Genre:        strcmp(genre);
-    case Column_AlbumArtist:  strcmp(playlist_albumartist_sortable);
-    case Column_Composer:     strcmp(composer);
-    case Column_Performer:    strcmp(performer);
-    case Column_Grouping:     strcmp(grouping);
+// Stable-sorts the range by the given keys, most of the sort cost is paid
+// once in key extraction instead of in every comparison.
+template<typename KeyList>
+void StableSortByKeys(const PlaylistItemPtrList::iterator begin, const KeyList &keys, const Qt::SortOrder order) {
 
-    case Column_PlayCount:    cmp(playcount);
-    case Column_SkipCount:    cmp(skipcount);
-    case Column_LastPlayed:   cmp(lastplayed);
+  QList<int> indices;
+  indices.reserve(keys.count());
+  for (int i = 0; i < keys.count(); ++i) {
+    indices << i;
+  }
 
-    case Column_Bitrate:      cmp(bitrate);
-    case Column_Samplerate:   cmp(samplerate);
-    case Column_Bitdepth:     cmp(bitdepth);
-    case Column_Filename:
-      return (QString::localeAwareCompare(a->Url().path().toLower(), b->Url().path().toLower()) < 0);
-    case Column_BaseFilename: cmp(basefilename);
-    case Column_Filesize:     cmp(filesize);
-    case Column_Filetype:     cmp(filetype);
-    case Column_DateModified: cmp(mtime);
-    case Column_DateCreated:  cmp(ctime);
+  std::stable_sort(indices.begin(), indices.end(), [&keys, order](int a, int b) {
+    if (order == Qt::DescendingOrder) std::swap(a, b);
+    return keys[a] < keys[b];
+  });
 
-    case Column_Comment:      strcmp(comment);
-    case Column_Source:       cmp(source);
+  ApplySortPermutation(begin, indices);
 
-    case Column_Rating:       cmp(rating);
+}
 
-    case Column_HasCUE:       cmp(has_cue);
+}  // namespace
 
-    default: qLog(Error) << "No such column" << column;
+void Playlist::SortItems(const PlaylistItemPtrList::iterator begin, const PlaylistItemPtrList::iterator end, const int column, const Qt::SortOrder order) {
+
+  const int count = static_cast<int>(std::distance(begin, end));
+  if (count <= 1) return;
+
+  // Locale-aware string columns get a collator sort key each, so comparisons
+  // inside the sort are plain byte compares instead of full collations.
+  bool locale_aware = true;
+  QStringList texts;
+  texts.reserve(count);
+
+  for (auto it = begin; it != end; ++it) {
+    const Song song = (*it)->Metadata();
+    switch (column) {
+      case Column_Title:        texts << song.title_sortable(); break;
+      case Column_Artist:       texts << song.artist_sortable(); break;
+      case Column_Album:        texts << song.album_sortable(); break;
+      case Column_Genre:        texts << song.genre(); break;
+      case Column_AlbumArtist:  texts << song.playlist_albumartist_sortable(); break;
+      case Column_Composer:     texts << song.composer(); break;
+      case Column_Performer:    texts << song.performer(); break;
+      case Column_Grouping:     texts << song.grouping(); break;
+      case Column_Comment:      texts << song.comment(); break;
+      case Column_Filename:     texts << (*it)->Url().path(); break;
+      default:
+        locale_aware = false;
+        break;
+    }
+    if (!locale_aware) break;
   }
 
-#undef cmp
-#undef strcmp
+  if (locale_aware) {
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    QList<QCollatorSortKey> keys;
+    keys.reserve(count);
+    for (const QString &text : texts) {
+      keys << collator.sortKey(text.toLower());
+    }
+    StableSortByKeys(begin, keys, order);
+    return;
+  }
 
-  return false;
+  if (column == Column_BaseFilename) {
+    QStringList keys;
+    keys.reserve(count);
+    for (auto it = begin; it != end; ++it) {
+      keys << (*it)->Metadata().basefilename();
+    }
+    StableSortByKeys(begin, keys, order);
+    return;
+  }
+
+  // Everything else compares numerically.
+  QList<double> keys;
+  keys.reserve(count);
+  for (auto it = begin; it != end; ++it) {
+    const Song song = (*it)->Metadata();
+    double key = 0.0;
+    switch (column) {
+      case Column_Length:       key = static_cast<double>(song.length_nanosec()); break;
+      case Column_Track:        key = song.track(); break;
+      case Column_Disc:         key = song.disc(); break;
+      case Column_Year:         key = song.year(); break;
+      case Column_OriginalYear: key = song.originalyear(); break;
+
+      case Column_PlayCount:    key = song.playcount(); break;
+      case Column_SkipCount:    key = song.skipcount(); break;
+      case Column_LastPlayed:   key = static_cast<double>(song.lastplayed()); break;
+
+      case Column_Bitrate:      key = song.bitrate(); break;
+      case Column_Samplerate:   key = song.samplerate(); break;
+      case Column_Bitdepth:     key = song.bitdepth(); break;
+
+      case Column_Filesize:     key = static_cast<double>(song.filesize()); break;
+      case Column_Filetype:     key = static_cast<double>(song.filetype()); break;
+      case Column_DateModified: key = static_cast<double>(song.mtime()); break;
+      case Column_DateCreated:  key = static_cast<double>(song.ctime()); break;
+
+      case Column_Source:       key = static_cast<double>(song.source()); break;
+
+      case Column_Rating:       key = song.rating(); break;
+
+      case Column_HasCUE:       key = song.has_cue() ? 1.0 : 0.0; break;
+
+      default:
+        qLog(Error) << "No such column" << column;
+        return;
+    }
+    keys << key;
+  }
+
+  StableSortByKeys(begin, keys, order);
 
 }
 
-bool Playlist::ComparePathDepths(const Qt::SortOrder order, std::shared_ptr<PlaylistItem> _a, std::shared_ptr<PlaylistItem> _b) {
+void Playlist::SortItemsByPathDepth(const PlaylistItemPtrList::iterator begin, const PlaylistItemPtrList::iterator end, const Qt::SortOrder order) {
 
-  std::shared_ptr<PlaylistItem> a = order == Qt::AscendingOrder ? _a : _b;
-  std::shared_ptr<PlaylistItem> b = order == Qt::AscendingOrder ? _b : _a;
+  const int count = static_cast<int>(std::distance(begin, end));
+  if (count <= 1) return;
 
-  qint64 a_dir_level = a->Url().path().count('/');
-  qint64 b_dir_level = b->Url().path().count('/');
+  QList<double> keys;
+  keys.reserve(count);
+  for (auto it = begin; it != end; ++it) {
+    keys << static_cast<double>((*it)->Url().path().count('/'));
+  }
 
-  return a_dir_level < b_dir_level;
+  StableSortByKeys(begin, keys, order);
 
 }
 
@@ -1422,17 +1577,17 @@ void Playlist::sort(int column, Qt::SortOrder order) {
 
   if (column == Column_Album) {
     // When sorting by album, also take into account discs and tracks.
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column_Track, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column_Disc, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column_Album, order, std::placeholders::_1, std::placeholders::_2));
+    SortItems(begin, new_items.end(), Column_Track, order);
+    SortItems(begin, new_items.end(), Column_Disc, order);
+    SortItems(begin, new_items.end(), Column_Album, order);
   }
   else if (column == Column_Filename) {
     // When sorting by full paths we also expect a hierarchical order. This returns a breath-first ordering of paths.
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column_Filename, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::ComparePathDepths, order, std::placeholders::_1, std::placeholders::_2));
+    SortItems(begin, new_items.end(), Column_Filename, order);
+    SortItemsByPathDepth(begin, new_items.end(), order);
   }
   else {
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, column, order, std::placeholders::_1, std::placeholders::_2));
+    SortItems(begin, new_items.end(), column, order);
   }
 
   undo_stack_->push(new PlaylistUndoCommands::SortItems(this, column, order, new_items));
@@ -1503,6 +1658,19 @@ void Playlist::ScheduleSave() {
 
 }
 
+bool Playlist::has_pending_save() const {
+  return timer_save_->isActive();
+}
+
+void Playlist::FlushSave() {
+
+  if (!has_pending_save()) return;
+
+  timer_save_->stop();
+  Save();
+
+}
+
 void Playlist::Save() {
 
   if (!backend_ || is_loading_) return;
@@ -1515,9 +1683,15 @@ void Playlist::Restore() {
 
   if (!backend_) return;
 
+  restore_pending_ = false;
+
   items_.clear();
   virtual_items_.clear();
-  collection_items_by_id_.clear();
+  if (!collection_items_by_id_.isEmpty()) {
+    const QList<int> collection_song_ids_removed = collection_items_by_id_.uniqueKeys();
+    collection_items_by_id_.clear();
+    emit CollectionSongsRemoved(collection_song_ids_removed);
+  }
 
   cancel_restore_ = false;
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -1674,6 +1848,8 @@ PlaylistItemPtrList Playlist::RemoveItemsWithoutUndo(const int row, const int co
   }
   beginRemoveRows(QModelIndex(), row, row + count - 1);
 
+  QList<int> collection_song_ids_removed;
+
   // Remove items
   PlaylistItemPtrList ret;
   ret.reserve(count);
@@ -1685,12 +1861,15 @@ PlaylistItemPtrList Playlist::RemoveItemsWithoutUndo(const int row, const int co
       int id = item->Metadata().id();
       if (id != -1 && collection_items_by_id_.contains(id, item)) {
         collection_items_by_id_.remove(id, item);
+        if (!collection_items_by_id_.contains(id)) collection_song_ids_removed << id;
       }
     }
   }
 
   endRemoveRows();
 
+  if (!collection_song_ids_removed.isEmpty()) emit CollectionSongsRemoved(collection_song_ids_removed);
+
   QList<int>::iterator it = virtual_items_.begin();
   while (it != virtual_items_.end()) {
     if (*it >= items_.count()) {
@@ -1928,48 +2107,18 @@ void Playlist::Shuffle() {
 
 }
 
-namespace {
-
-bool AlbumShuffleComparator(const QMap<QString, int> &album_key_positions, const QMap<int, QString> &album_keys, const int left, const int right) {
-
-  const int left_pos = album_key_positions[album_keys[left]];
-  const int right_pos = album_key_positions[album_keys[right]];
-
-  if (left_pos == right_pos) return left < right;
-  return left_pos < right_pos;
-
-}
-
-}  // namespace
-
-void Playlist::ReshuffleIndices() {
+QList<int> Playlist::ComputeShuffledIndices(const PlaylistSequence::ShuffleMode shuffle_mode, QList<int> virtual_items, const int begin_offset, const QHash<int, QString> &album_keys, const QString &current_album_key) {
 
-  if (!playlist_sequence_) {
-    return;
-  }
-
-  if (playlist_sequence_->shuffle_mode() == PlaylistSequence::ShuffleMode::Off) {
-    // No shuffling - sort the virtual item list normally.
-    std::sort(virtual_items_.begin(), virtual_items_.end());
-    if (current_row() != -1) {
-      current_virtual_index_ = static_cast<int>(virtual_items_.indexOf(current_row()));
-    }
-    return;
-  }
-
-  // If the user is already playing a song, advance the begin iterator to only shuffle items that haven't been played yet.
-  QList<int>::iterator begin = virtual_items_.begin();
-  QList<int>::iterator end = virtual_items_.end();
-  if (current_virtual_index_ != -1) {
-    std::advance(begin, current_virtual_index_ + 1);
-  }
+  QList<int>::iterator begin = virtual_items.begin();
+  std::advance(begin, begin_offset);
+  QList<int>::iterator end = virtual_items.end();
 
   std::random_device rd;
   std::mt19937 g(rd());
 
-  switch (playlist_sequence_->shuffle_mode()) {
+  switch (shuffle_mode) {
     case PlaylistSequence::ShuffleMode::Off:
-      // Handled above.
+      // Handled by the caller.
       break;
 
     case PlaylistSequence::ShuffleMode::All:
@@ -1978,15 +2127,10 @@ void Playlist::ReshuffleIndices() {
       break;
 
     case PlaylistSequence::ShuffleMode::Albums: {
-      QMap<int, QString> album_keys;  // real index -> key
-      QSet<QString> album_key_set;    // unique keys
-
       // Find all the unique albums in the playlist
+      QSet<QString> album_key_set;
       for (QList<int>::iterator it = begin; it != end; ++it) {
-        const int index = *it;
-        const QString key = items_[index]->Metadata().AlbumKey();
-        album_keys[index] = key;
-        album_key_set << key;
+        album_key_set << album_keys[*it];
       }
 
       // Shuffle them
@@ -1995,27 +2139,102 @@ void Playlist::ReshuffleIndices() {
 
       // If the user is currently playing a song, force its album to be first
       // Or if the song was not playing but it was selected, force its album to be first.
-      if (current_virtual_index_ != -1 || current_row() != -1) {
-        const QString key = items_[current_row()]->Metadata().AlbumKey();
-        const qint64 pos = shuffled_album_keys.indexOf(key);
+      if (!current_album_key.isEmpty()) {
+        const qint64 pos = shuffled_album_keys.indexOf(current_album_key);
         if (pos >= 1) {
           std::swap(shuffled_album_keys[0], shuffled_album_keys[pos]);
         }
       }
 
       // Create album key -> position mapping for fast lookup
-      QMap<QString, int> album_key_positions;
+      QHash<QString, int> album_key_positions;
+      album_key_positions.reserve(static_cast<int>(shuffled_album_keys.count()));
       for (int i = 0; i < shuffled_album_keys.count(); ++i) {
         album_key_positions[shuffled_album_keys[i]] = i;
       }
 
+      // Precompute the position of every index so the sort compares plain ints instead of doing two map lookups per comparison.
+      QHash<int, int> index_positions;
+      index_positions.reserve(static_cast<int>(std::distance(begin, end)));
+      for (QList<int>::iterator it = begin; it != end; ++it) {
+        index_positions[*it] = album_key_positions[album_keys[*it]];
+      }
+
       // Sort the virtual items
-      std::stable_sort(begin, end, std::bind(AlbumShuffleComparator, album_key_positions, album_keys, std::placeholders::_1, std::placeholders::_2));
+      std::stable_sort(begin, end, [&index_positions](const int left, const int right) {
+        const int left_pos = index_positions[left];
+        const int right_pos = index_positions[right];
+        if (left_pos == right_pos) return left < right;
+        return left_pos < right_pos;
+      });
 
       break;
     }
   }
 
+  return virtual_items;
+
+}
+
+void Playlist::ReshuffleIndices() {
+
+  if (!playlist_sequence_) {
+    return;
+  }
+
+  const PlaylistSequence::ShuffleMode shuffle_mode = playlist_sequence_->shuffle_mode();
+
+  if (shuffle_mode == PlaylistSequence::ShuffleMode::Off) {
+    // No shuffling - sort the virtual item list normally.
+    std::sort(virtual_items_.begin(), virtual_items_.end());
+    if (current_row() != -1) {
+      current_virtual_index_ = static_cast<int>(virtual_items_.indexOf(current_row()));
+    }
+    return;
+  }
+
+  // If the user is already playing a song, only shuffle items that haven't been played yet.
+  const int begin_offset = current_virtual_index_ != -1 ? current_virtual_index_ + 1 : 0;
+
+  // Extract the album keys up front, the computation must not touch items_ once it runs on a worker thread.
+  QHash<int, QString> album_keys;  // real index -> key
+  QString current_album_key;
+  if (shuffle_mode == PlaylistSequence::ShuffleMode::Albums) {
+    album_keys.reserve(static_cast<int>(virtual_items_.count()) - begin_offset);
+    for (int i = begin_offset; i < virtual_items_.count(); ++i) {
+      const int index = virtual_items_[i];
+      album_keys[index] = items_[index]->Metadata().AlbumKey();
+    }
+    if (current_virtual_index_ != -1 || current_row() != -1) {
+      current_album_key = items_[current_row()]->Metadata().AlbumKey();
+    }
+  }
+
+  if (virtual_items_.count() < kAsyncReshuffleThreshold) {
+    virtual_items_ = ComputeShuffledIndices(shuffle_mode, virtual_items_, begin_offset, album_keys, current_album_key);
+    return;
+  }
+
+  // Large playlists: compute the new order on a worker thread and swap it in when done.
+  // If the playlist or the play position changed while the computation ran the result no longer fits
+  // (the begin offset it was computed with is stale), so it is thrown away and the reshuffle is retried with the current state.
+  const int generation = ++reshuffle_generation_;
+  const QList<int> snapshot = virtual_items_;
+  const int snapshot_virtual_index = current_virtual_index_;
+  QFuture<QList<int>> future = QtConcurrent::run(&Playlist::ComputeShuffledIndices, shuffle_mode, snapshot, begin_offset, album_keys, current_album_key);
+  QFutureWatcher<QList<int>> *watcher = new QFutureWatcher<QList<int>>(this);
+  QObject::connect(watcher, &QFutureWatcher<QList<int>>::finished, this, [this, watcher, generation, snapshot, snapshot_virtual_index]() {
+    const QList<int> shuffled = watcher->result();
+    watcher->deleteLater();
+    if (generation != reshuffle_generation_) return;
+    if (virtual_items_ != snapshot || current_virtual_index_ != snapshot_virtual_index) {
+      ReshuffleIndices();
+      return;
+    }
+    virtual_items_ = shuffled;
+  });
+  watcher->setFuture(future);
+
 }
 
 void Playlist::set_sequence(PlaylistSequence *v) {
@@ -2044,12 +2263,49 @@ PlaylistItemPtrList Playlist::GetAllItems() const { return items_; }
 
 quint64 Playlist::GetTotalLength() const {
 
-  quint64 ret = 0;
-  for (PlaylistItemPtr item : items_) {  // clazy:exclude=range-loop-reference
-    qint64 length = item->Metadata().length_nanosec();
-    if (length > 0) ret += length;
+  if (total_length_dirty_) {
+    quint64 ret = 0;
+    for (PlaylistItemPtr item : items_) {  // clazy:exclude=range-loop-reference
+      qint64 length = item->Metadata().length_nanosec();
+      if (length > 0) ret += length;
+    }
+    total_length_nanosec_ = ret;
+    total_length_dirty_ = false;
   }
-  return ret;
+
+  return total_length_nanosec_;
+
+}
+
+void Playlist::TotalLengthRowsInserted(const QModelIndex &parent, const int first, const int last) {
+
+  Q_UNUSED(parent)
+
+  if (total_length_dirty_) return;
+
+  for (int i = first; i <= last && i < items_.count(); ++i) {
+    const qint64 length = items_[i]->Metadata().length_nanosec();
+    if (length > 0) total_length_nanosec_ += length;
+  }
+
+}
+
+void Playlist::TotalLengthRowsAboutToBeRemoved(const QModelIndex &parent, const int first, const int last) {
+
+  Q_UNUSED(parent)
+
+  if (total_length_dirty_) return;
+
+  for (int i = first; i <= last && i < items_.count(); ++i) {
+    const qint64 length = items_[i]->Metadata().length_nanosec();
+    if (length > 0) total_length_nanosec_ -= length;
+  }
+
+}
+
+void Playlist::TotalLengthInvalidate() {
+
+  total_length_dirty_ = true;
 
 }
 
@@ -2057,6 +2313,10 @@ PlaylistItemPtrList Playlist::collection_items_by_id(const int id) const {
   return collection_items_by_id_.values(id);
 }
 
+QList<int> Playlist::collection_song_ids() const {
+  return collection_items_by_id_.uniqueKeys();
+}
+
 void Playlist::TracksAboutToBeDequeued(const QModelIndex&, int begin, int end) {
 
   for (int i = begin; i <= end; ++i) {
@@ -2339,6 +2599,7 @@ int Playlist::dynamic_history_length() const {
 void Playlist::TurnOffDynamicPlaylist() {
 
   dynamic_playlist_.reset();
+  dynamic_prefetched_items_.clear();
 
   if (playlist_sequence_) {
     ShuffleModeChanged(playlist_sequence_->shuffle_mode());
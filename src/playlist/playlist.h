@@ -32,6 +32,7 @@
 #include <QFuture>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QMultiMap>
 #include <QMetaType>
 #include <QVariant>
@@ -94,7 +95,7 @@ class Playlist : public QAbstractListModel {
   friend class PlaylistUndoCommands::ReOrderItems;
 
  public:
-  explicit Playlist(PlaylistBackend *backend, TaskManager *task_manager, CollectionBackend *collection, const int id, const QString &special_type = QString(), const bool favorite = false, QObject *parent = nullptr);
+  explicit Playlist(PlaylistBackend *backend, TaskManager *task_manager, CollectionBackend *collection, const int id, const QString &special_type = QString(), const bool favorite = false, const bool lazy_restore = false, QObject *parent = nullptr);
   ~Playlist() override;
 
   void SkipTracks(const QModelIndexList &source_indexes);
@@ -140,6 +141,9 @@ class Playlist : public QAbstractListModel {
     Role_StopAfter,
     Role_QueuePosition,
     Role_CanSetRating,
+    // The column's display text lowercased, cached on the playlist item so the
+    // filter doesn't convert the same values again on every keystroke.
+    Role_FilterText,
   };
 
   enum class AutoScroll {
@@ -163,10 +167,16 @@ class Playlist : public QAbstractListModel {
   static const int kUndoStackSize;
   static const int kUndoItemLimit;
 
+  // When fewer than this many dynamic items are buffered ahead, the next batch is generated in the background.
+  static const int kDynamicPrefetchThreshold;
+  static const int kDynamicPrefetchBatchSize;
+
+  static const int kAsyncReshuffleThreshold;
+
   static const qint64 kMinScrobblePointNsecs;
   static const qint64 kMaxScrobblePointNsecs;
 
-  static bool CompareItems(const int column, const Qt::SortOrder order, PlaylistItemPtr a, PlaylistItemPtr b);
+  static void SortItems(const PlaylistItemPtrList::iterator begin, const PlaylistItemPtrList::iterator end, const int column, const Qt::SortOrder order);
 
   static QString column_name(Column column);
   static QString abbreviated_column_name(Column column);
@@ -176,7 +186,13 @@ class Playlist : public QAbstractListModel {
 
   // Persistence
   void Restore();
+  // True for a playlist created with lazy_restore that has not loaded its items from the backend yet, see PlaylistManager.
+  bool restore_pending() const { return restore_pending_; }
   void ScheduleSaveAsync();
+  // Hands any change still sitting in the debounce window over to the backend immediately.
+  // Used at shutdown so exit only waits for playlists that are actually dirty.
+  void FlushSave();
+  bool has_pending_save() const;
 
   // Accessors
   PlaylistFilter *filter() const;
@@ -212,6 +228,8 @@ class Playlist : public QAbstractListModel {
   Song current_item_metadata() const;
 
   PlaylistItemPtrList collection_items_by_id(const int id) const;
+  // The distinct collection song ids currently present in this playlist.
+  QList<int> collection_song_ids() const;
 
   SongList GetAllSongs() const;
   PlaylistItemPtrList GetAllItems() const;
@@ -279,7 +297,7 @@ class Playlist : public QAbstractListModel {
   void sort(int column, Qt::SortOrder order) override;
   bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
-  static bool ComparePathDepths(Qt::SortOrder, PlaylistItemPtr, PlaylistItemPtr);
+  static void SortItemsByPathDepth(const PlaylistItemPtrList::iterator begin, const PlaylistItemPtrList::iterator end, const Qt::SortOrder order);
 
   void ItemChanged(PlaylistItemPtr item);
   void ItemChanged(const int row);
@@ -333,6 +351,11 @@ class Playlist : public QAbstractListModel {
 
   // Signals that the underlying list of items was changed, meaning that something was added to it, removed from it or the ordering changed.
   void PlaylistChanged();
+
+  // Emitted when collection song ids appear in (or disappear from) this playlist, so PlaylistManager can keep its song id index current.
+  // Only 0 -> 1 and 1 -> 0 transitions are reported - adding a second copy of a song, or removing one of two copies, is silent.
+  void CollectionSongsAdded(const QList<int> &song_ids);
+  void CollectionSongsRemoved(const QList<int> &song_ids);
   void DynamicModeChanged(bool dynamic);
 
   void Error(QString message);
@@ -342,6 +365,8 @@ class Playlist : public QAbstractListModel {
 
  private:
   void SetCurrentIsPaused(const bool paused);
+  // Computes the new virtual play order, takes only plain data so it can run on a worker thread.
+  static QList<int> ComputeShuffledIndices(const PlaylistSequence::ShuffleMode shuffle_mode, QList<int> virtual_items, const int begin_offset, const QHash<int, QString> &album_keys, const QString &current_album_key);
   int NextVirtualIndex(int i, const bool ignore_repeat_track) const;
   int PreviousVirtualIndex(int i, const bool ignore_repeat_track) const;
   bool FilterContainsVirtualIndex(const int i) const;
@@ -364,6 +389,8 @@ class Playlist : public QAbstractListModel {
 
   void TurnOnDynamicPlaylist(PlaylistGeneratorPtr gen);
   void InsertDynamicItems(const int count);
+  // Generates the next batch of dynamic items in the background, so the insert at the next track transition is served from memory.
+  void PrefetchDynamicItems();
 
  private slots:
   void TracksAboutToBeDequeued(const QModelIndex&, const int begin, const int end);
@@ -376,6 +403,10 @@ class Playlist : public QAbstractListModel {
   void SongInsertVetoListenerDestroyed();
   void ScheduleSave();
   void Save();
+  // Maintain the cached playlist length from model signals.
+  void TotalLengthRowsInserted(const QModelIndex &parent, const int first, const int last);
+  void TotalLengthRowsAboutToBeRemoved(const QModelIndex &parent, const int first, const int last);
+  void TotalLengthInvalidate();
 
  private:
   bool is_loading_;
@@ -400,6 +431,11 @@ class Playlist : public QAbstractListModel {
   // A map of collection ID to playlist item - for fast lookups when collection items change.
   QMultiMap<int, PlaylistItemPtr> collection_items_by_id_;
 
+  // Summed length of items_, maintained from row insert/remove signals so GetTotalLength() doesn't walk the whole playlist.
+  // dataChanged invalidates it because an edit can change a track's length; the next GetTotalLength() recomputes from scratch.
+  mutable quint64 total_length_nanosec_;
+  mutable bool total_length_dirty_;
+
   QPersistentModelIndex current_item_index_;
   QPersistentModelIndex last_played_item_index_;
   QPersistentModelIndex stop_after_;
@@ -408,6 +444,9 @@ class Playlist : public QAbstractListModel {
 
   bool is_shuffled_;
 
+  // Bumped for every async reshuffle so a finished computation that was superseded is discarded.
+  int reshuffle_generation_;
+
   PlaylistSequence *playlist_sequence_;
 
   // Hack to stop QTreeView::setModel sorting the playlist
@@ -423,6 +462,7 @@ class Playlist : public QAbstractListModel {
 
   // Cancel async restore if songs are already replaced
   bool cancel_restore_;
+  bool restore_pending_;
 
   bool scrobbled_;
   qint64 scrobble_point_;
@@ -431,6 +471,10 @@ class Playlist : public QAbstractListModel {
 
   PlaylistGeneratorPtr dynamic_playlist_;
 
+  // Items generated ahead of need for dynamic mode, and whether a generation is already running.
+  PlaylistItemPtrList dynamic_prefetched_items_;
+  bool dynamic_prefetch_in_progress_;
+
   bool auto_sort_;
   int sort_column_;
   Qt::SortOrder sort_order_;
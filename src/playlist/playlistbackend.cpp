@@ -36,6 +36,8 @@
 #include <QStringList>
 #include <QUrl>
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
 
 #include "core/application.h"
 #include "core/database.h"
@@ -80,6 +82,16 @@ void PlaylistBackend::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
 
+  // Saves handed over after their queued SavePendingPlaylist invocation was processed would otherwise be dropped.
+  QList<int> remaining;
+  {
+    QMutexLocker l(&pending_saves_mutex_);
+    remaining = pending_saves_.keys();
+  }
+  for (const int playlist : remaining) {
+    SavePendingPlaylist(playlist);
+  }
+
   moveToThread(original_thread_);
   emit ExitFinished();
 
@@ -181,6 +193,8 @@ PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
     QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
 
+    playlistitems.reserve(PlaylistItemCount(db, playlist));
+
     QString query = "SELECT songs.ROWID, " + Song::JoinSpec("songs") + ", p.ROWID, " + Song::JoinSpec("p") + ", p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist";
     SqlQuery q(db);
     // Forward iterations only may be faster
@@ -194,8 +208,11 @@ PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
 
     // it's probable that we'll have a few songs associated with the same CUE, so we're caching results of parsing CUEs
     std::shared_ptr<NewSongFromQueryState> state_ptr = std::make_shared<NewSongFromQueryState>();
+    // The field names are the same for every row, resolve them only once.
+    QStringList field_names;
     while (q.next()) {
-      playlistitems << NewPlaylistItemFromQuery(SqlRow(q), state_ptr);
+      if (field_names.isEmpty()) field_names = FieldNames(q);
+      playlistitems << NewPlaylistItemFromQuery(SqlRow(q, field_names), state_ptr);
     }
 
   }
@@ -216,6 +233,8 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
     QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
 
+    songs.reserve(PlaylistItemCount(db, playlist));
+
     QString query = "SELECT songs.ROWID, " + Song::JoinSpec("songs") + ", p.ROWID, " + Song::JoinSpec("p") + ", p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist";
     SqlQuery q(db);
     // Forward iterations only may be faster
@@ -229,8 +248,11 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
 
     // it's probable that we'll have a few songs associated with the same CUE, so we're caching results of parsing CUEs
     std::shared_ptr<NewSongFromQueryState> state_ptr = std::make_shared<NewSongFromQueryState>();
+    // The field names are the same for every row, resolve them only once.
+    QStringList field_names;
     while (q.next()) {
-      songs << NewSongFromQuery(SqlRow(q), state_ptr);
+      if (field_names.isEmpty()) field_names = FieldNames(q);
+      songs << NewSongFromQuery(SqlRow(q, field_names), state_ptr);
     }
 
   }
@@ -243,6 +265,32 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
 
 }
 
+int PlaylistBackend::PlaylistItemCount(const QSqlDatabase &db, const int playlist) {
+
+  SqlQuery q(db);
+  q.prepare("SELECT COUNT(*) FROM playlist_items WHERE playlist = :playlist");
+  q.BindValue(":playlist", playlist);
+  if (!q.Exec() || !q.next()) {
+    return 0;
+  }
+
+  return q.value(0).toInt();
+
+}
+
+QStringList PlaylistBackend::FieldNames(const QSqlQuery &query) {
+
+  const QSqlRecord r = query.record();
+  QStringList field_names;
+  field_names.reserve(r.count());
+  for (int i = 0; i < r.count(); ++i) {
+    field_names << r.fieldName(i);
+  }
+
+  return field_names;
+
+}
+
 PlaylistItemPtr PlaylistBackend::NewPlaylistItemFromQuery(const SqlRow &row, std::shared_ptr<NewSongFromQueryState> state) {
 
   // The song tables get joined first, plus one each for the song ROWIDs
@@ -251,6 +299,19 @@ PlaylistItemPtr PlaylistBackend::NewPlaylistItemFromQuery(const SqlRow &row, std
   PlaylistItemPtr item(PlaylistItem::NewFromSource(static_cast<Song::Source>(row.value(playlist_row).toInt())));
   if (item) {
     item->InitFromQuery(row);
+    // Songs use implicit sharing, so when the same collection song appears more than once, pointing every item at the first restored instance keeps one copy of the metadata instead of one per item.
+    if (item->source() == Song::Source::Collection) {
+      const Song song = item->OriginalMetadata();
+      if (song.id() != -1) {
+        QMutexLocker l(&state->mutex_);
+        if (state->cached_collection_songs_.contains(song.id())) {
+          item->SetMetadata(state->cached_collection_songs_[song.id()]);
+        }
+        else {
+          state->cached_collection_songs_.insert(song.id(), song);
+        }
+      }
+    }
     return RestoreCueData(item, state);
   }
   else {
@@ -318,7 +379,32 @@ PlaylistItemPtr PlaylistBackend::RestoreCueData(PlaylistItemPtr item, std::share
 
 void PlaylistBackend::SavePlaylistAsync(int playlist, const PlaylistItemPtrList &items, int last_played, PlaylistGeneratorPtr dynamic) {
 
-  QMetaObject::invokeMethod(this, "SavePlaylist", Qt::QueuedConnection, Q_ARG(int, playlist), Q_ARG(PlaylistItemPtrList, items), Q_ARG(int, last_played), Q_ARG(PlaylistGeneratorPtr, dynamic));
+  bool already_queued = false;
+  {
+    QMutexLocker l(&pending_saves_mutex_);
+    already_queued = pending_saves_.contains(playlist);
+    PendingSave &pending_save = pending_saves_[playlist];
+    pending_save.items = items;
+    pending_save.last_played = last_played;
+    pending_save.dynamic = dynamic;
+  }
+
+  if (!already_queued) {
+    QMetaObject::invokeMethod(this, "SavePendingPlaylist", Qt::QueuedConnection, Q_ARG(int, playlist));
+  }
+
+}
+
+void PlaylistBackend::SavePendingPlaylist(const int playlist) {
+
+  PendingSave pending_save;
+  {
+    QMutexLocker l(&pending_saves_mutex_);
+    if (!pending_saves_.contains(playlist)) return;
+    pending_save = pending_saves_.take(playlist);
+  }
+
+  SavePlaylist(playlist, pending_save.items, pending_save.last_played, pending_save.dynamic);
 
 }
 
@@ -342,16 +428,18 @@ void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &item
     }
   }
 
-  // Save the new ones
-  for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
+  // Save the new ones, preparing the statement once and rebinding it for every row
+  {
     SqlQuery q(db);
     q.prepare("INSERT INTO playlist_items (playlist, type, collection_id, " + Song::kColumnSpec + ") VALUES (:playlist, :type, :collection_id, " + Song::kBindSpec + ")");
-    q.BindValue(":playlist", playlist);
-    item->BindToQuery(&q);
-
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      return;
+    for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
+      q.BindValue(":playlist", playlist);
+      item->BindToQuery(&q);
+
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
     }
   }
 
@@ -32,6 +32,8 @@
 #include <QList>
 #include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QSqlDatabase>
 #include <QSqlQuery>
 
 #include "core/song.h"
@@ -82,6 +84,7 @@ class PlaylistBackend : public QObject {
   void SetPlaylistUiPath(const int id, const QString &path);
 
   int CreatePlaylist(const QString &name, const QString &special_type);
+  // Queues a save on the backend thread. Saves for the same playlist that are still waiting are replaced instead of queued again, so a burst of changes results in one write.
   void SavePlaylistAsync(const int playlist, const PlaylistItemPtrList &items, const int last_played, PlaylistGeneratorPtr dynamic);
   void RenamePlaylist(const int id, const QString &new_name);
   void FavoritePlaylist(const int id, bool is_favorite);
@@ -93,15 +96,30 @@ class PlaylistBackend : public QObject {
   void Exit();
   void SavePlaylist(const int playlist, const PlaylistItemPtrList &items, const int last_played, PlaylistGeneratorPtr dynamic);
 
+ private slots:
+  void SavePendingPlaylist(const int playlist);
+
  signals:
   void ExitFinished();
 
  private:
   struct NewSongFromQueryState {
     QHash<QString, SongList> cached_cues_;
+    // Collection songs already restored in this batch, keyed by song id, so duplicates share one Song instance instead of each holding their own copy.
+    QHash<int, Song> cached_collection_songs_;
     QMutex mutex_;
   };
 
+  struct PendingSave {
+    PendingSave() : last_played(-1) {}
+    PlaylistItemPtrList items;
+    int last_played;
+    PlaylistGeneratorPtr dynamic;
+  };
+
+  static int PlaylistItemCount(const QSqlDatabase &db, const int playlist);
+  static QStringList FieldNames(const QSqlQuery &query);
+
   Song NewSongFromQuery(const SqlRow &row, std::shared_ptr<NewSongFromQueryState> state);
   PlaylistItemPtr NewPlaylistItemFromQuery(const SqlRow &row, std::shared_ptr<NewSongFromQueryState> state);
   PlaylistItemPtr RestoreCueData(PlaylistItemPtr item, std::shared_ptr<NewSongFromQueryState> state);
@@ -116,6 +134,9 @@ class PlaylistBackend : public QObject {
   Application *app_;
   Database *db_;
   QThread *original_thread_;
+
+  QHash<int, PendingSave> pending_saves_;
+  QMutex pending_saves_mutex_;
 };
 
 #endif  // PLAYLISTBACKEND_H
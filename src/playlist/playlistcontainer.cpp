@@ -486,8 +486,8 @@ void PlaylistContainer::RepositionNoMatchesLabel(const bool force) {
 
 }
 
-void PlaylistContainer::SelectionChanged() {
-  manager_->SelectionChanged(view()->selectionModel()->selection());
+void PlaylistContainer::SelectionChanged(const QItemSelection &selected, const QItemSelection &deselected) {
+  manager_->SelectionChanged(view()->selectionModel()->selection(), selected, deselected);
 }
 
 bool PlaylistContainer::eventFilter(QObject *objectWatched, QEvent *event) {
@@ -37,6 +37,7 @@ class QAction;
 class QEvent;
 class QKeyEvent;
 class QResizeEvent;
+class QItemSelection;
 
 class Playlist;
 class PlaylistManager;
@@ -96,7 +97,7 @@ class PlaylistContainer : public QWidget {
   void SetTabBarVisible(const bool visible);
   void SetTabBarHeight(const int height);
 
-  void SelectionChanged();
+  void SelectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
   void MaybeUpdateFilter();
   void UpdateFilter();
   void FocusOnFilter(QKeyEvent *event);
@@ -58,6 +58,7 @@
 #include <QToolTip>
 #include <QTreeView>
 #include <QWhatsThis>
+#include <QStyle>
 #include <QStyledItemDelegate>
 #include <QStyleOptionViewItem>
 #include <QtEvents>
@@ -78,6 +79,7 @@ const QRgb QueuedItemDelegate::kQueueBoxGradientColor1 = qRgb(102, 150, 227);
 const QRgb QueuedItemDelegate::kQueueBoxGradientColor2 = qRgb(77, 121, 200);
 const int QueuedItemDelegate::kQueueOpacitySteps = 10;
 const float QueuedItemDelegate::kQueueOpacityLowerBound = 0.4F;
+const int QueuedItemDelegate::kElidedTextCacheSize = 4096;
 
 const int PlaylistDelegateBase::kMinHeight = 19;
 
@@ -87,7 +89,22 @@ QueuedItemDelegate::QueuedItemDelegate(QObject *parent, int indicator_column)
 
 void QueuedItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &idx) const {
 
-  QStyledItemDelegate::paint(painter, option, idx);
+  QStyleOptionViewItem opt(option);
+  initStyleOption(&opt, idx);
+
+  const QWidget *widget = opt.widget;
+  QStyle *style = widget ? widget->style() : QApplication::style();
+
+  // Eliding the text is surprisingly expensive and the same rows are repainted over and over while scrolling or while the current track bar is glowing, so elide up front and cache the result.
+  if (opt.features.testFlag(QStyleOptionViewItem::HasDisplay) && !opt.text.isEmpty() && !opt.text.contains('\n') && opt.textElideMode != Qt::ElideNone) {
+    QRect text_rect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+    const int text_margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    text_rect.adjust(text_margin, 0, -text_margin, 0);
+    opt.text = CachedElidedText(opt.text, opt.font, text_rect.width(), opt.textElideMode);
+    opt.textElideMode = Qt::ElideNone;
+  }
+
+  style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
 
   if (idx.column() == indicator_column_) {
     bool ok = false;
@@ -152,6 +169,22 @@ void QueuedItemDelegate::DrawBox(QPainter *painter, const QRect line_rect, const
 
 }
 
+QString QueuedItemDelegate::CachedElidedText(const QString &text, const QFont &font, const int width, const Qt::TextElideMode mode) const {
+
+  const QString key = font.key() + QChar('\x01') + QString::number(width) + QChar('\x01') + QString::number(mode) + QChar('\x01') + text;
+
+  QHash<QString, QString>::const_iterator it = elided_text_cache_.constFind(key);
+  if (it != elided_text_cache_.constEnd()) return it.value();
+
+  const QString elided = QFontMetrics(font).elidedText(text, mode, width);
+
+  if (elided_text_cache_.count() >= kElidedTextCacheSize) elided_text_cache_.clear();
+  elided_text_cache_.insert(key, elided);
+
+  return elided;
+
+}
+
 int QueuedItemDelegate::queue_indicator_size(const QModelIndex &idx) const {
 
   if (idx.column() == indicator_column_) {
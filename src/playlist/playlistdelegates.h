@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QWidget>
 #include <QAbstractItemView>
+#include <QHash>
 #include <QStyledItemDelegate>
 #include <QStyleOptionViewItem>
 #include <QTreeView>
@@ -65,6 +66,9 @@ class QueuedItemDelegate : public QStyledItemDelegate {
 
   int queue_indicator_size(const QModelIndex &idx) const;
 
+ private:
+  QString CachedElidedText(const QString &text, const QFont &font, const int width, const Qt::TextElideMode mode) const;
+
  private:
   static const int kQueueBoxBorder;
   static const int kQueueBoxCornerRadius;
@@ -73,8 +77,11 @@ class QueuedItemDelegate : public QStyledItemDelegate {
   static const QRgb kQueueBoxGradientColor2;
   static const int kQueueOpacitySteps;
   static const float kQueueOpacityLowerBound;
+  static const int kElidedTextCacheSize;
 
   int indicator_column_;
+  // Keyed by font, column width and cell text, so edits and header resizes miss the cache naturally instead of needing explicit invalidation.
+  mutable QHash<QString, QString> elided_text_cache_;
 };
 
 class PlaylistDelegateBase : public QueuedItemDelegate {
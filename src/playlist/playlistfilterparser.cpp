@@ -194,7 +194,8 @@ class FilterTerm : public FilterTree {
   bool accept(int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
     for (int i : columns_) {
       QModelIndex idx(model->index(row, i, parent));
-      if (cmp_->Matches(idx.data().toString().toLower())) return true;
+      // Role_FilterText is the display text pre-lowercased and cached on the playlist item.
+      if (cmp_->Matches(idx.data(Playlist::Role_FilterText).toString())) return true;
     }
     return false;
   }
@@ -211,7 +212,7 @@ class FilterColumnTerm : public FilterTree {
 
   bool accept(int row, const QModelIndex &parent, const QAbstractItemModel *const model) const override {
     QModelIndex idx(model->index(row, col, parent));
-    return cmp_->Matches(idx.data().toString().toLower());
+    return cmp_->Matches(idx.data(Playlist::Role_FilterText).toString());
   }
   FilterType type() override { return FilterType::Column; }
  private:
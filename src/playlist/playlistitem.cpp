@@ -99,6 +99,7 @@ void PlaylistItem::BindToQuery(SqlQuery *query) const {
 
 void PlaylistItem::SetTemporaryMetadata(const Song &metadata) {
   temp_metadata_ = metadata;
+  InvalidateFilterTextCache();
 }
 
 void PlaylistItem::UpdateTemporaryMetadata(const Song &metadata) {
@@ -113,10 +114,13 @@ void PlaylistItem::UpdateTemporaryMetadata(const Song &metadata) {
   if (temp_metadata_.bitdepth() <= 0 && old_metadata.bitdepth() > 0) temp_metadata_.set_bitdepth(old_metadata.bitdepth());
   if (temp_metadata_.bitrate() <= 0 && old_metadata.bitrate() > 0) temp_metadata_.set_bitrate(old_metadata.bitrate());
 
+  InvalidateFilterTextCache();
+
 }
 
 void PlaylistItem::ClearTemporaryMetadata() {
   temp_metadata_ = Song();
+  InvalidateFilterTextCache();
 }
 
 static void ReloadPlaylistItem(PlaylistItemPtr item) {
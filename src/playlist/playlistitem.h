@@ -106,6 +106,13 @@ class PlaylistItem : public std::enable_shared_from_this<PlaylistItem> {
   QColor GetCurrentForegroundColor() const;
   bool HasCurrentForegroundColor() const;
 
+  // Lowercased column text cached for the playlist filter, see
+  // Playlist::Role_FilterText.  Invalidated whenever the metadata changes.
+  bool HasFilterTextCache(const int column) const { return filter_text_cache_.contains(column); }
+  QString FilterTextCache(const int column) const { return filter_text_cache_.value(column); }
+  void SetFilterTextCache(const int column, const QString &text) { filter_text_cache_.insert(column, text); }
+  void InvalidateFilterTextCache() { filter_text_cache_.clear(); }
+
   // Convenience function to find out whether this item is from the local collection, as opposed to a device, a file on disk, or a stream.
   // Remember that even if this returns true, the collection item might be invalid, so you might want to check that its id is not equal to -1 before actually using it.
   virtual bool IsLocalCollectionItem() const { return false; }
@@ -129,6 +136,9 @@ class PlaylistItem : public std::enable_shared_from_this<PlaylistItem> {
   QMap<short, QColor> background_colors_;
   QMap<short, QColor> foreground_colors_;
 
+ private:
+  QMap<int, QString> filter_text_cache_;
+
   Q_DISABLE_COPY(PlaylistItem)
 };
 using PlaylistItemPtr = std::shared_ptr<PlaylistItem>;
@@ -42,6 +42,7 @@
 #include <QScrollBar>
 #include <QSettings>
 #include <QMessageBox>
+#include <QTimer>
 
 #include "core/application.h"
 #include "core/player.h"
@@ -62,6 +63,11 @@
 
 class ParserBase;
 
+namespace {
+// Delay between lazy restores of background playlist tabs, so their database loads stay out of the startup critical path.
+constexpr int kLazyRestoreIntervalMs = 500;
+}  // namespace
+
 PlaylistManager::PlaylistManager(Application *app, QObject *parent)
     : PlaylistManagerInterface(app, parent),
       app_(app),
@@ -72,7 +78,8 @@ PlaylistManager::PlaylistManager(Application *app, QObject *parent)
       playlist_container_(nullptr),
       current_(-1),
       active_(-1),
-      playlists_loading_(0) {
+      playlists_loading_(0),
+      lazy_restore_timer_(new QTimer(this)) {
 
   QObject::connect(app_->player(), &Player::Paused, this, &PlaylistManager::SetActivePaused);
   QObject::connect(app_->player(), &Player::Playing, this, &PlaylistManager::SetActivePlaying);
@@ -97,17 +104,31 @@ void PlaylistManager::Init(CollectionBackend *collection_backend, PlaylistBacken
 
   QObject::connect(collection_backend_, &CollectionBackend::SongsDiscovered, this, &PlaylistManager::SongsDiscovered);
   QObject::connect(collection_backend_, &CollectionBackend::SongsStatisticsChanged, this, &PlaylistManager::SongsDiscovered);
+  QObject::connect(collection_backend_, &CollectionBackend::SongsStatisticsPending, this, &PlaylistManager::SongsDiscovered);
   QObject::connect(collection_backend_, &CollectionBackend::SongsRatingChanged, this, &PlaylistManager::SongsDiscovered);
 
+  lazy_restore_timer_->setSingleShot(true);
+  lazy_restore_timer_->setInterval(kLazyRestoreIntervalMs);
+  QObject::connect(lazy_restore_timer_, &QTimer::timeout, this, &PlaylistManager::LazyRestoreNextPlaylist);
+
+  // Only the playlist whose tab is shown at startup is worth restoring eagerly.
+  // The rest open as empty models and load their items when their tab is first activated, or shortly afterwards from the lazy restore timer.
+  QSettings s;
+  s.beginGroup(Playlist::kSettingsGroup);
+  const int eager_id = s.value("current_playlist", 1).toInt();
+  s.endGroup();
+
   for (const PlaylistBackend::Playlist &p : playlist_backend->GetAllOpenPlaylists()) {
     ++playlists_loading_;
-    Playlist *ret = AddPlaylist(p.id, p.name, p.special_type, p.ui_path, p.favorite);
+    Playlist *ret = AddPlaylist(p.id, p.name, p.special_type, p.ui_path, p.favorite, p.id != eager_id);
     QObject::connect(ret, &Playlist::PlaylistLoaded, this, &PlaylistManager::PlaylistLoaded);
   }
 
   // If no playlist exists then make a new one
   if (playlists_.isEmpty()) New(tr("Playlist"));
 
+  lazy_restore_timer_->start();
+
   emit PlaylistManagerInitialized();
 
 }
@@ -121,6 +142,32 @@ void PlaylistManager::PlaylistLoaded() {
   if (playlists_loading_ == 0) {
     emit AllPlaylistsLoaded();
   }
+  else if (!lazy_restore_timer_->isActive()) {
+    // Chain the next background restore so playlists hydrate one at a time.
+    lazy_restore_timer_->start();
+  }
+
+}
+
+void PlaylistManager::LazyRestoreNextPlaylist() {
+
+  // One playlist per tick, so background hydration never bursts database work.
+  // PlaylistLoaded restarts the timer when there are still playlists left to load.
+  const QList<int> ids = playlists_.keys();
+  for (const int id : ids) {
+    if (playlists_[id].p->restore_pending()) {
+      playlists_[id].p->Restore();
+      return;
+    }
+  }
+
+}
+
+void PlaylistManager::EnsureRestored(const int id) {
+
+  if (playlists_.contains(id) && playlists_[id].p->restore_pending()) {
+    playlists_[id].p->Restore();
+  }
 
 }
 
@@ -143,15 +190,21 @@ QItemSelection PlaylistManager::selection(const int id) const {
   return it->selection;
 }
 
-Playlist *PlaylistManager::AddPlaylist(const int id, const QString &name, const QString &special_type, const QString &ui_path, const bool favorite) {
+Playlist *PlaylistManager::AddPlaylist(const int id, const QString &name, const QString &special_type, const QString &ui_path, const bool favorite, const bool lazy_restore) {
 
-  Playlist *ret = new Playlist(playlist_backend_, app_->task_manager(), collection_backend_, id, special_type, favorite);
+  Playlist *ret = new Playlist(playlist_backend_, app_->task_manager(), collection_backend_, id, special_type, favorite, lazy_restore);
   ret->set_sequence(sequence_);
   ret->set_ui_path(ui_path);
 
   QObject::connect(ret, &Playlist::CurrentSongChanged, this, &PlaylistManager::CurrentSongChanged);
   QObject::connect(ret, &Playlist::SongMetadataChanged, this, &PlaylistManager::SongMetadataChanged);
+  QObject::connect(ret, &Playlist::CollectionSongsAdded, this, &PlaylistManager::PlaylistCollectionSongsAdded);
+  QObject::connect(ret, &Playlist::CollectionSongsRemoved, this, &PlaylistManager::PlaylistCollectionSongsRemoved);
   QObject::connect(ret, &Playlist::PlaylistChanged, this, &PlaylistManager::OneOfPlaylistsChanged);
+  // Structural changes can shift or invalidate the stored selection, so the running selection totals have to be rebuilt.
+  QObject::connect(ret, &Playlist::PlaylistChanged, this, [this, id]() { playlists_[id].selection_dirty = true; });
+  // A metadata edit can change the length of a selected row, and the deltas would later subtract the new length on deselect.
+  QObject::connect(ret, &Playlist::dataChanged, this, [this, id]() { playlists_[id].selection_dirty = true; });
   QObject::connect(ret, &Playlist::PlaylistChanged, this, &PlaylistManager::UpdateSummaryText);
   QObject::connect(ret, &Playlist::EditingFinished, this, &PlaylistManager::EditingFinished);
   QObject::connect(ret, &Playlist::Error, this, &PlaylistManager::Error);
@@ -213,11 +266,12 @@ void PlaylistManager::Load(const QString &filename) {
 
 void PlaylistManager::Save(const int id, const QString &filename, const PlaylistSettingsPage::PathType path_type) {
 
-  if (playlists_.contains(id)) {
+  if (playlists_.contains(id) && !playlists_[id].p->restore_pending()) {
     parser_->Save(playlist(id)->GetAllSongs(), filename, path_type);
   }
   else {
-    // Playlist is not in the playlist manager: probably save action was triggered from the left sidebar and the playlist isn't loaded.
+    // Playlist is not in the playlist manager, or it's open on a background tab that hasn't restored its items yet:
+    // either way fetch the songs straight from the backend.
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     QFuture<SongList> future = QtConcurrent::run(&PlaylistBackend::GetPlaylistSongs, playlist_backend_, id);
 #else
@@ -328,6 +382,10 @@ bool PlaylistManager::Close(const int id) {
   if (id == current_) SetCurrentPlaylist(next_id);
 
   Data data = playlists_.take(id);
+  const QList<int> song_ids = data.p->collection_song_ids();
+  for (const int song_id : song_ids) {
+    playlist_ids_by_song_id_.remove(song_id, id);
+  }
   emit PlaylistClosed(id);
 
   if (!data.p->is_favorite()) {
@@ -359,12 +417,16 @@ void PlaylistManager::SetCurrentPlaylist(const int id) {
 
   Q_ASSERT(playlists_.contains(id));
 
+  EnsureRestored(id);
+
   // Save the scroll position for the current playlist.
   if (playlists_.contains(current_)) {
     playlists_[current_].scroll_position = playlist_container_->view()->verticalScrollBar()->value();
   }
 
   current_ = id;
+  // The view's selection model changes with the playlist, so the next selection delta has no valid base to apply against.
+  playlists_[id].selection_dirty = true;
   emit CurrentChanged(current(), playlists_[id].scroll_position);
   UpdateSummaryText();
 
@@ -374,6 +436,8 @@ void PlaylistManager::SetActivePlaylist(const int id) {
 
   Q_ASSERT(playlists_.contains(id));
 
+  EnsureRestored(id);
+
   // Kinda a hack: unset the current item from the old active playlist before setting the new one
   if (active_ != -1 && active_ != id) active()->set_current_row(-1);
 
@@ -424,25 +488,33 @@ void PlaylistManager::ChangePlaylistOrder(const QList<int> &ids) {
 
 void PlaylistManager::UpdateSummaryText() {
 
-  int tracks = current()->rowCount();
-  quint64 nanoseconds = 0;
-  int selected = 0;
-
-  // Get the length of the selected tracks
-  for (const QItemSelectionRange &range : playlists_[current_id()].selection) {
-    if (!range.isValid()) continue;
-
-    selected += range.bottom() - range.top() + 1;
-    for (int i = range.top(); i <= range.bottom(); ++i) {
-      qint64 length = range.model()->index(i, Playlist::Column_Length).data().toLongLong();
-      if (length > 0) {
-        nanoseconds += length;
+  Data &data = playlists_[current_id()];
+
+  // Rebuild the running selection totals if a structural change invalidated them.
+  if (data.selection_dirty) {
+    data.selected_rows = 0;
+    data.selected_length_nanosec = 0;
+    for (const QItemSelectionRange &range : std::as_const(data.selection)) {
+      if (!range.isValid()) continue;
+
+      data.selected_rows += range.bottom() - range.top() + 1;
+      for (int i = range.top(); i <= range.bottom(); ++i) {
+        const qint64 length = range.model()->index(i, Playlist::Column_Length).data().toLongLong();
+        if (length > 0) {
+          data.selected_length_nanosec += length;
+        }
       }
     }
+    data.selection_dirty = false;
   }
 
+  const int tracks = current()->rowCount();
+  const int selected = data.selected_rows;
+  quint64 nanoseconds = 0;
+
   QString summary;
   if (selected > 1) {
+    nanoseconds = data.selected_length_nanosec;
     summary += tr("%1 selected of").arg(selected) + " ";
   }
   else {
@@ -460,29 +532,91 @@ void PlaylistManager::UpdateSummaryText() {
 
 }
 
-void PlaylistManager::SelectionChanged(const QItemSelection &selection) {
-  playlists_[current_id()].selection = selection;
+void PlaylistManager::SelectionChanged(const QItemSelection &selection, const QItemSelection &selected, const QItemSelection &deselected) {
+
+  Data &data = playlists_[current_id()];
+  data.selection = selection;
+
+  // Apply only the delta, so dragging a rubber band over a large playlist costs O(changed rows) instead of O(selection) per change.
+  if (!data.selection_dirty) {
+    for (const QItemSelectionRange &range : selected) {
+      if (!range.isValid()) {
+        data.selection_dirty = true;
+        break;
+      }
+      data.selected_rows += range.bottom() - range.top() + 1;
+      for (int i = range.top(); i <= range.bottom(); ++i) {
+        const qint64 length = range.model()->index(i, Playlist::Column_Length).data().toLongLong();
+        if (length > 0) {
+          data.selected_length_nanosec += length;
+        }
+      }
+    }
+  }
+  if (!data.selection_dirty) {
+    for (const QItemSelectionRange &range : deselected) {
+      if (!range.isValid()) {
+        data.selection_dirty = true;
+        break;
+      }
+      data.selected_rows -= range.bottom() - range.top() + 1;
+      for (int i = range.top(); i <= range.bottom(); ++i) {
+        const qint64 length = range.model()->index(i, Playlist::Column_Length).data().toLongLong();
+        if (length > 0) {
+          data.selected_length_nanosec -= length;
+        }
+      }
+    }
+  }
+
   UpdateSummaryText();
+
 }
 
 void PlaylistManager::SongsDiscovered(const SongList &songs) {
 
-  // Some songs might've changed in the collection, let's update any playlist items we have that match those songs
+  // Some songs might've changed in the collection, let's update any playlist items we have that match those songs.
+  // The inverted index tells us which playlists contain each song, so we only visit those instead of every open playlist.
 
   for (const Song &song : songs) {
-    for (const Data &data : std::as_const(playlists_)) {
-      PlaylistItemPtrList items = data.p->collection_items_by_id(song.id());
+    const QList<int> playlist_ids = playlist_ids_by_song_id_.values(song.id());
+    for (const int playlist_id : playlist_ids) {
+      if (!playlists_.contains(playlist_id)) continue;
+      Playlist *p = playlists_[playlist_id].p;
+      const PlaylistItemPtrList items = p->collection_items_by_id(song.id());
       for (PlaylistItemPtr item : items) {
         if (item->Metadata().directory_id() != song.directory_id()) continue;
         item->SetMetadata(song);
         if (item->HasTemporaryMetadata()) item->UpdateTemporaryMetadata(song);
-        data.p->ItemChanged(item);
+        p->ItemChanged(item);
       }
     }
   }
 
 }
 
+void PlaylistManager::PlaylistCollectionSongsAdded(const QList<int> &song_ids) {
+
+  Playlist *playlist = qobject_cast<Playlist*>(sender());
+  if (!playlist) return;
+  for (const int song_id : song_ids) {
+    if (!playlist_ids_by_song_id_.contains(song_id, playlist->id())) {
+      playlist_ids_by_song_id_.insert(song_id, playlist->id());
+    }
+  }
+
+}
+
+void PlaylistManager::PlaylistCollectionSongsRemoved(const QList<int> &song_ids) {
+
+  Playlist *playlist = qobject_cast<Playlist*>(sender());
+  if (!playlist) return;
+  for (const int song_id : song_ids) {
+    playlist_ids_by_song_id_.remove(song_id, playlist->id());
+  }
+
+}
+
 // When Player has processed the new song chosen by the user...
 void PlaylistManager::SongChangeRequestProcessed(const QUrl &url, const bool valid) {
 
@@ -498,6 +632,8 @@ void PlaylistManager::InsertUrls(const int id, const QList<QUrl> &urls, const in
 
   Q_ASSERT(playlists_.contains(id));
 
+  EnsureRestored(id);
+
   playlists_[id].p->InsertUrls(urls, pos, play_now, enqueue);
 
 }
@@ -506,6 +642,8 @@ void PlaylistManager::InsertSongs(const int id, const SongList &songs, const int
 
   Q_ASSERT(playlists_.contains(id));
 
+  EnsureRestored(id);
+
   playlists_[id].p->InsertSongs(songs, pos, play_now, enqueue);
 
 }
@@ -514,6 +652,8 @@ void PlaylistManager::RemoveItemsWithoutUndo(const int id, const QList<int> &ind
 
   Q_ASSERT(playlists_.contains(id));
 
+  EnsureRestored(id);
+
   playlists_[id].p->RemoveItemsWithoutUndo(indices);
 
 }
@@ -654,3 +794,13 @@ void PlaylistManager::SaveAllPlaylists() {
   }
 
 }
+
+void PlaylistManager::FlushDirtyPlaylists() {
+
+  for (QMap<int, Data>::const_iterator it = playlists_.constBegin(); it != playlists_.constEnd(); ++it) {
+    if (it.value().p && it.value().p->has_pending_save()) {
+      it.value().p->FlushSave();
+    }
+  }
+
+}
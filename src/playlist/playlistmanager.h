@@ -30,6 +30,7 @@
 #include <QFuture>
 #include <QList>
 #include <QMap>
+#include <QMultiHash>
 #include <QString>
 #include <QUrl>
 
@@ -39,6 +40,7 @@
 #include "smartplaylists/playlistgenerator.h"
 
 class QModelIndex;
+class QTimer;
 
 class Application;
 class CollectionBackend;
@@ -97,7 +99,7 @@ class PlaylistManagerInterface : public QObject {
   virtual void SetActivePlaylist(const int id) = 0;
   virtual void SetActiveToCurrent() = 0;
 
-  virtual void SelectionChanged(const QItemSelection &selection) = 0;
+  virtual void SelectionChanged(const QItemSelection &selection, const QItemSelection &selected, const QItemSelection &deselected) = 0;
 
   // Convenience slots that defer to either current() or active()
   virtual void ClearCurrent() = 0;
@@ -196,7 +198,7 @@ class PlaylistManager : public PlaylistManagerInterface {
   void SetActivePlaylist(const int id) override;
   void SetActiveToCurrent() override;
 
-  void SelectionChanged(const QItemSelection &selection) override;
+  void SelectionChanged(const QItemSelection &selection, const QItemSelection &selected, const QItemSelection &deselected) override;
 
   // Makes a playlist current if it's open already, or opens it and makes it current if it is hidden.
   void SetCurrentOrOpen(const int id);
@@ -225,6 +227,10 @@ class PlaylistManager : public PlaylistManagerInterface {
 
   void SaveAllPlaylists();
 
+  // Pushes still-dirty playlists to the backend so shutdown only writes what actually changed.
+  // Playlists save themselves incrementally during runtime; this only catches changes from the last debounce window.
+  void FlushDirtyPlaylists();
+
  private slots:
   void SetActivePlaying() override;
   void SetActivePaused() override;
@@ -233,19 +239,28 @@ class PlaylistManager : public PlaylistManagerInterface {
   void OneOfPlaylistsChanged();
   void UpdateSummaryText();
   void SongsDiscovered(const SongList &songs);
+  void PlaylistCollectionSongsAdded(const QList<int> &song_ids);
+  void PlaylistCollectionSongsRemoved(const QList<int> &song_ids);
   void ItemsLoadedForSavePlaylist(const SongList &songs, const QString &filename, const PlaylistSettingsPage::PathType path_type);
   void PlaylistLoaded();
+  void LazyRestoreNextPlaylist();
 
  private:
-  Playlist *AddPlaylist(const int id, const QString &name, const QString &special_type, const QString &ui_path, const bool favorite);
+  Playlist *AddPlaylist(const int id, const QString &name, const QString &special_type, const QString &ui_path, const bool favorite, const bool lazy_restore = false);
+  // Starts the deferred item load for a lazily restored playlist.  Called before a playlist becomes visible or is modified.
+  void EnsureRestored(const int id);
 
  private:
   struct Data {
-    explicit Data(Playlist *_p = nullptr, const QString &_name = QString()) : p(_p), name(_name), scroll_position(0) {}
+    explicit Data(Playlist *_p = nullptr, const QString &_name = QString()) : p(_p), name(_name), scroll_position(0), selected_rows(0), selected_length_nanosec(0), selection_dirty(false) {}
     Playlist *p;
     QString name;
     QItemSelection selection;
     int scroll_position;
+    // Running totals over the selection, updated from selection deltas so a rubber-band drag costs O(changed rows).
+    int selected_rows;
+    quint64 selected_length_nanosec;
+    bool selection_dirty;
   };
 
   Application *app_;
@@ -258,9 +273,16 @@ class PlaylistManager : public PlaylistManagerInterface {
   // key = id
   QMap<int, Data> playlists_;
 
+  // Inverted index: collection song id -> ids of open playlists containing that song.
+  // Lets SongsDiscovered touch only the playlists a changed song is actually in instead of asking every open playlist.
+  QMultiHash<int, int> playlist_ids_by_song_id_;
+
   int current_;
   int active_;
   int playlists_loading_;
+
+  // Hydrates background tabs one at a time after startup, so their items are loaded outside the startup critical path.
+  QTimer *lazy_restore_timer_;
 };
 
 #endif  // PLAYLISTMANAGER_H
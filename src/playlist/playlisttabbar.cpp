@@ -425,8 +425,9 @@ void PlaylistTabBar::dropEvent(QDropEvent *e) {
 
   if (drag_hover_tab_ == -1) {
     const MimeData *mime_data = qobject_cast<const MimeData*>(e->mimeData());
-    if (mime_data && !mime_data->name_for_new_playlist_.isEmpty()) {
-      manager_->New(mime_data->name_for_new_playlist_);
+    if (mime_data) {
+      // get_name_for_new_playlist() instead of the field - lazy mime data only fills the name once the songs are resolved.
+      manager_->New(mime_data->get_name_for_new_playlist());
     }
     else {
       manager_->New(tr("Playlist"));
@@ -20,10 +20,18 @@
 
 #include "config.h"
 
+#include <memory>
+
 #include <QtGlobal>
 #include <QList>
+#include <QMap>
+#include <QMultiHash>
 #include <QUndoStack>
 
+#include "core/logging.h"
+#include "core/song.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionplaylistitem.h"
 #include "playlist.h"
 #include "playlistitem.h"
 #include "playlistundocommands.h"
@@ -74,6 +82,24 @@ void RemoveItems::redo() {
 
   for (int i = 0; i < ranges_.count(); ++i) {
     ranges_[i].items_ = playlist_->RemoveItemsWithoutUndo(ranges_[i].pos_, ranges_[i].count_);
+    CompactRange(ranges_[i]);
+  }
+
+}
+
+void RemoveItems::CompactRange(Range &range) {
+
+  range.collection_ids_.clear();
+  range.collection_ids_.reserve(range.items_.count());
+
+  for (int i = 0; i < range.items_.count(); ++i) {
+    const PlaylistItemPtr &item = range.items_[i];
+    int id = -1;
+    if (item->IsLocalCollectionItem() && !item->HasTemporaryMetadata()) {
+      id = item->Metadata().id();
+      if (id != -1) range.items_[i].reset();
+    }
+    range.collection_ids_ << id;
   }
 
 }
@@ -81,7 +107,34 @@ void RemoveItems::redo() {
 void RemoveItems::undo() {
 
   for (int i = static_cast<int>(ranges_.count() - 1); i >= 0; --i) {
-    playlist_->InsertItemsWithoutUndo(ranges_[i].items_, ranges_[i].pos_);
+    Range &range = ranges_[i];
+
+    QList<int> ids;
+    for (const int id : range.collection_ids_) {
+      if (id != -1) ids << id;
+    }
+    QMap<int, Song> songs;
+    if (!ids.isEmpty()) {
+      const SongList song_list = playlist_->collection_->GetSongsById(ids);
+      for (const Song &song : song_list) songs.insert(song.id(), song);
+    }
+
+    PlaylistItemPtrList items;
+    items.reserve(range.items_.count());
+    for (int j = 0; j < range.items_.count(); ++j) {
+      if (range.items_[j]) {
+        items << range.items_[j];
+      }
+      else if (songs.contains(range.collection_ids_[j])) {
+        items << std::make_shared<CollectionPlaylistItem>(songs[range.collection_ids_[j]]);
+      }
+      else {
+        qLog(Warning) << "Can't restore song with rowid" << range.collection_ids_[j] << "- no longer in the collection";
+      }
+    }
+    range.count_ = static_cast<int>(items.count());
+
+    playlist_->InsertItemsWithoutUndo(items, range.pos_);
   }
 
 }
@@ -117,12 +170,42 @@ void MoveItems::undo() {
   playlist_->MoveItemsWithoutUndo(pos_, source_rows_);
 }
 
-ReOrderItems::ReOrderItems(Playlist *playlist, const PlaylistItemPtrList &new_items)
-    : Base(playlist), old_items_(playlist->items_), new_items_(new_items) {}
+ReOrderItems::ReOrderItems(Playlist *playlist, const PlaylistItemPtrList &new_items) : Base(playlist) {
 
-void ReOrderItems::undo() { playlist_->ReOrderWithoutUndo(old_items_); }
+  QMultiHash<const PlaylistItem*, int> positions;
+  for (int i = static_cast<int>(playlist->items_.count()) - 1; i >= 0; --i) {
+    positions.insert(playlist->items_[i].get(), i);
+  }
+
+  permutation_.reserve(new_items.count());
+  for (const PlaylistItemPtr &item : new_items) {
+    permutation_ << positions.take(item.get());
+  }
+
+}
+
+void ReOrderItems::undo() {
+
+  const PlaylistItemPtrList items = playlist_->items_;
+  PlaylistItemPtrList old_items = items;
+  for (int i = 0; i < permutation_.count(); ++i) {
+    old_items[permutation_[i]] = items[i];
+  }
+  playlist_->ReOrderWithoutUndo(old_items);
+
+}
+
+void ReOrderItems::redo() {
 
-void ReOrderItems::redo() { playlist_->ReOrderWithoutUndo(new_items_); }
+  const PlaylistItemPtrList items = playlist_->items_;
+  PlaylistItemPtrList new_items;
+  new_items.reserve(items.count());
+  for (const int i : permutation_) {
+    new_items << items[i];
+  }
+  playlist_->ReOrderWithoutUndo(new_items);
+
+}
 
 SortItems::SortItems(Playlist *playlist, int column, Qt::SortOrder order, const PlaylistItemPtrList &new_items)
     : ReOrderItems(playlist, new_items) {
@@ -80,9 +80,15 @@ namespace PlaylistUndoCommands {
       Range(int pos, int count) : pos_(pos), count_(count) {}
       int pos_;
       int count_;
+      // Items that can't be recreated from the collection are kept alive here,
+      // collection items are dropped and only their rowids remembered so a
+      // deep undo stack doesn't pin the removed songs in memory.
       PlaylistItemPtrList items_;
+      QList<int> collection_ids_;
     };
 
+    void CompactRange(Range &range);
+
     QList<Range> ranges_;
   };
 
@@ -106,8 +112,9 @@ namespace PlaylistUndoCommands {
     void redo() override;
 
    private:
-    PlaylistItemPtrList old_items_;
-    PlaylistItemPtrList new_items_;
+    // Only the permutation is stored, the items themselves stay owned by the
+    // playlist and the new order is rebuilt from them on undo/redo.
+    QList<int> permutation_;
   };
 
   class SortItems : public ReOrderItems {
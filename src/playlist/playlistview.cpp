@@ -37,6 +37,9 @@
 #include <QKeySequence>
 #include <QMimeData>
 #include <QMetaType>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QList>
 #include <QSize>
 #include <QTimeLine>
@@ -66,6 +69,7 @@
 #include "core/application.h"
 #include "core/player.h"
 #include "core/qt_blurimage.h"
+#include "core/settingswriter.h"
 #include "core/song.h"
 #include "playlistmanager.h"
 #include "playlist.h"
@@ -87,6 +91,7 @@ const int PlaylistView::kGlowIntensitySteps = 24;
 const int PlaylistView::kAutoscrollGraceTimeout = 30;  // seconds
 const int PlaylistView::kDropIndicatorWidth = 2;
 const int PlaylistView::kDropIndicatorGradientWidth = 5;
+const int PlaylistView::kRenderedBackgroundCacheSize = 8;
 
 PlaylistProxyStyle::PlaylistProxyStyle(QObject*) : QProxyStyle(nullptr), common_style_(new QCommonStyle) {}
 
@@ -151,6 +156,10 @@ PlaylistView::PlaylistView(QWidget *parent)
       header_state_loaded_(false),
       header_state_restored_(false),
       read_only_settings_(false),
+      background_image_key_(0),
+      background_render_in_progress_(false),
+      background_render_queued_(false),
+      background_fade_pending_(false),
       previous_background_image_opacity_(0.0),
       fade_animation_(new QTimeLine(1000, this)),
       force_background_redraw_(false),
@@ -1026,30 +1035,10 @@ void PlaylistView::paintEvent(QPaintEvent *event) {
         if (background_image_.isNull()) {
           cached_scaled_background_image_ = QPixmap();
         }
-        else {
-          if (background_image_stretch_) {
-            if (background_image_keep_aspect_ratio_) {
-              if (background_image_do_not_cut_) {
-                cached_scaled_background_image_ = QPixmap::fromImage(background_image_.scaled(pb_width, pb_height, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-              }
-              else {
-                if (pb_height >= pb_width) {
-                  cached_scaled_background_image_ = QPixmap::fromImage(background_image_.scaledToHeight(pb_height, Qt::SmoothTransformation));
-                }
-                else {
-                  cached_scaled_background_image_ = QPixmap::fromImage(background_image_.scaledToWidth(pb_width, Qt::SmoothTransformation));
-                }
-              }
-            }
-            else {
-              cached_scaled_background_image_ = QPixmap::fromImage(background_image_.scaled(pb_width, pb_height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-            }
-          }
-          else {
-            int resize_width = qMin(qMin(background_image_.size().width(), pb_width), background_image_maxsize_);
-            int resize_height = qMin(qMin(background_image_.size().height(), pb_height), background_image_maxsize_);
-            cached_scaled_background_image_ = QPixmap::fromImage(background_image_.scaled(resize_width, resize_height, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-          }
+        // Rendering happens on a background thread, so serve the pixmap from the cache if we have it,
+        // otherwise kick off a render and keep showing the old pixmap until the result comes in.
+        else if (!ApplyCachedBackground(pb_width, pb_height)) {
+          StartBackgroundRender(pb_width, pb_height);
         }
 
         last_height_ = pb_height;
@@ -1295,6 +1284,9 @@ void PlaylistView::ReloadSettings() {
     blur_radius_ = blur_radius;
     opacity_level_ = opacity_level;
 
+    // The cached pixmaps baked the old blur radius, opacity and stretch options, drop them.
+    rendered_backgrounds_.clear();
+
     if (background_image_type_ == AppearanceSettingsPage::BackgroundImageType::Custom) {
       set_background_image(QImage(background_image_filename));
     }
@@ -1327,13 +1319,11 @@ void PlaylistView::SaveSettings() {
 
   if (!header_state_loaded_ || read_only_settings_) return;
 
-  QSettings s;
-  s.beginGroup(Playlist::kSettingsGroup);
-  s.setValue("state_version", header_state_version_);
-  s.setValue("state", header_->SaveState());
-  s.setValue("column_alignments", QVariant::fromValue<ColumnAlignmentMap>(column_alignment_));
-  s.setValue("rating_locked", rating_locked_);
-  s.endGroup();
+  // Queued instead of written directly - this is called on every column change, and a temporary QSettings would sync the file on the GUI thread each time.
+  SettingsWriter::QueueValue(Playlist::kSettingsGroup, "state_version", header_state_version_);
+  SettingsWriter::QueueValue(Playlist::kSettingsGroup, "state", header_->SaveState());
+  SettingsWriter::QueueValue(Playlist::kSettingsGroup, "column_alignments", QVariant::fromValue<ColumnAlignmentMap>(column_alignment_));
+  SettingsWriter::QueueValue(Playlist::kSettingsGroup, "rating_locked", rating_locked_);
 
 }
 
@@ -1503,37 +1493,160 @@ void PlaylistView::set_background_image(const QImage &image) {
   previous_background_image_x_ = current_background_image_x_;
   previous_background_image_y_ = current_background_image_y_;
 
-  if (image.isNull() || image.format() == QImage::Format_ARGB32) {
-    background_image_ = image;
-  }
-  else {
-    background_image_ = image.convertToFormat(QImage::Format_ARGB32);
-  }
+  background_image_ = image;
+  background_image_key_ = background_image_.isNull() ? 0 : background_image_.cacheKey();
 
-  if (!background_image_.isNull()) {
-    // Apply opacity filter
-    uchar *bits = background_image_.bits();
-    for (int i = 0; i < background_image_.height() * background_image_.bytesPerLine(); i += 4) {
-      bits[i + 3] = static_cast<uchar>((opacity_level_ / 100.0) * 255);
+  // The opacity filter, blur and scaling are applied on a background thread when the image is painted, see StartBackgroundRender.
+
+  if (isVisible()) {
+    if (background_image_.isNull()) {
+      // Nothing to render, start fading out the old image right away.
+      cached_scaled_background_image_ = QPixmap();
+      background_fade_pending_ = false;
+      previous_background_image_opacity_ = 1.0;
+      if (fade_animation_->state() == QTimeLine::Running) fade_animation_->stop();
+      fade_animation_->start();
+    }
+    else {
+      // Crossfade once the new image has been rendered.
+      background_fade_pending_ = true;
     }
+  }
 
-    if (blur_radius_ != 0) {
-      QImage blurred(background_image_.size(), QImage::Format_ARGB32_Premultiplied);
-      blurred.fill(Qt::transparent);
-      QPainter blur_painter(&blurred);
-      qt_blurImage(&blur_painter, background_image_, blur_radius_, true, false);
-      blur_painter.end();
+}
+
+bool PlaylistView::ApplyCachedBackground(const int width, const int height) {
 
-      background_image_ = blurred;
+  for (int i = 0; i < rendered_backgrounds_.count(); ++i) {
+    const RenderedBackground &rendered = rendered_backgrounds_[i];
+    if (rendered.source_key == background_image_key_ && rendered.width == width && rendered.height == height) {
+      rendered_backgrounds_.move(i, 0);
+      ApplyRenderedBackground(rendered_backgrounds_.first().pixmap);
+      return true;
     }
   }
 
-  if (isVisible()) {
+  return false;
+
+}
+
+void PlaylistView::StartBackgroundRender(const int width, const int height) {
+
+  // Only one render runs at a time. If the image or the size changes while one is in flight, paintEvent is asked to look again once it finishes.
+  if (background_render_in_progress_) {
+    background_render_queued_ = true;
+    return;
+  }
+  background_render_in_progress_ = true;
+
+  const qint64 source_key = background_image_key_;
+  const QImage image = background_image_;
+  const int blur_radius = blur_radius_;
+  const int opacity_level = opacity_level_;
+  const int maxsize = background_image_maxsize_;
+  const bool stretch = background_image_stretch_;
+  const bool keep_aspect_ratio = background_image_keep_aspect_ratio_;
+  const bool do_not_cut = background_image_do_not_cut_;
+
+  QFuture<QImage> future = QtConcurrent::run([image, width, height, blur_radius, opacity_level, maxsize, stretch, keep_aspect_ratio, do_not_cut]() {
+    return RenderBackgroundImage(image, width, height, blur_radius, opacity_level, maxsize, stretch, keep_aspect_ratio, do_not_cut);
+  });
+  QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+  QObject::connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, source_key, width, height]() {
+    const QPixmap pixmap = QPixmap::fromImage(watcher->result());
+    watcher->deleteLater();
+    background_render_in_progress_ = false;
+    InsertRenderedBackground(source_key, width, height, pixmap);
+    if (background_render_queued_ || source_key != background_image_key_) {
+      // The image or the size changed while we were rendering, have paintEvent look up the right pixmap again.
+      background_render_queued_ = false;
+      force_background_redraw_ = true;
+      update();
+    }
+    else if (width == last_width_ && height == last_height_) {
+      ApplyRenderedBackground(pixmap);
+    }
+  });
+  watcher->setFuture(future);
+
+}
+
+void PlaylistView::ApplyRenderedBackground(const QPixmap &pixmap) {
+
+  cached_scaled_background_image_ = pixmap;
+
+  if (background_fade_pending_) {
+    background_fade_pending_ = false;
     previous_background_image_opacity_ = 1.0;
     if (fade_animation_->state() == QTimeLine::Running) fade_animation_->stop();
     fade_animation_->start();
   }
 
+  update();
+
+}
+
+void PlaylistView::InsertRenderedBackground(const qint64 source_key, const int width, const int height, const QPixmap &pixmap) {
+
+  for (int i = 0; i < rendered_backgrounds_.count(); ++i) {
+    if (rendered_backgrounds_[i].source_key == source_key && rendered_backgrounds_[i].width == width && rendered_backgrounds_[i].height == height) {
+      rendered_backgrounds_.removeAt(i);
+      break;
+    }
+  }
+
+  RenderedBackground rendered;
+  rendered.source_key = source_key;
+  rendered.width = width;
+  rendered.height = height;
+  rendered.pixmap = pixmap;
+  rendered_backgrounds_.prepend(rendered);
+
+  while (rendered_backgrounds_.count() > kRenderedBackgroundCacheSize) {
+    rendered_backgrounds_.removeLast();
+  }
+
+}
+
+QImage PlaylistView::RenderBackgroundImage(QImage image, const int width, const int height, const int blur_radius, const int opacity_level, const int maxsize, const bool stretch, const bool keep_aspect_ratio, const bool do_not_cut) {
+
+  if (image.format() != QImage::Format_ARGB32) {
+    image = image.convertToFormat(QImage::Format_ARGB32);
+  }
+
+  // Apply opacity filter
+  uchar *bits = image.bits();
+  for (int i = 0; i < image.height() * image.bytesPerLine(); i += 4) {
+    bits[i + 3] = static_cast<uchar>((opacity_level / 100.0) * 255);
+  }
+
+  if (blur_radius != 0) {
+    QImage blurred(image.size(), QImage::Format_ARGB32_Premultiplied);
+    blurred.fill(Qt::transparent);
+    QPainter blur_painter(&blurred);
+    qt_blurImage(&blur_painter, image, blur_radius, true, false);
+    blur_painter.end();
+
+    image = blurred;
+  }
+
+  if (stretch) {
+    if (keep_aspect_ratio) {
+      if (do_not_cut) {
+        return image.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+      }
+      if (height >= width) {
+        return image.scaledToHeight(height, Qt::SmoothTransformation);
+      }
+      return image.scaledToWidth(width, Qt::SmoothTransformation);
+    }
+    return image.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+  }
+
+  const int resize_width = qMin(qMin(image.size().width(), width), maxsize);
+  const int resize_height = qMin(qMin(image.size().height(), height), maxsize);
+  return image.scaled(resize_width, resize_height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
 }
 
 void PlaylistView::FadePreviousBackgroundImage(const qreal value) {
@@ -206,6 +206,15 @@ class PlaylistView : public QTreeView {
   // Should be used instead of modifying background_image_ directly
   void set_background_image(const QImage &image);
 
+  // Looks up a rendered background for the current image at the given size and applies it. Returns false on a cache miss.
+  bool ApplyCachedBackground(const int width, const int height);
+  // Renders the current background image at the given size on a background thread and applies the result when it is ready.
+  void StartBackgroundRender(const int width, const int height);
+  void ApplyRenderedBackground(const QPixmap &pixmap);
+  void InsertRenderedBackground(const qint64 source_key, const int width, const int height, const QPixmap &pixmap);
+  // Applies the opacity filter, blur and scaling. Runs on a thread pool thread, so it must not touch the view.
+  static QImage RenderBackgroundImage(QImage image, const int width, const int height, const int blur_radius, const int opacity_level, const int maxsize, const bool stretch, const bool keep_aspect_ratio, const bool do_not_cut);
+
   void GlowIntensityChanged();
 
  private:
@@ -213,6 +222,7 @@ class PlaylistView : public QTreeView {
   static const int kAutoscrollGraceTimeout;
   static const int kDropIndicatorWidth;
   static const int kDropIndicatorGradientWidth;
+  static const int kRenderedBackgroundCacheSize;
 
   QList<int> GetEditableColumns();
   QModelIndex NextEditableIndex(const QModelIndex &current);
@@ -246,6 +256,20 @@ class PlaylistView : public QTreeView {
   QImage current_song_cover_art_;
   QPixmap cached_scaled_background_image_;
 
+  // Rendered backgrounds (opacity applied, blurred and scaled), keyed by source image and viewport size.
+  // Keeps the last few results so a resize or a switch back to a recent size doesn't have to render again.
+  struct RenderedBackground {
+    qint64 source_key;
+    int width;
+    int height;
+    QPixmap pixmap;
+  };
+  QList<RenderedBackground> rendered_backgrounds_;
+  qint64 background_image_key_;
+  bool background_render_in_progress_;
+  bool background_render_queued_;
+  bool background_fade_pending_;
+
   // For fading when image change
   QPixmap previous_background_image_;
   qreal previous_background_image_opacity_;
@@ -21,8 +21,11 @@
 
 #include "config.h"
 
+#include <vector>
+
 #include <QtConcurrent>
 #include <QtAlgorithms>
+#include <QAtomicInt>
 #include <QList>
 #include <QUrl>
 
@@ -166,27 +169,37 @@ void SongLoaderInserter::InsertSongs() {
 void SongLoaderInserter::AsyncLoad() {
 
   // First, quick load raw songs.
-  int async_progress = 0;
+  // Each pending loader is independent, so resolve them on the global thread pool and collect the results back in drop order afterwards.
   int async_load_id = task_manager_->StartTask(tr("Loading tracks"));
-  task_manager_->SetTaskProgress(async_load_id, async_progress, pending_.count());
-  bool first_loaded = false;
+  task_manager_->SetTaskProgress(async_load_id, 0, pending_.count());
+
+  QList<int> indices;
+  indices.reserve(pending_.count());
+  for (int i = 0; i < pending_.count(); ++i) indices << i;
+
+  std::vector<SongLoader::Result> results(static_cast<size_t>(pending_.count()), SongLoader::Result::Error);
+  QAtomicInt async_progress(0);
+  QtConcurrent::blockingMap(indices, [this, &results, &async_progress, async_load_id](const int i) {
+    results[static_cast<size_t>(i)] = pending_[i]->LoadFilenamesBlocking();
+    task_manager_->SetTaskProgress(async_load_id, async_progress.fetchAndAddRelaxed(1) + 1);
+  });
+
+  int first_loaded = -1;
   for (int i = 0; i < pending_.count(); ++i) {
     SongLoader *loader = pending_[i];
-    SongLoader::Result res = loader->LoadFilenamesBlocking();
-    task_manager_->SetTaskProgress(async_load_id, ++async_progress);
 
-    if (res == SongLoader::Result::Error) {
+    if (results[static_cast<size_t>(i)] == SongLoader::Result::Error) {
       for (const QString &error : loader->errors()) {
         emit Error(error);
       }
       continue;
     }
 
-    if (!first_loaded) {
+    if (first_loaded == -1) {
       // Load everything from the first song.
       // It'll start playing as soon as we emit PreloadFinished, so it needs to have the duration set to show properly in the UI.
       loader->LoadMetadataBlocking();
-      first_loaded = true;
+      first_loaded = i;
     }
 
     songs_ << loader->songs();
@@ -196,18 +209,20 @@ void SongLoaderInserter::AsyncLoad() {
   emit PreloadFinished();
 
   // Songs are inserted in playlist, now load them completely.
-  async_progress = 0;
   async_load_id = task_manager_->StartTask(tr("Loading tracks info"));
-  task_manager_->SetTaskProgress(async_load_id, async_progress, songs_.count());
-  SongList songs;
-  for (int i = 0; i < pending_.count(); ++i) {
-    SongLoader *loader = pending_[i];
-    if (i != 0) {
+  task_manager_->SetTaskProgress(async_load_id, 0, pending_.count());
+  QAtomicInt metadata_progress(0);
+  QtConcurrent::blockingMap(indices, [this, &metadata_progress, async_load_id, first_loaded](const int i) {
+    if (i != first_loaded) {
       // We already did this earlier for the first song.
-      loader->LoadMetadataBlocking();
+      pending_[i]->LoadMetadataBlocking();
     }
-    songs << loader->songs();
-    task_manager_->SetTaskProgress(async_load_id, songs.count());
+    task_manager_->SetTaskProgress(async_load_id, metadata_progress.fetchAndAddRelaxed(1) + 1);
+  });
+
+  SongList songs;
+  for (int i = 0; i < pending_.count(); ++i) {
+    songs << pending_[i]->songs();
   }
   task_manager_->SetTaskFinished(async_load_id);
 
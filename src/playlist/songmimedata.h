@@ -23,8 +23,17 @@
 
 #include "config.h"
 
+#include <functional>
+#include <utility>
+
+#include <QtGlobal>
 #include <QObject>
 #include <QMimeData>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QVariant>
 
 #include "core/mimedata.h"
 #include "core/song.h"
@@ -37,9 +46,65 @@ class SongMimeData : public MimeData {
  public:
   explicit SongMimeData(QObject* = nullptr) : MimeData(), backend(nullptr) {}
 
+  using SongResolver = std::function<SongList()>;
+
   CollectionBackendInterface *backend;
+
+  // Filled directly by senders that already have the songs in hand.
+  // Large drags set a resolver instead, so drag start doesn't have to collect thousands of songs up front.
   SongList songs;
+
+  // Sets a function that collects the dragged songs on first use.
+  // The resolver may also fill in name_for_new_playlist_ as a side effect.
+  void set_song_resolver(SongResolver resolver) { resolver_ = std::move(resolver); }
+
+  // Returns the dragged songs, resolving them on first use.
+  const SongList &resolved_songs() const {
+    if (resolver_) {
+      SongMimeData *self = const_cast<SongMimeData*>(this);
+      self->songs = resolver_();
+      self->resolver_ = nullptr;
+    }
+    return songs;
+  }
+
+  QString get_name_for_new_playlist() const override {
+    // Resolving may fill in name_for_new_playlist_.
+    if (resolver_) resolved_songs();
+    return MimeData::get_name_for_new_playlist();
+  }
+
+  // Lazy drags advertise the URL list without building it - it is only materialized when a target actually retrieves it.
+  QStringList formats() const override {
+    QStringList ret = QMimeData::formats();
+    if (resolver_ && !ret.contains("text/uri-list")) ret << "text/uri-list";
+    return ret;
+  }
+
+  bool hasFormat(const QString &mime_type) const override {
+    return (resolver_ && mime_type == "text/uri-list") || QMimeData::hasFormat(mime_type);
+  }
+
+ protected:
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  QVariant retrieveData(const QString &mime_type, QMetaType type) const override {
+#else
+  QVariant retrieveData(const QString &mime_type, QVariant::Type type) const override {
+#endif
+    if (resolver_ && mime_type == "text/uri-list") {
+      const SongList &song_list = resolved_songs();
+      QList<QUrl> urls;
+      urls.reserve(song_list.count());
+      for (const Song &song : song_list) {
+        urls << song.url();
+      }
+      const_cast<SongMimeData*>(this)->setUrls(urls);
+    }
+    return QMimeData::retrieveData(mime_type, type);
+  }
+
+ private:
+  SongResolver resolver_;
 };
 
 #endif  // SONGMIMEDATA_H
-
@@ -34,6 +34,7 @@ SongPlaylistItem::SongPlaylistItem(const Song &song) : PlaylistItem(song.source(
 
 bool SongPlaylistItem::InitFromQuery(const SqlRow &query) {
   song_.InitFromQuery(query, false);
+  InvalidateFilterTextCache();
   return true;
 }
 
@@ -23,7 +23,10 @@
 #include <QIODevice>
 #include <QByteArray>
 #include <QDir>
+#include <QHash>
 #include <QString>
+#include <QStringList>
+#include <QUrl>
 #include <QTextStream>
 
 #include "settings/playlistsettingspage.h"
@@ -49,8 +52,8 @@ SongList AsxIniParser::Load(QIODevice *device, const QString &playlist_path, con
 
   Q_UNUSED(playlist_path);
 
-  SongList ret;
-
+  // Collect the entries first so the collection lookups can be done for the whole playlist at once instead of one query per line.
+  QStringList entries;
   while (!device->atEnd()) {
     QString line = QString::fromUtf8(device->readLine()).trimmed();
     qint64 equals = line.indexOf('=');
@@ -58,10 +61,18 @@ SongList AsxIniParser::Load(QIODevice *device, const QString &playlist_path, con
     QString value = line.mid(equals + 1);
 
     if (key.startsWith("ref")) {
-      Song song = LoadSong(value, 0, dir, collection_search);
-      if (song.is_valid()) {
-        ret << song;
-      }
+      entries << value;
+    }
+  }
+
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(entries, dir) : QHash<QUrl, Song>();
+
+  SongList ret;
+  ret.reserve(entries.count());
+  for (const QString &entry : entries) {
+    Song song = LoadSong(entry, 0, dir, collection_search, nullptr, &collection_songs);
+    if (song.is_valid()) {
+      ret << song;
     }
   }
 
@@ -23,8 +23,11 @@
 #include <QIODevice>
 #include <QBuffer>
 #include <QDir>
+#include <QHash>
+#include <QList>
 #include <QByteArray>
 #include <QString>
+#include <QUrl>
 #include <QRegularExpression>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -68,23 +71,35 @@ SongList ASXParser::Load(QIODevice *device, const QString &playlist_path, const
     return SongList();
   }
 
-  SongList ret;
+  // Collect the entries first so the collection lookups can be done for the whole playlist at once instead of one query per entry.
+  QList<Entry> entries;
+  QStringList refs;
   while (!reader.atEnd() && Utilities::ParseUntilElementCI(&reader, "entry")) {
-    Song song = ParseTrack(&reader, dir, collection_search);
+    const Entry entry = ParseTrack(&reader);
+    entries << entry;
+    refs << entry.ref;
+  }
+
+  buffer.close();
+
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(refs, dir) : QHash<QUrl, Song>();
+
+  SongList ret;
+  ret.reserve(entries.count());
+  for (const Entry &entry : entries) {
+    Song song = LoadEntry(entry, dir, collection_search, collection_songs);
     if (song.is_valid()) {
       ret << song;
     }
   }
 
-  buffer.close();
-
   return ret;
 
 }
 
-Song ASXParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_search) const {
+ASXParser::Entry ASXParser::ParseTrack(QXmlStreamReader *reader) {
 
-  QString title, artist, album, ref;
+  Entry entry;
 
   while (!reader->atEnd()) {
     QXmlStreamReader::TokenType type = reader->readNext();
@@ -93,20 +108,20 @@ Song ASXParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool
       case QXmlStreamReader::StartElement: {
         QString name = reader->name().toString().toLower();
         if (name == "ref") {
-          ref = reader->attributes().value("href").toString();
+          entry.ref = reader->attributes().value("href").toString();
         }
         else if (name == "title") {
-          title = reader->readElementText();
+          entry.title = reader->readElementText();
         }
         else if (name == "author") {
-          artist = reader->readElementText();
+          entry.artist = reader->readElementText();
         }
         break;
       }
       case QXmlStreamReader::EndElement: {
         QString name = reader->name().toString().toLower();
         if (name == "entry") {
-          goto return_song;
+          return entry;
         }
         break;
       }
@@ -115,14 +130,19 @@ Song ASXParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool
     }
   }
 
-return_song:
-  Song song = LoadSong(ref, 0, dir, collection_search);
+  return entry;
+
+}
+
+Song ASXParser::LoadEntry(const Entry &entry, const QDir &dir, const bool collection_search, const QHash<QUrl, Song> &collection_songs) const {
+
+  Song song = LoadSong(entry.ref, 0, dir, collection_search, nullptr, &collection_songs);
 
   // Override metadata with what was in the playlist
   if (song.source() != Song::Source::Collection) {
-    if (!title.isEmpty()) song.set_title(title);
-    if (!artist.isEmpty()) song.set_artist(artist);
-    if (!album.isEmpty()) song.set_album(album);
+    if (!entry.title.isEmpty()) song.set_title(entry.title);
+    if (!entry.artist.isEmpty()) song.set_artist(entry.artist);
+    if (!entry.album.isEmpty()) song.set_album(entry.album);
   }
 
   return song;
@@ -23,8 +23,10 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QHash>
 #include <QString>
 #include <QStringList>
+#include <QUrl>
 #include <QDir>
 
 #include "config.h"
@@ -54,7 +56,16 @@ class ASXParser : public XMLParser {
   void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const override;
 
  private:
-  Song ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_search) const;
+  // Raw fields of one <entry> element, kept so the collection lookups can be batched for the whole playlist after parsing.
+  struct Entry {
+    QString ref;
+    QString title;
+    QString artist;
+    QString album;
+  };
+
+  static Entry ParseTrack(QXmlStreamReader *reader);
+  Song LoadEntry(const Entry &entry, const QDir &dir, const bool collection_search, const QHash<QUrl, Song> &collection_songs) const;
 };
 
 #endif
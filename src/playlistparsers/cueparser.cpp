@@ -25,6 +25,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QStringList>
@@ -233,11 +234,14 @@ SongList CueParser::Load(QIODevice *device, const QString &playlist_path, const
 
   QDateTime cue_mtime = QFileInfo(playlist_path).lastModified();
 
+  // All tracks of a FILE share the media file's tags, cache them so a cue sheet with hundreds of tracks in one file only reads it once.
+  QHash<QString, Song> tag_cache;
+
   // Finalize parsing songs
   for (int i = 0; i < entries.length(); i++) {
     CueEntry entry = entries.at(i);
 
-    Song song = LoadSong(entry.file, IndexToMarker(entry.index), dir, collection_search);
+    Song song = LoadSong(entry.file, IndexToMarker(entry.index), dir, collection_search, &tag_cache);
 
     // Cue song has mtime equal to qMax(media_file_mtime, cue_sheet_mtime)
     if (cue_mtime.isValid()) {
@@ -276,14 +280,17 @@ SongList CueParser::Load(QIODevice *device, const QString &playlist_path, const
 // line into logical parts and getting rid of all the unnecessary whitespaces and quoting.
 QStringList CueParser::SplitCueLine(const QString &line) {
 
-  QRegularExpression line_regexp(kFileLineRegExp);
+  static const QRegularExpression line_regexp(kFileLineRegExp);
+  static const QRegularExpression non_empty_regexp(".+");
+  static const QRegularExpression empty_quotes_regexp("^\"\"$");
+
   QRegularExpressionMatch re_match = line_regexp.match(line.trimmed());
   if (!re_match.hasMatch()) {
     return QStringList();
   }
 
   // Let's remove the empty entries while we're at it
-  return re_match.capturedTexts().filter(QRegularExpression(".+")).mid(1, -1).replaceInStrings(QRegularExpression("^\"\"$"), "");
+  return re_match.capturedTexts().filter(non_empty_regexp).mid(1, -1).replaceInStrings(empty_quotes_regexp, "");
 
 }
 
@@ -347,7 +354,7 @@ bool CueParser::UpdateLastSong(const CueEntry &entry, Song *song) {
 
 qint64 CueParser::IndexToMarker(const QString &index) {
 
-  QRegularExpression index_regexp(kIndexRegExp);
+  static const QRegularExpression index_regexp(kIndexRegExp);
   QRegularExpressionMatch re_match = index_regexp.match(index);
   if (!re_match.hasMatch()) {
     return -1;
@@ -23,8 +23,10 @@
 #include <QDir>
 #include <QBuffer>
 #include <QByteArray>
+#include <QHash>
 #include <QString>
 #include <QStringList>
+#include <QUrl>
 #include <QSettings>
 
 #include "core/logging.h"
@@ -59,7 +61,9 @@ SongList M3UParser::Load(QIODevice *device, const QString &playlist_path, const
     line = QString::fromUtf8(buffer.readLine()).trimmed();
   }
 
-  SongList ret;
+  // Collect the entries first so the collection lookups can be done for the whole playlist at once instead of one query per line.
+  QStringList entries;
+  QList<Metadata> metadata;
   forever {
     if (line.startsWith('#')) {
       // Extended info or comment.
@@ -70,17 +74,8 @@ SongList M3UParser::Load(QIODevice *device, const QString &playlist_path, const
       }
     }
     else if (!line.isEmpty()) {
-      Song song = LoadSong(line, 0, dir, collection_search);
-      if (!current_metadata.title.isEmpty()) {
-        song.set_title(current_metadata.title);
-      }
-      if (!current_metadata.artist.isEmpty()) {
-        song.set_artist(current_metadata.artist);
-      }
-      if (current_metadata.length > 0) {
-        song.set_length_nanosec(current_metadata.length);
-      }
-      ret << song;
+      entries << line;
+      metadata << current_metadata;
 
       current_metadata = Metadata();
     }
@@ -92,6 +87,24 @@ SongList M3UParser::Load(QIODevice *device, const QString &playlist_path, const
 
   buffer.close();
 
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(entries, dir) : QHash<QUrl, Song>();
+
+  SongList ret;
+  ret.reserve(entries.count());
+  for (int i = 0; i < entries.count(); ++i) {
+    Song song = LoadSong(entries[i], 0, dir, collection_search, nullptr, &collection_songs);
+    if (!metadata[i].title.isEmpty()) {
+      song.set_title(metadata[i].title);
+    }
+    if (!metadata[i].artist.isEmpty()) {
+      song.set_artist(metadata[i].artist);
+    }
+    if (metadata[i].length > 0) {
+      song.set_length_nanosec(metadata[i].length);
+    }
+    ret << song;
+  }
+
   return ret;
 
 }
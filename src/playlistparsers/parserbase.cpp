@@ -36,19 +36,47 @@
 ParserBase::ParserBase(CollectionBackendInterface *collection, QObject *parent)
     : QObject(parent), collection_(collection) {}
 
-void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, Song *song, const bool collection_search) const {
+QUrl ParserBase::LocalUrlForEntry(const QString &filename_or_url, const QDir &dir) {
+
+  QString filename = filename_or_url;
+
+  if (filename_or_url.contains(QRegularExpression("^[a-z]{2,}:", QRegularExpression::CaseInsensitiveOption))) {
+    const QUrl url(filename_or_url);
+    if (Song::SourceFromURL(url) != Song::Source::LocalFile) {
+      return QUrl();
+    }
+    filename = url.toLocalFile();
+  }
+
+  // Strawberry always wants / separators internally.
+  // Using QDir::fromNativeSeparators() only works on the same platform the playlist was created on/for, using replace() lets playlists work on any platform.
+  filename = filename.replace('\\', '/');
+
+  // Make the path absolute
+  if (!QDir::isAbsolutePath(filename)) {
+    filename = dir.absoluteFilePath(filename);
+  }
+
+  // Use the canonical path
+  if (QFile::exists(filename)) {
+    filename = QFileInfo(filename).canonicalFilePath();
+  }
+
+  return QUrl::fromLocalFile(filename);
+
+}
+
+void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, Song *song, const bool collection_search, QHash<QString, Song> *tag_cache, const QHash<QUrl, Song> *collection_songs) const {
 
   if (filename_or_url.isEmpty()) {
     return;
   }
 
-  QString filename = filename_or_url;
-
   if (filename_or_url.contains(QRegularExpression("^[a-z]{2,}:", QRegularExpression::CaseInsensitiveOption))) {
     QUrl url(filename_or_url);
     song->set_source(Song::SourceFromURL(url));
     if (song->source() == Song::Source::LocalFile) {
-      filename = url.toLocalFile();
+      // Handled below together with plain filenames.
     }
     else if (song->is_stream()) {
       song->set_url(QUrl::fromUserInput(filename_or_url));
@@ -62,45 +90,75 @@ void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning
     }
   }
 
-  // Strawberry always wants / separators internally.
-  // Using QDir::fromNativeSeparators() only works on the same platform the playlist was created on/for, using replace() lets playlists work on any platform.
-  filename = filename.replace('\\', '/');
-
-  // Make the path absolute
-  if (!QDir::isAbsolutePath(filename)) {
-    filename = dir.absoluteFilePath(filename);
-  }
-
-  // Use the canonical path
-  if (QFile::exists(filename)) {
-    filename = QFileInfo(filename).canonicalFilePath();
-  }
-
-  const QUrl url = QUrl::fromLocalFile(filename);
+  const QUrl url = LocalUrlForEntry(filename_or_url, dir);
+  const QString filename = url.toLocalFile();
 
   // Search in the collection
   if (collection_ && collection_search) {
-    Song collection_song = collection_->GetSongByUrl(url, beginning);
-    // If it was found in the collection then use it, otherwise load metadata from disk.
-    if (collection_song.is_valid()) {
-      *song = collection_song;
-      return;
+    if (collection_songs) {
+      // The parser already resolved this entry together with the rest of the playlist, a miss here means the song is not in the collection.
+      const Song collection_song = collection_songs->value(url);
+      if (collection_song.is_valid()) {
+        *song = collection_song;
+        return;
+      }
+    }
+    else {
+      Song collection_song = collection_->GetSongByUrl(url, beginning);
+      // If it was found in the collection then use it, otherwise load metadata from disk.
+      if (collection_song.is_valid()) {
+        *song = collection_song;
+        return;
+      }
     }
   }
 
+  if (tag_cache && tag_cache->contains(filename)) {
+    *song = tag_cache->value(filename);
+    return;
+  }
+
   TagReaderClient::Instance()->ReadFileBlocking(filename, song);
 
+  if (tag_cache) tag_cache->insert(filename, *song);
+
 }
 
-Song ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, const bool collection_search) const {
+Song ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, const bool collection_search, QHash<QString, Song> *tag_cache, const QHash<QUrl, Song> *collection_songs) const {
 
   Song song(Song::Source::LocalFile);
-  LoadSong(filename_or_url, beginning, dir, &song, collection_search);
+  LoadSong(filename_or_url, beginning, dir, &song, collection_search, tag_cache, collection_songs);
 
   return song;
 
 }
 
+QHash<QUrl, Song> ParserBase::CollectionSongsForEntries(const QStringList &filenames_or_urls, const QDir &dir) const {
+
+  QHash<QUrl, Song> ret;
+
+  if (!collection_) return ret;
+
+  QList<QUrl> urls;
+  urls.reserve(filenames_or_urls.count());
+  for (const QString &filename_or_url : filenames_or_urls) {
+    if (filename_or_url.isEmpty()) continue;
+    const QUrl url = LocalUrlForEntry(filename_or_url, dir);
+    if (!url.isEmpty()) urls << url;
+  }
+
+  const SongList songs = collection_->GetSongsByUrls(urls);
+  ret.reserve(songs.count());
+  for (const Song &song : songs) {
+    if (!ret.contains(song.url())) {
+      ret.insert(song.url(), song);
+    }
+  }
+
+  return ret;
+
+}
+
 QString ParserBase::URLOrFilename(const QUrl &url, const QDir &dir, const PlaylistSettingsPage::PathType path_type) {
 
   if (!url.isLocalFile()) return url.toString();
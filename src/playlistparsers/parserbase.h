@@ -26,6 +26,7 @@
 #include <QObject>
 #include <QDir>
 #include <QByteArray>
+#include <QHash>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -63,15 +64,24 @@ class ParserBase : public QObject {
   // Loads a song.  If filename_or_url is a URL (with a scheme other than "file") then it is set on the song and the song marked as a stream.
   // If it is a filename or a file:// URL then it is made absolute and canonical and set as a file:// url on the song.
   // Also sets the song's metadata by searching in the Collection, or loading from the file as a fallback.
+  // A parser that refers to the same media file many times (like a cue sheet) can pass a cache to avoid re-reading the file's tags for every entry; collection matches are per track and bypass the cache.
+  // A parser that loads many entries can pass the map from CollectionSongsForEntries() to replace the per-entry collection query with a lookup; a miss in the map then means the song is not in the collection.
   // This function should always be used when loading a playlist.
-  Song LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, const bool collection_search) const;
-  void LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, Song *song, const bool collection_search) const;
+  Song LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, const bool collection_search, QHash<QString, Song> *tag_cache = nullptr, const QHash<QUrl, Song> *collection_songs = nullptr) const;
+  void LoadSong(const QString &filename_or_url, const qint64 beginning, const QDir &dir, Song *song, const bool collection_search, QHash<QString, Song> *tag_cache = nullptr, const QHash<QUrl, Song> *collection_songs = nullptr) const;
+
+  // Resolves a whole list of playlist entries against the collection with chunked queries instead of one query per line.
+  // The returned map is keyed by the same canonical file:// URLs that LoadSong() searches for, entries that are streams or not in the collection are left out.
+  QHash<QUrl, Song> CollectionSongsForEntries(const QStringList &filenames_or_urls, const QDir &dir) const;
 
   // If the URL is a file:// URL then returns its path, absolute or relative to the directory depending on the path_type option.
   // Otherwise, returns the URL as is. This function should always be used when saving a playlist.
   static QString URLOrFilename(const QUrl &url, const QDir &dir, const PlaylistSettingsPage::PathType path_type);
 
  private:
+  // Makes the same URL out of a playlist entry that LoadSong() searches the collection for, or an empty URL for entries that are streams or unhandled schemes.
+  static QUrl LocalUrlForEntry(const QString &filename_or_url, const QDir &dir);
+
   CollectionBackendInterface *collection_;
 };
 
@@ -22,9 +22,12 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
+#include <QHash>
 #include <QMap>
 #include <QByteArray>
 #include <QString>
+#include <QStringList>
+#include <QUrl>
 #include <QRegularExpression>
 #include <QTextStream>
 
@@ -48,7 +51,9 @@ SongList PLSParser::Load(QIODevice *device, const QString &playlist_path, const
 
   Q_UNUSED(playlist_path);
 
+  // Collect the entries first so the collection lookups can be done for the whole playlist at once instead of one query per line.
   QMap<int, Song> songs;
+  QMap<int, QString> files;
   QRegularExpression n_re("\\d+$");
 
   while (!device->atEnd()) {
@@ -61,15 +66,7 @@ SongList PLSParser::Load(QIODevice *device, const QString &playlist_path, const
     int n = re_match.captured(0).toInt();
 
     if (key.startsWith("file")) {
-      Song song = LoadSong(value, 0, dir, collection_search);
-
-      // Use the title and length we've already loaded if any
-      if (!songs[n].title().isEmpty()) song.set_title(songs[n].title());
-      if (songs[n].length_nanosec() != -1) {
-        song.set_length_nanosec(songs[n].length_nanosec());
-      }
-
-      songs[n] = song;
+      files[n] = value;
     }
     else if (key.startsWith("title")) {
       songs[n].set_title(value);
@@ -82,6 +79,26 @@ SongList PLSParser::Load(QIODevice *device, const QString &playlist_path, const
     }
   }
 
+  QStringList entries;
+  entries.reserve(files.count());
+  for (QMap<int, QString>::const_iterator it = files.constBegin(); it != files.constEnd(); ++it) {
+    entries << it.value();
+  }
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(entries, dir) : QHash<QUrl, Song>();
+
+  for (QMap<int, QString>::const_iterator it = files.constBegin(); it != files.constEnd(); ++it) {
+    const int n = it.key();
+    Song song = LoadSong(it.value(), 0, dir, collection_search, nullptr, &collection_songs);
+
+    // Use the title and length from the playlist if any
+    if (!songs[n].title().isEmpty()) song.set_title(songs[n].title());
+    if (songs[n].length_nanosec() != -1) {
+      song.set_length_nanosec(songs[n].length_nanosec());
+    }
+
+    songs[n] = song;
+  }
+
   return songs.values();
 
 }
@@ -24,8 +24,11 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
+#include <QHash>
 #include <QByteArray>
 #include <QString>
+#include <QStringList>
+#include <QUrl>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
@@ -54,14 +57,26 @@ SongList WplParser::Load(QIODevice *device, const QString &playlist_path, const
     return ret;
   }
 
+  // Collect the entries first so the collection lookups can be done for the whole playlist at once instead of one query per entry.
+  QStringList srcs;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, "seq")) {
-    ParseSeq(dir, &reader, &ret, collection_search);
+    ParseSeq(&reader, &srcs);
+  }
+
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(srcs, dir) : QHash<QUrl, Song>();
+
+  ret.reserve(srcs.count());
+  for (const QString &src : srcs) {
+    Song song = LoadSong(src, 0, dir, collection_search, nullptr, &collection_songs);
+    if (song.is_valid()) {
+      ret << song;
+    }
   }
   return ret;
 
 }
 
-void WplParser::ParseSeq(const QDir &dir, QXmlStreamReader *reader, SongList *songs, const bool collection_search) const {
+void WplParser::ParseSeq(QXmlStreamReader *reader, QStringList *srcs) {
 
   while (!reader->atEnd()) {
     QXmlStreamReader::TokenType type = reader->readNext();
@@ -71,10 +86,7 @@ void WplParser::ParseSeq(const QDir &dir, QXmlStreamReader *reader, SongList *so
         if (name == "media") {
           QString src = reader->attributes().value("src").toString();
           if (!src.isEmpty()) {
-            Song song = LoadSong(src, 0, dir, collection_search);
-            if (song.is_valid()) {
-              songs->append(song);
-            }
+            srcs->append(src);
           }
         }
         else {
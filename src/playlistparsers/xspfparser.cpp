@@ -23,6 +23,8 @@
 #include <QIODevice>
 #include <QDir>
 #include <QByteArray>
+#include <QHash>
+#include <QList>
 #include <QString>
 #include <QUrl>
 #include <QSettings>
@@ -51,8 +53,20 @@ SongList XSPFParser::Load(QIODevice *device, const QString &playlist_path, const
     return ret;
   }
 
+  // Collect the tracks first so the collection lookups can be done for the whole playlist at once instead of one query per track.
+  QList<Track> tracks;
+  QStringList locations;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, "track")) {
-    Song song = ParseTrack(&reader, dir, collection_search);
+    const Track track = ParseTrack(&reader);
+    tracks << track;
+    locations << track.location;
+  }
+
+  const QHash<QUrl, Song> collection_songs = collection_search ? CollectionSongsForEntries(locations, dir) : QHash<QUrl, Song>();
+
+  ret.reserve(tracks.count());
+  for (const Track &track : tracks) {
+    Song song = LoadTrack(track, dir, collection_search, collection_songs);
     if (song.is_valid()) {
       ret << song;
     }
@@ -61,11 +75,9 @@ SongList XSPFParser::Load(QIODevice *device, const QString &playlist_path, const
 
 }
 
-Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_search) const {
+XSPFParser::Track XSPFParser::ParseTrack(QXmlStreamReader *reader) const {
 
-  QString title, artist, album, location, art;
-  qint64 nanosec = -1;
-  int track_num = -1;
+  Track track;
 
   while (!reader->atEnd()) {
     QXmlStreamReader::TokenType type = reader->readNext();
@@ -73,34 +85,34 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
     switch (type) {
       case QXmlStreamReader::StartElement: {
         if (name == "location") {
-          location = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
+          track.location = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
         }
         else if (name == "title") {
-          title = reader->readElementText();
+          track.title = reader->readElementText();
         }
         else if (name == "creator") {
-          artist = reader->readElementText();
+          track.artist = reader->readElementText();
         }
         else if (name == "album") {
-          album = reader->readElementText();
+          track.album = reader->readElementText();
         }
         else if (name == "image") {
-          art = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
+          track.art = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
         }
         else if (name == "duration") {  // in milliseconds.
           const QString duration = reader->readElementText();
           bool ok = false;
-          nanosec = duration.toInt(&ok) * kNsecPerMsec;
+          track.nanosec = duration.toInt(&ok) * kNsecPerMsec;
           if (!ok) {
-            nanosec = -1;
+            track.nanosec = -1;
           }
         }
         else if (name == "trackNum") {
           const QString track_num_str = reader->readElementText();
           bool ok = false;
-          track_num = track_num_str.toInt(&ok);
-          if (!ok || track_num < 1) {
-            track_num = -1;
+          track.track_num = track_num_str.toInt(&ok);
+          if (!ok || track.track_num < 1) {
+            track.track_num = -1;
           }
         }
         else if (name == "info") {
@@ -110,7 +122,7 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
       }
       case QXmlStreamReader::EndElement: {
         if (name == "track") {
-          goto return_song;
+          return track;
         }
       }
       default:
@@ -118,17 +130,22 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
     }
   }
 
-return_song:
-  Song song = LoadSong(location, 0, dir, collection_search);
+  return track;
+
+}
+
+Song XSPFParser::LoadTrack(const Track &track, const QDir &dir, const bool collection_search, const QHash<QUrl, Song> &collection_songs) const {
+
+  Song song = LoadSong(track.location, 0, dir, collection_search, nullptr, &collection_songs);
 
   // Override metadata with what was in the playlist
   if (song.source() != Song::Source::Collection) {
-    if (!title.isEmpty()) song.set_title(title);
-    if (!artist.isEmpty()) song.set_artist(artist);
-    if (!album.isEmpty()) song.set_album(album);
-    if (!art.isEmpty()) song.set_art_manual(QUrl(art));
-    if (nanosec > 0) song.set_length_nanosec(nanosec);
-    if (track_num > 0) song.set_track(track_num);
+    if (!track.title.isEmpty()) song.set_title(track.title);
+    if (!track.artist.isEmpty()) song.set_artist(track.artist);
+    if (!track.album.isEmpty()) song.set_album(track.album);
+    if (!track.art.isEmpty()) song.set_art_manual(QUrl(track.art));
+    if (track.nanosec > 0) song.set_length_nanosec(track.nanosec);
+    if (track.track_num > 0) song.set_track(track.track_num);
   }
 
   return song;
@@ -26,8 +26,10 @@
 #include <QObject>
 #include <QByteArray>
 #include <QDir>
+#include <QHash>
 #include <QString>
 #include <QStringList>
+#include <QUrl>
 
 #include "core/song.h"
 #include "settings/playlistsettingspage.h"
@@ -54,7 +56,20 @@ class XSPFParser : public XMLParser {
   void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const override;
 
  private:
-  Song ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_search) const;
+  // Raw fields of one <track> element, kept so the collection lookups can be batched for the whole playlist after parsing.
+  struct Track {
+    Track() : nanosec(-1), track_num(-1) {}
+    QString location;
+    QString title;
+    QString artist;
+    QString album;
+    QString art;
+    qint64 nanosec;
+    int track_num;
+  };
+
+  Track ParseTrack(QXmlStreamReader *reader) const;
+  Song LoadTrack(const Track &track, const QDir &dir, const bool collection_search, const QHash<QUrl, Song> &collection_songs) const;
 };
 
 #endif
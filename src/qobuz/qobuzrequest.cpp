@@ -64,6 +64,9 @@ QobuzRequest::QobuzRequest(QobuzService *service, QobuzUrlHandler *url_handler,
       query_type_(query_type),
       query_id_(-1),
       finished_(false),
+      artists_pages_prefetched_(false),
+      albums_pages_prefetched_(false),
+      songs_pages_prefetched_(false),
       artists_requests_total_(0),
       artists_requests_active_(0),
       artists_requests_received_(0),
@@ -418,6 +421,9 @@ void QobuzRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
     return;
   }
 
+  // Release the raw reply body, the parsed document is all that is needed from here on.
+  data.clear();
+
   if (!json_obj.contains("artists")) {
     ArtistsFinishCheck();
     Error("Json object is missing artists.", json_obj);
@@ -518,6 +524,15 @@ void QobuzRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
   artists_received_ += artists_received;
 
+  // The first page told us the page size and the total, so queue all remaining pages at once.
+  // The queue keeps at most kMaxConcurrentArtistsRequests in flight instead of chaining one page per reply.
+  if (query_type_ == QueryType::Artists && offset_requested == 0 && limit_requested == 0 && artists_received > 0 && !artists_pages_prefetched_) {
+    artists_pages_prefetched_ = true;
+    for (int offset_next = artists_received; offset_next < artists_total_; offset_next += artists_received) {
+      AddArtistsRequest(offset_next);
+    }
+  }
+
   if (offset_requested != 0) emit UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
 
   ArtistsFinishCheck(limit_requested, offset, artists_received);
@@ -528,7 +543,7 @@ void QobuzRequest::ArtistsFinishCheck(const int limit, const int offset, const i
 
   if (finished_) return;
 
-  if ((limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
+  if (!artists_pages_prefetched_ && (limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
     int offset_next = offset + artists_received;
     if (offset_next > 0 && offset_next < artists_total_) {
       if (query_type_ == QueryType::Artists) AddArtistsRequest(offset_next);
@@ -629,6 +644,8 @@ void QobuzRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
     return;
   }
 
+  data.clear();
+
   Artist artist = artist_requested;
 
   if (json_obj.contains("id") && json_obj.contains("name")) {
@@ -757,6 +774,14 @@ void QobuzRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
     emit UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
   }
 
+  // Queue all remaining favorite albums pages after the first page, same as for artists.
+  if (query_type_ == QueryType::Albums && artist_requested.artist_id.isEmpty() && offset_requested == 0 && limit_requested == 0 && albums_received > 0 && !albums_pages_prefetched_) {
+    albums_pages_prefetched_ = true;
+    for (int offset_next = albums_received; offset_next < albums_total; offset_next += albums_received) {
+      AddAlbumsRequest(offset_next);
+    }
+  }
+
   AlbumsFinishCheck(artist_requested, limit_requested, offset, albums_total, albums_received);
 
 }
@@ -770,7 +795,7 @@ void QobuzRequest::AlbumsFinishCheck(const Artist &artist, const int limit, cons
     if (offset_next > 0 && offset_next < albums_total) {
       switch (query_type_) {
         case QueryType::Albums:
-          AddAlbumsRequest(offset_next);
+          if (!albums_pages_prefetched_) AddAlbumsRequest(offset_next);
           break;
         case QueryType::SearchAlbums:
           AddAlbumsSearchRequest(offset_next);
@@ -886,6 +911,8 @@ void QobuzRequest::SongsReceived(QNetworkReply *reply, const Artist &artist_requ
     return;
   }
 
+  data.clear();
+
   if (!json_obj.contains("tracks")) {
     Error("Json object is missing tracks.", json_obj);
     SongsFinishCheck(artist_requested, album_requested, limit_requested, offset_requested);
@@ -1020,6 +1047,14 @@ void QobuzRequest::SongsReceived(QNetworkReply *reply, const Artist &artist_requ
     emit UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
   }
 
+  // Queue all remaining favorite tracks pages after the first page, same as for artists and albums.
+  if (query_type_ == QueryType::Songs && artist_requested.artist_id.isEmpty() && album_requested.album_id.isEmpty() && offset_requested == 0 && limit_requested == 0 && songs_received > 0 && !songs_pages_prefetched_) {
+    songs_pages_prefetched_ = true;
+    for (int offset_next = songs_received; offset_next < songs_total; offset_next += songs_received) {
+      AddSongsRequest(offset_next);
+    }
+  }
+
   SongsFinishCheck(album_artist, album, limit_requested, offset_requested, songs_total, songs_received);
 
 }
@@ -1033,7 +1068,7 @@ void QobuzRequest::SongsFinishCheck(const Artist &artist, const Album &album, co
     if (offset_next > 0 && offset_next < songs_total) {
       switch (query_type_) {
         case QueryType::Songs:
-          AddSongsRequest(offset_next);
+          if (!songs_pages_prefetched_) AddSongsRequest(offset_next);
           break;
         case QueryType::SearchSongs:
           AddSongsSearchRequest(offset_next);
@@ -190,6 +190,11 @@ class QobuzRequest : public QobuzBaseRequest {
 
   bool finished_;
 
+  // Set once the first page's reply has been used to queue all remaining pages up front.
+  bool artists_pages_prefetched_;
+  bool albums_pages_prefetched_;
+  bool songs_pages_prefetched_;
+
   QQueue<Request> artists_requests_queue_;
   QQueue<Request> albums_requests_queue_;
   QQueue<Request> songs_requests_queue_;
@@ -41,7 +41,7 @@
 
 const char *Queue::kRowsMimetype = "application/x-strawberry-queue-rows";
 
-Queue::Queue(Playlist *playlist, QObject *parent) : QAbstractProxyModel(parent), playlist_(playlist), total_length_ns_(0) {
+Queue::Queue(Playlist *playlist, QObject *parent) : QAbstractProxyModel(parent), playlist_(playlist), total_length_ns_(0), source_rows_dirty_(true) {
 
   signal_item_count_changed_ = QObject::connect(this, &Queue::ItemCountChanged, this, &Queue::UpdateTotalLength);
   QObject::connect(this, &Queue::TotalLengthChanged, this, &Queue::UpdateSummaryText);
@@ -50,26 +50,38 @@ Queue::Queue(Playlist *playlist, QObject *parent) : QAbstractProxyModel(parent),
 
 }
 
-QModelIndex Queue::mapFromSource(const QModelIndex &source_index) const {
+void Queue::EnsureSourceRowMapping() const {
 
-  if (!source_index.isValid()) return QModelIndex();
+  if (!source_rows_dirty_) return;
 
-  const int source_row = source_index.row();
+  source_rows_.clear();
+  source_rows_.reserve(static_cast<int>(source_indexes_.count()));
   for (int i = 0; i < source_indexes_.count(); ++i) {
-    if (source_indexes_[i].row() == source_row) {
-      return index(i, source_index.column());
-    }
+    if (source_indexes_[i].isValid()) source_rows_.insert(source_indexes_[i].row(), i);
   }
-  return QModelIndex();
+  source_rows_dirty_ = false;
+
+}
+
+void Queue::InvalidateSourceRowMapping() {
+  source_rows_dirty_ = true;
+}
+
+QModelIndex Queue::mapFromSource(const QModelIndex &source_index) const {
+
+  if (!source_index.isValid()) return QModelIndex();
+
+  EnsureSourceRowMapping();
+  const int proxy_row = source_rows_.value(source_index.row(), -1);
+  if (proxy_row == -1) return QModelIndex();
+  return index(proxy_row, source_index.column());
 
 }
 
 bool Queue::ContainsSourceRow(const int source_row) const {
 
-  for (int i = 0; i < source_indexes_.count(); ++i) {
-    if (source_indexes_[i].row() == source_row) return true;
-  }
-  return false;
+  EnsureSourceRowMapping();
+  return source_rows_.contains(source_row);
 
 }
 
@@ -87,6 +99,9 @@ void Queue::setSourceModel(QAbstractItemModel *source_model) {
     QObject::disconnect(sourceModel(), &QAbstractItemModel::dataChanged, this, &Queue::SourceDataChanged);
     QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &Queue::SourceLayoutChanged);
     QObject::disconnect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &Queue::SourceLayoutChanged);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &Queue::InvalidateSourceRowMapping);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::rowsMoved, this, &Queue::InvalidateSourceRowMapping);
+    QObject::disconnect(sourceModel(), &QAbstractItemModel::modelReset, this, &Queue::InvalidateSourceRowMapping);
   }
 
   QAbstractProxyModel::setSourceModel(source_model);
@@ -94,6 +109,12 @@ void Queue::setSourceModel(QAbstractItemModel *source_model) {
   QObject::connect(sourceModel(), &QAbstractItemModel::dataChanged, this, &Queue::SourceDataChanged);
   QObject::connect(sourceModel(), &QAbstractItemModel::rowsRemoved, this, &Queue::SourceLayoutChanged);
   QObject::connect(sourceModel(), &QAbstractItemModel::layoutChanged, this, &Queue::SourceLayoutChanged);
+  // These shift the rows of the persistent indexes without going through SourceLayoutChanged.
+  QObject::connect(sourceModel(), &QAbstractItemModel::rowsInserted, this, &Queue::InvalidateSourceRowMapping);
+  QObject::connect(sourceModel(), &QAbstractItemModel::rowsMoved, this, &Queue::InvalidateSourceRowMapping);
+  QObject::connect(sourceModel(), &QAbstractItemModel::modelReset, this, &Queue::InvalidateSourceRowMapping);
+
+  source_rows_dirty_ = true;
 
 }
 
@@ -111,6 +132,8 @@ void Queue::SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bo
 
 void Queue::SourceLayoutChanged() {
 
+  source_rows_dirty_ = true;
+
   QObject::disconnect(signal_item_count_changed_);
 
   for (int i = 0; i < source_indexes_.count(); ++i) {
@@ -185,6 +208,8 @@ void Queue::ToggleTracks(const QModelIndexList &source_indexes) {
       source_indexes_ << QPersistentModelIndex(source_index);
       endInsertRows();
     }
+    // Invalidated inside the loop because the next iteration's mapFromSource must see this change.
+    source_rows_dirty_ = true;
   }
 
 }
@@ -199,6 +224,7 @@ void Queue::InsertFirst(const QModelIndexList &source_indexes) {
       beginRemoveRows(QModelIndex(), row, row);
       source_indexes_.removeAt(row);
       endRemoveRows();
+      source_rows_dirty_ = true;
     }
   }
 
@@ -212,6 +238,8 @@ void Queue::InsertFirst(const QModelIndexList &source_indexes) {
   }
   endInsertRows();
 
+  source_rows_dirty_ = true;
+
 }
 
 int Queue::PositionOf(const QModelIndex &source_index) const {
@@ -267,6 +295,8 @@ void Queue::Clear() {
   source_indexes_.clear();
   endRemoveRows();
 
+  source_rows_dirty_ = true;
+
 }
 
 void Queue::Move(const QList<int> &proxy_rows, int pos) {
@@ -307,6 +337,8 @@ void Queue::Move(const QList<int> &proxy_rows, int pos) {
     }
   }
 
+  source_rows_dirty_ = true;
+
   emit layoutChanged();
 
 }
@@ -395,6 +427,7 @@ bool Queue::dropMimeData(const QMimeData *data, Qt::DropAction action, int row,
         source_indexes_.insert(insert_point + i, source_indexes[i]);
       }
       endInsertRows();
+      source_rows_dirty_ = true;
     }
   }
 
@@ -432,6 +465,8 @@ int Queue::TakeNext() {
   int ret = source_indexes_.takeFirst().row();
   endRemoveRows();
 
+  source_rows_dirty_ = true;
+
   return ret;
 
 }
@@ -461,6 +496,8 @@ void Queue::Remove(QList<int> &proxy_rows) {
     removed_rows++;
   }
 
+  source_rows_dirty_ = true;
+
   emit layoutChanged();
 
 }
@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QAbstractItemModel>
 #include <QAbstractProxyModel>
+#include <QHash>
 #include <QList>
 #include <QVariant>
 #include <QString>
@@ -90,14 +91,23 @@ class Queue : public QAbstractProxyModel {
  private slots:
   void SourceDataChanged(const QModelIndex &top_left, const QModelIndex &bottom_right);
   void SourceLayoutChanged();
+  void InvalidateSourceRowMapping();
   void UpdateTotalLength();
 
+ private:
+  void EnsureSourceRowMapping() const;
+
  private:
   QList<QPersistentModelIndex> source_indexes_;
   const Playlist *playlist_;
   quint64 total_length_ns_;
   QMetaObject::Connection signal_item_count_changed_;
 
+  // Playlist row -> queue position, so lookups don't scan the whole queue.
+  // Rebuilt lazily after playlist edits shift the rows of the persistent indexes, or after the queue itself changes.
+  mutable QHash<int, int> source_rows_;
+  mutable bool source_rows_dirty_;
+
 };
 
 #endif  // QUEUE_H
@@ -83,6 +83,41 @@ void RadioBackend::AddChannels(const RadioChannelList &channels) {
 
 }
 
+void RadioBackend::ReplaceChannelsAsync(const Song::Source source, const RadioChannelList &channels) {
+  QMetaObject::invokeMethod(this, "ReplaceChannels", Qt::QueuedConnection, Q_ARG(Song::Source, source), Q_ARG(RadioChannelList, channels));
+}
+
+void RadioBackend::ReplaceChannels(const Song::Source source, const RadioChannelList &channels) {
+
+  QMutexLocker l(db_->Mutex());
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery delete_query(db);
+  delete_query.prepare(QString("DELETE FROM radio_channels WHERE source = :source"));
+  delete_query.BindValue(":source", static_cast<int>(source));
+  if (!delete_query.Exec()) {
+    db_->ReportErrors(delete_query);
+    return;
+  }
+
+  SqlQuery q(db);
+  q.prepare(QString("INSERT INTO radio_channels (source, name, url, thumbnail_url) VALUES (:source, :name, :url, :thumbnail_url)"));
+
+  for (const RadioChannel &channel : channels) {
+    q.BindValue(":source", static_cast<int>(channel.source));
+    q.BindValue(":name", channel.name);
+    q.BindValue(":url", channel.url);
+    q.BindValue(":thumbnail_url", channel.thumbnail_url);
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return;
+    }
+  }
+
+  // No NewChannels here - the model is updated with the diff by RadioServices, this only keeps the stored copy in sync.
+
+}
+
 void RadioBackend::GetChannelsAsync() {
 
   QMetaObject::invokeMethod(this, "GetChannels", Qt::QueuedConnection);
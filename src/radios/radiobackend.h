@@ -37,11 +37,13 @@ class RadioBackend : public QObject {
   void ExitAsync();
 
   void AddChannelsAsync(const RadioChannelList &channels);
+  void ReplaceChannelsAsync(const Song::Source source, const RadioChannelList &channels);
   void GetChannelsAsync();
   void DeleteChannelsAsync();
 
  private slots:
   void AddChannels(const RadioChannelList &channels);
+  void ReplaceChannels(const Song::Source source, const RadioChannelList &channels);
   void GetChannels();
   void DeleteChannels();
 
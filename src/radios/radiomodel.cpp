@@ -25,10 +25,10 @@
 #include <QUrl>
 #include <QMimeData>
 #include <QPixmap>
-#include <QPixmapCache>
 #include <QRegularExpression>
 
 #include "core/application.h"
+#include "core/pixmapbudget.h"
 #include "core/simpletreemodel.h"
 #include "playlist/playlistmanager.h"
 #include "covermanager/albumcoverloader.h"
@@ -41,6 +41,10 @@
 
 const int RadioModel::kTreeIconSize = 22;
 
+namespace {
+constexpr char kPixmapBudgetConsumer[] = "radios";
+}
+
 RadioModel::RadioModel(Application *app, QObject *parent)
     : SimpleTreeModel<RadioItem>(new RadioItem(this), parent),
       app_(app) {
@@ -196,6 +200,45 @@ void RadioModel::AddChannels(const RadioChannelList &channels) {
 
 }
 
+bool RadioModel::ChannelMatchesItem(const RadioChannel &channel, const RadioItem *item) {
+  return channel.source == item->channel.source && channel.name == item->channel.name && channel.url == item->channel.url && channel.thumbnail_url == item->channel.thumbnail_url;
+}
+
+void RadioModel::ReplaceChannels(const Song::Source source, const RadioChannelList &channels) {
+
+  if (!container_nodes_.contains(source)) {
+    AddChannels(channels);
+    return;
+  }
+
+  RadioItem *container = container_nodes_[source];
+
+  // Remove the channels that are gone and keep the rest, so unchanged rows survive a refresh with their cached icons.
+  for (int i = static_cast<int>(container->children.count()) - 1; i >= 0; --i) {
+    RadioItem *item = container->children[i];
+    const bool still_present = std::any_of(channels.begin(), channels.end(), [item](const RadioChannel &channel) { return ChannelMatchesItem(channel, item); });
+    if (still_present) continue;
+    items_.removeAll(item);
+    QList<quint64> stale_ids;
+    for (QMap<quint64, ItemAndCacheKey>::const_iterator it = pending_art_.constBegin(); it != pending_art_.constEnd(); ++it) {
+      if (it.value().first == item) stale_ids << it.key();
+    }
+    for (const quint64 stale_id : stale_ids) {
+      pending_cache_keys_.remove(pending_art_.take(stale_id).second);
+    }
+    container->DeleteNotify(i);
+  }
+
+  RadioChannelList channels_to_add;
+  for (const RadioChannel &channel : channels) {
+    const bool already_present = std::any_of(container->children.begin(), container->children.end(), [&channel](const RadioItem *item) { return ChannelMatchesItem(channel, item); });
+    if (!already_present) channels_to_add << channel;
+  }
+
+  AddChannels(channels_to_add);
+
+}
+
 bool RadioModel::IsPlayable(const QModelIndex &idx) const {
 
   return idx.data(Role_Type) == RadioItem::Type_Channel;
@@ -286,7 +329,7 @@ QPixmap RadioModel::ChannelIcon(const QModelIndex &idx) {
   const QString cache_key = ChannelIconPixmapCacheKey(idx);
 
   QPixmap cached_pixmap;
-  if (QPixmapCache::find(cache_key, &cached_pixmap)) {
+  if (PixmapBudget::Find(kPixmapBudgetConsumer, cache_key, &cached_pixmap)) {
     return cached_pixmap;
   }
 
@@ -320,10 +363,10 @@ void RadioModel::AlbumCoverLoaded(const quint64 id, AlbumCoverLoaderResultPtr re
   pending_cache_keys_.remove(cache_key);
 
   if (!result || !result->success || result->image_scaled.isNull() || result->type == AlbumCoverLoaderResult::Type::ManuallyUnset) {
-    QPixmapCache::insert(cache_key, ServiceIcon(item));
+    PixmapBudget::Insert(kPixmapBudgetConsumer, cache_key, ServiceIcon(item));
   }
   else {
-    QPixmapCache::insert(cache_key, QPixmap::fromImage(result->image_scaled));
+    PixmapBudget::Insert(kPixmapBudgetConsumer, cache_key, QPixmap::fromImage(result->image_scaled));
   }
 
   const QModelIndex idx = ItemToIndex(item);
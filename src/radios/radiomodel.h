@@ -70,8 +70,10 @@ class RadioModel : public SimpleTreeModel<RadioItem> {
 
   void Reset();
   void AddChannels(const RadioChannelList &channels);
+  void ReplaceChannels(const Song::Source source, const RadioChannelList &channels);
 
  private:
+  static bool ChannelMatchesItem(const RadioChannel &channel, const RadioItem *item);
   bool IsPlayable(const QModelIndex &idx) const;
   bool CompareItems(const RadioItem *a, const RadioItem *b) const;
   void GetChildSongs(RadioItem *item, QList<QUrl> *urls, SongList *songs) const;
@@ -30,7 +30,9 @@ RadioParadiseService::RadioParadiseService(Application *app, NetworkAccessManage
 QUrl RadioParadiseService::Homepage() { return QUrl("https://radioparadise.com/"); }
 QUrl RadioParadiseService::Donate() { return QUrl("https://payments.radioparadise.com/rp2s-content.php?name=Support&file=support"); }
 
-void RadioParadiseService::GetChannels() {
+void RadioParadiseService::GetChannels(const bool force) {
+
+  Q_UNUSED(force)
 
   emit NewChannels(RadioChannelList()
     << RadioChannel(source_, "Main Mix 320k AAC", QUrl("https://stream.radioparadise.com/aac-320"))
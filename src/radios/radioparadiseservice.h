@@ -38,7 +38,7 @@ class RadioParadiseService : public RadioService {
   QUrl Donate() override;
 
  public slots:
-  void GetChannels() override;
+  void GetChannels(const bool force = false) override;
 
 };
 
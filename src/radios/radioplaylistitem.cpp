@@ -40,6 +40,7 @@ bool RadioPlaylistItem::InitFromQuery(const SqlRow &query) {
 
   metadata_.InitFromQuery(query, false);
   InitMetadata();
+  InvalidateFilterTextCache();
   return true;
 
 }
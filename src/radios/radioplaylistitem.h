@@ -42,7 +42,10 @@ class RadioPlaylistItem : public PlaylistItem {
   Song OriginalMetadata() const override { return metadata_; }
   QUrl Url() const override;
 
-  void SetMetadata(const Song &metadata) override { metadata_ = metadata; }
+  void SetMetadata(const Song &metadata) override {
+    metadata_ = metadata;
+    InvalidateFilterTextCache();
+  }
   void SetArtManual(const QUrl &cover_url) override;
 
  protected:
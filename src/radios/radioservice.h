@@ -55,7 +55,8 @@ class RadioService : public QObject {
   void NewChannels(const RadioChannelList &channels = RadioChannelList());
 
  public slots:
-  virtual void GetChannels() = 0;
+  // force skips cache validators and always downloads a fresh channel list.
+  virtual void GetChannels(const bool force = false) = 0;
 
  protected:
   QByteArray ExtractData(QNetworkReply *reply);
@@ -113,13 +113,18 @@ void RadioServices::GetChannels() {
 
 void RadioServices::RefreshChannels() {
 
+  // The current channels stay visible while the services revalidate, so an unchanged or failed fetch causes no flicker.
+  RequestChannelsFromServices(false);
+
+}
+
+void RadioServices::RequestChannelsFromServices(const bool force) {
+
   channels_refresh_ = true;
-  model_->Reset();
-  backend_->DeleteChannelsAsync();
 
   QList<RadioService*> services = services_.values();
   for (RadioService *service : services) {
-    service->GetChannels();
+    service->GetChannels(force);
   }
 
 }
@@ -128,7 +133,8 @@ void RadioServices::GotChannelsFromBackend(const RadioChannelList &channels) {
 
   if (channels.isEmpty()) {
     if (!channels_refresh_) {
-      RefreshChannels();
+      // Forced, because with nothing stored to fall back on a 304 would leave the list empty.
+      RequestChannelsFromServices(true);
     }
   }
   else {
@@ -142,6 +148,10 @@ void RadioServices::GotChannelsFromService(const RadioChannelList &channels) {
   RadioService *service = qobject_cast<RadioService*>(sender());
   if (!service) return;
 
-  backend_->AddChannelsAsync(channels);
+  // An empty list means the fetch failed or returned nothing useful - keep whatever is currently shown.
+  if (channels.isEmpty()) return;
+
+  backend_->ReplaceChannelsAsync(service->source(), channels);
+  model_->ReplaceChannels(service->source(), channels);
 
 }
@@ -65,6 +65,9 @@ class RadioServices : public QObject {
   void GetChannels();
   void RefreshChannels();
 
+ private:
+  void RequestChannelsFromServices(const bool force);
+
  private:
   NetworkAccessManager *network_;
   RadioBackend *backend_;
@@ -20,6 +20,7 @@
 #include <QObject>
 #include <QString>
 #include <QUrl>
+#include <QSettings>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QJsonValue>
@@ -34,6 +35,7 @@
 #include "somafmservice.h"
 #include "radiochannel.h"
 
+const char *SomaFMService::kSettingsGroup = "SomaFM";
 const char *SomaFMService::kApiChannelsUrl = "https://somafm.com/channels.json";
 
 SomaFMService::SomaFMService(Application *app, NetworkAccessManager *network, QObject *parent)
@@ -59,12 +61,25 @@ void SomaFMService::Abort() {
 
 }
 
-void SomaFMService::GetChannels() {
+void SomaFMService::GetChannels(const bool force) {
 
   Abort();
 
   QUrl url(kApiChannelsUrl);
   QNetworkRequest req(url);
+
+  // Revalidate the stored channel list instead of re-downloading it:
+  // a 304 costs one round trip and skips re-resolving the stream URL for every channel.
+  if (!force) {
+    QSettings s;
+    s.beginGroup(kSettingsGroup);
+    const QByteArray etag = s.value("channels_etag").toByteArray();
+    const QByteArray last_modified = s.value("channels_last_modified").toByteArray();
+    s.endGroup();
+    if (!etag.isEmpty()) req.setRawHeader("If-None-Match", etag);
+    if (!last_modified.isEmpty()) req.setRawHeader("If-Modified-Since", last_modified);
+  }
+
   QNetworkReply *reply = network_->get(req);
   replies_ << reply;
   const int task_id = app_->task_manager()->StartTask(tr("Getting %1 channels").arg(name_));
@@ -77,6 +92,12 @@ void SomaFMService::GetChannelsReply(QNetworkReply *reply, const int task_id) {
   if (replies_.contains(reply)) replies_.removeAll(reply);
   reply->deleteLater();
 
+  if (reply->error() == QNetworkReply::NoError && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+    // Not modified - the channels loaded from the backend are still current.
+    app_->task_manager()->SetTaskFinished(task_id);
+    return;
+  }
+
   QJsonObject object = ExtractJsonObj(reply);
   if (object.isEmpty()) {
     app_->task_manager()->SetTaskFinished(task_id);
@@ -127,6 +148,12 @@ void SomaFMService::GetChannelsReply(QNetworkReply *reply, const int task_id) {
     emit NewChannels();
   }
   else {
+    // Only a list that parsed into channels is worth revalidating against later.
+    QSettings s;
+    s.beginGroup(kSettingsGroup);
+    s.setValue("channels_etag", reply->rawHeader("ETag"));
+    s.setValue("channels_last_modified", reply->rawHeader("Last-Modified"));
+    s.endGroup();
     for (const RadioChannel &channel : channels) {
       GetStreamUrl(task_id, channel);
     }
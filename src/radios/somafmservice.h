@@ -43,7 +43,7 @@ class SomaFMService : public RadioService {
   void Abort();
 
  public slots:
-  void GetChannels() override;
+  void GetChannels(const bool force = false) override;
 
  private:
   void GetStreamUrl(const int task_id, const RadioChannel &channel);
@@ -53,6 +53,7 @@ class SomaFMService : public RadioService {
   void GetStreamUrlsReply(QNetworkReply *reply, const int task_id, RadioChannel channel);
 
  private:
+  static const char *kSettingsGroup;
   static const char *kApiChannelsUrl;
   QList<QNetworkReply*> replies_;
   RadioChannelList channels_;
@@ -47,6 +47,8 @@
 #include "lastfmscrobbler.h"
 
 const int LastFMImport::kRequestsDelay = 2000;
+const int LastFMImport::kMaxConcurrentRequests = 4;
+const int LastFMImport::kMaxRetries = 3;
 
 LastFMImport::LastFMImport(NetworkAccessManager *network, QObject *parent)
     : QObject(parent),
@@ -225,23 +227,28 @@ void LastFMImport::ImportData(const bool lastplayed, const bool playcount) {
 
 void LastFMImport::FlushRequests() {
 
-  if (!recent_tracks_requests_.isEmpty()) {
-    SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
-    return;
+  // Refill the request window each tick, so up to kMaxConcurrentRequests pages are in flight instead of one request per tick.
+  while (replies_.count() < kMaxConcurrentRequests) {
+    if (!recent_tracks_requests_.isEmpty()) {
+      SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
+      continue;
+    }
+    if (!top_tracks_requests_.isEmpty()) {
+      SendGetTopTracksRequest(top_tracks_requests_.dequeue());
+      continue;
+    }
+    break;
   }
 
-  if (!top_tracks_requests_.isEmpty()) {
-    SendGetTopTracksRequest(top_tracks_requests_.dequeue());
-    return;
+  if (recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) {
+    timer_flush_requests_->stop();
   }
 
-  timer_flush_requests_->stop();
-
 }
 
-void LastFMImport::AddGetRecentTracksRequest(const int page) {
+void LastFMImport::AddGetRecentTracksRequest(const int page, const int retries) {
 
-  recent_tracks_requests_.enqueue(GetRecentTracksRequest(page));
+  recent_tracks_requests_.enqueue(GetRecentTracksRequest(page, retries));
 
   if (!timer_flush_requests_->isActive()) {
     timer_flush_requests_->start();
@@ -263,17 +270,24 @@ void LastFMImport::SendGetRecentTracksRequest(GetRecentTracksRequest request) {
   }
 
   QNetworkReply *reply = CreateRequest(params);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { GetRecentTracksRequestFinished(reply, request.page); });
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { GetRecentTracksRequestFinished(reply, request.page, request.retries); });
 
 }
 
-void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const int page) {
+void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const int page, const int retries) {
 
   if (!replies_.contains(reply)) return;
   replies_.removeAll(reply);
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
+  // Requeue the page on transient network or server errors instead of aborting the whole import.
+  if (reply->error() != QNetworkReply::NoError && retries < kMaxRetries) {
+    qLog(Error) << "Retrying last.fm recent tracks page" << page << "after error:" << reply->errorString();
+    AddGetRecentTracksRequest(page, retries + 1);
+    return;
+  }
+
   QByteArray data = GetReplyData(reply);
   if (data.isEmpty()) {
     return;
@@ -350,6 +364,8 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
 
     QJsonArray array_track = json_obj["track"].toArray();
 
+    CollectionBackend::LastPlayedUpdateList lastplayed_updates;
+
     for (const QJsonValueRef value_track : array_track) {
 
       ++lastplayed_received_;
@@ -383,13 +399,23 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
       QString title = obj_track["name"].toString();
       QDateTime datetime = QDateTime::fromString(date, "dd MMM yyyy, hh:mm");
       if (datetime.isValid()) {
-        emit UpdateLastPlayed(artist, album, title, datetime.toSecsSinceEpoch());
+        CollectionBackend::LastPlayedUpdate update;
+        update.artist = artist;
+        update.album = album;
+        update.title = title;
+        update.lastplayed = datetime.toSecsSinceEpoch();
+        lastplayed_updates << update;
       }
 
       UpdateProgressCheck();
 
     }
 
+    // One batched write per page, so the collection backend does one transaction instead of one per track.
+    if (!lastplayed_updates.isEmpty()) {
+      emit UpdateLastPlayed(lastplayed_updates);
+    }
+
     if (page == 1) {
       for (int i = 2; i <= pages; ++i) {
         AddGetRecentTracksRequest(i);
@@ -402,9 +428,9 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
 
 }
 
-void LastFMImport::AddGetTopTracksRequest(const int page) {
+void LastFMImport::AddGetTopTracksRequest(const int page, const int retries) {
 
-  top_tracks_requests_.enqueue(GetTopTracksRequest(page));
+  top_tracks_requests_.enqueue(GetTopTracksRequest(page, retries));
 
   if (!timer_flush_requests_->isActive()) {
     timer_flush_requests_->start();
@@ -426,17 +452,23 @@ void LastFMImport::SendGetTopTracksRequest(GetTopTracksRequest request) {
   }
 
   QNetworkReply *reply = CreateRequest(params);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { GetTopTracksRequestFinished(reply, request.page); });
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, request]() { GetTopTracksRequestFinished(reply, request.page, request.retries); });
 
 }
 
-void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int page) {
+void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int page, const int retries) {
 
   if (!replies_.contains(reply)) return;
   replies_.removeAll(reply);
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
+  if (reply->error() != QNetworkReply::NoError && retries < kMaxRetries) {
+    qLog(Error) << "Retrying last.fm top tracks page" << page << "after error:" << reply->errorString();
+    AddGetTopTracksRequest(page, retries + 1);
+    return;
+  }
+
   QByteArray data = GetReplyData(reply);
   if (data.isEmpty()) {
     return;
@@ -31,6 +31,8 @@
 #include <QQueue>
 #include <QDateTime>
 
+#include "collection/collectionbackend.h"
+
 class QTimer;
 class QNetworkReply;
 
@@ -52,12 +54,14 @@ class LastFMImport : public QObject {
   using ParamList = QList<Param>;
 
   struct GetRecentTracksRequest {
-    explicit GetRecentTracksRequest(const int _page) : page(_page) {}
+    explicit GetRecentTracksRequest(const int _page, const int _retries = 0) : page(_page), retries(_retries) {}
     int page;
+    int retries;
   };
   struct GetTopTracksRequest {
-    explicit GetTopTracksRequest(const int _page) : page(_page) {}
+    explicit GetTopTracksRequest(const int _page, const int _retries = 0) : page(_page), retries(_retries) {}
     int page;
+    int retries;
   };
 
  private:
@@ -65,8 +69,8 @@ class LastFMImport : public QObject {
   QByteArray GetReplyData(QNetworkReply *reply);
   QJsonObject ExtractJsonObj(const QByteArray &data);
 
-  void AddGetRecentTracksRequest(const int page = 0);
-  void AddGetTopTracksRequest(const int page = 0);
+  void AddGetRecentTracksRequest(const int page = 0, const int retries = 0);
+  void AddGetTopTracksRequest(const int page = 0, const int retries = 0);
 
   void SendGetRecentTracksRequest(GetRecentTracksRequest request);
   void SendGetTopTracksRequest(GetTopTracksRequest request);
@@ -80,7 +84,7 @@ class LastFMImport : public QObject {
 
  signals:
   void UpdatePlayCount(const QString&, const QString&, const int, const bool = false);
-  void UpdateLastPlayed(const QString&, const QString&, const QString&, const qint64);
+  void UpdateLastPlayed(const CollectionBackend::LastPlayedUpdateList &updates);
   void UpdateTotal(const int, const int);
   void UpdateProgress(const int, const int);
   void Finished();
@@ -88,11 +92,13 @@ class LastFMImport : public QObject {
 
  private slots:
   void FlushRequests();
-  void GetRecentTracksRequestFinished(QNetworkReply *reply, const int page);
-  void GetTopTracksRequestFinished(QNetworkReply *reply, const int page);
+  void GetRecentTracksRequestFinished(QNetworkReply *reply, const int page, const int retries);
+  void GetTopTracksRequestFinished(QNetworkReply *reply, const int page, const int retries);
 
  private:
   static const int kRequestsDelay;
+  static const int kMaxConcurrentRequests;
+  static const int kMaxRetries;
 
   NetworkAccessManager *network_;
   QTimer *timer_flush_requests_;
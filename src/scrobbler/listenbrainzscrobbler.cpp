@@ -63,7 +63,10 @@ const char *ListenBrainzScrobbler::kApiUrl = "https://api.listenbrainz.org";
 const char *ListenBrainzScrobbler::kClientIDB64 = "b2VBVU53cVNRZXIwZXIwOUZpcWkwUQ==";
 const char *ListenBrainzScrobbler::kClientSecretB64 = "Uk9GZ2hrZVEzRjNvUHlFaHFpeVdQQQ==";
 const char *ListenBrainzScrobbler::kCacheFile = "listenbrainzscrobbler.cache";
-const int ListenBrainzScrobbler::kScrobblesPerRequest = 10;
+// The API accepts a maximum of 1000 listens for each submit-listens request, so a long offline backlog drains in as few requests as possible.
+const int ListenBrainzScrobbler::kScrobblesPerRequest = 1000;
+const int ListenBrainzScrobbler::kSubmitErrorDelay = 30;
+const int ListenBrainzScrobbler::kSubmitErrorDelayMax = 1920;
 
 ListenBrainzScrobbler::ListenBrainzScrobbler(AudioScrobbler *scrobbler, NetworkAccessManager *network, QObject *parent)
     : ScrobblerService(kName, parent),
@@ -78,6 +81,7 @@ ListenBrainzScrobbler::ListenBrainzScrobbler(AudioScrobbler *scrobbler, NetworkA
       scrobbled_(false),
       timestamp_(0),
       submit_error_(false),
+      submit_error_delay_(kSubmitErrorDelay),
       prefer_albumartist_(false) {
 
   refresh_login_timer_.setSingleShot(true);
@@ -526,9 +530,13 @@ void ListenBrainzScrobbler::StartSubmit(const bool initial) {
       Submit();
     }
     else if (!timer_submit_.isActive()) {
-      int submit_delay = static_cast<int>(std::max(scrobbler_->SubmitDelay(), submit_error_ ? 30 : 5) * kMsecPerSec);
+      int submit_delay = static_cast<int>(std::max(scrobbler_->SubmitDelay(), submit_error_ ? submit_error_delay_ : 5) * kMsecPerSec);
       timer_submit_.setInterval(submit_delay);
       timer_submit_.start();
+      if (submit_error_) {
+        // Grow the delay for the next retry, so an unreachable server is not hammered at a fixed rate.
+        submit_error_delay_ = std::min(submit_error_delay_ * 2, kSubmitErrorDelayMax);
+      }
     }
   }
 
@@ -592,6 +600,7 @@ void ListenBrainzScrobbler::ScrobbleRequestFinished(QNetworkReply *reply, Scrobb
     }
     cache_->Flush(cache_items);
     submit_error_ = false;
+    submit_error_delay_ = kSubmitErrorDelay;
   }
   else {
     submit_error_ = true;
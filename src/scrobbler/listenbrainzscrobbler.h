@@ -109,6 +109,8 @@ class ListenBrainzScrobbler : public ScrobblerService {
   static const char *kClientSecretB64;
   static const char *kCacheFile;
   static const int kScrobblesPerRequest;
+  static const int kSubmitErrorDelay;
+  static const int kSubmitErrorDelayMax;
 
   AudioScrobbler *scrobbler_;
   NetworkAccessManager *network_;
@@ -128,6 +130,8 @@ class ListenBrainzScrobbler : public ScrobblerService {
   QTimer refresh_login_timer_;
   QTimer timer_submit_;
   bool submit_error_;
+  // Current retry delay in seconds, doubled on every failed submission up to kSubmitErrorDelayMax.
+  int submit_error_delay_;
 
   bool prefer_albumartist_;
 
@@ -26,6 +26,7 @@
 #include <QObject>
 #include <QStandardPaths>
 #include <QString>
+#include <QStringList>
 #include <QFile>
 #include <QIODevice>
 #include <QTextStream>
@@ -43,11 +44,17 @@
 
 using namespace std::chrono_literals;
 
+namespace {
+// Compact the journal once at least this many flushed records have accumulated and they outnumber the live entries.
+constexpr int kJournalCompactMinDeadRecords = 50;
+}  // namespace
+
 ScrobblerCache::ScrobblerCache(const QString &filename, QObject *parent)
     : QObject(parent),
       timer_flush_(new QTimer(this)),
       filename_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + filename),
-      loaded_(false) {
+      loaded_(false),
+      journal_dead_records_(0) {
 
   ReadCache();
   loaded_ = true;
@@ -79,29 +86,51 @@ void ScrobblerCache::ReadCache() {
 
   if (data.isEmpty()) return;
 
+  // The cache used to be a single pretty-printed JSON document with a "tracks" array.
+  // If the whole file parses as such a document, load it the old way and let the next compaction rewrite it as a journal.
   QJsonParseError error;
   QJsonDocument json_doc = QJsonDocument::fromJson(data.toUtf8(), &error);
-  if (error.error != QJsonParseError::NoError) {
-    qLog(Error) << "Scrobbler cache is missing JSON data.";
-    return;
-  }
-  if (json_doc.isEmpty()) {
-    qLog(Error) << "Scrobbler cache has empty JSON document.";
-    return;
-  }
-  if (!json_doc.isObject()) {
-    qLog(Error) << "Scrobbler cache JSON document is not an object.";
-    return;
-  }
-  QJsonObject json_obj = json_doc.object();
-  if (json_obj.isEmpty()) {
-    qLog(Error) << "Scrobbler cache has empty JSON object.";
+  if (error.error == QJsonParseError::NoError && json_doc.isObject() && json_doc.object().contains("tracks")) {
+    ReadLegacyCache(json_doc.object());
+    timer_flush_->start();
     return;
   }
-  if (!json_obj.contains("tracks")) {
-    qLog(Error) << "Scrobbler cache is missing JSON tracks.";
-    return;
+
+  // Otherwise the file is an append-only journal: one JSON record per line, an "add" record per scrobble and a "flush" record per acknowledgement.
+  const QStringList lines = data.split('\n');
+  for (const QString &line : lines) {
+    if (line.isEmpty()) continue;
+    QJsonDocument json_doc_record = QJsonDocument::fromJson(line.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !json_doc_record.isObject()) {
+      // A torn last line from a crash mid-append is expected, anything else is logged.
+      qLog(Error) << "Scrobbler cache journal has invalid record" << line;
+      continue;
+    }
+    QJsonObject json_obj_record = json_doc_record.object();
+    const QString op = json_obj_record["op"].toString();
+    if (op == "add") {
+      ScrobblerCacheItemPtr cache_item = ParseTrackObject(json_obj_record);
+      if (cache_item) scrobbler_cache_ << cache_item;
+    }
+    else if (op == "flush") {
+      const quint64 timestamp = json_obj_record["timestamp"].toVariant().toULongLong();
+      for (ScrobblerCacheItemPtr cache_item : scrobbler_cache_) {
+        if (cache_item->timestamp == timestamp) {
+          scrobbler_cache_.removeAll(cache_item);
+          ++journal_dead_records_;
+          break;
+        }
+      }
+    }
+    else {
+      qLog(Error) << "Scrobbler cache journal has record with unknown op" << op;
+    }
   }
+
+}
+
+void ScrobblerCache::ReadLegacyCache(const QJsonObject &json_obj) {
+
   QJsonValue json_tracks = json_obj["tracks"];
   if (!json_tracks.isArray()) {
     qLog(Error) << "Scrobbler cache JSON tracks is not an array.";
@@ -118,73 +147,137 @@ void ScrobblerCache::ReadCache() {
       qLog(Debug) << value;
       continue;
     }
-    QJsonObject json_obj_track = value.toObject();
-    if (
-        !json_obj_track.contains("timestamp") ||
-        !json_obj_track.contains("artist") ||
-        !json_obj_track.contains("album") ||
-        !json_obj_track.contains("title") ||
-        !json_obj_track.contains("track") ||
-        !json_obj_track.contains("albumartist") ||
-        !json_obj_track.contains("length_nanosec")
-    ) {
-      qLog(Error) << "Scrobbler cache JSON tracks array value is missing data.";
-      qLog(Debug) << value;
-      continue;
-    }
+    ScrobblerCacheItemPtr cache_item = ParseTrackObject(value.toObject());
+    if (cache_item) scrobbler_cache_ << cache_item;
+  }
 
-    ScrobbleMetadata metadata;
-    quint64 timestamp = json_obj_track["timestamp"].toVariant().toULongLong();
-    metadata.artist = json_obj_track["artist"].toString();
-    metadata.album = json_obj_track["album"].toString();
-    metadata.title = json_obj_track["title"].toString();
-    metadata.track = json_obj_track["track"].toInt();
-    metadata.albumartist = json_obj_track["albumartist"].toString();
-    metadata.length_nanosec = json_obj_track["length_nanosec"].toVariant().toLongLong();
-
-    if (timestamp <= 0 || metadata.artist.isEmpty() || metadata.title.isEmpty() || metadata.length_nanosec <= 0) {
-      qLog(Error) << "Invalid cache data" << "for song" << metadata.title;
-      continue;
-    }
+}
 
-    if (json_obj_track.contains("grouping")) {
-      metadata.grouping = json_obj_track["grouping"].toString();
-    }
+ScrobblerCacheItemPtr ScrobblerCache::ParseTrackObject(const QJsonObject &json_obj_track) const {
+
+  if (
+      !json_obj_track.contains("timestamp") ||
+      !json_obj_track.contains("artist") ||
+      !json_obj_track.contains("album") ||
+      !json_obj_track.contains("title") ||
+      !json_obj_track.contains("track") ||
+      !json_obj_track.contains("albumartist") ||
+      !json_obj_track.contains("length_nanosec")
+  ) {
+    qLog(Error) << "Scrobbler cache JSON track is missing data.";
+    qLog(Debug) << json_obj_track;
+    return nullptr;
+  }
 
-    if (json_obj_track.contains("musicbrainz_album_artist_id")) {
-      metadata.musicbrainz_album_artist_id = json_obj_track["musicbrainz_album_artist_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_artist_id")) {
-      metadata.musicbrainz_artist_id = json_obj_track["musicbrainz_artist_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_original_artist_id")) {
-      metadata.musicbrainz_original_artist_id = json_obj_track["musicbrainz_original_artist_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_album_id")) {
-      metadata.musicbrainz_album_id = json_obj_track["musicbrainz_album_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_original_album_id")) {
-      metadata.musicbrainz_original_album_id = json_obj_track["musicbrainz_original_album_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_recording_id")) {
-      metadata.musicbrainz_recording_id = json_obj_track["musicbrainz_recording_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_track_id")) {
-      metadata.musicbrainz_track_id = json_obj_track["musicbrainz_track_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_disc_id")) {
-      metadata.musicbrainz_disc_id = json_obj_track["musicbrainz_disc_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_release_group_id")) {
-      metadata.musicbrainz_release_group_id = json_obj_track["musicbrainz_release_group_id"].toString();
-    }
-    if (json_obj_track.contains("musicbrainz_work_id")) {
-      metadata.musicbrainz_work_id = json_obj_track["musicbrainz_work_id"].toString();
-    }
+  ScrobbleMetadata metadata;
+  quint64 timestamp = json_obj_track["timestamp"].toVariant().toULongLong();
+  metadata.artist = json_obj_track["artist"].toString();
+  metadata.album = json_obj_track["album"].toString();
+  metadata.title = json_obj_track["title"].toString();
+  metadata.track = json_obj_track["track"].toInt();
+  metadata.albumartist = json_obj_track["albumartist"].toString();
+  metadata.length_nanosec = json_obj_track["length_nanosec"].toVariant().toLongLong();
+
+  if (timestamp <= 0 || metadata.artist.isEmpty() || metadata.title.isEmpty() || metadata.length_nanosec <= 0) {
+    qLog(Error) << "Invalid cache data" << "for song" << metadata.title;
+    return nullptr;
+  }
+
+  if (json_obj_track.contains("grouping")) {
+    metadata.grouping = json_obj_track["grouping"].toString();
+  }
+
+  if (json_obj_track.contains("musicbrainz_album_artist_id")) {
+    metadata.musicbrainz_album_artist_id = json_obj_track["musicbrainz_album_artist_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_artist_id")) {
+    metadata.musicbrainz_artist_id = json_obj_track["musicbrainz_artist_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_original_artist_id")) {
+    metadata.musicbrainz_original_artist_id = json_obj_track["musicbrainz_original_artist_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_album_id")) {
+    metadata.musicbrainz_album_id = json_obj_track["musicbrainz_album_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_original_album_id")) {
+    metadata.musicbrainz_original_album_id = json_obj_track["musicbrainz_original_album_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_recording_id")) {
+    metadata.musicbrainz_recording_id = json_obj_track["musicbrainz_recording_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_track_id")) {
+    metadata.musicbrainz_track_id = json_obj_track["musicbrainz_track_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_disc_id")) {
+    metadata.musicbrainz_disc_id = json_obj_track["musicbrainz_disc_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_release_group_id")) {
+    metadata.musicbrainz_release_group_id = json_obj_track["musicbrainz_release_group_id"].toString();
+  }
+  if (json_obj_track.contains("musicbrainz_work_id")) {
+    metadata.musicbrainz_work_id = json_obj_track["musicbrainz_work_id"].toString();
+  }
+
+  return std::make_shared<ScrobblerCacheItem>(metadata, timestamp);
+
+}
+
+QJsonObject ScrobblerCache::CacheItemToJsonObject(ScrobblerCacheItemPtr cache_item) {
+
+  QJsonObject object;
+  object.insert("op", "add");
+  object.insert("timestamp", QJsonValue::fromVariant(cache_item->timestamp));
+  object.insert("artist", QJsonValue::fromVariant(cache_item->metadata.artist));
+  object.insert("album", QJsonValue::fromVariant(cache_item->metadata.album));
+  object.insert("title", QJsonValue::fromVariant(cache_item->metadata.title));
+  object.insert("track", QJsonValue::fromVariant(cache_item->metadata.track));
+  object.insert("albumartist", QJsonValue::fromVariant(cache_item->metadata.albumartist));
+  object.insert("grouping", QJsonValue::fromVariant(cache_item->metadata.grouping));
+  object.insert("musicbrainz_album_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_artist_id));
+  object.insert("musicbrainz_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_artist_id));
+  object.insert("musicbrainz_original_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_artist_id));
+  object.insert("musicbrainz_album_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_id));
+  object.insert("musicbrainz_original_album_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_album_id));
+  object.insert("musicbrainz_recording_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_recording_id));
+  object.insert("musicbrainz_track_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_track_id));
+  object.insert("musicbrainz_disc_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_disc_id));
+  object.insert("musicbrainz_release_group_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_release_group_id));
+  object.insert("musicbrainz_work_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_work_id));
+  object.insert("length_nanosec", QJsonValue::fromVariant(cache_item->metadata.length_nanosec));
+
+  return object;
+
+}
+
+void ScrobblerCache::AppendJournal(const QList<QJsonObject> &objects) {
+
+  QFile file(filename_);
+  bool result = file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+  if (!result) {
+    qLog(Error) << "Unable to open scrobbler cache file" << filename_;
+    // Fall back to a full rewrite from the timer so nothing is lost for long.
+    if (!timer_flush_->isActive()) timer_flush_->start();
+    return;
+  }
+  QTextStream stream(&file);
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+  stream.setEncoding(QStringConverter::Encoding::Utf8);
+#else
+  stream.setCodec("UTF-8");
+#endif
+  for (const QJsonObject &object : objects) {
+    stream << QJsonDocument(object).toJson(QJsonDocument::Compact) << "\n";
+  }
+  file.close();
+
+}
+
+void ScrobblerCache::ScheduleCompact() {
 
-    ScrobblerCacheItemPtr cache_item = std::make_shared<ScrobblerCacheItem>(metadata, timestamp);
-    scrobbler_cache_ << cache_item;
+  if (journal_dead_records_ < kJournalCompactMinDeadRecords || journal_dead_records_ < scrobbler_cache_.count()) return;
 
+  if (!timer_flush_->isActive()) {
+    timer_flush_->start();
   }
 
 }
@@ -193,7 +286,9 @@ void ScrobblerCache::WriteCache() {
 
   if (!loaded_) return;
 
-  qLog(Debug) << "Writing scrobbler cache file" << filename_;
+  qLog(Debug) << "Compacting scrobbler cache file" << filename_;
+
+  journal_dead_records_ = 0;
 
   if (scrobbler_cache_.isEmpty()) {
     QFile file(filename_);
@@ -201,34 +296,6 @@ void ScrobblerCache::WriteCache() {
     return;
   }
 
-  QJsonArray array;
-  for (ScrobblerCacheItemPtr cache_item : scrobbler_cache_) {
-    QJsonObject object;
-    object.insert("timestamp", QJsonValue::fromVariant(cache_item->timestamp));
-    object.insert("artist", QJsonValue::fromVariant(cache_item->metadata.artist));
-    object.insert("album", QJsonValue::fromVariant(cache_item->metadata.album));
-    object.insert("title", QJsonValue::fromVariant(cache_item->metadata.title));
-    object.insert("track", QJsonValue::fromVariant(cache_item->metadata.track));
-    object.insert("albumartist", QJsonValue::fromVariant(cache_item->metadata.albumartist));
-    object.insert("grouping", QJsonValue::fromVariant(cache_item->metadata.grouping));
-    object.insert("musicbrainz_album_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_artist_id));
-    object.insert("musicbrainz_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_artist_id));
-    object.insert("musicbrainz_original_artist_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_artist_id));
-    object.insert("musicbrainz_album_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_id));
-    object.insert("musicbrainz_original_album_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_album_id));
-    object.insert("musicbrainz_recording_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_recording_id));
-    object.insert("musicbrainz_track_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_track_id));
-    object.insert("musicbrainz_disc_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_disc_id));
-    object.insert("musicbrainz_release_group_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_release_group_id));
-    object.insert("musicbrainz_work_id", QJsonValue::fromVariant(cache_item->metadata.musicbrainz_work_id));
-    object.insert("length_nanosec", QJsonValue::fromVariant(cache_item->metadata.length_nanosec));
-    array.append(QJsonValue::fromVariant(object));
-  }
-
-  QJsonObject object;
-  object.insert("tracks", array);
-  QJsonDocument doc(object);
-
   QFile file(filename_);
   bool result = file.open(QIODevice::WriteOnly | QIODevice::Text);
   if (!result) {
@@ -241,7 +308,9 @@ void ScrobblerCache::WriteCache() {
 #else
   stream.setCodec("UTF-8");
 #endif
-  stream << doc.toJson();
+  for (ScrobblerCacheItemPtr cache_item : scrobbler_cache_) {
+    stream << QJsonDocument(CacheItemToJsonObject(cache_item)).toJson(QJsonDocument::Compact) << "\n";
+  }
   file.close();
 
 }
@@ -252,8 +321,9 @@ ScrobblerCacheItemPtr ScrobblerCache::Add(const Song &song, const quint64 timest
 
   scrobbler_cache_ << cache_item;
 
-  if (loaded_ && !timer_flush_->isActive()) {
-    timer_flush_->start();
+  // Persisting a new scrobble is a single small append, the full rewrite only happens when the journal is compacted.
+  if (loaded_) {
+    AppendJournal(QList<QJsonObject>() << CacheItemToJsonObject(cache_item));
   }
 
   return cache_item;
@@ -264,7 +334,14 @@ void ScrobblerCache::Remove(ScrobblerCacheItemPtr cache_item) {
 
   if (scrobbler_cache_.contains(cache_item)) {
     scrobbler_cache_.removeAll(cache_item);
+    QJsonObject object;
+    object.insert("op", "flush");
+    object.insert("timestamp", QJsonValue::fromVariant(cache_item->timestamp));
+    AppendJournal(QList<QJsonObject>() << object);
+    ++journal_dead_records_;
+    ScheduleCompact();
   }
+
 }
 
 void ScrobblerCache::ClearSent(ScrobblerCacheItemPtrList cache_items) {
@@ -285,14 +362,21 @@ void ScrobblerCache::SetError(ScrobblerCacheItemPtrList cache_items) {
 
 void ScrobblerCache::Flush(ScrobblerCacheItemPtrList cache_items) {
 
+  QList<QJsonObject> objects;
   for (ScrobblerCacheItemPtr cache_item : cache_items) {
     if (scrobbler_cache_.contains(cache_item)) {
       scrobbler_cache_.removeAll(cache_item);
+      QJsonObject object;
+      object.insert("op", "flush");
+      object.insert("timestamp", QJsonValue::fromVariant(cache_item->timestamp));
+      objects << object;
+      ++journal_dead_records_;
     }
   }
 
-  if (!timer_flush_->isActive()) {
-    timer_flush_->start();
+  if (!objects.isEmpty()) {
+    AppendJournal(objects);
+    ScheduleCompact();
   }
 
 }
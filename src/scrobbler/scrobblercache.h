@@ -28,6 +28,7 @@
 #include <QObject>
 #include <QList>
 #include <QString>
+#include <QJsonObject>
 
 #include "scrobblercacheitem.h"
 
@@ -52,12 +53,23 @@ class ScrobblerCache : public QObject {
   void Flush(ScrobblerCacheItemPtrList cache_items);
 
  public slots:
+  // Compacts the journal: rewrites the file with only the entries still awaiting acknowledgement.
   void WriteCache();
 
+ private:
+  void ReadLegacyCache(const QJsonObject &json_obj);
+  ScrobblerCacheItemPtr ParseTrackObject(const QJsonObject &json_obj_track) const;
+  static QJsonObject CacheItemToJsonObject(ScrobblerCacheItemPtr cache_item);
+  void AppendJournal(const QList<QJsonObject> &objects);
+  // Starts the compaction timer once flushed journal records outnumber the live entries.
+  void ScheduleCompact();
+
  private:
   QTimer *timer_flush_;
   QString filename_;
   bool loaded_;
+  // Journal records that refer to already flushed scrobbles, reset on compaction.
+  int journal_dead_records_;
   QList<ScrobblerCacheItemPtr> scrobbler_cache_;
 
 };
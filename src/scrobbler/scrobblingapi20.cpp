@@ -26,6 +26,7 @@
 #include <QLocale>
 #include <QClipboard>
 #include <QPair>
+#include <QMap>
 #include <QVariant>
 #include <QByteArray>
 #include <QString>
@@ -80,7 +81,8 @@ ScrobblingAPI20::ScrobblingAPI20(const QString &name, const QString &settings_gr
       submitted_(false),
       scrobbled_(false),
       timestamp_(0),
-      submit_error_(false) {
+      submit_error_(false),
+      submit_error_count_(0) {
 
   timer_submit_.setSingleShot(true);
   QObject::connect(&timer_submit_, &QTimer::timeout, this, &ScrobblingAPI20::Submit);
@@ -478,7 +480,9 @@ void ScrobblingAPI20::StartSubmit(const bool initial) {
       Submit();
     }
     else if (!timer_submit_.isActive()) {
-      int submit_delay = static_cast<int>(std::max(scrobbler_->SubmitDelay(), submit_error_ ? 30 : 5) * kMsecPerSec);
+      // Consecutive failures back off exponentially (30s, 60s, ...) up to half an hour, so a failing or rate-limiting service isn't hammered.
+      const int error_delay = std::min(15 << std::min(submit_error_count_, 7), 1800);
+      int submit_delay = static_cast<int>(std::max(scrobbler_->SubmitDelay(), submit_error_ ? error_delay : 5) * kMsecPerSec);
       timer_submit_.setInterval(submit_delay);
       timer_submit_.start();
     }
@@ -546,12 +550,14 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
     Error(error_message);
     cache_->ClearSent(cache_items);
     submit_error_ = true;
+    ++submit_error_count_;
     StartSubmit();
     return;
   }
 
   cache_->Flush(cache_items);
   submit_error_ = false;
+  submit_error_count_ = 0;
 
   if (!json_obj.contains("scrobbles")) {
     Error("Json reply from server is missing scrobbles.", json_obj);
@@ -599,6 +605,12 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
 
   qLog(Debug) << name_ << "Scrobbles accepted:" << accepted << "ignored:" << ignored;
 
+  // Index the batch by timestamp so the per-item results below can be mapped back to the cache entries we actually sent.
+  QMap<quint64, ScrobblerCacheItemPtr> cache_items_by_timestamp;
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
+    cache_items_by_timestamp.insert(cache_item->timestamp, cache_item);
+  }
+
   QJsonArray array_scrobble;
 
   QJsonValue value_scrobble = json_obj["scrobble"];
@@ -651,7 +663,7 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
     QJsonValue value_album = json_track["album"];
     QJsonValue value_song = json_track["track"];
     QJsonValue value_ignoredmessage = json_track["ignoredMessage"];
-    //quint64 timestamp = json_track["timestamp"].toVariant().toULongLong();
+    quint64 timestamp = json_track["timestamp"].toVariant().toULongLong();
 
     if (!value_artist.isObject() || !value_album.isObject() || !value_song.isObject() || !value_ignoredmessage.isObject()) {
       Error("Json scrobbles scrobble values are not objects.", json_track);
@@ -678,6 +690,10 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
     bool ignoredmessage = obj_ignoredmessage["code"].toVariant().toBool();
     QString ignoredmessage_text = obj_ignoredmessage["#text"].toString();
 
+    // The server may have corrected the title, report the ignored scrobble under the title we have cached.
+    ScrobblerCacheItemPtr cache_item = cache_items_by_timestamp.value(timestamp);
+    if (cache_item && song.isEmpty()) song = cache_item->metadata.title;
+
     if (ignoredmessage) {
       Error(QString("Scrobble for \"%1\" ignored: %2").arg(song, ignoredmessage_text));
     }
@@ -687,7 +703,8 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
 
  }
 
-  StartSubmit();
+  // Submit the next batch right away so a backlog from an offline period drains back-to-back instead of waiting out the resubmit timer for every 50 scrobbles.
+  StartSubmit(true);
 
 }
 
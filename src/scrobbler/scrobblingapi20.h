@@ -160,6 +160,8 @@ class ScrobblingAPI20 : public ScrobblerService {
   bool scrobbled_;
   quint64 timestamp_;
   bool submit_error_;
+  // Number of consecutive failed submissions, drives the exponential backoff in StartSubmit().
+  int submit_error_count_;
 
   QTimer timer_submit_;
 
@@ -59,6 +59,7 @@ const char *BackendSettingsPage::kOutputCustom = "Custom";
 const qint64 BackendSettingsPage::kDefaultBufferDuration = 4000;
 const double BackendSettingsPage::kDefaultBufferLowWatermark = 0.33;
 const double BackendSettingsPage::kDefaultBufferHighWatermark = 0.99;
+const qint64 BackendSettingsPage::kDefaultPreloadPrefetchBytes = 4 * 1024 * 1024;
 
 BackendSettingsPage::BackendSettingsPage(SettingsDialog *dialog, QWidget *parent)
     : SettingsPage(dialog, parent),
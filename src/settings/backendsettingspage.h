@@ -46,6 +46,7 @@ class BackendSettingsPage : public SettingsPage {
   static const qint64 kDefaultBufferDuration;
   static const double kDefaultBufferLowWatermark;
   static const double kDefaultBufferHighWatermark;
+  static const qint64 kDefaultPreloadPrefetchBytes;
 
   void Load() override;
   void Save() override;
@@ -182,6 +182,7 @@ void CollectionSettingsPage::Load() {
   ui_->show_dividers->setChecked(s.value("show_dividers", true).toBool());
   ui_->startup_scan->setChecked(s.value("startup_scan", true).toBool());
   ui_->monitor->setChecked(s.value("monitor", true).toBool());
+  ui_->prewarm_album_art->setChecked(s.value("prewarm_album_art", true).toBool());
   ui_->song_tracking->setChecked(s.value("song_tracking", false).toBool());
   ui_->mark_songs_unavailable->setChecked(ui_->song_tracking->isChecked() ? true : s.value("mark_songs_unavailable", true).toBool());
   ui_->expire_unavailable_songs_days->setValue(s.value("expire_unavailable_songs", 60).toInt());
@@ -256,6 +257,7 @@ void CollectionSettingsPage::Save() {
   s.setValue("show_dividers", ui_->show_dividers->isChecked());
   s.setValue("startup_scan", ui_->startup_scan->isChecked());
   s.setValue("monitor", ui_->monitor->isChecked());
+  s.setValue("prewarm_album_art", ui_->prewarm_album_art->isChecked());
   s.setValue("song_tracking", ui_->song_tracking->isChecked());
   s.setValue("mark_songs_unavailable", ui_->song_tracking->isChecked() ? true : ui_->mark_songs_unavailable->isChecked());
   s.setValue("expire_unavailable_songs", ui_->expire_unavailable_songs_days->value());
@@ -28,13 +28,13 @@
 #include "playlistquerygenerator.h"
 #include "collection/collectionbackend.h"
 
-PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), current_pos_(0) {}
+PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), keyset_rowid_(-1) {}
 
 PlaylistQueryGenerator::PlaylistQueryGenerator(const QString &name, const SmartPlaylistSearch &search, const bool dynamic, QObject *parent)
     : PlaylistGenerator(parent),
       search_(search),
       dynamic_(dynamic),
-      current_pos_(0) {
+      keyset_rowid_(-1) {
 
   set_name(name);
 
@@ -44,7 +44,8 @@ void PlaylistQueryGenerator::Load(const SmartPlaylistSearch &search) {
 
   search_ = search;
   dynamic_ = false;
-  current_pos_ = 0;
+  keyset_value_ = QVariant();
+  keyset_rowid_ = -1;
 
 }
 
@@ -70,7 +71,8 @@ QByteArray PlaylistQueryGenerator::Save() const {
 PlaylistItemPtrList PlaylistQueryGenerator::Generate() {
 
   previous_ids_.clear();
-  current_pos_ = 0;
+  keyset_value_ = QVariant();
+  keyset_rowid_ = -1;
   return GenerateMore(0);
 
 }
@@ -78,17 +80,27 @@ PlaylistItemPtrList PlaylistQueryGenerator::Generate() {
 PlaylistItemPtrList PlaylistQueryGenerator::GenerateMore(const int count) {
 
   SmartPlaylistSearch search_copy = search_;
-  search_copy.id_not_in_ = previous_ids_;
   if (count > 0) {
     search_copy.limit_ = count;
   }
 
-  if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random) {
-    search_copy.first_item_ = current_pos_;
-    current_pos_ += search_copy.limit_;
+  if (search_copy.sort_type_ == SmartPlaylistSearch::SortType::Random) {
+    search_copy.id_not_in_ = previous_ids_;
+  }
+  else {
+    // Resume after the last row we handed out.
+    // The boundary alone excludes everything already returned, so the NOT IN list isn't needed here.
+    search_copy.keyset_value_ = keyset_value_;
+    search_copy.keyset_rowid_ = keyset_rowid_;
   }
 
   SongList songs = backend_->SmartPlaylistsFindSongs(search_copy);
+
+  if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random && !songs.isEmpty()) {
+    keyset_value_ = search_copy.keyset_value_;
+    keyset_rowid_ = search_copy.keyset_rowid_;
+  }
+
   PlaylistItemPtrList items;
   items.reserve(songs.count());
   for (const Song &song : songs) {
@@ -25,6 +25,7 @@
 
 #include <QList>
 #include <QByteArray>
+#include <QVariant>
 #include <QString>
 
 #include "playlistgenerator.h"
@@ -56,7 +57,10 @@ class PlaylistQueryGenerator : public PlaylistGenerator {
   bool dynamic_;
 
   QList<int> previous_ids_;
-  int current_pos_;
+
+  // Boundary of the last page for field sorted searches, so refills resume with a keyset query instead of an OFFSET re-scan.
+  QVariant keyset_value_;
+  int keyset_rowid_;
 
 };
 
@@ -28,7 +28,7 @@
 
 #include "smartplaylistsearch.h"
 
-SmartPlaylistSearch::SmartPlaylistSearch() : search_type_(SearchType::And), sort_type_(SortType::Random), sort_field_(SmartPlaylistSearchTerm::Field::Title), limit_(-1), first_item_(0) { Reset(); }
+SmartPlaylistSearch::SmartPlaylistSearch() : search_type_(SearchType::And), sort_type_(SortType::Random), sort_field_(SmartPlaylistSearchTerm::Field::Title), limit_(-1), first_item_(0), keyset_rowid_(-1) { Reset(); }
 
 SmartPlaylistSearch::SmartPlaylistSearch(const SearchType type, const TermList &terms, const SortType sort_type, const SmartPlaylistSearchTerm::Field sort_field, const int limit)
     : search_type_(type),
@@ -36,7 +36,8 @@ SmartPlaylistSearch::SmartPlaylistSearch(const SearchType type, const TermList &
       sort_type_(sort_type),
       sort_field_(sort_field),
       limit_(limit),
-      first_item_(0) {}
+      first_item_(0),
+      keyset_rowid_(-1) {}
 
 void SmartPlaylistSearch::Reset() {
 
@@ -46,12 +47,19 @@ void SmartPlaylistSearch::Reset() {
   sort_field_ = SmartPlaylistSearchTerm::Field::Title;
   limit_ = -1;
   first_item_ = 0;
+  keyset_value_ = QVariant();
+  keyset_rowid_ = -1;
 
 }
 
 QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
 
-  QString sql = "SELECT ROWID," + Song::kColumnSpec + " FROM " + songs_table;
+  QString sql = "SELECT ROWID," + Song::kColumnSpec;
+  if (sort_type_ != SortType::Random) {
+    // Also select the sort column so the caller can remember the boundary of this page for keyset continuation.
+    sql += "," + SmartPlaylistSearchTerm::FieldColumnName(sort_field_);
+  }
+  sql += " FROM " + songs_table;
 
   // Add search terms
   QStringList where_clauses;
@@ -75,6 +83,14 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
     where_clauses << "(ROWID NOT IN (" + numbers + "))";
   }
 
+  // Resume strictly after the previous page's boundary row instead of re-scanning the skipped rows with OFFSET.
+  // The values are bound by the caller, so the SQL text stays identical between refills and the prepared statement can be reused.
+  if (has_keyset()) {
+    const QString column = SmartPlaylistSearchTerm::FieldColumnName(sort_field_);
+    const QString op = sort_type_ == SortType::FieldAsc ? ">" : "<";
+    where_clauses << "(" + column + " " + op + " :keyset_value OR (" + column + " = :keyset_value2 AND ROWID " + op + " :keyset_rowid))";
+  }
+
   // We never want to include songs that have been deleted,
   // but are still kept in the database in case the directory containing them has just been unmounted.
   where_clauses << "unavailable = 0";
@@ -88,7 +104,9 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
     sql += " ORDER BY random()";
   }
   else {
-    sql += " ORDER BY " + SmartPlaylistSearchTerm::FieldColumnName(sort_field_) + (sort_type_ == SortType::FieldAsc ? " ASC" : " DESC");
+    // ROWID breaks ties between equal sort values so the order is stable and keyset pages never skip or repeat rows.
+    const QString direction = sort_type_ == SortType::FieldAsc ? " ASC" : " DESC";
+    sql += " ORDER BY " + SmartPlaylistSearchTerm::FieldColumnName(sort_field_) + direction + ", ROWID" + direction;
   }
 
   // Add limit
@@ -24,6 +24,7 @@
 #include "config.h"
 
 #include <QList>
+#include <QVariant>
 #include <QString>
 #include <QDataStream>
 
@@ -53,6 +54,7 @@ class SmartPlaylistSearch {
   explicit SmartPlaylistSearch(const SearchType type, const TermList &terms, const SortType sort_type, const SmartPlaylistSearchTerm::Field sort_field, const int limit = PlaylistGenerator::kDefaultLimit);
 
   bool is_valid() const;
+  bool has_keyset() const { return sort_type_ != SortType::Random && keyset_rowid_ != -1; }
   bool operator==(const SmartPlaylistSearch &other) const;
   bool operator!=(const SmartPlaylistSearch &other) const { return !(*this == other); }
 
@@ -66,6 +68,12 @@ class SmartPlaylistSearch {
   QList<int> id_not_in_;
   int first_item_;
 
+  // Not persisted, the boundary of the previous page for field sorted searches.
+  // When keyset_rowid_ is set the query resumes strictly after (keyset_value_, keyset_rowid_) instead of re-scanning the skipped rows with OFFSET.
+  // CollectionBackend::SmartPlaylistsFindSongs fills these in from the last row it returns.
+  QVariant keyset_value_;
+  int keyset_rowid_;
+
   void Reset();
   QString ToSql(const QString &songs_table) const;
 
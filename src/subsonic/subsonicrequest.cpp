@@ -20,7 +20,11 @@
 #include "config.h"
 
 #include <QObject>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QDir>
+#include <QFileInfo>
 #include <QMimeDatabase>
 #include <QByteArray>
 #include <QByteArrayList>
@@ -52,7 +56,7 @@
 
 const int SubsonicRequest::kMaxConcurrentAlbumsRequests = 3;
 const int SubsonicRequest::kMaxConcurrentAlbumSongsRequests = 3;
-const int SubsonicRequest::kMaxConcurrentAlbumCoverRequests = 1;
+const int SubsonicRequest::kMaxConcurrentAlbumCoverRequests = 8;
 
 SubsonicRequest::SubsonicRequest(SubsonicService *service, SubsonicUrlHandler *url_handler, Application *app, QObject *parent)
     : SubsonicBaseRequest(service, parent),
@@ -69,6 +73,7 @@ SubsonicRequest::SubsonicRequest(SubsonicService *service, SubsonicUrlHandler *u
       album_covers_requests_active_(0),
       album_covers_requested_(0),
       album_covers_received_(0),
+      album_cover_saves_active_(0),
       no_results_(false) {
 
   network_->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
@@ -110,6 +115,7 @@ void SubsonicRequest::Reset() {
   album_covers_requests_active_ = 0;
   album_covers_requested_ = 0;
   album_covers_received_ = 0;
+  album_cover_saves_active_ = 0;
 
   songs_.clear();
   cover_urls_.clear();
@@ -120,6 +126,19 @@ void SubsonicRequest::Reset() {
 
 }
 
+void SubsonicRequest::SetPreviousSongs(const SongList &songs) {
+
+  previous_album_songs_.clear();
+  previous_album_stamps_.clear();
+
+  for (const Song &song : songs) {
+    if (song.album_id().isEmpty()) continue;
+    previous_album_songs_[song.album_id()] << song;
+    if (song.mtime() > previous_album_stamps_[song.album_id()]) previous_album_stamps_[song.album_id()] = song.mtime();
+  }
+
+}
+
 void SubsonicRequest::GetAlbums() {
 
   emit UpdateStatus(tr("Retrieving albums..."));
@@ -182,6 +201,9 @@ void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset
     return;
   }
 
+  // Release the raw reply body, the parsed document is all that is needed from here on.
+  data.clear();
+
   if (json_obj.contains("error")) {
     QJsonValue json_error = json_obj["error"];
     if (!json_error.isObject()) {
@@ -278,6 +300,23 @@ void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset
 
     if (album_songs_requests_pending_.contains(album_id)) continue;
 
+    qint64 album_stamp = 0;
+    if (obj_album.contains("changed")) {
+      album_stamp = QDateTime::fromString(obj_album["changed"].toString(), Qt::ISODate).toSecsSinceEpoch();
+    }
+    else if (obj_album.contains("created")) {
+      album_stamp = QDateTime::fromString(obj_album["created"].toString(), Qt::ISODate).toSecsSinceEpoch();
+    }
+
+    // Delta sync: if the album has the same modification stamp and song count as the previous sync, reuse the previous songs instead of requesting them again.
+    if (AlbumUnchanged(album_id, album_stamp, obj_album["songCount"].toInt())) {
+      const SongList previous_songs = previous_album_songs_[album_id];
+      for (const Song &previous_song : previous_songs) {
+        songs_.insert(previous_song.song_id(), previous_song);
+      }
+      continue;
+    }
+
     Request request;
     request.album_id = album_id;
     request.album_artist = artist;
@@ -289,6 +328,16 @@ void SubsonicRequest::AlbumsReplyReceived(QNetworkReply *reply, const int offset
 
 }
 
+bool SubsonicRequest::AlbumUnchanged(const QString &album_id, const qint64 album_stamp, const int album_song_count) const {
+
+  if (album_stamp <= 0 || album_song_count <= 0) return false;
+  if (!previous_album_songs_.contains(album_id)) return false;
+  if (previous_album_songs_[album_id].count() != album_song_count) return false;
+
+  return album_stamp <= previous_album_stamps_[album_id];
+
+}
+
 void SubsonicRequest::AlbumsFinishCheck(const int offset, const int size, const int albums_received) {
 
   if (finished_) return;
@@ -377,6 +426,8 @@ void SubsonicRequest::AlbumSongsReplyReceived(QNetworkReply *reply, const QStrin
     return;
   }
 
+  data.clear();
+
   if (json_obj.contains("error")) {
     QJsonValue json_error = json_obj["error"];
     if (!json_error.isObject()) {
@@ -719,6 +770,16 @@ void SubsonicRequest::AddAlbumCoverRequest(const Song &song) {
   QDir dir(cover_path);
   if (!dir.exists()) dir.mkpath(cover_path);
 
+  // If the cover is already in the cache directory from an earlier sync, use it without requesting it again.
+  const QString cover_filename = cover_path + "/" + cover_id + ".jpg";
+  const QFileInfo cover_fileinfo(cover_filename);
+  if (cover_fileinfo.exists() && cover_fileinfo.size() > 0) {
+    if (songs_.contains(song.song_id())) {
+      songs_[song.song_id()].set_art_automatic(QUrl::fromLocalFile(cover_filename));
+    }
+    return;
+  }
+
   AlbumCoverRequest request;
   request.album_id = song.album_id();
   request.cover_id = cover_id;
@@ -819,15 +880,31 @@ void SubsonicRequest::AlbumCoverReceived(QNetworkReply *reply, const AlbumCoverR
     return;
   }
 
-  QByteArrayList format_list = ImageUtils::ImageFormatsForMimeType(mimetype.toUtf8());
-  char *format = nullptr;
-  if (!format_list.isEmpty()) {
-    format = format_list.first().data();
-  }
+  const QByteArrayList format_list = ImageUtils::ImageFormatsForMimeType(mimetype.toUtf8());
 
-  QImage image;
-  if (image.loadFromData(data, format)) {
-    if (image.save(request.filename, format)) {
+  // Decode and write the cover on the thread pool, so the reply handler is free to dispatch the next queued request right away.
+  ++album_cover_saves_active_;
+  QFuture<QString> future = QtConcurrent::run([data, format_list, request]() -> QString {
+    QByteArrayList formats = format_list;
+    char *format = nullptr;
+    if (!formats.isEmpty()) {
+      format = formats.first().data();
+    }
+    QImage image;
+    if (!image.loadFromData(data, format)) {
+      return QString("Error decoding image data from %1.").arg(request.url.toString());
+    }
+    if (!image.save(request.filename, format)) {
+      return QString("Error saving image data to %1.").arg(request.filename);
+    }
+    return QString();
+  });
+  QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+  QObject::connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, request]() {
+    const QString error = watcher->result();
+    watcher->deleteLater();
+    --album_cover_saves_active_;
+    if (error.isEmpty()) {
       while (album_covers_requests_sent_.contains(request.cover_id)) {
         const QString song_id = album_covers_requests_sent_.take(request.cover_id);
         if (songs_.contains(song_id)) {
@@ -836,14 +913,12 @@ void SubsonicRequest::AlbumCoverReceived(QNetworkReply *reply, const AlbumCoverR
       }
     }
     else {
-      Error(QString("Error saving image data to %1.").arg(request.filename));
+      Error(error);
       if (album_covers_requests_sent_.contains(request.cover_id)) album_covers_requests_sent_.remove(request.cover_id);
     }
-  }
-  else {
-    Error(QString("Error decoding image data from %1.").arg(request.url.toString()));
-    if (album_covers_requests_sent_.contains(request.cover_id)) album_covers_requests_sent_.remove(request.cover_id);
-  }
+    AlbumCoverFinishCheck();
+  });
+  watcher->setFuture(future);
 
   AlbumCoverFinishCheck();
 
@@ -872,6 +947,7 @@ void SubsonicRequest::FinishCheck() {
       album_songs_requests_active_ <= 0 &&
       album_songs_received_ >= album_songs_requested_ &&
       album_covers_requests_active_ <= 0 &&
+      album_cover_saves_active_ <= 0 &&
       album_covers_received_ >= album_covers_requested_
   ) {
     finished_ = true;
@@ -56,6 +56,7 @@ class SubsonicRequest : public SubsonicBaseRequest {
 
   void ReloadSettings();
 
+  void SetPreviousSongs(const SongList &songs);
   void GetAlbums();
   void Reset();
 
@@ -93,6 +94,7 @@ class SubsonicRequest : public SubsonicBaseRequest {
   void AddAlbumsRequest(const int offset = 0, const int size = 500);
   void FlushAlbumsRequests();
 
+  bool AlbumUnchanged(const QString &album_id, const qint64 album_stamp, const int album_song_count) const;
   void AlbumsFinishCheck(const int offset = 0, const int size = 0, const int albums_received = 0);
   void SongsFinishCheck();
 
@@ -139,6 +141,11 @@ class SubsonicRequest : public SubsonicBaseRequest {
   int album_covers_requests_active_;
   int album_covers_requested_;
   int album_covers_received_;
+  int album_cover_saves_active_;
+
+  // Songs from the previous sync grouped by album ID, used to skip songs requests for unchanged albums.
+  QHash<QString, SongList> previous_album_songs_;
+  QHash<QString, qint64> previous_album_stamps_;
 
   SongMap songs_;
   QMap<QString, QUrl> cover_urls_;
@@ -439,6 +439,8 @@ void SubsonicService::GetSongs() {
   QObject::connect(songs_request_.get(), &SubsonicRequest::ProgressSetMaximum, this, &SubsonicService::SongsProgressSetMaximum);
   QObject::connect(songs_request_.get(), &SubsonicRequest::UpdateProgress, this, &SubsonicService::SongsUpdateProgress);
 
+  // Give the request the songs from the previous sync, so it can skip songs requests for unchanged albums.
+  songs_request_->SetPreviousSongs(collection_backend_->GetAllSongs());
   songs_request_->GetAlbums();
 
 }
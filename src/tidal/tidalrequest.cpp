@@ -67,6 +67,9 @@ TidalRequest::TidalRequest(TidalService *service, TidalUrlHandler *url_handler,
       coversize_(service->coversize()),
       query_id_(-1),
       finished_(false),
+      artists_pages_prefetched_(false),
+      albums_pages_prefetched_(false),
+      songs_pages_prefetched_(false),
       artists_requests_total_(0),
       artists_requests_active_(0),
       artists_requests_received_(0),
@@ -430,6 +433,9 @@ void TidalRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
     return;
   }
 
+  // Release the raw reply body, the parsed document is all that is needed from here on.
+  data.clear();
+
   if (!json_obj.contains("limit") ||
       !json_obj.contains("offset") ||
       !json_obj.contains("totalNumberOfItems") ||
@@ -516,6 +522,15 @@ void TidalRequest::ArtistsReplyReceived(QNetworkReply *reply, const int limit_re
   }
   artists_received_ += artists_received;
 
+  // The first page told us the page size and the total, so queue all remaining pages at once.
+  // The queue keeps at most kMaxConcurrentArtistsRequests in flight instead of chaining one page per reply.
+  if (query_type_ == QueryType::Artists && offset_requested == 0 && limit_requested == 0 && artists_received > 0 && !artists_pages_prefetched_) {
+    artists_pages_prefetched_ = true;
+    for (int offset_next = artists_received; offset_next < artists_total_; offset_next += artists_received) {
+      AddArtistsRequest(offset_next);
+    }
+  }
+
   if (offset_requested != 0) emit UpdateProgress(query_id_, GetProgress(artists_received_, artists_total_));
 
   ArtistsFinishCheck(limit_requested, offset, artists_received);
@@ -526,7 +541,7 @@ void TidalRequest::ArtistsFinishCheck(const int limit, const int offset, const i
 
   if (finished_) return;
 
-  if ((limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
+  if (!artists_pages_prefetched_ && (limit == 0 || limit > artists_received) && artists_received_ < artists_total_) {
     int offset_next = offset + artists_received;
     if (offset_next > 0 && offset_next < artists_total_) {
       if (query_type_ == QueryType::Artists) AddArtistsRequest(offset_next);
@@ -625,6 +640,8 @@ void TidalRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
     return;
   }
 
+  data.clear();
+
   if (!json_obj.contains("limit") ||
       !json_obj.contains("offset") ||
       !json_obj.contains("totalNumberOfItems") ||
@@ -768,6 +785,14 @@ void TidalRequest::AlbumsReceived(QNetworkReply *reply, const Artist &artist_req
     emit UpdateProgress(query_id_, GetProgress(albums_received_, albums_total_));
   }
 
+  // Queue all remaining favorite albums pages after the first page, same as for artists.
+  if (query_type_ == QueryType::Albums && artist_requested.artist_id.isEmpty() && offset_requested == 0 && limit_requested == 0 && albums_received > 0 && !albums_pages_prefetched_) {
+    albums_pages_prefetched_ = true;
+    for (int offset_next = albums_received; offset_next < albums_total; offset_next += albums_received) {
+      AddAlbumsRequest(offset_next);
+    }
+  }
+
   AlbumsFinishCheck(artist_requested, limit_requested, offset, albums_total, albums_received);
 
 }
@@ -781,7 +806,7 @@ void TidalRequest::AlbumsFinishCheck(const Artist &artist, const int limit, cons
     if (offset_next > 0 && offset_next < albums_total) {
       switch (query_type_) {
         case QueryType::Albums:
-          AddAlbumsRequest(offset_next);
+          if (!albums_pages_prefetched_) AddAlbumsRequest(offset_next);
           break;
         case QueryType::SearchAlbums:
           AddAlbumsSearchRequest(offset_next);
@@ -902,6 +927,8 @@ void TidalRequest::SongsReceived(QNetworkReply *reply, const Artist &artist, con
     return;
   }
 
+  data.clear();
+
   if (!json_obj.contains("limit") ||
       !json_obj.contains("offset") ||
       !json_obj.contains("totalNumberOfItems") ||
@@ -974,6 +1001,14 @@ void TidalRequest::SongsReceived(QNetworkReply *reply, const Artist &artist, con
     emit UpdateProgress(query_id_, GetProgress(songs_received_, songs_total_));
   }
 
+  // Queue all remaining favorite tracks pages after the first page, same as for artists and albums.
+  if (query_type_ == QueryType::Songs && artist.artist_id.isEmpty() && album.album_id.isEmpty() && offset_requested == 0 && limit_requested == 0 && songs_received > 0 && !songs_pages_prefetched_) {
+    songs_pages_prefetched_ = true;
+    for (int offset_next = songs_received; offset_next < songs_total; offset_next += songs_received) {
+      AddSongsRequest(offset_next);
+    }
+  }
+
   SongsFinishCheck(artist, album, limit_requested, offset_requested, songs_total, songs_received);
 
 }
@@ -987,7 +1022,7 @@ void TidalRequest::SongsFinishCheck(const Artist &artist, const Album &album, co
     if (offset_next > 0 && offset_next < songs_total) {
       switch (query_type_) {
         case QueryType::Songs:
-          AddSongsRequest(offset_next);
+          if (!songs_pages_prefetched_) AddSongsRequest(offset_next);
           break;
         case QueryType::SearchSongs:
           // If artist_id and album_id isn't zero it means that it's a songs search where we fetch all albums too. So fallthrough.
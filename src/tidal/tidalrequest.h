@@ -194,6 +194,11 @@ class TidalRequest : public TidalBaseRequest {
 
   bool finished_;
 
+  // Set once the first page's reply has been used to queue all remaining pages up front.
+  bool artists_pages_prefetched_;
+  bool albums_pages_prefetched_;
+  bool songs_pages_prefetched_;
+
   QQueue<Request> artists_requests_queue_;
   QQueue<Request> albums_requests_queue_;
   QQueue<Request> songs_requests_queue_;
@@ -280,15 +280,8 @@ void TranscodeDialog::JobComplete(const QString &input, const QString &output, b
 
 void TranscodeDialog::UpdateProgress() {
 
-  int progress = (finished_success_ + finished_failed_) * 100;
-
-  QMap<QString, float> current_jobs = transcoder_->GetProgress();
-  QList<float> values = current_jobs.values();
-  for (const float value : values) {
-    progress += qBound(0, static_cast<int>(value * 100), 99);
-  }
-
-  ui_->progress_bar->setValue(progress);
+  // Weight progress by input file size so one long file doesn't make the bar crawl at the end of the batch.
+  ui_->progress_bar->setValue(static_cast<int>(transcoder_->OverallProgress() * static_cast<float>(ui_->progress_bar->maximum())));
 
 }
 
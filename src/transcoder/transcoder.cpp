@@ -94,60 +94,74 @@ GstElement *Transcoder::CreateElementForMimeType(const QString &element_type, co
     return CreateElement("mp4mux", bin);
   }
 
-  // Keep track of all the suitable elements we find and figure out which is the best at the end.
-  QList<SuitableElement> suitable_elements_;
-
-  // The caps we're trying to find
-  GstCaps *target_caps = gst_caps_from_string(mime_type.toUtf8().constData());
-
-  GstRegistry *registry = gst_registry_get();
-  GList *const features = gst_registry_get_feature_list(registry, GST_TYPE_ELEMENT_FACTORY);
-
-  for (GList *f = features; f; f = g_list_next(f)) {
-    GstElementFactory *factory = GST_ELEMENT_FACTORY(f->data);
-
-    // Is this the right type of plugin?
-    if (QString(gst_element_factory_get_metadata(factory, GST_ELEMENT_METADATA_KLASS)).contains(element_type)) {
-      const GList *const templates = gst_element_factory_get_static_pad_templates(factory);
-      for (const GList *t = templates; t; t = g_list_next(t)) {
-        // Only interested in source pads
-        GstStaticPadTemplate *pad_template = reinterpret_cast<GstStaticPadTemplate*>(t->data);
-        if (pad_template->direction != GST_PAD_SRC) continue;
-
-        // Does this pad support the mime type we want?
-        GstCaps *caps = gst_static_pad_template_get_caps(pad_template);
-        GstCaps *intersection = gst_caps_intersect(caps, target_caps);
-        gst_caps_unref(caps);
-
-        if (intersection) {
-          if (!gst_caps_is_empty(intersection)) {
-            int rank = static_cast<int>(gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory)));
-            QString name = GST_OBJECT_NAME(factory);
-
-            if (name.startsWith("ffmux") || name.startsWith("ffenc")) {
-              rank = -1;  // ffmpeg usually sucks
-            }
+  const QString cache_key = element_type + " " + mime_type;
+  QString best_name;
+  if (best_element_cache_.contains(cache_key)) {
+    best_name = best_element_cache_[cache_key];
+  }
+  else {
+
+    // Keep track of all the suitable elements we find and figure out which is the best at the end.
+    QList<SuitableElement> suitable_elements_;
+
+    // The caps we're trying to find
+    GstCaps *target_caps = gst_caps_from_string(mime_type.toUtf8().constData());
+
+    GstRegistry *registry = gst_registry_get();
+    GList *const features = gst_registry_get_feature_list(registry, GST_TYPE_ELEMENT_FACTORY);
+
+    for (GList *f = features; f; f = g_list_next(f)) {
+      GstElementFactory *factory = GST_ELEMENT_FACTORY(f->data);
 
-            suitable_elements_ << SuitableElement(name, rank);
+      // Is this the right type of plugin?
+      if (QString(gst_element_factory_get_metadata(factory, GST_ELEMENT_METADATA_KLASS)).contains(element_type)) {
+        const GList *const templates = gst_element_factory_get_static_pad_templates(factory);
+        for (const GList *t = templates; t; t = g_list_next(t)) {
+          // Only interested in source pads
+          GstStaticPadTemplate *pad_template = reinterpret_cast<GstStaticPadTemplate*>(t->data);
+          if (pad_template->direction != GST_PAD_SRC) continue;
+
+          // Does this pad support the mime type we want?
+          GstCaps *caps = gst_static_pad_template_get_caps(pad_template);
+          GstCaps *intersection = gst_caps_intersect(caps, target_caps);
+          gst_caps_unref(caps);
+
+          if (intersection) {
+            if (!gst_caps_is_empty(intersection)) {
+              int rank = static_cast<int>(gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory)));
+              QString name = GST_OBJECT_NAME(factory);
+
+              if (name.startsWith("ffmux") || name.startsWith("ffenc")) {
+                rank = -1;  // ffmpeg usually sucks
+              }
+
+              suitable_elements_ << SuitableElement(name, rank);
+            }
+            gst_caps_unref(intersection);
           }
-          gst_caps_unref(intersection);
         }
       }
     }
-  }
 
-  gst_plugin_feature_list_free(features);
-  gst_caps_unref(target_caps);
+    gst_plugin_feature_list_free(features);
+    gst_caps_unref(target_caps);
 
-  if (suitable_elements_.isEmpty()) return nullptr;
+    if (!suitable_elements_.isEmpty()) {
+      // Sort by rank
+      std::sort(suitable_elements_.begin(), suitable_elements_.end());
+      const SuitableElement &best = suitable_elements_.last();
+      best_name = best.name_;
+      emit LogLine(QString("Using '%1' (rank %2)").arg(best.name_).arg(best.rank_));
+    }
 
-  // Sort by rank
-  std::sort(suitable_elements_.begin(), suitable_elements_.end());
-  const SuitableElement &best = suitable_elements_.last();
+    // Remember misses too, so an absent encoder doesn't rescan the registry for every job.
+    best_element_cache_.insert(cache_key, best_name);
 
-  emit LogLine(QString("Using '%1' (rank %2)").arg(best.name_).arg(best.rank_));
+  }
+
+  if (best_name.isEmpty()) return nullptr;
 
-  if (best.name_ == "lamemp3enc") {
+  if (best_name == "lamemp3enc") {
     // Special case: we need to add xingmux and id3v2mux to the pipeline when using lamemp3enc because it doesn't write the VBR or ID3v2 headers itself.
 
     emit LogLine("Adding xingmux and id3v2mux to the pipeline");
@@ -180,7 +194,7 @@ GstElement *Transcoder::CreateElementForMimeType(const QString &element_type, co
     return mp3bin;
   }
   else {
-    return CreateElement(best.name_, bin);
+    return CreateElement(best_name, bin);
   }
 
 }
@@ -201,6 +215,8 @@ void Transcoder::JobState::PostFinished(const bool success) {
 Transcoder::Transcoder(QObject *parent, const QString &settings_postfix)
     : QObject(parent),
       max_threads_(QThread::idealThreadCount()),
+      total_input_bytes_(0),
+      finished_input_bytes_(0),
       settings_postfix_(settings_postfix) {
 
   if (JobFinishedEvent::sEventType == -1)
@@ -327,12 +343,17 @@ void Transcoder::AddJob(const QString &input, const TranscoderPreset &preset, co
   job.input = input;
   job.preset = preset;
   job.output = output;
+  job.input_size = QFileInfo(input).size();
+  total_input_bytes_ += job.input_size;
   queued_jobs_ << job;
 
 }
 
 void Transcoder::Start() {
 
+  // Schedule the longest files first so a single long file can't end up alone at the tail of the batch with every other thread idle.
+  std::stable_sort(queued_jobs_.begin(), queued_jobs_.end(), [](const Job &a, const Job &b) { return a.input_size > b.input_size; });
+
   emit LogLine(tr("Transcoding %1 files using %2 threads").arg(queued_jobs_.count()).arg(max_threads()));
 
   forever {
@@ -347,6 +368,10 @@ Transcoder::StartJobStatus Transcoder::MaybeStartNextJob() {
   if (current_jobs_.count() >= max_threads()) return StartJobStatus::AllThreadsBusy;
   if (queued_jobs_.isEmpty()) {
     if (current_jobs_.isEmpty()) {
+      // The batch is done, release the pooled pipelines so encoders aren't kept alive between batches.
+      pipeline_pool_.clear();
+      total_input_bytes_ = 0;
+      finished_input_bytes_ = 0;
       emit AllJobsComplete();
     }
 
@@ -414,52 +439,78 @@ void Transcoder::JobState::ReportError(GstMessage *msg) const {
 
 }
 
-bool Transcoder::StartJob(const Job &job) {
+Transcoder::PooledPipelinePtr Transcoder::BuildPipeline(const TranscoderPreset &preset) {
 
-  std::shared_ptr<JobState> state = std::make_shared<JobState>(job, this);
-
-  emit LogLine(tr("Starting %1").arg(QDir::toNativeSeparators(job.input)));
+  PooledPipelinePtr pooled = std::make_shared<PooledPipeline>();
+  pooled->preset_name_ = preset.name_;
 
   // Create the pipeline.
-  // This should be a scoped_ptr, but scoped_ptr doesn't support custom destructors.
-  state->pipeline_ = gst_pipeline_new("pipeline");
-  if (!state->pipeline_) return false;
+  pooled->pipeline_ = gst_pipeline_new("pipeline");
+  if (!pooled->pipeline_) return nullptr;
 
   // Create all the elements
-  GstElement *src      = CreateElement("filesrc", state->pipeline_);
-  GstElement *decode   = CreateElement("decodebin", state->pipeline_);
-  GstElement *convert  = CreateElement("audioconvert", state->pipeline_);
-  GstElement *resample = CreateElement("audioresample", state->pipeline_);
-  GstElement *codec    = CreateElementForMimeType("Codec/Encoder/Audio", job.preset.codec_mimetype_, state->pipeline_);
-  GstElement *muxer    = CreateElementForMimeType("Codec/Muxer", job.preset.muxer_mimetype_, state->pipeline_);
-  GstElement *sink     = CreateElement("filesink", state->pipeline_);
-
-  if (!src || !decode || !convert || !sink) return false;
-
-  if (!codec && !job.preset.codec_mimetype_.isEmpty()) {
-    emit LogLine(tr("Couldn't find an encoder for %1, check you have the correct GStreamer plugins installed").arg(job.preset.codec_mimetype_));
-    return false;
+  pooled->src_     = CreateElement("filesrc", pooled->pipeline_);
+  pooled->decode_  = CreateElement("decodebin", pooled->pipeline_);
+  pooled->convert_ = CreateElement("audioconvert", pooled->pipeline_);
+  GstElement *resample = CreateElement("audioresample", pooled->pipeline_);
+  GstElement *codec    = CreateElementForMimeType("Codec/Encoder/Audio", preset.codec_mimetype_, pooled->pipeline_);
+  GstElement *muxer    = CreateElementForMimeType("Codec/Muxer", preset.muxer_mimetype_, pooled->pipeline_);
+  pooled->sink_    = CreateElement("filesink", pooled->pipeline_);
+
+  if (!pooled->src_ || !pooled->decode_ || !pooled->convert_ || !pooled->sink_) return nullptr;
+
+  if (!codec && !preset.codec_mimetype_.isEmpty()) {
+    emit LogLine(tr("Couldn't find an encoder for %1, check you have the correct GStreamer plugins installed").arg(preset.codec_mimetype_));
+    return nullptr;
   }
 
-  if (!muxer && !job.preset.muxer_mimetype_.isEmpty()) {
-    emit LogLine(tr("Couldn't find a muxer for %1, check you have the correct GStreamer plugins installed").arg(job.preset.muxer_mimetype_));
-    return false;
+  if (!muxer && !preset.muxer_mimetype_.isEmpty()) {
+    emit LogLine(tr("Couldn't find a muxer for %1, check you have the correct GStreamer plugins installed").arg(preset.muxer_mimetype_));
+    return nullptr;
   }
 
   // Join them together
-  gst_element_link(src, decode);
-  if (codec && muxer) gst_element_link_many(convert, resample, codec, muxer, sink, nullptr);
-  else if (codec) gst_element_link_many(convert, resample, codec, sink, nullptr);
-  else if (muxer) gst_element_link_many(convert, resample, muxer, sink, nullptr);
+  gst_element_link(pooled->src_, pooled->decode_);
+  if (codec && muxer) gst_element_link_many(pooled->convert_, resample, codec, muxer, pooled->sink_, nullptr);
+  else if (codec) gst_element_link_many(pooled->convert_, resample, codec, pooled->sink_, nullptr);
+  else if (muxer) gst_element_link_many(pooled->convert_, resample, muxer, pooled->sink_, nullptr);
+
+  return pooled;
+
+}
+
+void Transcoder::ReturnPooledPipeline(PooledPipelinePtr pooled) {
+
+  // NULL resets every element, and the next job re-triggers typefinding in decodebin when the pipeline goes back to PLAYING with the new location.
+  if (gst_element_set_state(pooled->pipeline_, GST_STATE_NULL) == GST_STATE_CHANGE_FAILURE) return;
+
+  QList<PooledPipelinePtr> &pool = pipeline_pool_[pooled->preset_name_];
+  // More idle pipelines than threads can never be used, let the extra ones be destroyed.
+  if (pool.count() < max_threads()) pool << pooled;
+
+}
+
+bool Transcoder::StartJob(const Job &job) {
+
+  std::shared_ptr<JobState> state = std::make_shared<JobState>(job, this);
+
+  emit LogLine(tr("Starting %1").arg(QDir::toNativeSeparators(job.input)));
+
+  // Reuse a pipeline left over from a finished job with the same preset, or build one on first use.
+  // Only the file locations and the callback data change between jobs, element construction and encoder lookup are skipped entirely on reuse.
+  QList<PooledPipelinePtr> &pool = pipeline_pool_[job.preset.name_];
+  state->pooled_ = pool.isEmpty() ? BuildPipeline(job.preset) : pool.takeLast();
+  if (!state->pooled_) return false;
+
+  state->pipeline_ = state->pooled_->pipeline_;
+  state->convert_element_ = state->pooled_->convert_;
 
   // Set properties
-  g_object_set(src, "location", job.input.toUtf8().constData(), nullptr);
-  g_object_set(sink, "location", job.output.toUtf8().constData(), nullptr);
+  g_object_set(state->pooled_->src_, "location", job.input.toUtf8().constData(), nullptr);
+  g_object_set(state->pooled_->sink_, "location", job.output.toUtf8().constData(), nullptr);
 
   // Set callbacks
-  state->convert_element_ = convert;
-
-  CHECKED_GCONNECT(decode, "pad-added", &NewPadCallback, state.get());
+  state->pooled_->pad_added_cb_id_ = CHECKED_GCONNECT(state->pooled_->decode_, "pad-added", &NewPadCallback, state.get());
   gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(state->pipeline_)), BusCallbackSync, state.get(), nullptr);
 
   // Start the pipeline
@@ -473,7 +524,7 @@ bool Transcoder::StartJob(const Job &job) {
 
 }
 
-Transcoder::JobState::~JobState() {
+Transcoder::PooledPipeline::~PooledPipeline() {
 
   if (pipeline_) {
     gst_element_set_state(pipeline_, GST_STATE_NULL);
@@ -500,10 +551,20 @@ bool Transcoder::event(QEvent *e) {
     QString input = (*it)->job_.input;
     QString output = (*it)->job_.output;
 
+    finished_input_bytes_ += (*it)->job_.input_size;
+
     // Remove event handlers from the gstreamer pipeline, so they don't get called after the pipeline is shutting down
     gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(finished_event->state_->pipeline_)), nullptr, nullptr, nullptr);
+    if ((*it)->pooled_->pad_added_cb_id_ > 0) {
+      g_signal_handler_disconnect((*it)->pooled_->decode_, (*it)->pooled_->pad_added_cb_id_);
+      (*it)->pooled_->pad_added_cb_id_ = 0;
+    }
 
-    // Remove it from the list - this will also destroy the GStreamer pipeline
+    // Keep the pipeline around for the next job with the same preset.
+    // A failed graph might be in an inconsistent state, so only successful ones go back to the pool.
+    if (finished_event->success_) ReturnPooledPipeline((*it)->pooled_);
+
+    // Remove it from the list - this destroys the GStreamer pipeline too unless it was returned to the pool
     current_jobs_.erase(it);  // clazy:exclude=strict-iterators
 
     // Emit the finished signal
@@ -531,6 +592,10 @@ void Transcoder::Cancel() {
 
     // Remove event handlers from the gstreamer pipeline, so they don't get called after the pipeline is shutting down
     gst_bus_set_sync_handler(gst_pipeline_get_bus(GST_PIPELINE(state->pipeline_)), nullptr, nullptr, nullptr);
+    if (state->pooled_->pad_added_cb_id_ > 0) {
+      g_signal_handler_disconnect(state->pooled_->decode_, state->pooled_->pad_added_cb_id_);
+      state->pooled_->pad_added_cb_id_ = 0;
+    }
 
     // Stop the pipeline
     if (gst_element_set_state(state->pipeline_, GST_STATE_NULL) == GST_STATE_CHANGE_ASYNC) {
@@ -542,6 +607,12 @@ void Transcoder::Cancel() {
     it = current_jobs_.erase(it);  // clazy:exclude=strict-iterators
   }
 
+  // Cancelled jobs don't come back, drop the idle pipelines too.
+  pipeline_pool_.clear();
+
+  total_input_bytes_ = 0;
+  finished_input_bytes_ = 0;
+
 }
 
 QMap<QString, float> Transcoder::GetProgress() const {
@@ -557,13 +628,30 @@ QMap<QString, float> Transcoder::GetProgress() const {
     gst_element_query_position(state->pipeline_, GST_FORMAT_TIME, &position);
     gst_element_query_duration(state->pipeline_, GST_FORMAT_TIME, &duration);
 
-    ret[state->job_.input] = static_cast<float>(position) / static_cast<float>(duration);
+    // The duration query can fail right after the pipeline starts.
+    ret[state->job_.input] = duration > 0 ? static_cast<float>(position) / static_cast<float>(duration) : 0.0F;
   }
 
   return ret;
 
 }
 
+float Transcoder::OverallProgress() const {
+
+  if (total_input_bytes_ <= 0) return 0.0F;
+
+  double done_bytes = static_cast<double>(finished_input_bytes_);
+
+  const QMap<QString, float> current_progress = GetProgress();
+  for (const auto &state : current_jobs_) {
+    if (!current_progress.contains(state->job_.input)) continue;
+    done_bytes += static_cast<double>(current_progress[state->job_.input]) * static_cast<double>(state->job_.input_size);
+  }
+
+  return qBound(0.0F, static_cast<float>(done_bytes / static_cast<double>(total_input_bytes_)), 1.0F);
+
+}
+
 void Transcoder::SetElementProperties(const QString &name, GObject *object) {
 
   QSettings s;
@@ -30,6 +30,7 @@
 #include <gst/gst.h>
 
 #include <QObject>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QMetaType>
@@ -68,6 +69,8 @@ class Transcoder : public QObject {
   void AddJob(const QString &input, const TranscoderPreset &preset, const QString &output);
 
   QMap<QString, float> GetProgress() const;
+  // Fraction of the whole batch that is done, weighted by input file size so long files count for what they cost.
+  float OverallProgress() const;
   qint64 QueuedJobsCount() const { return queued_jobs_.count(); }
 
  public slots:
@@ -88,8 +91,24 @@ class Transcoder : public QObject {
     QString input;
     QString output;
     TranscoderPreset preset;
+    qint64 input_size = 0;
   };
 
+  // A fully built and linked pipeline, kept between jobs targeting the same preset.
+  // decodebin rebuilds its decode chain on every NULL -> PLAYING cycle, so the same graph handles any source format; only the file locations change between jobs.
+  struct PooledPipeline {
+    ~PooledPipeline();
+
+    QString preset_name_;
+    GstElement *pipeline_ = nullptr;
+    GstElement *src_ = nullptr;
+    GstElement *decode_ = nullptr;
+    GstElement *convert_ = nullptr;
+    GstElement *sink_ = nullptr;
+    gulong pad_added_cb_id_ = 0;
+  };
+  using PooledPipelinePtr = std::shared_ptr<PooledPipeline>;
+
   // State held by a job and shared across gstreamer callbacks - lives in the job's thread.
   struct JobState {
     explicit JobState(const Job &job, Transcoder *parent)
@@ -97,13 +116,13 @@ class Transcoder : public QObject {
           parent_(parent),
           pipeline_(nullptr),
           convert_element_(nullptr) {}
-    ~JobState();
 
     void PostFinished(const bool success);
     void ReportError(GstMessage *msg) const;
 
     Job job_;
     Transcoder *parent_;
+    PooledPipelinePtr pooled_;
     GstElement *pipeline_;
     GstElement *convert_element_;
    private:
@@ -131,6 +150,8 @@ class Transcoder : public QObject {
 
   StartJobStatus MaybeStartNextJob();
   bool StartJob(const Job &job);
+  PooledPipelinePtr BuildPipeline(const TranscoderPreset &preset);
+  void ReturnPooledPipeline(PooledPipelinePtr pooled);
 
   GstElement *CreateElement(const QString &factory_name, GstElement *bin = nullptr, const QString &name = QString());
   GstElement *CreateElementForMimeType(const QString &element_type, const QString &mime_type, GstElement *bin = nullptr);
@@ -145,6 +166,12 @@ class Transcoder : public QObject {
   int max_threads_;
   QList<Job> queued_jobs_;
   JobStateList current_jobs_;
+  // Idle pipelines from finished jobs, keyed by preset name, reused by the next job with the same preset.
+  QHash<QString, QList<PooledPipelinePtr>> pipeline_pool_;
+  // Best factory per element type and mimetype, so the registry is only scanned once per preset instead of once per job.
+  QHash<QString, QString> best_element_cache_;
+  qint64 total_input_bytes_;
+  qint64 finished_input_bytes_;
   QString settings_postfix_;
 };
 
@@ -19,6 +19,7 @@
  */
 
 #include <memory>
+#include <functional>
 
 #include <QtGlobal>
 
@@ -28,6 +29,13 @@
 #include <QDir>
 #include <QFile>
 
+#ifdef Q_OS_LINUX
+#  include <unistd.h>
+#  include <sys/sendfile.h>
+#  include <cerrno>
+#  include <cstring>
+#endif
+
 #include "core/logging.h"
 
 #include "fileutils.h"
@@ -80,6 +88,94 @@ bool Copy(QIODevice *source, QIODevice *destination) {
 
 }
 
+bool CopyFile(const QString &source, const QString &destination, std::function<void(float)> progress) {
+
+  static const qint64 kCopyBlockSize = 1048576;
+
+  QFile source_file(source);
+  if (!source_file.open(QIODevice::ReadOnly)) {
+    qLog(Error) << "Failed to open file" << source << "for reading:" << source_file.errorString();
+    return false;
+  }
+
+  QFile destination_file(destination);
+  if (destination_file.exists()) return false;
+  if (!destination_file.open(QIODevice::WriteOnly)) {
+    qLog(Error) << "Failed to open file" << destination << "for writing:" << destination_file.errorString();
+    return false;
+  }
+
+  const qint64 bytes_total = source_file.size();
+  qint64 bytes_copied = 0;
+  bool success = true;
+
+#ifdef Q_OS_LINUX
+  // Let the kernel move the data directly between the two files instead of bouncing every block through a userspace buffer.
+  // copy_file_range also enables reflinks and server-side copy on filesystems that support them, sendfile covers the rest.
+  bool kernel_copy = true;
+  while (success && kernel_copy && bytes_copied < bytes_total) {
+    ssize_t result = -1;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+    result = copy_file_range(source_file.handle(), nullptr, destination_file.handle(), nullptr, static_cast<size_t>(bytes_total - bytes_copied), 0);
+    if (result < 0 && bytes_copied == 0 && (errno == EINVAL || errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP)) {
+      result = sendfile(destination_file.handle(), source_file.handle(), nullptr, static_cast<size_t>(bytes_total - bytes_copied));
+    }
+#else
+    result = sendfile(destination_file.handle(), source_file.handle(), nullptr, static_cast<size_t>(bytes_total - bytes_copied));
+#endif
+    if (result > 0) {
+      bytes_copied += result;
+      if (progress && bytes_total > 0) progress(static_cast<float>(bytes_copied) / static_cast<float>(bytes_total));
+    }
+    else if (result == 0) {
+      kernel_copy = false;
+    }
+    else if (bytes_copied == 0 && (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)) {
+      kernel_copy = false;
+    }
+    else {
+      qLog(Error) << "Failed to copy file" << source << "to" << destination << ":" << strerror(errno);
+      success = false;
+    }
+  }
+#endif  // Q_OS_LINUX
+
+  // Buffered copy for platforms and filesystems where the kernel cannot do the copy for us.
+  if (success && bytes_copied < bytes_total) {
+    QByteArray buffer;
+    buffer.resize(static_cast<int>(kCopyBlockSize));
+    while (success) {
+      const qint64 bytes_read = source_file.read(buffer.data(), buffer.size());
+      if (bytes_read < 0) success = false;
+      if (bytes_read <= 0) break;
+      qint64 pos = 0;
+      while (pos < bytes_read) {
+        const qint64 bytes_written = destination_file.write(buffer.constData() + pos, bytes_read - pos);
+        if (bytes_written < 0) {
+          success = false;
+          break;
+        }
+        pos += bytes_written;
+      }
+      bytes_copied += bytes_read;
+      if (progress && bytes_total > 0) progress(static_cast<float>(bytes_copied) / static_cast<float>(bytes_total));
+    }
+    if (!success) {
+      qLog(Error) << "Failed to copy file" << source << "to" << destination << ":" << (source_file.error() != QFile::NoError ? source_file.errorString() : destination_file.errorString());
+    }
+  }
+
+  source_file.close();
+  destination_file.close();
+
+  if (!success) {
+    destination_file.remove();
+  }
+
+  return success;
+
+}
+
 bool CopyRecursive(const QString &source, const QString &destination) {
 
   // Make the destination directory
@@ -21,6 +21,8 @@
 #ifndef FILEUTILS_H
 #define FILEUTILS_H
 
+#include <functional>
+
 #include <QString>
 
 class QIODevice;
@@ -29,6 +31,9 @@ namespace Utilities {
 
 QByteArray ReadDataFromFile(const QString &filename);
 bool Copy(QIODevice *source, QIODevice *destination);
+// Copies a single file, letting the kernel move the data directly between the files where the platform supports it.
+// The progress callback, when given, is called with values between 0.0 and 1.0 as bytes are written.
+bool CopyFile(const QString &source, const QString &destination, std::function<void(float)> progress = nullptr);
 bool CopyRecursive(const QString &source, const QString &destination);
 bool RemoveRecursive(const QString &path);
 
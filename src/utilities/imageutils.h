@@ -34,6 +34,8 @@ class ImageUtils {
   static QStringList kSupportedImageMimeTypes;
   static QStringList kSupportedImageFormats;
 
+  static QImage PreScaleForSmoothTransform(const QImage &image, const QSize size);
+
  public:
   static QStringList SupportedImageMimeTypes();
   static QStringList SupportedImageFormats();
@@ -21,6 +21,7 @@
 
 #include <QWidget>
 #include <QMimeData>
+#include <QTimer>
 #include <QTreeView>
 #include <QAbstractItemModel>
 #include <QAbstractItemView>
@@ -30,17 +31,24 @@
 #include "core/mimedata.h"
 
 const int AutoExpandingTreeView::kRowsToShow = 50;
+const int AutoExpandingTreeView::kNodesToExpandPerTurn = 64;
 
 AutoExpandingTreeView::AutoExpandingTreeView(QWidget *parent)
     : QTreeView(parent),
       auto_open_(false),
       expand_on_reset_(false),
       add_on_double_click_(true),
-      ignore_next_click_(false) {
+      ignore_next_click_(false),
+      expand_timer_(new QTimer(this)),
+      expand_rows_(0) {
 
   setExpandsOnDoubleClick(true);
   setAnimated(true);
 
+  expand_timer_->setSingleShot(true);
+  expand_timer_->setInterval(0);
+
+  QObject::connect(expand_timer_, &QTimer::timeout, this, &AutoExpandingTreeView::ProcessExpandQueue);
   QObject::connect(this, &AutoExpandingTreeView::expanded, this, &AutoExpandingTreeView::ItemExpanded);
   QObject::connect(this, &AutoExpandingTreeView::clicked, this, &AutoExpandingTreeView::ItemClicked);
   QObject::connect(this, &AutoExpandingTreeView::doubleClicked, this, &AutoExpandingTreeView::ItemDoubleClicked);
@@ -50,6 +58,9 @@ AutoExpandingTreeView::AutoExpandingTreeView(QWidget *parent)
 void AutoExpandingTreeView::reset() {
   QTreeView::reset();
 
+  expand_timer_->stop();
+  expand_queue_.clear();
+
   // Expand nodes in the tree until we have about 50 rows visible in the view
   if (auto_open_ && expand_on_reset_) {
     RecursivelyExpandSlot(rootIndex());
@@ -57,35 +68,61 @@ void AutoExpandingTreeView::reset() {
 }
 
 void AutoExpandingTreeView::RecursivelyExpandSlot(const QModelIndex &idx) {
-  int rows = model()->rowCount(idx);
-  RecursivelyExpand(idx, &rows);
+
+  expand_queue_.clear();
+  expand_queue_ << QPersistentModelIndex(idx);
+  expand_rows_ = model()->rowCount(idx);
+  ProcessExpandQueue();
+
 }
 
-bool AutoExpandingTreeView::RecursivelyExpand(const QModelIndex &idx, int *count) {
+void AutoExpandingTreeView::ProcessExpandQueue() {
 
-  if (!CanRecursivelyExpand(idx)) {
-    return true;
-  }
+  // Expanding a container lazily populates it, which can be expensive for large subtrees,
+  // so only expand a limited number of nodes per event-loop turn and reschedule the rest.
+  // Subtrees currently visible in the viewport are expanded first so the rows the user is looking at fill in before the off-screen ones.
 
-  if (model()->canFetchMore(idx)) {
-    model()->fetchMore(idx);
-  }
+  const QRect visible_rect = viewport()->rect();
+  int budget = kNodesToExpandPerTurn;
 
-  int children = model()->rowCount(idx);
-  if (*count + children > kRowsToShow) {
-    return false;
-  }
+  while (!expand_queue_.isEmpty() && budget > 0) {
+
+    int pos = 0;
+    for (int i = 0; i < expand_queue_.count(); ++i) {
+      if (visible_rect.intersects(visualRect(expand_queue_.value(i)))) {
+        pos = i;
+        break;
+      }
+    }
+
+    const QPersistentModelIndex idx = expand_queue_.takeAt(pos);
+    if (!idx.isValid()) continue;
 
-  expand(idx);
-  *count += children;
+    if (!CanRecursivelyExpand(idx)) continue;
 
-  for (int i = 0; i < children; ++i) {
-    if (!RecursivelyExpand(model()->index(i, 0, idx), count)) {
-      return false;
+    if (model()->canFetchMore(idx)) {
+      model()->fetchMore(idx);
     }
+
+    const int children = model()->rowCount(idx);
+    if (expand_rows_ + children > kRowsToShow) {
+      expand_queue_.clear();
+      return;
+    }
+
+    expand(idx);
+    expand_rows_ += children;
+    --budget;
+
+    for (int i = 0; i < children; ++i) {
+      expand_queue_ << QPersistentModelIndex(model()->index(i, 0, idx));
+    }
+
   }
 
-  return true;
+  if (!expand_queue_.isEmpty()) {
+    expand_timer_->start();
+  }
 
 }
 
@@ -24,7 +24,9 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QList>
 #include <QString>
+#include <QPersistentModelIndex>
 #include <QTreeView>
 
 class QMimeData;
@@ -32,6 +34,7 @@ class QWidget;
 class QModelIndex;
 class QKeyEvent;
 class QMouseEvent;
+class QTimer;
 
 class AutoExpandingTreeView : public QTreeView {
   Q_OBJECT
@@ -40,6 +43,7 @@ class AutoExpandingTreeView : public QTreeView {
   explicit AutoExpandingTreeView(QWidget *parent = nullptr);
 
   static const int kRowsToShow;
+  static const int kNodesToExpandPerTurn;
 
   void SetAutoOpen(bool v) { auto_open_ = v; }
   void SetExpandOnReset(bool v) { expand_on_reset_ = v; }
@@ -69,15 +73,17 @@ class AutoExpandingTreeView : public QTreeView {
   void ItemExpanded(const QModelIndex &idx);
   void ItemClicked(const QModelIndex &idx);
   void ItemDoubleClicked(const QModelIndex &idx);
-
- private:
-  bool RecursivelyExpand(const QModelIndex &idx, int *count);
+  void ProcessExpandQueue();
 
  private:
   bool auto_open_;
   bool expand_on_reset_;
   bool add_on_double_click_;
   bool ignore_next_click_;
+
+  QTimer *expand_timer_;
+  QList<QPersistentModelIndex> expand_queue_;
+  int expand_rows_;
 };
 
 #endif  // AUTOEXPANDINGTREEVIEW_H
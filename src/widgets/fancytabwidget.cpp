@@ -277,68 +277,84 @@ class FancyTabBar : public QTabBar {  // clazy:exclude=missing-qobject-macro
       {
         p.save();
         QTransform m;
-        int textFlags = 0;
-        Qt::Alignment iconFlags;
-
-        QRect tabrectText;
-        QRect tabrectLabel;
-
         if (verticalTextTabs) {
           m = QTransform::fromTranslate(tabrect.left(), tabrect.bottom());
           m.rotate(-90);
-          textFlags = Qt::AlignVCenter;
-          iconFlags = Qt::AlignVCenter;
-
-          tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
-
-          tabrectText = tabrectLabel;
-          tabrectText.translate(tabWidget->iconsize_smallsidebar() + 8, 0);
         }
         else {
           m = QTransform::fromTranslate(tabrect.left(), tabrect.top());
-          textFlags = Qt::AlignHCenter | Qt::AlignBottom | Qt::TextWordWrap;
-          iconFlags = Qt::AlignHCenter | Qt::AlignTop;
+        }
 
-          tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
+        const QRect tabrectLabel = QRect(QPoint(0, 0), m.mapRect(tabrect).size());
+
+        // The label layer (word-wrapped or rotated text plus the icon) is the expensive part of a repaint,
+        // so it is rasterized once and composited from the cache on subsequent repaints - hover and selection
+        // highlights are plain fills drawn directly above.
+        // The key changes with size, icon, device pixel ratio, font and palette, so a style or DPI change renders fresh pixmaps.
+        const qreal pixel_ratio = devicePixelRatioF();
+        const QString cache_key = QString::asprintf("fancytab %d %d %d %d %d %d %llx %x ", tabrectLabel.width(), tabrectLabel.height(), QTabBar::width(), selected ? 1 : 0, verticalTextTabs ? 1 : 0, static_cast<int>(pixel_ratio * 100), static_cast<qulonglong>(tabIcon(index).cacheKey()), StyleHelper::panelTextColor().rgb()) + font().key() + " " + tabText(index);
+
+        QPixmap label_pixmap;
+        if (!QPixmapCache::find(cache_key, &label_pixmap)) {
+
+          label_pixmap = QPixmap(tabrectLabel.size() * pixel_ratio);
+          label_pixmap.setDevicePixelRatio(pixel_ratio);
+          label_pixmap.fill(Qt::transparent);
+          QPainter lp(&label_pixmap);
+
+          int textFlags = 0;
+          Qt::Alignment iconFlags;
+          QRect tabrectText = tabrectLabel;
+          if (verticalTextTabs) {
+            textFlags = Qt::AlignVCenter;
+            iconFlags = Qt::AlignVCenter;
+            tabrectText.translate(tabWidget->iconsize_smallsidebar() + 8, 0);
+          }
+          else {
+            textFlags = Qt::AlignHCenter | Qt::AlignBottom | Qt::TextWordWrap;
+            iconFlags = Qt::AlignHCenter | Qt::AlignTop;
+            tabrectText.translate(0, -5);
+          }
+
+          QFont boldFont(font());
+          boldFont.setBold(true);
+          lp.setFont(boldFont);
+
+          // Text drop shadow color
+          lp.setPen(selected ? QColor(255, 255, 255, 160) : QColor(0, 0, 0, 110));
+          lp.translate(0, 3);
+          lp.drawText(tabrectText, textFlags, tabText(index));
+
+          // Text foreground color
+          lp.translate(0, -1);
+          lp.setPen(selected ? QColor(60, 60, 60) : StyleHelper::panelTextColor());
+          lp.drawText(tabrectText, textFlags, tabText(index));
+
+          // Draw the icon
+          QRect tabrectIcon;
+          if (verticalTextTabs) {
+            tabrectIcon = tabrectLabel;
+            tabrectIcon.setSize(QSize(tabWidget->iconsize_smallsidebar(), tabWidget->iconsize_smallsidebar()));
+            // Center the icon
+            const int moveRight = (QTabBar::width() - tabWidget->iconsize_smallsidebar()) / 2;
+            tabrectIcon.translate(5, moveRight);
+          }
+          else {
+            tabrectIcon = tabrectLabel;
+            tabrectIcon.setSize(QSize(tabWidget->iconsize_largesidebar(), tabWidget->iconsize_largesidebar()));
+            // Center the icon
+            const int moveRight = (QTabBar::width() - tabWidget->iconsize_largesidebar() - 1) / 2;
+            tabrectIcon.translate(moveRight, 5);
+          }
+          tabIcon(index).paint(&lp, tabrectIcon, iconFlags);
+
+          lp.end();
+          QPixmapCache::insert(cache_key, label_pixmap);
 
-          tabrectText = tabrectLabel;
-          tabrectText.translate(0, -5);
         }
 
         p.setTransform(m);
-
-        QFont boldFont(p.font());
-        boldFont.setBold(true);
-        p.setFont(boldFont);
-
-        // Text drop shadow color
-        p.setPen(selected ? QColor(255, 255, 255, 160) : QColor(0, 0, 0, 110));
-        p.translate(0, 3);
-        p.drawText(tabrectText, textFlags, tabText(index));
-
-        // Text foreground color
-        p.translate(0, -1);
-        p.setPen(selected ? QColor(60, 60, 60) : StyleHelper::panelTextColor());
-        p.drawText(tabrectText, textFlags, tabText(index));
-
-
-        // Draw the icon
-        QRect tabrectIcon;
-        if (verticalTextTabs) {
-          tabrectIcon = tabrectLabel;
-          tabrectIcon.setSize(QSize(tabWidget->iconsize_smallsidebar(), tabWidget->iconsize_smallsidebar()));
-          // Center the icon
-          const int moveRight = (QTabBar::width() - tabWidget->iconsize_smallsidebar()) / 2;
-          tabrectIcon.translate(5, moveRight);
-        }
-        else {
-          tabrectIcon = tabrectLabel;
-          tabrectIcon.setSize(QSize(tabWidget->iconsize_largesidebar(), tabWidget->iconsize_largesidebar()));
-          // Center the icon
-          const int moveRight = (QTabBar::width() - tabWidget->iconsize_largesidebar() - 1) / 2;
-          tabrectIcon.translate(moveRight, 5);
-        }
-        tabIcon(index).paint(&p, tabrectIcon, iconFlags);
+        p.drawPixmap(0, 0, label_pixmap);
         p.restore();
       }
     }
@@ -348,9 +364,10 @@ class FancyTabBar : public QTabBar {  // clazy:exclude=missing-qobject-macro
 
 class TabData : public QObject {  // clazy:exclude=missing-qobject-macro
  public:
-  TabData(QWidget *widget_view, const QString &name, const QIcon &icon, const QString &label, const int idx, QWidget *parent)
+  TabData(QWidget *widget_view, FancyTabWidget::WidgetFactory factory, const QString &name, const QIcon &icon, const QString &label, const int idx, QWidget *parent)
       : QObject(parent),
         widget_view_(widget_view),
+        factory_(factory),
         name_(name), icon_(icon),
         label_(label),
         index_(idx),
@@ -359,10 +376,20 @@ class TabData : public QObject {  // clazy:exclude=missing-qobject-macro
     QVBoxLayout *layout = new QVBoxLayout(page_);
     layout->setSpacing(0);
     layout->setContentsMargins(0, 0, 0, 0);
-    layout->addWidget(widget_view_);
+    if (widget_view_) layout->addWidget(widget_view_);
     page_->setLayout(layout);
   }
 
+  // Creates the view of a lazy tab the first time the tab is shown.
+  QWidget *EnsureWidgetCreated() {
+    if (!widget_view_ && factory_) {
+      widget_view_ = factory_();
+      // The view goes above the bottom widget, which may already be on this page.
+      qobject_cast<QVBoxLayout*>(page_->layout())->insertWidget(0, widget_view_);
+    }
+    return widget_view_;
+  }
+
   QWidget *widget_view() const { return widget_view_; }
   QString name() const { return name_; }
   QIcon icon() const { return icon_; }
@@ -372,6 +399,7 @@ class TabData : public QObject {  // clazy:exclude=missing-qobject-macro
 
  private:
   QWidget *widget_view_;
+  FancyTabWidget::WidgetFactory factory_;
   QString name_;
   QIcon icon_;
   QString label_;
@@ -403,6 +431,7 @@ void FancyTabWidget::setCurrentIndex(int idx) {
   if (idx >= count() || idx < 0) idx = 0;
 
   QWidget *currentPage = widget(idx);
+  EnsurePageWidgetCreated(currentPage);
   QLayout *layout = currentPage->layout();
   if (bottom_widget_) layout->addWidget(bottom_widget_);
   QTabWidget::setCurrentIndex(idx);
@@ -412,12 +441,25 @@ void FancyTabWidget::setCurrentIndex(int idx) {
 void FancyTabWidget::currentTabChanged(const int idx) {
 
   QWidget *currentPage = currentWidget();
+  EnsurePageWidgetCreated(currentPage);
   QLayout *layout = currentPage->layout();
   if (bottom_widget_) layout->addWidget(bottom_widget_);
   emit CurrentChanged(idx);
 
 }
 
+// Lazy tabs start out as an empty page, the view is created the first time the page is shown.
+void FancyTabWidget::EnsurePageWidgetCreated(QWidget *page) {
+
+  for (TabData *tab : std::as_const(tabs_)) {
+    if (tab->page() == page) {
+      tab->EnsureWidgetCreated();
+      return;
+    }
+  }
+
+}
+
 // Override QStyle::subElementRect() and use QCommonStyle to fix a problem with the adwaita style.
 // The adwaita style is causing the contents of the tabbar to be stretched from top to bottom with space between icons and text.
 // You can see this on the default Fedora (Gnome) installation.
@@ -556,15 +598,22 @@ void FancyTabWidget::addBottomWidget(QWidget *widget_view) {
 
 void FancyTabWidget::AddTab(QWidget *widget_view, const QString &name, const QIcon &icon, const QString &label) {
 
-  TabData *tab = new TabData(widget_view, name, icon, label, static_cast<int>(tabs_.count()), this);
-  tabs_.insert(widget_view, tab);
+  TabData *tab = new TabData(widget_view, WidgetFactory(), name, icon, label, static_cast<int>(tabs_.count()), this);
+  tabs_.insert(name, tab);
+
+}
+
+void FancyTabWidget::AddLazyTab(WidgetFactory factory, const QString &name, const QIcon &icon, const QString &label) {
+
+  TabData *tab = new TabData(nullptr, factory, name, icon, label, static_cast<int>(tabs_.count()), this);
+  tabs_.insert(name, tab);
 
 }
 
-bool FancyTabWidget::EnableTab(QWidget *widget_view) {
+bool FancyTabWidget::EnableTab(const QString &name) {
 
-  if (!tabs_.contains(widget_view)) return false;
-  TabData *tab = tabs_.value(widget_view);
+  if (!tabs_.contains(name)) return false;
+  TabData *tab = tabs_.value(name);
 
   if (QTabWidget::indexOf(tab->page()) >= 0) return true;
   const int idx = QTabWidget::insertTab(count(), tab->page(), tab->icon(), tab->label());
@@ -574,10 +623,10 @@ bool FancyTabWidget::EnableTab(QWidget *widget_view) {
 
 }
 
-bool FancyTabWidget::DisableTab(QWidget *widget_view) {
+bool FancyTabWidget::DisableTab(const QString &name) {
 
-  if (!tabs_.contains(widget_view)) return false;
-  TabData *tab = tabs_.value(widget_view);
+  if (!tabs_.contains(name)) return false;
+  TabData *tab = tabs_.value(name);
 
   int idx = QTabWidget::indexOf(tab->page());
   if (idx < 0) return false;
@@ -588,9 +637,9 @@ bool FancyTabWidget::DisableTab(QWidget *widget_view) {
 
 }
 
-int FancyTabWidget::IndexOfTab(QWidget *widget) {
-  if (!tabs_.contains(widget)) return -1;
-  return QTabWidget::indexOf(tabs_[widget]->page());
+int FancyTabWidget::IndexOfTab(const QString &name) {
+  if (!tabs_.contains(name)) return -1;
+  return QTabWidget::indexOf(tabs_.value(name)->page());
 }
 
 void FancyTabWidget::paintEvent(QPaintEvent *pe) {
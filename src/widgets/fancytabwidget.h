@@ -22,6 +22,8 @@
 #ifndef FANCYTABWIDGET_H
 #define FANCYTABWIDGET_H
 
+#include <functional>
+
 #include <QObject>
 #include <QTabWidget>
 #include <QHash>
@@ -45,12 +47,16 @@ class FancyTabWidget : public QTabWidget {
   explicit FancyTabWidget(QWidget *parent = nullptr);
   ~FancyTabWidget() override;
 
+  using WidgetFactory = std::function<QWidget*()>;
+
   void AddTab(QWidget *widget_view, const QString &name, const QIcon &icon, const QString &label);
-  bool EnableTab(QWidget *widget_view);
-  bool DisableTab(QWidget *widget_view);
+  // Adds a tab whose view is created by the factory the first time the tab is shown, so views the user never opens are never built.
+  void AddLazyTab(WidgetFactory factory, const QString &name, const QIcon &icon, const QString &label);
+  bool EnableTab(const QString &name);
+  bool DisableTab(const QString &name);
   int insertTab(const int idx, QWidget *page, const QIcon &icon, const QString &label);
   void addBottomWidget(QWidget *widget_view);
-  int IndexOfTab(QWidget *widget);
+  int IndexOfTab(const QString &name);
 
   void setBackgroundPixmap(const QPixmap &pixmap);
   void addSpacer();
@@ -97,6 +103,7 @@ class FancyTabWidget : public QTabWidget {
 
  private:
   void addMenuItem(QActionGroup *group, const QString &text, Mode mode);
+  void EnsurePageWidgetCreated(QWidget *page);
 
   QProxyStyle *style_;
   QPixmap background_pixmap_;
@@ -104,7 +111,7 @@ class FancyTabWidget : public QTabWidget {
   Mode mode_;
   QWidget *bottom_widget_;
 
-  QHash<QWidget*, TabData*> tabs_;
+  QHash<QString, TabData*> tabs_;
 
   bool bg_color_system_;
   bool bg_gradient_;
@@ -56,7 +56,9 @@ GroupedIconView::GroupedIconView(QWidget *parent)
       header_spacing_(10),
       header_indent_(5),
       item_indent_(10),
-      header_text_("%1") {
+      header_text_("%1"),
+      layout_max_row_height_(0),
+      layout_width_(-1) {
 
   setFlow(LeftToRight);
   setViewMode(IconMode);
@@ -120,13 +122,32 @@ void GroupedIconView::DrawHeader(QPainter *painter, const QRect rect, const QFon
 }
 
 void GroupedIconView::resizeEvent(QResizeEvent *e) {
+
   QListView::resizeEvent(e);
+
+  // Only a width change moves the wrap points - a height change just needs the scrollbar range refreshed.
+  if (viewport()->width() == layout_width_) {
+    verticalScrollBar()->setRange(0, layout_next_position_.y() + layout_max_row_height_ - viewport()->height());
+    return;
+  }
+
   LayoutItems();
+
 }
 
 void GroupedIconView::rowsInserted(const QModelIndex &parent, int start, int end) {
+
   QListView::rowsInserted(parent, start, end);
-  LayoutItems();
+
+  // Rows appended at the end - the common case when search results arrive in batches - only need themselves positioned.
+  // An insert in the middle shifts everything after it, so that still relays out from scratch.
+  if (start == visual_rects_.count()) {
+    LayoutItems(start);
+  }
+  else {
+    LayoutItems();
+  }
+
 }
 
 void GroupedIconView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int>&) {
@@ -135,6 +156,10 @@ void GroupedIconView::dataChanged(const QModelIndex &topLeft, const QModelIndex
 }
 
 void GroupedIconView::LayoutItems() {
+  LayoutItems(0);
+}
+
+void GroupedIconView::LayoutItems(const int start_row) {
 
   if (!model()) {
     return;
@@ -142,15 +167,23 @@ void GroupedIconView::LayoutItems() {
 
   const int count = model()->rowCount();
 
-  QString last_group;
-  QPoint next_position(0, 0);
-  int max_row_height = 0;
+  if (start_row == 0) {
+    layout_last_group_ = QString();
+    layout_next_position_ = QPoint(0, 0);
+    layout_max_row_height_ = 0;
+    visual_rects_.clear();
+    headers_.clear();
+  }
+
+  layout_width_ = viewport()->width();
+
+  QString last_group = layout_last_group_;
+  QPoint next_position(layout_next_position_);
+  int max_row_height = layout_max_row_height_;
 
-  visual_rects_.clear();
   visual_rects_.reserve(count);
-  headers_.clear();
 
-  for (int i = 0; i < count; ++i) {
+  for (int i = start_row; i < count; ++i) {
     const QModelIndex idx(model()->index(i, 0));
     const QString group = idx.data(Role_Group).toString();
     const QSize size(rectForIndex(idx).size());
@@ -205,6 +238,10 @@ void GroupedIconView::LayoutItems() {
     max_row_height = qMax(max_row_height, size.height());
   }
 
+  layout_last_group_ = last_group;
+  layout_next_position_ = next_position;
+  layout_max_row_height_ = max_row_height;
+
   verticalScrollBar()->setRange(0, next_position.y() + max_row_height - viewport()->height());
   update();
 
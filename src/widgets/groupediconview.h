@@ -99,6 +99,11 @@ class GroupedIconView : public QListView {
  private slots:
   void LayoutItems();
 
+ private:
+  // Lays out rows from start_row to the end, resuming from the cursor state saved after the previous layout.
+  // Passing 0 relays out everything; passing the old row count positions just the appended rows.
+  void LayoutItems(const int start_row);
+
  private:
   static const int kBarThickness;
   static const int kBarMarginTop;
@@ -119,6 +124,13 @@ class GroupedIconView : public QListView {
   QVector<QRect> visual_rects_;
   QVector<Header> headers_;
 
+  // Layout cursor state after the last laid-out row, so appended rows can be positioned without repositioning every row,
+  // plus the viewport width the layout was computed for - only a width change moves the wrap points.
+  QString layout_last_group_;
+  QPoint layout_next_position_;
+  int layout_max_row_height_;
+  int layout_width_;
+
   const int default_header_height_;
   int header_spacing_;
   int header_indent_;
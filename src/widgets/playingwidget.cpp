@@ -22,6 +22,9 @@
 #include <memory>
 
 #include <QtGlobal>
+#include <QtConcurrent>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QWidget>
 #include <QList>
 #include <QByteArray>
@@ -79,7 +82,8 @@ PlayingWidget::PlayingWidget(QWidget *parent)
       timeline_fade_(new QTimeLine(1000, this)),
       details_(new QTextDocument(this)),
       pixmap_previous_track_opacity_(0.0),
-      downloading_covers_(false) {
+      downloading_covers_(false),
+      scale_cover_id_(0) {
 
   SetHeight(0);
 
@@ -108,6 +112,8 @@ PlayingWidget::PlayingWidget(QWidget *parent)
 
   // Animations
   QObject::connect(timeline_show_hide_, &QTimeLine::frameChanged, this, &PlayingWidget::SetHeight);
+  // The text below the cover is skipped while the show/hide animation runs, render the full contents again once it stops.
+  QObject::connect(timeline_show_hide_, &QTimeLine::finished, this, [this]() { pixmap_contents_ = QPixmap(); update(); });
   QObject::connect(timeline_fade_, &QTimeLine::valueChanged, this, &PlayingWidget::FadePreviousTrack);
   timeline_fade_->setDirection(QTimeLine::Backward);  // 1.0 -> 0.0
 
@@ -340,16 +346,29 @@ void PlayingWidget::SetImage(const QImage &image) {
 
 void PlayingWidget::ScaleCover() {
 
-  QImage image = ImageUtils::ScaleAndPad(image_original_, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
-  if (image.isNull()) pixmap_cover_ = QPixmap();
-  else pixmap_cover_ = QPixmap::fromImage(image);
-  update();
+  // Scaling a full size cover takes long enough to be felt as a hiccup right at the track change,
+  // so it runs on a worker thread while the fade animation already blits the previous contents.
+  // The id guards against an older scale finishing after a newer one.
+  const quint64 id = ++scale_cover_id_;
+  QFuture<QImage> future = QtConcurrent::run(&ImageUtils::ScaleAndPad, image_original_, cover_loader_options_.scale_output_image_, cover_loader_options_.pad_output_image_, cover_loader_options_.desired_height_, devicePixelRatioF());
+  QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>();
+  QObject::connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, id]() {
+    QImage image = watcher->result();
+    watcher->deleteLater();
+    if (id != scale_cover_id_) return;
+    if (image.isNull()) pixmap_cover_ = QPixmap();
+    else pixmap_cover_ = QPixmap::fromImage(image);
+    pixmap_contents_ = QPixmap();
+    update();
+  });
+  watcher->setFuture(future);
 
 }
 
 void PlayingWidget::SetHeight(int height) {
 
   setMaximumHeight(height);
+  pixmap_contents_ = QPixmap();
   update();
 
   if (height >= total_height_ - 5) visible_ = true;
@@ -419,6 +438,7 @@ void PlayingWidget::UpdateDetailsText() {
   // if something spans multiple lines the height needs to change
   if (mode_ == Mode::LargeSongDetails) UpdateHeight();
 
+  pixmap_contents_ = QPixmap();
   update();
 
 }
@@ -429,7 +449,25 @@ void PlayingWidget::paintEvent(QPaintEvent *e) {
 
   QPainter p(this);
 
-  DrawContents(&p);
+  // The fade repaints on every animation tick, so the current contents are rendered once into
+  // a pixmap and each tick composites two blits.
+  // The spinner advances every frame, caching would freeze it, so it paints directly.
+  if (downloading_covers_ || size().isEmpty()) {
+    pixmap_contents_ = QPixmap();
+    DrawContents(&p);
+  }
+  else {
+    if (pixmap_contents_.isNull()) {
+      const qreal pixel_ratio = devicePixelRatioF();
+      pixmap_contents_ = QPixmap(size() * pixel_ratio);
+      pixmap_contents_.setDevicePixelRatio(pixel_ratio);
+      pixmap_contents_.fill(Qt::transparent);
+      QPainter contents_painter(&pixmap_contents_);
+      DrawContents(&contents_painter);
+      contents_painter.end();
+    }
+    p.drawPixmap(0, 0, pixmap_contents_);
+  }
 
   // Draw the previous track's image if we're fading
   if (!pixmap_previous_track_.isNull()) {
@@ -498,6 +536,7 @@ void PlayingWidget::resizeEvent(QResizeEvent *e) {
 
   //if (visible_ && e->oldSize() != e->size()) {
   if (e->oldSize() != e->size()) {
+    pixmap_contents_ = QPixmap();
     if (mode_ == Mode::LargeSongDetails) {
       UpdateHeight();
       UpdateDetailsText();
@@ -137,7 +137,10 @@ class PlayingWidget : public QWidget {
   QImage image_current_;
   QImage image_original_;
   QPixmap pixmap_cover_;
+  // The widget contents rendered once, so fade animation ticks are blits instead of full redraws.
+  QPixmap pixmap_contents_;
   QPixmap pixmap_previous_track_;
+  quint64 scale_cover_id_;
   std::unique_ptr<QMovie> spinner_animation_;
 
   void SetVisible(const bool visible);
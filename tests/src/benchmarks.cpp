@@ -0,0 +1,285 @@
+/*
+ * Strawberry Music Player
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Micro benchmarks for the collection scan/query/model hot paths.
+//
+// Every benchmark runs against synthetic fixtures generated from a fixed seed, so numbers are comparable between runs and commits.
+// Results are printed as a JSON array (one object per benchmark with iteration counts and per-iteration times), suitable for collecting across commits:
+//
+//   strawberry_benchmarks [--output results.json]
+//
+// This binary is intentionally not part of the test targets, build it explicitly with `make strawberry_benchmarks`.
+
+#include <functional>
+#include <memory>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QModelIndex>
+#include <QRandomGenerator>
+#include <QScopedPointer>
+#include <QSet>
+#include <QStandardItemModel>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QUrl>
+#include <QtDebug>
+
+#include "core/database.h"
+#include "core/song.h"
+#include "collection/collection.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionmodel.h"
+#include "playlist/playlist.h"
+#include "playlist/playlistfilterparser.h"
+#include "utilities/imageutils.h"
+
+namespace {
+
+// Fixed seed so every run generates identical fixtures.
+const quint32 kFixtureSeed = 0x5743414e;
+
+const int kBackendSongCount = 5000;
+const int kModelSongCount = 5000;
+const int kFilterRowCount = 50000;
+const int kCoverSourceSize = 1200;
+const int kCoverDesiredHeight = 300;
+
+struct BenchmarkResult {
+  QString name;
+  int iterations;
+  int items;
+  qint64 total_nsecs;
+};
+
+QList<BenchmarkResult> sResults;
+
+void RunBenchmark(const QString &name, const int iterations, const int items, const std::function<void()> &func) {
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < iterations; ++i) {
+    func();
+  }
+
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.items = items;
+  result.total_nsecs = timer.nsecsElapsed();
+  sResults << result;
+
+  qDebug() << name << ":" << iterations << "iteration(s)," << (static_cast<double>(result.total_nsecs) / 1e6 / iterations) << "ms/iteration";
+
+}
+
+// Deterministic pseudo-random song metadata spread over a realistic number of artists and albums.
+SongList GenerateSongs(const int count, QRandomGenerator *random) {
+
+  SongList songs;
+  songs.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    const int artist = static_cast<int>(random->bounded(count / 50 + 1));
+    const int album = static_cast<int>(random->bounded(10));
+    Song song;
+    song.Init(QString("Title %1").arg(i), QString("Artist %1").arg(artist), QString("Album %1 %2").arg(artist).arg(album), 120 + static_cast<int>(random->bounded(200)));
+    song.set_directory_id(1);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_url(QUrl(QString("file:///music/%1/%2/%3.flac").arg(artist).arg(album).arg(i)));
+    song.set_filesize(1);
+    song.set_year(1960 + static_cast<int>(random->bounded(60)));
+    song.set_track(i % 12 + 1);
+    song.set_genre(QString("Genre %1").arg(random->bounded(20)));
+    songs << song;
+  }
+
+  return songs;
+
+}
+
+// Walks the whole model forcing lazy population, the way expanding every node in the collection view would.
+void PopulateRecursively(CollectionModel *model, const QModelIndex &parent) {
+
+  if (model->canFetchMore(parent)) model->fetchMore(parent);
+  const int rows = model->rowCount(parent);
+  for (int i = 0; i < rows; ++i) {
+    PopulateRecursively(model, model->index(i, 0, parent));
+  }
+
+}
+
+void BenchmarkCollectionBackend() {
+
+  QRandomGenerator random(kFixtureSeed);
+  const SongList songs = GenerateSongs(kBackendSongCount, &random);
+
+  auto database = std::make_shared<MemoryDatabase>(nullptr);
+  auto backend = std::make_unique<CollectionBackend>();
+  backend->Init(database.get(), nullptr, Song::Source::Collection, SCollection::kSongsTable, SCollection::kFtsTable, SCollection::kDirsTable, SCollection::kSubdirsTable);
+  backend->AddDirectory("/music");
+
+  // One big batch, the shape CollectionWatcher::ScanSubdirectory produces when ingesting a scanned directory.
+  RunBenchmark("collectionbackend_add_or_update_songs", 1, kBackendSongCount, [&]() { backend->AddOrUpdateSongs(songs); });
+
+  // Updating the same songs again exercises the compare-and-skip path of an unchanged rescan.
+  RunBenchmark("collectionbackend_update_unchanged_songs", 1, kBackendSongCount, [&]() { backend->AddOrUpdateSongs(songs); });
+
+}
+
+void BenchmarkCollectionModel() {
+
+  QRandomGenerator random(kFixtureSeed);
+  const SongList songs = GenerateSongs(kModelSongCount, &random);
+
+  auto database = std::make_shared<MemoryDatabase>(nullptr);
+  auto backend = std::make_unique<CollectionBackend>();
+  backend->Init(database.get(), nullptr, Song::Source::Collection, SCollection::kSongsTable, SCollection::kFtsTable, SCollection::kDirsTable, SCollection::kSubdirsTable);
+  backend->AddDirectory("/music");
+  backend->AddOrUpdateSongs(songs);
+
+  auto model = std::make_unique<CollectionModel>(backend.get(), nullptr);
+  model->Init(false);
+
+  RunBenchmark("collectionmodel_reset_and_populate", 5, kModelSongCount, [&]() {
+    model->Reset();
+    PopulateRecursively(model.get(), QModelIndex());
+  });
+
+}
+
+void BenchmarkPlaylistFilter() {
+
+  QRandomGenerator random(kFixtureSeed);
+
+  // The same column layout PlaylistFilter feeds to the parser.
+  QMap<QString, int> columns;
+  columns["title"] = Playlist::Column_Title;
+  columns["artist"] = Playlist::Column_Artist;
+  columns["album"] = Playlist::Column_Album;
+  columns["year"] = Playlist::Column_Year;
+  columns["genre"] = Playlist::Column_Genre;
+  QSet<int> numerical_columns;
+  numerical_columns << Playlist::Column_Year;
+
+  QStandardItemModel model;
+  model.setColumnCount(Playlist::ColumnCount);
+  model.setRowCount(kFilterRowCount);
+  for (int i = 0; i < kFilterRowCount; ++i) {
+    model.setData(model.index(i, Playlist::Column_Title), QString("Title %1").arg(i));
+    model.setData(model.index(i, Playlist::Column_Artist), QString("Artist %1").arg(random.bounded(1000)));
+    model.setData(model.index(i, Playlist::Column_Album), QString("Album %1").arg(random.bounded(2000)));
+    model.setData(model.index(i, Playlist::Column_Year), 1960 + static_cast<int>(random.bounded(60)));
+    model.setData(model.index(i, Playlist::Column_Genre), QString("Genre %1").arg(random.bounded(20)));
+  }
+
+  const QStringList filters = QStringList() << "artist:\"Artist 1\""
+                                            << "year:>2000 artist:5"
+                                            << "title OR genre:7"
+                                            << "-artist:99 year:<=1980";
+
+  for (const QString &filter : filters) {
+    FilterParser parser(filter, columns, numerical_columns);
+    QScopedPointer<FilterTree> tree(parser.parse());
+    RunBenchmark(QString("playlistfilter_match [%1]").arg(filter), 1, kFilterRowCount, [&]() {
+      int matched = 0;
+      for (int i = 0; i < kFilterRowCount; ++i) {
+        if (tree->accept(i, QModelIndex(), &model)) ++matched;
+      }
+      Q_UNUSED(matched);
+    });
+  }
+
+}
+
+void BenchmarkCoverScaling() {
+
+  QImage image(kCoverSourceSize, kCoverSourceSize, QImage::Format_RGB32);
+  for (int y = 0; y < image.height(); ++y) {
+    for (int x = 0; x < image.width(); ++x) {
+      image.setPixel(x, y, qRgb(x & 0xff, y & 0xff, (x + y) & 0xff));
+    }
+  }
+
+  RunBenchmark("albumcover_scale_and_pad", 50, 1, [&]() {
+    const QImage scaled = ImageUtils::ScaleAndPad(image, true, true, kCoverDesiredHeight);
+    Q_UNUSED(scaled);
+  });
+
+}
+
+QJsonDocument ResultsToJson() {
+
+  QJsonArray array;
+  for (const BenchmarkResult &result : sResults) {
+    QJsonObject object;
+    object["name"] = result.name;
+    object["iterations"] = result.iterations;
+    object["items"] = result.items;
+    object["total_ms"] = static_cast<double>(result.total_nsecs) / 1e6;
+    object["ms_per_iteration"] = static_cast<double>(result.total_nsecs) / 1e6 / result.iterations;
+    array << object;
+  }
+
+  return QJsonDocument(array);
+
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+
+  QApplication a(argc, argv);
+
+  QString output_filename;
+  const QStringList args = a.arguments();
+  for (int i = 1; i < args.count(); ++i) {
+    if (args[i] == "--output" && i + 1 < args.count()) {
+      output_filename = args[i + 1];
+    }
+  }
+
+  BenchmarkCollectionBackend();
+  BenchmarkCollectionModel();
+  BenchmarkPlaylistFilter();
+  BenchmarkCoverScaling();
+
+  const QJsonDocument json = ResultsToJson();
+  if (output_filename.isEmpty()) {
+    QTextStream stream(stdout);
+    stream << json.toJson(QJsonDocument::Indented);
+  }
+  else {
+    QFile file(output_filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qWarning() << "Could not open" << output_filename << "for writing";
+      return 1;
+    }
+    file.write(json.toJson(QJsonDocument::Indented));
+  }
+
+  return 0;
+
+}
@@ -19,6 +19,7 @@
  *
  */
 
+#include <algorithm>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -609,4 +610,150 @@ TEST_F(UpdateSongsBySongID, UpdateSongsBySongID) {
 
 }
 
+class AddSongsBatch : public CollectionBackendTest {
+ protected:
+  void SetUp() override {
+    CollectionBackendTest::SetUp();
+    backend_->AddDirectory("/mnt/music");
+  }
+
+  static SongList MakeSongs(const int count, const int first_number) {
+
+    SongList songs;
+    songs.reserve(count);
+    for (int i = 0; i < count; ++i) {
+
+      const int number = first_number + i;
+
+      QUrl url;
+      url.setScheme("file");
+      url.setPath(QString("/music/song%1.flac").arg(number));
+
+      Song song(Song::Source::Collection);
+      song.set_directory_id(1);
+      song.set_title(QString("Test Title %1").arg(number));
+      song.set_album("Test Album");
+      song.set_artist("Test Artist");
+      song.set_url(url);
+      song.set_length_nanosec(kNsecPerSec);
+      song.set_mtime(1);
+      song.set_ctime(1);
+      song.set_filesize(1);
+      song.set_valid(true);
+
+      songs << song;
+
+    }
+
+    return songs;
+
+  }
+};
+
+TEST_F(AddSongsBatch, ConsecutiveIds) {
+
+  // Use a batch size smaller than the song count so the insert spans several batches.
+  backend_->SetAddSongsBatchSize(4);
+
+  const SongList songs = MakeSongs(10, 1);
+
+  QSignalSpy spy(backend_.get(), &CollectionBackend::SongsDiscovered);
+
+  backend_->AddOrUpdateSongs(songs);
+
+  // All batches commit in one transaction and emit a single signal.
+  ASSERT_EQ(1, spy.count());
+  SongList new_songs = spy[0][0].value<SongList>();
+  ASSERT_EQ(songs.count(), new_songs.count());
+
+  // The IDs assigned by the batched insert must be consecutive and each must map back to the right song.
+  for (int i = 0; i < new_songs.count(); ++i) {
+    EXPECT_EQ(i + 1, new_songs[i].id());
+    EXPECT_EQ(songs[i].title(), new_songs[i].title());
+    EXPECT_EQ(songs[i].url(), new_songs[i].url());
+    Song song = backend_->GetSongById(new_songs[i].id());
+    EXPECT_TRUE(song.is_valid());
+    EXPECT_EQ(songs[i].title(), song.title());
+    EXPECT_EQ(songs[i].url(), song.url());
+  }
+
+}
+
+TEST_F(AddSongsBatch, FtsRowIdsMatch) {
+
+  backend_->SetAddSongsBatchSize(3);
+
+  const SongList songs = MakeSongs(7, 1);
+
+  QSignalSpy spy(backend_.get(), &CollectionBackend::SongsDiscovered);
+
+  backend_->AddOrUpdateSongs(songs);
+
+  ASSERT_EQ(1, spy.count());
+  SongList new_songs = spy[0][0].value<SongList>();
+  ASSERT_EQ(songs.count(), new_songs.count());
+
+  // The FTS rows are inserted with explicit ROWIDs derived from the first ID of each batch - check they line up with the songs table.
+  QSqlDatabase db(database_->Connect());
+  for (const Song &new_song : new_songs) {
+    QSqlQuery q(db);
+    q.prepare(QString("SELECT ftstitle FROM %1 WHERE ROWID = :rowid").arg(SCollection::kFtsTable));
+    q.bindValue(":rowid", new_song.id());
+    EXPECT_TRUE(q.exec());
+    ASSERT_TRUE(q.next());
+    EXPECT_EQ(new_song.title(), q.value(0).toString());
+  }
+
+}
+
+TEST_F(AddSongsBatch, MixedAddAndUpdate) {
+
+  backend_->SetAddSongsBatchSize(4);
+
+  backend_->AddOrUpdateSongs(MakeSongs(3, 1));
+
+  QSignalSpy added_spy(backend_.get(), &CollectionBackend::SongsDiscovered);
+  QSignalSpy deleted_spy(backend_.get(), &CollectionBackend::SongsDeleted);
+
+  // Interleave an update of an existing row with new songs, so the update lands between two batches.
+  Song updated_song = backend_->GetSongById(2);
+  ASSERT_TRUE(updated_song.is_valid());
+  updated_song.set_title("A different title");
+
+  SongList songs = MakeSongs(9, 4);
+  songs.insert(5, updated_song);
+
+  backend_->AddOrUpdateSongs(songs);
+
+  ASSERT_EQ(1, added_spy.count());
+  ASSERT_EQ(1, deleted_spy.count());
+
+  SongList added_songs = added_spy[0][0].value<SongList>();
+  SongList deleted_songs = deleted_spy[0][0].value<SongList>();
+  EXPECT_EQ(songs.count(), added_songs.count());
+  ASSERT_EQ(1, deleted_songs.count());
+  EXPECT_EQ(2, deleted_songs[0].id());
+  EXPECT_EQ("Test Title 2", deleted_songs[0].title());
+
+  // The new songs continue from the highest existing ID, the updated song keeps its own.
+  QList<int> new_ids;
+  for (const Song &added_song : added_songs) {
+    if (added_song.id() == 2) {
+      EXPECT_EQ("A different title", added_song.title());
+    }
+    else {
+      new_ids << added_song.id();
+    }
+  }
+  ASSERT_EQ(9, new_ids.count());
+  std::sort(new_ids.begin(), new_ids.end());
+  for (int i = 0; i < new_ids.count(); ++i) {
+    EXPECT_EQ(i + 4, new_ids[i]);
+    Song song = backend_->GetSongById(new_ids[i]);
+    EXPECT_TRUE(song.is_valid());
+    EXPECT_EQ(QString("Test Title %1").arg(new_ids[i]), song.title());
+  }
+
+}
+
 } // namespace
@@ -25,6 +25,9 @@
 
 #include "test_utils.h"
 
+#include "core/database.h"
+#include "collection/collectionbackend.h"
+#include "collection/collection.h"
 #include "collection/collectionplaylistitem.h"
 #include "playlist/playlist.h"
 #include "mock_settingsprovider.h"
@@ -544,4 +547,150 @@ TEST_F(PlaylistTest, CollectionIdMapMulti) {
 }
 
 
+// Removing collection items compacts them to their database rowids, so undo has to rebuild the items from the collection backend.
+class PlaylistCollectionUndoTest : public ::testing::Test {
+ protected:
+  PlaylistCollectionUndoTest() : sequence_(nullptr, new DummySettingsProvider) {}
+
+  void SetUp() override {
+    database_.reset(new MemoryDatabase(nullptr));
+    backend_ = std::make_unique<CollectionBackend>();
+    backend_->Init(database_.get(), nullptr, Song::Source::Collection, SCollection::kSongsTable, SCollection::kFtsTable, SCollection::kDirsTable, SCollection::kSubdirsTable);
+    backend_->AddDirectory("/mnt/music");
+    playlist_ = std::make_unique<Playlist>(nullptr, nullptr, backend_.get(), 1);
+    playlist_->set_sequence(&sequence_);
+  }
+
+  // Adds a song to the collection backend and returns it with the ID it was assigned.
+  Song AddSongToCollection(const QString &title) {
+
+    QUrl url;
+    url.setScheme("file");
+    url.setPath("/music/" + title + ".flac");
+
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_title(title);
+    song.set_artist("Artist");
+    song.set_album("Album");
+    song.set_url(url);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    song.set_valid(true);
+
+    backend_->AddOrUpdateSongs(SongList() << song);
+
+    return backend_->GetSongByUrl(url);
+
+  }
+
+  std::shared_ptr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  std::unique_ptr<CollectionBackend> backend_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  std::unique_ptr<Playlist> playlist_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  PlaylistSequence sequence_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+
+};
+
+TEST_F(PlaylistCollectionUndoTest, UndoRemoveRebuildsFromCollection) {
+
+  const Song one = AddSongToCollection("One");
+  const Song two = AddSongToCollection("Two");
+  const Song three = AddSongToCollection("Three");
+  ASSERT_NE(-1, one.id());
+  ASSERT_NE(-1, two.id());
+  ASSERT_NE(-1, three.id());
+
+  std::weak_ptr<PlaylistItem> weak_two;
+  {
+    PlaylistItemPtr item_two = std::make_shared<CollectionPlaylistItem>(two);
+    weak_two = item_two;
+    playlist_->InsertItems(PlaylistItemPtrList()
+        << std::make_shared<CollectionPlaylistItem>(one)
+        << item_two
+        << std::make_shared<CollectionPlaylistItem>(three));
+  }
+  ASSERT_EQ(3, playlist_->rowCount(QModelIndex()));
+
+  playlist_->removeRows(0, 3);
+  ASSERT_EQ(0, playlist_->rowCount(QModelIndex()));
+
+  // The undo command must not keep the items alive - only their rowids.
+  EXPECT_TRUE(weak_two.expired());
+
+  ASSERT_TRUE(playlist_->undo_stack()->canUndo());
+  playlist_->undo_stack()->undo();
+
+  ASSERT_EQ(3, playlist_->rowCount(QModelIndex()));
+  EXPECT_EQ("One", playlist_->data(playlist_->index(0, Playlist::Column_Title)));
+  EXPECT_EQ("Two", playlist_->data(playlist_->index(1, Playlist::Column_Title)));
+  EXPECT_EQ("Three", playlist_->data(playlist_->index(2, Playlist::Column_Title)));
+  EXPECT_EQ(two.id(), playlist_->item_at(1)->Metadata().id());
+  EXPECT_TRUE(playlist_->item_at(1)->IsLocalCollectionItem());
+
+}
+
+TEST_F(PlaylistCollectionUndoTest, UndoRemoveSkipsSongsGoneFromCollection) {
+
+  const Song one = AddSongToCollection("One");
+  const Song two = AddSongToCollection("Two");
+  const Song three = AddSongToCollection("Three");
+
+  playlist_->InsertItems(PlaylistItemPtrList()
+      << std::make_shared<CollectionPlaylistItem>(one)
+      << std::make_shared<CollectionPlaylistItem>(two)
+      << std::make_shared<CollectionPlaylistItem>(three));
+  ASSERT_EQ(3, playlist_->rowCount(QModelIndex()));
+
+  playlist_->removeRows(0, 3);
+  ASSERT_EQ(0, playlist_->rowCount(QModelIndex()));
+
+  // Delete one of the songs from the collection while it only exists as a rowid in the undo command.
+  backend_->DeleteSongs(SongList() << two);
+
+  playlist_->undo_stack()->undo();
+
+  // The deleted song can't be restored, the others still are.
+  ASSERT_EQ(2, playlist_->rowCount(QModelIndex()));
+  EXPECT_EQ("One", playlist_->data(playlist_->index(0, Playlist::Column_Title)));
+  EXPECT_EQ("Three", playlist_->data(playlist_->index(1, Playlist::Column_Title)));
+
+}
+
+TEST_F(PlaylistCollectionUndoTest, UndoRemoveKeepsNonCollectionItems) {
+
+  const Song one = AddSongToCollection("One");
+  const Song three = AddSongToCollection("Three");
+
+  Song stream_metadata;
+  stream_metadata.Init("Stream", "Artist", "Album", 123);
+  MockPlaylistItem *stream_item = new MockPlaylistItem;
+  EXPECT_CALL(*stream_item, Metadata()).WillRepeatedly(Return(stream_metadata));
+
+  std::weak_ptr<PlaylistItem> weak_stream;
+  {
+    PlaylistItemPtr stream_item_ptr(stream_item);
+    weak_stream = stream_item_ptr;
+    playlist_->InsertItems(PlaylistItemPtrList()
+        << std::make_shared<CollectionPlaylistItem>(one)
+        << stream_item_ptr
+        << std::make_shared<CollectionPlaylistItem>(three));
+  }
+  ASSERT_EQ(3, playlist_->rowCount(QModelIndex()));
+
+  playlist_->removeRows(0, 3);
+  ASSERT_EQ(0, playlist_->rowCount(QModelIndex()));
+
+  // The stream item has no collection rowid to rebuild from, so the undo command keeps it alive.
+  EXPECT_FALSE(weak_stream.expired());
+
+  playlist_->undo_stack()->undo();
+
+  ASSERT_EQ(3, playlist_->rowCount(QModelIndex()));
+  EXPECT_EQ("One", playlist_->data(playlist_->index(0, Playlist::Column_Title)));
+  EXPECT_EQ("Stream", playlist_->data(playlist_->index(1, Playlist::Column_Title)));
+  EXPECT_EQ("Three", playlist_->data(playlist_->index(2, Playlist::Column_Title)));
+
+}
+
 }  // namespace
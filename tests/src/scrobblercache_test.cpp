@@ -0,0 +1,166 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2018-2023, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QStandardPaths>
+#include <QString>
+#include <QTextStream>
+
+#include "test_utils.h"
+
+#include "core/song.h"
+#include "utilities/timeconstants.h"
+#include "scrobbler/scrobblercache.h"
+#include "scrobbler/scrobblercacheitem.h"
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class ScrobblerCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // ScrobblerCache resolves the filename against the cache location, so the test has to clean up the same path.
+    filename_ = QString("strawberry_scrobbler_cache_test-%1.jsonl").arg(::testing::UnitTest::GetInstance()->current_test_info()->name());
+    const QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(cache_dir);
+    path_ = cache_dir + "/" + filename_;
+    QFile::remove(path_);
+  }
+
+  void TearDown() override {
+    QFile::remove(path_);
+  }
+
+  static Song MakeSong(const QString &title) {
+    Song song;
+    song.Init(title, "Artist", "Album", 123 * kNsecPerSec);
+    return song;
+  }
+
+  void AppendToCacheFile(const QString &data) {
+    QFile file(path_);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text));
+    QTextStream stream(&file);
+    stream << data;
+    file.close();
+  }
+
+  QString filename_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QString path_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+
+};
+
+TEST_F(ScrobblerCacheTest, JournalReplay) {
+
+  {  // Add three scrobbles and acknowledge one, everything goes through the journal.
+    ScrobblerCache cache(filename_, nullptr);
+    EXPECT_EQ(0, cache.Count());
+
+    cache.Add(MakeSong("One"), 10001);
+    ScrobblerCacheItemPtr item_two = cache.Add(MakeSong("Two"), 10002);
+    cache.Add(MakeSong("Three"), 10003);
+    ASSERT_EQ(3, cache.Count());
+
+    cache.Flush(ScrobblerCacheItemPtrList() << item_two);
+    ASSERT_EQ(2, cache.Count());
+  }
+
+  // A new cache replaying the journal must see the adds minus the flushed entry.
+  ScrobblerCache cache(filename_, nullptr);
+  ASSERT_EQ(2, cache.Count());
+  const ScrobblerCacheItemPtrList items = cache.List();
+  EXPECT_EQ("One", items[0]->metadata.title);
+  EXPECT_EQ(10001U, items[0]->timestamp);
+  EXPECT_EQ("Three", items[1]->metadata.title);
+  EXPECT_EQ(10003U, items[1]->timestamp);
+  EXPECT_EQ("Artist", items[0]->metadata.artist);
+  EXPECT_EQ("Album", items[0]->metadata.album);
+  EXPECT_EQ(123 * kNsecPerSec, items[0]->metadata.length_nanosec);
+
+}
+
+TEST_F(ScrobblerCacheTest, JournalReplayTornLastLine) {
+
+  {
+    ScrobblerCache cache(filename_, nullptr);
+    cache.Add(MakeSong("One"), 10001);
+    cache.Add(MakeSong("Two"), 10002);
+  }
+
+  // A crash mid-append leaves a record without a closing brace and newline.
+  AppendToCacheFile("{\"op\":\"add\",\"timestamp\":10003,\"title\":\"Torn");
+
+  // The torn record is dropped, the complete records before it are kept.
+  ScrobblerCache cache(filename_, nullptr);
+  ASSERT_EQ(2, cache.Count());
+  const ScrobblerCacheItemPtrList items = cache.List();
+  EXPECT_EQ("One", items[0]->metadata.title);
+  EXPECT_EQ("Two", items[1]->metadata.title);
+
+}
+
+TEST_F(ScrobblerCacheTest, LegacyDocumentMigration) {
+
+  // The old cache format is one pretty-printed document with a "tracks" array.
+  AppendToCacheFile(
+      "{\n"
+      "  \"tracks\": [\n"
+      "    {\n"
+      "      \"timestamp\": 10001,\n"
+      "      \"artist\": \"Artist\",\n"
+      "      \"album\": \"Album\",\n"
+      "      \"title\": \"One\",\n"
+      "      \"track\": 1,\n"
+      "      \"albumartist\": \"Artist\",\n"
+      "      \"length_nanosec\": 123000000000\n"
+      "    },\n"
+      "    {\n"
+      "      \"timestamp\": 10002,\n"
+      "      \"artist\": \"Artist\",\n"
+      "      \"album\": \"Album\",\n"
+      "      \"title\": \"Two\",\n"
+      "      \"track\": 2,\n"
+      "      \"albumartist\": \"Artist\",\n"
+      "      \"length_nanosec\": 123000000000\n"
+      "    }\n"
+      "  ]\n"
+      "}\n");
+
+  ScrobblerCache cache(filename_, nullptr);
+  ASSERT_EQ(2, cache.Count());
+  const ScrobblerCacheItemPtrList items = cache.List();
+  EXPECT_EQ("One", items[0]->metadata.title);
+  EXPECT_EQ(10001U, items[0]->timestamp);
+  EXPECT_EQ("Two", items[1]->metadata.title);
+  EXPECT_EQ(10002U, items[1]->timestamp);
+
+  // Entries loaded from the legacy document are journalled like any others from then on.
+  cache.Add(MakeSong("Three"), 10003);
+  EXPECT_EQ(3, cache.Count());
+
+}
+
+}  // namespace